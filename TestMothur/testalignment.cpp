@@ -0,0 +1,125 @@
+//
+//  testalignment.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testalignment.hpp"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//a 1500 base template, a 250 base read from the middle, a full length read and one with 10 bases more at each end.
+//The seed is fixed so every run is the same.
+void TestAlignment::SetUp() {
+    string bases = "ACGT";
+    mt19937_64 engine(12345);
+    templateSeq = BenchmarkData::getRandomBases(1500, engine);
+    
+    string middle = templateSeq.substr(600, 250);
+    middle[20] = bases[(bases.find(middle[20]) + 1) % 4];
+    middle.erase(100, 3);
+    middle.insert(180, "TT");
+    reads.push_back(middle);
+    
+    string full = templateSeq;
+    for (int i = 50; i < full.length(); i += 150) { full[i] = bases[(bases.find(full[i]) + 2) % 4]; }
+    full.erase(700, 5);
+    full.insert(1200, "ACA");
+    reads.push_back(full);
+    
+    reads.push_back("ACGTACGTAC" + templateSeq.substr(0, 400) + "GGCCAATTGG");
+}
+/**************************************************************************************************/
+typedef TestAlignment Test_Alignment; //the test names need to start with Test_ to run
+/**************************************************************************************************/
+TEST_F(Test_Alignment, band) {
+    NeedlemanOverlap full(-5.0, 1.0, -1.0, 2000);
+    NeedlemanOverlap banded(-5.0, 1.0, -1.0, 2000); banded.setBand(20);
+    GotohOverlap fullGotoh(-5.0, -2.0, 1.0, -1.0, 2000);
+    GotohOverlap bandedGotoh(-5.0, -2.0, 1.0, -1.0, 2000); bandedGotoh.setBand(20);
+    
+    for (int i = 0; i < reads.size(); i++) {
+        full.align(reads[i], templateSeq); banded.align(reads[i], templateSeq);
+        EXPECT_EQ(full.getSeqAAln(), banded.getSeqAAln());
+        EXPECT_EQ(full.getSeqBAln(), banded.getSeqBAln());
+        EXPECT_EQ(full.getTemplateStartPos(), banded.getTemplateStartPos());
+        EXPECT_EQ(full.getTemplateEndPos(), banded.getTemplateEndPos());
+        
+        fullGotoh.align(reads[i], templateSeq); bandedGotoh.align(reads[i], templateSeq);
+        EXPECT_EQ(fullGotoh.getSeqAAln(), bandedGotoh.getSeqAAln());
+        EXPECT_EQ(fullGotoh.getSeqBAln(), bandedGotoh.getSeqBAln());
+    }
+    
+    //the middle read lines up with template bases 601 to 850, counting from 1
+    full.align(reads[0], templateSeq);
+    EXPECT_EQ(601, full.getTemplateStartPos());
+    EXPECT_EQ(850, full.getTemplateEndPos());
+}
+
+TEST_F(Test_Alignment, resize) {
+    NeedlemanOverlap small(-5.0, 1.0, -1.0, 100);
+    small.resize(2000);
+    
+    //the template bases before the read are still gaps in the read after resizing
+    small.align(reads[0], templateSeq);
+    EXPECT_EQ(601, small.getTemplateStartPos());
+    string alignedRead = small.getSeqAAln();
+    EXPECT_EQ(string(600, '-'), alignedRead.substr(0, 600));
+    EXPECT_EQ(templateSeq.length(), small.getSeqBAln().length() - 2); //the read's 2 inserted bases
+}
+
+TEST_F(Test_Alignment, striped) {
+    //halving the scores gives the same alignments, but the halves aren't whole numbers so the scalar loop is used
+    NeedlemanOverlap striped(-5.0, 1.0, -1.0, 2000);
+    NeedlemanOverlap scalar(-2.5, 0.5, -0.5, 2000);
+    GotohOverlap stripedGotoh(-5.0, -2.0, 1.0, -1.0, 2000);
+    GotohOverlap scalarGotoh(-2.5, -1.0, 0.5, -0.5, 2000);
+    
+    for (int i = 0; i < reads.size(); i++) {
+        striped.align(reads[i], templateSeq); scalar.align(reads[i], templateSeq);
+        EXPECT_EQ(scalar.getSeqAAln(), striped.getSeqAAln());
+        EXPECT_EQ(scalar.getSeqBAln(), striped.getSeqBAln());
+        
+        stripedGotoh.align(reads[i], templateSeq); scalarGotoh.align(reads[i], templateSeq);
+        EXPECT_EQ(scalarGotoh.getSeqAAln(), stripedGotoh.getSeqAAln());
+        EXPECT_EQ(scalarGotoh.getSeqBAln(), stripedGotoh.getSeqBAln());
+        
+        //and with seqA shorter than seqB
+        striped.align(templateSeq.substr(0, 30), reads[i]); scalar.align(templateSeq.substr(0, 30), reads[i]);
+        EXPECT_EQ(scalar.getSeqAAln(), striped.getSeqAAln());
+        EXPECT_EQ(scalar.getSeqBAln(), striped.getSeqBAln());
+    }
+}
+
+TEST_F(Test_Alignment, templateProfile) {
+    //the template in a 3000 column alignment, with runs of gap columns between some of its bases
+    string aligned = "....";
+    for (int i = 0; i < templateSeq.length(); i++) {
+        aligned += templateSeq[i];
+        if (i % 7 == 0) { aligned += string(i % 5, '-'); }
+    }
+    aligned += string(3000 - aligned.length(), '.');
+    Sequence temp("template", aligned);
+    
+    TemplateProfile profile(0, temp);
+    EXPECT_EQ(templateSeq.length(), profile.baseColumns.size());
+    EXPECT_EQ(4, profile.baseColumns[0]);
+    EXPECT_EQ(5, profile.baseColumns[1]);
+    
+    //nast gives the same alignment with the profile's base columns as with the ones it finds itself
+    NeedlemanOverlap alignment(-2.0, 1.0, -1.0, 2000);
+    for (int i = 0; i < reads.size(); i++) {
+        Sequence byColumn("read", reads[i]); Sequence byRun("read", reads[i]);
+        Sequence tempByColumn("template", aligned);
+        
+        Nast nastByColumn(&alignment, &byColumn, &tempByColumn);
+        Nast nastByRun(&alignment, &byRun, &profile.seq, &profile.baseColumns);
+        
+        EXPECT_EQ(byColumn.getAligned(), byRun.getAligned());
+        EXPECT_EQ(aligned.length(), byRun.getAligned().length());
+        EXPECT_EQ(nastByColumn.getMaxInsertLength(), nastByRun.getMaxInsertLength());
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,29 @@
+//
+//  testalignment.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testalignment_hpp
+#define testalignment_hpp
+
+#include "gtest/gtest.h"
+#include "needlemanoverlap.hpp"
+#include "gotohoverlap.hpp"
+#include "nast.hpp"
+#include "templateprofile.hpp"
+
+//a made up template and reads taken from it with a few substitutions and indels
+class TestAlignment : public ::testing::Test {
+    
+protected:
+    
+    void SetUp();
+    
+    string templateSeq;
+    vector<string> reads;
+};
+
+#endif /* testalignment_hpp */
@@ -0,0 +1,70 @@
+//
+//  benchmark.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "benchmark.hpp"
+
+/**************************************************************************************************/
+Benchmark::Benchmark(string u) {
+    m = MothurOut::getInstance();
+    data = BenchmarkData::getInstance();
+    unit = u; processors = 1; repeats = 3;
+
+    Utils util;
+    const char* value = getenv("MOTHUR_BENCH_PROCESSORS");
+    if ((value != NULL) && util.isInteger(value)) { util.mothurConvert(string(value), processors); }
+    value = getenv("MOTHUR_BENCH_REPEATS");
+    if ((value != NULL) && util.isInteger(value)) { util.mothurConvert(string(value), repeats); }
+
+    if (processors < 1) { processors = 1; }
+    if (repeats < 1) { repeats = 1; }
+
+    m->setRandomSeed(data->getSeed());
+
+    //the classifier and search databases check the version of the files they read
+    CurrentFile* current = CurrentFile::getInstance();
+#ifdef VERSION
+    if (current->getVersion() == "") { current->setVersion(VERSION); }
+#endif
+}
+/**************************************************************************************************/
+double Benchmark::run(function<void()> work) {
+    work(); //warm up the caches and anything built on first use
+
+    vector<double> times;
+    for (int i = 0; i < repeats; i++) {
+        auto start = chrono::steady_clock::now();
+        work();
+        times.push_back(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    sort(times.begin(), times.end());
+
+    double seconds = times[times.size() / 2];
+    if (seconds <= 0) { seconds = 1e-9; }
+
+    return seconds;
+}
+/**************************************************************************************************/
+void Benchmark::report(string description, double items, double seconds) {
+    if (seconds <= 0) { seconds = 1e-9; }
+    double throughput = items / seconds;
+
+    m->mothurOut("\n" + description + ": " + toString(throughput) + " " + unit + " per second\n");
+
+    ::testing::Test::RecordProperty("throughput", toString(throughput));
+    ::testing::Test::RecordProperty("unit", unit + "/second");
+    ::testing::Test::RecordProperty("items", toString((long long)items));
+    ::testing::Test::RecordProperty("seconds", toString(seconds));
+    ::testing::Test::RecordProperty("repeats", repeats);
+    ::testing::Test::RecordProperty("processors", processors);
+    ::testing::Test::RecordProperty("scale", toString(data->getScale()));
+    ::testing::Test::RecordProperty("seed", toString(data->getSeed()));
+#ifdef VERSION
+    ::testing::Test::RecordProperty("version", VERSION);
+#endif
+}
+/**************************************************************************************************/
@@ -0,0 +1,51 @@
+//
+//  benchmark.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef benchmark_hpp
+#define benchmark_hpp
+
+#include "gtest/gtest.h"
+#include "benchmarkdata.hpp"
+#include "currentfile.h"
+
+/* The benchmarks are gtest tests named Bench_*, so the unit test runs (Test_*) skip them. make bench runs them with
+ --gtest_filter=Bench_* --gtest_output=json:$(BENCH_OUTPUT), and each test records its throughput, the items it
+ processed, the median seconds and the settings as properties of the test in the json file.
+
+ MOTHUR_BENCH_SCALE multiplies the dataset sizes, MOTHUR_BENCH_SEED picks the datasets, MOTHUR_BENCH_PROCESSORS sets
+ the processors for the benchmarks that use threads and MOTHUR_BENCH_REPEATS the number of timed runs. */
+
+/**************************************************************************************************/
+
+class Benchmark {
+
+public:
+
+    Benchmark(string); //unit the throughput is counted in, ie. "pairs"
+    ~Benchmark() {}
+
+    //runs the work once to warm up, then repeats times. Returns the median seconds.
+    double run(function<void()>);
+
+    //records items / seconds as the test's throughput
+    void report(string, double, double); //description, items, seconds
+
+    int getProcessors()     { return processors;    }
+    int getRepeats()        { return repeats;       }
+    BenchmarkData* data;
+
+private:
+
+    MothurOut* m;
+    string unit;
+    int processors, repeats;
+};
+
+/**************************************************************************************************/
+
+#endif /* benchmark_hpp */
@@ -0,0 +1,323 @@
+//
+//  benchmarkdata.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "benchmarkdata.hpp"
+
+BenchmarkData* BenchmarkData::instance = NULL;
+/**************************************************************************************************/
+BenchmarkData* BenchmarkData::getInstance() {
+    if (instance == NULL) {
+        string dir = "benchmark_data/"; double scale = 1.0; unsigned long long seed = 19760;
+        Utils util;
+
+        const char* value = getenv("MOTHUR_BENCH_DIR");
+        if (value != NULL) { dir = value; }
+        value = getenv("MOTHUR_BENCH_SCALE");
+        if ((value != NULL) && util.isNumeric1(value)) { util.mothurConvert(value, scale); }
+        value = getenv("MOTHUR_BENCH_SEED");
+        if ((value != NULL) && util.isInteger(value)) { seed = strtoull(value, NULL, 10); }
+
+        instance = new BenchmarkData(dir, scale, seed);
+    }
+    return instance;
+}
+/**************************************************************************************************/
+BenchmarkData::BenchmarkData(string dir, double s, unsigned long long sd) {  //setup
+    m = MothurOut::getInstance();
+    dataDir = dir; scale = s; seed = sd;
+    if (scale <= 0) { scale = 1.0; }
+
+    util.mkDir(dataDir);
+
+    numGenera = scaled(50); speciesPerGenus = 20;
+    refLength = 1500; readStart = 500; readLength = 250;
+}
+/**************************************************************************************************/
+int BenchmarkData::scaled(int num) {
+    int value = (int)(num * scale);
+    if (value < 1) { value = 1; }
+    return value;
+}
+/**************************************************************************************************/
+bool BenchmarkData::needToWrite(string fileName) {
+    if (written.count(fileName) != 0) { return false; }
+    written.insert(fileName);
+    return true;
+}
+/**************************************************************************************************/
+//substitutes rate of the bases, and deletes a tenth as many. Deleted bases are '-' so the columns stay lined up.
+string BenchmarkData::mutate(const string& bases, double rate, mt19937_64& engine) {
+    string mutated = bases;
+    const char nucleotides[4] = { 'A', 'C', 'G', 'T' };
+
+    for (int i = 0; i < mutated.length(); i++) {
+        if (mutated[i] == '-') { continue; }
+
+        double r = drawUnit(engine);
+        if (r < rate)               { mutated[i] = nucleotides[draw(engine, 4)];   }
+        else if (r < rate * 1.1)    { mutated[i] = '-';                            }
+    }
+
+    return mutated;
+}
+/**************************************************************************************************/
+string BenchmarkData::getRandomBases(int length, mt19937_64& engine) {
+    const char nucleotides[4] = { 'A', 'C', 'G', 'T' };
+
+    string bases(length, 'A');
+    for (int i = 0; i < length; i++) { bases[i] = nucleotides[draw(engine, 4)]; }
+
+    return bases;
+}
+/**************************************************************************************************/
+//each change picks a position and gives it one of the other three bases. A position can be picked twice
+string BenchmarkData::substitute(const string& bases, int numChanges, mt19937_64& engine) {
+    string mutated = bases;
+    const string nucleotides = "ACGT";
+
+    for (int i = 0; i < numChanges; i++) {
+        int pos = draw(engine, mutated.length());
+        size_t base = nucleotides.find(mutated[pos]);
+        if (base == string::npos) { continue; }
+
+        mutated[pos] = nucleotides[(base + 1 + draw(engine, 3)) % 4];
+    }
+
+    return mutated;
+}
+/**************************************************************************************************/
+//the genera are 15% from the ancestor and the species 3% from their genus
+void BenchmarkData::makeReferences() {
+    if (refBases.size() != 0) { return; }
+
+    mt19937_64 engine(seed);
+    string ancestor = getRandomBases(refLength, engine);
+
+    //silva like alignments have many more columns than bases
+    gapsBefore.resize(refLength+1, 0);
+    for (int i = 0; i <= refLength; i++) { if (drawUnit(engine) < 0.3) { gapsBefore[i] = 1 + draw(engine, 4); } }
+
+    for (int g = 0; g < numGenera; g++) {
+        string genus = mutate(ancestor, 0.15, engine);
+        for (int s = 0; s < speciesPerGenus; s++) { refBases.push_back(mutate(genus, 0.03, engine)); }
+    }
+}
+/**************************************************************************************************/
+//bases outside first - last are '.'
+string BenchmarkData::alignBases(const string& bases, int first, int last) {
+    string aligned = "";
+    for (int i = 0; i < refLength; i++) {
+        char gap = '-'; char base = bases[i];
+        if ((i < first) || (i > last)) { gap = '.'; base = '.'; }
+        if ((i == first) && (first != 0)) { gap = '.'; }
+
+        aligned += string(gapsBefore[i], gap);
+        aligned += base;
+    }
+    aligned += string(gapsBefore[refLength], (last == refLength-1) ? '-' : '.');
+
+    return aligned;
+}
+/**************************************************************************************************/
+vector<Sequence> BenchmarkData::getReferences(bool aligned) {
+    makeReferences();
+
+    vector<Sequence> refs;
+    for (int i = 0; i < refBases.size(); i++) {
+        Sequence seq("ref" + toString(i), alignBases(refBases[i], 0, refLength-1));
+        if (!aligned) { seq.setAligned(seq.getUnaligned()); }
+        refs.push_back(seq);
+    }
+
+    return refs;
+}
+/**************************************************************************************************/
+string BenchmarkData::getReferenceFasta() {
+    string fileName = dataDir + "bench.ref.fasta";
+    if (!needToWrite(fileName)) { return fileName; }
+
+    vector<Sequence> refs = getReferences(false);
+
+    ofstream out; util.openOutputFile(fileName, out);
+    for (int i = 0; i < refs.size(); i++) { refs[i].printSequence(out); }
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
+string BenchmarkData::getReferenceTaxonomy() {
+    string fileName = dataDir + "bench.ref.tax";
+    if (!needToWrite(fileName)) { return fileName; }
+
+    makeReferences();
+
+    ofstream out; util.openOutputFile(fileName, out);
+    for (int i = 0; i < refBases.size(); i++) {
+        int g = i / speciesPerGenus;
+        out << "ref" << i << '\t' << "Bacteria;Phylum" << (g % 4) << ";Class" << (g % 8) << ";Order" << (g % 16) << ";Family" << (g % 32) << ";Genus" << g << ";" << endl;
+    }
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
+//reads from the readStart - readStart + readLength region of a random species with 1% errors
+vector<Sequence> BenchmarkData::getReads(int numReads, bool aligned) {
+    makeReferences();
+
+    mt19937_64 engine(seed + 1);
+    int last = readStart + readLength - 1;
+
+    vector<Sequence> reads;
+    for (int i = 0; i < numReads; i++) {
+        string bases = mutate(refBases[draw(engine, refBases.size())], 0.01, engine);
+
+        Sequence seq("read" + toString(i), alignBases(bases, readStart, last));
+        if (!aligned) { seq.setAligned(seq.getUnaligned()); }
+        reads.push_back(seq);
+    }
+
+    return reads;
+}
+/**************************************************************************************************/
+//seqs are split into groups of otuSize. Each seq is close to numClose seqs, mostly in its own group, with a few
+//links to the next group, so opticluster has moves to make across groups
+string BenchmarkData::getColumnDist(int numSeqs, int otuSize, int numClose) {
+    string fileName = dataDir + "bench." + toString(numSeqs) + ".dist";
+    getColumnCount(numSeqs);
+    if (!needToWrite(fileName)) { return fileName; }
+
+    mt19937_64 engine(seed + 2);
+
+    ofstream out; util.openOutputFile(fileName, out);
+    out << setprecision(4);
+
+    set<pair<int, int> > pairs;
+    for (int i = 0; i < numSeqs; i++) {
+        int groupStart = (i / otuSize) * otuSize;
+        for (int j = 0; j < numClose; j++) {
+            int close = groupStart + draw(engine, otuSize);
+            if (j == 0) { close += otuSize; } //link to the next group
+            if ((close >= numSeqs) || (close == i)) { continue; }
+
+            pair<int, int> thisPair(min(i, close), max(i, close));
+            if (pairs.count(thisPair) != 0) { continue; }
+            pairs.insert(thisPair);
+
+            out << "seq" << thisPair.second << '\t' << "seq" << thisPair.first << '\t' << (0.001 + 0.028 * drawUnit(engine)) << '\n';
+        }
+    }
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
+string BenchmarkData::getColumnCount(int numSeqs) {
+    string fileName = dataDir + "bench." + toString(numSeqs) + ".count_table";
+    if (!needToWrite(fileName)) { return fileName; }
+
+    ofstream out; util.openOutputFile(fileName, out);
+    out << "Representative_Sequence\ttotal\n";
+    for (int i = 0; i < numSeqs; i++) { out << "seq" << i << "\t1\n"; }
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
+//the OTUs have a long tail, each group weights them a little differently
+string BenchmarkData::getShared(int numGroups, int numOtus, int readsPerGroup) {
+    string fileName = dataDir + "bench." + toString(numGroups) + "." + toString(numOtus) + ".shared";
+    if (!needToWrite(fileName)) { return fileName; }
+
+    mt19937_64 engine(seed + 3);
+
+    ofstream out; util.openOutputFile(fileName, out);
+    out << "label\tGroup\tnumOtus";
+    for (int j = 0; j < numOtus; j++) { out << "\tOtu" << (j+1); }
+    out << '\n';
+
+    for (int i = 0; i < numGroups; i++) {
+        vector<double> cumulative(numOtus, 0);
+        double total = 0;
+        for (int j = 0; j < numOtus; j++) { total += (0.5 + drawUnit(engine)) / (j + 1.0); cumulative[j] = total; }
+
+        vector<int> abunds(numOtus, 0);
+        for (int k = 0; k < readsPerGroup; k++) {
+            double r = drawUnit(engine) * total;
+            int otu = lower_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin();
+            if (otu >= numOtus) { otu = numOtus-1; }
+            abunds[otu]++;
+        }
+
+        out << "0.03\tgroup" << i << '\t' << numOtus;
+        for (int j = 0; j < numOtus; j++) { out << '\t' << abunds[j]; }
+        out << '\n';
+    }
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
+//joins random pairs of subtrees until one is left
+string BenchmarkData::getTree(int numSeqs, int numGroups) {
+    string fileName = dataDir + "bench." + toString(numSeqs) + ".tre";
+    getTreeCount(numSeqs, numGroups);
+    if (!needToWrite(fileName)) { return fileName; }
+
+    mt19937_64 engine(seed + 4);
+
+    vector<string> subtrees;
+    for (int i = 0; i < numSeqs; i++) { subtrees.push_back("seq" + toString(i)); }
+
+    ostringstream branch; branch << setprecision(4);
+    while (subtrees.size() > 1) {
+        int left = draw(engine, subtrees.size());
+        string leftTree = subtrees[left]; subtrees[left] = subtrees.back(); subtrees.pop_back();
+        int right = draw(engine, subtrees.size());
+
+        branch.str("");
+        branch << "(" << leftTree << ":" << (0.001 + 0.05 * drawUnit(engine)) << "," << subtrees[right] << ":" << (0.001 + 0.05 * drawUnit(engine)) << ")";
+        subtrees[right] = branch.str();
+    }
+
+    ofstream out; util.openOutputFile(fileName, out);
+    out << subtrees[0] << ";" << endl;
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
+//each seq is in 1 to 3 groups
+string BenchmarkData::getTreeCount(int numSeqs, int numGroups) {
+    string fileName = dataDir + "bench." + toString(numSeqs) + ".tre.count_table";
+    if (!needToWrite(fileName)) { return fileName; }
+
+    mt19937_64 engine(seed + 5);
+
+    ofstream out; util.openOutputFile(fileName, out);
+    out << "Representative_Sequence\ttotal";
+    for (int j = 0; j < numGroups; j++) { out << "\tgroup" << j; }
+    out << '\n';
+
+    for (int i = 0; i < numSeqs; i++) {
+        vector<int> abunds(numGroups, 0);
+        int numIn = 1 + draw(engine, 3);
+        for (int k = 0; k < numIn; k++) { abunds[draw(engine, numGroups)] += 1 + draw(engine, 10); }
+
+        int total = 0;
+        for (int j = 0; j < numGroups; j++) { total += abunds[j]; }
+
+        out << "seq" << i << '\t' << total;
+        for (int j = 0; j < numGroups; j++) { out << '\t' << abunds[j]; }
+        out << '\n';
+    }
+    out.close();
+
+    return fileName;
+}
+/**************************************************************************************************/
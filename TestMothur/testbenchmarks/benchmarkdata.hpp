@@ -0,0 +1,82 @@
+//
+//  benchmarkdata.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef benchmarkdata_hpp
+#define benchmarkdata_hpp
+
+#include "mothurout.h"
+#include "sequence.hpp"
+
+/* Makes the made up datasets the benchmarks run on. The reads come from a tree of genera and species that share an
+ ancestor, so the kmer searches, alignments and classifications have real work to do, and the aligned reads share
+ their gap columns like reads aligned to silva. Everything is drawn from its own mt19937_64 seeded with the seed, so
+ the same seed and scale give the same files on every machine.
+
+ The sizes are multiplied by the scale. The files are written to the data directory the first time they are asked
+ for. */
+
+/**************************************************************************************************/
+
+class BenchmarkData {
+
+public:
+
+    BenchmarkData(string, double, unsigned long long); //data directory, scale, seed
+    ~BenchmarkData() {}
+
+    static BenchmarkData* getInstance(); //reads MOTHUR_BENCH_DIR, MOTHUR_BENCH_SCALE and MOTHUR_BENCH_SEED
+
+    int scaled(int); //number * scale, at least 1
+
+    //16S-like reads from a single region, aligned to a shared set of columns or unaligned
+    vector<Sequence> getReads(int, bool); //numReads, aligned
+    //full length references, aligned or unaligned, and the taxonomy file for them
+    vector<Sequence> getReferences(bool);
+    string getReferenceFasta();     //unaligned
+    string getReferenceTaxonomy();
+
+    string getColumnDist(int, int, int); //numSeqs, seqs per OTU, close seqs per seq. Writes the count file too, see getColumnCount
+    string getColumnCount(int);          //numSeqs
+    string getShared(int, int, int);     //numGroups, numOtus, reads per group
+    string getTree(int, int);            //numSeqs, numGroups. Writes the count file too, see getTreeCount
+    string getTreeCount(int, int);
+
+    double getScale()               { return scale;         }
+    unsigned long long getSeed()    { return seed;          }
+    string getDataDir()             { return dataDir;       }
+
+    int numGenera, speciesPerGenus, refLength, readStart, readLength;
+
+    //what the datasets are made from, for the tests that make a small dataset of their own
+    static string getRandomBases(int, mt19937_64&);                 //length
+    static string mutate(const string&, double, mt19937_64&);       //bases, rate
+    static string substitute(const string&, int, mt19937_64&);      //bases, number of positions changed, gaps are left alone
+    static unsigned long long draw(mt19937_64& engine, unsigned long long n) { return engine() % n; }
+    static double drawUnit(mt19937_64& engine) { return (engine() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+
+    static BenchmarkData* instance;
+    MothurOut* m;
+    Utils util;
+    string dataDir;
+    double scale;
+    unsigned long long seed;
+
+    vector<string> refBases;        //one row per species
+    vector<int> gapsBefore;         //gap columns before each base position, shared by all the sequences
+    set<string> written;
+
+    void makeReferences();
+    string alignBases(const string&, int, int);   //bases, first base position, last base position
+    bool needToWrite(string);
+};
+
+/**************************************************************************************************/
+
+#endif /* benchmarkdata_hpp */
@@ -0,0 +1,318 @@
+//
+//  testbenchmarks.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "benchmark.hpp"
+#include "packeddist.hpp"
+#include "onegapignore.h"
+#include "kmerdb.hpp"
+#include "needlemanoverlap.hpp"
+#include "gotohoverlap.hpp"
+#include "bayesian.h"
+#include "opticluster.h"
+#include "optimatrix.h"
+#include "mcc.hpp"
+#include "inputdata.h"
+#include "subsample.h"
+#include "treereader.h"
+#include "weighted.h"
+#include "unweighted.h"
+#include "trimoligos.h"
+#include "fragmentassembler.hpp"
+
+/**************************************************************************************************/
+TEST(Bench_Calc_Dist, packedOneGap) {
+    Benchmark bench("pairs");
+
+    SequenceDB seqs;
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(2000), true);
+    for (int i = 0; i < reads.size(); i++) { seqs.push_back(reads[i]); }
+
+    PackedSeqDB packedDB;
+    ASSERT_TRUE(packedDB.pack(seqs));
+    PackedDist distCalculator(&packedDB, "onegap", false, 1.0);
+
+    long long numSeqs = packedDB.getNumSeqs(); double total = 0;
+    double seconds = bench.run([&] () {
+        for (long long i = 1; i < numSeqs; i++) { for (long long j = 0; j < i; j++) { total += distCalculator.calcDist(i, j); } }
+    });
+    RecordProperty("kernel", distCalculator.getKernelName());
+
+    bench.report("dist.seqs, packed onegap", (numSeqs * (numSeqs - 1)) / 2.0, seconds);
+    EXPECT_GT(total, 0);
+}
+
+TEST(Bench_Calc_Dist, stringOneGap) {
+    Benchmark bench("pairs");
+
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(500), true);
+    oneGapIgnoreTermGapDist distCalculator(1.0);
+
+    long long numSeqs = reads.size(); double total = 0;
+    double seconds = bench.run([&] () {
+        for (long long i = 1; i < numSeqs; i++) { for (long long j = 0; j < i; j++) { total += distCalculator.calcDist(reads[i], reads[j]); } }
+    });
+
+    bench.report("dist.seqs, string onegap", (numSeqs * (numSeqs - 1)) / 2.0, seconds);
+    EXPECT_GT(total, 0);
+}
+/**************************************************************************************************/
+TEST(Bench_Search_KmerDB, findClosest) {
+    Benchmark bench("queries");
+
+    vector<Sequence> refs = bench.data->getReferences(false);
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(2000), false);
+
+    KmerDB search(bench.data->getDataDir() + "bench.ref.fasta", 8);
+    for (int i = 0; i < refs.size(); i++) { search.addSequence(refs[i]); }
+    search.generateDB();
+    search.setNumSeqs(refs.size());
+
+    long long found = 0;
+    double seconds = bench.run([&] () {
+        vector<float> scores;
+        for (int i = 0; i < reads.size(); i++) { found += search.findClosestSequences(&reads[i], 1, scores).size(); }
+    });
+
+    bench.report("kmer search, 8mers", reads.size(), seconds);
+    EXPECT_GT(found, 0);
+}
+/**************************************************************************************************/
+TEST(Bench_Alignment_NeedlemanOverlap, align) {
+    Benchmark bench("cells");
+
+    vector<Sequence> refs = bench.data->getReferences(false);
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(200), false);
+
+    NeedlemanOverlap alignment(-2.0, 1.0, -1.0, bench.data->refLength + 100);
+
+    double cells = 0;
+    for (int i = 0; i < reads.size(); i++) { cells += (double)reads[i].getNumBases() * refs[i % refs.size()].getNumBases(); }
+
+    double seconds = bench.run([&] () {
+        for (int i = 0; i < reads.size(); i++) { alignment.align(reads[i].getUnaligned(), refs[i % refs.size()].getUnaligned()); }
+    });
+
+    bench.report("needleman alignment", cells, seconds);
+}
+
+TEST(Bench_Alignment_GotohOverlap, align) {
+    Benchmark bench("cells");
+
+    vector<Sequence> refs = bench.data->getReferences(false);
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(200), false);
+
+    GotohOverlap alignment(-2.0, -1.0, 1.0, -1.0, bench.data->refLength + 100);
+
+    double cells = 0;
+    for (int i = 0; i < reads.size(); i++) { cells += (double)reads[i].getNumBases() * refs[i % refs.size()].getNumBases(); }
+
+    double seconds = bench.run([&] () {
+        for (int i = 0; i < reads.size(); i++) { alignment.align(reads[i].getUnaligned(), refs[i % refs.size()].getUnaligned()); }
+    });
+
+    bench.report("gotoh alignment", cells, seconds);
+}
+/**************************************************************************************************/
+TEST(Bench_Classifier_Bayesian, classify) {
+    Benchmark bench("seqs");
+
+    string templateFile = bench.data->getReferenceFasta();
+    string taxonomyFile = bench.data->getReferenceTaxonomy();
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(500), false);
+
+    auto start = chrono::steady_clock::now();
+    Bayesian classifier(taxonomyFile, templateFile, "kmer", 8, 80, 100, bench.data->getSeed(), false, false, CurrentFile::getInstance()->getVersion());
+    RecordProperty("trainingSeconds", toString(chrono::duration<double>(chrono::steady_clock::now() - start).count()));
+
+    long long classified = 0;
+    double seconds = bench.run([&] () {
+        for (int i = 0; i < reads.size(); i++) {
+            string simpleTax = ""; bool flipped = false;
+            string tax = classifier.getTaxonomy(&reads[i], simpleTax, flipped);
+            if (tax.find("Genus") != string::npos) { classified++; }
+        }
+    });
+
+    bench.report("wang classifier, 8mers, 100 iters", reads.size(), seconds);
+    EXPECT_GT(classified, 0);
+}
+/**************************************************************************************************/
+TEST(Bench_Cluster_OptiCluster, update) {
+    Benchmark bench("moves");
+
+    int numSeqs = bench.data->scaled(20000);
+    string distFile = bench.data->getColumnDist(numSeqs, 50, 10);
+    string countFile = bench.data->getColumnCount(numSeqs);
+
+    auto start = chrono::steady_clock::now();
+    OptiMatrix matrix(distFile, countFile, "count", "column", 0.03, false);
+    RecordProperty("readSeconds", toString(chrono::duration<double>(chrono::steady_clock::now() - start).count()));
+
+    int iters = 3; double metricValue = 0.0;
+    double seconds = bench.run([&] () {
+        MCC metric;
+        OptiCluster cluster(&matrix, &metric, 0, bench.getProcessors());
+        cluster.initialize(metricValue, false, "singleton");
+        for (int i = 0; i < iters; i++) { cluster.update(metricValue); }
+    });
+
+    RecordProperty("mcc", toString(metricValue));
+    bench.report("opticluster update", (double)numSeqs * iters, seconds);
+    EXPECT_GT(metricValue, 0);
+}
+/**************************************************************************************************/
+TEST(Bench_SubSample, shared) {
+    Benchmark bench("reads");
+
+    int numGroups = bench.data->scaled(50); int readsPerGroup = 20000;
+    string sharedFile = bench.data->getShared(numGroups, 5000, readsPerGroup);
+
+    vector<string> groups;
+    InputData input(sharedFile, "sharedfile", groups);
+    SharedRAbundVectors* lookup = input.getSharedRAbundVectors();
+    ASSERT_TRUE(lookup != NULL);
+
+    int size = readsPerGroup / 2;
+    double seconds = bench.run([&] () {
+        SubSample sample;
+        SharedRAbundVectors* copy = new SharedRAbundVectors(*lookup);
+        sample.getSample(copy, size);
+        delete copy;
+    });
+    delete lookup;
+
+    bench.report("sub.sample, shared", (double)numGroups * size, seconds);
+}
+/**************************************************************************************************/
+TEST(Bench_Calc_UniFrac, weighted) {
+    Benchmark bench("comparisons");
+
+    string treeFile = bench.data->getTree(bench.data->scaled(2000), 10);
+    string countFile = bench.data->getTreeCount(bench.data->scaled(2000), 10);
+
+    TreeReader reader(treeFile, countFile);
+    vector<Tree*> trees = reader.getTrees();
+    ASSERT_EQ(1, trees.size());
+    CountTable* ct = trees[0]->getCountTable();
+    vector<string> groups = ct->getNamesOfGroups();
+
+    EstOutput scores;
+    double seconds = bench.run([&] () {
+        Weighted weighted(false, groups);
+        scores = weighted.getValues(trees[0], bench.getProcessors(), bench.data->getDataDir());
+    });
+
+    bench.report("unifrac.weighted", scores.size(), seconds);
+    EXPECT_EQ(45, scores.size());
+
+    delete ct; delete trees[0];
+}
+
+TEST(Bench_Calc_UniFrac, unweighted) {
+    Benchmark bench("comparisons");
+
+    string treeFile = bench.data->getTree(bench.data->scaled(2000), 10);
+    string countFile = bench.data->getTreeCount(bench.data->scaled(2000), 10);
+
+    TreeReader reader(treeFile, countFile);
+    vector<Tree*> trees = reader.getTrees();
+    ASSERT_EQ(1, trees.size());
+    CountTable* ct = trees[0]->getCountTable();
+    vector<string> groups = ct->getNamesOfGroups();
+
+    EstOutput scores;
+    double seconds = bench.run([&] () {
+        Unweighted unweighted(false, groups);
+        scores = unweighted.getValues(trees[0], bench.getProcessors(), bench.data->getDataDir());
+    });
+
+    bench.report("unifrac.unweighted", scores.size(), seconds);
+    EXPECT_EQ(45, scores.size());
+
+    delete ct; delete trees[0];
+}
+/**************************************************************************************************/
+TEST(Bench_TrimOligos, pairedBarcodes) {
+    Benchmark bench("pairs");
+
+    //16 x 24 dual indexed barcodes, a tenth of the reads have an error in a barcode
+    mt19937_64 engine(bench.data->getSeed());
+    const char nucleotides[4] = { 'A', 'C', 'G', 'T' };
+    vector<string> forwards, reverses;
+    for (int i = 0; i < 40; i++) {
+        string barcode(12, 'A');
+        for (int j = 0; j < 12; j++) { barcode[j] = nucleotides[engine() % 4]; }
+        if (i < 16) { forwards.push_back(barcode); } else { reverses.push_back(barcode); }
+    }
+    map<int, oligosPair> pairedBarcodes, pairedPrimers;
+    for (int i = 0; i < forwards.size(); i++) { for (int j = 0; j < reverses.size(); j++) { pairedBarcodes[i * reverses.size() + j] = oligosPair(forwards[i], reverses[j]); } }
+
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(20000), false);
+    vector<Sequence> forwardReads, reverseReads;
+    for (int i = 0; i < reads.size(); i++) {
+        string forward = forwards[engine() % forwards.size()];
+        string reverse = reverses[engine() % reverses.size()];
+        if ((engine() % 10) == 0) { forward[engine() % forward.length()] = nucleotides[engine() % 4]; }
+        if ((engine() % 10) == 0) { reverse.erase(engine() % reverse.length(), 1); }
+        forwardReads.push_back(Sequence(reads[i].getName(), forward + reads[i].getUnaligned()));
+        reverseReads.push_back(Sequence(reads[i].getName(), reverse + reads[i].getUnaligned()));
+    }
+
+    TrimOligos trimOligos(0, 1, 0, 0, pairedPrimers, pairedBarcodes, false);
+
+    long long matched = 0;
+    double seconds = bench.run([&] () {
+        for (int i = 0; i < forwardReads.size(); i++) {
+            Sequence forward = forwardReads[i]; Sequence reverse = reverseReads[i];
+            int group = -1;
+            vector<int> results = trimOligos.stripBarcode(forward, reverse, group);
+            if (results[1] == 0) { matched++; }
+        }
+    });
+
+    bench.report("make.contigs barcodes, 384 pairs, bdiffs=1", forwardReads.size(), seconds);
+    EXPECT_GT(matched, 0);
+}
+/**************************************************************************************************/
+TEST(Bench_FragmentAssembler, assemble) {
+    Benchmark bench("pairs");
+
+    //2 x 200 reads of the 250 base region, with a substitution near the 3' end of a third of the reads
+    mt19937_64 engine(bench.data->getSeed());
+    const char nucleotides[4] = { 'A', 'C', 'G', 'T' };
+    vector<Sequence> reads = bench.data->getReads(bench.data->scaled(20000), false);
+    vector<string> forwardReads, reverseReads;
+    for (int i = 0; i < reads.size(); i++) {
+        string bases = reads[i].getUnaligned();
+        int readLength = min(200, (int)bases.length());
+        string forward = bases.substr(0, readLength);
+        string reverse = bases.substr(bases.length()-readLength);
+        if ((engine() % 3) == 0) { forward[readLength - 1 - (engine() % 30)] = nucleotides[engine() % 4]; }
+        if ((engine() % 3) == 0) { reverse[engine() % 30] = nucleotides[engine() % 4]; }
+        forwardReads.push_back(forward); reverseReads.push_back(reverse);
+    }
+    vector<int> scores(200, 35);
+
+    NeedlemanOverlap alignment(-2.0, 1.0, -1.0, 1000);
+    FragmentAssembler assembler(&alignment, "needleman", 1.0, -1.0, -2.0, -1.0, 20, 6, false);
+
+    double errors = 0;
+    double seconds = bench.run([&] () {
+        for (int i = 0; i < forwardReads.size(); i++) {
+            Sequence fSeq("pair", forwardReads[i]); Sequence rSeq("pair", reverseReads[i]); rSeq.reverseComplement();
+            string contig, trashCode; int oend, oStart, numMismatches = 0;
+            vector<int> contigScores = assembler.assemble(fSeq, rSeq, scores, scores, true, contig, trashCode, oend, oStart, numMismatches);
+            errors += assembler.getExpectedErrors(contigScores);
+        }
+    });
+    RecordProperty("ungappedFraction", toString(assembler.getNumUngapped() / (double)(assembler.getNumUngapped() + assembler.getNumGapped())));
+
+    bench.report("make.contigs assembly, needleman", forwardReads.size(), seconds);
+    EXPECT_GT(assembler.getNumUngapped(), 0);
+}
+/**************************************************************************************************/
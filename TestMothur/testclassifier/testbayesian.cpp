@@ -0,0 +1,243 @@
+//
+//  testbayesian.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testbayesian.hpp"
+#include "kmer.hpp"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//a made up reference of 40 seqs in 4 genera, each genus' seqs share a 60 base start
+TestBayesian::TestBayesian() {  //setup
+    m = MothurOut::getInstance();
+    fastaFile = "testbayesian.fasta";
+    taxFile = "testbayesian.tax";
+    modelFile = "testbayesian.testbayesian.8mer.model";
+    version = "1.44.1";
+    CurrentFile::getInstance()->setVersion(version); //the tree files are written with the current version
+    
+    string genera[4] = { "Bacteria;Firmicutes;Clostridia;Clostridiales;Lachnospiraceae;Blautia;",
+                         "Bacteria;Firmicutes;Clostridia;Clostridiales;Ruminococcaceae;Anaerotruncus;",
+                         "Bacteria;Bacteroidetes;Bacteroidia;Bacteroidales;Bacteroidaceae;Bacteroides;",
+                         "Bacteria;Bacteroidetes;Bacteroidia;Bacteroidales;Porphyromonadaceae;Barnesiella;" };
+    
+    mt19937_64 engine(2468);
+    vector<string> starts(4, "");
+    ofstream fasta, tax;
+    util.openOutputFile(fastaFile, fasta); util.openOutputFile(taxFile, tax);
+    for (int i = 0; i < 40; i++) {
+        string seq = starts[i % 4];
+        seq += BenchmarkData::getRandomBases(200 - seq.length(), engine);
+        if (i < 4) { starts[i] = seq.substr(0, 60); }
+        fasta << ">seq" << i << endl << seq << endl;
+        tax << "seq" << i << '\t' << genera[i % 4] << endl;
+    }
+    fasta.close(); tax.close();
+    
+    shortcutFiles.push_back(modelFile);
+    shortcutFiles.push_back("testbayesian.testbayesian.8mer.prob");
+    shortcutFiles.push_back("testbayesian.testbayesian.8mer.numNonZero");
+    shortcutFiles.push_back("testbayesian.tree.train");
+    shortcutFiles.push_back("testbayesian.tree.sum");
+    shortcutFiles.push_back("testbayesian.8mer");
+}
+/**************************************************************************************************/
+TestBayesian::~TestBayesian() {
+    util.mothurRemove(fastaFile); util.mothurRemove(taxFile);
+    for (int i = 0; i < shortcutFiles.size(); i++) { util.mothurRemove(shortcutFiles[i]); }
+}
+/**************************************************************************************************/
+Bayesian* TestBayesian::train() {
+    return new Bayesian(taxFile, fastaFile, "kmer", 8, 80, 100, 0, false, true, version);
+}
+/**************************************************************************************************/
+vector<float> TestBayesian::getTable(Bayesian* b) {
+    return vector<float>(b->genusProbs, b->genusProbs + ((long long)b->numKmers * b->numGenera));
+}
+/**************************************************************************************************/
+vector<float> TestBayesian::getKmerProbs(Bayesian* b) {
+    vector<float> probs;
+    for (int i = 0; i < b->WordPairDiffArr.size(); i++) { probs.push_back(b->WordPairDiffArr[i].prob); }
+    return probs;
+}
+/**************************************************************************************************/
+vector<int> TestBayesian::getKmers(Bayesian* b, Sequence* seq) {
+    Kmer kmer(b->kmerSize);
+    string queryKmerString = kmer.getKmerString(seq->getUnaligned());
+    
+    vector<int> queryKmers;
+    for (int i = 0; i < queryKmerString.length()-1; i++) { if (queryKmerString[i] != '!') { queryKmers.push_back(i); } }
+    return queryKmers;
+}
+/**************************************************************************************************/
+vector< vector<float> > TestBayesian::getNestedTable(Bayesian* b) {
+    //the tree forgets the seqs' taxonomies after training, so find each seq's genus from the taxonomy file
+    map<string, string> taxonomies; util.readTax(taxFile, taxonomies, true);
+    map<string, int> genusIndex;
+    for (int k = 0; k < b->genusNodes.size(); k++) { genusIndex[b->phyloTree->get(b->genusNodes[k]).name] = k; }
+    vector<int> seqGenus;
+    for (int j = 0; j < b->names.size(); j++) {
+        vector<string> taxons; util.splitAtChar(taxonomies[b->names[j]], taxons, ';');
+        while (!taxons.empty() && (taxons.back() == "")) { taxons.pop_back(); }
+        seqGenus.push_back(genusIndex[taxons.back()]);
+    }
+    
+    vector< vector<float> > wordGenusProb(b->numKmers);
+    for (int i = 0; i < b->numKmers; i++) {
+        wordGenusProb[i].resize(b->genusNodes.size(), 0.0);
+        
+        vector<int> seqsWithWordi = b->database->getSequencesWithKmer(i);
+        vector<int> count(b->genusNodes.size(), 0);
+        for (int j = 0; j < seqsWithWordi.size(); j++) { count[seqGenus[seqsWithWordi[j]]]++; }
+        
+        float probabilityInTemplate = (seqsWithWordi.size() + 0.50) / (float) (b->names.size() + 1);
+        for (int k = 0; k < b->genusNodes.size(); k++) {
+            wordGenusProb[i][k] = log((count[k] + probabilityInTemplate) / (float) (b->genusTotals[k] + 1));
+        }
+    }
+    return wordGenusProb;
+}
+/**************************************************************************************************/
+int TestBayesian::getNestedTaxonomy(Bayesian* b, vector< vector<float> >& wordGenusProb, vector<int>& queryKmer, vector<double>& scores) {
+    int indexofGenus = 0;
+    double maxProbability = -1000000.0;
+    scores.assign(b->genusNodes.size(), 0.0);
+    for (int k = 0; k < b->genusNodes.size(); k++) {
+        double prob = 0.0000;
+        for (int i = 0; i < queryKmer.size(); i++) { prob += wordGenusProb[queryKmer[i]][k]; }
+        scores[k] = prob;
+        
+        if (prob > maxProbability) { indexofGenus = b->genusNodes[k]; maxProbability = prob; }
+    }
+    return indexofGenus;
+}
+/**************************************************************************************************/
+//the first run writes the model, the second reads it back from the mapped file
+TEST(Test_Bayesian, modelRoundTrip) {
+    TestBayesian test;
+    
+    Bayesian* trained = test.train();
+    ASSERT_TRUE(test.util.fileExists(test.modelFile));
+    EXPECT_FALSE(test.util.fileExists(test.modelFile + "." + toString(getpid()) + ".temp"));
+    vector<float> table = test.getTable(trained);
+    vector<float> kmerProbs = test.getKmerProbs(trained);
+    
+    Bayesian* fromModel = test.train();
+    EXPECT_TRUE(test.isMapped(fromModel));
+    EXPECT_EQ(table, test.getTable(fromModel));
+    EXPECT_EQ(kmerProbs, test.getKmerProbs(fromModel));
+    
+    Sequence query("query", "");
+    ifstream in; test.util.openInputFile(test.fastaFile, in);
+    for (int i = 0; i < 10; i++) {
+        Sequence seq(in); test.util.gobble(in);
+        Sequence other = seq;
+        string simpleA, simpleB; bool flipped;
+        EXPECT_EQ(trained->getTaxonomy(&seq, simpleA, flipped), fromModel->getTaxonomy(&other, simpleB, flipped));
+    }
+    in.close();
+    
+    delete trained; delete fromModel;
+}
+/**************************************************************************************************/
+//a model that doesn't match the tree is not used, the probabilities come from the .prob files and the model is rewritten
+TEST(Test_Bayesian, staleModel) {
+    TestBayesian test;
+    
+    Bayesian* trained = test.train();
+    vector<float> table = test.getTable(trained);
+    vector<float> kmerProbs = test.getKmerProbs(trained);
+    
+    //change the first genus total
+    fstream model(test.modelFile.c_str(), ios::in | ios::out | ios::binary);
+    string line; getline(model, line);
+    unsigned long long totalsStart = (((line.length() + 1 + 7) / 8) * 8) + 8 + 2*sizeof(unsigned int) + 2*sizeof(unsigned long long) + 4*sizeof(int);
+    int total = 1000; model.seekp(totalsStart); model.write((char*)&total, sizeof(int));
+    model.close();
+    EXPECT_FALSE(test.readModel(trained, test.modelFile));
+    
+    Bayesian* fromProbFiles = test.train();
+    EXPECT_FALSE(test.isMapped(fromProbFiles));
+    vector<float> readTable = test.getTable(fromProbFiles);
+    ASSERT_EQ(table.size(), readTable.size());
+    for (long long i = 0; i < table.size(); i += 97) { EXPECT_NEAR(table[i], readTable[i], 1e-4); } //the .prob file is text
+    EXPECT_EQ(kmerProbs.size(), test.getKmerProbs(fromProbFiles).size());
+    
+    EXPECT_TRUE(test.readModel(trained, test.modelFile)); //rewritten from the .prob files
+    
+    delete trained; delete fromProbFiles;
+}
+/**************************************************************************************************/
+//with .prob files from an older version there is nothing to read the probabilities from, so they are calculated again
+TEST(Test_Bayesian, staleModelAndProbFiles) {
+    TestBayesian test;
+    
+    Bayesian* trained = test.train();
+    vector<float> table = test.getTable(trained);
+    delete trained;
+    
+    //change the first genus total and make the .prob files older
+    fstream model(test.modelFile.c_str(), ios::in | ios::out | ios::binary);
+    string line; getline(model, line);
+    unsigned long long totalsStart = (((line.length() + 1 + 7) / 8) * 8) + 8 + 2*sizeof(unsigned int) + 2*sizeof(unsigned long long) + 4*sizeof(int);
+    int total = 1000; model.seekp(totalsStart); model.write((char*)&total, sizeof(int));
+    model.close();
+    for (int i = 1; i < 3; i++) {
+        ofstream out; test.util.openOutputFile(test.shortcutFiles[i], out);
+        out << "#1.40.0" << endl;
+        out.close();
+    }
+    
+    Bayesian* retrained = test.train();
+    EXPECT_FALSE(test.m->getControl_pressed());
+    EXPECT_EQ(table, test.getTable(retrained));
+    EXPECT_TRUE(test.readModel(retrained, test.modelFile)); //written again
+    
+    delete retrained;
+}
+/**************************************************************************************************/
+//the flat table holds the same probabilities as the nested one it replaced, and the genus scores are added up in the
+//same order, so the taxonomy and scores are identical for whole queries and for bootstrap samples of their kmers
+TEST(Test_Bayesian, flatTableMatchesNested) {
+    TestBayesian test;
+    
+    Bayesian* trained = test.train();
+    vector< vector<float> > nested = test.getNestedTable(trained);
+    vector<float> table = test.getTable(trained);
+    ASSERT_FALSE(nested.empty());
+    ASSERT_EQ(nested.size() * nested[0].size(), table.size());
+    
+    long long numDifferent = 0;
+    for (long long i = 0; i < nested.size(); i++) {
+        for (int k = 0; k < nested[i].size(); k++) { if (nested[i][k] != table[i * nested[i].size() + k]) { numDifferent++; } }
+    }
+    EXPECT_EQ(0, numDifferent);
+    
+    mt19937_64 engine(97531);
+    ifstream in; test.util.openInputFile(test.fastaFile, in);
+    while (!in.eof()) {
+        Sequence seq(in); test.util.gobble(in);
+        if (seq.getName() == "") { continue; }
+        
+        vector<int> kmers = test.getKmers(trained, &seq);
+        for (int i = 0; i < 10; i++) {
+            vector<int> sample = kmers;
+            if (i != 0) { //a bootstrap sample
+                sample.resize(kmers.size() / 8);
+                for (int j = 0; j < sample.size(); j++) { sample[j] = kmers[BenchmarkData::draw(engine, kmers.size())]; }
+            }
+            
+            vector<double> scores(nested[0].size(), 0.0), nestedScores;
+            EXPECT_EQ(test.getNestedTaxonomy(trained, nested, sample, nestedScores), test.getTaxonomy(trained, sample, scores));
+            EXPECT_EQ(nestedScores, scores);
+        }
+    }
+    in.close();
+    
+    delete trained;
+}
+/**************************************************************************************************/
@@ -0,0 +1,42 @@
+//
+//  testbayesian.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testbayesian_hpp
+#define testbayesian_hpp
+
+#include "gtest/gtest.h"
+#include "bayesian.h"
+
+class TestBayesian {
+    
+public:
+    
+    TestBayesian();
+    ~TestBayesian();
+    
+    Bayesian* train();  //builds the classifier from the reference, reading the shortcut files if they are there
+    
+    vector<float> getTable(Bayesian*);      //kmer by genus probabilities, from the table or the mapped model
+    vector<float> getKmerProbs(Bayesian*);
+    bool readModel(Bayesian* b, string name)    { return b->readModelFile(name);    }
+    bool isMapped(Bayesian* b)                  { return (b->mappedModel != NULL);  }
+    vector<int> getKmers(Bayesian*, Sequence*);  //the kmers in the query, the way getTaxonomy finds them
+    int getTaxonomy(Bayesian* b, vector<int>& kmers, vector<double>& scores) { return b->getMostProbableTaxonomy(kmers, scores); }
+    
+    //the table and scores the way they were found before the table was flattened, one vector of genus probabilities per kmer
+    vector< vector<float> > getNestedTable(Bayesian*);
+    int getNestedTaxonomy(Bayesian*, vector< vector<float> >&, vector<int>&, vector<double>&);
+    
+    MothurOut* m;
+    Utils util;
+    string fastaFile, taxFile, modelFile, version;
+    vector<string> shortcutFiles;
+    
+};
+
+#endif /* testbayesian_hpp */
@@ -0,0 +1,180 @@
+//
+//  testalignseqscommand.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testalignseqscommand.h"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//a made up template of 20 aligned seqs and 600 reads taken from them. Every 11th read is reversed so align.seqs flips
+//it, and a few are random so they align badly either way
+TestAlignSeqsIntegration::TestAlignSeqsIntegration() {  //setup
+    m = MothurOut::getInstance();
+    fastaFile = "testalignseqs.fasta";
+    templateFile = "testalignseqs.template.align";
+    numSeqs = 600;
+    CurrentFile::getInstance()->setVersion("1.44.1"); //the kmer shortcut file is written with the current version
+
+    tempFiles.push_back(fastaFile); tempFiles.push_back(templateFile); tempFiles.push_back("testalignseqs.template.8mer");
+
+    string bases = "ACGT";
+    mt19937_64 engine(1357);
+    vector<string> templates;
+    ofstream out;
+    util.openOutputFile(templateFile, out);
+    for (int i = 0; i < 20; i++) {
+        string aligned = BenchmarkData::getRandomBases(360, engine);
+        for (int j = 5; j < aligned.length(); j += 6) { aligned[j] = '-'; }
+        out << ">template" << i << endl << aligned << endl;
+        templates.push_back(Sequence("template", aligned).getUnaligned());
+    }
+    out.close();
+
+    util.openOutputFile(fastaFile, out);
+    for (int i = 0; i < numSeqs; i++) {
+        string seq = templates[i % 20].substr(10 + (i % 7), 250);
+        for (int j = (i % 37); j < seq.length(); j += 37) { seq[j] = bases[(i + j) % 4]; }
+        if ((i % 2) == 1) { seq.insert(100, "A"); }
+
+        if ((i % 50) == 13) {
+            seq = BenchmarkData::getRandomBases(200, engine);
+        }else if ((i % 11) == 0) {
+            Sequence reversed("reversed", seq); reversed.reverseComplement(); seq = reversed.getUnaligned();
+        }
+        out << ">read" << i << endl << seq << endl;
+    }
+    out.close();
+}
+/**************************************************************************************************/
+TestAlignSeqsIntegration::~TestAlignSeqsIntegration() {
+    for (int i = 0; i < tempFiles.size(); i++) { util.mothurRemove(tempFiles[i]); }
+}
+/**************************************************************************************************/
+string TestAlignSeqsIntegration::readFile(string filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    ostringstream contents; contents << in.rdbuf();
+    return contents.str();
+}
+/**************************************************************************************************/
+long long TestAlignSeqsIntegration::align(int processors, string root, bool cancel) {
+    AlignCommand command("fasta=" + fastaFile + ", reference=" + templateFile);
+    command.processors = processors;
+    command.templateDB = new AlignmentDB(templateFile, command.search, command.kmerSize, command.gapOpen, command.gapExtend, command.match, command.misMatch, 0, true);
+
+    string alignFile = root + ".align"; string reportFile = root + ".align_report"; string accnosFile = root + ".flip.accnos";
+    tempFiles.push_back(alignFile); tempFiles.push_back(reportFile); tempFiles.push_back(accnosFile);
+    util.mothurRemove(alignFile);
+
+    //stops the command as soon as the writer has written some of the alignments
+    std::thread* canceller = NULL;
+    if (cancel) {
+        canceller = new std::thread([this, alignFile] () {
+            for (int i = 0; i < 10000; i++) {
+                ifstream in(alignFile.c_str(), ios::binary | ios::ate);
+                if (in && (in.tellg() > 0)) { break; }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            m->setControl_pressed(true);
+        });
+    }
+
+    vector<long long> numFlipped(2, 0);
+    long long num = command.createProcesses(alignFile, reportFile, accnosFile, fastaFile, numFlipped);
+
+    if (canceller != NULL) { canceller->join(); delete canceller; m->setControl_pressed(false); }
+    delete command.templateDB;
+
+    return num;
+}
+/**************************************************************************************************/
+void TestAlignSeqsIntegration::alignSerial(string& aligned, string& report, string& accnos) {
+    AlignCommand command("fasta=" + fastaFile + ", reference=" + templateFile);
+    AlignmentDB templateDB(templateFile, command.search, command.kmerSize, command.gapOpen, command.gapExtend, command.match, command.misMatch, 0, true);
+    NeedlemanOverlap alignment(command.gapOpen, command.match, command.misMatch, templateDB.getLongestBase());
+
+    NastReport nastReport;
+    aligned = ""; report = nastReport.getHeaders(); accnos = "";
+
+    ifstream in;
+    util.openInputFile(fastaFile, in);
+    while (!in.eof()) {
+        Sequence candidate(in); util.gobble(in);
+        if (candidate.getName() == "") { continue; }
+
+        nastReport.setCandidate(&candidate);
+        string originalUnaligned = candidate.getUnaligned();
+        int numBasesNeeded = candidate.getNumBases() * command.threshold;
+        if (originalUnaligned.length()+1 > alignment.getnRows()) { alignment.resize(originalUnaligned.length()+2); }
+
+        float searchScore;
+        Sequence templateSeq = templateDB.findClosestSequence(&candidate, searchScore);
+        Nast* nast = new Nast(&alignment, &candidate, &templateSeq);
+
+        //nast keeps pointers to the reversed seq and its template, they are used by the report
+        Sequence copy(candidate.getName(), originalUnaligned); copy.reverseComplement();
+        Sequence templateSeq2;
+        if ((candidate.getNumBases() < numBasesNeeded) && command.flip) {
+            templateSeq2 = templateDB.findClosestSequence(&copy, searchScore);
+            Nast* nast2 = new Nast(&alignment, &copy, &templateSeq2);
+
+            if (copy.getNumBases() > candidate.getNumBases()) {
+                candidate.setAligned(copy.getAligned());
+                templateSeq = templateSeq2;
+                delete nast; nast = nast2;
+                accnos += candidate.getName() + '\n';
+            }else { delete nast2; }
+        }
+
+        nastReport.setTemplate(&templateSeq);
+        nastReport.setSearchParameters(command.search, searchScore);
+        nastReport.setAlignmentParameters("", &alignment); //align.seqs doesn't fill in the method
+        nastReport.setNastParameters(*nast);
+
+        aligned += '>' + candidate.getName() + '\n' + candidate.getAligned() + '\n';
+        report += nastReport.getReport();
+        delete nast;
+    }
+    in.close();
+}
+/**************************************************************************************************/
+TEST(Test_Command_AlignSeqs, pipelineMatchesSerial) {
+    TestAlignSeqsIntegration test;
+
+    string aligned, report, accnos;
+    test.alignSerial(aligned, report, accnos);
+    ASSERT_NE("", accnos); //some reads were flipped
+
+    int processors[3] = { 1, 3, 4 };
+    for (int i = 0; i < 3; i++) {
+        string root = "testalignseqs.p" + toString(processors[i]);
+        EXPECT_EQ(test.numSeqs, test.align(processors[i], root));
+        EXPECT_EQ(aligned, test.readFile(root + ".align"));
+        EXPECT_EQ(report, test.readFile(root + ".align_report"));
+        EXPECT_EQ(accnos, test.readFile(root + ".flip.accnos"));
+    }
+}
+/**************************************************************************************************/
+//a stopped command returns without waiting on the queues, and what was written is the start of the serial output
+TEST(Test_Command_AlignSeqs, pipelineCancels) {
+    TestAlignSeqsIntegration test;
+
+    string aligned, report, accnos;
+    test.alignSerial(aligned, report, accnos);
+
+    int processors[2] = { 1, 3 };
+    for (int i = 0; i < 2; i++) {
+        string root = "testalignseqs.cancel.p" + toString(processors[i]);
+        long long num = test.align(processors[i], root, true);
+        EXPECT_LT(num, test.numSeqs);
+        EXPECT_FALSE(test.m->getControl_pressed());
+
+        string written = test.readFile(root + ".align");
+        EXPECT_EQ(num, count(written.begin(), written.end(), '>'));
+        EXPECT_EQ(aligned.substr(0, written.length()), written);
+    }
+}
+/**************************************************************************************************/
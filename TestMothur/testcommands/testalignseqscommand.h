@@ -0,0 +1,38 @@
+//
+//  testalignseqscommand.h
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testalignseqscommand_h
+#define testalignseqscommand_h
+
+#include "gtest/gtest.h"
+#include "aligncommand.h"
+
+class TestAlignSeqsIntegration {
+
+public:
+
+    TestAlignSeqsIntegration();
+    ~TestAlignSeqsIntegration();
+
+    //runs the reader, aligner and writer pipeline, returns the number of seqs written
+    long long align(int, string, bool cancel=false); //processors, root of the output files, cancel once output is written
+
+    //aligns the seqs one at a time in file order, the way align.seqs did before the pipeline
+    void alignSerial(string&, string&, string&); //fills aligned, report, accnos
+
+    string readFile(string);
+
+    MothurOut* m;
+    Utils util;
+    string fastaFile, templateFile;
+    int numSeqs;
+    vector<string> tempFiles;
+
+};
+
+#endif /* testalignseqscommand_h */
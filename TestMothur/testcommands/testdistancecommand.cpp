@@ -0,0 +1,148 @@
+//
+//  testdistancecommand.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testdistancecommand.h"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//150 aligned seqs made from 10 parents with up to 28 of their bases changed, so some pairs are under a 0.10 cutoff
+TestDistanceCommand::TestDistanceCommand() {  //setup
+    m = MothurOut::getInstance();
+    fastaFile = "testdistance.fasta";
+
+    mt19937_64 engine(8642);
+    vector<string> parents;
+    for (int i = 0; i < 10; i++) {
+        string parent = BenchmarkData::getRandomBases(400, engine);
+        for (int j = 4; j < parent.length(); j += 9) { parent[j] = '-'; }
+        parents.push_back(parent);
+    }
+
+    ofstream out;
+    util.openOutputFile(fastaFile, out);
+    for (int i = 0; i < 150; i++) {
+        string seq = BenchmarkData::substitute(parents[i % 10], (i / 10) * 2, engine);
+        if ((i % 7) == 3) { seq = "...." + seq.substr(4, 380) + "................"; } //end gaps
+        out << ">seq" << i << endl << seq << endl;
+    }
+    out.close();
+}
+/**************************************************************************************************/
+TestDistanceCommand::~TestDistanceCommand() {
+    util.mothurRemove(fastaFile);
+}
+/**************************************************************************************************/
+vector<int> TestDistanceCommand::getTileCoverage(long long numRows, long long numCols, bool lowerTriangle, long long tileSize, long long numNewFasta) {
+    DistanceCommand command("fasta=" + fastaFile);
+    command.numNewFasta = numNewFasta;
+
+    DistanceTiles tiles;
+    command.fillTiles(tiles, numRows, numCols, lowerTriangle, tileSize);
+
+    //step through the tiles the way the column drivers do
+    vector<int> coverage(numRows * numCols, 0);
+    distanceTile tile; long long tileNum = 0;
+    while (tiles.getNext(tile, tileNum)) {
+        for (long long i = tile.rowStart; i < tile.rowEnd; i++) {
+            long long colEnd = tile.colEnd;
+            if (lowerTriangle) { colEnd = min(i, tile.colEnd); }
+
+            for (long long j = tile.colStart; j < colEnd; j++) {
+                if (lowerTriangle && (i >= numNewFasta) && (j >= numNewFasta)) { break; }
+                coverage[i * numCols + j]++;
+            }
+        }
+    }
+    return coverage;
+}
+/**************************************************************************************************/
+map< pair<string, string>, float > TestDistanceCommand::getRowDistances(float cutoff) {
+    vector<Sequence> seqs;
+    ifstream in;
+    util.openInputFile(fastaFile, in);
+    while (!in.eof()) {
+        Sequence seq(in); util.gobble(in);
+        if (seq.getName() != "") { seqs.push_back(seq); }
+    }
+    in.close();
+
+    oneGapDist distCalculator(cutoff);
+    map< pair<string, string>, float > dists;
+    for (int i = 0; i < seqs.size(); i++) {
+        for (int j = 0; j < i; j++) {
+            double dist = distCalculator.calcDist(seqs[i], seqs[j]);
+            if (dist <= cutoff) { dists[make_pair(seqs[i].getName(), seqs[j].getName())] = dist; }
+        }
+    }
+    return dists;
+}
+/**************************************************************************************************/
+map< pair<string, string>, float > TestDistanceCommand::readColumn(string filename) {
+    map< pair<string, string>, float > dists;
+    ifstream in;
+    util.openInputFile(filename, in);
+    while (!in.eof()) {
+        string nameA, nameB; float dist;
+        in >> nameA >> nameB >> dist; util.gobble(in);
+        if (nameA != "") { dists[make_pair(nameA, nameB)] = dist; }
+    }
+    in.close();
+    return dists;
+}
+/**************************************************************************************************/
+//every pair of the lower triangle, or the rectangle for fitcalc, is compared exactly once
+TEST(Test_Command_DistSeqs, tilesCoverPairs) {
+    TestDistanceCommand test;
+
+    long long numRows = 150;
+    long long tileSizes[4] = { 1, 7, 16, 150 };
+    long long numNew[2] = { 150, 40 }; //40 new seqs appended to 110 old ones, the old pairs are already in the column file
+    for (int t = 0; t < 4; t++) {
+        for (int n = 0; n < 2; n++) {
+            vector<int> coverage = test.getTileCoverage(numRows, numRows, true, tileSizes[t], numNew[n]);
+            long long numWrong = 0;
+            for (long long i = 0; i < numRows; i++) {
+                for (long long j = 0; j < numRows; j++) {
+                    int expected = ((j < i) && ((i < numNew[n]) || (j < numNew[n]))) ? 1 : 0;
+                    if (coverage[i * numRows + j] != expected) { numWrong++; }
+                }
+            }
+            EXPECT_EQ(0, numWrong);
+        }
+
+        vector<int> coverage = test.getTileCoverage(60, numRows, false, tileSizes[t], numRows);
+        EXPECT_EQ(vector<int>(60 * numRows, 1), coverage);
+    }
+}
+/**************************************************************************************************/
+//the tiled column file holds the same distances as comparing the seqs a row at a time, for any number of processors
+TEST(Test_Command_DistSeqs, columnMatchesRows) {
+    TestDistanceCommand test;
+
+    map< pair<string, string>, float > expected = test.getRowDistances(0.10);
+    ASSERT_GT(expected.size(), 100);
+    ASSERT_LT(expected.size(), 150 * 149 / 2); //some pairs are above the cutoff
+
+    int processors[2] = { 1, 3 };
+    for (int p = 0; p < 2; p++) {
+        DistanceCommand command("fasta=" + test.fastaFile + ", cutoff=0.10, output=column, processors=" + toString(processors[p]));
+        command.execute();
+
+        string distFile = "testdistance.dist";
+        map< pair<string, string>, float > dists = test.readColumn(distFile);
+        test.util.mothurRemove(distFile);
+
+        ASSERT_EQ(expected.size(), dists.size());
+        for (map< pair<string, string>, float >::iterator it = expected.begin(); it != expected.end(); it++) {
+            map< pair<string, string>, float >::iterator itFound = dists.find(it->first);
+            ASSERT_TRUE(itFound != dists.end()) << it->first.first << " " << it->first.second;
+            EXPECT_NEAR(it->second, itFound->second, 1e-6);
+        }
+    }
+}
+/**************************************************************************************************/
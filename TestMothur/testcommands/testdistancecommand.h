@@ -0,0 +1,35 @@
+//
+//  testdistancecommand.h
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testdistancecommand_h
+#define testdistancecommand_h
+
+#include "gtest/gtest.h"
+#include "distancecommand.h"
+
+class TestDistanceCommand {
+
+public:
+
+    TestDistanceCommand();
+    ~TestDistanceCommand();
+
+    //the number of times the tiles' pairs are compared, numRows * numCols counts in row order
+    vector<int> getTileCoverage(long long, long long, bool, long long, long long); //numRows, numCols, lowerTriangle, tileSize, numNewFasta
+
+    //the distances under the cutoff comparing each row to the rows before it, the way dist.seqs did before the tiles
+    map< pair<string, string>, float > getRowDistances(float);
+    map< pair<string, string>, float > readColumn(string);
+
+    MothurOut* m;
+    Utils util;
+    string fastaFile;
+
+};
+
+#endif /* testdistancecommand_h */
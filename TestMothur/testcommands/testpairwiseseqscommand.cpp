@@ -0,0 +1,198 @@
+//
+//  testpairwiseseqscommand.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testpairwiseseqscommand.h"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//60 unaligned reads made from 6 parents with some of their bases changed or deleted, so the reads have different
+//lengths and some pairs are under a 0.10 cutoff
+TestPairwiseSeqsCommand::TestPairwiseSeqsCommand() {  //setup
+    m = MothurOut::getInstance();
+    fastaFile = "testpairwise.fasta";
+
+    mt19937_64 engine(9753);
+    vector<string> parents;
+    for (int i = 0; i < 6; i++) { parents.push_back(BenchmarkData::getRandomBases(220, engine)); }
+
+    ofstream out;
+    util.openOutputFile(fastaFile, out);
+    for (int i = 0; i < 60; i++) {
+        Sequence read("read", BenchmarkData::mutate(parents[i % 6], (i / 6) * 0.005, engine)); //deleted bases are gaps
+        string seq = read.getUnaligned();
+        if ((i % 7) == 3) { seq = seq.substr(15); } //shorter reads
+        names.push_back("read" + toString(i));
+        out << ">" << names.back() << endl << seq << endl;
+    }
+    out.close();
+}
+/**************************************************************************************************/
+TestPairwiseSeqsCommand::~TestPairwiseSeqsCommand() {
+    util.mothurRemove(fastaFile);
+}
+/**************************************************************************************************/
+vector< vector<double> > TestPairwiseSeqsCommand::getPairDistances(string align, string calc, bool countends, float cutoff) {
+    vector<Sequence> seqs;
+    int longestBase = 0;
+    ifstream in;
+    util.openInputFile(fastaFile, in);
+    while (!in.eof()) {
+        Sequence seq(in); util.gobble(in);
+        if (seq.getName() != "") { seqs.push_back(seq); longestBase = max(longestBase, (int)seq.getUnaligned().length()+1); }
+    }
+    in.close();
+
+    Alignment* alignment;
+    if (align == "gotoh")   { alignment = new GotohOverlap(-2.0, -1.0, 1.0, -1.0, longestBase);   }
+    else                    { alignment = new NeedlemanOverlap(-2.0, 1.0, -1.0, longestBase);     }
+
+    DistCalc* distCalculator;
+    if (countends) {
+        if (calc == "eachgap")  { distCalculator = new eachGapDist(cutoff); }
+        else                    { distCalculator = new oneGapDist(cutoff);  }
+    }else {
+        if (calc == "eachgap")  { distCalculator = new eachGapIgnoreTermGapDist(cutoff);  }
+        else                    { distCalculator = new oneGapIgnoreTermGapDist(cutoff);   }
+    }
+
+    vector< vector<double> > dists(seqs.size());
+    for (int i = 0; i < seqs.size(); i++) {
+        for (int j = 0; j < i; j++) {
+            Sequence seqI = seqs[i];
+            Sequence seqJ = seqs[j];
+
+            alignment->align(seqI.getUnaligned(), seqJ.getUnaligned());
+            seqI.setAligned(alignment->getSeqAAln());
+            seqJ.setAligned(alignment->getSeqBAln());
+
+            dists[i].push_back(distCalculator->calcDist(seqI, seqJ));
+        }
+    }
+
+    delete alignment;
+    delete distCalculator;
+
+    return dists;
+}
+/**************************************************************************************************/
+map< pair<string, string>, string > TestPairwiseSeqsCommand::getColumn(vector< vector<double> >& dists, float cutoff) {
+    map< pair<string, string>, string > column;
+    for (int i = 0; i < dists.size(); i++) {
+        for (int j = 0; j < i; j++) {
+            if (dists[i][j] <= cutoff) { column[make_pair(names[i], names[j])] = toString(dists[i][j]); }
+        }
+    }
+    return column;
+}
+/**************************************************************************************************/
+map< pair<string, string>, string > TestPairwiseSeqsCommand::readColumn(string filename) {
+    map< pair<string, string>, string > column;
+    ifstream in;
+    util.openInputFile(filename, in);
+    while (!in.eof()) {
+        string nameA, nameB, dist;
+        in >> nameA >> nameB >> dist; util.gobble(in);
+        if (nameA != "") { column[make_pair(nameA, nameB)] = dist; }
+    }
+    in.close();
+    return column;
+}
+/**************************************************************************************************/
+string TestPairwiseSeqsCommand::getLt(vector< vector<double> >& dists) {
+    ostringstream out;
+    out.setf(ios::fixed, ios::showpoint);
+    out << setprecision(4);
+
+    out << dists.size() << endl;
+    for (int i = 0; i < dists.size(); i++) {
+        string name = names[i];
+        while (name.length() < 10) { name += " "; }
+        out << name;
+        for (int j = 0; j < i; j++) { out << '\t' << dists[i][j]; }
+        out << endl;
+    }
+    return out.str();
+}
+/**************************************************************************************************/
+string TestPairwiseSeqsCommand::readFile(string filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    ostringstream contents; contents << in.rdbuf();
+    return contents.str();
+}
+/**************************************************************************************************/
+//the workspaces give the same column file as aligning fresh copies of each pair, for any number of processors
+TEST(Test_Command_PairwiseSeqs, columnMatchesPairs) {
+    TestPairwiseSeqsCommand test;
+
+    string options[2] = { "", ", align=gotoh, calc=eachgap, countends=F" };
+    string aligns[2] = { "needleman", "gotoh" };
+    string calcs[2] = { "onegap", "eachgap" };
+    bool countends[2] = { true, false };
+
+    for (int o = 0; o < 2; o++) {
+        vector< vector<double> > dists = test.getPairDistances(aligns[o], calcs[o], countends[o], 0.10);
+        map< pair<string, string>, string > expected = test.getColumn(dists, 0.10);
+        ASSERT_GT(expected.size(), 50);
+        ASSERT_LT(expected.size(), 60 * 59 / 2); //some pairs are above the cutoff
+
+        int processors[2] = { 1, 3 };
+        for (int p = 0; p < 2; p++) {
+            PairwiseSeqsCommand command("fasta=" + test.fastaFile + ", cutoff=0.10, output=column, processors=" + toString(processors[p]) + options[o]);
+            command.execute();
+
+            string distFile = "testpairwise.dist";
+            map< pair<string, string>, string > column = test.readColumn(distFile);
+            test.util.mothurRemove(distFile);
+
+            EXPECT_EQ(expected, column);
+        }
+    }
+}
+/**************************************************************************************************/
+//the lower triangle and binary files hold the same distances as the pairs
+TEST(Test_Command_PairwiseSeqs, ltAndBinaryMatchPairs) {
+    TestPairwiseSeqsCommand test;
+
+    vector< vector<double> > dists = test.getPairDistances("needleman", "onegap", true, 1.0);
+    string expected = test.getLt(dists);
+
+    int processors[2] = { 1, 3 };
+    for (int p = 0; p < 2; p++) {
+        PairwiseSeqsCommand command("fasta=" + test.fastaFile + ", output=lt, processors=" + toString(processors[p]));
+        command.execute();
+
+        string distFile = "testpairwise.phylip.dist";
+        EXPECT_EQ(expected, test.readFile(distFile));
+        test.util.mothurRemove(distFile);
+    }
+
+    vector< vector<double> > cutoffDists = test.getPairDistances("needleman", "onegap", true, 0.10);
+    for (int p = 0; p < 2; p++) {
+        PairwiseSeqsCommand command("fasta=" + test.fastaFile + ", cutoff=0.10, output=binary, processors=" + toString(processors[p]));
+        command.execute();
+
+        string distFile = "testpairwise.bdist";
+        BinaryDistFile binDist;
+        ASSERT_TRUE(binDist.read(distFile));
+        test.util.mothurRemove(distFile);
+
+        map< pair<string, string>, string > expectedColumn = test.getColumn(cutoffDists, 0.10);
+        ASSERT_EQ(expectedColumn.size(), binDist.getNumDists());
+
+        map<string, int> indexes;
+        for (int i = 0; i < test.names.size(); i++) { indexes[test.names[i]] = i; }
+
+        string nameA, nameB; float dist;
+        while (binDist.getNext(nameA, nameB, dist)) {
+            int i = indexes[nameA]; int j = indexes[nameB];
+            if (i < j) { swap(i, j); }
+            EXPECT_FLOAT_EQ((float)cutoffDists[i][j], dist) << nameA << " " << nameB;
+        }
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,40 @@
+//
+//  testpairwiseseqscommand.h
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testpairwiseseqscommand_h
+#define testpairwiseseqscommand_h
+
+#include "gtest/gtest.h"
+#include "pairwiseseqscommand.h"
+
+class TestPairwiseSeqsCommand {
+
+public:
+
+    TestPairwiseSeqsCommand();
+    ~TestPairwiseSeqsCommand();
+
+    //aligns each pair with fresh copies of the seqs, the way pairwise.seqs did before the per thread workspaces
+    //returns the lower triangle, row i holds the distances to seqs 0 to i-1
+    vector< vector<double> > getPairDistances(string, string, bool, float); //align, calc, countends, cutoff
+
+    //the column file the pair distances make, nameI nameJ dist for the dists under the cutoff
+    map< pair<string, string>, string > getColumn(vector< vector<double> >&, float);
+    map< pair<string, string>, string > readColumn(string);
+
+    string getLt(vector< vector<double> >&);  //the lower triangle phylip file the pair distances make
+    string readFile(string);
+
+    MothurOut* m;
+    Utils util;
+    string fastaFile;
+    vector<string> names;
+
+};
+
+#endif /* testpairwiseseqscommand_h */
@@ -0,0 +1,139 @@
+//
+//  testbinarydistfile.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testbinarydistfile.hpp"
+
+/**************************************************************************************************/
+TestBinaryDistFile::TestBinaryDistFile() {  //setup
+    m = MothurOut::getInstance();
+    filename = "testbinarydistfile.bdist";
+    
+    vector<string> names;
+    names.push_back("seq1"); names.push_back("seq2"); names.push_back("seq3"); names.push_back("seq4");
+    binDist.setNames(names);
+    
+    binDist.add(3, 1, 0.025);
+    binDist.add(0, 2, 0.01); //stored as row 2, column 0
+    binDist.add(1, 0, 0.03);
+    binDist.add(3, 0, 0.0012345);
+    binDist.add(1, 3, 0.5); //seq2 seq4 again, the first distance is kept
+}
+/**************************************************************************************************/
+TestBinaryDistFile::~TestBinaryDistFile() { util.mothurRemove(filename); }
+/**************************************************************************************************/
+TEST(Test_Container_BinaryDistFile, finalize) {
+    TestBinaryDistFile test;
+    
+    test.binDist.finalize();
+    
+    EXPECT_EQ(4, test.binDist.getNumSeqs());
+    EXPECT_EQ(4, test.binDist.getNumDists());
+    EXPECT_EQ(0, test.binDist.getRowStart(0));
+    EXPECT_EQ(0, test.binDist.getRowStart(1));
+    EXPECT_EQ(1, test.binDist.getRowStart(2));
+    EXPECT_EQ(2, test.binDist.getRowStart(3));
+    EXPECT_EQ(4, test.binDist.getRowStart(4));
+    EXPECT_EQ(0, test.binDist.getCol(2));
+    EXPECT_EQ(1, test.binDist.getCol(3));
+    EXPECT_FLOAT_EQ(0.025, test.binDist.getDist(3));
+    
+    string nameA, nameB; float dist;
+    EXPECT_EQ(true, test.binDist.getNext(nameA, nameB, dist));
+    EXPECT_EQ("seq2", nameA);
+    EXPECT_EQ("seq1", nameB);
+    EXPECT_FLOAT_EQ(0.03, dist);
+}
+
+TEST(Test_Container_BinaryDistFile, readWrite) {
+    TestBinaryDistFile test;
+    
+    EXPECT_EQ(true, test.binDist.write(test.filename));
+    EXPECT_EQ(true, BinaryDistFile::isBinary(test.filename));
+    
+    BinaryDistFile readDist;
+    EXPECT_EQ(true, readDist.read(test.filename));
+    EXPECT_EQ(4, readDist.getNumDists());
+    EXPECT_EQ("seq4", readDist.getName(3));
+    for (int k = 0; k < 4; k++) {
+        EXPECT_EQ(test.binDist.getCol(k), readDist.getCol(k));
+        EXPECT_FLOAT_EQ(test.binDist.getDist(k), readDist.getDist(k));
+    }
+    
+    //16 bit distances keep about 3 significant digits
+    EXPECT_EQ(true, test.binDist.write(test.filename, 16));
+    EXPECT_EQ(true, readDist.read(test.filename));
+    for (int k = 0; k < 4; k++) {
+        EXPECT_NEAR(test.binDist.getDist(k), readDist.getDist(k), test.binDist.getDist(k) * 0.001);
+    }
+}
+
+TEST(Test_Container_BinaryDistFile, spilledRuns) {
+    TestBinaryDistFile test;
+    
+    vector<string> names;
+    for (int i = 0; i < 50; i++) { names.push_back("seq" + toString(i)); }
+    string memoryFile = test.filename + ".memory";
+    
+    for (int precision = 16; precision <= 32; precision += 16) {
+        //two threads' worth of distances, spilled every 7 distances
+        BinaryDistFile inMemory, spilled, other;
+        inMemory.setNames(names); spilled.setNames(names);
+        spilled.setRunFile(test.filename + ".run", 7); other.setRunFile(test.filename + "1.run", 7);
+        for (int i = 0; i < 50; i++) {
+            for (int j = 0; j < i; j++) {
+                if (((i * j) % 3) == 0) { continue; }
+                float dist = ((i + j) % 10) / 100.0;
+                inMemory.add(i, j, dist);
+                if ((i % 2) == 0) { spilled.add(j, i, dist); }
+                else { other.add(i, j, dist); }
+            }
+        }
+        spilled.add(4, 1, 0.5); //repeated pair, the first distance is kept
+        spilled.append(other);
+        
+        EXPECT_EQ(true, inMemory.write(memoryFile, precision));
+        EXPECT_EQ(true, spilled.write(test.filename, precision));
+        
+        ifstream a(memoryFile.c_str(), ios::binary), b(test.filename.c_str(), ios::binary);
+        string bytesA((istreambuf_iterator<char>(a)), istreambuf_iterator<char>());
+        string bytesB((istreambuf_iterator<char>(b)), istreambuf_iterator<char>());
+        EXPECT_EQ(bytesA, bytesB);
+        
+        EXPECT_EQ(false, test.util.fileExists(test.filename + ".run0.temp"));
+        EXPECT_EQ(false, test.util.fileExists(test.filename + "1.run0.temp"));
+    }
+    test.util.mothurRemove(memoryFile);
+}
+
+TEST(Test_Container_BinaryDistFile, readColumn) {
+    TestBinaryDistFile test;
+    string columnFile = test.filename + ".dist";
+    
+    ofstream out; test.util.openOutputFile(columnFile, out);
+    out << "seq1 seq2 0.03\nseq2 seq3 0.5\nseq3 seq1 0.01\n";
+    out.close();
+    
+    BinaryDistFile readDist;
+    EXPECT_EQ(true, readDist.readColumn(columnFile, 0.1));
+    EXPECT_EQ(3, readDist.getNumSeqs());
+    EXPECT_EQ(2, readDist.getNumDists());
+    
+    //a file with only a blank line has no distances
+    test.util.openOutputFile(columnFile, out); out << "\n"; out.close();
+    EXPECT_EQ(true, readDist.readColumn(columnFile, 0.1));
+    EXPECT_EQ(0, readDist.getNumDists());
+    
+    //a file that ends before the last distance
+    test.util.openOutputFile(columnFile, out);
+    out << "seq1 seq2 0.03\nseq2 seq3";
+    out.close();
+    EXPECT_EQ(false, readDist.readColumn(columnFile, 0.1));
+    
+    test.util.mothurRemove(columnFile);
+}
+/**************************************************************************************************/
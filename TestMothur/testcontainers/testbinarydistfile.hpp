@@ -0,0 +1,29 @@
+//
+//  testbinarydistfile.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testbinarydistfile_hpp
+#define testbinarydistfile_hpp
+
+#include "gtest/gtest.h"
+#include "binarydistfile.hpp"
+
+class TestBinaryDistFile {
+    
+public:
+    
+    TestBinaryDistFile();
+    ~TestBinaryDistFile();
+    
+    MothurOut* m;
+    Utils util;
+    BinaryDistFile binDist;
+    string filename;
+    
+};
+
+#endif /* testbinarydistfile_hpp */
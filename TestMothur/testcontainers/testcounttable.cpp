@@ -27,7 +27,7 @@ TEST(Test_Container_CountTable, createTables) {
     //int createTable(string, string, bool); //namefile, groupfile, createGroup
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector);
     
     EXPECT_EQ(ct.getNumGroups(), 10);
     EXPECT_EQ(ct.getNumSeqs(), 200);
@@ -86,7 +86,7 @@ TEST(Test_Container_CountTable, testGroups) {
     EXPECT_EQ(groups[4], "F003D008");
     EXPECT_EQ(groups[5], "F003D142");
     
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector);
     CountTable ct2; ct2.copy(&ct);
     EXPECT_EQ(ct2.getNumGroups(), 10);
     EXPECT_EQ(ct2.getNumSeqs(), 200);
@@ -144,7 +144,7 @@ TEST(Test_Container_CountTable, push_backs) {
 TEST(Test_Container_CountTable, push_backGroups) {
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector);
     ct.setAbund("GQY1XT001B1CEF", "F003D000", 50);
     EXPECT_EQ(ct.getGroupCount("GQY1XT001B1CEF", "F003D000"), 50);
     
@@ -158,7 +158,7 @@ TEST(Test_Container_CountTable, push_backGroups) {
 TEST(Test_Container_CountTable, getSets) {
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector);
     
     vector<string> thisSeqsGroups = ct.getGroups("GQY1XT001B1CEF");
     EXPECT_EQ(thisSeqsGroups[0], "F003D148");
@@ -177,7 +177,7 @@ TEST(Test_Container_CountTable, getSets) {
 TEST(Test_Container_CountTable, dataStructures) {
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector);
     
     EXPECT_EQ(ct.getNamesOfSeqs().size(), 93);
     EXPECT_EQ(ct.getNamesOfSeqs("F003D148").size(), 19);
@@ -190,6 +190,101 @@ TEST(Test_Container_CountTable, dataStructures) {
 }
 /**************************************************************************************************/
 
+TEST(Test_Container_CountTable, binaryFile) {
+    Utils util;
+    vector<string> groups; groups.push_back("groupB"); groups.push_back("groupA"); groups.push_back("groupC");
+    CountTable ct;
+    for (int i = 0; i < groups.size(); i++) { ct.addGroup(groups[i]); }
+    vector<int> abunds(3, 0);
+    abunds[0] = 2; abunds[2] = 3; ct.push_back("seqB", abunds);
+    abunds[0] = 0; abunds[1] = 1; abunds[2] = 0; ct.push_back("seqA", abunds);
+    abunds[0] = 4; abunds[1] = 0; abunds[2] = 0; ct.push_back("seqC", abunds);
+
+    string file = "testBinary.count_table";
+    ct.printTable(file, true);
+    ifstream in; EXPECT_EQ(util.openInputFile(CountTableBinaryFile::getFileName(file), in, ""), true); in.close();
+
+    //read from the binary file
+    CountTable ct2; ct2.readTable(file, true, false);
+    EXPECT_EQ(ct2.isTableCompressed(), true);
+    EXPECT_EQ(ct2.getNumGroups(), 3);
+    EXPECT_EQ(ct2.getNumSeqs(), 10);
+    EXPECT_EQ(ct2.getNamesOfSeqs()[0], "seqA");
+    EXPECT_EQ(ct2.getGroupCount("seqB", "groupC"), 3);
+    EXPECT_EQ(ct2.getGroupCount("seqC", "groupC"), 0);
+    EXPECT_EQ(ct2.getNamesOfSeqs("groupB").size(), 1);
+
+    //selected groups and no groups read the same as the text
+    vector<string> selected; selected.push_back("groupC");
+    CountTable ct3; ct3.readTable(file, true, false, selected);
+    EXPECT_EQ(ct3.getNumGroups(), 1);
+    EXPECT_EQ(ct3.getNumSeqs(), 3);
+    EXPECT_EQ(ct3.getNumUniqueSeqs(), 1);
+
+    CountTable ct4; ct4.readTable(file, false, false);
+    EXPECT_EQ(ct4.hasGroupInfo(), false);
+    EXPECT_EQ(ct4.getNumSeqs("seqC"), 4);
+
+    //the binary file is ignored once the text changes
+    ofstream out; util.openOutputFileAppend(file, out); out << "seqD\t5\t1,5\n"; out.close();
+    CountTable ct5; ct5.readTable(file, true, false);
+    EXPECT_EQ(ct5.getNumSeqs(), 15);
+    EXPECT_EQ(ct5.getNumUniqueSeqs(), 4);
+
+    //the binary copy follows its table when utils renames or removes it
+    string newFile = "testBinary.renamed.count_table";
+    ct.printTable(file, true);
+    util.renameFile(file, newFile);
+    EXPECT_EQ(util.openInputFile(CountTableBinaryFile::getFileName(file), in, ""), false);
+    EXPECT_EQ(CountTableBinaryFile::isBinaryFile(CountTableBinaryFile::getFileName(newFile)), true);
+
+    util.mothurRemove(newFile);
+    EXPECT_EQ(util.openInputFile(CountTableBinaryFile::getFileName(newFile), in, ""), false);
+}
+/**************************************************************************************************/
+
+TEST(Test_Container_CountTable, removeAndMerge) {
+    CountTable ct;
+    ct.addGroup("group1"); ct.addGroup("group2");
+    vector<int> abunds(2, 0);
+    abunds[0] = 1; ct.push_back("seq1", abunds);
+    abunds[0] = 2; abunds[1] = 3; ct.push_back("seq2", abunds);
+    abunds[0] = 0; abunds[1] = 4; ct.push_back("seq3", abunds);
+
+    ct.removeGroup("group1");
+    EXPECT_EQ(ct.getNumUniqueSeqs(), 2);
+    EXPECT_EQ(ct.getNumSeqs(), 7);
+    EXPECT_EQ(ct.inTable("seq1"), false);
+    EXPECT_EQ(ct.getGroupCount("seq2", "group2"), 3);
+
+    ct.mergeCounts("seq3", "seq2");
+    EXPECT_EQ(ct.size(), 1);
+    EXPECT_EQ(ct.inTable("seq2"), false);
+    EXPECT_EQ(ct.getNameMap("group2")["seq3"], 7);
+    EXPECT_EQ(ct.getListVector().getNumBins(), 1);
+}
+/**************************************************************************************************/
+//the name order views give what getNameMap does, and follow the table as it changes
+TEST(Test_Container_CountTable, sortedViews) {
+    CountTable ct;
+    ct.push_back("seqC", 4); ct.push_back("seqA", 1); ct.push_back("seqB10", 2); ct.push_back("seqB", 3);
+
+    map<string, int> nameMap = ct.getNameMap();
+    ASSERT_EQ(ct.getNumSortedSeqs(), nameMap.size());
+    int i = 0;
+    for (map<string, int>::iterator it = nameMap.begin(); it != nameMap.end(); it++, i++) {
+        EXPECT_EQ(ct.getSortedName(i), it->first);
+        EXPECT_EQ(ct.getSortedNumSeqs(i), it->second);
+    }
+
+    ct.remove("seqB"); ct.push_back("seqAA", 5);
+    EXPECT_EQ(ct.getNumSortedSeqs(), 4);
+    EXPECT_EQ(ct.getSortedName(1), "seqAA");
+    EXPECT_EQ(ct.getSortedNumSeqs(1), 5);
+    EXPECT_EQ(ct.getSortedName(2), "seqB10");
+}
+/**************************************************************************************************/
+
 //ListVector getListVector();
 //SharedRAbundVectors* getShared();
 //SharedRAbundVectors* getShared(vector<string>); //set of groups selected
@@ -0,0 +1,89 @@
+//
+//  testdereplicator.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testdereplicator.hpp"
+
+/**************************************************************************************************/
+TestDereplicator::TestDereplicator() {  //setup
+    //5000 uniques of different lengths, each one repeated (i % 4) + 1 times in a scrambled order
+    numUniques = 5000;
+    vector<string> uniques;
+    for (int i = 0; i < numUniques; i++) {
+        string bases = "";
+        for (int j = 0; j < 20 + (i % 37); j++) { bases += "ACGT-"[((i+1)*(j+3) + (i >> (j % 9))) % 5]; }
+        bases += toString(i);
+        uniques.push_back(bases);
+    }
+    for (int copy = 0; copy < 4; copy++) {
+        for (int i = 0; i < numUniques; i++) {
+            int u = (i * 7919 + copy) % numUniques;
+            if ((u % 4) >= copy) { seqs.push_back(uniques[u]); }
+        }
+    }
+}
+/**************************************************************************************************/
+TEST(Test_Container_Dereplicator, uniques) {
+    TestDereplicator test;
+    
+    Dereplicator uniques;
+    vector<int> indexes; vector<bool> isNew;
+    EXPECT_EQ(test.numUniques, uniques.add(test.seqs, indexes, isNew));
+    EXPECT_EQ(test.numUniques, uniques.getNumUniques());
+    
+    //first appearances are numbered in order and every copy finds its unique
+    int next = 0;
+    for (int i = 0; i < test.seqs.size(); i++) {
+        if (isNew[i]) { EXPECT_EQ(next, indexes[i]); next++; }
+        EXPECT_EQ(test.seqs[i], uniques.getUnique(indexes[i]));
+    }
+    
+    bool found;
+    EXPECT_EQ(indexes[17], uniques.add(test.seqs[17], found));
+    EXPECT_EQ(false, found);
+    EXPECT_EQ(test.numUniques, uniques.add("ACGT", found));
+    EXPECT_EQ(true, found);
+}
+
+TEST(Test_Container_Dereplicator, processorsMatch) {
+    TestDereplicator test;
+    
+    Dereplicator serial;
+    vector<int> serialIndexes; vector<bool> serialNew;
+    serial.add(test.seqs, serialIndexes, serialNew);
+    
+    //split across batches and shards, the numbering doesn't change
+    Dereplicator sharded(3);
+    vector<int> shardedIndexes, indexes; vector<bool> shardedNew, isNew;
+    for (int start = 0; start < test.seqs.size(); start += 4000) {
+        vector<string> batch(test.seqs.begin() + start, test.seqs.begin() + min(start + 4000, (int)test.seqs.size()));
+        sharded.add(batch, indexes, isNew);
+        shardedIndexes.insert(shardedIndexes.end(), indexes.begin(), indexes.end());
+        shardedNew.insert(shardedNew.end(), isNew.begin(), isNew.end());
+    }
+    
+    EXPECT_EQ(serial.getNumUniques(), sharded.getNumUniques());
+    EXPECT_EQ(true, (serialIndexes == shardedIndexes));
+    EXPECT_EQ(true, (serialNew == shardedNew));
+}
+
+TEST(Test_Container_Dereplicator, members) {
+    Dereplicator uniques;
+    vector<string> seqs; seqs.push_back("ATGC"); seqs.push_back("AT-GC"); seqs.push_back("ATGC");
+    vector<int> indexes; vector<bool> isNew;
+    uniques.add(seqs, indexes, isNew);
+    
+    uniques.addMember(indexes[0], "seq1"); uniques.addAbundance(indexes[0], 1);
+    uniques.addMember(indexes[2], "seq3,seq4"); uniques.addAbundance(indexes[2], 2);
+    
+    EXPECT_EQ("seq1,seq3,seq4", uniques.getMembers(0));
+    EXPECT_EQ("seq1", uniques.getFirstMember(0));
+    EXPECT_EQ(3, uniques.getAbundance(0));
+    EXPECT_EQ(false, uniques.hasMembers(1));
+    EXPECT_EQ("", uniques.getMembers(1));
+}
+/**************************************************************************************************/
@@ -0,0 +1,26 @@
+//
+//  testdereplicator.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testdereplicator_hpp
+#define testdereplicator_hpp
+
+#include "gtest/gtest.h"
+#include "dereplicator.hpp"
+
+class TestDereplicator {
+    
+public:
+    
+    TestDereplicator();
+    ~TestDereplicator() {}
+    
+    vector<string> seqs; //with duplicates
+    int numUniques;
+};
+
+#endif /* testdereplicator_hpp */
@@ -0,0 +1,88 @@
+//
+//  testinflatereader.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testinflatereader.hpp"
+
+#ifdef USE_BOOST
+
+/**************************************************************************************************/
+TestInflateReader::TestInflateReader() {  //setup
+    m = MothurOut::getInstance();
+    filename = "testinflatereader.fastq.gz";
+    
+    //about 3Mb of reads, so the inflated text spans several blocks
+    numReads = 20000; contents = "";
+    for (int i = 0; i < numReads; i++) {
+        string bases = "";
+        for (int j = 0; j < 60; j++) { bases += "ACGT"[(i+j*j) % 4]; }
+        contents += "@read" + toString(i) + "\n" + bases + "\n+\n" + string(bases.length(), 'I') + "\n";
+    }
+    
+    ofstream file(filename.c_str(), ios_base::out | ios_base::binary);
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::gzip_compressor());
+    out.push(file);
+    out << contents;
+    out.pop(); out.pop(); file.close();
+}
+/**************************************************************************************************/
+TestInflateReader::~TestInflateReader() { util.mothurRemove(filename); }
+/**************************************************************************************************/
+TEST(Test_Container_InflateReader, readAll) {
+    TestInflateReader test;
+    
+    InflateReader reader(test.filename);
+    EXPECT_EQ(true, reader.isOpen());
+    
+    string text = "";
+    char buffer[4096];
+    while (reader.getStream().read(buffer, 4096) || (reader.getStream().gcount() != 0)) { text.append(buffer, reader.getStream().gcount()); }
+    
+    EXPECT_EQ(test.contents.length(), text.length());
+    EXPECT_EQ(true, (test.contents == text));
+}
+
+TEST(Test_Container_InflateReader, fastqReads) {
+    TestInflateReader test;
+    
+    InflateReader reader(test.filename);
+    boost::iostreams::filtering_istream& in = reader.getStream();
+    
+    int count = 0; string lastName = "";
+    while (!in.eof()) {
+        bool ignore = false;
+        FastqRead read(in, ignore, "illumina1.8+"); test.util.gobble(in);
+        if (ignore) { break; }
+        lastName = read.getName(); count++;
+    }
+    
+    EXPECT_EQ(test.numReads, count);
+    EXPECT_EQ("read" + toString(test.numReads-1), lastName);
+}
+
+TEST(Test_Container_InflateReader, stopEarly) {
+    TestInflateReader test;
+    
+    //the inflate thread is still filling blocks when the reader is destroyed
+    InflateReader* reader = new InflateReader(test.filename);
+    bool ignore = false;
+    FastqRead read(reader->getStream(), ignore, "illumina1.8+");
+    EXPECT_EQ("read0", read.getName());
+    delete reader;
+}
+
+TEST(Test_Container_InflateReader, missingFile) {
+    InflateReader reader("testinflatereader.missing.gz");
+    
+    EXPECT_EQ(false, reader.isOpen());
+    reader.getStream().peek();
+    EXPECT_EQ(true, reader.getStream().eof());
+}
+/**************************************************************************************************/
+
+#endif
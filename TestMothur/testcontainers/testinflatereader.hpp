@@ -0,0 +1,34 @@
+//
+//  testinflatereader.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testinflatereader_hpp
+#define testinflatereader_hpp
+
+#include "gtest/gtest.h"
+#include "inflatereader.hpp"
+#include "fastqread.h"
+
+#ifdef USE_BOOST
+
+class TestInflateReader {
+    
+public:
+    
+    TestInflateReader();
+    ~TestInflateReader();
+    
+    MothurOut* m;
+    Utils util;
+    string filename, contents;
+    int numReads;
+    
+};
+
+#endif
+
+#endif /* testinflatereader_hpp */
@@ -0,0 +1,151 @@
+//
+//  testkmerdb.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testkmerdb.hpp"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//300 made up seqs, every 10th one starts with the same 20 bases so some kmers are in seqs far apart
+TestKmerDB::TestKmerDB() {  //setup
+    m = MothurOut::getInstance();
+    fastaFile = "testkmerdb.fasta";
+    dbFile = "testkmerdb.8mer";
+    
+    mt19937_64 engine(12345);
+    for (int i = 0; i < 300; i++) {
+        string seq = "";
+        if ((i % 10) == 0) { seq = "ACGTTGCAACGGTTCCAAGG"; }
+        seq += BenchmarkData::getRandomBases(150 - seq.length(), engine);
+        seqs.push_back(Sequence("seq" + toString(i), seq));
+    }
+}
+/**************************************************************************************************/
+TestKmerDB::~TestKmerDB() { util.mothurRemove(dbFile); }
+/**************************************************************************************************/
+vector<int> TestKmerDB::search(KmerDB& db, int i) {
+    vector<float> scores;
+    Sequence query = seqs[i];
+    return db.findClosestSequences(&query, 5, scores);
+}
+/**************************************************************************************************/
+TEST(Test_Container_KmerDB, compactIndex) {
+    TestKmerDB test;
+    
+    KmerDB db(test.fastaFile, 8);
+    for (int i = 0; i < test.seqs.size(); i++) { db.addSequence(test.seqs[i]); }
+    db.setNumSeqs(test.seqs.size());
+    
+    vector<int> before = test.search(db, 20);
+    vector<int> sharedBefore = db.getSequencesWithKmer(7140); //ACGTTGCA
+    EXPECT_LE(30, db.getCount(7140));
+    
+    db.generateDB(); //packs the index
+    
+    EXPECT_EQ(before, test.search(db, 20));
+    EXPECT_EQ(sharedBefore, db.getSequencesWithKmer(7140));
+    EXPECT_EQ(sharedBefore.size(), db.getCount(7140));
+    EXPECT_EQ(0, sharedBefore[0]);
+    EXPECT_EQ(290, sharedBefore.back());
+}
+
+TEST(Test_Container_KmerDB, readWrite) {
+    TestKmerDB test;
+    
+    KmerDB db(test.fastaFile, 8);
+    for (int i = 0; i < test.seqs.size(); i++) { db.addSequence(test.seqs[i]); }
+    db.setNumSeqs(test.seqs.size());
+    db.generateDB();
+    
+    ifstream in;
+    test.util.openInputFile(test.dbFile, in);
+    string line = test.util.getline(in);
+    EXPECT_EQ('#', line[0]); //version line, so shortcut file checks still work
+    
+    KmerDB readDB(test.fastaFile, 8);
+    readDB.readDB(in);
+    readDB.setNumSeqs(test.seqs.size());
+    
+    for (int i = 0; i < test.seqs.size(); i += 37) { EXPECT_EQ(test.search(db, i), test.search(readDB, i)); }
+    for (int k = 0; k < readDB.getMaxKmer(); k += 101) { EXPECT_EQ(db.getSequencesWithKmer(k), readDB.getSequencesWithKmer(k)); }
+}
+
+TEST(Test_Container_KmerDB, addAfterRead) {
+    TestKmerDB test;
+    
+    KmerDB db(test.fastaFile, 8);
+    for (int i = 0; i < 200; i++) { db.addSequence(test.seqs[i]); }
+    db.generateDB();
+    
+    ifstream in;
+    test.util.openInputFile(test.dbFile, in);
+    KmerDB readDB(test.fastaFile, 8);
+    readDB.readDB(in);
+    for (int i = 200; i < test.seqs.size(); i++) { readDB.addSequence(test.seqs[i]); }
+    readDB.setNumSeqs(test.seqs.size());
+    
+    EXPECT_EQ(db.getCount(7140) + 10, readDB.getCount(7140));
+    vector<int> closest = test.search(readDB, 250);
+    EXPECT_EQ(250, closest[0]);
+}
+
+//the new file is renamed over the old one, so a db that has the old one mapped keeps its index
+TEST(Test_Container_KmerDB, rewriteWhileMapped) {
+    TestKmerDB test;
+    
+    KmerDB db(test.fastaFile, 8);
+    for (int i = 0; i < test.seqs.size(); i++) { db.addSequence(test.seqs[i]); }
+    db.setNumSeqs(test.seqs.size());
+    db.generateDB();
+    
+    ifstream in;
+    test.util.openInputFile(test.dbFile, in);
+    KmerDB readDB(test.fastaFile, 8);
+    readDB.readDB(in);
+    readDB.setNumSeqs(test.seqs.size());
+    vector<int> sharedBefore = readDB.getSequencesWithKmer(7140);
+    
+    KmerDB smallerDB(test.fastaFile, 8);
+    for (int i = 0; i < 50; i++) { smallerDB.addSequence(test.seqs[i]); }
+    smallerDB.generateDB();
+    
+    EXPECT_EQ(sharedBefore, readDB.getSequencesWithKmer(7140));
+    EXPECT_EQ(sharedBefore.size(), readDB.getCount(7140));
+    EXPECT_EQ(test.search(db, 123), test.search(readDB, 123));
+    EXPECT_FALSE(test.util.fileExists(test.dbFile + "." + toString(getpid()) + ".temp"));
+    
+    ifstream newIn;
+    test.util.openInputFile(test.dbFile, newIn);
+    KmerDB newDB(test.fastaFile, 8);
+    newDB.readDB(newIn);
+    EXPECT_EQ(smallerDB.getCount(7140), newDB.getCount(7140));
+    EXPECT_GT(sharedBefore.size(), newDB.getCount(7140));
+}
+/**************************************************************************************************/
+TEST(Test_Container_KmerDB, topMatches) {
+    TestKmerDB test;
+    
+    KmerDB db(test.fastaFile, 8);
+    for (int i = 0; i < test.seqs.size(); i++) { db.addSequence(test.seqs[i]); }
+    db.setNumSeqs(test.seqs.size());
+    
+    //the 13 kmers of the shared start are in seqs 0, 10, 20 ... so they tie after the query itself
+    Sequence query("query", "ACGTTGCAACGGTTCCAAGG");
+    vector<float> scores;
+    vector<int> closest = db.findClosestSequences(&query, 5, scores);
+    
+    int expected[] = { 0, 10, 20, 30, 40 };
+    EXPECT_EQ(vector<int>(expected, expected+5), closest);
+    EXPECT_EQ(6, scores.size());
+    EXPECT_FLOAT_EQ(100, scores[0]);
+    EXPECT_FLOAT_EQ(100, scores[5]);
+    
+    closest = test.search(db, 7);
+    EXPECT_EQ(7, closest[0]);
+    EXPECT_EQ(5, closest.size());
+}
+/**************************************************************************************************/
@@ -0,0 +1,31 @@
+//
+//  testkmerdb.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testkmerdb_hpp
+#define testkmerdb_hpp
+
+#include "gtest/gtest.h"
+#include "kmerdb.hpp"
+
+class TestKmerDB {
+    
+public:
+    
+    TestKmerDB();
+    ~TestKmerDB();
+    
+    vector<int> search(KmerDB&, int); //closest 5 seqs to query i
+    
+    MothurOut* m;
+    Utils util;
+    vector<Sequence> seqs;
+    string fastaFile, dbFile;
+    
+};
+
+#endif /* testkmerdb_hpp */
@@ -0,0 +1,71 @@
+//
+//  testopticsrmatrix.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testopticsrmatrix.hpp"
+#include "binarydistfile.hpp"
+
+/**************************************************************************************************/
+TestOptiCSRMatrix::TestOptiCSRMatrix() {  //setup
+    columnFile = "testopticsrmatrix.dist";
+    binaryFile = "testopticsrmatrix.bdist";
+    nameFile = "testopticsrmatrix.names";
+    
+    ofstream out;
+    util.openOutputFile(nameFile, out);
+    out << "seqA\tseqA,seqA2\nseqB\tseqB\nseqC\tseqC\nseqD\tseqD,seqD2,seqD3\nseqE\tseqE\n";
+    out.close();
+    
+    //seqE is a singleton, seqB seqC is given in both directions
+    util.openOutputFile(columnFile, out);
+    out << "seqB\tseqA\t0.02\nseqC\tseqA\t0.05\nseqC\tseqB\t0.01\nseqB\tseqC\t0.01\nseqD\tseqA\t0.03\nseqE\tseqD\t0.2\n";
+    out.close();
+    
+    BinaryDistFile binDist;
+    binDist.readColumn(columnFile, 1.0);
+    binDist.write(binaryFile);
+}
+/**************************************************************************************************/
+TestOptiCSRMatrix::~TestOptiCSRMatrix() { util.mothurRemove(columnFile); util.mothurRemove(binaryFile); util.mothurRemove(nameFile); }
+/**************************************************************************************************/
+//distfile, dupsFile, dupsFormat, cutoff, sim
+TEST(Test_Container_OptiCSRMatrix, readColumn) {
+    TestOptiCSRMatrix test;
+    OptiCSRMatrix matrix(test.columnFile, test.nameFile, "name", 0.03, false);
+    OptiMatrix setMatrix(test.columnFile, test.nameFile, "name", "column", 0.03, false);
+    
+    EXPECT_EQ(4, matrix.getNumSeqs());
+    EXPECT_EQ(1, matrix.getNumSingletons());
+    EXPECT_EQ(6, matrix.getNumDists());
+    EXPECT_EQ(setMatrix.getNumDists(), matrix.getNumDists());
+    EXPECT_EQ("seqD,seqD2,seqD3", matrix.getName(3));
+    
+    for (long long i = 0; i < setMatrix.getNumSeqs(); i++) {
+        EXPECT_EQ(setMatrix.getName(i), matrix.getName(i));
+        EXPECT_EQ(setMatrix.getNumClose(i), matrix.getNumClose(i));
+        EXPECT_EQ(setMatrix.getCloseSeqs(i), matrix.getCloseSeqs(i));
+        for (long long j = 0; j < setMatrix.getNumSeqs(); j++) { EXPECT_EQ(setMatrix.isClose(i, j), matrix.isClose(i, j)); }
+    }
+}
+
+TEST(Test_Container_OptiCSRMatrix, readBinary) {
+    TestOptiCSRMatrix test;
+    OptiCSRMatrix matrix(test.binaryFile, test.nameFile, "name", 0.03, false);
+    
+    EXPECT_EQ(4, matrix.getNumSeqs());
+    EXPECT_EQ(6, matrix.getNumDists());
+    EXPECT_EQ(true, matrix.isClose(0, 1));
+    EXPECT_EQ(true, matrix.isClose(2, 1));
+    EXPECT_EQ(true, matrix.isClose(3, 0));
+    EXPECT_EQ(false, matrix.isClose(2, 0)); //0.05 is above the cutoff
+    EXPECT_EQ(false, matrix.isClose(3, 1));
+    
+    ListVector* list = matrix.getListSingle();
+    EXPECT_EQ("seqE", list->get(0));
+    delete list;
+}
+/**************************************************************************************************/
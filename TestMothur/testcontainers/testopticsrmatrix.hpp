@@ -0,0 +1,28 @@
+//
+//  testopticsrmatrix.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testopticsrmatrix_hpp
+#define testopticsrmatrix_hpp
+
+#include "gtest/gtest.h"
+#include "opticsrmatrix.hpp"
+#include "optimatrix.h"
+
+class TestOptiCSRMatrix {
+    
+public:
+    
+    TestOptiCSRMatrix();
+    ~TestOptiCSRMatrix();
+    
+    Utils util;
+    string columnFile, binaryFile, nameFile;
+    
+};
+
+#endif /* testopticsrmatrix_hpp */
@@ -0,0 +1,121 @@
+//
+//  testfragmentassembler.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testfragmentassembler.hpp"
+
+/**************************************************************************************************/
+//reads of a random amplicon, the reverse read is reverse complemented like assemble() does
+void makePair(mt19937_64& engine, int ampliconLength, int readLength, int numErrors, string& forward, string& reverse) {
+    const char nucleotides[4] = { 'A', 'C', 'G', 'T' };
+    string amplicon(ampliconLength, 'A');
+    for (int i = 0; i < ampliconLength; i++) { amplicon[i] = nucleotides[engine() % 4]; }
+
+    forward = amplicon.substr(0, readLength);
+    reverse = amplicon.substr(max(0, ampliconLength-readLength));
+    for (int i = 0; i < numErrors; i++) {
+        string& read = ((i % 2) == 0) ? forward : reverse;
+        int pos = engine() % read.length();
+        read[pos] = nucleotides[(string("ACGT").find(read[pos]) + 1 + (engine() % 3)) % 4];
+    }
+}
+/**************************************************************************************************/
+//without an indel the ungapped overlap is the alignment the gapped aligners find
+TEST(Test_FragmentAssembler, ungappedMatchesGapped) {
+    mt19937_64 engine(1234);
+    NeedlemanOverlap needleman(-2.0, 1.0, -1.0, 600);
+    GotohOverlap gotoh(-2.0, -1.0, 1.0, -1.0, 600);
+    FragmentAssembler needlemanAssembler(&needleman, "needleman", 1.0, -1.0, -2.0, -1.0, 20, 6, false);
+    FragmentAssembler gotohAssembler(&gotoh, "gotoh", 1.0, -1.0, -2.0, -1.0, 20, 6, false);
+
+    int ampliconLengths[4] = { 253, 300, 200, 120 }; //the last two are shorter than the reads
+    int numUngapped = 0;
+    for (int i = 0; i < 200; i++) {
+        string forward, reverse;
+        makePair(engine, ampliconLengths[i % 4], 150 + (i % 3) * 50, i % 6, forward, reverse);
+
+        string fAligned, rAligned;
+        if (needlemanAssembler.findUngappedOverlap(forward, reverse, fAligned, rAligned)) {
+            numUngapped++;
+            needleman.align(forward, reverse);
+            EXPECT_EQ(needleman.getSeqAAln(), fAligned);
+            EXPECT_EQ(needleman.getSeqBAln(), rAligned);
+        }
+        if (gotohAssembler.findUngappedOverlap(forward, reverse, fAligned, rAligned)) {
+            gotoh.align(forward, reverse);
+            EXPECT_EQ(gotoh.getSeqAAln(), fAligned);
+            EXPECT_EQ(gotoh.getSeqBAln(), rAligned);
+        }
+    }
+    EXPECT_GT(numUngapped, 150);
+}
+/**************************************************************************************************/
+TEST(Test_FragmentAssembler, gapsFallBack) {
+    mt19937_64 engine(4321);
+    NeedlemanOverlap needleman(-2.0, 1.0, -1.0, 600);
+    FragmentAssembler assembler(&needleman, "needleman", 1.0, -1.0, -2.0, -1.0, 20, 6, false);
+
+    string forward, reverse, fAligned, rAligned;
+    makePair(engine, 253, 250, 0, forward, reverse);
+    EXPECT_TRUE(assembler.findUngappedOverlap(forward, reverse, fAligned, rAligned));
+
+    //an indel in the middle of the overlap
+    string deleted = reverse.substr(0, 100) + reverse.substr(101);
+    EXPECT_FALSE(assembler.findUngappedOverlap(forward, deleted, fAligned, rAligned));
+
+    //a base dropped a few bases from the end of the forward read, where the ungapped offset only pays two mismatches
+    string shortened = forward.substr(0, 245) + forward.substr(246);
+    EXPECT_FALSE(assembler.findUngappedOverlap(shortened, reverse, fAligned, rAligned));
+
+    //a 10 base indel 30 bases from the end of the overlap is outside the band, the mismatches after it have to send it to the traceback
+    string longDeletion = forward.substr(0, 220) + forward.substr(230);
+    EXPECT_FALSE(assembler.findUngappedOverlap(longDeletion, reverse, fAligned, rAligned));
+    needleman.align(longDeletion, reverse);
+    string aAligned = needleman.getSeqAAln(); string bAligned = needleman.getSeqBAln();
+    EXPECT_EQ(13, count(aAligned.begin(), aAligned.end(), '-')); //the deleted bases and the 3 past the end of the forward read
+    EXPECT_EQ(aAligned.substr(aAligned.length()-23, 20), bAligned.substr(bAligned.length()-23, 20)); //the bases after it are paired again
+
+    //too short an overlap to trust
+    EXPECT_FALSE(assembler.findUngappedOverlap(forward.substr(0, 20), forward.substr(5, 30), fAligned, rAligned));
+}
+/**************************************************************************************************/
+TEST(Test_FragmentAssembler, assemble) {
+    mt19937_64 engine(99);
+    NeedlemanOverlap needleman(-2.0, 1.0, -1.0, 600);
+    FragmentAssembler assembler(&needleman, "needleman", 1.0, -1.0, -2.0, -1.0, 20, 6, false);
+
+    string forward, reverse;
+    makePair(engine, 253, 200, 0, forward, reverse);
+    string amplicon = forward + reverse.substr(147);
+
+    //one mismatch in the overlap, the forward read has the better score
+    reverse[100] = (reverse[100] == 'A') ? 'C' : 'A';
+    vector<int> scores1(200, 30); vector<int> scores2(200, 30); scores2[100] = 10;
+
+    Sequence fSeq("pair", forward); Sequence rSeq("pair", reverse); rSeq.reverseComplement(); //assemble flips it back
+    string contig, trashCode; int oend, oStart, numMismatches = 0;
+    vector<int> contigScores = assembler.assemble(fSeq, rSeq, scores1, scores2, true, contig, trashCode, oend, oStart, numMismatches);
+
+    EXPECT_EQ(amplicon, contig);
+    EXPECT_EQ("", trashCode);
+    EXPECT_EQ(53, oStart);
+    EXPECT_EQ(200, oend);
+    EXPECT_EQ(1, numMismatches);
+    EXPECT_EQ(1, assembler.getNumUngapped());
+    ASSERT_EQ(253, contigScores.size());
+
+    //the scores outside the overlap are the read's, the overlap's are the posteriors
+    EXPECT_EQ(30, contigScores[0]);
+    EXPECT_EQ(65, contigScores[100]);
+    EXPECT_EQ(20, contigScores[153]);
+    EXPECT_EQ(30, contigScores[252]);
+
+    double expected = 0;
+    for (int i = 0; i < contigScores.size(); i++) { expected += FragmentAssembler::convertQToProb(contigScores[i]); }
+    EXPECT_DOUBLE_EQ(expected, assembler.getExpectedErrors(contigScores));
+}
+/**************************************************************************************************/
@@ -0,0 +1,17 @@
+//
+//  testfragmentassembler.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testfragmentassembler_hpp
+#define testfragmentassembler_hpp
+
+#include "gtest/gtest.h"
+#include "fragmentassembler.hpp"
+#include "needlemanoverlap.hpp"
+#include "gotohoverlap.hpp"
+
+#endif /* testfragmentassembler_hpp */
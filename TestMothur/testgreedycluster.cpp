@@ -0,0 +1,82 @@
+//
+//  testgreedycluster.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testgreedycluster.hpp"
+#include "benchmarkdata.hpp"
+
+/**************************************************************************************************/
+//each variant has 2 substitutions in 200 bases, 1% from its parent. The last variant of each parent is reverse
+//complemented. The seed is fixed so every run is the same.
+void TestGreedyCluster::SetUp() {
+    numParents = 5; int numVariants = 6; int length = 200;
+    
+    mt19937_64 engine(12345);
+    vector<string> parents;
+    for (int i = 0; i < numParents; i++) {
+        string seq = BenchmarkData::getRandomBases(length, engine);
+        parents.push_back(seq);
+        seqs.push_back(seqPriorityNode(10, seq, "parent" + toString(i)));
+        parent.push_back(i);
+    }
+    
+    for (int i = 0; i < numParents; i++) {
+        for (int j = 0; j < numVariants; j++) {
+            Sequence variant("variant", BenchmarkData::substitute(parents[i], 2, engine));
+            if (j == (numVariants-1)) { variant.reverseComplement(); }
+            
+            seqs.push_back(seqPriorityNode(1, variant.getUnaligned(), "variant" + toString(i) + "_" + toString(j)));
+            parent.push_back(i);
+        }
+    }
+}
+/**************************************************************************************************/
+typedef TestGreedyCluster Test_Cluster_GreedyCluster; //the test names need to start with Test_ to run
+/**************************************************************************************************/
+TEST_F(Test_Cluster_GreedyCluster, agcFindsParents) {
+    GreedyCluster greedy("agc", 0.03);
+    vector<int> bins;
+    
+    EXPECT_EQ(greedy.cluster(seqs, bins), numParents);
+    
+    for (int i = 0; i < seqs.size(); i++) { EXPECT_EQ(bins[i], parent[i]) << seqs[i].name; }
+}
+
+TEST_F(Test_Cluster_GreedyCluster, dgcFindsParents) {
+    GreedyCluster greedy("dgc", 0.03);
+    vector<int> bins;
+    
+    EXPECT_EQ(greedy.cluster(seqs, bins), numParents);
+    
+    for (int i = 0; i < seqs.size(); i++) { EXPECT_EQ(bins[i], parent[i]) << seqs[i].name; }
+}
+
+TEST_F(Test_Cluster_GreedyCluster, cutoffSplitsVariants) {
+    GreedyCluster greedy("agc", 0.005); //variants are 1% from their parents
+    vector<int> bins;
+    
+    EXPECT_GT(greedy.cluster(seqs, bins), numParents);
+}
+/**************************************************************************************************/
+
+//the leading terminal gaps are ignored, so a read that starts before its parent is within the cutoff although the kmers
+//of its start aren't in the parent
+TEST_F(Test_Cluster_GreedyCluster, overhangJoinsParent) {
+    mt19937_64 engine(54321);
+    string overhang = BenchmarkData::getRandomBases(40, engine) + BenchmarkData::substitute(seqs[0].seq, 4, engine);
+
+    vector<seqPriorityNode> overhangSeqs;
+    overhangSeqs.push_back(seqs[0]);
+    overhangSeqs.push_back(seqPriorityNode(1, overhang, "overhang"));
+
+    GreedyCluster greedy("dgc", 0.03);
+    vector<int> bins;
+
+    EXPECT_EQ(greedy.cluster(overhangSeqs, bins), 1);
+    EXPECT_EQ(bins[1], 0);
+}
+/**************************************************************************************************/
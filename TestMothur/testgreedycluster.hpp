@@ -0,0 +1,27 @@
+//
+//  testgreedycluster.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testgreedycluster_hpp
+#define testgreedycluster_hpp
+
+#include "gtest/gtest.h"
+#include "greedycluster.hpp"
+
+//made up seqs, a few unrelated parents each with some close variants
+class TestGreedyCluster : public ::testing::Test {
+    
+protected:
+    
+    void SetUp();
+    
+    vector<seqPriorityNode> seqs;   //sorted most abundant first, parents first
+    vector<int> parent;             //parent of each seq
+    int numParents;
+};
+
+#endif /* testgreedycluster_hpp */
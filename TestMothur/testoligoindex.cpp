@@ -0,0 +1,74 @@
+//
+//  testoligoindex.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testoligoindex.hpp"
+
+/**************************************************************************************************/
+//the index has to agree with compareDNASeq for every oligo code and read base
+TEST(Test_OligoIndex, iupacCodes) {
+    string codes = "ACGTNIRYMKWSBDHV-";
+    string bases = "ACGTN";
+    
+    for (int i = 0; i < codes.length(); i++) {
+        vector<string> oligos; oligos.push_back(string("AC") + codes[i]);
+        OligoIndex index(oligos, 0);
+        
+        for (int j = 0; j < bases.length(); j++) {
+            string seq = string("AC") + bases[j] + "TTGA";
+            bool expected = OligoIndex::compareDNASeq(oligos[0], seq.substr(0, 3));
+            EXPECT_EQ(expected, (index.findMatches(seq) == 0)) << oligos[0] << " " << seq;
+        }
+    }
+}
+/**************************************************************************************************/
+TEST(Test_OligoIndex, findMatches) {
+    vector<string> oligos;
+    oligos.push_back("TTCGTGGC");
+    oligos.push_back("NONE");
+    oligos.push_back("ACGT");
+    oligos.push_back("ACGTNNNNNNNNNNNN"); //too ambiguous to expand
+    OligoIndex index(oligos, 0);
+    
+    EXPECT_EQ(1, index.findMatches("ACGTAAAAAAAAAAAAGG"));
+    EXPECT_EQ(3, index.getMatches().size());
+    EXPECT_TRUE(index.isMatch("ACGTNNNNNNNNNNNN"));
+    EXPECT_FALSE(index.isMatch("TTCGTGGC"));
+    
+    //ambiguous bases in the sequence are compared base by base
+    EXPECT_EQ(1, index.findMatches("ACRTAAAAAAAAAAAAGG"));
+    EXPECT_EQ(1, index.getMatches().size());
+    
+    EXPECT_EQ(0, index.findMatches("AAAAAAAATTCGTGGC", true));
+    EXPECT_FALSE(index.isMatch("ACGT"));
+    
+    //too short for the long oligos
+    EXPECT_EQ(1, index.findMatches("ACGTA"));
+    EXPECT_EQ(2, index.getMatches().size());
+}
+/**************************************************************************************************/
+TEST(Test_OligoIndex, align) {
+    vector<string> oligos;
+    oligos.push_back("TTCGTGGC");
+    oligos.push_back("NONE");
+    oligos.push_back("TTCTTGAC");
+    OligoIndex index(oligos, 1);
+    
+    //the G at 4 deleted from the first barcode
+    vector<OligoAlignment> alignments = index.align("TTCTGGCAATTCCATG", "seq1");
+    ASSERT_EQ(3, alignments.size());
+    EXPECT_EQ(1, alignments[0].numDiffs);
+    EXPECT_EQ(7, alignments[0].pos); //the barcode is 7 bases of the sequence
+    EXPECT_EQ(8, alignments[0].alnLength);
+    EXPECT_EQ(2, alignments[2].numDiffs);
+    
+    //same first 9 bases, from the cache
+    vector<OligoAlignment> cached = index.align("TTCTGGCAAGGGGGG", "seq2");
+    EXPECT_EQ(alignments[0].numDiffs, cached[0].numDiffs);
+    EXPECT_EQ(alignments[0].pos, cached[0].pos);
+}
+/**************************************************************************************************/
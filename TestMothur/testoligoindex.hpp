@@ -0,0 +1,15 @@
+//
+//  testoligoindex.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testoligoindex_hpp
+#define testoligoindex_hpp
+
+#include "gtest/gtest.h"
+#include "oligoindex.hpp"
+
+#endif /* testoligoindex_hpp */
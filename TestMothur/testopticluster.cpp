@@ -52,4 +52,27 @@ TEST(Test_Cluster_OptiCluster, getCloseFarCounts) {
     ASSERT_EQ(results[0], 0); //number of close sequences in bin 31 to seq 0
     ASSERT_EQ(results[1], 10); //number of far sequences in bin 31 to seq 0
 }
+
+TEST(Test_Cluster_OptiCluster, parallelUpdate) {
+    TestOptiCluster test;
+    TestOptiCluster parallelTest;
+    parallelTest.processors = 3;
+    
+    double metricValue, parallelMetricValue;
+    test.initialize(metricValue, false, "singleton"); //no randomization
+    parallelTest.initialize(parallelMetricValue, false, "singleton");
+    
+    for (int i = 0; i < 2; i++) {
+        test.update(metricValue);
+        parallelTest.update(parallelMetricValue);
+        
+        //same moves as the serial update
+        ASSERT_NEAR(metricValue, parallelMetricValue, 0.00001);
+        
+        ListVector* list = test.getList(); ListVector* parallelList = parallelTest.getList();
+        ASSERT_EQ(list->getNumBins(), parallelList->getNumBins());
+        for (int j = 0; j < list->getNumBins(); j++) { EXPECT_EQ(list->get(j), parallelList->get(j)); }
+        delete list; delete parallelList;
+    }
+}
 /**************************************************************************************************/
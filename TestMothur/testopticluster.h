@@ -31,6 +31,7 @@ public:
     using OptiCluster::initialize;
     using OptiCluster::update;
     using OptiCluster::getCloseFarCounts;
+    using OptiCluster::processors;
 };
 
 #endif /* defined(__Mothur__testopticluster__) */
@@ -0,0 +1,125 @@
+//
+//  testpackeddist.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testpackeddist.hpp"
+
+/**************************************************************************************************/
+TestPackedDist::TestPackedDist() {  //setup
+    m = MothurOut::getInstance();
+    
+    seqs.push_back(Sequence("seq1", "....ATGC-GTCATC--TAGGCT-AACGTAGCCA-TG............................................"));
+    seqs.push_back(Sequence("seq2", "..--ATGCAGTCATC---AGGCTTAACGTAGCCA--GTCAGGCTA-CGT................................"));
+    seqs.push_back(Sequence("seq3", "....ATGC-GTNATC--TAGG---AACGTAGCCA-TGTCAGGCTAACGTAGCCAATGCGTCA-CTAG.............."));
+    seqs.push_back(Sequence("seq4", ".......C-GTCATC--TAGGCT-AACGTAGCCA-TGTCAGGCTAACGTAGCCAATGCGTCA-CTAGGCTAACGTAG-CCA"));
+    seqs.push_back(Sequence("seq5", "..........................................................TGCGTCA-CTAGGCTAACG...."));
+    seqs.push_back(Sequence("seq6", "ATGCAGTCATC---AGGCTTAACGTAGCCA--GTCAGGCTA-CGTAGCCAATGCGTCA-CTAGGCTAACGTAG-CCAT---"));
+    seqs.push_back(Sequence("seq7", "................................................................................."));
+    
+    packedDB.pack(seqs);
+}
+/**************************************************************************************************/
+TestPackedDist::~TestPackedDist() {}
+/**************************************************************************************************/
+DistCalc* TestPackedDist::getDistCalc(string calc, bool countends, double cutoff) {
+    DistCalc* distCalculator = NULL;
+    if (countends) {
+        if (calc == "nogaps")           {	distCalculator = new ignoreGaps(cutoff);	}
+        else if (calc == "eachgap")     {	distCalculator = new eachGapDist(cutoff);	}
+        else if (calc == "onegap")      {	distCalculator = new oneGapDist(cutoff);	}
+    }else {
+        if (calc == "nogaps")           {	distCalculator = new ignoreGaps(cutoff);					}
+        else if (calc == "eachgap")     {	distCalculator = new eachGapIgnoreTermGapDist(cutoff);	}
+        else if (calc == "onegap")      {	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
+    }
+    return distCalculator;
+}
+/**************************************************************************************************/
+TEST(Test_Calc_PackedDist, pack) {
+    TestPackedDist test;
+    
+    EXPECT_EQ(true, test.packedDB.isPacked());
+    EXPECT_EQ(7, test.packedDB.getNumSeqs());
+    EXPECT_EQ(2, test.packedDB.getNumWords());
+    EXPECT_EQ(4, test.packedDB.getNumPlanes()); //A, C, G, N, T
+    EXPECT_EQ("seq3", test.packedDB.getName(2));
+    
+    SequenceDB differentLengths;
+    differentLengths.push_back(Sequence("seq1", "ATGC-GTCATC"));
+    differentLengths.push_back(Sequence("seq2", "ATGC-GTCATCA"));
+    PackedSeqDB notPacked;
+    EXPECT_EQ(false, notPacked.pack(differentLengths));
+}
+
+TEST(Test_Calc_PackedDist, matchesStringCalcs) {
+    TestPackedDist test;
+    
+    string calcs[3] = { "nogaps", "eachgap", "onegap" };
+    double cutoffs[2] = { 1.0, 0.03 };
+    
+    for (int c = 0; c < 3; c++) {
+        for (int countends = 0; countends < 2; countends++) {
+            for (int k = 0; k < 2; k++) {
+                DistCalc* distCalculator = test.getDistCalc(calcs[c], countends, cutoffs[k]);
+                PackedDist packedCalculator(&test.packedDB, calcs[c], countends, cutoffs[k]);
+                
+                for (int i = 0; i < test.seqs.getNumSeqs(); i++) {
+                    for (int j = 0; j < test.seqs.getNumSeqs(); j++) {
+                        EXPECT_EQ(distCalculator->calcDist(test.seqs.get(i), test.seqs.get(j)), packedCalculator.calcDist(i, j));
+                    }
+                }
+                delete distCalculator;
+            }
+        }
+    }
+}
+
+TEST(Test_Calc_PackedDist, prefilter) {
+    TestPackedDist test;
+    
+    string calcs[2] = { "eachgap", "onegap" };
+    double cutoffs[3] = { 0.03, 0.1, 0.5 };
+    
+    for (int c = 0; c < 2; c++) {
+        for (int k = 0; k < 3; k++) {
+            DistCalc* distCalculator = test.getDistCalc(calcs[c], true, cutoffs[k]);
+            PackedDist packedCalculator(&test.packedDB, calcs[c], true, cutoffs[k], true);
+            
+            for (int i = 0; i < test.seqs.getNumSeqs(); i++) {
+                for (int j = 0; j < test.seqs.getNumSeqs(); j++) {
+                    EXPECT_EQ(distCalculator->calcDist(test.seqs.get(i), test.seqs.get(j)), packedCalculator.calcDist(i, j));
+                }
+            }
+            delete distCalculator;
+            
+            EXPECT_EQ(49, packedCalculator.getNumComputed()+packedCalculator.getNumSkipped());
+            if ((c == 0) && (k == 0)) { EXPECT_LT(0, packedCalculator.getNumSkipped()); } //seq1 and seq6 differ by 40 bases
+        }
+    }
+    
+    //same length, but no base in common
+    SequenceDB composition;
+    composition.push_back(Sequence("seq1", "..AAAAACCCCC-AAAAACCCCC.."));
+    composition.push_back(Sequence("seq2", "..GGGGG-TTTTTGGGGGTTTTT.."));
+    composition.push_back(Sequence("seq3", "..AAAAACCCCCAAAAA-CCCCC.."));
+    PackedSeqDB compositionDB; compositionDB.pack(composition);
+    
+    for (int c = 0; c < 2; c++) {
+        DistCalc* distCalculator = test.getDistCalc(calcs[c], true, 0.1);
+        PackedDist packedCalculator(&compositionDB, calcs[c], true, 0.1, true);
+        
+        for (int i = 0; i < composition.getNumSeqs(); i++) {
+            for (int j = 0; j < composition.getNumSeqs(); j++) {
+                EXPECT_EQ(distCalculator->calcDist(composition.get(i), composition.get(j)), packedCalculator.calcDist(i, j));
+            }
+        }
+        delete distCalculator;
+        
+        EXPECT_EQ(4, packedCalculator.getNumSkipped()); //seq2 against seq1 and seq3, both ways
+    }
+}
+/**************************************************************************************************/
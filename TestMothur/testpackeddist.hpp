@@ -0,0 +1,35 @@
+//
+//  testpackeddist.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testpackeddist_hpp
+#define testpackeddist_hpp
+
+#include "gtest/gtest.h"
+#include "packeddist.hpp"
+#include "ignoregaps.h"
+#include "eachgapdist.h"
+#include "eachgapignore.h"
+#include "onegapdist.h"
+#include "onegapignore.h"
+
+class TestPackedDist   {
+    
+public:
+    
+    TestPackedDist();
+    ~TestPackedDist();
+    
+    DistCalc* getDistCalc(string, bool, double);
+    
+    MothurOut* m;
+    SequenceDB seqs;
+    PackedSeqDB packedDB;
+    
+};
+
+#endif /* testpackeddist_hpp */
@@ -0,0 +1,72 @@
+//
+//  testprofiler.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testprofiler.hpp"
+
+/**************************************************************************************************/
+void profileWork(int numItems) {
+    ProfileTimer timer("work");
+    Profiler::getInstance()->addItems("work", numItems);
+    Profiler::getInstance()->addBytesRead("work", 10);
+}
+/**************************************************************************************************/
+TEST(Test_Profiler, disabled) {
+    Profiler* profiler = Profiler::getInstance();
+    profiler->setProfile("", "tsv");
+    
+    profiler->startCommand("test");
+    profileWork(5);
+    
+    EXPECT_FALSE(profiler->isEnabled());
+    EXPECT_EQ(profiler->getStages().size(), 0);
+    profiler->endCommand();
+}
+/**************************************************************************************************/
+TEST(Test_Profiler, threads) {
+    Utils util;
+    Profiler* profiler = Profiler::getInstance();
+    string profileFile = "testProfiler.profile.tsv";
+    profiler->setProfile(profileFile, "tsv");
+    
+    profiler->startCommand("test");
+    
+    vector<std::thread*> workerThreads;
+    for (int i = 0; i < 3; i++) { workerThreads.push_back(new std::thread(profileWork, i+1)); }
+    for (int i = 0; i < 3; i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+    profileWork(4);
+    
+    map<string, ProfileStage> stages = profiler->getStages();
+    ASSERT_EQ(stages.count("work"), 1);
+    EXPECT_EQ(stages["work"].threads, 4);
+    EXPECT_EQ(stages["work"].calls, 4);
+    EXPECT_EQ(stages["work"].items, 10);
+    EXPECT_EQ(stages["work"].bytesRead, 40);
+    EXPECT_GE(stages["work"].seconds, stages["work"].maxThreadSeconds);
+    
+    profiler->endCommand();
+    
+    //the next command starts over
+    profiler->startCommand("next");
+    EXPECT_EQ(profiler->getStages().size(), 0);
+    profiler->endCommand();
+    profiler->setProfile("", "tsv");
+    
+    ifstream in; util.openInputFile(profileFile, in);
+    vector<string> lines;
+    while (!in.eof()) { lines.push_back(util.getline(in)); util.gobble(in); }
+    in.close();
+    util.mothurRemove(profileFile);
+    
+    ASSERT_EQ(lines.size(), 4); //header, test work, test total, next total
+    vector<string> pieces; util.splitAtChar(lines[1], pieces, '\t');
+    ASSERT_EQ(pieces.size(), 10);
+    EXPECT_EQ(pieces[0], "test"); EXPECT_EQ(pieces[1], "work"); EXPECT_EQ(pieces[2], "4"); EXPECT_EQ(pieces[6], "10");
+    EXPECT_EQ(lines[2].substr(0, 10), "test\ttotal");
+    EXPECT_EQ(lines[3].substr(0, 10), "next\ttotal");
+}
+/**************************************************************************************************/
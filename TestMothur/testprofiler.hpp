@@ -0,0 +1,15 @@
+//
+//  testprofiler.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testprofiler_hpp
+#define testprofiler_hpp
+
+#include "gtest/gtest.h"
+#include "profiler.hpp"
+
+#endif /* testprofiler_hpp */
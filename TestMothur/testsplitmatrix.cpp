@@ -0,0 +1,168 @@
+//
+//  testsplitmatrix.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testsplitmatrix.hpp"
+
+/**************************************************************************************************/
+//24 seqs. s00-s05, s06-s11 and s12-s17 are chains of close seqs, s18-s23 have no distances.
+//s00-s11 share a class, so the classify split puts two distance groups in one taxonomy group.
+//s18-s20 and s22-s23 are taxonomy groups without distances, s21 is the only seq in its class.
+TestSplitMatrix::TestSplitMatrix() {  //setup
+    m = MothurOut::getInstance();
+    distFile = "testsplitmatrix.dist";
+    nameFile = "testsplitmatrix.names";
+    countFile = "testsplitmatrix.count_table";
+    taxFile = "testsplitmatrix.tax";
+    cutoff = 0.03;
+
+    vector<string> names;
+    for (int i = 0; i < 24; i++) { names.push_back((i < 10 ? "s0" : "s") + toString(i)); }
+
+    ofstream dist, name, count, tax;
+    util.openOutputFile(distFile, dist); util.openOutputFile(nameFile, name);
+    util.openOutputFile(countFile, count); util.openOutputFile(taxFile, tax);
+
+    for (int i = 0; i < 18; i++) {
+        for (int j = 0; j < i; j++) {
+            if ((i / 6) == (j / 6)) {
+                if (j == (i-1)) { dist << names[i] << '\t' << names[j] << '\t' << (0.01 + 0.005 * (i % 3)) << endl; }
+                else            { dist << names[i] << '\t' << names[j] << '\t' << 0.05 << endl;                      }
+            }
+        }
+    }
+    dist << names[6] << '\t' << names[5] << '\t' << 0.04 << endl; //above the cutoff, doesn't join the first two chains
+    dist.close();
+
+    count << "Representative_Sequence\ttotal" << endl;
+    for (int i = 0; i < names.size(); i++) {
+        if ((i % 2) == 0)   { name << names[i] << '\t' << names[i] << ',' << names[i] << "a" << endl; count << names[i] << '\t' << 2 << endl; }
+        else                { name << names[i] << '\t' << names[i] << endl;                          count << names[i] << '\t' << 1 << endl; }
+
+        if (i < 12)         { tax << names[i] << "\tBacteria;Firmicutes;Clostridia;" << endl;                 }
+        else if (i < 18)    { tax << names[i] << "\tBacteria;Bacteroidetes;Bacteroidia;" << endl;             }
+        else if (i < 21)    { tax << names[i] << "\tBacteria;Proteobacteria;Gammaproteobacteria;" << endl;    }
+        else if (i == 21)   { tax << names[i] << "\tBacteria;Actinobacteria;Actinobacteria;" << endl;         }
+        else                { tax << names[i] << "\tBacteria;Tenericutes;Mollicutes;" << endl;                }
+    }
+    name.close(); count.close(); tax.close();
+}
+/**************************************************************************************************/
+TestSplitMatrix::~TestSplitMatrix() {
+    util.mothurRemove(distFile); util.mothurRemove(nameFile); util.mothurRemove(countFile); util.mothurRemove(taxFile);
+}
+/**************************************************************************************************/
+string TestSplitMatrix::describe(string groupFile, OptiMatrix* matrix) {
+    ostringstream out;
+    out << util.getSimpleName(groupFile) << endl;
+    matrix->print(out);
+
+    ListVector* singletons = matrix->getListSingle();
+    if (singletons != NULL) {
+        for (int i = 0; i < singletons->getNumBins(); i++) { out << singletons->get(i) << '\t'; }
+        delete singletons;
+    }
+    out << endl;
+
+    return out.str();
+}
+/**************************************************************************************************/
+void TestSplitMatrix::readSingletons(string singletonFile, set<string>& singletons) {
+    singletons.clear();
+    if ((singletonFile == "") || (singletonFile == "none")) { return; }
+
+    ifstream in;
+    if (!util.openInputFile(singletonFile, in, "no error")) { return; }
+    while (!in.eof()) {
+        string name, list; in >> name >> list; util.gobble(in);
+        if ((name != "") && (name != "Representative_Sequence")) { singletons.insert(name + '\t' + list); }
+    }
+    in.close();
+    util.mothurRemove(singletonFile);
+}
+/**************************************************************************************************/
+//the group distance and name files, read the way cluster.split reads them
+vector<string> TestSplitMatrix::splitFiles(string splitmethod, string dupsFile, string tax, set<string>& singletons) {
+    string dupsFormat = "name"; string name = dupsFile; string count = "";
+    if (dupsFile == countFile) { dupsFormat = "count"; name = ""; count = dupsFile; }
+
+    SplitMatrix split(distFile, name, count, tax, (splitmethod == "classify" ? 3 : cutoff), splitmethod, false);
+    split.split();
+
+    vector<string> groups;
+    vector< map<string, string> > files = split.getDistanceFiles();
+    for (int i = 0; i < files.size(); i++) {
+        OptiMatrix matrix(files[i].begin()->first, files[i].begin()->second, dupsFormat, "column", cutoff, false);
+        groups.push_back(describe(files[i].begin()->first, &matrix));
+        util.mothurRemove(files[i].begin()->first); util.mothurRemove(files[i].begin()->second);
+    }
+    readSingletons(split.getSingletonNames(), singletons);
+
+    return groups;
+}
+/**************************************************************************************************/
+vector<string> TestSplitMatrix::splitStream(string splitmethod, string dupsFile, string tax, set<string>& singletons, unsigned long long mem) {
+    string name = dupsFile; string count = "";
+    if (dupsFile == countFile) { name = ""; count = dupsFile; }
+
+    SplitMatrix split(distFile, name, count, tax, (splitmethod == "classify" ? 3 : cutoff), splitmethod, false);
+    split.setStream(mem, cutoff);
+    split.split();
+
+    vector<string> groups;
+    for (int i = 0; i < split.getNumGroups(); i++) {
+        OptiMatrix* matrix = split.getGroupMatrix(i);
+        groups.push_back(describe(split.getGroupFile(i), matrix));
+        delete matrix;
+    }
+    readSingletons(split.getSingletonNames(), singletons);
+
+    return groups;
+}
+/**************************************************************************************************/
+TEST(Test_Read_SplitMatrix, streamDistanceMatchesFiles) {
+    TestSplitMatrix test;
+
+    vector<string> dupsFiles; dupsFiles.push_back(test.nameFile); dupsFiles.push_back(test.countFile);
+    for (int i = 0; i < dupsFiles.size(); i++) {
+        set<string> fileSingletons, streamSingletons, spilledSingletons;
+        vector<string> fromFiles = test.splitFiles("distance", dupsFiles[i], "", fileSingletons);
+        vector<string> fromStream = test.splitStream("distance", dupsFiles[i], "", streamSingletons);
+        vector<string> spilled = test.splitStream("distance", dupsFiles[i], "", spilledSingletons, 1); //every group past the memory limit
+
+        EXPECT_EQ(3, fromFiles.size());
+        EXPECT_EQ(fromFiles, fromStream);
+        EXPECT_EQ(fromFiles, spilled);
+
+        EXPECT_EQ(6, fileSingletons.size());
+        EXPECT_EQ(fileSingletons, streamSingletons);
+        EXPECT_EQ(fileSingletons, spilledSingletons);
+    }
+}
+/**************************************************************************************************/
+//the file split loses the seqs of taxonomy groups without distances, the stream split clusters them as singletons
+TEST(Test_Read_SplitMatrix, streamClassifyMatchesFiles) {
+    TestSplitMatrix test;
+
+    set<string> fileSingletons, streamSingletons;
+    vector<string> fromFiles = test.splitFiles("classify", test.nameFile, test.taxFile, fileSingletons);
+    vector<string> fromStream = test.splitStream("classify", test.nameFile, test.taxFile, streamSingletons);
+
+    EXPECT_EQ(2, fromFiles.size());
+    EXPECT_EQ(fromFiles, fromStream);
+
+    set<string> expected; expected.insert("s21\ts21");
+    EXPECT_EQ(expected, fileSingletons);
+
+    expected.insert("s18\ts18,s18a"); expected.insert("s19\ts19"); expected.insert("s20\ts20,s20a");
+    expected.insert("s22\ts22,s22a"); expected.insert("s23\ts23");
+    EXPECT_EQ(expected, streamSingletons);
+
+    //the file split leaves the names of the groups without distances behind
+    for (int i = 0; i < 4; i++) { test.util.mothurRemove(test.nameFile + "." + toString(i) + ".temp"); }
+}
+/**************************************************************************************************/
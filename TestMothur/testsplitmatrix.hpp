@@ -0,0 +1,38 @@
+//
+//  testsplitmatrix.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testsplitmatrix_hpp
+#define testsplitmatrix_hpp
+
+#include "gtest/gtest.h"
+#include "splitmatrix.h"
+
+class TestSplitMatrix {
+
+public:
+
+    TestSplitMatrix();
+    ~TestSplitMatrix();
+
+    //each group's matrix printed with its distance file name and singletons, in the order cluster.split clusters them
+    vector<string> splitFiles(string, string, string, set<string>&);   //splitmethod, name or count file, taxonomy file, fills singleton names
+    vector<string> splitStream(string, string, string, set<string>&, unsigned long long mem=1073741824);
+
+    MothurOut* m;
+    Utils util;
+    string distFile, nameFile, countFile, taxFile;
+    float cutoff;
+
+private:
+
+    string describe(string, OptiMatrix*);
+    void readSingletons(string, set<string>&);
+
+};
+
+#endif /* testsplitmatrix_hpp */
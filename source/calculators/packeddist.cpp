@@ -0,0 +1,312 @@
+//
+//  packeddist.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "packeddist.hpp"
+
+#if defined(__GNUC__)
+    #define PACKED_INLINE inline __attribute__((always_inline))
+    #if defined(__x86_64__) || defined(__i386__)
+        #define PACKED_DISPATCH
+    #endif
+#else
+    #define PACKED_INLINE inline
+#endif
+
+typedef unsigned long long u64;
+
+//distance flavours, the IGNORE versions are used when countends=f
+enum { PACKED_NOGAPS, PACKED_EACHGAP, PACKED_ONEGAP, PACKED_EACHGAP_IGNORE, PACKED_ONEGAP_IGNORE };
+
+//column tests used to find the start, end and stop of the comparison
+enum { NOT_BOTH_DOT, BOTH_DOT, BOTH_BASE, NO_DOT, ANY_DOT };
+
+/**************************************************************************************************/
+PACKED_INLINE int packedPopCount(u64 x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    while (x) { x &= x - 1; count++; }
+    return count;
+#endif
+}
+/**************************************************************************************************/
+PACKED_INLINE int packedLowBit(u64 x) { //x != 0
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int bit = 0;
+    while (!(x & 1ULL)) { x >>= 1; bit++; }
+    return bit;
+#endif
+}
+/**************************************************************************************************/
+PACKED_INLINE int packedHighBit(u64 x) { //x != 0
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(x);
+#else
+    int bit = 63;
+    while (!(x & (1ULL << 63))) { x <<= 1; bit--; }
+    return bit;
+#endif
+}
+/**************************************************************************************************/
+//bits of word w inside columns [lo, hi)
+PACKED_INLINE u64 packedRange(int w, int lo, int hi) {
+    int base = w * 64;
+    u64 mask = ~0ULL;
+    if (lo > base)      { mask &= ~0ULL << (lo - base);         }
+    if (hi < base + 64) { mask &= ~0ULL >> (64 - (hi - base));  }
+    return mask;
+}
+/**************************************************************************************************/
+template<int TEST, int RS>
+PACKED_INLINE u64 packedColumns(const u64* a, const u64* b, int w) {
+    const u64* ra = a + (w * RS); const u64* rb = b + (w * RS);
+
+    if (TEST == NOT_BOTH_DOT)   { return ~(ra[1] & rb[1]);                      }
+    else if (TEST == BOTH_DOT)  { return ra[1] & rb[1];                         }
+    else if (TEST == BOTH_BASE) { return ~(ra[0] | ra[1] | rb[0] | rb[1]);      }
+    else if (TEST == NO_DOT)    { return ~(ra[1] | rb[1]);                      }
+    else                        { return ra[1] | rb[1];                         } //ANY_DOT
+}
+/**************************************************************************************************/
+//first column >= from that passes the test
+template<int TEST, int RS>
+PACKED_INLINE int packedFirst(const u64* a, const u64* b, int from, int numWords, int notFound) {
+    for (int w = from / 64; w < numWords; w++) {
+        u64 x = packedColumns<TEST, RS>(a, b, w);
+        if (w == from / 64) { x &= ~0ULL << (from % 64); }
+        if (x) { return (w * 64) + packedLowBit(x); }
+    }
+    return notFound;
+}
+/**************************************************************************************************/
+//last column that passes the test
+template<int TEST, int RS>
+PACKED_INLINE int packedLast(const u64* a, const u64* b, int numWords, int notFound) {
+    for (int w = numWords-1; w >= 0; w--) {
+        u64 x = packedColumns<TEST, RS>(a, b, w);
+        if (x) { return (w * 64) + packedHighBit(x); }
+    }
+    return notFound;
+}
+/**************************************************************************************************/
+//columns where seqs have different characters
+template<int PLANES>
+PACKED_INLINE u64 packedMismatches(const u64* ra, const u64* rb) {
+    u64 diff = (ra[0] ^ rb[0]) | (ra[1] ^ rb[1]);
+    for (int p = 0; p < PLANES; p++) { diff |= ra[2+p] ^ rb[2+p]; }
+    return diff;
+}
+/**************************************************************************************************/
+//onegap counts a run of gaps in one sequence as a single difference. Columns where both seqs are gaps don't end a run.
+//returns the gap columns of x that continue a run, gg are the gap-gap columns and carry is whether the run continues into the next word.
+PACKED_INLINE u64 packedRunContinues(u64 x, u64 gg, u64& carry) {
+    u64 gen = x | (gg & carry);
+    u64 pro = gg;
+
+    //fill runs forward through the gap-gap columns
+    gen |= pro & (gen << 1);    pro &= pro << 1;
+    gen |= pro & (gen << 2);    pro &= pro << 2;
+    gen |= pro & (gen << 4);    pro &= pro << 4;
+    gen |= pro & (gen << 8);    pro &= pro << 8;
+    gen |= pro & (gen << 16);   pro &= pro << 16;
+    gen |= pro & (gen << 32);
+
+    u64 continues = x & ((gen << 1) | carry);
+    carry = gen >> 63;
+
+    return continues;
+}
+/**************************************************************************************************/
+template<int FLAVOUR, int PLANES>
+PACKED_INLINE double packedKernel(const u64* a, const u64* b, int numWords, double cutoff, bool& abandoned) {
+    const int RS = 2 + PLANES;
+    bool checkCutoff = (cutoff < 1.0); //diff can't be larger than length
+    int start, end, stop;
+    long long length;
+
+    if ((FLAVOUR == PACKED_EACHGAP) || (FLAVOUR == PACKED_ONEGAP)) {
+        start = packedFirst<NOT_BOTH_DOT, RS>(a, b, 0, numWords, 0);
+        end = packedLast<NOT_BOTH_DOT, RS>(a, b, numWords, 0);
+        length = end - start + 1;
+        stop = packedFirst<BOTH_DOT, RS>(a, b, start, numWords, numWords*64); //reached terminal gaps
+    }else if (FLAVOUR == PACKED_NOGAPS) {
+        start = packedFirst<NO_DOT, RS>(a, b, 0, numWords, -1);
+        if (start == -1) { return 1.0000; } //non-overlapping sequences
+        end = packedLast<NO_DOT, RS>(a, b, numWords, 0);
+        length = end - start + 1;
+        stop = packedFirst<ANY_DOT, RS>(a, b, start, numWords, numWords*64);
+    }else {
+        start = packedFirst<BOTH_BASE, RS>(a, b, 0, numWords, -1);
+        if (start == -1) { return 1.0000; } //non-overlapping sequences
+        end = packedLast<BOTH_BASE, RS>(a, b, numWords, 0);
+        if (FLAVOUR == PACKED_ONEGAP_IGNORE) {
+            length = end - start;
+            stop = end + 1;
+        }else {
+            length = end - start + 1;
+            stop = packedFirst<ANY_DOT, RS>(a, b, start, numWords, numWords*64);
+        }
+    }
+
+    long long diff = 0;
+    u64 carryA = 0; u64 carryB = 0;
+
+    for (int w = start / 64; (w * 64) < stop; w++) {
+        const u64* ra = a + (w * RS); const u64* rb = b + (w * RS);
+        u64 range = packedRange(w, start, stop);
+        u64 mismatch = packedMismatches<PLANES>(ra, rb);
+
+        if ((FLAVOUR == PACKED_ONEGAP) || (FLAVOUR == PACKED_ONEGAP_IGNORE)) {
+            u64 gapA, gapB;
+            if (FLAVOUR == PACKED_ONEGAP) { gapA = ra[0] | ra[1]; gapB = rb[0] | rb[1]; }
+            else                          { gapA = ra[0];         gapB = rb[0];         }
+
+            u64 gapGap = gapA & gapB & range;
+            u64 gapInA = gapA & ~gapB & range;
+            u64 gapInB = gapB & ~gapA & range;
+            u64 bases = ~(gapA | gapB) & range;
+
+            u64 continuesA = packedRunContinues(gapInA, gapGap, carryA);
+            u64 continuesB = packedRunContinues(gapInB, gapGap, carryB);
+            int numContinues = packedPopCount(continuesA) + packedPopCount(continuesB);
+
+            length -= packedPopCount(gapGap) + numContinues;
+            diff += packedPopCount(bases & mismatch) + packedPopCount(gapInA) + packedPopCount(gapInB) - numContinues;
+        }else {
+            u64 gapGap;
+            if (FLAVOUR == PACKED_EACHGAP)              { gapGap = (ra[0] & rb[0]) | (ra[0] & rb[1]) | (ra[1] & rb[0]); }
+            else if (FLAVOUR == PACKED_EACHGAP_IGNORE)  { gapGap = ra[0] & rb[0];                                       }
+            else                                        { gapGap = ra[0] | rb[0];                                       } //nogaps
+
+            length -= packedPopCount(gapGap & range);
+            diff += packedPopCount(~gapGap & mismatch & range);
+        }
+        
+        //length only shrinks and diff only grows as we go, so once we are over the cutoff we will stay there.
+        //this is the same test the string calcs make after each column.
+        if (checkCutoff && (length > 0)) {
+            if (((double)diff / length) > cutoff) { abandoned = true; return 1.0000; }
+        }
+    }
+
+    if (length <= 0) { return 1.0000; }
+
+    double dist = (double)diff / length;
+
+    if (dist > cutoff) { return 1.0000; }
+
+    return dist;
+}
+/**************************************************************************************************/
+template<int FLAVOUR, int PLANES>
+double packedDistScalar(const u64* a, const u64* b, int numWords, double cutoff, bool& abandoned) {
+    return packedKernel<FLAVOUR, PLANES>(a, b, numWords, cutoff, abandoned);
+}
+#ifdef PACKED_DISPATCH
+//the same kernel built for newer cpus, so the popcounts compile to popcnt and, with bmi, the low bit scans to tzcnt
+template<int FLAVOUR, int PLANES> __attribute__((target("sse4.2,popcnt")))
+double packedDistSSE(const u64* a, const u64* b, int numWords, double cutoff, bool& abandoned) {
+    return packedKernel<FLAVOUR, PLANES>(a, b, numWords, cutoff, abandoned);
+}
+template<int FLAVOUR, int PLANES> __attribute__((target("avx2,bmi,popcnt")))
+double packedDistAVX2(const u64* a, const u64* b, int numWords, double cutoff, bool& abandoned) {
+    return packedKernel<FLAVOUR, PLANES>(a, b, numWords, cutoff, abandoned);
+}
+#endif
+/**************************************************************************************************/
+template<int FLAVOUR>
+PackedDistKernel packedSelectKernel(int numPlanes, string& kernelName) {
+#ifdef PACKED_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("popcnt")) {
+        kernelName = "avx2";
+        if (numPlanes == 2) { return packedDistAVX2<FLAVOUR, 2>; }
+        return packedDistAVX2<FLAVOUR, 4>;
+    }else if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+        kernelName = "sse4.2";
+        if (numPlanes == 2) { return packedDistSSE<FLAVOUR, 2>; }
+        return packedDistSSE<FLAVOUR, 4>;
+    }
+#endif
+    kernelName = "scalar";
+    if (numPlanes == 2) { return packedDistScalar<FLAVOUR, 2>; }
+    return packedDistScalar<FLAVOUR, 4>;
+}
+/**************************************************************************************************/
+PackedDist::PackedDist(PackedSeqDB* d, string calc, bool countends, double c, bool p) {
+    try {
+        m = MothurOut::getInstance();
+        db = d; cutoff = c;
+        numWords = db->getNumWords();
+        numComputed = 0; numAbandoned = 0; numSkipped = 0;
+        
+        //with countends every base of both seqs is compared, so the lengths and base composition bound the distance
+        eachGap = (calc == "eachgap");
+        prefilter = p && ((calc == "eachgap") || (calc == "onegap")) && countends && (cutoff < 1.0);
+
+        int numPlanes = db->getNumPlanes();
+
+        if (calc == "nogaps")           {   kernel = packedSelectKernel<PACKED_NOGAPS>(numPlanes, kernelName);    }
+        else if (calc == "eachgap") {
+            if (countends)  {   kernel = packedSelectKernel<PACKED_EACHGAP>(numPlanes, kernelName);          }
+            else            {   kernel = packedSelectKernel<PACKED_EACHGAP_IGNORE>(numPlanes, kernelName);   }
+        }else { //onegap
+            if (countends)  {   kernel = packedSelectKernel<PACKED_ONEGAP>(numPlanes, kernelName);           }
+            else            {   kernel = packedSelectKernel<PACKED_ONEGAP_IGNORE>(numPlanes, kernelName);    }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "PackedDist");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//If both seqs only have '.'s at their ends and they overlap, every base is compared and the columns compared are from
+//the first non '.' to the last. Two bases can only match if the other seq has the same base, so the sum over A, C, G, T
+//and other of the smaller count is an upper bound on the matches.
+//eachgap counts every column where one seq has a base and the other doesn't, so the difference in the number of bases
+//is a lower bound on the mismatches, and every column with a base that doesn't match is a difference.
+//onegap charges one difference per gap, which only pushes the distance towards 1, so the mismatches over the columns
+//where both seqs have a base are a lower bound. There are at least numBasesA + numBasesB - length of those columns.
+bool PackedDist::isAboveCutoff(long long i, long long j) {
+    try {
+        const PackedSeqSummary& a = db->getSummary(i);
+        const PackedSeqSummary& b = db->getSummary(j);
+        
+        if (!a.terminalDotsOnly || !b.terminalDotsOnly) { return false; }
+        if ((a.start > b.end) || (b.start > a.end))     { return false; } //non overlapping
+        
+        long long length = max(a.end, b.end) - min(a.start, b.start) + 1;
+        
+        long long maxMatches = 0;
+        for (int k = 0; k < 5; k++) { maxMatches += min(a.baseCounts[k], b.baseCounts[k]); }
+        
+        if (eachGap) {
+            long long minDiffs = a.numBases - b.numBases;
+            if (minDiffs < 0) { minDiffs = -minDiffs; }
+            
+            if (((double)minDiffs / length) > cutoff) { return true; }
+            
+            long long longest = max(a.numBases, b.numBases);
+            if (longest > maxMatches) { return (((double)(longest - maxMatches) / longest) > cutoff); }
+        }else {
+            long long minBoth = a.numBases + b.numBases - length;
+            if (minBoth > maxMatches) { return (((double)(minBoth - maxMatches) / minBoth) > cutoff); }
+        }
+        
+        return false;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "isAboveCutoff");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -11,6 +11,11 @@
 #include "kmer.hpp"
 #include "phylosummary.h"
 
+#if defined NON_WINDOWS
+    #include <sys/mman.h>
+    #include <fcntl.h>
+#endif
+
 /**************************************************************************************************/
 Bayesian::Bayesian(string txfile, string tempFile, string method, int ksize, int cutoff, int i, int tid, bool f, bool sh, string version) :
 Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
@@ -19,6 +24,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 		threadID = tid;
 		flip = f;
         shortcuts = sh;
+        genusProbs = NULL; mappedModel = NULL; mappedModelSize = 0; numGenera = 0;
         string baseName = tempFile;
         string baseTName = txfile;
         Utils util;
@@ -30,6 +36,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
         string phyloTreeSumName = tfileroot + "tree.sum";
         string probFileName = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.prob";
         string probFileName2 = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.numNonZero";
+        string modelFileName = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.model";
         
         ofstream out;
         ofstream out2;
@@ -45,8 +52,23 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 		//if they are there make sure they were created after this release date
 		bool FilesGood = false;
 		if(probFileTest && probFileTest2 && phyloTreeTest && probFileTest3){ FilesGood = checkReleaseDate(files, version); }
+        
+        //the model file replaces the .prob and .numNonZero files
+        bool ModelGood = false;
+        if (!FilesGood) {
+            ifstream* modelTest = new ifstream(modelFileName.c_str());
+            
+            //the tree files were closed by the failed check, so reopen them
+            phyloTreeTest->close(); phyloTreeTest->clear(); phyloTreeTest->open(phyloTreeName.c_str());
+            probFileTest3->close(); probFileTest3->clear(); probFileTest3->open(phyloTreeSumName.c_str());
+            vector<ifstream*> treeFiles; treeFiles.push_back(phyloTreeTest); treeFiles.push_back(probFileTest3);
+            vector<ifstream*> modelFiles; modelFiles.push_back(modelTest);
+            if (checkReleaseDate(modelFiles, version)) { ModelGood = checkReleaseDate(treeFiles, version); }
+            modelTest->close(); delete modelTest;
+        }
 
-		if(probFileTest && probFileTest2 && phyloTreeTest && probFileTest3 && FilesGood){
+		bool loaded = false;
+		if((probFileTest && probFileTest2 && phyloTreeTest && probFileTest3 && FilesGood) || ModelGood){
 			
 			m->mothurOut("Reading template taxonomy...     "); cout.flush();
 			
@@ -59,9 +81,20 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 			genusTotals = phyloTree->getGenusTotals();
 			
             m->mothurOut("Reading template probabilities...     "); cout.flush();
-            readProbFile(*probFileTest, *probFileTest2, probFileName, probFileName2);
-			
-        }else{
+            if (readModelFile(modelFileName)) { loaded = true; }
+            else if (FilesGood) {
+                readProbFile(*probFileTest, *probFileTest2, probFileName, probFileName2);
+                if (shortcuts) { writeModelFile(modelFileName, version); }
+                loaded = true;
+            }else {
+                //the .prob files are from an older version, so the probabilities are calculated again
+                m->mothurOut("\n" + modelFileName + " does not match the template, recalculating the probabilities.\n");
+                delete phyloTree; WordPairDiffArr.clear();
+                util.mothurRemove(modelFileName); util.mothurRemove(probFileName); util.mothurRemove(probFileName2);
+            }
+        }
+        
+        if (!loaded) {
 		
 			//create search database and names vector
 			generateDatabaseAndNames(txfile, tempFile, method, ksize, 0.0, 0.0, 0.0, 0.0, version);
@@ -83,10 +116,9 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 				numKmers = database->getMaxKmer() + 1;
 			
 				//initialze probabilities
-				wordGenusProb.resize(numKmers);
+				numGenera = genusNodes.size();
+				wordGenusProb.assign((long long)numKmers * numGenera, 0.0);
                 for (int j = 0; j < numKmers; j++) {  diffPair tempDiffPair; WordPairDiffArr.push_back(tempDiffPair); }
-			
-                for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size(), 0.0);		}
                 ofstream out; ofstream out2;
 
                 if (shortcuts) { 
@@ -126,14 +158,15 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 					WordPairDiffArr[i] = tempProb;
 						
 					int numNotZero = 0;
+					float* genusProb = &wordGenusProb[(long long)i * numGenera];
 					for (int k = 0; k < genusNodes.size(); k++) {
 						//probabilityInThisTaxonomy = (# of seqs with that word in this taxonomy + probabilityInTemplate) / (total number of seqs in this taxonomy + 1);
 						
 						
-						wordGenusProb[i][k] = log((count[k] + probabilityInTemplate) / (float) (genusTotals[k] + 1));  
+						genusProb[k] = log((count[k] + probabilityInTemplate) / (float) (genusTotals[k] + 1));  
 									
 						if (count[k] != 0) {
-                            if (shortcuts) { out << k << '\t' << wordGenusProb[i][k] << '\t' ; }
+                            if (shortcuts) { out << k << '\t' << genusProb[k] << '\t' ; }
 							numNotZero++;
 						}
 					}
@@ -145,7 +178,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
                     }
                     
 				}
-                if (shortcuts) { out.close(); out2.close();  }
+                if (shortcuts) { out.close(); out2.close(); writeModelFile(modelFileName, version); }
 				
 				//read in new phylotree with less info. - its faster
 				ifstream phyloTreeTest(phyloTreeName.c_str());
@@ -156,6 +189,8 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 			}
 		}
 		
+        if (genusProbs == NULL) { genusProbs = wordGenusProb.data(); }
+        
         if (m->getDebug()) { m->mothurOut("[DEBUG]: about to generateWordPairDiffArr\n"); }
 		generateWordPairDiffArr();
         if (m->getDebug()) { m->mothurOut("[DEBUG]: done generateWordPairDiffArr\n"); }
@@ -173,6 +208,9 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 /**************************************************************************************************/
 Bayesian::~Bayesian() {
 	try {
+#if defined NON_WINDOWS
+        if (mappedModel != NULL) { munmap(mappedModel, mappedModelSize); }
+#endif
         if (phyloTree != NULL) { delete phyloTree; }
         if (database != NULL) {  delete database; }
 	}
@@ -220,7 +258,8 @@ string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped) {
 		if (queryKmers.size() == 0) {  m->mothurOut(seq->getName() + " is bad. It has no kmers of length " + toString(kmerSize) + ".\n");  simpleTax = "unknown;";  return "unknown;"; }
 		
 		
-		int index = getMostProbableTaxonomy(queryKmers);
+		vector<double> genusScores(numGenera, 0.0);
+		int index = getMostProbableTaxonomy(queryKmers, genusScores);
 		
 		if (m->getControl_pressed()) { return tax; }
 					
@@ -229,7 +268,7 @@ string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped) {
 	
         if (m->getDebug()) {  m->mothurOut(seq->getName() + "\t"); }
         
-		tax = bootstrapResults(queryKmers, index, numToSelect, simpleTax);
+		tax = bootstrapResults(queryKmers, index, numToSelect, simpleTax, genusScores);
         
         if (m->getDebug()) {  m->mothurOut("\n"); }
 		
@@ -241,7 +280,7 @@ string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped) {
 	}
 }
 /**************************************************************************************************/
-string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, string& simpleTax) {
+string Bayesian::bootstrapResults(vector<int>& kmers, int tax, int numToSelect, string& simpleTax, vector<double>& genusScores) {
 	try {
 				
 		map<int, int> confidenceScores; 
@@ -263,19 +302,19 @@ string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, s
         
         int numKmers = kmers.size()-1;
         Utils util;
+        vector<int> temp(numToSelect);
 		for (int i = 0; i < iters; i++) {
 			if (m->getControl_pressed()) { return "control"; }
 			
-            vector<int> temp;
 			for (int j = 0; j < numToSelect; j++) {
 				int index = util.getRandomIndex(numKmers);
                 
 				//add word to temp
-				temp.push_back(kmers[index]);
+				temp[j] = kmers[index];
 			}
             
 			//get taxonomy
-			int newTax = getMostProbableTaxonomy(temp);
+			int newTax = getMostProbableTaxonomy(temp, genusScores);
 			//int newTax = 1;
 			TaxNode taxonomyTemp = phyloTree->get(newTax);
 			
@@ -331,23 +370,28 @@ string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, s
 	}
 }
 /**************************************************************************************************/
-int Bayesian::getMostProbableTaxonomy(vector<int> queryKmer) {
+//adds up the kmers' rows of genus probabilities, so the inner loop runs over contiguous floats and the compiler can
+//vectorize it. Each genus' sum is still added in the order of the kmers, so the scores are the same as adding them
+//up one genus at a time.
+int Bayesian::getMostProbableTaxonomy(vector<int>& queryKmer, vector<double>& genusScores) {
 	try {
 		int indexofGenus = 0;
 		
+		double* scores = &genusScores[0];
+		for (int k = 0; k < numGenera; k++) { scores[k] = 0.0000; }
+		
+		for (int i = 0; i < queryKmer.size(); i++) {
+			const float* genusProb = genusProbs + (long long)queryKmer[i] * numGenera;
+			for (int k = 0; k < numGenera; k++) { scores[k] += genusProb[k]; }
+		}
+		
 		double maxProbability = -1000000.0;
 		//find taxonomy with highest probability that this sequence is from it
-
-        for (int k = 0; k < genusNodes.size(); k++) {
-			//for each taxonomy calc its probability
-			
-			double prob = 0.0000;
-			for (int i = 0; i < queryKmer.size(); i++) { prob += wordGenusProb[queryKmer[i]][k]; }
-
+        for (int k = 0; k < numGenera; k++) {
 			//is this the taxonomy with the greatest probability?
-			if (prob > maxProbability) { 
+			if (scores[k] > maxProbability) { 
 				indexofGenus = genusNodes[k];
-				maxProbability = prob;
+				maxProbability = scores[k];
 			}
 		}
 			
@@ -399,6 +443,126 @@ int Bayesian::generateWordPairDiffArr(){
 	}
 }
 /**************************************************************************************************/
+//the model is only read if it was made from a reference with the same genera as the tree
+bool Bayesian::readModelFile(string modelFileName) {
+	try{
+		Utils util;
+        
+        ifstream in; 
+        if (!util.openInputFile(modelFileName, in, "no error")) { return false; }
+        string line = util.getline(in);
+        unsigned long long headerStart = ((line.length() + 1 + 7) / 8) * 8;
+        
+        char magic[8] = { 0 };
+        unsigned int fileVersion = 0, k = 0;
+        unsigned long long numKmersInFile = 0, numGeneraInFile = 0;
+        in.seekg(headerStart);
+        in.read(magic, 8);
+        in.read((char*)&fileVersion, sizeof(unsigned int));
+        in.read((char*)&k, sizeof(unsigned int));
+        in.read((char*)&numKmersInFile, sizeof(unsigned long long));
+        in.read((char*)&numGeneraInFile, sizeof(unsigned long long));
+        if (!in || (strncmp(magic, BAYESIAN_MODEL_MAGIC, 8) != 0) || (fileVersion != BAYESIAN_MODEL_VERSION) || (k != kmerSize) || (numGeneraInFile != genusNodes.size())) { in.close(); return false; }
+        
+        vector<int> fileNodes(numGeneraInFile), fileTotals(numGeneraInFile);
+        vector<float> kmerProbs(numKmersInFile);
+        in.read((char*)fileNodes.data(), numGeneraInFile*sizeof(int));
+        in.read((char*)fileTotals.data(), numGeneraInFile*sizeof(int));
+        in.read((char*)kmerProbs.data(), numKmersInFile*sizeof(float));
+        if (!in || (fileNodes != genusNodes) || (fileTotals != genusTotals)) { in.close(); return false; }
+        
+        unsigned long long tableStart = (unsigned long long)in.tellg();
+        tableStart = ((tableStart + 7) / 8) * 8;
+        unsigned long long tableSize = numKmersInFile * numGeneraInFile * sizeof(float);
+        
+        numKmers = numKmersInFile; numGenera = numGeneraInFile;
+        WordPairDiffArr.assign(numKmers, diffPair());
+        for (int i = 0; i < numKmers; i++) { WordPairDiffArr[i].prob = kmerProbs[i]; }
+        
+#if defined NON_WINDOWS
+        in.close();
+        
+        int fd = open(modelFileName.c_str(), O_RDONLY);
+        if (fd == -1) { return false; }
+        struct stat fileInfo;
+        if ((fstat(fd, &fileInfo) == -1) || ((unsigned long long)fileInfo.st_size < (tableStart + tableSize))) { close(fd); return false; }
+        
+        mappedModelSize = fileInfo.st_size;
+        mappedModel = mmap(NULL, mappedModelSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mappedModel == MAP_FAILED) { mappedModel = NULL; mappedModelSize = 0; return false; }
+        
+        genusProbs = (const float*)((const char*)mappedModel + tableStart);
+#else
+        wordGenusProb.resize(numKmers * numGenera);
+        in.seekg(tableStart);
+        in.read((char*)wordGenusProb.data(), tableSize);
+        if (!in) { in.close(); return false; }
+        in.close();
+        
+        genusProbs = wordGenusProb.data();
+#endif
+        
+        return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "readModelFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//written to a temp file and renamed over the old model, a process that has the old one mapped keeps reading it
+void Bayesian::writeModelFile(string modelFileName, string version) {
+	try{
+		Utils util;
+        
+        string tempName = modelFileName + ".temp";
+#if defined NON_WINDOWS
+        tempName = modelFileName + "." + toString(getpid()) + ".temp";
+#endif
+        
+        ofstream out;
+        if (!util.openOutputFileBinary(tempName, out)) { return; }
+        
+        string versionLine = "#" + version + "\n";
+        while ((versionLine.length() % 8) != 0) { versionLine += '\0'; }
+        out.write(versionLine.c_str(), versionLine.length());
+        
+        unsigned int fileVersion = BAYESIAN_MODEL_VERSION; unsigned int k = kmerSize;
+        unsigned long long numKmersInFile = numKmers; unsigned long long numGeneraInFile = numGenera;
+        out.write(BAYESIAN_MODEL_MAGIC, 8);
+        out.write((char*)&fileVersion, sizeof(unsigned int));
+        out.write((char*)&k, sizeof(unsigned int));
+        out.write((char*)&numKmersInFile, sizeof(unsigned long long));
+        out.write((char*)&numGeneraInFile, sizeof(unsigned long long));
+        
+        out.write((char*)genusNodes.data(), numGenera*sizeof(int));
+        out.write((char*)genusTotals.data(), numGenera*sizeof(int));
+        
+        vector<float> kmerProbs(numKmers);
+        for (int i = 0; i < numKmers; i++) { kmerProbs[i] = WordPairDiffArr[i].prob; }
+        out.write((char*)kmerProbs.data(), numKmers*sizeof(float));
+        if ((numKmers % 2) != 0) { float pad = 0; out.write((char*)&pad, sizeof(float)); }
+        
+        out.write((char*)wordGenusProb.data(), (unsigned long long)numKmers*numGenera*sizeof(float));
+        bool good = out.good();
+        out.close();
+        
+        if (!good) { m->mothurOut("[WARNING]: unable to write " + modelFileName + ".\n"); util.mothurRemove(tempName); return; }
+        
+#if !defined NON_WINDOWS
+        util.mothurRemove(modelFileName); //windows won't rename over an existing file
+#endif
+        if (rename(util.getFullPathName(tempName).c_str(), util.getFullPathName(modelFileName).c_str()) != 0) {
+            m->mothurOut("[WARNING]: unable to rename " + tempName + " to " + modelFileName + ".\n"); util.mothurRemove(tempName);
+        }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "writeModelFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string inNumName) {
 	try{
 		Utils util;
@@ -408,8 +572,8 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
         in >> numKmers; util.gobble(in);
         //initialze probabilities
         
-        wordGenusProb.resize(numKmers);
-        for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size());		}
+        numGenera = genusNodes.size();
+        wordGenusProb.assign((long long)numKmers * numGenera, 0.0);
         
         int kmer, name, count;  count = 0;
         vector<int> num; num.resize(numKmers);
@@ -437,14 +601,15 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
             in >> kmer;
             
             //set them all to zero value
+            float* genusProb = &wordGenusProb[(long long)kmer * numGenera];
             for (int i = 0; i < genusNodes.size(); i++) {
-                wordGenusProb[kmer][i] = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
+                genusProb[i] = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
             }
            
             //get probs for nonzero values
             for (int i = 0; i < num[kmer]; i++) {
                 in >> name >> prob;
-                wordGenusProb[kmer][name] = prob;
+                genusProb[name] = prob;
                 if (m->getDebug()) { m->mothurOut("[DEBUG]: " + toString(name) + '\t' + toString(prob) + '\t' + toString(kmer) + "\n"); }
             }
             
@@ -13,10 +13,24 @@
 #include "mothur.h"
 #include "classify.h"
 
+#define BAYESIAN_MODEL_MAGIC "MOTHURWM"
+#define BAYESIAN_MODEL_VERSION 1
+
+/* The template probabilities can be saved as a binary model file, [taxonomy root][reference root].8mer.model, next to
+ the text shortcut files. It holds the genus nodes and totals, the probability of each kmer in the template and the
+ kmer by genus probability table, after a version line padded to 8 bytes:
+    header      - "MOTHURWM", version, kmer size, number of kmers, number of genera
+    genusNodes  - numGenera ints, then genusTotals - numGenera ints
+    kmerProbs   - numKmers floats, log probability of each kmer in the template, padded to 8 bytes
+    table       - numKmers rows of numGenera floats
+ The table is used straight from the mapped file, so classify.seqs runs on the same reference share one copy. */
+
 /**************************************************************************************************/
 
 class Bayesian : public Classify {
 	
+    friend class TestBayesian;
+    
 public:
 	Bayesian(string, string, string, int, int, int, int, bool, bool, string);
 	~Bayesian();
@@ -24,19 +38,24 @@ public:
 	string getTaxonomy(Sequence*, string&, bool&);
 	
 private:
-	vector< vector<float> > wordGenusProb;	//vector of maps from genus to probability
-										//wordGenusProb[0][392] = probability that a sequence within genus that's index in the tree is 392 would contain kmer 0;
+	vector<float> wordGenusProb;	//the genus probabilities of each kmer, one row of genusNodes.size() floats per kmer
+									//wordGenusProb[0*numGenera+392] = probability that a sequence within genus that's index in the tree is 392 would contain kmer 0;
+	const float* genusProbs;		//wordGenusProb, or the same table in the mapped model file
+	void* mappedModel;
+	unsigned long long mappedModelSize;
 	
 	vector<int> genusTotals;
 	vector<int> genusNodes;  //indexes in phyloTree where genus' are located
 	
 	vector<diffPair> WordPairDiffArr; 
 	
-	int kmerSize, numKmers, confidenceThreshold, iters;
+	int kmerSize, numKmers, numGenera, confidenceThreshold, iters;
 	
-	string bootstrapResults(vector<int>, int, int, string&);
-	int getMostProbableTaxonomy(vector<int>);
+	string bootstrapResults(vector<int>&, int, int, string&, vector<double>&);
+	int getMostProbableTaxonomy(vector<int>&, vector<double>&); //kmers, space for the genus scores
 	void readProbFile(ifstream&, ifstream&, string, string);
+	bool readModelFile(string);
+	void writeModelFile(string, string); //filename, version
 	bool isReversed(vector<int>&);
 	vector<int> createWordIndexArr(Sequence*);
 	int generateWordPairDiffArr();
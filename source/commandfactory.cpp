@@ -154,6 +154,8 @@
 #include "diversityestimatorcommand.hpp"
 #include "srainfocommand.hpp"
 #include "makeclrcommand.hpp"
+#include "convertdistcommand.hpp"
+#include "setprofilecommand.h"
 
 /*******************************************************/
 
@@ -324,6 +326,8 @@ CommandFactory::CommandFactory(){
     commands["estimator.single"]    = "estimator.single";
     commands["sra.info"]            = "sra.info";
     commands["make.clr"]            = "make.clr";
+    commands["convert.dist"]        = "convert.dist";
+    commands["set.profile"]         = "set.profile";
 
 }
 
@@ -562,6 +566,8 @@ Command* CommandFactory::getCommand(string commandName, string optionString){
         else if(commandName == "estimator.single")      {	command = new EstimatorSingleCommand(optionString);         }
         else if(commandName == "sra.info")              {   command = new SRAInfoCommand(optionString);                 }
         else if(commandName == "make.clr")              {   command = new MakeCLRCommand(optionString);                 }
+        else if(commandName == "convert.dist")          {   command = new ConvertDistCommand(optionString);             }
+        else if(commandName == "set.profile")           {   command = new SetProfileCommand(optionString);              }
 		else											{	command = new NoCommand(optionString);						}
 
 		return command;
@@ -739,6 +745,8 @@ Command* CommandFactory::getCommand(string commandName, string optionString, str
         else if(commandName == "estimator.single")      {	pipecommand = new EstimatorSingleCommand(optionString);         }
         else if(commandName == "sra.info")              {   pipecommand = new SRAInfoCommand(optionString);                 }
         else if(commandName == "make.clr")              {   pipecommand = new MakeCLRCommand(optionString);                 }
+        else if(commandName == "convert.dist")          {   pipecommand = new ConvertDistCommand(optionString);             }
+        else if(commandName == "set.profile")           {   pipecommand = new SetProfileCommand(optionString);              }
 		else											{	pipecommand = new NoCommand(optionString);						}
         
         
@@ -28,6 +28,7 @@ vector<string> AlignCommand::setParameters(){
 		CommandParameter pmismatch("mismatch", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pmismatch);
 		CommandParameter pgapopen("gapopen", "Number", "", "-5.0", "", "", "","",false,false); parameters.push_back(pgapopen);
 		CommandParameter pgapextend("gapextend", "Number", "", "-2.0", "", "", "","",false,false); parameters.push_back(pgapextend);
+		CommandParameter pband("band", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pband);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pflip("flip", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pflip);
 		CommandParameter pthreshold("threshold", "Number", "", "0.50", "", "", "","",false,false); parameters.push_back(pthreshold);
@@ -65,6 +66,7 @@ string AlignCommand::getHelpString(){
 		helpString += "The mistmatch parameter allows you to specify the penalty for having different bases. Default=-1.0.\n";
 		helpString += "The gapopen parameter allows you to specify the penalty for opening a gap in an alignment. Default=-5.0.\n";
 		helpString += "The gapextend parameter allows you to specify the penalty for extending a gap in an alignment. Default=-2.0.\n";
+		helpString += "The band parameter allows you to limit the needleman and gotoh alignments to the bases within band of the diagonal your sequence shares the most kmers with its reference on. This uses less memory and time for long reads, but an alignment that needs more than band gaps isn't found. Default=0, meaning no band.\n";
         helpString += "If the flip parameter is set to true the reverse complement of the sequence is aligned and the better alignment is reported.";
 		helpString += " By default, mothur will align the reverse compliment of your sequences when the alignment process removes more than 50% of the bases indicating the read may be flipped. This process assembles the best possible alignment, and downstream analysis will remove any poor quality reads remaining.\n";
 		helpString += "The threshold is used to specify a cutoff at which an alignment is deemed 'bad' and the reverse complement may be tried. The default threshold is 0.50, meaning 50% of the bases are removed in the alignment.\n";
@@ -169,6 +171,10 @@ AlignCommand::AlignCommand(string option)  {
 			temp = validParameter.valid(parameters, "gapextend");	if (temp == "not found"){	temp = "-2.0";			}
 			util.mothurConvert(temp, gapExtend); 
 			
+			temp = validParameter.valid(parameters, "band");		if (temp == "not found"){	temp = "0";			}
+			util.mothurConvert(temp, band);
+			if (band < 0) { m->mothurOut("[ERROR]: band must be positive.\n"); abort=true; }
+			
 			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
 			processors = current->setProcessors(temp);
 			
@@ -273,35 +279,38 @@ int AlignCommand::execute(){
 	}
 }
 //**********************************************************************************************************************
+//a block of reads passed from the reader to the aligners and then on to the writer, numbered in the order it was read
+struct alignBatch {
+    long long number;
+    vector<Sequence> seqs;
+    string aligned, report, accnos;
+    
+    alignBatch() : number(0) {}
+};
+//**********************************************************************************************************************
 struct alignStruct {
-    OutputWriter* alignWriter;
-    OutputWriter* reportWriter;
-    OutputWriter* accnosWriter;
-    string inputFilename;
-    string alignMethod, search, templateFileName;
+    BoundedQueue<alignBatch*>* toAlign;
+    BoundedQueue<alignBatch*>* toWrite;
+    string alignMethod, search;
     float match, misMatch, gapOpen, gapExtend, threshold;
     bool flip;
-    long long numSeqs;
-    int kmerSize;
+    int kmerSize, band;
     
     vector<long long> flippedResults;
-    linePair filePos;
     
     MothurOut* m;
+    Profiler* profiler;
     Utils util;
     AlignmentDB* templateDB;
     Alignment* alignment;
+    TemplateProfileCache* templateCache;
     
-    alignStruct (linePair fP, OutputWriter* aFName, OutputWriter* reFName, OutputWriter* ac, string fname, AlignmentDB* tfn, string al, float ma, float misMa, float gOpen, float gExtend, float thr, bool fl, int ks, string se) {
-        
-        filePos.start = fP.start;
-        filePos.end = fP.end;
-        alignWriter = aFName;
-        reportWriter = reFName;
-        accnosWriter = ac;
-        inputFilename = fname;
-        numSeqs = 0;
+    alignStruct (BoundedQueue<alignBatch*>* ta, BoundedQueue<alignBatch*>* tw, AlignmentDB* tfn, string al, float ma, float misMa, float gOpen, float gExtend, float thr, bool fl, int ks, string se, int ba) {
+        
+        toAlign = ta;
+        toWrite = tw;
         m = MothurOut::getInstance();
+        profiler = Profiler::getInstance();
         match = ma;
         misMatch = misMa;
         gapOpen = gOpen;
@@ -310,6 +319,7 @@ struct alignStruct {
         flip = fl;
         search = se;
         kmerSize = ks;
+        band = ba;
         flippedResults.resize(2, 0);
         
         templateDB = tfn;
@@ -324,219 +334,299 @@ struct alignStruct {
             m->mothurOut(al + " is not a valid alignment option. I will run the command using needleman.\n");
             alignment = new NeedlemanOverlap(gapOpen, match, misMatch, longestBase);
         }
+        alignment->setBand(band);
+        
+        //keep about 64M of templates per thread, a 16S template is about 50K in the silva alignment and 1.5K unaligned
+        long long bytesPerTemplate = templateDB->getAlignmentLength() + (8 * longestBase) + 1;
+        long long numTemplates = (64 * 1024 * 1024) / bytesPerTemplate;
+        if (numTemplates > 4096)    { numTemplates = 4096;  }
+        if (numTemplates < 16)      { numTemplates = 16;    }
+        templateCache = new TemplateProfileCache(templateDB, numTemplates);
     }
-    ~alignStruct() { delete alignment;  }
+    ~alignStruct() { delete alignment; delete templateCache; }
     
 };
 //**********************************************************************************************************************
+//aligns candidateSeq and adds its alignment, report line and accnos entry to the batch's output
+void alignSequence(alignStruct* params, Sequence* candidateSeq, NastReport& report, alignBatch* batch) {
+	try {
+        report.setCandidate(candidateSeq);
+        
+        int origNumBases = candidateSeq->getNumBases();
+        string originalUnaligned = candidateSeq->getUnaligned();
+        int numBasesNeeded = origNumBases * params->threshold;
+        
+        if (candidateSeq->getUnaligned().length()+1 > params->alignment->getnRows()) {
+            if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: " + candidateSeq->getName() + " " + toString(candidateSeq->getUnaligned().length()) + " " + toString(params->alignment->getnRows()) + " \n"); }
+            params->alignment->resize(candidateSeq->getUnaligned().length()+2);
+        }
+        
+        float searchScore;
+        TemplateProfile* profile;
+        { ProfileTimer timer("search"); profile = params->templateCache->get(params->templateDB->findClosestSequenceIndex(candidateSeq, searchScore)); }
+        Sequence* templateSeq = &profile->seq;
+        
+        Nast* nast;
+        { ProfileTimer timer("align"); nast = new Nast(params->alignment, candidateSeq, templateSeq, &profile->baseColumns); }
+        
+        Sequence* copy;
+        
+        Nast* nast2;
+        bool needToDeleteCopy = false;  //this is needed in case you have you enter the ifs below
+                                        //since nast does not make a copy of hte sequence passed, and it is used by the reporter below
+                                        //you can't delete the copy sequence til after you report, but you may choose not to create it in the first place
+                                        //so this bool tells you if you need to delete it
+        
+        //if there is a possibility that this sequence should be reversed
+        if (candidateSeq->getNumBases() < numBasesNeeded) {
+            params->flippedResults[1]++;
+            //if the user wants you to try the reverse
+            if (params->flip) {
+                
+                //get reverse compliment
+                copy = new Sequence(candidateSeq->getName(), originalUnaligned);
+                copy->reverseComplement();
+                
+                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: flipping "  + candidateSeq->getName() + " \n"); }
+                
+                //rerun alignment
+                TemplateProfile* profile2;
+                { ProfileTimer timer("search"); profile2 = params->templateCache->get(params->templateDB->findClosestSequenceIndex(copy, searchScore)); }
+                Sequence* templateSeq2 = &profile2->seq;
+                
+                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: closest template "  + templateSeq2->getName() + " \n"); }
+                
+                { ProfileTimer timer("align"); nast2 = new Nast(params->alignment, copy, templateSeq2, &profile2->baseColumns); }
+                
+                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: completed Nast2 "  + candidateSeq->getName() + " flipped numBases = " + toString(copy->getNumBases()) + " old numbases = " + toString(candidateSeq->getNumBases()) +" \n"); }
+                
+                //check if any better
+                if (copy->getNumBases() > candidateSeq->getNumBases()) {
+                    candidateSeq->setAligned(copy->getAligned());  //use reverse compliments alignment since its better
+                    templateSeq = templateSeq2;
+                    delete nast;
+                    nast = nast2;
+                    needToDeleteCopy = true;
+                    batch->accnos += candidateSeq->getName() + '\n';
+                    params->flippedResults[0]++;
+                }else{
+                    delete nast2;
+                    delete copy;
+                }
+                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: done.\n"); }
+            }
+        }
+        
+        report.setTemplate(templateSeq);
+        report.setSearchParameters(params->search, searchScore);
+        report.setAlignmentParameters(params->alignMethod, params->alignment);
+        report.setNastParameters(*nast);
+        
+        batch->aligned += '>' + candidateSeq->getName() + '\n' + candidateSeq->getAligned() + '\n';
+        batch->report += report.getReport();
+        delete nast;
+        if (needToDeleteCopy) {   delete copy;   }
+	}
+	catch(exception& e) {
+		params->m->errorOut(e, "AlignCommand", "alignSequence");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//aligns the batches the reader puts in the queue until it is closed, and passes them on to the writer
 void alignDriver(alignStruct* params) {
 	try {
         NastReport report;
-		
-		ifstream inFASTA;
-		params->util.openInputFile(params->inputFilename, inFASTA);
-
-		inFASTA.seekg(params->filePos.start);
-
-		bool done = false;
         
-		long long count = 0;
-        long long numFlipped_0 = 0;
-        long long numFlipped_1 = 0;
-		
-		while (!done) {
-			
-			if (params->m->getControl_pressed()) {  break; }
-			
-			Sequence* candidateSeq = new Sequence(inFASTA);  params->util.gobble(inFASTA);
-			report.setCandidate(candidateSeq);
-
-			int origNumBases = candidateSeq->getNumBases();
-			string originalUnaligned = candidateSeq->getUnaligned();
-			int numBasesNeeded = origNumBases * params->threshold;
-	
-			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
-				if (candidateSeq->getUnaligned().length()+1 > params->alignment->getnRows()) {
-                    if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: " + candidateSeq->getName() + " " + toString(candidateSeq->getUnaligned().length()) + " " + toString(params->alignment->getnRows()) + " \n"); }
-					params->alignment->resize(candidateSeq->getUnaligned().length()+2);
-				}
+        alignBatch* batch;
+        while (params->toAlign->pop(batch)) {
+            
+            //keep passing the batches along when the command is stopped, so the reader and writer don't wait on them
+            if (!params->m->getControl_pressed()) {
+                for (int i = 0; i < batch->seqs.size(); i++) { alignSequence(params, &batch->seqs[i], report, batch); }
+                params->profiler->addItems("align", batch->seqs.size());
+            }
+            
+            params->toWrite->push(batch);
+        }
+	}
+	catch(exception& e) {
+		params->m->errorOut(e, "AlignCommand", "driver");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+struct alignOutput {
+    BoundedQueue<alignBatch*>* toWrite;
+    BoundedQueue<alignBatch*>* freeBatches;
+    string alignFileName, reportFileName, accnosFileName;
+    long long numSeqs;
+    
+    MothurOut* m;
+    Profiler* profiler;
+    Utils util;
+    
+    alignOutput(BoundedQueue<alignBatch*>* tw, BoundedQueue<alignBatch*>* fb, string afn, string rfn, string acfn) : toWrite(tw), freeBatches(fb), alignFileName(afn), reportFileName(rfn), accnosFileName(acfn) {
+        numSeqs = 0;
+        m = MothurOut::getInstance();
+        profiler = Profiler::getInstance();
+    }
+};
+//**********************************************************************************************************************
+//the aligners finish batches out of order, so they are held until the ones read before them are written. The output
+//files are in the same order as the fasta file and only this thread writes to them.
+void alignWriter(alignOutput* params) {
+	try {
+        ofstream outAlign, outReport, outAccnos;
+        params->util.openOutputFile(params->alignFileName, outAlign);
+        params->util.openOutputFile(params->reportFileName, outReport);
+        params->util.openOutputFile(params->accnosFileName, outAccnos);
+        
+        NastReport nast; outReport << nast.getHeaders();
+        
+        map<long long, alignBatch*> finished;
+        long long nextBatch = 0;
+        
+        alignBatch* batch;
+        while (params->toWrite->pop(batch)) {
+            finished[batch->number] = batch;
+            
+            for (map<long long, alignBatch*>::iterator it = finished.find(nextBatch); it != finished.end(); it = finished.find(nextBatch)) {
+                batch = it->second;
                 
-                float searchScore;
-				Sequence temp = params->templateDB->findClosestSequence(candidateSeq, searchScore);
-				Sequence* templateSeq = new Sequence(temp.getName(), temp.getAligned());
-								
-				Nast* nast = new Nast(params->alignment, candidateSeq, templateSeq);
-		
-				Sequence* copy;
-				
-				Nast* nast2;
-				bool needToDeleteCopy = false;  //this is needed in case you have you enter the ifs below
-												//since nast does not make a copy of hte sequence passed, and it is used by the reporter below
-												//you can't delete the copy sequence til after you report, but you may choose not to create it in the first place
-												//so this bool tells you if you need to delete it
-												
-				//if there is a possibility that this sequence should be reversed
-				if (candidateSeq->getNumBases() < numBasesNeeded) {
-					numFlipped_1++;
-					//if the user wants you to try the reverse
-					if (params->flip) {
-				
-						//get reverse compliment
-						copy = new Sequence(candidateSeq->getName(), originalUnaligned);
-						copy->reverseComplement();
-                        
-                        if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: flipping "  + candidateSeq->getName() + " \n"); }
-						
-						//rerun alignment
-						Sequence temp2 = params->templateDB->findClosestSequence(copy, searchScore);
-						Sequence* templateSeq2 = new Sequence(temp2.getName(), temp2.getAligned());
-                        
-                        if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: closest template "  + temp2.getName() + " \n"); }
-						
-						nast2 = new Nast(params->alignment, copy, templateSeq2);
-                        
-                        if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: completed Nast2 "  + candidateSeq->getName() + " flipped numBases = " + toString(copy->getNumBases()) + " old numbases = " + toString(candidateSeq->getNumBases()) +" \n"); }
-			
-						//check if any better
-						if (copy->getNumBases() > candidateSeq->getNumBases()) {
-							candidateSeq->setAligned(copy->getAligned());  //use reverse compliments alignment since its better
-                            delete templateSeq;
-							templateSeq = templateSeq2;
-							delete nast;
-							nast = nast2;
-							needToDeleteCopy = true;
-                            params->accnosWriter->write(candidateSeq->getName()+ '\n');
-                            numFlipped_0++;
-						}else{
-							delete nast2;
-                            delete templateSeq2;
-							delete copy;	
-						}
-                        if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: done.\n"); }
-					}
-				}
-				
-				report.setTemplate(templateSeq);
-				report.setSearchParameters(params->search, searchScore);
-				report.setAlignmentParameters(params->alignMethod, params->alignment);
-				report.setNastParameters(*nast);
-	
-				params->alignWriter->write('>' + candidateSeq->getName() + '\n' + candidateSeq->getAligned() + '\n');
-				params->reportWriter->write(report.getReport());
-				delete nast;
-                delete templateSeq;
-				if (needToDeleteCopy) {   delete copy;   }
+                if (!params->m->getControl_pressed()) {
+                    ProfileTimer timer("write");
+                    outAlign << batch->aligned; outReport << batch->report; outAccnos << batch->accnos;
+                    params->profiler->addItems("write", batch->seqs.size());
+                    params->profiler->addBytesWritten("write", batch->aligned.length() + batch->report.length() + batch->accnos.length());
+                    
+                    //report progress
+                    long long before = params->numSeqs;
+                    params->numSeqs += batch->seqs.size();
+                    if ((params->numSeqs / 1000) != (before / 1000)) { params->m->mothurOutJustToScreen(toString(params->numSeqs) + "\n"); }
+                }
                 
-				count++;
-			}
-			delete candidateSeq;
-			
-			#if defined NON_WINDOWS
-				unsigned long long pos = inFASTA.tellg();
-				if ((pos == -1) || (pos >= params->filePos.end)) { break; }
-			#else
-				if (count == params->filePos.end) { break; }
-			#endif
-			
-			//report progress
-			if((count) % 1000 == 0){	params->m->mothurOutJustToScreen(toString(count) + "\n"); 		}
-			
-		}
-		//report progress
-		if((count) % 1000 != 0){	params->m->mothurOutJustToScreen(toString(count) + "\n"); 		}
+                batch->seqs.clear(); batch->aligned = ""; batch->report = ""; batch->accnos = "";
+                finished.erase(it); nextBatch++;
+                
+                params->freeBatches->push(batch);
+            }
+        }
+        //report progress
+        if((params->numSeqs) % 1000 != 0){	params->m->mothurOutJustToScreen(toString(params->numSeqs) + "\n"); 		}
         
-        params->numSeqs += count;
-        params->flippedResults[0] += numFlipped_0;
-        params->flippedResults[1] += numFlipped_1;
+        outAlign.close(); outReport.close(); outAccnos.close();
+	}
+	catch(exception& e) {
+		params->m->errorOut(e, "AlignCommand", "alignWriter");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//fills the free batches with the reads in the file and queues them for the aligners
+template <class InputStream>
+void readAlignBatches(InputStream& in, BoundedQueue<alignBatch*>* freeBatches, BoundedQueue<alignBatch*>* toAlign, int batchSize, MothurOut* m) {
+	try {
+        Utils util;
+        long long numBatches = 0;
         
-		inFASTA.close();
-		
+        alignBatch* batch;
+        while (!in.eof() && !m->getControl_pressed() && freeBatches->pop(batch)) {
+            batch->number = numBatches++;
+            
+            {
+                ProfileTimer timer("read"); //not the time waiting on the queues
+                
+                while ((batch->seqs.size() < batchSize) && !in.eof()) {
+                    if (m->getControl_pressed()) { break; }
+                    
+                    Sequence seq(in); util.gobble(in);
+                    if (seq.getName() != "") { batch->seqs.push_back(seq); } //incase there is a commented sequence at the end of a file
+                }
+            }
+            
+            Profiler::getInstance()->addItems("read", batch->seqs.size());
+            toAlign->push(batch);
+        }
 	}
 	catch(exception& e) {
-		params->m->errorOut(e, "AlignCommand", "driver");
+		m->errorOut(e, "AlignCommand", "readAlignBatches");
 		exit(1);
 	}
 }
 /**************************************************************************************************/
-//void alignDriver(linePair* filePos, string alignFName, string reportFName, string accnosFName, string filename, vector<long long>& numFlipped,MothurOut* m, string align, float match, float misMatch, float gapOpen, float gapExtend, float threshold, bool flip, AlignmentDB* templateDB, string search, long long& count) {
+//one reader, processors aligners and one writer connected by queues. The reader and writer pass the same batches back
+//and forth, so at most 4 * processors batches of reads are in memory however far ahead of the aligners the reader gets.
 long long AlignCommand::createProcesses(string alignFileName, string reportFileName, string accnosFName, string filename, vector<long long>& numFlipped) {
 	try {
-        
-        vector<linePair> lines;
-        vector<double> positions;
-#if defined NON_WINDOWS
-        positions = util.divideFile(filename, processors);
-        for (int i = 0; i < (positions.size()-1); i++) {	lines.push_back(linePair(positions[i], positions[(i+1)]));	}
+        bool gz = false;
+#ifdef USE_BOOST
+        gz = util.isGZ(filename)[1];
 #else
-        long long numFastaSeqs = 0;
-        positions = util.setFilePosFasta(filename, numFastaSeqs);
-        if (numFastaSeqs < processors) { processors = numFastaSeqs; m->mothurOut("Reducing processors to " + toString(numFastaSeqs) + ".\n");  }
-        
-        //figure out how many sequences you have to process
-        int numSeqsPerProcessor = numFastaSeqs / processors;
-        for (int i = 0; i < processors; i++) {
-            int startIndex =  i * numSeqsPerProcessor;
-            if(i == (processors - 1)){	numSeqsPerProcessor = numFastaSeqs - i * numSeqsPerProcessor; 	}
-            lines.push_back(linePair(positions[startIndex], numSeqsPerProcessor));
-        }
+        string extension = util.getExtension(filename);
+        if ((extension == ".gz") || (extension == ".GZ")) { m->mothurOut("[ERROR]: mothur must be compiled with boost to read gzipped files, aborting.\n"); m->setControl_pressed(true); return 0; }
 #endif
-
-        //create array of worker threads
-        vector<std::thread*> workerThreads;
-        vector<alignStruct*> data;
         
-        long long num = 0;
-        for (int i = 0; i < numFlipped.size(); i++) { numFlipped[i] = 0; }
+        int batchSize = 64;
+        int numBatches = 4 * processors;
+        BoundedQueue<alignBatch*> freeBatches(numBatches);
+        BoundedQueue<alignBatch*> toAlign(numBatches);
+        BoundedQueue<alignBatch*> toWrite(numBatches);
+        
+        vector<alignBatch*> batches;
+        for (int i = 0; i < numBatches; i++) { batches.push_back(new alignBatch()); freeBatches.push(batches[i]); }
         
         time_t start, end;
         time(&start);
         
-        NastReport nast; string nastHeaders = nast.getHeaders();
-        ofstream out; util.openOutputFile(reportFileName, out); out << nastHeaders; out.close();
+        //create array of worker threads
+        vector<std::thread*> workerThreads;
+        vector<alignStruct*> data;
         
-        auto synchronizedOutputAlignFile = std::make_shared<SynchronizedOutputFile>(alignFileName);
-        auto synchronizedOutputReportFile = std::make_shared<SynchronizedOutputFile>(reportFileName, true);
-        auto synchronizedOutputAccnosFile = std::make_shared<SynchronizedOutputFile>(accnosFName);
-
-        for (int i = 0; i < processors-1; i++) {
-            
-            OutputWriter* threadAlignWriter = new OutputWriter(synchronizedOutputAlignFile);
-            OutputWriter* threadReportWriter = new OutputWriter(synchronizedOutputReportFile);
-            OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedOutputAccnosFile);
-
-            
-            alignStruct* dataBundle = new alignStruct(lines[i+1], threadAlignWriter, threadReportWriter, threadAccnosWriter, filename, templateDB, align, match, misMatch, gapOpen, gapExtend, threshold, flip, kmerSize, search);
+        for (int i = 0; i < processors; i++) {
+            alignStruct* dataBundle = new alignStruct(&toAlign, &toWrite, templateDB, align, match, misMatch, gapOpen, gapExtend, threshold, flip, kmerSize, search, band);
             data.push_back(dataBundle);
-
+            
             workerThreads.push_back(new std::thread(alignDriver, dataBundle));
-         }
+        }
         
-        OutputWriter* threadAlignWriter = new OutputWriter(synchronizedOutputAlignFile);
-        OutputWriter* threadReportWriter = new OutputWriter(synchronizedOutputReportFile);
-        OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedOutputAccnosFile);
+        alignOutput* output = new alignOutput(&toWrite, &freeBatches, alignFileName, reportFileName, accnosFName);
+        std::thread* writerThread = new std::thread(alignWriter, output);
         
-        alignStruct* dataBundle = new alignStruct(lines[0], threadAlignWriter, threadReportWriter, threadAccnosWriter, filename, templateDB, align, match, misMatch, gapOpen, gapExtend, threshold, flip, kmerSize, search);
-        alignDriver(dataBundle);
-        numFlipped[0] = dataBundle->flippedResults[0];
-        numFlipped[1] = dataBundle->flippedResults[1];
-        num = dataBundle->numSeqs;
+        //this thread is the reader
+#ifdef USE_BOOST
+        if (gz) {
+            ifstream inFASTA; boost::iostreams::filtering_istream inBoost;
+            util.openInputFileBinary(filename, inFASTA, inBoost);
+            readAlignBatches(inBoost, &freeBatches, &toAlign, batchSize, m);
+            inBoost.pop(); inFASTA.close();
+        }
+#endif
+        if (!gz) {
+            ifstream inFASTA; util.openInputFile(filename, inFASTA);
+            readAlignBatches(inFASTA, &freeBatches, &toAlign, batchSize, m);
+            inFASTA.close();
+        }
+        toAlign.close();
+        Profiler::getInstance()->addFileRead("read", filename);
+        
+        for (int i = 0; i < numFlipped.size(); i++) { numFlipped[i] = 0; }
         
-        for (int i = 0; i < processors-1; i++) {
+        for (int i = 0; i < processors; i++) {
             workerThreads[i]->join();
-            num += data[i]->numSeqs;
             numFlipped[0] += data[i]->flippedResults[0];
             numFlipped[1] += data[i]->flippedResults[1];
             
-            delete data[i]->alignWriter;
-            delete data[i]->reportWriter;
-            delete data[i]->accnosWriter;
-            
             delete data[i];
             delete workerThreads[i];
         }
-        synchronizedOutputAlignFile->close(); synchronizedOutputReportFile->close(); synchronizedOutputAccnosFile->close();
-        delete threadAlignWriter; delete threadAccnosWriter; delete threadReportWriter;
-        delete dataBundle;
+        toWrite.close();
+        
+        writerThread->join();
+        long long num = output->numSeqs;
+        delete writerThread; delete output;
+        
+        for (int i = 0; i < numBatches; i++) { delete batches[i]; }
         
         time(&end);
         m->mothurOut("It took " + toString(difftime(end, start)) + " secs to align " + toString(num) + " sequences.\n\n");
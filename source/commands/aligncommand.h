@@ -20,6 +20,9 @@
 #include "noalign.hpp"
 #include "nast.hpp"
 #include "nastreport.hpp"
+#include "templateprofile.hpp"
+#include "boundedqueue.hpp"
+#include "profiler.hpp"
 
 //test
 class AlignCommand : public Command {
@@ -52,7 +55,7 @@ protected:
 		
 	string fastafile, templateFileName, distanceFileName, search, align;
 	float match, misMatch, gapOpen, gapExtend, threshold;
-	int processors, kmerSize;
+	int processors, kmerSize, band;
 	vector<string> outputNames;
 	
 	bool abort, flip, calledHelp, save;
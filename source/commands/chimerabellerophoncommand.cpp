@@ -124,9 +124,11 @@ int ChimeraBellerophonCommand::execute(){
         
         long start = time(NULL);
 
+        ProfileTimer chimeraTimer("chimera");
         MothurChimera* chimera = new Bellerophon(fastafile, filter, correction, window, increment, outputdir);
         
         chimera->getChimeras();
+        chimeraTimer.stop();
         
         if (m->getControl_pressed()) { delete chimera;  return 0;	}
         
@@ -140,7 +142,9 @@ int ChimeraBellerophonCommand::execute(){
         ofstream out2; util.openOutputFile(accnosFileName, out2); outputNames.push_back(accnosFileName);  outputTypes["accnos"].push_back(accnosFileName);
         
         //print results
+        ProfileTimer writeTimer("write");
         numSeqs = chimera->print(out, out2, "");
+        writeTimer.stop(); Profiler::getInstance()->addItems("chimera", numSeqs);
         
         out.close(); out2.close();
         
@@ -195,7 +195,9 @@ int ChimeraCcodeCommand::execute(){
 
 int ChimeraCcodeCommand::driver(string outputFName, string filename, string accnos){
 	try {
+        ProfileTimer referenceTimer("reference");
         MothurChimera* chimera = new Ccode(fastafile, templatefile, filter, maskfile, window, numwanted, outputdir);
+        referenceTimer.stop();
         
         //is your template aligned?
         if (chimera->getUnaligned()) { m->mothurOut("[ERROR]: Your reference sequences are unaligned, please correct.\n");  delete chimera; return 0; }
@@ -215,7 +217,7 @@ int ChimeraCcodeCommand::driver(string outputFName, string filename, string accn
 		
             if (m->getControl_pressed()) {	count = 1; break;	}
 		
-			Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA);
+			ProfileTimer readTimer("read"); Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA); readTimer.stop();
 				
 			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
 				
@@ -223,14 +225,14 @@ int ChimeraCcodeCommand::driver(string outputFName, string filename, string accn
 					m->mothurOut(candidateSeq->getName() + " is not the same length as the template sequences. Skipping.\n"); 
 				}else{
 					//find chimeras
-					chimera->getChimeras(candidateSeq);
+					{ ProfileTimer timer("chimera"); chimera->getChimeras(candidateSeq); }
 					
 					if (m->getControl_pressed()) {	delete candidateSeq; return 1;	}
 		
 					//print results
-					chimera->print(out, out2);
+					{ ProfileTimer timer("write"); chimera->print(out, out2); }
 				}
-				count++;
+				count++; Profiler::getInstance()->addItems("chimera", 1);
 			}
 			delete candidateSeq;
 			
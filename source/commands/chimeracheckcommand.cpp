@@ -164,7 +164,9 @@ int ChimeraCheckCommand::checkChimeras(){
         string outputFileName = getOutputFileName("chimera", variables);
         outputNames.push_back(outputFileName); outputTypes["chimera"].push_back(outputFileName);
         
+        ProfileTimer referenceTimer("reference");
         MothurChimera* chimera = new ChimeraCheckRDP(fastafile, templatefile, namefile, svg, increment, ksize, outputdir);
+        referenceTimer.stop();
         
 		ofstream out;
 		util.openOutputFile(outputFileName, out);
@@ -180,17 +182,17 @@ int ChimeraCheckCommand::checkChimeras(){
 
             if (m->getControl_pressed()) {	break;	}
 		
-			Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA);
+			ProfileTimer readTimer("read"); Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA); readTimer.stop();
 				
 			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
 				//find chimeras
-				chimera->getChimeras(candidateSeq);
+				{ ProfileTimer timer("chimera"); chimera->getChimeras(candidateSeq); }
 				
 				if (m->getControl_pressed()) {	delete candidateSeq; return 1;	}
 	
 				//print results
-				chimera->print(out, out2);
-                count++;
+				{ ProfileTimer timer("write"); chimera->print(out, out2); }
+                count++; Profiler::getInstance()->addItems("chimera", 1);
 			}
 			delete candidateSeq;
 			
@@ -14,6 +14,7 @@
 #include "command.hpp"
 #include "mothurchimera.h"
 #include "chimeracheckrdp.h"
+#include "profiler.hpp"
 
 
 /***********************************************************/
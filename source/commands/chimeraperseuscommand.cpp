@@ -264,9 +264,13 @@ void driver(perseusData* params){
             int bestSingleIndex, bestSingleDiff;
             vector<pwAlign> alignments(numSeqs);
             
+            ProfileTimer alignTimer("align");
             int comparisons = myPerseus.getAlignments(i, params->sequences, alignments, leftDiffs, leftMaps, rightDiffs, rightMaps, bestSingleIndex, bestSingleDiff, restricted);
+            alignTimer.stop();
             if (params->m->getControl_pressed()) { chimeraFile.close(); accnosFile.close(); break; }
             
+            ProfileTimer chimeraTimer("chimera"); //finding the parents and writing the results
+            
             int minMismatchToChimera, leftParentBi, rightParentBi, breakPointBi;
             
             string dummyA, dummyB;
@@ -336,6 +340,7 @@ void driver(perseusData* params){
             //report progress
             if((i+1) % 100 == 0){ 	params->m->mothurOutJustToScreen("Processing sequence: " + toString(i+1) + "\n");		}
             params->count++; //# of sequences completed. Used by calling function to check for failure
+            Profiler::getInstance()->addItems("chimera", 1);
         }
         
         if((numSeqs) % 100 != 0){ 	params->m->mothurOutJustToScreen("Processing sequence: " + toString(numSeqs) + "\n");		}
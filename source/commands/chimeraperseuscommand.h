@@ -19,6 +19,7 @@
 #include "sequencecountparser.h"
 #include "myPerseus.h"
 #include "counttable.h"
+#include "profiler.hpp"
 
 /***********************************************************/
 class ChimeraPerseusCommand : public Command {
@@ -214,7 +214,9 @@ int ChimeraPintailCommand::execute(){
 
 int ChimeraPintailCommand::checkChiemras(){
 	try {
+        ProfileTimer referenceTimer("reference");
         MothurChimera* chimera = new Pintail(fastafile, templatefile, filter, maskfile, consfile, quanfile, window, increment, outputdir, current->getVersion());
+        referenceTimer.stop();
         
         if (m->getControl_pressed()) { delete chimera;  return 0;	}
         
@@ -247,7 +249,7 @@ int ChimeraPintailCommand::checkChiemras(){
 				
 			if (m->getControl_pressed()) {	break;	}
 		
-			Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA);
+			ProfileTimer readTimer("read"); Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA); readTimer.stop();
 				
 			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
 				
@@ -255,14 +257,14 @@ int ChimeraPintailCommand::checkChiemras(){
 					m->mothurOut("[WARNING]: " + candidateSeq->getName() + " is not the same length as the template sequences. Skipping.\n");
 				}else{
 					//find chimeras
-					chimera->getChimeras(candidateSeq);
+					{ ProfileTimer timer("chimera"); chimera->getChimeras(candidateSeq); }
 					
 					if (m->getControl_pressed()) {	delete candidateSeq; return 1;	}
 		
 					//print results
-					chimera->print(out, out2);
+					{ ProfileTimer timer("write"); chimera->print(out, out2); }
 				}
-				count++;
+				count++; Profiler::getInstance()->addItems("chimera", 1);
 			}
 			delete candidateSeq;
 			
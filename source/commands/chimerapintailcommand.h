@@ -13,6 +13,7 @@
 #include "mothur.h"
 #include "command.hpp"
 #include "mothurchimera.h"
+#include "profiler.hpp"
 
 /***********************************************************/
 
@@ -770,6 +770,7 @@ int ChimeraSlayerCommand::driver(string outputFName, string filename, string acc
 		
         if (m->getDebug()) { m->mothurOut("[DEBUG]: filename = " + filename + "\n"); }
         
+		ProfileTimer referenceTimer("reference");
 		MothurChimera* chimera;
 		if (templatefile != "self") { //you want to run slayer with a reference template
 			chimera = new ChimeraSlayer(filename, templatefile, trim, search, ksize, match, mismatch, window, divR, minSimilarity, minCoverage, minBS, minSNP, parents, iters, increment, numwanted, realign, blastlocation, util.getRandomNumber());
@@ -777,6 +778,7 @@ int ChimeraSlayerCommand::driver(string outputFName, string filename, string acc
 			chimera = new ChimeraSlayer(filename, templatefile, trim, priority, search, ksize, match, mismatch, window, divR, minSimilarity, minCoverage, minBS, minSNP, parents, iters, increment, numwanted, realign, blastlocation, util.getRandomNumber());	
 		}
 		
+		referenceTimer.stop();
 		if (m->getControl_pressed()) { delete chimera; return 0; }
 		
 		if (chimera->getUnaligned()) { delete chimera; m->mothurOut("Your template sequences are different lengths, please correct.\n");  m->setControl_pressed(true); return 0; }
@@ -801,7 +803,7 @@ int ChimeraSlayerCommand::driver(string outputFName, string filename, string acc
 		
 			if (m->getControl_pressed()) {	delete chimera; out.close(); out2.close(); if (trim) { out3.close(); } inFASTA.close(); return 1;	}
 		
-			Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA);
+			ProfileTimer readTimer("read"); Sequence* candidateSeq = new Sequence(inFASTA);  util.gobble(inFASTA); readTimer.stop();
 			string candidateAligned = candidateSeq->getAligned();
 			
 			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
@@ -809,7 +811,7 @@ int ChimeraSlayerCommand::driver(string outputFName, string filename, string acc
 					m->mothurOut("[WARNING]: " + candidateSeq->getName() + " is not the same length as the template sequences. Skipping.\n");
 				}else{
 					//find chimeras
-					chimera->getChimeras(candidateSeq);
+					{ ProfileTimer timer("chimera"); chimera->getChimeras(candidateSeq); }
 					
 					if (m->getControl_pressed()) {	delete chimera; delete candidateSeq; return 1;	}
 						
@@ -843,11 +845,13 @@ int ChimeraSlayerCommand::driver(string outputFName, string filename, string acc
 						Sequence* right = new Sequence(candidateSeq->getName(), rightQuery);
 						
 						//find chimeras
+						ProfileTimer halvesTimer("chimera");
 						chimera->getChimeras(left);
 						data_results leftResults = chimera->getResults();
 						
 						chimera->getChimeras(right);
 						data_results rightResults = chimera->getResults();
+						halvesTimer.stop();
 						
 						//if either piece is chimeric then report
 						Sequence trimmed = chimera->print(out, out2, leftResults, rightResults);
@@ -863,7 +867,7 @@ int ChimeraSlayerCommand::driver(string outputFName, string filename, string acc
 					
 					
 				}
-				count++;
+				count++; Profiler::getInstance()->addItems("chimera", 1);
 			}
 			delete candidateSeq;
 			//report progress
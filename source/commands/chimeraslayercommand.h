@@ -16,6 +16,7 @@
 #include "chimeraslayer.h"
 #include "sequenceparser.h"
 #include "sequencecountparser.h"
+#include "profiler.hpp"
 
 /***********************************************************/
 
@@ -604,7 +604,9 @@ int driver(uchimeData* params){
         commandString = "\"" + commandString + "\"";
 #endif
         if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: uchime command = " + commandString + ".\n"); }
+        ProfileTimer chimeraTimer("chimera"); //time spent in uchime
         system(commandString.c_str());
+        chimeraTimer.stop();
         
         //free memory
         for(int i = 0; i < cPara.size(); i++)  {  delete cPara[i];  }
@@ -15,6 +15,7 @@
 #include "sequenceparser.h"
 #include "counttable.h"
 #include "sequencecountparser.h"
+#include "profiler.hpp"
 
 /***********************************************************/
 struct uchimeVariables {
@@ -477,7 +477,9 @@ void driver(vsearchData* params){
         
         if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: vsearch command = " + commandString + ".\n"); }
         
+        ProfileTimer chimeraTimer("chimera"); //time spent in vsearch
         system(commandString.c_str());
+        chimeraTimer.stop();
         
         //free memory
         for(int i = 0; i < cPara.size(); i++)  {  delete cPara[i];  }
@@ -13,6 +13,7 @@
 #include "sequenceparser.h"
 #include "counttable.h"
 #include "sequencecountparser.h"
+#include "profiler.hpp"
 
 /**************************************************************************************************/
 struct vsearchVariables {
@@ -472,6 +472,7 @@ struct classifyData {
     unsigned long long start;
     unsigned long long end;
     MothurOut* m;
+    Profiler* profiler;
     Classify* classify;
     float match, misMatch, gapOpen, gapExtend;
     int count, kmerSize, threadID, cutoff, iters, numWanted;
@@ -485,6 +486,7 @@ struct classifyData {
         taxTWriter = r;
         filename = f;
         m = MothurOut::getInstance();
+        profiler = Profiler::getInstance();
         start = st;
         end = en;
         probs = p;
@@ -508,12 +510,14 @@ void driverClassifier(classifyData* params){
         while (!done) {
             if (params->m->getControl_pressed()) { break; }
             
-            Sequence* candidateSeq = new Sequence(inFASTA); params->util.gobble(inFASTA);
+            Sequence* candidateSeq;
+            { ProfileTimer timer("read"); candidateSeq = new Sequence(inFASTA); params->util.gobble(inFASTA); }
             
             if (candidateSeq->getName() != "") {
                 
                 string simpleTax = ""; bool flipped = false;
-                taxonomy = params->classify->getTaxonomy(candidateSeq, simpleTax, flipped);
+                { ProfileTimer timer("classify"); taxonomy = params->classify->getTaxonomy(candidateSeq, simpleTax, flipped); }
+                params->profiler->addItems("classify", 1);
                 
                 if (params->m->getControl_pressed()) { delete candidateSeq; break; }
                 
@@ -534,6 +538,7 @@ void driverClassifier(classifyData* params){
             //report progress
             if((params->count) % 100 == 0){
                 params->m->mothurOutJustToScreen(toString(params->count) +"\n");
+                ProfileTimer timer("write");
                 params->taxTWriter->write(taxTBuffer); taxTBuffer = "";
                 params->taxWriter->write(taxBuffer); taxBuffer = "";
                 if (accnosBuffer != "") { params->accnosWriter->write(accnosBuffer); accnosBuffer = ""; }
@@ -550,6 +555,7 @@ void driverClassifier(classifyData* params){
         //report progress
         if((params->count) % 100 != 0){
             params->m->mothurOutJustToScreen(toString(params->count)+"\n");
+            ProfileTimer timer("write");
             params->taxTWriter->write(taxTBuffer); taxTBuffer = "";
             params->taxWriter->write(taxBuffer); taxBuffer = "";
             if (accnosBuffer != "") { params->accnosWriter->write(accnosBuffer); accnosBuffer = ""; }
@@ -628,6 +634,10 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
         delete threadTaxWriter; delete threadTaxTWriter; delete threadAccnosWriter;
         delete dataBundle;
         
+        Profiler* profiler = Profiler::getInstance();
+        profiler->addFileRead("read", filename);
+        profiler->addFileWritten("write", taxFileName); profiler->addFileWritten("write", tempTaxFile); profiler->addFileWritten("write", accnos);
+        
         return num;
 	}
 	catch(exception& e) {
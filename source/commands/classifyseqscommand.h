@@ -21,6 +21,7 @@
 #include "knn.h"
 #include "kmertree.h"
 #include "aligntree.h"
+#include "profiler.hpp"
 
 
 //KNN and Wang methods modeled from algorithms in
@@ -88,7 +88,8 @@ string ClusterCommand::getHelpString(){
         helpString += "The delta parameter allows to set the stable value for the metric in the opticluster method (delta=0.0001). \n";
         helpString += "The method parameter allows you to enter your clustering mothod. Options are furthest, nearest, average, weighted, agc, dgc, unique and opti. Default=opti.  The agc and dgc methods require a fasta file.";
         helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
-         helpString += "The vsearch parameter allows you to specify the name and location of your vsearch executable if using agc or dgc clustering methods. By default mothur will look in your path, mothur's executable and mothur tools locations.  You can set the vsearch location as follows, vsearch=/usr/bin/vsearch.\n";
+        helpString += "With the opti method, the processors are used to find the best OTU for batches of sequences in parallel. The OTUs are the same for any number of processors.\n";
+         helpString += "The vsearch parameter allows you to specify the name and location of your vsearch executable if using agc or dgc clustering methods. By default mothur will look in your path, mothur's executable and mothur tools locations, and clusters the sequences itself with the same settings if vsearch is not found.  You can set the vsearch location as follows, vsearch=/usr/bin/vsearch. Set vsearch=mothur to use mothur's clustering when vsearch is installed.\n";
        helpString += "The cluster command should be in the following format: \n";
 		helpString += "cluster(method=yourMethod, cutoff=yourCutoff, precision=yourPrecision) \n";
 		return helpString;
@@ -162,31 +163,38 @@ ClusterCommand::ClusterCommand(string option)  {
             method = validParameter.valid(parameters, "method");
             if (method == "not found") {  method = "opti";}
             
-            vector<string> versionOutputs;
-            bool foundTool = false;
-            string path = current->getProgramPath();
-            string programName = "vsearch"; programName += EXECUTABLE_EXT;
-            
+            //agc and dgc run vsearch if it is in mothur's location, the tools location or your path, unless you set vsearch=mothur
             vsearchLocation = validParameter.valid(parameters, "vsearch");
-            if (vsearchLocation == "not found") {
-                vsearchLocation = "";
-                if ((method == "agc") || (method == "dgc")) {
-                    foundTool = util.findTool(programName, vsearchLocation, path, versionOutputs, current->getLocations());
-                }
-            }
-            else {
-                if ((method == "agc") || (method == "dgc")) {
+            if ((method == "agc") || (method == "dgc")) {
+                string programName = "vsearch"; programName += EXECUTABLE_EXT;
+                
+                if (vsearchLocation == "not found") {
+                    vsearchLocation = current->getProgramPath() + programName;
+                    if (!util.fileExists(vsearchLocation)) {
+                        vsearchLocation = programName;
+                        if (!util.checkLocations(vsearchLocation, current->getLocations(), "silent")) {
+                            vsearchLocation = util.findProgramPath(programName) + programName;
+                            if (!util.fileExists(vsearchLocation)) { vsearchLocation = ""; }
+                        }
+                    }
+                    if (vsearchLocation != "") { vsearchLocation = util.getFullPathName(vsearchLocation); }
+                    else { m->mothurOut("Unable to find " + programName + ", using mothur's " + method + " clustering.\n"); }
+                }else if (vsearchLocation == "mothur") { vsearchLocation = ""; }
+                else {
                     //test to make sure vsearch exists
                     ifstream in;
                     vsearchLocation = util.getFullPathName(vsearchLocation);
                     bool ableToOpen = util.openInputFile(vsearchLocation, in, "no error"); in.close();
                     if(!ableToOpen) {
-                        m->mothurOut(vsearchLocation + " file does not exist or cannot be opened, ignoring.\n"); vsearchLocation = "";
+                        m->mothurOut(vsearchLocation + " file does not exist or cannot be opened, ignoring.\n");
+                        vector<string> versionOutputs;
+                        string path = current->getProgramPath();
                         programName = util.getSimpleName(vsearchLocation); vsearchLocation = "";
-                        foundTool = util.findTool(programName, vsearchLocation, path, versionOutputs, current->getLocations());
+                        bool foundTool = util.findTool(programName, vsearchLocation, path, versionOutputs, current->getLocations());
+                        if (!foundTool) { vsearchLocation = ""; m->mothurOut("Using mothur's " + method + " clustering instead.\n"); }
                     }
                 }
-            }
+            }else { vsearchLocation = ""; }
             
             if ((method == "furthest") || (method == "nearest") || (method == "average") || (method == "weighted") || (method == "agc") || (method == "dgc") || (method == "opti") || (method == "unique")) { }
             else { m->mothurOut("[ERROR]: Not a valid clustering method.  Valid clustering algorithms are furthest, nearest, average, weighted, agc, dgc, unique and opti.\n");  abort = true; }
@@ -287,8 +295,8 @@ ClusterCommand::ClusterCommand(string option)  {
             
             if ((method == "agc") || (method == "dgc")) {
                 if (fastafile == "") { m->mothurOut("[ERROR]: You must provide a fasta file when using the agc or dgc clustering methods, aborting\n."); abort = true;}
-            }else if (setProcessors) {
-                m->mothurOut("[WARNING]: You can only use the processors option when using the agc or dgc clustering methods. Using 1 processor.\n.");
+            }else if ((setProcessors) && (method != "opti")) {
+                m->mothurOut("[WARNING]: You can only use the processors option when using the agc, dgc or opti clustering methods. Using 1 processor.\n.");
             }
             
             cutOffSet = false;
@@ -394,6 +402,7 @@ int ClusterCommand::execute(){
 
 int ClusterCommand::runVsearchCluster(){
     try {
+        ProfileTimer readTimer("read");
         string vsearchFastafile = ""; VsearchFileParser* vParse;
         if ((namefile == "") && (countfile == ""))  { vParse = new VsearchFileParser(fastafile);                        }
         else if (namefile != "")                    { vParse = new VsearchFileParser(fastafile, namefile, "name");      }
@@ -402,7 +411,10 @@ int ClusterCommand::runVsearchCluster(){
     
         if (m->getControl_pressed()) {  delete vParse; return 0; }
         
-        vsearchFastafile = vParse->getVsearchFile();
+        vector<seqPriorityNode> seqs;
+        if (vsearchLocation == "")  { seqs = vParse->getSortedSeqs();               } //cluster in process, no temp files
+        else                        { vsearchFastafile = vParse->getVsearchFile();  }
+        readTimer.stop(); Profiler::getInstance()->addItems("read", seqs.size());
         
         if (cutoff > 1.0) {  m->mothurOut("You did not set a cutoff, using 0.03.\n"); cutoff = 0.03; }
         
@@ -425,29 +437,43 @@ int ClusterCommand::runVsearchCluster(){
             m->mothurOut("\n" + *it + "\n");
             util.mothurConvert(*it, cutoff);
             
-            //Run vsearch
-            string ucVsearchFile = util.getSimpleName(vsearchFastafile) + ".clustered.uc";
-            string logfile = util.getSimpleName(vsearchFastafile) + ".clustered.log";
-            vsearchDriver(vsearchFastafile, ucVsearchFile, logfile);
-            
-            if (m->getControl_pressed()) { break; }
-            
-            //Convert outputted *.uc file into a list file
-            ListVector list = vParse->createListFile(ucVsearchFile, vParse->getNumBins(logfile), toString(1.0-cutoff), counts);
+            ListVector list;
+            ProfileTimer clusterTimer("cluster");
+            if (vsearchLocation == "") {
+                GreedyCluster greedy(method, cutoff);
+                vector<int> bins;
+                int numBins = greedy.cluster(seqs, bins);
+                
+                if (m->getControl_pressed()) { break; }
+                
+                list = vParse->createListFile(seqs, bins, numBins, toString(1.0-cutoff), counts);
+            }else {
+                //Run vsearch
+                string ucVsearchFile = util.getSimpleName(vsearchFastafile) + ".clustered.uc";
+                string logfile = util.getSimpleName(vsearchFastafile) + ".clustered.log";
+                vsearchDriver(vsearchFastafile, ucVsearchFile, logfile);
+                
+                if (m->getControl_pressed()) { break; }
+                
+                //Convert outputted *.uc file into a list file
+                list = vParse->createListFile(ucVsearchFile, vParse->getNumBins(logfile), toString(1.0-cutoff), counts);
+                
+                //remove temp files
+                util.mothurRemove(ucVsearchFile); util.mothurRemove(logfile);
+            }
+            clusterTimer.stop();
             
+            ProfileTimer writeTimer("write");
             if (printHeaders) {
                 printHeaders = false;
             }else {  list.setPrintedLabels(printHeaders);  }
             
             if (countfile != "") { list.print(out, counts); }
             else { list.print(out); }
-           
-            //remove temp files
-            util.mothurRemove(ucVsearchFile); util.mothurRemove(logfile);
             
         }
         out.close();
-        util.mothurRemove(vsearchFastafile); delete vParse;
+        if (vsearchFastafile != "") { util.mothurRemove(vsearchFastafile); } delete vParse;
         if (m->getControl_pressed()) { for (int i = 0; i < outputNames.size(); i++) { util.mothurRemove(outputNames[i]); } return 0; }
         
         return 0;
@@ -576,6 +602,7 @@ int ClusterCommand::vsearchDriver(string inputFile, string ucClusteredFile, stri
 int ClusterCommand::runMothurCluster(){
     try {
         
+        ProfileTimer readTimer("read");
         ReadMatrix* read;
         if (format == "column") { read = new ReadColumnMatrix(columnfile, sim); }	//sim indicates whether its a similarity matrix
         else if (format == "phylip") { read = new ReadPhylipMatrix(phylipfile, sim); }
@@ -606,6 +633,7 @@ int ClusterCommand::runMothurCluster(){
             delete ct;
         }else { rabund = new RAbundVector(list->getRAbundVector()); }
         delete read;
+        readTimer.stop(); Profiler::getInstance()->addFileRead("read", distfile);
         
         if (m->getControl_pressed()) { //clean up
             delete list; delete matrix; delete rabund; if(countfile == ""){rabundFile.close(); sabundFile.close();  util.mothurRemove((fileroot+ tag + ".rabund")); util.mothurRemove((fileroot+ tag + ".sabund")); }
@@ -651,6 +679,7 @@ int ClusterCommand::runMothurCluster(){
         double saveCutoff = cutoff;
         bool printHeaders = true;
         
+        ProfileTimer clusterTimer("cluster"); //includes printing the list, rabund and sabund at each distance
         while ((matrix->getSmallDist() <= cutoff) && (matrix->getNNodes() > 0)){
             
             if (m->getControl_pressed()) { //clean up
@@ -668,6 +697,7 @@ int ClusterCommand::runMothurCluster(){
             }
             
             cluster->update(cutoff);
+            Profiler::getInstance()->addItems("cluster", 1);
             
             float dist = matrix->getSmallDist();
             float rndDist = util.ceilDist(dist, precision);
@@ -690,6 +720,7 @@ int ClusterCommand::runMothurCluster(){
         
         if(previousDist <= 0.0000)          { printData("unique", counts, printHeaders);                            }
         else if(rndPreviousDist<cutoff)     { printData(toString(rndPreviousDist, length-1), counts, printHeaders); }
+        clusterTimer.stop();
         
         delete matrix;
         delete list;
@@ -841,15 +872,21 @@ int ClusterCommand::runOptiCluster(){
             m->mothurOut("\n" + *it + "\n");
             util.mothurConvert(*it, cutoff);
             
-            OptiData* matrix = new OptiMatrix(distfile, thisNamefile, nameOrCount, format, cutoff, false);
+            ProfileTimer readTimer("read");
+            OptiData* matrix = NULL;
+            if (format == "column") { matrix = new OptiCSRMatrix(distfile, thisNamefile, nameOrCount, cutoff, false);  }
+            else                    { matrix = new OptiMatrix(distfile, thisNamefile, nameOrCount, format, cutoff, false); }
+            readTimer.stop(); Profiler::getInstance()->addFileRead("read", distfile);
             
-            OptiCluster cluster(matrix, metric, 0);
+            OptiCluster cluster(matrix, metric, 0, processors);
             
             int iters = 0;
             double listVectorMetric = 0; //worst state
             double delta = 1;
             
+            ProfileTimer clusterTimer("cluster");
             cluster.initialize(listVectorMetric, true, initialize);
+            clusterTimer.stop();
             
             long long numBins = cluster.getNumBins();
             double tp, tn, fp, fn;
@@ -867,7 +904,8 @@ int ClusterCommand::runOptiCluster(){
                 if (m->getControl_pressed()) { break; }
                 double oldMetric = listVectorMetric;
                 
-                cluster.update(listVectorMetric);
+                { ProfileTimer updateTimer("cluster"); cluster.update(listVectorMetric); }
+                Profiler::getInstance()->addItems("cluster", 1);
                 
                 delta = abs(oldMetric - listVectorMetric);
                 iters++;
@@ -884,6 +922,7 @@ int ClusterCommand::runOptiCluster(){
             
             if (m->getControl_pressed()) { delete matrix; delete metric; metric = NULL; return 0; }
             
+            ProfileTimer writeTimer("write");
             ListVector* list = cluster.getList();
             list->setLabel(toString(cutoff));
             
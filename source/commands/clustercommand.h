@@ -16,10 +16,13 @@
 #include "cluster.hpp"
 #include "counttable.h"
 #include "vsearchfileparser.h"
+#include "greedycluster.hpp"
 #include "clusterdoturcommand.h"
 #include "opticluster.h"
 #include "optimatrix.h"
+#include "opticsrmatrix.hpp"
 #include "calculator.h"
+#include "profiler.hpp"
 
 
 /* The cluster() command:
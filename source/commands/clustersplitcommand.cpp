@@ -38,6 +38,8 @@ vector<string> ClusterSplitCommand::setParameters(){
 		CommandParameter ptaxlevel("taxlevel", "Number", "", "3", "", "", "","",false,false,true); parameters.push_back(ptaxlevel);
 		CommandParameter psplitmethod("splitmethod", "Multiple", "classify-fasta-distance", "distance", "", "", "","",false,false,true); parameters.push_back(psplitmethod);
 		CommandParameter plarge("large", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(plarge);
+        CommandParameter pstream("stream", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pstream);
+        CommandParameter pmemory("memory", "Number", "", "1024", "", "", "","",false,false); parameters.push_back(pmemory);
 		CommandParameter pshowabund("showabund", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pshowabund);
         CommandParameter prunspenspec("runsensspec", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(prunspenspec);
         CommandParameter pcluster("cluster", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pcluster);
@@ -82,7 +84,7 @@ vector<string> ClusterSplitCommand::setParameters(){
 string ClusterSplitCommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The cluster.split command parameter options are file, fasta, phylip, column, name, count, cutoff, precision, method, splitmethod, taxonomy, taxlevel, showabund, timing, large, cluster, iters, delta, initialize, dist, processors, runsensspec. Fasta or Phylip or column and name are required.\n";
+		helpString += "The cluster.split command parameter options are file, fasta, phylip, column, name, count, cutoff, precision, method, splitmethod, taxonomy, taxlevel, showabund, timing, large, stream, memory, cluster, iters, delta, initialize, dist, processors, runsensspec. Fasta or Phylip or column and name are required.\n";
 		helpString += "The cluster.split command can split your files in 3 ways. Splitting by distance file, by classification, or by classification also using a fasta file. \n";
 		helpString += "For the distance file method, you need only provide your distance file and mothur will split the file into distinct groups. \n";
 		helpString += "For the classification method, you need to provide your distance file and taxonomy file, and set the splitmethod to classify.  \n";
@@ -108,9 +110,12 @@ string ClusterSplitCommand::getHelpString(){
 		helpString += "The taxonomy parameter allows you to enter the taxonomy file for your sequences, this is only valid if you are using splitmethod=classify. Be sure your taxonomy file does not include the probability scores. \n";
 		helpString += "The taxlevel parameter allows you to specify the taxonomy level you want to use to split the distance file, default=3, meaning use the first taxon in each list. \n";
 		helpString += "The large parameter allows you to indicate that your distance matrix is too large to fit in RAM.  The default value is false.\n";
+        helpString += "The stream parameter allows you to split the distance matrix in memory and cluster each group as it is ready, instead of writing a distance and name file for each group. It is used with the opti method and the distance and classify splitmethods. With splitmethod=classify, the sequences in taxonomy groups that have no distances are clustered as singletons. The default value is false.\n";
+        helpString += "The memory parameter allows you to set the number of megabytes of distances the stream option holds in memory. Past that, the biggest groups are written to temp files until they are clustered. Default=1024.\n";
         helpString += "The classic parameter allows you to indicate that you want to run your files with cluster.classic.  It is only valid with splitmethod=fasta. Default=f.\n";
         helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
-         helpString += "The vsearch parameter allows you to specify the name and location of your vsearch executable if using agc or dgc clustering methods. By default mothur will look in your path, mothur's executable and mothur tools locations.  You can set the vsearch location as follows, vsearch=/usr/bin/vsearch.\n";
+        helpString += "When there are more processors than files to cluster with the opti method, the extra processors are used to cluster each file.\n";
+         helpString += "The vsearch parameter allows you to specify the name and location of your vsearch executable if using agc or dgc clustering methods. By default mothur will look in your path, mothur's executable and mothur tools locations, and clusters the sequences itself with the same settings if vsearch is not found.  You can set the vsearch location as follows, vsearch=/usr/bin/vsearch. Set vsearch=mothur to use mothur's clustering when vsearch is installed.\n";
 		helpString += "The cluster.split command should be in the following format: \n";
 		helpString += "cluster.split(column=youDistanceFile, name=yourNameFile, method=yourMethod, cutoff=yourCutoff, precision=yourPrecision, splitmethod=yourSplitmethod, taxonomy=yourTaxonomyfile, taxlevel=yourtaxlevel) \n";
 		helpString += "Example: cluster.split(column=abrecovery.dist, name=abrecovery.names, method=opti, cutoff=0.10, precision=1000, splitmethod=classify, taxonomy=abrecovery.silva.slv.taxonomy, taxlevel=5) \n";	
@@ -295,6 +300,13 @@ ClusterSplitCommand::ClusterSplitCommand(string option)  {
 			temp = validParameter.valid(parameters, "large");			if (temp == "not found") { temp = "F"; }
 			large = util.isTrue(temp);
             
+            temp = validParameter.valid(parameters, "stream");			if (temp == "not found") { temp = "F"; }
+			stream = util.isTrue(temp);
+            
+            temp = validParameter.valid(parameters, "memory");		if (temp == "not found")  { temp = "1024"; }
+            util.mothurConvert(temp, memory);
+            if (memory < 1) { m->mothurOut("[ERROR]: memory must be at least 1 megabyte, using 1.\n"); memory = 1; }
+            
 			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
 			processors = current->setProcessors(temp);
 			
@@ -334,31 +346,38 @@ ClusterSplitCommand::ClusterSplitCommand(string option)  {
 
 			method = validParameter.valid(parameters, "method");		if (method == "not found") { method = "opti";  }
             
-            vector<string> versionOutputs;
-            bool foundTool = false;
-            string path = current->getProgramPath();
-            string programName = "vsearch"; programName += EXECUTABLE_EXT;
-            
+            //agc and dgc run vsearch if it is in mothur's location, the tools location or your path, unless you set vsearch=mothur
             vsearchLocation = validParameter.valid(parameters, "vsearch");
-            if (vsearchLocation == "not found") {
-                vsearchLocation = "";
-                if ((method == "agc") || (method == "dgc")) {
-                    foundTool = util.findTool(programName, vsearchLocation, path, versionOutputs, current->getLocations());
-                }
-            }
-            else {
-                if ((method == "agc") || (method == "dgc")) {
+            if ((method == "agc") || (method == "dgc")) {
+                string programName = "vsearch"; programName += EXECUTABLE_EXT;
+                
+                if (vsearchLocation == "not found") {
+                    vsearchLocation = current->getProgramPath() + programName;
+                    if (!util.fileExists(vsearchLocation)) {
+                        vsearchLocation = programName;
+                        if (!util.checkLocations(vsearchLocation, current->getLocations(), "silent")) {
+                            vsearchLocation = util.findProgramPath(programName) + programName;
+                            if (!util.fileExists(vsearchLocation)) { vsearchLocation = ""; }
+                        }
+                    }
+                    if (vsearchLocation != "") { vsearchLocation = util.getFullPathName(vsearchLocation); }
+                    else { m->mothurOut("Unable to find " + programName + ", using mothur's " + method + " clustering.\n"); }
+                }else if (vsearchLocation == "mothur") { vsearchLocation = ""; }
+                else {
                     //test to make sure vsearch exists
                     ifstream in;
                     vsearchLocation = util.getFullPathName(vsearchLocation);
                     bool ableToOpen = util.openInputFile(vsearchLocation, in, "no error"); in.close();
                     if(!ableToOpen) {
-                        m->mothurOut(vsearchLocation + " file does not exist or cannot be opened, ignoring.\n"); vsearchLocation = "";
+                        m->mothurOut(vsearchLocation + " file does not exist or cannot be opened, ignoring.\n");
+                        vector<string> versionOutputs;
+                        string path = current->getProgramPath();
                         programName = util.getSimpleName(vsearchLocation); vsearchLocation = "";
-                        foundTool = util.findTool(programName, vsearchLocation, path, versionOutputs, current->getLocations());
+                        bool foundTool = util.findTool(programName, vsearchLocation, path, versionOutputs, current->getLocations());
+                        if (!foundTool) { vsearchLocation = ""; m->mothurOut("Using mothur's " + method + " clustering instead.\n"); }
                     }
                 }
-            }
+            }else { vsearchLocation = ""; }
 			
             if ((method == "furthest") || (method == "nearest") || (method == "average") || (method == "weighted") || (method == "agc") || (method == "dgc") || (method == "opti")) { }
             else { m->mothurOut("[ERROR]: Not a valid clustering method.  Valid clustering algorithms are furthest, nearest, average, weighted, agc, dgc and opti.\n");  abort = true; }
@@ -366,7 +385,6 @@ ClusterSplitCommand::ClusterSplitCommand(string option)  {
             if ((method == "agc") || (method == "dgc")) {
                 if (fastafile == "") { m->mothurOut("[ERROR]: You must provide a fasta file when using the agc or dgc clustering methods, aborting\n."); abort = true;}
                 if (classic) { m->mothurOut("[ERROR]: You cannot use cluster.classic with the agc or dgc clustering methods, aborting\n."); abort = true; }
-                if (!foundTool) { abort = true; }
             }
             
             cutoffNotSet = false;
@@ -397,6 +415,11 @@ ClusterSplitCommand::ClusterSplitCommand(string option)  {
             
             if (((phylipfile != "") || (columnfile != "")) && makeDist) { m->mothurOut("[ERROR]: You already provided a distance matrix. Mothur will ignore the dist parameter.\n"); makeDist = false; }
             if (classic && makeDist) { m->mothurOut("[ERROR]: You cannot use the dist parameter with the classic parameter. Mothur will ignore the dist parameter.\n"); makeDist = false; }
+            
+            //stream clusters the groups from memory, so it can't be used when the split files are needed
+            if (stream && ((method != "opti") || (splitmethod == "fasta") || classic || makeDist || !runCluster)) {
+                m->mothurOut("[WARNING]: The stream option can only be used with the opti method and the distance or classify splitmethods when clustering, ignoring.\n"); stream = false;
+            }
 
 			timing = validParameter.valid(parameters, "timing");
 			if (timing == "not found") { timing = "F"; }
@@ -500,6 +523,7 @@ int ClusterSplitCommand::execute(){
                     }
                 }
                 else { m->mothurOut("Not a valid splitting method.  Valid splitting algorithms are distance, classify or fasta.\n");  return 0;		}
+                if (stream) { split->setStream((unsigned long long)memory * 1024 * 1024, cutoff); }
                 split->split();
                 if (fastafile != "") {  current->setFastaFile(fastafile);  }
 
@@ -507,18 +531,29 @@ int ClusterSplitCommand::execute(){
                 
                 singletonName = split->getSingletonNames();
                 numSingletons = split->getNumSingleton();
-                distName = split->getDistanceFiles();  //returns map of distance files -> namefile sorted by distance file size
-                delete split;
+                
+                if (stream) {
+                    current->setMothurCalling(false);
+                    m->mothurOut("It took " + toString(time(NULL) - estart) + " seconds to split the distance file.\n");
+                    estart = time(NULL);
+                    
+                    //the groups are clustered as they are read from the split
+                    listFileNames = createStreamProcesses(split, labels);
+                    delete split;
+                    split = NULL;
+                }else {
+                    distName = split->getDistanceFiles();  //returns map of distance files -> namefile sorted by distance file size
+                    delete split;
+                }
                 current->setMothurCalling(false);
                 if (m->getDebug()) { m->mothurOut("[DEBUG]: distName.size() = " + toString(distName.size()) + ".\n"); }
                 
                 //output a merged distance file
                 if (makeDist)		{ createMergedDistanceFile(distName); }
 				
-                if (m->getControl_pressed()) { return 0; }
+                if (m->getControl_pressed()) { for (int i = 0; i < listFileNames.size(); i++) { util.mothurRemove(listFileNames[i]); } return 0; }
                 
-                m->mothurOut("It took " + toString(time(NULL) - estart) + " seconds to split the distance file.\n"); 
-                estart = time(NULL);
+                if (!stream) { m->mothurOut("It took " + toString(time(NULL) - estart) + " seconds to split the distance file.\n"); estart = time(NULL); }
 
                 if (!runCluster) {
                     string filename = printFile(singletonName, distName);
@@ -534,7 +569,7 @@ int ClusterSplitCommand::execute(){
             }
 		//****************** break up files between processes and cluster each file set ******************************//
 		
-        listFileNames = createProcesses(distName, labels);
+        if (!stream || (file != "")) { listFileNames = createProcesses(distName, labels); }
         
         if (deleteFiles) {
             //delete the temp files now that we are done
@@ -839,7 +874,7 @@ int ClusterSplitCommand::mergeLists(vector<string> listNames, map<double, int> u
 struct clusterData {
     MothurOut* m;
     Utils util;
-    int count, precision, length, numSingletons, maxIters;
+    int count, precision, length, numSingletons, maxIters, optiProcessors;
     bool showabund, classic, useName, useCount, deleteFiles, cutoffNotSet;
     double cutoff, stableMetric;
     ofstream outList, outRabund, outSabund;
@@ -866,12 +901,14 @@ struct clusterData {
         useName = false;
         useCount = false;
         numSingletons = 0;
+        optiProcessors = 1;
     }
-    void setOptiOptions(string metn, double stabMet, string init, int mxi ) {
+    void setOptiOptions(string metn, double stabMet, string init, int mxi, int op) {
         metricName = metn;
         stableMetric = stabMet;
         maxIters = mxi;
         initialize = init;
+        optiProcessors = op;
     }
     void setNamesCount(string nmf, string cnf) {
         useName = false;
@@ -1008,6 +1045,7 @@ string clusterClassicFile(string thisDistFile, string thisNamefile, double& smal
     }
 }
 //**********************************************************************************************************************
+string runOptiCluster(OptiData* matrix, string thisDistFile, string thisNamefile, double& smallestCutoff, clusterData* params);
 string runOptiCluster(string thisDistFile, string thisNamefile, double& smallestCutoff, clusterData* params){
     try {
         if (params->cutoffNotSet) {  params->m->mothurOut("\nYou did not set a cutoff, using 0.03.\n"); params->cutoff = 0.03;  }
@@ -1017,6 +1055,17 @@ string runOptiCluster(string thisDistFile, string thisNamefile, double& smallest
         
         OptiMatrix matrix(thisDistFile, thisNamefile, nameOrCount, "column", params->cutoff, false);
         
+        return runOptiCluster(&matrix, thisDistFile, thisNamefile, smallestCutoff, params);
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "ClusterSplitCommand", "runOptiCluster");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//thisDistFile names the list file, it and thisNamefile are removed if params->deleteFiles is set
+string runOptiCluster(OptiData* matrix, string thisDistFile, string thisNamefile, double& smallestCutoff, clusterData* params){
+    try {
         ClusterMetric* metric = NULL;
         if (params->metricName == "mcc")             { metric = new MCC();              }
         else if (params->metricName == "sens")       { metric = new Sensitivity();      }
@@ -1033,7 +1082,7 @@ string runOptiCluster(string thisDistFile, string thisNamefile, double& smallest
         else if (params->metricName == "fdr")        { metric = new FDR();              }
         else if (params->metricName == "fpfn")       { metric = new FPFN();             }
         
-        OptiCluster cluster(&matrix, metric, 0);
+        OptiCluster cluster(matrix, metric, 0, params->optiProcessors);
         params->tag = cluster.getTag();
         
         params->m->mothurOut("\nClustering " + thisDistFile + "\n");
@@ -1216,25 +1265,44 @@ string runVsearchCluster(string thisDistFile, string thisNamefile, double& small
         
         if (params->m->getControl_pressed()) {  delete vParse; return ""; }
         
-        vsearchFastafile = vParse->getVsearchFile();
-        
         if (params->cutoff > 1.0) {  params->m->mothurOut("You did not set a cutoff, using 0.03.\n"); params->cutoff = 0.03; }
         
-        //Run vsearch
-        string ucVsearchFile = params->util.getSimpleName(vsearchFastafile) + ".clustered.uc";
-        string logfile = params->util.getSimpleName(vsearchFastafile) + ".clustered.log";
-        vsearchDriver(vsearchFastafile, ucVsearchFile, logfile, smallestCutoff, params);
-        
-        if (params->m->getControl_pressed()) { params->util.mothurRemove(ucVsearchFile); params->util.mothurRemove(logfile);  params->util.mothurRemove(vsearchFastafile); return ""; }
-        
         string thisOutputDir = params->outputDir;
         if (params->outputDir == "") { thisOutputDir += params->util.hasPath(thisDistFile); }
         params->tag = params->method;
         string listFileName = thisOutputDir + params->util.getRootName(params->util.getSimpleName(thisDistFile)) + params->tag + ".list";
         
-        //Convert outputted *.uc file into a list file
         map<string, int> counts;
-        ListVector list = vParse->createListFile(ucVsearchFile, vParse->getNumBins(logfile), toString(params->cutoff), counts);
+        ListVector list;
+        
+        if (params->vsearchLocation == "") { //cluster in process, no temp files
+            vector<seqPriorityNode> seqs = vParse->getSortedSeqs();
+            
+            if (params->m->getControl_pressed()) { delete vParse; return ""; }
+            
+            GreedyCluster greedy(params->method, smallestCutoff);
+            vector<int> bins;
+            int numBins = greedy.cluster(seqs, bins);
+            
+            if (params->m->getControl_pressed()) { delete vParse; return ""; }
+            
+            list = vParse->createListFile(seqs, bins, numBins, toString(params->cutoff), counts);
+        }else {
+            vsearchFastafile = vParse->getVsearchFile();
+            
+            //Run vsearch
+            string ucVsearchFile = params->util.getSimpleName(vsearchFastafile) + ".clustered.uc";
+            string logfile = params->util.getSimpleName(vsearchFastafile) + ".clustered.log";
+            vsearchDriver(vsearchFastafile, ucVsearchFile, logfile, smallestCutoff, params);
+            
+            if (params->m->getControl_pressed()) { params->util.mothurRemove(ucVsearchFile); params->util.mothurRemove(logfile);  params->util.mothurRemove(vsearchFastafile); delete vParse; return ""; }
+            
+            //Convert outputted *.uc file into a list file
+            list = vParse->createListFile(ucVsearchFile, vParse->getNumBins(logfile), toString(params->cutoff), counts);
+            
+            //remove temp files
+            params->util.mothurRemove(ucVsearchFile); params->util.mothurRemove(logfile);  params->util.mothurRemove(vsearchFastafile);
+        }
         
         ofstream out;
         params->util.openOutputFile(listFileName,	out);
@@ -1243,9 +1311,6 @@ string runVsearchCluster(string thisDistFile, string thisNamefile, double& small
         
         if (params->useCount) { list.print(out, counts); }
         else { list.print(out); } delete vParse;
-
-        //remove temp files
-        params->util.mothurRemove(ucVsearchFile); params->util.mothurRemove(logfile);  params->util.mothurRemove(vsearchFastafile);
         
         if (params->deleteFiles) {
             params->util.mothurRemove(thisDistFile);
@@ -1436,6 +1501,43 @@ void cluster(clusterData* params){
     }
     
     
+}
+//**********************************************************************************************************************
+struct streamGroup {
+    OptiMatrix* matrix;
+    string distFile; //the distance file the group would have had, names the list file
+    
+    streamGroup() { matrix = NULL; }
+    streamGroup(OptiMatrix* mt, string df) : matrix(mt), distFile(df) {}
+};
+//**********************************************************************************************************************
+//clusters the groups SplitMatrix reads into the queue until it is closed
+void clusterStream(clusterData* params, BoundedQueue<streamGroup>* groups){
+    try {
+        double smallestCutoff = params->cutoff;
+        
+        streamGroup group;
+        while (groups->pop(group)) {
+            
+            if (params->m->getControl_pressed()) { delete group.matrix; continue; } //empty the queue so the split doesn't wait
+            
+            string listFileName = runOptiCluster(group.matrix, group.distFile, "", smallestCutoff, params);
+            delete group.matrix;
+            
+            if (params->m->getControl_pressed()) { continue; }
+            params->listFileNames.push_back(listFileName);
+        }
+        
+        if (params->m->getControl_pressed()) {
+            for (int i = 0; i < params->listFileNames.size(); i++) {	params->util.mothurRemove(params->listFileNames[i]); 	}
+            params->listFileNames.clear();
+        }
+        params->cutoff = smallestCutoff;
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "ClusterSplitCommand", "clusterStream");
+        exit(1);
+    }
 }
 //**********************************************************************************************************************
 void printData(ListVector* oldList, clusterData* params){
@@ -1460,6 +1562,10 @@ void printData(ListVector* oldList, clusterData* params){
 //**********************************************************************************************************************
 vector<string>  ClusterSplitCommand::createProcesses(vector< map<string, string> > distName, set<string>& labels){
 	try {
+        //processors left over after giving each file its own are used by the opti update
+        int optiProcessors = 1;
+        if ((processors > distName.size()) && (distName.size() != 0)) { optiProcessors = processors / distName.size(); }
+        
         //sanity check
         if (processors > distName.size()) { processors = distName.size(); }
         deleteFiles = false; //so if we need to recalc the processors the files are still there
@@ -1493,7 +1599,7 @@ vector<string>  ClusterSplitCommand::createProcesses(vector< map<string, string>
         //Lauch worker threads
         for (int i = 0; i < processors-1; i++) {
             clusterData* dataBundle = new clusterData(showabund, classic, deleteFiles, dividedNames[i+1], cutoffNotSet, cutoff, precision, length, method, outputdir, vsearchLocation);
-            dataBundle->setOptiOptions(metricName, stableMetric, initialize, maxIters);
+            dataBundle->setOptiOptions(metricName, stableMetric, initialize, maxIters, optiProcessors);
             dataBundle->setNamesCount(namefile, countfile);
             data.push_back(dataBundle);
             
@@ -1502,7 +1608,7 @@ vector<string>  ClusterSplitCommand::createProcesses(vector< map<string, string>
         
         
         clusterData* dataBundle = new clusterData(showabund, classic, deleteFiles, dividedNames[0], cutoffNotSet, cutoff, precision, length, method, outputdir, vsearchLocation);
-        dataBundle->setOptiOptions(metricName, stableMetric, initialize, maxIters);
+        dataBundle->setOptiOptions(metricName, stableMetric, initialize, maxIters, optiProcessors);
         dataBundle->setNamesCount(namefile, countfile);
         cluster(dataBundle);
         listFiles = dataBundle->listFileNames;
@@ -1532,6 +1638,64 @@ vector<string>  ClusterSplitCommand::createProcesses(vector< map<string, string>
 	}
 }
 //**********************************************************************************************************************
+//the split's groups are built one at a time, largest first, and handed to the worker threads through a queue,
+//so only the groups being clustered and the ones waiting in the queue are in memory as matrices
+vector<string>  ClusterSplitCommand::createStreamProcesses(SplitMatrix* split, set<string>& labels){
+	try {
+        vector<string> listFiles;
+        int numGroups = split->getNumGroups();
+        if (numGroups == 0) { return listFiles; }
+        
+        //processors left over after giving each group its own are used by the opti update
+        int optiProcessors = 1;
+        if (processors > numGroups) { optiProcessors = processors / numGroups; }
+        int numWorkers = processors;
+        if (numWorkers > numGroups) { numWorkers = numGroups; }
+        
+        BoundedQueue<streamGroup> groups(numWorkers);
+        
+        //create array of worker threads
+        vector<std::thread*> workerThreads;
+        vector<clusterData*> data;
+        
+        //Lauch worker threads
+        for (int i = 0; i < numWorkers; i++) {
+            vector< map<string, string> > noFiles;
+            clusterData* dataBundle = new clusterData(showabund, classic, false, noFiles, cutoffNotSet, cutoff, precision, length, method, outputdir, vsearchLocation);
+            dataBundle->setOptiOptions(metricName, stableMetric, initialize, maxIters, optiProcessors);
+            dataBundle->setNamesCount(namefile, countfile);
+            data.push_back(dataBundle);
+            
+            workerThreads.push_back(new std::thread(clusterStream, dataBundle, &groups));
+        }
+        
+        for (int i = 0; i < numGroups; i++) {
+            if (m->getControl_pressed()) { break; }
+            
+            groups.push(streamGroup(split->getGroupMatrix(i), split->getGroupFile(i)));
+        }
+        groups.close();
+        
+        for (int i = 0; i < numWorkers; i++) {
+            workerThreads[i]->join();
+            
+            listFiles.insert(listFiles.end(), data[i]->listFileNames.begin(), data[i]->listFileNames.end());
+            labels.insert(data[i]->labels.begin(), data[i]->labels.end());
+            if (i == 0) { tag = data[i]->tag; cutoff = data[i]->cutoff; }
+            else if (data[i]->cutoff < cutoff) { cutoff = data[i]->cutoff; }
+            
+            delete data[i];
+            delete workerThreads[i];
+        }
+        
+        return listFiles;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClusterSplitCommand", "createStreamProcesses");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
 
 int ClusterSplitCommand::createMergedDistanceFile(vector< map<string, string> > distNames) {
 	try{
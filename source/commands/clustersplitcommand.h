@@ -25,7 +25,9 @@
 #include "clustercommand.h"
 #include "clusterclassic.h"
 #include "vsearchfileparser.h"
+#include "greedycluster.hpp"
 #include "opticluster.h"
+#include "boundedqueue.hpp"
 #include "calculator.h"
 
 class ClusterSplitCommand : public Command {
@@ -51,11 +53,12 @@ private:
 	vector<string> outputNames;
 	string file, method, fileroot, tag, phylipfile, columnfile, namefile, countfile, distfile, format, timing, splitmethod, taxFile, fastafile, inputDir, vsearchLocation, metricName, initialize;
 	double cutoff, splitcutoff, stableMetric;
-	int precision, length, processors, taxLevelCutoff, maxIters, numSingletons;
-	bool  abort, large, classic, runCluster, deleteFiles, isList, cutoffNotSet, makeDist, runsensSpec, showabund; 
+	int precision, length, processors, taxLevelCutoff, maxIters, numSingletons, memory;
+	bool  abort, large, classic, runCluster, deleteFiles, isList, cutoffNotSet, makeDist, runsensSpec, showabund, stream; 
 	
 	void printData(ListVector*);
 	vector<string> createProcesses(vector< map<string, string> >, set<string>&);
+    vector<string> createStreamProcesses(SplitMatrix*, set<string>&);
 	int mergeLists(vector<string>, map<double, int>, ListVector*);
 	map<double, int> completeListFile(vector<string>, string, set<string>&, ListVector*&);
 	int createMergedDistanceFile(vector< map<string, string> >);
@@ -0,0 +1,213 @@
+//
+//  convertdistcommand.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "convertdistcommand.hpp"
+
+//**********************************************************************************************************************
+vector<string> ConvertDistCommand::setParameters(){
+    try {
+        CommandParameter pphylip("phylip", "InputTypes", "", "", "PhylipColumnBdist", "PhylipColumnBdist", "none","bdist",false,false,true); parameters.push_back(pphylip);
+        CommandParameter pcolumn("column", "InputTypes", "", "", "PhylipColumnBdist", "PhylipColumnBdist", "none","bdist",false,false,true); parameters.push_back(pcolumn);
+        CommandParameter pbdist("bdist", "InputTypes", "", "", "PhylipColumnBdist", "PhylipColumnBdist", "none","column-phylip",false,false,true); parameters.push_back(pbdist);
+        CommandParameter poutput("output", "Multiple", "column-lt-binary", "", "", "", "","",false,false); parameters.push_back(poutput);
+        CommandParameter pcutoff("cutoff", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pcutoff);
+        CommandParameter pbits("bits", "Multiple", "32-16", "32", "", "", "","",false,false); parameters.push_back(pbits);
+        CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
+        CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
+        CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
+        
+        abort = false; calledHelp = false;
+        
+        vector<string> tempOutNames;
+        outputTypes["phylip"] = tempOutNames;
+        outputTypes["column"] = tempOutNames;
+        outputTypes["bdist"] = tempOutNames;
+        
+        vector<string> myArray;
+        for (int i = 0; i < parameters.size(); i++) {    myArray.push_back(parameters[i].name);        }
+        return myArray;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ConvertDistCommand", "setParameters");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+string ConvertDistCommand::getHelpString(){
+    try {
+        string helpString = "";
+        helpString += "The convert.dist command converts a distance file between the column, phylip and binary (.bdist) formats.\n";
+        helpString += "The convert.dist command parameters are phylip, column, bdist, output, cutoff and bits. You must provide one of phylip, column or bdist.\n";
+        helpString += "The output parameter allows you to specify the format of the new file. Options are column, lt and binary. The default is binary for phylip and column files and column for bdist files.\n";
+        helpString += "The cutoff parameter allows you to specify the largest distance to keep when creating a binary file. The default is 1.0.\n";
+        helpString += "The bits parameter allows you to store the distances in a binary file as 32 or 16 bit floats. 16 bits halves the size of the distances, but only keeps about 3 significant digits. The default is 32.\n";
+        helpString += "When a binary file is converted to lt, distances that are not in the file are written as 1.0.\n";
+        helpString += "The convert.dist command should be in the following format: convert.dist(column=yourColumnFile, output=binary)\n";
+        helpString += "Example convert.dist(column=final.dist, cutoff=0.03).\n";
+        return helpString;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ConvertDistCommand", "getHelpString");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+string ConvertDistCommand::getOutputPattern(string type) {
+    try {
+        string pattern = "";
+        
+        if (type == "phylip")       {  pattern = "[filename],phylip,dist";   }
+        else if (type == "column")  {  pattern = "[filename],dist";          }
+        else if (type == "bdist")   {  pattern = "[filename],bdist";         }
+        else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->setControl_pressed(true);  }
+        
+        return pattern;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ConvertDistCommand", "getOutputPattern");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+ConvertDistCommand::ConvertDistCommand(string option) {
+    try {
+        
+        if(option == "help") { help(); abort = true; calledHelp = true; }
+        else if(option == "citation") { citation(); abort = true; calledHelp = true;}
+        else if(option == "category") {  abort = true; calledHelp = true;  }
+        
+        else {
+            OptionParser parser(option, setParameters());
+            map<string,string> parameters = parser.getParameters();
+            
+            ValidParameters validParameter;
+            phylipfile = validParameter.validFile(parameters, "phylip");
+            if (phylipfile == "not open") { phylipfile = ""; abort = true; }
+            else if (phylipfile == "not found") { phylipfile = ""; }
+            else {  current->setPhylipFile(phylipfile); }
+            
+            columnfile = validParameter.validFile(parameters, "column");
+            if (columnfile == "not open") { columnfile = ""; abort = true; }
+            else if (columnfile == "not found") { columnfile = ""; }
+            else {  current->setColumnFile(columnfile); }
+            
+            bdistfile = validParameter.validFile(parameters, "bdist");
+            if (bdistfile == "not open") { bdistfile = ""; abort = true; }
+            else if (bdistfile == "not found") { bdistfile = ""; }
+            
+            //the column parameter can also be a binary file from dist.seqs
+            if ((columnfile != "") && (BinaryDistFile::isBinary(columnfile))) { bdistfile = columnfile; columnfile = ""; }
+            
+            int numFiles = 0;
+            if (phylipfile != "")   { numFiles++; }
+            if (columnfile != "")   { numFiles++; }
+            if (bdistfile != "")    { numFiles++; }
+            
+            if ((numFiles == 0) && !abort) {
+                columnfile = current->getColumnFile();
+                if (columnfile != "") {
+                    m->mothurOut("Using " + columnfile + " as input file for the column parameter.\n");
+                    if (BinaryDistFile::isBinary(columnfile)) { bdistfile = columnfile; columnfile = ""; }
+                }else {
+                    phylipfile = current->getPhylipFile();
+                    if (phylipfile != "") {  m->mothurOut("Using " + phylipfile + " as input file for the phylip parameter.\n"); }
+                    else { m->mothurOut("[ERROR]: No valid current files. You must provide a phylip, column or bdist file.\n"); abort = true; }
+                }
+            }else if (numFiles > 1) { m->mothurOut("[ERROR]: You may only provide one of phylip, column or bdist.\n"); abort = true; }
+            
+            output = validParameter.valid(parameters, "output");
+            if (output == "not found") {
+                if (bdistfile != "") { output = "column"; }
+                else { output = "binary"; }
+            }
+            if ((output != "column") && (output != "lt") && (output != "binary")) { m->mothurOut("[ERROR]: " + output + " is not a valid output. Options are column, lt and binary.\n"); abort = true; }
+            if ((bdistfile == "") && (output != "binary")) { m->mothurOut("[ERROR]: phylip and column files can only be converted to binary, use a bdist file to create column or lt files.\n"); abort = true; }
+            if ((bdistfile != "") && (output == "binary")) { m->mothurOut("[ERROR]: your file is already in binary format.\n"); abort = true; }
+            
+            string temp = validParameter.valid(parameters, "cutoff");    if (temp == "not found") { temp = "1.0"; }
+            util.mothurConvert(temp, cutoff);
+            
+            temp = validParameter.valid(parameters, "bits");    if (temp == "not found") { temp = "32"; }
+            util.mothurConvert(temp, bits);
+            if ((bits != 32) && (bits != 16)) { m->mothurOut("[ERROR]: " + temp + " is not a valid number of bits. Options are 32 and 16.\n"); abort = true; }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ConvertDistCommand", "ConvertDistCommand");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+int ConvertDistCommand::execute(){
+    try {
+        
+        if (abort) { if (calledHelp) { return 0; }  return 2;    }
+        
+        string inputFile = bdistfile;
+        if (phylipfile != "")       { inputFile = phylipfile; }
+        else if (columnfile != "")  { inputFile = columnfile; }
+        
+        if (outputdir == "") {  outputdir = util.hasPath(inputFile);  }
+        map<string, string> variables;
+        variables["[filename]"] = outputdir + util.getRootName(util.getSimpleName(inputFile));
+        
+        BinaryDistFile binDist;
+        bool good = false;
+        if (phylipfile != "")       { good = binDist.readPhylip(phylipfile, cutoff);   }
+        else if (columnfile != "")  { good = binDist.readColumn(columnfile, cutoff);   }
+        else                        { good = binDist.read(bdistfile);                  }
+        
+        if (!good || m->getControl_pressed()) { return 0; }
+        
+        string outputFileName = "";
+        if (output == "binary") {
+            outputFileName = getOutputFileName("bdist", variables);
+            if (!binDist.write(outputFileName, bits)) { util.mothurRemove(outputFileName); return 0; }
+            outputNames.push_back(outputFileName); outputTypes["bdist"].push_back(outputFileName);
+        }else if (output == "column") {
+            outputFileName = getOutputFileName("column", variables);
+            binDist.writeColumn(outputFileName);
+            outputNames.push_back(outputFileName); outputTypes["column"].push_back(outputFileName);
+        }else {
+            outputFileName = getOutputFileName("phylip", variables);
+            binDist.writePhylip(outputFileName);
+            outputNames.push_back(outputFileName); outputTypes["phylip"].push_back(outputFileName);
+        }
+        
+        if (m->getControl_pressed()) { for (int i = 0; i < outputNames.size(); i++) { util.mothurRemove(outputNames[i]); } return 0; }
+        
+        m->mothurOut("\n" + toString(binDist.getNumSeqs()) + " sequences, " + toString(binDist.getNumDists()) + " distances.\n");
+        
+        //set column file as new current columnfile, binary files are read as column files
+        string currentName = "";
+        itTypes = outputTypes.find("column");
+        if (itTypes != outputTypes.end()) {
+            if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
+        }
+        
+        itTypes = outputTypes.find("bdist");
+        if (itTypes != outputTypes.end()) {
+            if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
+        }
+        
+        itTypes = outputTypes.find("phylip");
+        if (itTypes != outputTypes.end()) {
+            if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setPhylipFile(currentName); }
+        }
+        
+        m->mothurOut("\nOutput File Names: \n");
+        for (int i = 0; i < outputNames.size(); i++) {    m->mothurOut(outputNames[i] +"\n");     } m->mothurOutEndLine();
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ConvertDistCommand", "execute");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
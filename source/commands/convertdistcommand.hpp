@@ -0,0 +1,41 @@
+//
+//  convertdistcommand.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef convertdistcommand_hpp
+#define convertdistcommand_hpp
+
+#include "command.hpp"
+#include "binarydistfile.hpp"
+
+class ConvertDistCommand : public Command {
+
+public:
+    ConvertDistCommand(string);
+    ~ConvertDistCommand() {}
+    
+    vector<string> setParameters();
+    string getCommandName()            { return "convert.dist";             }
+    string getCommandCategory()        { return "General";                  }
+    
+    string getHelpString();
+    string getOutputPattern(string);
+    string getCitation()            { return "http://www.mothur.org/wiki/Convert.dist";                                  }
+    string getDescription()         { return "converts distance files between the column, phylip and binary formats";    }
+    
+    int execute();
+    void help() { m->mothurOut(getHelpString()); }
+    
+private:
+    bool abort;
+    string phylipfile, columnfile, bdistfile, output;
+    float cutoff;
+    int bits;
+    vector<string> outputNames;
+};
+
+#endif /* convertdistcommand_hpp */
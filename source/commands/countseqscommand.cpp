@@ -47,6 +47,7 @@ string CountSeqsCommand::getHelpString(){
 		helpString += "The groups parameter allows you to indicate which groups you want to include in the counts, by default all groups in your groupfile are used.\n";
         helpString += "The compress parameter allows you to indicate you want the count table printed in compressed format. Default=t.\n";
 		helpString += "When you use the groups parameter and a sequence does not represent any sequences from the groups you specify it is not included in the .count.summary file.\n";
+		helpString += "Every command that prints a count table, count.seqs included, also writes a binary copy of it, [count table].bin. Later commands read the copy in place of the text while the table is unchanged, and it can be deleted safely.\n";
 		helpString += "The count.seqs command should be in the following format: count.seqs(name=yourNameFile).\n";
 		helpString += "Example count.seqs(name=amazon.names) or make.table(name=amazon.names).\n";
 		return helpString;
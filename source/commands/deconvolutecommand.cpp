@@ -17,6 +17,7 @@ vector<string> DeconvoluteCommand::setParameters(){
 		CommandParameter pname("name", "InputTypes", "", "", "namecount", "none", "none","name",false,false,true); parameters.push_back(pname);
         CommandParameter pcount("count", "InputTypes", "", "", "namecount", "none", "none","count",false,false,true); parameters.push_back(pcount);
         CommandParameter pformat("format", "Multiple", "count-name", "name", "", "", "","",false,false, true); parameters.push_back(pformat);
+        CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
         CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -42,10 +43,11 @@ string DeconvoluteCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The unique.seqs command reads a fastafile and creates a name or count file.\n";
-		helpString += "The unique.seqs command parameters are fasta, name, count and format.  fasta is required, unless there is a valid current fasta file.\n";
+		helpString += "The unique.seqs command parameters are fasta, name, count, format and processors.  fasta is required, unless there is a valid current fasta file.\n";
         helpString += "The name parameter is used to provide an existing name file associated with the fasta file. \n";
         helpString += "The count parameter is used to provide an existing count file associated with the fasta file. \n";
         helpString += "The format parameter is used to indicate what type of file you want outputted.  Choices are name and count, default=name unless count file used then default=count.\n";
+        helpString += "The processors parameter allows you to specify the number of processors to use while finding the unique sequences. The default is all available.\n";
 		helpString += "The unique.seqs command should be in the following format: \n";
 		helpString += "unique.seqs(fasta=yourFastaFile) \n";	
 		return helpString;
@@ -110,6 +112,9 @@ DeconvoluteCommand::DeconvoluteCommand(string option)  {
 			
             if ((countfile != "") && (namefile != "")) { m->mothurOut("When executing a unique.seqs command you must enter ONLY ONE of the following: count or name.\n");  abort = true; }
 			
+            string temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+            processors = current->setProcessors(temp);
+            
             format = validParameter.valid(parameters, "format");
             if(format == "not found"){
                 if (countfile != "") { format = "count";    }
@@ -182,91 +187,98 @@ int DeconvoluteCommand::execute() {
 		ofstream outFasta;
 		util.openOutputFile(outFastaFile, outFasta);
 		
-		map<string, string> sequenceStrings; //sequenceString -> list of names.  "atgc...." -> seq1,seq2,seq3.
-		map<string, string>::iterator itStrings;
-		set<string> nameInFastaFile; //for sanity checking
-		set<string>::iterator itname;
-		vector<string> nameFileOrder;
-        CountTable newCt;
-		int count = 0;
+		Dereplicator uniques(processors); //unique sequence -> names or counts
+		Dereplicator namesInFastaFile(processors); //for sanity checking
+		vector<Sequence> seqs;
+		vector<string> alignedSeqs, seqNames;
+		vector<int> uniqueIndexes, nameIndexes;
+		vector<bool> isNew, isNewName;
+		int count = 0; int numUniques = 0;
 		while (!in.eof()) {
 			
 			if (m->getControl_pressed()) { in.close(); outFasta.close(); util.mothurRemove(outFastaFile); return 0; }
 			
-			Sequence seq(in);
+			//read a batch of sequences so the processors can split the hashing
+			seqs.clear(); alignedSeqs.clear(); seqNames.clear();
+			while (!in.eof() && (seqs.size() < 10000)) {
+				Sequence seq(in); util.gobble(in);
+				if (seq.getName() != "") { alignedSeqs.push_back(seq.getAligned()); seqNames.push_back(seq.getName()); seqs.push_back(seq); }
+			}
+			
+			uniques.add(alignedSeqs, uniqueIndexes, isNew);
+			namesInFastaFile.add(seqNames, nameIndexes, isNewName);
 			
-			if (seq.getName() != "") {
+			for (int i = 0; i < seqs.size(); i++) {
+				
+				if (m->getControl_pressed()) { in.close(); outFasta.close(); util.mothurRemove(outFastaFile); return 0; }
+				
+				string seqName = seqNames[i];
+				int index = uniqueIndexes[i];
 				
 				//sanity checks
-				itname = nameInFastaFile.find(seq.getName());
-				if (itname == nameInFastaFile.end()) { nameInFastaFile.insert(seq.getName());  }
-				else { m->mothurOut("[ERROR]: You already have a sequence named " + seq.getName() + " in your fasta file, sequence names must be unique, please correct.\n");  }
-
-				itStrings = sequenceStrings.find(seq.getAligned());
+				if (!isNewName[i]) { m->mothurOut("[ERROR]: You already have a sequence named " + seqName + " in your fasta file, sequence names must be unique, please correct.\n");  }
 				
-				if (itStrings == sequenceStrings.end()) { //this is a new unique sequence
+				if (isNew[i]) { //this is a new unique sequence
 					//output to unique fasta file
-					seq.printSequence(outFasta);
+					seqs[i].printSequence(outFasta);
+					numUniques++;
 					
 					if (namefile != "") {
-						itNames = nameMap.find(seq.getName());
+						itNames = nameMap.find(seqName);
 						
 						if (itNames == nameMap.end()) { //namefile and fastafile do not match
-							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct.\n"); 
+							m->mothurOut("[ERROR]: " + seqName + " is in your fasta file, and not in your namefile, please correct.\n"); 
 						}else {
-                            if (format == "name") { sequenceStrings[seq.getAligned()] = itNames->second;  nameFileOrder.push_back(seq.getAligned());
-                            }else {  newCt.push_back(seq.getName(), util.getNumNames(itNames->second)); sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
+                            if (format == "name") { uniques.addMember(index, itNames->second);
+                            }else {  uniques.addMember(index, seqName); uniques.addAbundance(index, util.getNumNames(itNames->second)); }
 						}
 					}else if (countfile != "") {
                         if (format == "name") {
-                            int numSeqs = ct.getNumSeqs(seq.getName());
-                            string expandedName = seq.getName()+"_0";
-                            for (int i = 1; i < numSeqs; i++) {  expandedName += "," + seq.getName() + "_" + toString(i);  }
-                            sequenceStrings[seq.getAligned()] = expandedName;  nameFileOrder.push_back(seq.getAligned());
+                            int numSeqs = ct.getNumSeqs(seqName);
+                            string expandedName = seqName+"_0";
+                            for (int j = 1; j < numSeqs; j++) {  expandedName += "," + seqName + "_" + toString(j);  }
+                            uniques.addMember(index, expandedName);
                         }else {
-                            ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
-                            sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned());
+                            ct.getNumSeqs(seqName); //checks to make sure seq is in table
+                            uniques.addMember(index, seqName);
                         }
                     }else {
-                        if (format == "name") { sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
-                        else {  newCt.push_back(seq.getName()); sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
+                        uniques.addMember(index, seqName); uniques.addAbundance(index, 1);
                     }
 				}else { //this is a dup
 					if (namefile != "") {
-						itNames = nameMap.find(seq.getName());
+						itNames = nameMap.find(seqName);
 						
 						if (itNames == nameMap.end()) { //namefile and fastafile do not match
-							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct.\n"); 
+							m->mothurOut("[ERROR]: " + seqName + " is in your fasta file, and not in your namefile, please correct.\n"); 
 						}else {
-                            if (format == "name") { sequenceStrings[seq.getAligned()] += "," + itNames->second;  }
-                            else {  int currentReps = newCt.getNumSeqs(itStrings->second);  newCt.setNumSeqs(itStrings->second, currentReps+(util.getNumNames(itNames->second)));  }
+                            if (format == "name") { uniques.addMember(index, itNames->second);  }
+                            else {  uniques.addAbundance(index, util.getNumNames(itNames->second));  }
 						}
                     }else if (countfile != "") {
                         if (format == "name") {
-                            int numSeqs = ct.getNumSeqs(seq.getName());
-                            string expandedName = seq.getName()+"_0";
-                            for (int i = 1; i < numSeqs; i++) {  expandedName += "," + seq.getName() + "_" + toString(i);  }
-                            sequenceStrings[seq.getAligned()] += "," + expandedName;
+                            int numSeqs = ct.getNumSeqs(seqName);
+                            string expandedName = seqName+"_0";
+                            for (int j = 1; j < numSeqs; j++) {  expandedName += "," + seqName + "_" + toString(j);  }
+                            uniques.addMember(index, expandedName);
                         }else {
-                            int num = ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
+                            int num = ct.getNumSeqs(seqName); //checks to make sure seq is in table
                             if (num != 0) { //its in the table
-                                ct.mergeCounts(itStrings->second, seq.getName()); //merges counts and saves in uniques name
+                                ct.mergeCounts(uniques.getFirstMember(index), seqName); //merges counts and saves in uniques name
                             }
                         }
                     }else {
-                        if (format == "name") {  sequenceStrings[seq.getAligned()] += "," + seq.getName(); }
-                        else {  int currentReps = newCt.getNumSeqs(itStrings->second); newCt.setNumSeqs(itStrings->second, currentReps+1);  }
+                        if (format == "name") {  uniques.addMember(index, seqName); }
+                        else {  uniques.addAbundance(index, 1);  }
                     }
 				}
 				count++;
+				
+				if(count % 1000 == 0)	{ m->mothurOutJustToScreen(toString(count) + "\t" + toString(numUniques) + "\n");	}
 			}
-			
-			util.gobble(in);
-			
-			if(count % 1000 == 0)	{ m->mothurOutJustToScreen(toString(count) + "\t" + toString(sequenceStrings.size()) + "\n");	}
 		}
 		
-		if(count % 1000 != 0)	{ m->mothurOut(toString(count) + "\t" + toString(sequenceStrings.size())); m->mothurOutEndLine();	}
+		if(count % 1000 != 0)	{ m->mothurOut(toString(count) + "\t" + toString(numUniques)); m->mothurOutEndLine();	}
 		
 		in.close();
 		outFasta.close();
@@ -278,29 +290,33 @@ int DeconvoluteCommand::execute() {
 		if (format == "name") { util.openOutputFile(outNameFile, outNames); outputNames.push_back(outNameFile); outputTypes["name"].push_back(outNameFile);   }
         else { util.openOutputFile(outCountFile, outNames); outputTypes["count"].push_back(outCountFile); outputNames.push_back(outCountFile);                }
         
+        CountTable newCt;
+        if ((countfile == "") && (format == "count")) {
+            for (int i = 0; i < uniques.getNumUniques(); i++) { if (uniques.hasMembers(i)) { newCt.push_back(uniques.getFirstMember(i), uniques.getAbundance(i)); } }
+        }
+        
         if ((countfile != "") && (format == "count")) { ct.printHeaders(outNames); }
         else if ((countfile == "") && (format == "count")) { newCt.printHeaders(outNames); }
 		
-		for (int i = 0; i < nameFileOrder.size(); i++) {
+		for (int i = 0; i < uniques.getNumUniques(); i++) {
 			if (m->getControl_pressed()) { outputTypes.clear(); util.mothurRemove(outFastaFile); outNames.close(); for (int j = 0; j < outputNames.size(); j++) { util.mothurRemove(outputNames[j]); } return 0; }
 			
-			itStrings = sequenceStrings.find(nameFileOrder[i]);
+			if (!uniques.hasMembers(i)) { continue; } //not in the namefile
 			
-			if (itStrings != sequenceStrings.end()) {
-                if (format == "name") {
-                    //get rep name
-                    int pos = (itStrings->second).find_first_of(',');
-                    
-                    if (pos == string::npos) { // only reps itself
-                        outNames << itStrings->second << '\t' << itStrings->second << endl;
-                    }else {
-                        outNames << (itStrings->second).substr(0, pos) << '\t' << itStrings->second << endl;
-                    }
+            if (format == "name") {
+                //get rep name
+                string members = uniques.getMembers(i);
+                int pos = members.find_first_of(',');
+                
+                if (pos == string::npos) { // only reps itself
+                    outNames << members << '\t' << members << endl;
                 }else {
-                    if (countfile != "") {  ct.printSeq(outNames, itStrings->second);  }
-                    else if (format == "count")  {  newCt.printSeq(outNames, itStrings->second);  }
+                    outNames << members.substr(0, pos) << '\t' << members << endl;
                 }
-			}else{ m->mothurOut("[ERROR]: mismatch in namefile print.\n");  m->setControl_pressed(true); }
+            }else {
+                if (countfile != "") {  ct.printSeq(outNames, uniques.getFirstMember(i));  }
+                else if (format == "count")  {  newCt.printSeq(outNames, uniques.getFirstMember(i));  }
+            }
 		}
 		outNames.close();
 		
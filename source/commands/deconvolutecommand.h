@@ -12,6 +12,7 @@
 #include "command.hpp"
 #include "fastamap.h"
 #include "counttable.h"
+#include "dereplicator.hpp"
 
 /* The unique.seqs command reads a fasta file, finds the duplicate sequences and outputs a names file
 	containing 2 columns.  The first being the groupname and the second the list of identical sequence names. */ 
@@ -40,6 +41,7 @@ public:
 private:
 	string fastafile, namefile,  countfile, format;
 	vector<string> outputNames;
+	int processors;
 
 	bool abort;
 };
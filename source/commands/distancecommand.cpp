@@ -14,11 +14,12 @@ vector<string> DistanceCommand::setParameters(){
 	try {
 		CommandParameter pcolumn("column", "InputTypes", "", "", "none", "none", "OldFastaColumn","column",false,false); parameters.push_back(pcolumn);
 		CommandParameter poldfasta("oldfasta", "InputTypes", "", "", "none", "none", "OldFastaColumn","",false,false); parameters.push_back(poldfasta);
-		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column",false,true, true); parameters.push_back(pfasta);
-		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
+		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column-bdist",false,true, true); parameters.push_back(pfasta);
+		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip-binary", "column", "", "", "","phylip-column-bdist",false,false, true); parameters.push_back(poutput);
 		CommandParameter pcalc("calc", "Multiple", "nogaps-eachgap-onegap", "onegap", "", "", "","",false,false); parameters.push_back(pcalc);
 		CommandParameter pcountends("countends", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pcountends);
         CommandParameter pfitcalc("fitcalc", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pfitcalc);
+        CommandParameter pprefilter("prefilter", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pprefilter);
 		CommandParameter pcompress("compress", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pcompress);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false, true); parameters.push_back(pprocessors);
 		CommandParameter pcutoff("cutoff", "Number", "", "1.0", "", "", "","",false,false, true); parameters.push_back(pcutoff);
@@ -31,6 +32,7 @@ vector<string> DistanceCommand::setParameters(){
         vector<string> tempOutNames;
         outputTypes["phylip"] = tempOutNames;
         outputTypes["column"] = tempOutNames;
+        outputTypes["bdist"] = tempOutNames;
         
 		vector<string> myArray;
 		for (int i = 0; i < parameters.size(); i++) {	myArray.push_back(parameters[i].name);		}
@@ -46,13 +48,15 @@ string DistanceCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The dist.seqs command reads a file containing sequences and creates a distance file.\n";
-		helpString += "The dist.seqs command parameters are fasta, oldfasta, column, calc, countends, output, compress, cutoff and processors.  \n";
+		helpString += "The dist.seqs command parameters are fasta, oldfasta, column, calc, countends, output, compress, cutoff, prefilter and processors.  \n";
 		helpString += "The fasta parameter is required, unless you have a valid current fasta file.\n";
 		helpString += "The oldfasta and column parameters allow you to append the distances calculated to the column file.\n";
 		helpString += "The calc parameter allows you to specify the method of calculating the distances.  Your options are: nogaps, onegap or eachgap. The default is onegap.\n";
 		helpString += "The countends parameter allows you to specify whether to include terminal gaps in distance.  Your options are: T or F. The default is T.\n";
 		helpString += "The cutoff parameter allows you to specify maximum distance to keep. The default is 1.0.\n";
-		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, and square. The default is column.\n";
+		helpString += "The prefilter parameter allows you to skip pairs of sequences whose lengths and base composition already put them above the cutoff, without comparing them. It is used with calc=onegap or calc=eachgap and countends=T, it has no effect with calc=nogaps or countends=F. The distances are the same either way. The default is false.\n";
+		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, square and binary. The default is column.\n";
+		helpString += "The binary output is a column distance file stored in mothur's binary format, .bdist. It is smaller and faster to read than the column file and can be used as the column file for cluster and cluster.split. The convert.dist command converts it to and from the column and phylip formats.\n";
 		helpString += "The processors parameter allows you to specify number of processors to use.  The default is 1.\n";
 		helpString += "The compress parameter allows you to indicate that you want the resulting distance file compressed.  The default is false.\n";
 		helpString += "The dist.seqs command should be in the following format: \n";
@@ -72,6 +76,7 @@ string DistanceCommand::getOutputPattern(string type) {
         
         if (type == "phylip") {  pattern = "[filename],[outputtag],dist"; } 
         else if (type == "column") { pattern = "[filename],dist-[filename],[outputtag],dist"; }
+        else if (type == "bdist") {  pattern = "[filename],bdist"; }
         else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->setControl_pressed(true);  }
         
         return pattern;
@@ -98,12 +103,14 @@ DistanceCommand::DistanceCommand(string option) {
 			if (fastafile == "not found") { 				
 				fastafile = current->getFastaFile(); 
 				if (fastafile != "") { m->mothurOut("Using " + fastafile + " as input file for the fasta parameter.\n");
+					ProfileTimer timer("read");
 					ifstream inFASTA; util.openInputFile(fastafile, inFASTA);
 					alignDB = SequenceDB(inFASTA); 
 					inFASTA.close();
 				}else { 	m->mothurOut("You have no current fastafile and the fasta parameter is required.\n"); abort = true; }
 			}else if (fastafile == "not open") { abort = true; }	
 			else{
+				ProfileTimer timer("read");
 				ifstream inFASTA; util.openInputFile(fastafile, inFASTA);
 				alignDB = SequenceDB(inFASTA); 
 				inFASTA.close();
@@ -137,6 +144,9 @@ DistanceCommand::DistanceCommand(string option) {
             
             temp = validParameter.valid(parameters, "fitcalc");	if(temp == "not found"){	temp = "F";	}
             fitCalc = util.isTrue(temp);
+            
+            temp = validParameter.valid(parameters, "prefilter");	if(temp == "not found"){	temp = "F";	}
+            prefilter = util.isTrue(temp);
 			
 			temp = validParameter.valid(parameters, "cutoff");		if(temp == "not found"){	temp = "1.0"; }
 			util.mothurConvert(temp, cutoff); 
@@ -154,7 +164,7 @@ DistanceCommand::DistanceCommand(string option) {
 			
 			if ((column != "") && (oldfastafile != "") && (output != "column")) { m->mothurOut("You have provided column and oldfasta, indicating you want to append distances to your column file. Your output must be in column format to do so.\n"); abort=true; }
 			
-			if ((output != "column") && (output != "lt") && (output != "square")) { m->mothurOut(output + " is not a valid output form. Options are column, lt and square. I will use column.\n");  output = "column"; }
+			if ((output != "column") && (output != "lt") && (output != "square") && (output != "binary")) { m->mothurOut(output + " is not a valid output form. Options are column, lt, square and binary. I will use column.\n");  output = "column"; }
             
             if ((calc != "onegap") && (calc != "eachgap") && (calc != "nogaps")) { m->mothurOut(calc + " is not a valid output form. Options are eachgap, onegap and nogaps. I'll use onegap.\n");  calc = "onegap";  }
 
@@ -272,6 +282,10 @@ int DistanceCommand::execute(){
 			}
 			
 			util.mothurRemove(outputFile);
+		}else if (output == "binary") {
+			outputFile = getOutputFileName("bdist", variables);
+			util.mothurRemove(outputFile);
+			outputTypes["bdist"].push_back(outputFile);
 		}else { //assume square
 			variables["[outputtag]"] = "square";
 			outputFile = getOutputFileName("phylip", variables);
@@ -323,6 +337,12 @@ int DistanceCommand::execute(){
 			if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
 		}
 		
+		//binary files are read as column files
+		itTypes = outputTypes.find("bdist");
+		if (itTypes != outputTypes.end()) {
+			if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
+		}
+		
 		m->mothurOut("\nOutput File Names: \n");
 		m->mothurOut(outputFile+"\n\n");
 		
@@ -360,36 +380,63 @@ void driverColumn(distanceData* params){
             }
         }
         
+        PackedDist* packedCalculator = NULL;
+        if (params->packedDB != NULL) { packedCalculator = new PackedDist(params->packedDB, params->calc, params->countends, params->cutoff, params->prefilter); }
+        
         int startTime = time(NULL);
+        Profiler* profiler = Profiler::getInstance();
        
         params->count = 0;
-        string buffer = "";
-        for(int i=params->startLine;i<params->endLine;i++){
+        distanceTile tile; long long tileNum = 0;
+        while (params->tiles->getNext(tile, tileNum)) {
             
-            Sequence seqI = params->alignDB.get(i);
-            for(int j=0;j<i;j++){
-                
-                if (params->m->getControl_pressed()) { break;  }
-                
-                if ((i >= params->numNewFasta) && (j >= params->numNewFasta)) { break; }
+            if (params->m->getControl_pressed()) { break;  }
+            
+            string buffer = ""; long long numPairs = 0;
+            ProfileTimer timer("distance");
+            for(long long i=tile.rowStart;i<tile.rowEnd;i++){
                 
-                Sequence seqJ = params->alignDB.get(j);
-                double dist = distCalculator->calcDist(seqI, seqJ);
+                Sequence seqI, seqJ;
+                string nameI = "";
+                if (packedCalculator == NULL) { seqI = params->alignDB.get(i); nameI = seqI.getName(); }
+                else { nameI = params->packedDB->getName(i); }
                 
-                if(dist <= params->cutoff){
-                    buffer += seqI.getName() + " " + seqJ.getName() + " " + toString(dist) + "\n";
-                    params->count++;
+                long long colEnd = min(i, tile.colEnd); //lower triangle
+                for(long long j=tile.colStart;j<colEnd;j++){
+                    
+                    if (params->m->getControl_pressed()) { break;  }
+                    
+                    if ((i >= params->numNewFasta) && (j >= params->numNewFasta)) { break; }
+                    
+                    double dist = 0; numPairs++;
+                    if (packedCalculator != NULL) { dist = packedCalculator->calcDist(i, j); }
+                    else { seqJ = params->alignDB.get(j); dist = distCalculator->calcDist(seqI, seqJ); }
+                    
+                    if(dist <= params->cutoff){
+                        if (params->binDist != NULL) { params->binDist->add(i, j, dist); params->count++; continue; }
+                        
+                        string nameJ = seqJ.getName();
+                        if (packedCalculator != NULL) { nameJ = params->packedDB->getName(j); }
+                        
+                        buffer += nameI + " " + nameJ + " " + toString(dist) + "\n";
+                        params->count++;
+                    }
                 }
             }
+            timer.stop(); profiler->addItems("distance", numPairs);
             
-            if(i % 100 == 0){ params->threadWriter->write(buffer);  buffer = ""; params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
+            if (params->binDist == NULL) { ProfileTimer writeTimer("write"); params->threadWriter->write(buffer); }
             
+            if(tileNum % 100 == 0){ params->m->mothurOutJustToScreen(toString(tile.rowEnd-1) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
         }
-        params->threadWriter->write(buffer);
-        
-        if((params->endLine-1) % 100 != 0){ params->m->mothurOutJustToScreen(toString(params->endLine-1) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
         
         delete distCalculator;
+        if (packedCalculator != NULL) {
+            params->numComputed = packedCalculator->getNumComputed();
+            params->numAbandoned = packedCalculator->getNumAbandoned();
+            params->numSkipped = packedCalculator->getNumSkipped();
+            delete packedCalculator;
+        }
     }
     catch(exception& e) {
         params->m->errorOut(e, "DistanceCommand", "driverColumn");
@@ -416,8 +463,11 @@ void driverLt(distanceData* params){
             }
         }
         
+        PackedDist* packedCalculator = NULL;
+        if (params->packedDB != NULL) { packedCalculator = new PackedDist(params->packedDB, params->calc, params->countends, cutoff, params->prefilter); }
+        
         int startTime = time(NULL);
-        long long numSeqs = params->alignDB.getNumSeqs();
+        long long numSeqs = params->numSeqs;
         
         //column file
         ofstream outFile;
@@ -431,7 +481,14 @@ void driverLt(distanceData* params){
         params->count = 0;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            string name = params->alignDB.get(i).getName();
+            ProfileTimer timer("distance"); //the row's distances and writing them
+            Profiler::getInstance()->addItems("distance", i);
+            
+            Sequence seqI;
+            string name = "";
+            if (packedCalculator == NULL) { seqI = params->alignDB.get(i); name = seqI.getName(); }
+            else { name = params->packedDB->getName(i); }
+            
             if (name.length() < 10) {  while (name.length() < 10) {  name += " ";  } }
             outFile << name;
             
@@ -441,7 +498,9 @@ void driverLt(distanceData* params){
                 
                 if ((i >= params->numNewFasta) && (j >= params->numNewFasta)) { break; }
                 
-                double dist = distCalculator->calcDist(params->alignDB.get(i), params->alignDB.get(j));
+                double dist = 0;
+                if (packedCalculator != NULL) { dist = packedCalculator->calcDist(i, j); }
+                else { dist = distCalculator->calcDist(seqI, params->alignDB.get(j)); }
                 
                 if(dist <= params->cutoff){ params->count++; }
                 outFile  << '\t' << dist;
@@ -457,6 +516,12 @@ void driverLt(distanceData* params){
         
         outFile.close();
         delete distCalculator;
+        if (packedCalculator != NULL) {
+            params->numComputed = packedCalculator->getNumComputed();
+            params->numAbandoned = packedCalculator->getNumAbandoned();
+            params->numSkipped = packedCalculator->getNumSkipped();
+            delete packedCalculator;
+        }
     }
     catch(exception& e) {
         params->m->errorOut(e, "DistanceCommand", "driverLt");
@@ -482,6 +547,9 @@ void driverSquare(distanceData* params){
                 else if (params->calc == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
             }
         }
+        PackedDist* packedCalculator = NULL;
+        if (params->packedDB != NULL) { packedCalculator = new PackedDist(params->packedDB, params->calc, params->countends, cutoff, params->prefilter); }
+        
         int startTime = time(NULL);
         
         //column file
@@ -490,13 +558,20 @@ void driverSquare(distanceData* params){
         outFile.setf(ios::fixed, ios::showpoint);
         outFile << setprecision(4);
         
-        long long numSeqs = params->alignDB.getNumSeqs();
+        long long numSeqs = params->numSeqs;
         if(params->startLine == 0){	outFile << numSeqs << endl;	}
         
         params->count = 0;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            string name = params->alignDB.get(i).getName();
+            ProfileTimer timer("distance"); //the row's distances and writing them
+            Profiler::getInstance()->addItems("distance", numSeqs);
+            
+            Sequence seqI;
+            string name = "";
+            if (packedCalculator == NULL) { seqI = params->alignDB.get(i); name = seqI.getName(); }
+            else { name = params->packedDB->getName(i); }
+            
             //pad with spaces to make compatible
             if (name.length() < 10) { while (name.length() < 10) {  name += " ";  } }
             
@@ -506,7 +581,9 @@ void driverSquare(distanceData* params){
                 
                 if (params->m->getControl_pressed()) { break; }
                 
-                double dist = distCalculator->calcDist(params->alignDB.get(i), params->alignDB.get(j));
+                double dist = 0;
+                if (packedCalculator != NULL) { dist = packedCalculator->calcDist(i, j); }
+                else { dist = distCalculator->calcDist(seqI, params->alignDB.get(j)); }
                 
                 if(dist <= params->cutoff){ params->count++; }
                 
@@ -522,6 +599,12 @@ void driverSquare(distanceData* params){
         
         outFile.close();
         delete distCalculator;
+        if (packedCalculator != NULL) {
+            params->numComputed = packedCalculator->getNumComputed();
+            params->numAbandoned = packedCalculator->getNumAbandoned();
+            params->numSkipped = packedCalculator->getNumSkipped();
+            delete packedCalculator;
+        }
     }
     catch(exception& e) {
         params->m->errorOut(e, "DistanceCommand", "driverSquare");
@@ -547,34 +630,60 @@ void driverFitCalc(distanceData* params){
             }
         }
         
+        //oldfasta seqs are packed after the fasta seqs
+        PackedDist* packedCalculator = NULL;
+        if (params->packedDB != NULL) { packedCalculator = new PackedDist(params->packedDB, params->calc, params->countends, params->cutoff, params->prefilter); }
+        
         int startTime = time(NULL);
+        Profiler* profiler = Profiler::getInstance();
         params->count = 0;
-        string buffer = "";
-        for(int i=params->startLine;i<params->endLine;i++){
+        
+        //tile rows are oldfasta seqs, columns are fasta seqs
+        distanceTile tile; long long tileNum = 0;
+        while (params->tiles->getNext(tile, tileNum)) {
             
-            Sequence seqI = params->oldFastaDB.get(i);
-            for(int j = 0; j < params->alignDB.getNumSeqs(); j++){
-                
-                if (params->m->getControl_pressed()) { break;  }
+            if (params->m->getControl_pressed()) { break;  }
+            
+            string buffer = ""; long long numPairs = 0;
+            ProfileTimer timer("distance");
+            for(long long i=tile.rowStart;i<tile.rowEnd;i++){
                 
-                Sequence seqJ = params->alignDB.get(j);
-                double dist = distCalculator->calcDist(seqI, seqJ);
+                Sequence seqI, seqJ;
+                string nameI = "";
+                if (packedCalculator == NULL) { seqI = params->oldFastaDB.get(i); nameI = seqI.getName(); }
+                else { nameI = params->packedDB->getName(params->numSeqs + i); }
                 
-                if(dist <= params->cutoff){
-                    buffer += seqI.getName() + " " + seqJ.getName() + " " + toString(dist) + "\n";
-                    params->count++;
+                for(long long j = tile.colStart; j < tile.colEnd; j++){
+                    
+                    if (params->m->getControl_pressed()) { break;  }
+                    
+                    double dist = 0; numPairs++;
+                    if (packedCalculator != NULL) { dist = packedCalculator->calcDist(params->numSeqs + i, j); }
+                    else { seqJ = params->alignDB.get(j); dist = distCalculator->calcDist(seqI, seqJ); }
+                    
+                    if(dist <= params->cutoff){
+                        string nameJ = seqJ.getName();
+                        if (packedCalculator != NULL) { nameJ = params->packedDB->getName(j); }
+                        
+                        buffer += nameI + " " + nameJ + " " + toString(dist) + "\n";
+                        params->count++;
+                    }
                 }
             }
+            timer.stop(); profiler->addItems("distance", numPairs);
             
-            if(i % 100 == 0){ params->threadWriter->write(buffer);  buffer = ""; params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
+            { ProfileTimer writeTimer("write"); params->threadWriter->write(buffer); }
             
+            if(tileNum % 100 == 0){ params->m->mothurOutJustToScreen(toString(tile.rowEnd-1) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
         }
-        params->threadWriter->write(buffer);
-        
-        if((params->endLine-1) % 100 != 0){ params->m->mothurOutJustToScreen(toString(params->endLine-1) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
         
         delete distCalculator;
-
+        if (packedCalculator != NULL) {
+            params->numComputed = packedCalculator->getNumComputed();
+            params->numAbandoned = packedCalculator->getNumAbandoned();
+            params->numSkipped = packedCalculator->getNumSkipped();
+            delete packedCalculator;
+        }
     }
     catch(exception& e) {
         params->m->errorOut(e, "DistanceCommand", "driverFitCalc");
@@ -622,16 +731,43 @@ void DistanceCommand::createProcesses(string filename) {
             oldFastaDB = SequenceDB(inFASTA);
             inFASTA.close();
             
-            lines.clear();
             if (processors > oldFastaDB.getNumSeqs()) { processors = oldFastaDB.getNumSeqs(); }
-            int remainingSeqs = oldFastaDB.getNumSeqs();
-            int startIndex = 0;
-            for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
-                int numSeqsToFit = remainingSeqs; //case for last processor
-                if (remainingProcessors != 1) { numSeqsToFit = ceil(remainingSeqs / remainingProcessors); }
-                lines.push_back(linePair(startIndex, (startIndex+numSeqsToFit))); //startIndex, endIndex
-                startIndex = startIndex + numSeqsToFit;
-                remainingSeqs -= numSeqsToFit;
+        }
+        
+        //encode the sequences once so the threads can compare 64 columns at a time
+        PackedSeqDB packedDB;
+        bool packed = false;
+        ProfileTimer packTimer("pack");
+        if (fitCalc) { packed = packedDB.pack(alignDB, oldFastaDB); }
+        else { packed = packedDB.pack(alignDB); }
+        packTimer.stop();
+        
+        PackedSeqDB* packedDBPtr = NULL;
+        if (packed) { packedDBPtr = &packedDB; }
+        else { m->mothurOut("[WARNING]: unable to pack your sequences, using the slower character by character distance calculation.\n"); }
+        
+        if (m->getControl_pressed()) { return; }
+        
+        //column distances are found a tile at a time, the lt and square files need their rows in order so they are split by line
+        DistanceTiles tiles;
+        if ((output == "column") || (output == "binary")) {
+            long long bytesPerSeq = 1;
+            if (packed)         { bytesPerSeq = packedDB.getNumWords() * packedDB.getRecordSize() * sizeof(unsigned long long); }
+            else if (num != 0)  { bytesPerSeq = alignDB.get(0).getAligned().length(); }
+            
+            //a tile's row and column seqs should fit in about 256K of cache
+            long long tileSize = (128 * 1024) / max(bytesPerSeq, 1LL);
+            if (tileSize > 1024)    { tileSize = 1024;  }
+            if (tileSize < 16)      { tileSize = 16;    }
+            
+            if (fitCalc) { fillTiles(tiles, oldFastaDB.getNumSeqs(), num, false, tileSize); }
+            else { fillTiles(tiles, num, num, true, tileSize); }
+            
+            //make sure there are enough tiles to keep all the processors busy
+            while ((tileSize > 16) && (tiles.getNumTiles() < (processors * 8))) {
+                tileSize /= 2; tiles.clear();
+                if (fitCalc) { fillTiles(tiles, oldFastaDB.getNumSeqs(), num, false, tileSize); }
+                else { fillTiles(tiles, num, num, true, tileSize); }
             }
         }
         
@@ -644,11 +780,14 @@ void DistanceCommand::createProcesses(string filename) {
                 threadWriter = new OutputWriter(synchronizedOutputFile);
                 dataBundle = new distanceData(threadWriter);
             }else { dataBundle = new distanceData(filename+extension); }
-            dataBundle->setVariables(lines[i+1].start, lines[i+1].end, cutoff, alignDB, oldFastaDB, calc, numNewFasta, countends);
+            dataBundle->setVariables(lines[i+1].start, lines[i+1].end, cutoff, alignDB, oldFastaDB, calc, numNewFasta, countends, packedDBPtr, prefilter);
+            dataBundle->tiles = &tiles;
+            if (output == "binary") { dataBundle->binDist = new BinaryDistFile(); dataBundle->binDist->setRunFile(filename + toString(i+1) + ".run"); }
             data.push_back(dataBundle);
             
             std::thread* thisThread = NULL;
-            if (output == "column")     {
+            if (output == "binary")     { thisThread = new std::thread(driverColumn, dataBundle);    }
+            else if (output == "column")     {
                 if (fitCalc)    { thisThread = new std::thread(driverFitCalc, dataBundle);   }
                 else            {  thisThread = new std::thread(driverColumn, dataBundle);   }
             }
@@ -663,22 +802,32 @@ void DistanceCommand::createProcesses(string filename) {
             threadWriter = new OutputWriter(synchronizedOutputFile);
             dataBundle = new distanceData(threadWriter);
         }else { dataBundle = new distanceData(filename); }
-        dataBundle->setVariables(lines[0].start, lines[0].end, cutoff, alignDB, oldFastaDB, calc, numNewFasta, countends);
+        dataBundle->setVariables(lines[0].start, lines[0].end, cutoff, alignDB, oldFastaDB, calc, numNewFasta, countends, packedDBPtr, prefilter);
+        dataBundle->tiles = &tiles;
+        if (output == "binary") { dataBundle->binDist = new BinaryDistFile(); dataBundle->binDist->setRunFile(filename + ".run"); }
         
-        if (output == "column")     {
+        if (output == "binary")     { driverColumn(dataBundle);     }
+        else if (output == "column")     {
             if (fitCalc)    { driverFitCalc(dataBundle);    }
             else            { driverColumn(dataBundle);     }
         }
         else if (output == "lt")    { driverLt(dataBundle);            }
         else                        { driverSquare(dataBundle);        }
         distsBelowCutoff = dataBundle->count;
+        long long numComputed = dataBundle->numComputed;
+        long long numAbandoned = dataBundle->numAbandoned;
+        long long numSkipped = dataBundle->numSkipped;
         
         
         for (int i = 0; i < processors-1; i++) {
             workerThreads[i]->join();
             
             distsBelowCutoff += data[i]->count;
+            numComputed += data[i]->numComputed;
+            numAbandoned += data[i]->numAbandoned;
+            numSkipped += data[i]->numSkipped;
             if (output == "column") {  delete data[i]->threadWriter; }
+            else if (output == "binary") { dataBundle->binDist->append(*data[i]->binDist); delete data[i]->binDist; }
             else {
                 string extension = toString(i+1) + ".temp";
                 util.appendFiles((filename+extension), filename);
@@ -688,10 +837,33 @@ void DistanceCommand::createProcesses(string filename) {
             delete workerThreads[i];
         }
         if (output == "column")     { synchronizedOutputFile->close(); delete threadWriter; }
+        else if (output == "binary") {
+            synchronizedOutputFile->close();
+            
+            vector<string> names;
+            for (long long i = 0; i < num; i++) {
+                if (packed) { names.push_back(packedDB.getName(i)); }
+                else { names.push_back(alignDB.get(i).getName()); }
+            }
+            dataBundle->binDist->setNames(names);
+            if (!m->getControl_pressed()) { dataBundle->binDist->write(filename); }
+            delete dataBundle->binDist;
+        }
         delete dataBundle;
         
+        Profiler::getInstance()->addFileRead("read", fastafile); Profiler::getInstance()->addFileWritten("write", filename);
+        
         time(&end);
-        m->mothurOut("\nIt took " + toString(difftime(end, start)) + " secs to find distances for " + toString(num) + " sequences. " + toString(distsBelowCutoff+numDistsBelowCutoff) + " distances below cutoff " + toString(cutoff) + ".\n\n");
+        m->mothurOut("\nIt took " + toString(difftime(end, start)) + " secs to find distances for " + toString(num) + " sequences. " + toString(distsBelowCutoff+numDistsBelowCutoff) + " distances below cutoff " + toString(cutoff) + ".\n");
+        
+        if (packed) {
+            long long numPairs = numComputed + numSkipped;
+            double pruned = 0.0;
+            if (numPairs != 0) { pruned = (numAbandoned + numSkipped) / (double) numPairs * 100.0; }
+            
+            m->mothurOut("Compared " + toString(numComputed) + " pairs, " + toString(numAbandoned) + " stopped early above the cutoff. Skipped " + toString(numSkipped) + " pairs with the prefilter. " + toString(pruned) + "% of pairs pruned.\n");
+        }
+        m->mothurOut("\n");
         
 	}
 	catch(exception& e) {
@@ -700,6 +872,29 @@ void DistanceCommand::createProcesses(string filename) {
 	}
 }
 /**************************************************************************************************/
+//splits the numRows by numCols matrix into tileSize blocks. For the lower triangle only blocks with columns before the rows are added,
+//and blocks where all the rows and columns are seqs from the old column file are left out.
+void DistanceCommand::fillTiles(DistanceTiles& tiles, long long numRows, long long numCols, bool lowerTriangle, long long tileSize) {
+    try {
+        for (long long rowStart = 0; rowStart < numRows; rowStart += tileSize) {
+            long long rowEnd = min(rowStart + tileSize, numRows);
+            
+            long long lastCol = numCols;
+            if (lowerTriangle) { lastCol = min(rowEnd-1, numCols); }
+            
+            for (long long colStart = 0; colStart < lastCol; colStart += tileSize) {
+                if (lowerTriangle && (rowStart >= numNewFasta) && (colStart >= numNewFasta)) { break; }
+                
+                tiles.add(distanceTile(rowStart, rowEnd, colStart, min(colStart + tileSize, lastCol)));
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "DistanceCommand", "fillTiles");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
 //its okay if the column file does not contain all the names in the fasta file, since some distance may have been above a cutoff,
 //but no sequences can be in the column file that are not in oldfasta. also, if a distance is above the cutoff given then remove it.
 //also check to make sure the 2 files have the same alignment length.
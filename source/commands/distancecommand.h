@@ -20,45 +20,97 @@
 #include "eachgapignore.h"
 #include "onegapdist.h"
 #include "onegapignore.h"
+#include "packeddist.hpp"
+#include "binarydistfile.hpp"
 #include "writer.h"
+#include "profiler.hpp"
 
+/**************************************************************************************************/
+//a block of the distance matrix, rows [rowStart, rowEnd) by columns [colStart, colEnd)
+struct distanceTile {
+    long long rowStart, rowEnd, colStart, colEnd;
+    
+    distanceTile() : rowStart(0), rowEnd(0), colStart(0), colEnd(0) {}
+    distanceTile(long long rs, long long re, long long cs, long long ce) : rowStart(rs), rowEnd(re), colStart(cs), colEnd(ce) {}
+};
+/**************************************************************************************************/
+//the tiles are handed out one at a time as the threads finish them, so a thread that gets faster pairs does more of the work.
+//tiles are small enough that the sequences for a tile's rows and columns stay in the cache while the tile is compared.
+class DistanceTiles {
+    
+public:
+    DistanceTiles() : next(0) {}
+    
+    void add(const distanceTile& t)     { tiles.push_back(t);   }
+    void clear()                        { tiles.clear(); next = 0;  }
+    long long getNumTiles()             { return tiles.size();  }
+    
+    //returns false when all the tiles have been handed out
+    bool getNext(distanceTile& t, long long& tileNum) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (next >= tiles.size()) { return false; }
+        tileNum = next; t = tiles[next]; next++;
+        return true;
+    }
+    
+private:
+    vector<distanceTile> tiles;
+    long long next;
+    std::mutex mutex;
+};
 /**************************************************************************************************/
 struct distanceData {
-	long long startLine, endLine, numNewFasta;
+	long long startLine, endLine, numNewFasta, numSeqs;
+    long long numComputed, numAbandoned, numSkipped;
     double count;
 	float cutoff;
     SequenceDB alignDB;
     SequenceDB oldFastaDB;
+    PackedSeqDB* packedDB; //NULL if the sequences could not be packed
+    DistanceTiles* tiles; //shared by the threads writing column distances
+    BinaryDistFile* binDist; //distances for binary output, NULL otherwise
 	MothurOut* m;
 	OutputWriter* threadWriter;
     string outputFileName, calc;
-	bool countends;
+	bool countends, prefilter;
     Utils util;
 	
-	distanceData(){}
+	distanceData(){ packedDB = NULL; tiles = NULL; binDist = NULL; }
     distanceData(OutputWriter* ofn) {
         threadWriter = ofn;
+        packedDB = NULL; tiles = NULL; binDist = NULL;
         m = MothurOut::getInstance();
     }
     
     distanceData(string ofn) {
         outputFileName = ofn;
+        packedDB = NULL; tiles = NULL; binDist = NULL;
         m = MothurOut::getInstance();
     }
-	void setVariables(int s, int e,  float c, SequenceDB db, SequenceDB oldfn, string Est, long long num, bool cnt) {
+	void setVariables(int s, int e,  float c, SequenceDB& db, SequenceDB& oldfn, string Est, long long num, bool cnt, PackedSeqDB* pdb, bool pf) {
 		startLine = s;
 		endLine = e;
 		cutoff = c;
-		alignDB = db;
-        oldFastaDB = oldfn;
+        numSeqs = db.getNumSeqs();
+        packedDB = pdb;
+        if (packedDB == NULL) { //packed seqs are shared by all threads, no need for a copy
+            alignDB = db;
+            oldFastaDB = oldfn;
+        }
 		calc = Est;
 		numNewFasta = num;
 		countends = cnt;
+        prefilter = pf;
         count = 0;
+        numComputed = 0; numAbandoned = 0; numSkipped = 0;
 	}
 };
 /**************************************************************************************************/
 class DistanceCommand : public Command {
+    
+#ifdef UNIT_TEST
+    friend class TestDistanceCommand;
+#endif
 
 public:
     DistanceCommand(string);
@@ -85,10 +137,11 @@ private:
     long long numNewFasta, numSeqs, numDistsBelowCutoff;
 	float cutoff;
 	
-	bool abort, countends, fitCalc;
+	bool abort, countends, fitCalc, prefilter;
 	vector<string> outputNames; 
 	
 	void createProcesses(string);
+    void fillTiles(DistanceTiles&, long long, long long, bool, long long);
 	bool sanityCheck();
 };
 
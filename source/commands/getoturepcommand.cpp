@@ -409,7 +409,8 @@ int GetOTURepCommand::readDist() {
         
         if (matrix != NULL) { delete matrix; }
         
-        matrix = new OptiMatrix(distfile, thisNamefile, nameOrCount, format, cutoff, false);
+        if (format == "column") { matrix = new OptiCSRMatrix(distfile, thisNamefile, nameOrCount, cutoff, false);  }
+        else                    { matrix = new OptiMatrix(distfile, thisNamefile, nameOrCount, format, cutoff, false); }
         
         if (m->getControl_pressed()) { return 0; }
         
@@ -18,6 +18,7 @@
 #include "groupmap.h"
 #include "counttable.h"
 #include "optimatrix.h"
+#include "opticsrmatrix.hpp"
 #include "nameassignment.hpp"
 #include "countseqscommand.h"
 #include "getseqscommand.h"
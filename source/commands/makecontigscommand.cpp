@@ -10,78 +10,6 @@
 #include "renameseqscommand.h"
 
 //**************************************************************************************************
-
-/**
- * Convert the probability to a quality score.
- */
-
-double convertProbToQ(double prob){
-		try {
-        return round(-10*log10(prob));
-    }
-    catch(exception& e) {
-        MothurOut* m; m = MothurOut::getInstance();
-        m->errorOut(e, "MakeContigsCommand", "convertProbToQ");
-        exit(1);
-    }
-}
-
-//**************************************************************************************************
-
-/**
- * Convert the quality score to a probability.
- */
-
-double convertQToProb(double Q){
-		try {
-        return pow(10,(-Q/10));
-    }
-    catch(exception& e) {
-        MothurOut* m; m = MothurOut::getInstance();
-        m->errorOut(e, "MakeContigsCommand", "convertQToProb");
-        exit(1);
-    }
-}
-
-//**************************************************************************************************
-
-int loadQmatchValues(vector< vector<double> >& qual_match_simple_bayesian, vector< vector<double> >& qual_mismatch_simple_bayesian){
-    try {
-				vector<double> probs(47);
-				for(int i=0;i<probs.size();i++){
-					probs[i] = convertQToProb(i);
-				}
-
-        //qual_match_simple_bayesian - naturally symmetric
-        //qual_mismatch_simple_bayesian - force symmetry
-				for(int i=0;i<qual_match_simple_bayesian.size(); i++){
-					for(int j=0;j<=i;j++){
-						qual_match_simple_bayesian[i][j] = convertProbToQ((probs[i]*probs[j]/3)/(1-probs[i]-probs[j]+4*probs[i]*probs[j]/3));
-
-						qual_mismatch_simple_bayesian[i][j] = convertProbToQ(probs[i]*(1-probs[j]/3)/(probs[i]+probs[j]-4*probs[i]*probs[j]/3));
-					}
-					qual_mismatch_simple_bayesian[i][i] = 2.0;
-				}
-
-				for(int i=0;i<qual_match_simple_bayesian.size(); i++){
-					for(int j=0;j<i;j++){
-						qual_match_simple_bayesian[j][i] = qual_match_simple_bayesian[i][j];
-						qual_mismatch_simple_bayesian[j][i] = qual_mismatch_simple_bayesian[i][j];
-					}
-				}
-
-        return 0;
-    }
-    catch(exception& e) {
-        MothurOut* m; m = MothurOut::getInstance();
-        m->errorOut(e, "MakeContigsCommand", "loadQmatchValues");
-        exit(1);
-    }
-}
-
-//**************************************************************************************************
-
-
 vector<string> MakeContigsCommand::setParameters(){
 	try {
 		CommandParameter pfastq("ffastq", "InputTypes", "", "", "FastaFastqFile", "FastaFastqFile", "fastqGroup","fasta-qfile",false,false,true); parameters.push_back(pfastq);
@@ -671,6 +599,16 @@ unsigned long long MakeContigsCommand::processSingleFileOption(string& outFastaF
     }
 }
 /**************************************************************************************************/
+//a block of read pairs passed from the reader to the threads assembling them, and back to the reader to be refilled
+struct contigsBatch {
+    int numPairs;
+    vector<Sequence> fSeqs, rSeqs, findexBarcodes, rindexBarcodes;
+    vector<QualityScores*> fQuals, rQuals;
+    vector<bool> ignores;
+
+    contigsBatch(int size) : numPairs(0), fSeqs(size), rSeqs(size), findexBarcodes(size, Sequence("findex", "NONE")), rindexBarcodes(size, Sequence("rindex", "NONE")), fQuals(size, NULL), rQuals(size, NULL), ignores(size, false) {}
+};
+/**************************************************************************************************/
 struct contigsData {
     MothurOut* m;
     Utils util;
@@ -679,6 +617,8 @@ struct contigsData {
     OutputWriter* trimQFileName;
     OutputWriter* scrapQFileName;
     OutputWriter* misMatchesFile;
+    BoundedQueue<contigsBatch*>* toAssemble;
+    BoundedQueue<contigsBatch*>* freeBatches;
     string align, group, format;
     float match, misMatch, gapOpen, gapExtend;
     bool gz, reorient, trimOverlap, createGroup, makeQualFile;
@@ -710,6 +650,7 @@ struct contigsData {
         misMatchesFile = mmf;
         m = MothurOut::getInstance();
         count = 0;
+        toAssemble = NULL; freeBatches = NULL;
         makeQualFile = true;
         if (trimQFileName == NULL) { makeQualFile = false; }
     }
@@ -728,6 +669,7 @@ struct contigsData {
         qlinesInput = qli;
         qlinesInputReverse = qlir;
         count = 0;
+        toAssemble = NULL; freeBatches = NULL;
         makeQualFile = true;
         if (trimQFileName == NULL) { makeQualFile = false; }
     }
@@ -804,14 +746,16 @@ struct groupContigsData {
     map<int, string> file2Groups;
     contigsData* bundle;
     long long count;
+    int processors;
 
     groupContigsData() {}
-    groupContigsData(vector< vector<string> > fi, int s, int e, contigsData* cd, map<int, string> f2g) {
+    groupContigsData(vector< vector<string> > fi, int s, int e, contigsData* cd, map<int, string> f2g, int p) {
         fileInputs = fi;
         start = s;
         end = e;
         bundle = cd;
         file2Groups = f2g;
+        processors = p;
         count = 0;
         m = MothurOut::getInstance();
     }
@@ -1258,130 +1202,6 @@ bool checkName(Sequence& forward, QualityScores& reverse, int nameType, int offB
 
 /**************************************************************************************************/
 
-//vector<int> contigScores = assembleFragments(qual_match_simple_bayesian, qual_mismatch_simple_bayesian, fSeq, rSeq, alignment, contig);
-vector<int> assembleFragments(vector< vector<double> >&qual_match_simple_bayesian, vector< vector<double> >& qual_mismatch_simple_bayesian, Sequence& fSeq, Sequence& rSeq, vector<int> scores1, vector<int> scores2, bool hasQuality, Alignment*& alignment, string& contig, string& trashCode, int& oend, int& oStart, int& numMismatches, int insert, int deltaq, bool trimOverlap) {
-    MothurOut* m; m = MothurOut::getInstance();
-    try {
-        vector<int> contigScores;
-
-        //flip the reverse reads
-        rSeq.reverseComplement();
-
-        //pairwise align
-        alignment->align(fSeq.getUnaligned(), rSeq.getUnaligned(), true);
-        map<int, int> ABaseMap = alignment->getSeqAAlnBaseMap();
-        map<int, int> BBaseMap = alignment->getSeqBAlnBaseMap();
-        fSeq.setAligned(alignment->getSeqAAln());
-        rSeq.setAligned(alignment->getSeqBAln());
-        int length = fSeq.getAligned().length();
-
-        //traverse alignments merging into one contiguous seq
-        string seq1 = fSeq.getAligned();
-        string seq2 = rSeq.getAligned();
-        
-        int overlapStart = fSeq.getStartPos()-1;
-        int seq2Start = rSeq.getStartPos()-1;
-
-        //bigger of the 2 starting positions is the location of the overlapping start
-        if (overlapStart < seq2Start) { //seq2 starts later so take from 0 to seq2Start from seq1
-            overlapStart = seq2Start;
-            for (int i = 0; i < overlapStart; i++) { contig += seq1[i];  if (hasQuality) { if (((seq1[i] != '-') && (seq1[i] != '.'))) { contigScores.push_back(scores1[ABaseMap[i]]); } } }
-        }else { //seq1 starts later so take from 0 to overlapStart from seq2
-            for (int i = 0; i < overlapStart; i++) {  contig += seq2[i]; if (hasQuality) { if (((seq2[i] != '-') && (seq2[i] != '.'))) {  contigScores.push_back(scores2[BBaseMap[i]]); }  } }
-        }
-
-        int seq1End = fSeq.getEndPos();
-        int seq2End = rSeq.getEndPos();
-        int overlapEnd = seq1End;
-        if (seq2End < overlapEnd) { overlapEnd = seq2End; }  //smallest end position is where overlapping ends
-
-        oStart = contig.length();
-
-        int firstForward = 0; int seq2FirstForward = 0; int lastReverse = seq1.length(); int seq2lastReverse = seq2.length(); bool firstChooseSeq1 = false; bool lastChooseSeq1 = false;
-        if (hasQuality) {
-            for (int i = 0; i < seq1.length(); i++) { if ((seq1[i] != '.') && (seq1[i] != '-')) { if (scores1[ABaseMap[i]] == 2) { firstForward++; }else { break; } } }
-            for (int i = 0; i < seq2.length(); i++) { if ((seq2[i] != '.') && (seq2[i] != '-')) { if (scores2[BBaseMap[i]] == 2) { seq2FirstForward++; }else { break; } } }
-            if (seq2FirstForward > firstForward) { firstForward = seq2FirstForward; firstChooseSeq1 = true; }
-            for (int i = seq1.length()-1; i >= 0; i--) { if ((seq1[i] != '.') && (seq1[i] != '-')) { if (scores1[ABaseMap[i]] == 2) { lastReverse--; }else { break; } } }
-            for (int i = seq2.length()-1; i >= 0; i--) { if ((seq2[i] != '.') && (seq2[i] != '-')) { if (scores2[BBaseMap[i]] == 2) { seq2lastReverse--; }else { break; } } }
-            if (lastReverse > seq2lastReverse) { lastReverse = seq2lastReverse; lastChooseSeq1 = true; }
-        }
-
-        for (int i = overlapStart; i < overlapEnd; i++) {
-            if (seq1[i] == seq2[i]) {
-                contig += seq1[i];
-                if (hasQuality) {
-                    contigScores.push_back(qual_match_simple_bayesian[PHREDCLAMP(scores1[ABaseMap[i]])][PHREDCLAMP(scores2[BBaseMap[i]])]);
-                }
-            }else if (((seq1[i] == '.') || (seq1[i] == '-')) && ((seq2[i] != '-') && (seq2[i] != '.'))) { //seq1 is a gap and seq2 is a base, choose seq2, unless quality score for base is below insert. In that case eliminate base
-                if (hasQuality) {
-                    if (scores2[BBaseMap[i]] <= insert) { } //
-                    else {
-                        contig += seq2[i];
-                        contigScores.push_back(scores2[BBaseMap[i]]);
-                    }
-                } else {  contig += seq2[i]; } //with no quality info, then we keep it?
-            }else if (((seq2[i] == '.') || (seq2[i] == '-')) && ((seq1[i] != '-') && (seq1[i] != '.'))) { //seq2 is a gap and seq1 is a base, choose seq1, unless quality score for base is below insert. In that case eliminate base
-                if (hasQuality) {
-                    if (scores1[ABaseMap[i]] <= insert) { } //eliminate base
-                    else {
-                        contig += seq1[i];
-                        contigScores.push_back(scores1[ABaseMap[i]]);
-                    }
-                }else { contig += seq1[i]; } //with no quality info, then we keep it?
-            }else if (((seq1[i] != '-') && (seq1[i] != '.')) && ((seq2[i] != '-') && (seq2[i] != '.'))) { //both bases choose one with better quality
-                if (hasQuality) {
-                    if (abs(scores1[ABaseMap[i]] - scores2[BBaseMap[i]]) >= deltaq) { //is the difference in qual scores >= deltaq, if yes choose base with higher score
-                        char c = seq1[i];
-                        if (scores1[ABaseMap[i]] < scores2[BBaseMap[i]]) { c = seq2[i]; }
-                        contig += c;
-                        if ((i >= firstForward) && (i <= lastReverse)) { //in unmasked section
-                            contigScores.push_back(qual_mismatch_simple_bayesian[PHREDCLAMP(scores1[ABaseMap[i]])][PHREDCLAMP(scores2[BBaseMap[i]])]);
-                        }else if (i < firstForward) {
-                            if (firstChooseSeq1) { contigScores.push_back(scores1[ABaseMap[i]]); }
-                            else { contigScores.push_back(scores2[BBaseMap[i]]); }
-                        }else if ((i > lastReverse)) {
-                            if (lastChooseSeq1) { contigScores.push_back(scores1[ABaseMap[i]]);   }
-                            else { contigScores.push_back(scores2[BBaseMap[i]]); }
-                        }else { contigScores.push_back(2); } //N
-                    }else { //if no, base becomes n
-                        contig += 'N'; contigScores.push_back(2);
-                    }
-                    numMismatches++;
-                }else { numMismatches++; } //cant decide, so eliminate and mark as mismatch
-            }else { //should never get here
-                m->mothurOut("[ERROR]: case I didn't think of seq1 = " + toString(seq1[i]) + " and seq2 = " + toString(seq2[i]) + "\n");
-            }
-            //printf("Overlap seq: %i, %i, %i, %c, %i\n", i, scores1[ABaseMap[i]], scores2[BBaseMap[i]], contig[contig.length()-1], contigScores[contigScores.size()-1]);
-        }
-        oend = contig.length();
-        if (seq1End < seq2End) { //seq1 ends before seq2 so take from overlap to length from seq2
-            for (int i = overlapEnd; i < length; i++) { contig += seq2[i];  if (hasQuality) { if (((seq2[i] != '-') && (seq2[i] != '.'))) {  contigScores.push_back(scores2[BBaseMap[i]]); } }
-            }
-        }else { //seq2 ends before seq1 so take from overlap to length from seq1
-            for (int i = overlapEnd; i < length; i++) {  contig += seq1[i];  if (hasQuality) { if (((seq1[i] != '-') && (seq1[i] != '.'))) { contigScores.push_back(scores1[ABaseMap[i]]); } }
-            }
-        }
-
-        if (trimOverlap) {
-            contig = contig.substr(overlapStart, oend-oStart);
-            if (hasQuality) {
-                vector<int> newContigScores;
-                for (int i = overlapStart; i < oend; i++)  { newContigScores.push_back(contigScores[i]);  }
-                contigScores = newContigScores;
-            }
-        }
-
-        if (contig == "") { trashCode += "l"; contig = "NNNN"; contigScores.push_back(2); contigScores.push_back(2); contigScores.push_back(2); contigScores.push_back(2); }
-
-        return contigScores;
-    }
-    catch(exception& e) {
-        m->errorOut(e, "MakeContigsCommand", "assembleFragments");
-        exit(1);
-    }
-}
-/**************************************************************************************************/
 #ifdef USE_BOOST
 //ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, delim,  inFF, inRF, inFQ, inRQ);
 bool read(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, Sequence& findexBarcode, Sequence& rindexBarcode, char delim, boost::iostreams::filtering_istream& inFF, boost::iostreams::filtering_istream& inRF, boost::iostreams::filtering_istream& inFQ, boost::iostreams::filtering_istream& inRQ, string thisfqualindexfile, string thisrqualindexfile, string format, int nameType, int offByOneTrimLength, MothurOut* m) {
@@ -1642,19 +1462,153 @@ vector<int> trimBarCodesAndPrimers(Sequence& fSeq, Sequence& rSeq, QualityScores
     }
 }
 //**********************************************************************************************************************
-//vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, , string group
-void driverContigs(contigsData* params){
+//the alignment, oligos and quality tables a thread trims and assembles its reads with
+struct contigsAssembler {
+    vector<TrimOligos*> trims;
+    Alignment* alignment;
+    FragmentAssembler* fragments;
+    bool hasQuality, hasIndex;
+    int numPrimers, numBarcodes;
+
+    contigsAssembler(contigsData* params) {
+        hasQuality = false;
+        hasIndex = false;
+        if (params->delim == '@') { //fastq files so make an output quality
+            hasQuality = true;
+            for (int i = 0; i < params->qualOrIndexFiles.size(); i++) { if ((params->qualOrIndexFiles[i] != "") && (params->qualOrIndexFiles[i] != "NONE")) {  hasIndex = true; } }
+        }else if ((params->delim == '>') && (params->qualOrIndexFiles.size() != 0)) { hasQuality = true; }
+
+        numPrimers = params->pairedPrimers.size();
+        numBarcodes = params->pairedBarcodes.size();
+
+        if ((numPrimers != 0) || (numBarcodes != 0)) {
+            //standard
+            trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->pairedPrimers, params->pairedBarcodes, hasIndex));
+
+            if (params->reorient) {
+                //reoriented
+                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reorientedPairedPrimers, params->reorientedPairedBarcodes, hasIndex));
+                //reversed
+                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reversedPairedPrimers, params->reversedPairedBarcodes, hasIndex));
+            }
+        }
+
+        alignment = NULL; int longestBase = 1000;
+        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, longestBase);			}
+        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, longestBase);                        }
+        else if(params->align == "kmer")        {   alignment = new KmerAlign(params->kmerSize);                                                                            }
+
+        fragments = new FragmentAssembler(alignment, params->align, params->match, params->misMatch, params->gapOpen, params->gapExtend, params->insert, params->deltaq, params->trimOverlap);
+    }
+    ~contigsAssembler() {
+        for (int i = 0; i < trims.size(); i++) {  delete trims[i]; }
+        delete fragments;
+        if (alignment != NULL) { delete alignment; }
+    }
+};
+//**********************************************************************************************************************
+//trims the barcodes and primers from a pair of reads, assembles them and writes the contig to the good or scrap files
+void assembleContig(contigsData* params, contigsAssembler& assembler, Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, Sequence& findexBarcode, Sequence& rindexBarcode){
     try {
-        vector< vector<double> > qual_match_simple_bayesian;
-        qual_match_simple_bayesian.resize(47);
-        for (int i = 0; i < qual_match_simple_bayesian.size(); i++) { qual_match_simple_bayesian[i].resize(47);  }
+        bool ignore = false;
+
+        //remove primers and barcodes if neccessary
+        vector<string> codes;
+        ProfileTimer oligosTimer("oligos");
+        vector<int> oligosResults = trimBarCodesAndPrimers(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode, assembler.trims, codes, assembler.numBarcodes, assembler.numPrimers, assembler.hasQuality, assembler.hasIndex, params->pdiffs, params->bdiffs, params->tdiffs, params->m);
+        oligosTimer.stop();
+        
+        string trashCode = codes[0];
+        string commentString = codes[1];
+        int barcodeIndex = oligosResults[0];
+        int primerIndex = oligosResults[1];
+        
+        //assemble reads
+        string contig = "";
+        int oend, oStart;
+        int numMismatches = 0;
+        vector<int> scores1, scores2;
+        if(assembler.hasQuality){
+            scores1 = fQual->getScores(); scores2 = rQual->getScores();
+        }
+        ProfileTimer assembleTimer("assemble");
+        vector<int> contigScores = assembler.fragments->assemble(fSeq, rSeq, scores1, scores2, assembler.hasQuality, contig, trashCode, oend, oStart, numMismatches);
+        assembleTimer.stop(); Profiler::getInstance()->addItems("assemble", 1);
+
+								//Note that usearch/vsearch cap the maximum Q value at 41 - perhaps due to ascii
+								//limits? we leave this value unbounded. if two sequences have a 40 then the
+								//assembled quality score will be 85. If two 250 nt reads are all 40 and they
+ 								//perfectly match each other, then the difference in the number of expected errors
+								//between using 85 and 41 all the way across will be 0.01986 - this is a "worst"
+								//case scenario
 
-        vector< vector<double> > qual_mismatch_simple_bayesian;
-        qual_mismatch_simple_bayesian.resize(47);
-        for (int i = 0; i < qual_mismatch_simple_bayesian.size(); i++) { qual_mismatch_simple_bayesian[i].resize(47);  }
+								double expected_errors = assembler.fragments->getExpectedErrors(contigScores);
+
+								if(expected_errors > params->maxee) { trashCode += 'e' ;}
+
+        if(trashCode.length() == 0){
+            string thisGroup = params->group;
+            if (params->createGroup) {
+                if(assembler.numBarcodes != 0){
+                    thisGroup = params->barcodeNameVector[barcodeIndex];
+                    if (assembler.numPrimers != 0) {
+                        if (params->primerNameVector[primerIndex] != "") {
+                            if(thisGroup != "") { thisGroup += "." + params->primerNameVector[primerIndex]; }
+                            else                { thisGroup = params->primerNameVector[primerIndex];        }
+                        }
+                    }
+                }
+            }
+
+            int pos = thisGroup.find("ignore");
+            if (pos == string::npos) {
+                if (thisGroup != "") {
+                    params->groupMap[fSeq.getName()] = thisGroup;
+
+                    map<string, int>::iterator it = params->groupCounts.find(thisGroup);
+                    if (it == params->groupCounts.end()) {	params->groupCounts[thisGroup] = 1; }
+                    else { params->groupCounts[it->first] ++; }
+                }
+            }else { ignore = true; }
+
+            //print good stuff
+            if(!ignore){
+                //output
+                string output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
+                params->trimFileName->write(output);
+                if (assembler.hasQuality && params->makeQualFile) {
+                    output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString +"\n";
+                    for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
+                    params->trimQFileName->write(output);
+                }
+                int numNs = 0;
+                for (int i = 0; i < contig.length(); i++) { if (contig[i] == 'N') { numNs++; }  }
+                output = fSeq.getName() + '\t' + toString(contig.length()) + '\t' + toString(oend-oStart) + '\t' + toString(oStart) + '\t' + toString(oend) + '\t' + toString(numMismatches) + '\t' + toString(numNs) + '\t' + toString(expected_errors) + "\n";
+                params->misMatchesFile->write(output);
+            }
+        }else{
+            params->badNames.insert(fSeq.getName());
 
-        loadQmatchValues(qual_match_simple_bayesian, qual_mismatch_simple_bayesian);
+            string output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" +  toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
+            params->scrapFileName->write(output);
 
+            if (assembler.hasQuality && params->makeQualFile) {
+                output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n";
+                for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
+                params->scrapQFileName->write(output);
+            }
+        }
+        if (params->m->getDebug()) { params->m->mothurOut("\n"); }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "assembleContig");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, , string group
+void driverContigs(contigsData* params){
+    try {
         params->count = 0;
         string thisfqualindexfile, thisrqualindexfile, thisffastafile, thisrfastafile;
         thisfqualindexfile = ""; thisrqualindexfile = "";
@@ -1709,36 +1663,11 @@ void driverContigs(contigsData* params){
             else { thisrqualindexfile = ""; }
         }
 
-        bool hasQuality = false;
-        bool hasIndex = false;
-        if (params->delim == '@') { //fastq files so make an output quality
-            hasQuality = true;
-            if (thisfqualindexfile != "")           { if (thisfqualindexfile != "NONE") {  hasIndex = true; } }
-            if (thisrqualindexfile != "")           { if (thisrqualindexfile != "NONE") {  hasIndex = true; } }
-        }else if ((params->delim == '>') && (params->qualOrIndexFiles.size() != 0)) { hasQuality = true; }
+        contigsAssembler assembler(params);
+        bool hasQuality = assembler.hasQuality;
 
         if (params->m->getDebug()) { if (hasQuality) { params->m->mothurOut("[DEBUG]: hasQuality = true\n");  } else { params->m->mothurOut("[DEBUG]: hasQuality = false\n"); } }
 
-        int numPrimers = params->pairedPrimers.size();
-        int numBarcodes = params->pairedBarcodes.size();
-        
-        vector<TrimOligos*> trims;
-        if ((numPrimers != 0) || (numBarcodes != 0)) {
-            //standard
-            trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->pairedPrimers, params->pairedBarcodes, hasIndex));
-    
-            if (params->reorient) {
-                //reoriented
-                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reorientedPairedPrimers, params->reorientedPairedBarcodes, hasIndex));
-                //reversed
-                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reversedPairedPrimers, params->reversedPairedBarcodes, hasIndex));
-            }
-        }
-        Alignment* alignment; int longestBase = 1000;
-        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, longestBase);			}
-        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, longestBase);                        }
-        else if(params->align == "kmer")        {   alignment = new KmerAlign(params->kmerSize);                                                                            }
-
         bool good = true;
         while (good) {
 
@@ -1750,6 +1679,7 @@ void driverContigs(contigsData* params){
             Sequence findexBarcode("findex", "NONE");  Sequence rindexBarcode("rindex", "NONE");
 
             //read from input files
+            ProfileTimer readTimer("read");
             if (params->gz) {
 #ifdef USE_BOOST
                 ignore = read(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode, params->delim, inFF, inRF, inFQ, inRQ, thisfqualindexfile, thisrqualindexfile, params->format, params->nameType, params->offByOneTrimLength, params->m);
@@ -1757,96 +1687,11 @@ void driverContigs(contigsData* params){
             }else    {
                 ignore = read(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode, params->delim, inFFasta, inRFasta, inFQualIndex, inRQualIndex, thisfqualindexfile, thisrqualindexfile, params->format, params->nameType, params->offByOneTrimLength, params->m);
             }
+            readTimer.stop();
 
-            if (!ignore) {
-                //remove primers and barcodes if neccessary
-                vector<string> codes;
-                vector<int> oligosResults = trimBarCodesAndPrimers(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode, trims, codes, numBarcodes, numPrimers, hasQuality, hasIndex, params->pdiffs, params->bdiffs, params->tdiffs, params->m);
-                
-                string trashCode = codes[0];
-                string commentString = codes[1];
-                int barcodeIndex = oligosResults[0];
-                int primerIndex = oligosResults[1];
-                
-                //assemble reads
-                string contig = "";
-                int oend, oStart;
-                int numMismatches = 0;
-                vector<int> scores1, scores2;
-                if(hasQuality){
-                    scores1 = fQual->getScores(); scores2 = rQual->getScores();
-                    delete fQual; delete rQual;
-                }
-                vector<int> contigScores = assembleFragments(qual_match_simple_bayesian, qual_mismatch_simple_bayesian, fSeq, rSeq, scores1, scores2, hasQuality, alignment, contig, trashCode, oend, oStart, numMismatches, params->insert, params->deltaq, params->trimOverlap);
-
-								//Note that usearch/vsearch cap the maximum Q value at 41 - perhaps due to ascii
-								//limits? we leave this value unbounded. if two sequences have a 40 then the
-								//assembled quality score will be 85. If two 250 nt reads are all 40 and they
- 								//perfectly match each other, then the difference in the number of expected errors
-								//between using 85 and 41 all the way across will be 0.01986 - this is a "worst"
-								//case scenario
-
-								double expected_errors = 0;
-								for(int i=0;i<contigScores.size();i++){
-									expected_errors += convertQToProb(contigScores[i]);
-								}
-
-								if(expected_errors > params->maxee) { trashCode += 'e' ;}
-
-                if(trashCode.length() == 0){
-                    string thisGroup = params->group;
-                    if (params->createGroup) {
-                        if(numBarcodes != 0){
-                            thisGroup = params->barcodeNameVector[barcodeIndex];
-                            if (numPrimers != 0) {
-                                if (params->primerNameVector[primerIndex] != "") {
-                                    if(thisGroup != "") { thisGroup += "." + params->primerNameVector[primerIndex]; }
-                                    else                { thisGroup = params->primerNameVector[primerIndex];        }
-                                }
-                            }
-                        }
-                    }
-
-                    int pos = thisGroup.find("ignore");
-                    if (pos == string::npos) {
-                        if (thisGroup != "") {
-                            params->groupMap[fSeq.getName()] = thisGroup;
-
-                            map<string, int>::iterator it = params->groupCounts.find(thisGroup);
-                            if (it == params->groupCounts.end()) {	params->groupCounts[thisGroup] = 1; }
-                            else { params->groupCounts[it->first] ++; }
-                        }
-                    }else { ignore = true; }
-
-                    //print good stuff
-                    if(!ignore){
-                        //output
-                        string output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
-                        params->trimFileName->write(output);
-                        if (hasQuality && params->makeQualFile) {
-                            output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString +"\n";
-                            for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
-                            params->trimQFileName->write(output);
-                        }
-                        int numNs = 0;
-                        for (int i = 0; i < contig.length(); i++) { if (contig[i] == 'N') { numNs++; }  }
-                        output = fSeq.getName() + '\t' + toString(contig.length()) + '\t' + toString(oend-oStart) + '\t' + toString(oStart) + '\t' + toString(oend) + '\t' + toString(numMismatches) + '\t' + toString(numNs) + '\t' + toString(expected_errors) + "\n";
-                        params->misMatchesFile->write(output);
-                    }
-                }else{
-                    params->badNames.insert(fSeq.getName());
-
-                    string output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" +  toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
-                    params->scrapFileName->write(output);
-
-                    if (hasQuality && params->makeQualFile) {
-                        output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n";
-                        for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
-                        params->scrapQFileName->write(output);
-                    }
-                }
-                if (params->m->getDebug()) { params->m->mothurOut("\n"); }
-            }
+            if (!ignore) { assembleContig(params, assembler, fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode); }
+            if (fQual != NULL) { delete fQual; }
+            if (rQual != NULL) { delete rQual; }
             params->count++;
 
 #if defined NON_WINDOWS
@@ -1910,11 +1755,6 @@ void driverContigs(contigsData* params){
                 }
             }
         }
-
-        //cleanup memory
-        for (int i = 0; i < trims.size(); i++) {  delete trims[i]; }
-        delete alignment;
-        
     }
     catch(exception& e) {
         params->m->errorOut(e, "MakeContigsCommand", "driverContigs");
@@ -1922,6 +1762,151 @@ void driverContigs(contigsData* params){
     }
 }
 //**********************************************************************************************************************
+//assembles the batches the reader puts in the queue until it is closed, and hands them back to be refilled
+void driverContigsBatches(contigsData* params){
+    try {
+        params->count = 0;
+        contigsAssembler assembler(params);
+
+        contigsBatch* batch;
+        while (params->toAssemble->pop(batch)) {
+            for (int i = 0; i < batch->numPairs; i++) {
+                //keep handing the batches back when the command is stopped, so the reader doesn't wait on them
+                if (!params->m->getControl_pressed() && !batch->ignores[i]) {
+                    assembleContig(params, assembler, batch->fSeqs[i], batch->rSeqs[i], batch->fQuals[i], batch->rQuals[i], batch->findexBarcodes[i], batch->rindexBarcodes[i]);
+                }
+                if (batch->fQuals[i] != NULL) { delete batch->fQuals[i]; batch->fQuals[i] = NULL; }
+                if (batch->rQuals[i] != NULL) { delete batch->rQuals[i]; batch->rQuals[i] = NULL; }
+            }
+            params->count += batch->numPairs;
+
+            params->freeBatches->push(batch);
+        }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "driverContigsBatches");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//parses the compressed files into batches of read pairs for the assembly threads, each file is inflated on a thread of
+//its own. Returns the number of pairs read.
+long long readContigsBatches(contigsData* params){
+    try {
+        long long count = 0;
+#ifdef USE_BOOST
+        string thisfqualindexfile = ""; string thisrqualindexfile = "";
+        if (params->qualOrIndexFiles.size() != 0) {
+            thisfqualindexfile = params->qualOrIndexFiles[0];
+            thisrqualindexfile = params->qualOrIndexFiles[1];
+            if (thisfqualindexfile == "NONE") { thisfqualindexfile = ""; }
+            if (thisrqualindexfile == "NONE") { thisrqualindexfile = ""; }
+        }
+
+        InflateReader forward(params->inputFiles[0]);
+        InflateReader reverse(params->inputFiles[1]);
+        InflateReader* findex = NULL; InflateReader* rindex = NULL;
+        if (thisfqualindexfile != "") { findex = new InflateReader(thisfqualindexfile); }
+        if (thisrqualindexfile != "") { rindex = new InflateReader(thisrqualindexfile); }
+
+        boost::iostreams::filtering_istream noIndex;
+        boost::iostreams::filtering_istream& inFF = forward.getStream();
+        boost::iostreams::filtering_istream& inRF = reverse.getStream();
+        boost::iostreams::filtering_istream& inFQ = (findex != NULL) ? findex->getStream() : noIndex;
+        boost::iostreams::filtering_istream& inRQ = (rindex != NULL) ? rindex->getStream() : noIndex;
+
+        bool good = true;
+        contigsBatch* batch;
+        while (good && params->freeBatches->pop(batch)) {
+            ProfileTimer readTimer("read");
+
+            batch->numPairs = 0;
+            while (batch->numPairs < batch->fSeqs.size()) {
+                if (params->m->getControl_pressed()) { good = false; break; }
+
+                int i = batch->numPairs;
+                batch->fQuals[i] = NULL; batch->rQuals[i] = NULL;
+                batch->ignores[i] = read(batch->fSeqs[i], batch->rSeqs[i], batch->fQuals[i], batch->rQuals[i], batch->findexBarcodes[i], batch->rindexBarcodes[i], params->delim, inFF, inRF, inFQ, inRQ, thisfqualindexfile, thisrqualindexfile, params->format, params->nameType, params->offByOneTrimLength, params->m);
+                batch->numPairs++; count++;
+
+                //report progress
+                if((count) % 1000 == 0){	params->m->mothurOutJustToScreen(toString(count)+"\n"); }
+
+                if (inFF.eof() || inRF.eof()) { good = false; break; }
+            }
+            readTimer.stop();
+
+            params->toAssemble->push(batch);
+        }
+
+        //report progress
+        if((count) % 1000 != 0){	params->m->mothurOutJustToScreen(toString(count)+"\n"); }
+
+        if (findex != NULL) { delete findex; }
+        if (rindex != NULL) { delete rindex; }
+#endif
+        params->toAssemble->close();
+
+        return count;
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "readContigsBatches");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//compressed files can't be divided by byte offset, so one reader parses them while processors threads assemble the
+//pairs. The results of the assembly threads are added to params, like driverContigs(params) would leave them.
+void driverContigsGZ(contigsData* params, int processors){
+    try {
+        //the reader and assembly threads pass a fixed set of batches back and forth
+        BoundedQueue<contigsBatch*> toAssemble(4*processors);
+        BoundedQueue<contigsBatch*> freeBatches(4*processors);
+        vector<contigsBatch*> batches;
+        for (int i = 0; i < 4*processors; i++) { batches.push_back(new contigsBatch(64)); freeBatches.push(batches[i]); }
+        params->toAssemble = &toAssemble; params->freeBatches = &freeBatches;
+
+        vector<std::thread*> workerThreads;
+        vector<contigsData*> data;
+        for (int i = 0; i < processors; i++) {
+            //the writers pass everything on to synchronized files, so the assembly threads can share them
+            contigsData* dataBundle = new contigsData(params->trimFileName, params->scrapFileName, params->trimQFileName, params->scrapQFileName, params->misMatchesFile, params->inputFiles, params->qualOrIndexFiles, params->linesInput, params->linesInputReverse, params->qlinesInput, params->qlinesInputReverse);
+            dataBundle->copyVariables(params);
+            dataBundle->toAssemble = &toAssemble; dataBundle->freeBatches = &freeBatches;
+            data.push_back(dataBundle);
+
+            workerThreads.push_back(new std::thread(driverContigsBatches, dataBundle));
+        }
+
+        readContigsBatches(params);
+
+        params->count = 0;
+        for (int i = 0; i < processors; i++) {
+            workerThreads[i]->join();
+            params->count += data[i]->count;
+
+            params->badNames.insert(data[i]->badNames.begin(), data[i]->badNames.end());
+            params->groupMap.insert(data[i]->groupMap.begin(), data[i]->groupMap.end());
+            //merge counts
+            for (map<string, int>::iterator it = data[i]->groupCounts.begin(); it != data[i]->groupCounts.end(); it++) {
+                map<string, int>::iterator itMine = params->groupCounts.find(it->first);
+                if (itMine != params->groupCounts.end()) { itMine->second += it->second; }
+                else { params->groupCounts[it->first] = it->second; }
+            }
+
+            delete data[i];
+            delete workerThreads[i];
+        }
+
+        for (int i = 0; i < batches.size(); i++) { delete batches[i]; }
+        params->toAssemble = NULL; params->freeBatches = NULL;
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "driverContigsGZ");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
 //fileInputs[0] = forward Fasta or Forward Fastq, fileInputs[1] = reverse Fasta or reverse Fastq. if qualOrIndexFiles.size() != 0, then qualOrIndexFiles[0] = forward qual or Forward index, qualOrIndexFiles[1] = reverse qual or reverse index.
 //lines[0] - ffasta, lines[1] - rfasta) - processor1
 //lines[2] - ffasta, lines[3] - rfasta) - processor2
@@ -1938,14 +1923,15 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         vector<linePair> lines;
         vector<linePair> qLines;
 
+        int numDrivers = processors;
         if (gz)  {
             nameType = setNameType(fileInputs[0], fileInputs[1], delim, offByOneTrimLength,  gz, format);
             for (int i = 0; i < fileInputs.size(); i++) {
-                //fake out lines - we are just going to check for end of file. Work is divided by number of files per processor.
+                //fake out lines - we are just going to check for end of file. Work is divided by batches of pairs.
                 lines.push_back(linePair(0, 1000));
                 qLines.push_back(linePair(0, 1000));
             }
-            processors = fileInputs.size() / 2;
+            numDrivers = 1; //driverContigsGZ starts the assembly threads
         }else        {
             //divides the files so that the processors can share the workload.
             setLines(fileInputs, qualOrIndexFiles, lines, qLines, delim);
@@ -1967,7 +1953,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
        
 
         //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
+        for (int i = 0; i < numDrivers-1; i++) {
             OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
             OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
             OutputWriter* threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile);
@@ -1998,7 +1984,8 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMisMatchWriter, fileInputs, qualOrIndexFiles, lines[0], lines[1], qLines[0], qLines[1]);
         dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, revpairedBarcodes, revpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, group);
 
-        driverContigs(dataBundle);
+        if (gz) { driverContigsGZ(dataBundle, processors);  }
+        else    { driverContigs(dataBundle);                }
 
         long long num = dataBundle->count;
         badNames.insert(dataBundle->badNames.begin(), dataBundle->badNames.end());
@@ -2009,7 +1996,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
             else { groupCounts[it->first] = it->second; }
         }
 
-        for (int i = 0; i < processors-1; i++) {
+        for (int i = 0; i < numDrivers-1; i++) {
             workerThreads[i]->join();
             num += data[i]->count;
 
@@ -2041,6 +2028,11 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
             delete threadQScrapWriter;
         }
         delete dataBundle;
+        
+        Profiler* profiler = Profiler::getInstance();
+        for (int i = 0; i < fileInputs.size(); i++)         { profiler->addFileRead("read", fileInputs[i]);         }
+        for (int i = 0; i < qualOrIndexFiles.size(); i++)   { profiler->addFileRead("read", qualOrIndexFiles[i]);   }
+        profiler->addItems("read", num);
 
         return num;
     }
@@ -2114,7 +2106,8 @@ void driverContigsGroups(groupContigsData* gparams) {
 
             contigsData* dataBundle = new contigsData(gparams->bundle->trimFileName, gparams->bundle->scrapFileName, gparams->bundle->trimQFileName, gparams->bundle->scrapQFileName, gparams->bundle->misMatchesFile, theseFileInputs, theseQIInputs, thisLines[0], thisLines[1], thisQLines[0], thisQLines[1]);
             dataBundle->copyVariables(gparams->bundle);
-            driverContigs(dataBundle);
+            if (dataBundle->gz) { driverContigsGZ(dataBundle, gparams->processors);  }
+            else                { driverContigs(dataBundle);                        }
 
             if (decompressionHelped) {
                 gparams->bundle->util.mothurRemove(theseFileInputs[0]); gparams->bundle->util.mothurRemove(theseFileInputs[1]);
@@ -2154,7 +2147,11 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
         //divide files between processors
         vector<linePair> startEndIndexes;
         int remainingPairs = fileInputs.size();
+        int totalProcessors = processors;
         if (remainingPairs < processors) { processors = remainingPairs; }
+
+        //the processors left over when there are fewer file pairs than processors help assemble the pairs
+        int assemblers = max(1, totalProcessors / processors);
         int startIndex = 0;
         for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
             int numPairs = remainingPairs; //case for last processor
@@ -2184,7 +2181,7 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
 
             contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMismatchWriter);
             dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, revpairedBarcodes, revpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, "");
-            groupContigsData* groupDataBundle = new groupContigsData(fileInputs, startEndIndexes[i+1].start, startEndIndexes[i+1].end, dataBundle, file2Groups);
+            groupContigsData* groupDataBundle = new groupContigsData(fileInputs, startEndIndexes[i+1].start, startEndIndexes[i+1].end, dataBundle, file2Groups, assemblers);
             data.push_back(groupDataBundle);
 
             workerThreads.push_back(new std::thread(driverContigsGroups, groupDataBundle));
@@ -2201,7 +2198,7 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
         }
         contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMisMatchWriter);
         dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, revpairedBarcodes, revpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, "");
-        groupContigsData* groupDataBundle = new groupContigsData(fileInputs, startEndIndexes[0].start, startEndIndexes[0].end, dataBundle, file2Groups);
+        groupContigsData* groupDataBundle = new groupContigsData(fileInputs, startEndIndexes[0].start, startEndIndexes[0].end, dataBundle, file2Groups, assemblers);
         driverContigsGroups(groupDataBundle);
 
         delete threadFastaTrimWriter;
@@ -21,11 +21,13 @@
 #include "kmeralign.h"
 #include "splitgroupscommand.h"
 #include "filefile.hpp"
+#include "profiler.hpp"
+#include "boundedqueue.hpp"
+#include "inflatereader.hpp"
+#include "fragmentassembler.hpp"
 
 
 #        define PROBABILITY(score) (pow(10.0, (-(double)(score)) / 10.0))
-#        define PHREDMAX 46
-#        define PHREDCLAMP(x) ((x) > PHREDMAX ? PHREDMAX : ((x) < 0 ? 0 : (x)))
 
 struct pairFastqRead {
 	FastqRead forward;
@@ -15,14 +15,15 @@ vector<string> PairwiseSeqsCommand::setParameters(){
         CommandParameter pcolumn("column", "InputTypes", "", "", "none", "none", "OldFastaColumn","column",false,false); parameters.push_back(pcolumn);
         CommandParameter poldfasta("oldfasta", "InputTypes", "", "", "none", "none", "OldFastaColumn","",false,false); parameters.push_back(poldfasta);
         CommandParameter pfitcalc("fitcalc", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pfitcalc);
-		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column",false,true,true); parameters.push_back(pfasta);
+		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column-bdist",false,true,true); parameters.push_back(pfasta);
 		CommandParameter palign("align", "Multiple", "needleman-gotoh-blast-noalign", "needleman", "", "", "","",false,false); parameters.push_back(palign);
 		CommandParameter pmatch("match", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pmatch);
 		CommandParameter pmismatch("mismatch", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pmismatch);
 		CommandParameter pgapopen("gapopen", "Number", "", "-2.0", "", "", "","",false,false); parameters.push_back(pgapopen);
 		CommandParameter pgapextend("gapextend", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pgapextend);
+        CommandParameter pband("band", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pband);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
-		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip", "column", "", "", "","phylip-column",false,false,true); parameters.push_back(poutput);
+		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip-binary", "column", "", "", "","phylip-column-bdist",false,false,true); parameters.push_back(poutput);
 		CommandParameter pcalc("calc", "Multiple", "nogaps-eachgap-onegap", "onegap", "", "", "","",false,false); parameters.push_back(pcalc);
 		CommandParameter pcountends("countends", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pcountends);
 		CommandParameter pcompress("compress", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pcompress);
@@ -36,6 +37,7 @@ vector<string> PairwiseSeqsCommand::setParameters(){
         vector<string> tempOutNames;
         outputTypes["phylip"] = tempOutNames;
         outputTypes["column"] = tempOutNames;
+        outputTypes["bdist"] = tempOutNames;
 		
 		vector<string> myArray;
 		for (int i = 0; i < parameters.size(); i++) {	myArray.push_back(parameters[i].name);		}
@@ -51,17 +53,19 @@ string PairwiseSeqsCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The pairwise.seqs command reads a fasta file and creates distance matrix.\n";
-		helpString += "The pairwise.seqs command parameters are fasta, align, match, mismatch, gapopen, gapextend, calc, output, cutoff, oldfasta, column and processors.\n";
+		helpString += "The pairwise.seqs command parameters are fasta, align, match, mismatch, gapopen, gapextend, band, calc, output, cutoff, oldfasta, column and processors.\n";
 		helpString += "The fasta parameter is required.\n";
 		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, blast and noalign. The default is needleman.\n";
 		helpString += "The match parameter allows you to specify the bonus for having the same base. The default is 1.0.\n";
 		helpString += "The mistmatch parameter allows you to specify the penalty for having different bases.  The default is -1.0.\n";
 		helpString += "The gapopen parameter allows you to specify the penalty for opening a gap in an alignment. The default is -2.0.\n";
 		helpString += "The gapextend parameter allows you to specify the penalty for extending a gap in an alignment.  The default is -1.0.\n";
+		helpString += "The band parameter allows you to limit the needleman and gotoh alignments to the bases within band of the diagonal the two sequences share the most kmers on. This uses less memory and time for long sequences, but an alignment that needs more than band gaps isn't found. The default is 0, meaning no band.\n";
 		helpString += "The calc parameter allows you to specify the method of calculating the distances.  Your options are: nogaps, onegap or eachgap. The default is onegap.\n";
 		helpString += "The countends parameter allows you to specify whether to include terminal gaps in distance.  Your options are: T or F. The default is T.\n";
 		helpString += "The cutoff parameter allows you to specify maximum distance to keep. The default is 1.0.\n";
-		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, and square. The default is column.\n";
+		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, square and binary. The default is column.\n";
+		helpString += "The binary output is a column distance file stored in mothur's binary format, .bdist. It can be used as the column file for cluster and cluster.split, and the convert.dist command converts it to and from the column and phylip formats.\n";
         helpString += "The oldfasta and column parameters allow you to append the distances calculated to the column file.\n";
 		helpString += "The compress parameter allows you to indicate that you want the resulting distance file compressed.  The default is false.\n";
 		helpString += "The pairwise.seqs command should be in the following format: \n";
@@ -82,6 +86,7 @@ string PairwiseSeqsCommand::getOutputPattern(string type) {
         
         if (type == "phylip") {  pattern = "[filename],[outputtag],dist"; } 
         else if (type == "column") { pattern = "[filename],dist"; }
+        else if (type == "bdist") {  pattern = "[filename],bdist"; }
         else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->setControl_pressed(true);  }
         
         return pattern;
@@ -139,6 +144,10 @@ PairwiseSeqsCommand::PairwiseSeqsCommand(string option)  {
 			temp = validParameter.valid(parameters, "gapextend");	if (temp == "not found"){	temp = "-1.0";			}
 			util.mothurConvert(temp, gapExtend); 
             if (gapExtend > 0) { m->mothurOut("[ERROR]: gapextend must be negative.\n"); abort=true; }
+            
+            temp = validParameter.valid(parameters, "band");		if (temp == "not found"){	temp = "0";			}
+			util.mothurConvert(temp, band);
+            if (band < 0) { m->mothurOut("[ERROR]: band must be positive.\n"); abort=true; }
 			
 			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
 			processors = current->setProcessors(temp);
@@ -170,7 +179,8 @@ PairwiseSeqsCommand::PairwiseSeqsCommand(string option)  {
 			
 			output = validParameter.valid(parameters, "output");		if(output == "not found"){	output = "column"; }
             if (output=="phylip") { output = "lt"; }
-			if ((output != "column") && (output != "lt") && (output != "square")) { m->mothurOut(output + " is not a valid output form. Options are column, lt and square. I will use column.\n");  output = "column"; }
+			if ((output != "column") && (output != "lt") && (output != "square") && (output != "binary")) { m->mothurOut(output + " is not a valid output form. Options are column, lt, square and binary. I will use column.\n");  output = "column"; }
+            if ((column != "") && (oldfastafile != "") && (output == "binary")) { m->mothurOut("You have provided column and oldfasta, indicating you want to append distances to your column file. Your output must be in column format to do so.\n"); abort=true; }
 			
 			calc = validParameter.valid(parameters, "calc");			
 			if (calc == "not found") { calc = "onegap";  }
@@ -227,6 +237,10 @@ int PairwiseSeqsCommand::execute(){
             outputFile = getOutputFileName("column", variables);
             outputTypes["column"].push_back(outputFile);
             util.mothurRemove(outputFile);
+        }else if (output == "binary") {
+            outputFile = getOutputFileName("bdist", variables);
+            util.mothurRemove(outputFile);
+            outputTypes["bdist"].push_back(outputFile);
         }else { //assume square
             variables["[outputtag]"] = "square";
             outputFile = getOutputFileName("phylip", variables);
@@ -287,6 +301,12 @@ int PairwiseSeqsCommand::execute(){
 			if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
 		}
 		
+		//binary files are read as column files
+		itTypes = outputTypes.find("bdist");
+		if (itTypes != outputTypes.end()) {
+			if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
+		}
+		
 		m->mothurOut("\nOutput File Names: \n"); 
 		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i] +"\n"); 	} m->mothurOutEndLine();
 		
@@ -299,6 +319,22 @@ int PairwiseSeqsCommand::execute(){
 	}
 }
 /**************************************************************************************************/
+//the names and unaligned bases of the sequences, pulled out of the SequenceDB once and shared by all the threads
+struct pairwiseSeqs {
+    vector<string> names, seqs;
+    int longest;
+    
+    pairwiseSeqs() : longest(0) {}
+    pairwiseSeqs(SequenceDB& db) : longest(0) {
+        for (long long i = 0; i < db.getNumSeqs(); i++) {
+            Sequence seq = db.get(i);
+            names.push_back(seq.getName()); seqs.push_back(seq.getUnaligned());
+            if (seqs.back().length() > longest) { longest = seqs.back().length(); }
+        }
+    }
+    long long getNumSeqs() { return seqs.size(); }
+};
+/**************************************************************************************************/
 struct pairwiseData {
     string align, distcalcType, outputFileName;
     unsigned long long start;
@@ -306,30 +342,33 @@ struct pairwiseData {
     long long count;
     MothurOut* m;
     float match, misMatch, gapOpen, gapExtend, cutoff;
-    int longestBase;
+    int longestBase, band;
     bool countends;
-    SequenceDB alignDB;
-    SequenceDB oldFastaDB;
+    pairwiseSeqs* seqs;
+    pairwiseSeqs* oldFastaSeqs;
     OutputWriter* threadWriter;
+    BinaryDistFile* binDist; //distances for binary output, NULL otherwise
     Utils util;
     
-    pairwiseData(){}
+    pairwiseData(){ binDist = NULL; }
     pairwiseData(OutputWriter* ofn) {
         threadWriter = ofn;
+        binDist = NULL;
         m = MothurOut::getInstance();
     }
     
     pairwiseData(string ofn) {
         outputFileName = ofn;
+        binDist = NULL;
         m = MothurOut::getInstance();
     }
     
-    void setVariables(string al, string di, bool co, string op, SequenceDB DB, SequenceDB oldDB,  unsigned long long st, unsigned long long en, float ma, float misMa, float gapO, float gapE, int thr, float cu) {
+    void setVariables(string al, string di, bool co, string op, pairwiseSeqs* DB, pairwiseSeqs* oldDB,  unsigned long long st, unsigned long long en, float ma, float misMa, float gapO, float gapE, int thr, float cu, int ba) {
         align = al;
         distcalcType = di;
         countends = co;
-        alignDB = DB;
-        oldFastaDB = oldDB;
+        seqs = DB;
+        oldFastaSeqs = oldDB;
         cutoff = cu;
         start = st;
         end = en;
@@ -338,15 +377,22 @@ struct pairwiseData {
         gapOpen = gapO;
         gapExtend = gapE;
         longestBase = thr;
+        band = ba;
         count = 0;
     }
 };
 /**************************************************************************************************/
-int driverColumn(pairwiseData* params){
-    try {
-        int startTime = time(NULL);
+//a thread's aligner and distance calculator. The aligner is sized for the longest sequence up front so its matrix is
+//never resized, and the same two Sequences are reused for every pair.
+struct pairwiseWorkspace {
+    Alignment* alignment;
+    DistCalc* distCalculator;
+    Sequence seqI, seqJ;
+    MothurOut* m;
+    
+    pairwiseWorkspace(pairwiseData* params, double cutoff) {
+        m = params->m;
         
-        Alignment* alignment;
         if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
         else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
         else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
@@ -355,53 +401,69 @@ int driverColumn(pairwiseData* params){
             params->m->mothurOut(params->align + " is not a valid alignment option. I will run the command using needleman.\n");
             alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);
         }
+        alignment->setBand(params->band);
         
         ValidCalculators validCalculator;
-        DistCalc* distCalculator;
+        distCalculator = NULL;
         if (params->countends) {
             if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")			{	distCalculator = new ignoreGaps(params->cutoff);	}
-                else if (params->distcalcType == "eachgap")	{	distCalculator = new eachGapDist(params->cutoff);	}
-                else if (params->distcalcType == "onegap")		{	distCalculator = new oneGapDist(params->cutoff);	}
+                if (params->distcalcType == "nogaps")			{	distCalculator = new ignoreGaps(cutoff);	}
+                else if (params->distcalcType == "eachgap")	{	distCalculator = new eachGapDist(cutoff);	}
+                else if (params->distcalcType == "onegap")		{	distCalculator = new oneGapDist(cutoff);	}
             }
         }else {
             if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")		{	distCalculator = new ignoreGaps(params->cutoff);					}
-                else if (params->distcalcType == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(params->cutoff);	}
-                else if (params->distcalcType == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(params->cutoff);		}
+                if (params->distcalcType == "nogaps")		{	distCalculator = new ignoreGaps(cutoff);					}
+                else if (params->distcalcType == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(cutoff);	}
+                else if (params->distcalcType == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
             }
         }
+    }
+    ~pairwiseWorkspace() { delete alignment; delete distCalculator; }
+    
+    double getDist(const string& nameI, const string& basesI, const string& nameJ, const string& basesJ) {
+        alignment->align(basesI, basesJ);
+        seqI.setAligned(alignment->getSeqAAln());
+        seqJ.setAligned(alignment->getSeqBAln());
+        
+        double dist = distCalculator->calcDist(seqI, seqJ);
+        
+        if (m->getDebug()) { m->mothurOut("[DEBUG]: " + nameI + '\t' +  alignment->getSeqAAln() + '\n' + nameJ + alignment->getSeqBAln() + "\n distance = " + toString(dist) + "\n"); }
+        
+        return dist;
+    }
+};
+/**************************************************************************************************/
+//column and binary output
+int driverColumn(pairwiseData* params){
+    try {
+        int startTime = time(NULL);
+        
+        pairwiseWorkspace workspace(params, params->cutoff);
+        vector<string>& names = params->seqs->names;
+        vector<string>& seqs = params->seqs->seqs;
         
         for(int i=params->start;i<params->end;i++){
             
-            Sequence seq = params->alignDB.get(i);
-            if (seq.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seq.getUnaligned().length()+1); }
-        
+            string buffer = ""; //a row's distances are written together
             for(int j=0;j<i;j++){
                 
                 if (params->m->getControl_pressed()) {  break;  }
                 
-                Sequence seqI = seq;
-                Sequence seqJ = params->alignDB.get(j);
-                if (seqJ.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seqJ.getUnaligned().length()+1); }
-                
-                alignment->align(seqI.getUnaligned(), seqJ.getUnaligned());
-                seqI.setAligned(alignment->getSeqAAln());
-                seqJ.setAligned(alignment->getSeqBAln());
+                double dist = workspace.getDist(names[i], seqs[i], names[j], seqs[j]);
                 
-                double dist = distCalculator->calcDist(seqI, seqJ);
-                
-                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + "\n distance = " + toString(dist) + "\n"); }
-                
-                if(dist <= params->cutoff){ params->count++; params->threadWriter->write(seqI.getName() + ' ' + seqJ.getName() + ' ' + toString(dist) + "\n"); }
+                if(dist <= params->cutoff){
+                    params->count++;
+                    if (params->binDist != NULL) { params->binDist->add(i, j, dist); }
+                    else { buffer += names[i] + ' ' + names[j] + ' ' + toString(dist) + "\n"; }
+                }
             }
+            if (params->binDist == NULL) { params->threadWriter->write(buffer); }
+            
             if(i % 100 == 0){ params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n"); }
         }
         params->m->mothurOutJustToScreen(toString(params->end-1) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n");
         
-        delete alignment;
-        delete distCalculator;
-        
         return 0;
     }
     catch(exception& e) {
@@ -414,63 +476,29 @@ int driverFitCalc(pairwiseData* params){
     try {
         int startTime = time(NULL);
         
-        Alignment* alignment;
-        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
-        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
-        else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
-        else if(params->align == "noalign")		{	alignment = new NoAlign();													}
-        else {
-            params->m->mothurOut(params->align + " is not a valid alignment option. I will run the command using needleman.\n");
-            alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);
-        }
-        
-        ValidCalculators validCalculator;
-        DistCalc* distCalculator;
-        if (params->countends) {
-            if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")			{	distCalculator = new ignoreGaps(params->cutoff);	}
-                else if (params->distcalcType == "eachgap")	{	distCalculator = new eachGapDist(params->cutoff);	}
-                else if (params->distcalcType == "onegap")		{	distCalculator = new oneGapDist(params->cutoff);	}
-            }
-        }else {
-            if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")		{	distCalculator = new ignoreGaps(params->cutoff);					}
-                else if (params->distcalcType == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(params->cutoff);	}
-                else if (params->distcalcType == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(params->cutoff);		}
-            }
-        }
+        pairwiseWorkspace workspace(params, params->cutoff);
+        vector<string>& oldNames = params->oldFastaSeqs->names;
+        vector<string>& oldSeqs = params->oldFastaSeqs->seqs;
+        vector<string>& names = params->seqs->names;
+        vector<string>& seqs = params->seqs->seqs;
         
         for(int i=params->start;i<params->end;i++){ //for each oldDB fasta seq calc the distance to every new seq in alignDB
             
-            Sequence seq = params->oldFastaDB.get(i);
-            if (seq.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seq.getUnaligned().length()+1); }
-            
-            for(int j = 0; j < params->alignDB.getNumSeqs(); j++){
+            string buffer = "";
+            for(int j = 0; j < seqs.size(); j++){
                 
                 if (params->m->getControl_pressed()) {  break;  }
                 
-                Sequence seqI = seq;
-                Sequence seqJ = params->alignDB.get(j);
-                if (seqJ.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seqJ.getUnaligned().length()+1); }
-                
-                alignment->align(seqI.getUnaligned(), seqJ.getUnaligned());
-                seqI.setAligned(alignment->getSeqAAln());
-                seqJ.setAligned(alignment->getSeqBAln());
-                
-                double dist = distCalculator->calcDist(seqI, seqJ);
-                
-                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + "\n distance = " + toString(dist) + "\n"); }
+                double dist = workspace.getDist(oldNames[i], oldSeqs[i], names[j], seqs[j]);
                 
-                if(dist <= params->cutoff){ params->count++; params->threadWriter->write(seqI.getName() + ' ' + seqJ.getName() + ' ' + toString(dist) + "\n"); }
+                if(dist <= params->cutoff){ params->count++; buffer += oldNames[i] + ' ' + names[j] + ' ' + toString(dist) + "\n"; }
             }
+            params->threadWriter->write(buffer);
             
             if(i % 100 == 0){ params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n"); }
         }
         params->m->mothurOutJustToScreen(toString(params->end-1) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n");
         
-        delete alignment;
-        delete distCalculator;
-        
         return 0;
     }
     catch(exception& e) {
@@ -479,71 +507,39 @@ int driverFitCalc(pairwiseData* params){
     }
 }
 /**************************************************************************************************/
-int driverLt(pairwiseData* params){
+//lt and square output, numCols is i for lt and the number of seqs for square
+int driverPhylip(pairwiseData* params, bool square){
     try {
         
         int startTime = time(NULL);
         
-        Alignment* alignment;
-        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
-        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
-        else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
-        else if(params->align == "noalign")		{	alignment = new NoAlign();													}
-        else {
-            params->m->mothurOut(params->align + " is not a valid alignment option. I will run the command using needleman.\n");
-            alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);
-        }
+        pairwiseWorkspace workspace(params, 1.0);
+        vector<string>& names = params->seqs->names;
+        vector<string>& seqs = params->seqs->seqs;
+        long long numSeqs = seqs.size();
         
-        ValidCalculators validCalculator;
-        DistCalc* distCalculator;
-        double cutoff = 1.0;
-        if (params->countends) {
-            if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")			{	distCalculator = new ignoreGaps(cutoff);	}
-                else if (params->distcalcType == "eachgap")	{	distCalculator = new eachGapDist(cutoff);	}
-                else if (params->distcalcType == "onegap")		{	distCalculator = new oneGapDist(cutoff);	}
-            }
-        }else {
-            if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")		{	distCalculator = new ignoreGaps(cutoff);					}
-                else if (params->distcalcType == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(cutoff);	}
-                else if (params->distcalcType == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
-            }
-        }
-        
-        //column file
         ofstream outFile;
         params->util.openOutputFile(params->outputFileName, outFile);
         outFile.setf(ios::fixed, ios::showpoint);
         outFile << setprecision(4);
         
-        if(params->start == 0){	outFile << params->alignDB.getNumSeqs() << endl;	}
-
+        if(params->start == 0){	outFile << numSeqs << endl;	}
         
         for(int i=params->start;i<params->end;i++){
             
-            Sequence seq = params->alignDB.get(i);
-            if (seq.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seq.getUnaligned().length()+1); }
-            
-            string name = seq.getName();
-            if (name.length() < 10) {  while (name.length() < 10) {  name += " ";  } seq.setName(name); } //pad with spaces to make compatible
+            string name = names[i];
+            if (name.length() < 10) {  while (name.length() < 10) {  name += " ";  } } //pad with spaces to make compatible
             outFile << name;
             
-            for(int j=0;j<i;j++){
+            long long numCols = i;
+            if (square) { numCols = numSeqs; }
+            
+            for(int j=0;j<numCols;j++){
                 
                 if (params->m->getControl_pressed()) { break;  }
                 
-                Sequence seqI = seq;
-                Sequence seqJ = params->alignDB.get(j);
-                if (seqJ.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seqJ.getUnaligned().length()+1); }
-                
-                alignment->align(seqI.getUnaligned(), seqJ.getUnaligned());
-                seqI.setAligned(alignment->getSeqAAln());
-                seqJ.setAligned(alignment->getSeqBAln());
-                
-                double dist = distCalculator->calcDist(seqI, seqJ);
+                double dist = workspace.getDist(name, seqs[i], names[j], seqs[j]);
                 
-                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + '\n' + "distance = " + toString(dist) + "\n"); }
                 if(dist <= params->cutoff){ params->count++; }
                 outFile << '\t' << dist;
             }
@@ -556,8 +552,6 @@ int driverLt(pairwiseData* params){
         params->m->mothurOutJustToScreen(toString(params->end-1) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n");
         
         outFile.close();
-        delete alignment;
-        delete distCalculator;
         
         return 1;
     }
@@ -567,95 +561,9 @@ int driverLt(pairwiseData* params){
     }
 }
 /**************************************************************************************************/
-int driverSquare(pairwiseData* params){
-    try {
-        
-        int startTime = time(NULL);
-        
-        Alignment* alignment;
-        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
-        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
-        else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
-        else if(params->align == "noalign")		{	alignment = new NoAlign();													}
-        else {
-            params->m->mothurOut(params->align + " is not a valid alignment option. I will run the command using needleman.\n");
-            alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);
-        }
-        
-        ValidCalculators validCalculator;
-        DistCalc* distCalculator;
-        double cutoff = 1.0;
-        if (params->countends) {
-            if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")			{	distCalculator = new ignoreGaps(cutoff);	}
-                else if (params->distcalcType == "eachgap")	{	distCalculator = new eachGapDist(cutoff);	}
-                else if (params->distcalcType == "onegap")		{	distCalculator = new oneGapDist(cutoff);	}
-            }
-        }else {
-            if (validCalculator.isValidCalculator("distance", params->distcalcType) ) {
-                if (params->distcalcType == "nogaps")		{	distCalculator = new ignoreGaps(cutoff);					}
-                else if (params->distcalcType == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(cutoff);	}
-                else if (params->distcalcType == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
-            }
-        }
-        
-        //column file
-        ofstream outFile;
-        params->util.openOutputFile(params->outputFileName, outFile);
-        outFile.setf(ios::fixed, ios::showpoint);
-        outFile << setprecision(4);
-        
-        long long numSeqs = params->alignDB.getNumSeqs();
-        if(params->start == 0){	outFile << numSeqs << endl;	}
-        
-        for(int i=params->start;i<params->end;i++){
-            
-            Sequence seq = params->alignDB.get(i);
-            if (seq.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seq.getUnaligned().length()+1); }
-            
-            string name = seq.getName();
-            if (name.length() < 10) {  while (name.length() < 10) {  name += " ";  } seq.setName(name); } //pad with spaces to make compatible
-            outFile << name;
-            
-            for(int j=0;j<numSeqs;j++){
-                
-                if (params->m->getControl_pressed()) { break;  }
-                
-                Sequence seqI = seq;
-                Sequence seqJ = params->alignDB.get(j);
-                if (seqJ.getUnaligned().length() > alignment->getnRows()) { alignment->resize(seqJ.getUnaligned().length()+1); }
-
-                alignment->align(seqI.getUnaligned(), seqJ.getUnaligned());
-                seqI.setAligned(alignment->getSeqAAln());
-                seqJ.setAligned(alignment->getSeqBAln());
-                
-                double dist = distCalculator->calcDist(seqI, seqJ);
-                
-                if(dist <= params->cutoff){ params->count++; }
-                outFile << '\t' << dist;
-                
-                if (params->m->getDebug()) { params->m->mothurOut("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + '\n' + "distance = " + toString(dist) + "\n"); }
-            }
-            
-            outFile << endl; 
-            
-            if(i % 100 == 0){ params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n");  }
-            
-        }
-        params->m->mothurOutJustToScreen(toString(params->end-1) + "\t" + toString(time(NULL) - startTime)+ "\t" + toString(params->count) +"\n"); 
-        
-        outFile.close();
-        delete alignment;
-        delete distCalculator;
-        
-        return 1;
-    }
-    catch(exception& e) {
-        params->m->errorOut(e, "PairwiseSeqsCommand", "driver");
-        exit(1);
-    }
-}
-
+int driverLt(pairwiseData* params){ return driverPhylip(params, false); }
+/**************************************************************************************************/
+int driverSquare(pairwiseData* params){ return driverPhylip(params, true); }
 /**************************************************************************************************/
 void PairwiseSeqsCommand::createProcesses(string filename) {
 	try {
@@ -684,16 +592,19 @@ void PairwiseSeqsCommand::createProcesses(string filename) {
         auto synchronizedOutputFile = std::make_shared<SynchronizedOutputFile>(filename);
         synchronizedOutputFile->setFixedShowPoint(); synchronizedOutputFile->setPrecision(4);
         
-        SequenceDB oldFastaDB;
+        //the threads share one copy of the unaligned seqs instead of each copying the SequenceDB
+        pairwiseSeqs seqs(alignDB);
+        pairwiseSeqs oldFastaSeqs;
         if (fitCalc) {
             ifstream inFASTA;
             util.openInputFile(oldfastafile, inFASTA);
-            oldFastaDB = SequenceDB(inFASTA);
+            SequenceDB oldFastaDB(inFASTA);
             inFASTA.close();
+            oldFastaSeqs = pairwiseSeqs(oldFastaDB);
             
             lines.clear();
-            if (processors > oldFastaDB.getNumSeqs()) { processors = oldFastaDB.getNumSeqs(); }
-            int remainingSeqs = oldFastaDB.getNumSeqs();
+            if (processors > oldFastaSeqs.getNumSeqs()) { processors = oldFastaSeqs.getNumSeqs(); }
+            int remainingSeqs = oldFastaSeqs.getNumSeqs();
             int startIndex = 0;
             for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
                 int numSeqsToFit = remainingSeqs; //case for last processor
@@ -703,6 +614,10 @@ void PairwiseSeqsCommand::createProcesses(string filename) {
                 remainingSeqs -= numSeqsToFit;
             }
         }
+        
+        //size the aligners for the longest seq so they are never resized
+        int longest = max(seqs.longest, oldFastaSeqs.longest) + 1;
+        if (longest > longestBase) { longestBase = longest; }
 
         //Lauch worker threads
         for (int i = 0; i < processors-1; i++) {
@@ -714,11 +629,13 @@ void PairwiseSeqsCommand::createProcesses(string filename) {
                 dataBundle = new pairwiseData(threadWriter);
             }else { dataBundle = new pairwiseData(filename+extension); }
             
-            dataBundle->setVariables(align, Estimators[0], countends, output, alignDB, oldFastaDB, lines[i+1].start, lines[i+1].end, match, misMatch, gapOpen, gapExtend, longestBase, cutoff);
+            dataBundle->setVariables(align, Estimators[0], countends, output, &seqs, &oldFastaSeqs, lines[i+1].start, lines[i+1].end, match, misMatch, gapOpen, gapExtend, longestBase, cutoff, band);
+            if (output == "binary") { dataBundle->binDist = new BinaryDistFile(); dataBundle->binDist->setRunFile(filename + toString(i+1) + ".run"); }
             data.push_back(dataBundle);
             
             std::thread* thisThread = NULL;
-            if (output == "column")     {
+            if (output == "binary")     { thisThread = new std::thread(driverColumn, dataBundle);    }
+            else if (output == "column")     {
                 if (fitCalc)    { thisThread = new std::thread(driverFitCalc, dataBundle);   }
                 else            {  thisThread = new std::thread(driverColumn, dataBundle);   }
             }
@@ -734,9 +651,11 @@ void PairwiseSeqsCommand::createProcesses(string filename) {
             dataBundle = new pairwiseData(threadWriter);
         }else { dataBundle = new pairwiseData(filename); }
         
-        dataBundle->setVariables(align, Estimators[0], countends, output, alignDB, oldFastaDB, lines[0].start, lines[0].end, match, misMatch, gapOpen, gapExtend, longestBase, cutoff);
+        dataBundle->setVariables(align, Estimators[0], countends, output, &seqs, &oldFastaSeqs, lines[0].start, lines[0].end, match, misMatch, gapOpen, gapExtend, longestBase, cutoff, band);
+        if (output == "binary") { dataBundle->binDist = new BinaryDistFile(); dataBundle->binDist->setRunFile(filename + ".run"); }
     
-        if (output == "column")     {
+        if (output == "binary")     { driverColumn(dataBundle);     }
+        else if (output == "column")     {
             if (fitCalc)    { driverFitCalc(dataBundle);    }
             else            { driverColumn(dataBundle);     }
             delete threadWriter;
@@ -750,6 +669,7 @@ void PairwiseSeqsCommand::createProcesses(string filename) {
             
             numDistsBelowCutoff += data[i]->count;
             if (output == "column") {  delete data[i]->threadWriter; }
+            else if (output == "binary") { dataBundle->binDist->append(*data[i]->binDist); delete data[i]->binDist; }
             else {
                 string extension = toString(i+1) + ".temp";
                 util.appendFiles((filename+extension), filename);
@@ -758,6 +678,14 @@ void PairwiseSeqsCommand::createProcesses(string filename) {
             delete data[i];
             delete workerThreads[i];
         }
+        
+        if (output == "binary") {
+            synchronizedOutputFile->close();
+            
+            dataBundle->binDist->setNames(seqs.names);
+            if (!m->getControl_pressed()) { dataBundle->binDist->write(filename); }
+            delete dataBundle->binDist;
+        }
         delete dataBundle;
 	}
 	catch(exception& e) {
@@ -29,6 +29,7 @@
 #include "eachgapignore.h"
 #include "onegapdist.h"
 #include "onegapignore.h"
+#include "binarydistfile.hpp"
 #include "writer.h"
 
 class PairwiseSeqsCommand : public Command {
@@ -57,7 +58,7 @@ private:
     
 	string fastaFileName, align, calc,  output, oldfastafile, column;
 	float match, misMatch, gapOpen, gapExtend, cutoff;
-	int processors, longestBase, numDistsBelowCutoff;
+	int processors, longestBase, numDistsBelowCutoff, band;
 	vector<string> Estimators, outputNames;
 	
 	bool abort, countends, compress, fitCalc;
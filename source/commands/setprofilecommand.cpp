@@ -0,0 +1,103 @@
+//
+//  setprofilecommand.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "setprofilecommand.h"
+
+//**********************************************************************************************************************
+vector<string> SetProfileCommand::setParameters(){
+    try {
+        CommandParameter pprofile("profile", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pprofile);
+        CommandParameter pformat("format", "Multiple", "tsv-json", "tsv", "", "", "","",false,false); parameters.push_back(pformat);
+        CommandParameter pname("name", "String", "", "", "", "", "","",false,false); parameters.push_back(pname);
+        CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
+        CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
+        
+        abort = false; calledHelp = false;
+        
+        vector<string> myArray;
+        for (int i = 0; i < parameters.size(); i++) {	myArray.push_back(parameters[i].name);		}
+        return myArray;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "setParameters");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+string SetProfileCommand::getHelpString(){
+    try {
+        string helpString = "";
+        helpString += "The set.profile command times the stages of the commands run after it, such as reading, searching, aligning and writing, and records the number of items processed, the bytes read and written and the peak RAM used by each stage.\n";
+        helpString += "The set.profile command parameters are profile, format and name.\n";
+        helpString += "The profile parameter allows you to turn profiling on or off. Default=T.\n";
+        helpString += "The format parameter allows you to choose the format of the profile file. Options are tsv, a row for each stage of each command, and json, a line for each command. Default=tsv.\n";
+        helpString += "The name parameter allows you to name the profile file. Default=mothur.profile.tsv or mothur.profile.json.\n";
+        helpString += "The profile file is started over by each set.profile command.\n";
+        helpString += "Example set.profile(format=json).\n";
+        return helpString;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "getHelpString");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+
+SetProfileCommand::SetProfileCommand(string option)  {
+    try {
+        if(option == "help") { help(); abort = true; calledHelp = true; }
+        else if(option == "citation") { citation(); abort = true; calledHelp = true;}
+        else if(option == "category") {  abort = true; calledHelp = true;  }
+        
+        else {
+            OptionParser parser(option, setParameters());
+            map<string, string> parameters = parser.getParameters();
+            
+            ValidParameters validParameter;
+            
+            string temp = validParameter.valid(parameters, "profile");		if (temp == "not found") {  temp = "T";  }
+            profile = util.isTrue(temp);
+            
+            format = validParameter.valid(parameters, "format");		if (format == "not found") { format = "tsv"; }
+            if ((format != "tsv") && (format != "json")) { m->mothurOut("[ERROR]: " + format + " is not a valid format, options are tsv and json.\n"); abort = true; }
+            
+            name = validParameter.valid(parameters, "name");		if (name == "not found") { name = "mothur.profile." + format; }
+            
+            if (util.hasPath(name) != "") { outputdir = ""; }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "SetProfileCommand");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+
+int SetProfileCommand::execute(){
+    try {
+        
+        if (abort) { if (calledHelp) { return 0; }  return 2;	}
+        
+        Profiler* profiler = Profiler::getInstance();
+        
+        if (!profile) {
+            profiler->setProfile("", format);
+            m->mothurOut("Profiling is off.\n\n");
+        }else {
+            profiler->setProfile(outputdir + name, format);
+            m->mothurOut("Profiling the commands that follow in " + profiler->getProfileFile() + ".\n\n");
+        }
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "execute");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************/
@@ -0,0 +1,43 @@
+//
+//  setprofilecommand.h
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef setprofilecommand_h
+#define setprofilecommand_h
+
+#include "command.hpp"
+#include "profiler.hpp"
+
+/**********************************************************/
+
+class SetProfileCommand : public Command {
+    
+public:
+    SetProfileCommand(string);
+    ~SetProfileCommand(){}
+    
+    vector<string> setParameters();
+    string getCommandName()			{ return "set.profile";		}
+    string getCommandCategory()		{ return "General";		}
+    
+    string getHelpString();
+    string getOutputPattern(string){ return ""; }
+    string getCitation() { return "http://www.mothur.org/wiki/Set.profile"; }
+    string getDescription()		{ return "time the stages of the commands that follow"; }
+    
+    int execute();
+    void help() { m->mothurOut(getHelpString()); }
+    
+private:
+    bool abort, profile;
+    string name, format;
+    vector<string> outputNames;
+};
+
+/**********************************************************/
+
+#endif /* setprofilecommand_h */
@@ -15,17 +15,15 @@
 
 /**************************************************************************************************/
 
-Alignment::Alignment() {	m = MothurOut::getInstance();  /*	do nothing	*/	}
+Alignment::Alignment() {	m = MothurOut::getInstance(); nRows = 0; nCols = 0; bandWidth = 0; banded = false; striped = NULL; stripeSegments = 0;	}
 
 /**************************************************************************************************/
 
 Alignment::Alignment(int A) : nCols(A), nRows(A) {
 	try {
 		m = MothurOut::getInstance();
-		alignment.resize(nRows);			//	For the Gotoh and Needleman-Wunsch we initialize the dynamic programming
-		for(int i=0;i<nRows;i++){			//	matrix by initializing a matrix that is A x A.  By default we will set A
-			alignment[i].resize(nCols);		//	at 2000 for 16S rRNA gene sequences
-		}	
+		bandWidth = 0; banded = false; striped = NULL; stripeSegments = 0;	//	For the Gotoh and Needleman-Wunsch the traceback is sized for the sequences
+										//	being aligned, A is the longest sequence we expect - 2000 for 16S rRNA genes
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Alignment", "Alignment");
@@ -37,10 +35,7 @@ Alignment::Alignment(int A) : nCols(A), nRows(A) {
 Alignment::Alignment(int A, int nk) : nCols(A), nRows(A) {
     try {
         m = MothurOut::getInstance();
-        alignment.resize(nRows);			//	For the Gotoh and Needleman-Wunsch we initialize the dynamic programming
-        for(int i=0;i<nRows;i++){			//	matrix by initializing a matrix that is A x A.  By default we will set A
-            alignment[i].resize(nCols);		//	at 2000 for 16S rRNA gene sequences
-        }
+        bandWidth = 0; banded = false; striped = NULL; stripeSegments = 0;
     }
     catch(exception& e) {
         m->errorOut(e, "Alignment", "Alignment");
@@ -52,11 +47,6 @@ void Alignment::resize(int A) {
 	try {
 		nCols = A;
 		nRows = A;
-
-		alignment.resize(nRows);			
-		for(int i=0;i<nRows;i++){			
-			alignment[i].resize(nCols);		
-		}	
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Alignment", "resize");
@@ -64,49 +54,161 @@ void Alignment::resize(int A) {
 	}
 }
 /**************************************************************************************************/
+//finds the diagonal seqA and seqB share the most 8mers on. If there is one and the band is narrower than seqA, only
+//the cells within bandWidth of it are filled
+void Alignment::setBand(){
+	try {
+		banded = false; bandDiagonal = 0; stripeSegments = 0;
+		
+		int kmerSize = 8;
+		if ((bandWidth > 0) && ((2*bandWidth+1) < (lA-1)) && (lA > kmerSize) && (lB > kmerSize)) {
+			int maxKmer = 1 << (2*kmerSize);
+			if (kmerPositions.size() == 0) { kmerPositions.assign(maxKmer, -1); }
+			
+			//first position of each kmer in seqB
+			vector<int> seen;
+			int kmer = 0; int numBases = 0;
+			for (int i = 1; i < lB; i++) {
+				int base = -1;
+				switch (toupper(seqB[i])) { case 'A': base = 0; break; case 'C': base = 1; break; case 'G': base = 2; break; case 'T': base = 3; break; case 'U': base = 3; break; default: break; }
+				if (base == -1) { numBases = 0; kmer = 0; continue; }
+				kmer = ((kmer << 2) | base) & (maxKmer-1); numBases++;
+				if ((numBases >= kmerSize) && (kmerPositions[kmer] == -1)) { kmerPositions[kmer] = i; seen.push_back(kmer); }
+			}
+			
+			//count the diagonals seqA's kmers are found on
+			vector<int> diagonalCounts(lA+lB, 0);
+			int bestCount = 0;
+			kmer = 0; numBases = 0;
+			for (int j = 1; j < lA; j++) {
+				int base = -1;
+				switch (toupper(seqA[j])) { case 'A': base = 0; break; case 'C': base = 1; break; case 'G': base = 2; break; case 'T': base = 3; break; case 'U': base = 3; break; default: break; }
+				if (base == -1) { numBases = 0; kmer = 0; continue; }
+				kmer = ((kmer << 2) | base) & (maxKmer-1); numBases++;
+				if ((numBases >= kmerSize) && (kmerPositions[kmer] != -1)) {
+					int diagonal = j - kmerPositions[kmer];
+					diagonalCounts[diagonal+lB]++;
+					if (diagonalCounts[diagonal+lB] > bestCount) { bestCount = diagonalCounts[diagonal+lB]; bandDiagonal = diagonal; }
+				}
+			}
+			
+			for (int i = 0; i < seen.size(); i++) { kmerPositions[seen[i]] = -1; }
+			
+			if (bestCount != 0) { banded = true; }
+		}
+		
+		long long numCells = (long long)lA * lB;
+		if (banded) { numCells = (long long)lB * (2*bandWidth+1); }
+		if (directions.size() < numCells) { directions.resize(numCells); }
+		
+		if (currentRow.size() < lA) { currentRow.resize(lA); }
+		previousRow.assign(lA, 0); //the first row
+		currentRow[0] = 0;
+		
+		lastColumn.assign(lB, OUTSIDE_BAND); lastColumn[0] = 0;
+		if (lA == 1) { lastColumn.assign(lB, 0); }
+		lastRow.assign(lA, OUTSIDE_BAND); lastRow[0] = 0;
+		if (lB == 1) { lastRow.assign(lA, 0); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Alignment", "setBand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//fills directions, lastColumn and lastRow the way the child's scalar loop would, after setBand
+bool Alignment::fillStriped(){
+	try {
+		stripeSegments = 0;
+		if (banded || (striped == NULL)) { return false; }
+		
+		if (!striped->fill(seqA, seqB, directions, lastColumn, lastRow)) { return false; }
+		
+		stripeSegments = striped->getNumSegments(); stripeLanes = striped->getNumLanes();
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Alignment", "fillStriped");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the first and last columns of a row that are filled, first > last if none are
+void Alignment::getRowRange(int row, int& first, int& last){
+	first = 1; last = lA-1;
+	if (banded) {
+		if ((row + bandDiagonal - bandWidth) > first)	{	first = row + bandDiagonal - bandWidth;	}
+		if ((row + bandDiagonal + bandWidth) < last)	{	last = row + bandDiagonal + bandWidth;	}
+	}
+}
+/**************************************************************************************************/
+//the first row points left and the first column points up, cells that weren't filled are 'x'
+char Alignment::getDirection(int row, int column){
+	if (row == 0)		{	if (column == 0) { return 'x'; } return 'l';	}
+	if (column == 0)	{	return 'u';	}
+	if (banded) {
+		int offset = column - row - bandDiagonal;
+		if ((offset < -bandWidth) || (offset > bandWidth)) { return 'x'; }
+	}
+	if (stripeSegments != 0) {	//	column j of a striped row is in lane (j-1) / stripeSegments of vector (j-1) % stripeSegments
+		int t = column - 1;
+		return directions[(long long)row * stripeSegments * stripeLanes + (t % stripeSegments) * stripeLanes + (t / stripeSegments)];
+	}
+	return directions[getRowStart(row) + column];
+}
+/**************************************************************************************************/
 
 void Alignment::traceBack(bool createBaseMap){			//	This traceback routine is used by the dynamic programming algorithms
 	try {	
 		BBaseMap.clear();
         ABaseMap.clear(); //	to fill the values of seqAaln and seqBaln
-		seqAaln = "";
+		seqAaln = "";							//	the alignment is built from the end and reversed
 		seqBaln = "";
 		int row = lB-1;
 		int column = lA-1;
 		//	seqAstart = 1;
 		//	seqAend = column;
 		
-		AlignmentCell currentCell = alignment[row][column];	//	Start the traceback from the bottom-right corner of the
-		//	matrix
+		//	Start the traceback from the bottom-right corner of the matrix. The Overlap class moved the end of the
+		//	alignment to endRow or endColumn, so the cells below it in the right column point up and the cells right of
+		//	it in the bottom row point left
+		char currentCell = getDirection(row, column);
+		if (row > endRow) { currentCell = 'u'; } else if (column > endColumn) { currentCell = 'l'; }
 		
-		if(currentCell.prevCell == 'x'){	seqAaln = seqBaln = "NOALIGNMENT";		}//If there's an 'x' in the bottom-
+		if(currentCell == 'x'){	seqAaln = seqBaln = "NOALIGNMENT";		}//If there's an 'x' in the bottom-
 		else{	//	right corner bail out because it means nothing got aligned
             int count = 0;
-			while(currentCell.prevCell != 'x'){				//	while the previous cell isn't an 'x', keep going...
+			while(currentCell != 'x'){				//	while the previous cell isn't an 'x', keep going...
 				
-				if(currentCell.prevCell == 'u'){			//	if the pointer to the previous cell is 'u', go up in the
-					seqAaln = '-' + seqAaln;				//	matrix.  this indicates that we need to insert a gap in
-					seqBaln = seqB[row] + seqBaln;			//	seqA and a base in seqB
+				if(currentCell == 'u'){				//	if the pointer to the previous cell is 'u', go up in the
+					seqAaln += '-';					//	matrix.  this indicates that we need to insert a gap in
+					seqBaln += seqB[row];			//	seqA and a base in seqB
                     if (createBaseMap) { BBaseMap[row] = count; }
-					currentCell = alignment[--row][column];
+					row--;
 				}
-				else if(currentCell.prevCell == 'l'){		//	if the pointer to the previous cell is 'l', go to the left
-					seqBaln = '-' + seqBaln;				//	in the matrix.  this indicates that we need to insert a gap
-					seqAaln = seqA[column] + seqAaln;		//	in seqB and a base in seqA
+				else if(currentCell == 'l'){		//	if the pointer to the previous cell is 'l', go to the left
+					seqBaln += '-';					//	in the matrix.  this indicates that we need to insert a gap
+					seqAaln += seqA[column];		//	in seqB and a base in seqA
                     if (createBaseMap) { ABaseMap[column] = count; }
-					currentCell = alignment[row][--column];
+					column--;
 				}
 				else{
-					seqAaln = seqA[column] + seqAaln;		//	otherwise we need to go diagonally up and to the left,
-					seqBaln = seqB[row] + seqBaln;			//	here we add a base to both alignments
+					seqAaln += seqA[column];		//	otherwise we need to go diagonally up and to the left,
+					seqBaln += seqB[row];			//	here we add a base to both alignments
                     if (createBaseMap) {
                         BBaseMap[row] = count;
                         ABaseMap[column] = count;
                     }
-					currentCell = alignment[--row][--column];
+					row--; column--;
 				}
                 count++;
+				
+				if ((column == lA-1) && (row > endRow))			{	currentCell = 'u';	}
+				else if ((row == lB-1) && (column > endColumn))	{	currentCell = 'l';	}
+				else											{	currentCell = getDirection(row, column);	}
 			}
+			reverse(seqAaln.begin(), seqAaln.end());
+			reverse(seqBaln.begin(), seqBaln.end());
 		}
 		
        
@@ -155,18 +257,7 @@ void Alignment::traceBack(bool createBaseMap){			//	This traceback routine is us
 }
 /**************************************************************************************************/
 
-Alignment::~Alignment(){
-	try {
-		for (int i = 0; i < alignment.size(); i++) {
-			for (int j = (alignment[i].size()-1); j >= 0; j--) {  alignment[i].pop_back();  }
-		}
-        alignment.clear();
-	}
-	catch(exception& e) {
-		m->errorOut(e, "Alignment", "~Alignment");
-		exit(1);
-	}
-}
+Alignment::~Alignment(){	if (striped != NULL) { delete striped; }	}
 
 /**************************************************************************************************/
 
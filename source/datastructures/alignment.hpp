@@ -10,12 +10,23 @@
  *
  *  This is a class for an abstract datatype for classes that implement various types of alignment	algorithms.
  *	As of 12/18/08 these included alignments based on blastn, needleman-wunsch, and the	Gotoh algorithms
+ *
+ *	The dynamic programming algorithms only keep two rows of scores and one byte per cell for the traceback, plus the
+ *	scores of the last row and column for the Overlap class. With setBand the cells filled are limited to a band around
+ *	the diagonal the two sequences share the most kmers on, which is how the template found by the kmer search lines
+ *	up with the candidate. The band uses memory and time proportional to the sequence length times the band width, so
+ *	long reads can be aligned. If the best alignment leaves the band it isn't found, the default band of 0 fills the
+ *	whole matrix. Without a band the Needleman-Wunsch and Gotoh fills are done several cells at a time by the
+ *	StripedAlignment class when its scores fit, with the same result.
  * 
  */
 
 #include "mothur.h"
 #include "alignmentcell.hpp"
 #include "currentfile.h"
+#include "stripedalignment.hpp"
+
+#define OUTSIDE_BAND -1.0e30 //score of cells that aren't filled, low enough that no alignment goes through them
 
 /**************************************************************************************************/
 
@@ -41,16 +52,30 @@ public:
 	int getPairwiseLength();
 	void resize(int);
 	int getnRows() { return nRows; }
+	void setBand(int w) { bandWidth = w; } //cells more than w from the shared diagonal are not filled, 0 fills them all
 
 protected:
 	void traceBack(bool createBaseMap);
+	void setBand(); //decides whether to band seqA and seqB and sizes the traceback for them
+	bool fillStriped(); //fills the matrix with striped, returns false if the scalar loop has to
+	void getRowRange(int, int&, int&); //row, first column, last column filled
+	long long getRowStart(int row) { if (banded) { return (long long)row * (2*bandWidth+1) - (row + bandDiagonal - bandWidth); } return (long long)row * lA; } //directions[getRowStart(i)+j] is cell i,j
+	char getDirection(int, int);
 	string seqA, seqAaln;
 	string seqB, seqBaln;
 	int seqAstart, seqAend;
 	int seqBstart, seqBend;
 	int pairwiseLength;
 	int nRows, nCols, lA, lB;
-	vector<vector<AlignmentCell> > alignment;
+	vector<unsigned char> directions; //'d', 'u' or 'l' for each cell filled, row by row
+	vector<float> previousRow, currentRow; //scores
+	vector<float> lastRow, lastColumn; //scores of the bottom row and right column, for the Overlap class
+	int endRow, endColumn; //where the traceback leaves the right column or bottom row, set by the Overlap class
+	int bandWidth, bandDiagonal; //in the band column - row is within bandWidth of bandDiagonal
+	bool banded;
+	StripedAlignment* striped; //set by the child classes that can use it
+	int stripeSegments, stripeLanes; //non zero if directions is in striped order
+	vector<int> kmerPositions;
     map<int, int> ABaseMap;
     map<int, int> BBaseMap;
 	MothurOut* m;
@@ -50,6 +50,7 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
         fastaFile.close();
         
         numSeqs = (int)templateSequences.size();
+        alignmentLength = tempLength;
         //all of this is elsewhere already!
         
         m->mothurOut("DONE.\n");
@@ -125,6 +126,7 @@ AlignmentDB::AlignmentDB(string s){
 	try {											
 		m = MothurOut::getInstance();
 		method = s;
+		numSeqs = 0; longest = 0; alignmentLength = 0;
 		
 		if(method == "suffix")		{	search = new SuffixDB();	}
 		else if(method == "blast")	{	search = new BlastDB("", 0);		}
@@ -147,17 +149,42 @@ AlignmentDB::AlignmentDB(string s){
 AlignmentDB::~AlignmentDB() {  delete search;	}
 /**************************************************************************************************/
 Sequence AlignmentDB::findClosestSequence(Sequence* seq, float& searchScore) const {
+	try{
+        
+		return getTemplate(findClosestSequenceIndex(seq, searchScore));
+		
+	}
+	catch(exception& e) {
+		m->errorOut(e, "AlignmentDB", "findClosestSequence");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+int AlignmentDB::findClosestSequenceIndex(Sequence* seq, float& searchScore) const {
 	try{
         
         vector<float> scores;
 		vector<int> spot = search->findClosestSequences(seq, 1, scores);
 	
-        if (spot.size() != 0)	{	searchScore = scores[0]; return templateSequences[spot[0]];	}
-        else					{ 	searchScore = 0; return emptySequence;                      }
+        if (spot.size() != 0)	{	searchScore = scores[0]; return spot[0];	}
+        else					{ 	searchScore = 0; return -1;                 }
 		
 	}
 	catch(exception& e) {
-		m->errorOut(e, "AlignmentDB", "findClosestSequence");
+		m->errorOut(e, "AlignmentDB", "findClosestSequenceIndex");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+Sequence AlignmentDB::getTemplate(int index) const {
+	try{
+        
+        if (index == -1)	{	return emptySequence;				}
+        else				{	return templateSequences[index];	}
+		
+	}
+	catch(exception& e) {
+		m->errorOut(e, "AlignmentDB", "getTemplate");
 		exit(1);
 	}
 }
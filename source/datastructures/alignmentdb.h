@@ -27,10 +27,13 @@ public:
 	~AlignmentDB();
 	
 	Sequence findClosestSequence(Sequence*, float&) const; //sequence to align, searchScore
+	int findClosestSequenceIndex(Sequence*, float&) const; //sequence to align, searchScore - returns -1 if nothing matches
+	Sequence getTemplate(int) const; //template index, the no_match sequence for -1
 	int getLongestBase()	{  return longest;  }
+	int getAlignmentLength()	{  return alignmentLength;  }
 	
 private:
-	int numSeqs, longest, threadID;
+	int numSeqs, longest, threadID, alignmentLength;
 	string method;
 	
 	Database* search;
@@ -0,0 +1,627 @@
+//
+//  binarydistfile.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "binarydistfile.hpp"
+
+/**************************************************************************************************/
+BinaryDistFile::BinaryDistFile() {
+    m = MothurOut::getInstance();
+    finalized = true; nextRow = 0; nextDist = 0;
+    runFile = ""; runSize = BINARYDIST_RUN_SIZE;
+    rowStarts.push_back(0);
+}
+/**************************************************************************************************/
+BinaryDistFile::~BinaryDistFile() {
+    for (int i = 0; i < runs.size(); i++) { util.mothurRemove(runs[i]); }
+}
+/**************************************************************************************************/
+bool BinaryDistFile::isBinary(string filename) {
+    try {
+        Utils util;
+        ifstream in(util.getFullPathName(filename).c_str(), ios::binary);
+        if (!in) { return false; }
+
+        char magic[8];
+        in.read(magic, 8);
+        if (!in) { return false; }
+
+        return (strncmp(magic, BINARYDIST_MAGIC, 8) == 0);
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "BinaryDistFile", "isBinary");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void BinaryDistFile::add(unsigned int row, unsigned int col, float dist) {
+    try {
+        if (row == col) { return; }
+        if (row < col) { pending.push_back(BinaryDistCell(col, row, dist)); }
+        else { pending.push_back(BinaryDistCell(row, col, dist)); }
+        finalized = false;
+        
+        if ((runFile != "") && (pending.size() >= runSize)) { spillRun(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "add");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void BinaryDistFile::append(BinaryDistFile& other) {
+    try {
+        if (pending.size() == 0) { pending.swap(other.pending); }
+        else { pending.insert(pending.end(), other.pending.begin(), other.pending.end()); }
+        other.pending.clear();
+        runs.insert(runs.end(), other.runs.begin(), other.runs.end());
+        other.runs.clear();
+        finalized = false;
+        
+        if ((runFile != "") && (pending.size() >= runSize)) { spillRun(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "append");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void BinaryDistFile::finalize() {
+    try {
+        if (finalized) { return; }
+        if (runs.size() != 0) { m->mothurOut("[ERROR]: the distances were spilled to disk, they can only be written, quitting.\n"); m->setControl_pressed(true); return; }
+
+        long long numSeqs = names.size();
+
+        //put the distances already in rows back with the new ones
+        for (long long i = 0; i < (rowStarts.size()-1); i++) {
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) { pending.push_back(BinaryDistCell(i, cols[k], dists[k])); }
+        }
+
+        //count the distances in each row
+        rowStarts.assign(numSeqs+1, 0);
+        for (long long k = 0; k < pending.size(); k++) {
+            if (pending[k].row >= numSeqs) { m->mothurOut("[ERROR]: distance for sequence " + toString(pending[k].row) + ", but there are only " + toString(numSeqs) + " names, quitting.\n"); m->setControl_pressed(true); pending.clear(); break; }
+            rowStarts[pending[k].row+1]++;
+        }
+        for (long long i = 0; i < numSeqs; i++) { rowStarts[i+1] += rowStarts[i]; }
+
+        vector<pair<unsigned int, float> > cells(pending.size());
+        vector<unsigned long long> next(rowStarts.begin(), rowStarts.end()-1);
+        for (long long k = 0; k < pending.size(); k++) {
+            cells[next[pending[k].row]] = pair<unsigned int, float>(pending[k].col, pending[k].dist);
+            next[pending[k].row]++;
+        }
+        pending.clear(); vector<BinaryDistCell>().swap(pending);
+
+        //sort each row by column and drop repeated pairs, square column files have every pair twice
+        cols.clear(); dists.clear();
+        cols.reserve(cells.size()); dists.reserve(cells.size());
+        unsigned long long rowStart = 0;
+        for (long long i = 0; i < numSeqs; i++) {
+            stable_sort(cells.begin()+rowStarts[i], cells.begin()+rowStarts[i+1], [](const pair<unsigned int, float>& a, const pair<unsigned int, float>& b) { return a.first < b.first; });
+
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) {
+                if ((k != rowStarts[i]) && (cells[k].first == cells[k-1].first)) { continue; }
+                cols.push_back(cells[k].first);
+                dists.push_back(cells[k].second);
+            }
+            rowStarts[i] = rowStart;
+            rowStart = cols.size();
+        }
+        rowStarts[numSeqs] = rowStart;
+
+        finalized = true; nextRow = 0; nextDist = 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "finalize");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool BinaryDistFile::getNext(string& nameA, string& nameB, float& dist) {
+    try {
+        if (!finalized) { finalize(); }
+        if (nextDist >= cols.size()) { return false; }
+
+        while (rowStarts[nextRow+1] <= nextDist) { nextRow++; }
+
+        nameA = names[nextRow];
+        nameB = names[cols[nextDist]];
+        dist = dists[nextDist];
+        nextDist++;
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "getNext");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool BinaryDistFile::write(string filename, int precision) {
+    try {
+        if ((precision != 32) && (precision != 16)) { m->mothurOut("[ERROR]: " + toString(precision) + " is not a valid precision for a binary distance file, options are 32 and 16.\n"); return false; }
+
+        if (runs.size() != 0) { return writeRuns(filename, precision); }
+
+        finalize();
+
+        ofstream out;
+        if (!util.openOutputFileBinary(filename, out)) { return false; }
+
+        unsigned long long numDists = cols.size();
+        writeHeader(out, precision);
+        if (numDists != 0) { out.write((char*)&cols[0], numDists * sizeof(unsigned int)); }
+
+        unsigned long long distBytes = 0;
+        if (precision == 32) {
+            if (numDists != 0) { out.write((char*)&dists[0], numDists * sizeof(float)); }
+            distBytes = numDists * sizeof(float);
+        }else {
+            vector<unsigned short> halfs(numDists);
+            for (unsigned long long k = 0; k < numDists; k++) { halfs[k] = floatToHalf(dists[k]); }
+            if (numDists != 0) { out.write((char*)&halfs[0], numDists * sizeof(unsigned short)); }
+            distBytes = numDists * sizeof(unsigned short);
+        }
+
+        //pad to 8 bytes
+        unsigned long long used = (numDists * sizeof(unsigned int)) + distBytes;
+        while ((used % 8) != 0) { out.put('\0'); used++; }
+
+        bool good = out.good();
+        out.close();
+
+        if (!good) { m->mothurOut("[ERROR]: unable to write " + filename + ".\n"); }
+
+        return good;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "write");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//header, names and rowStarts, the number of distances is rowStarts[numSeqs]
+void BinaryDistFile::writeHeader(ofstream& out, int precision) {
+    try {
+        string nameTable = "";
+        for (long long i = 0; i < names.size(); i++) { nameTable += names[i] + '\n'; }
+        unsigned long long nameBytes = nameTable.length();
+        while ((nameTable.length() % 8) != 0) { nameTable += '\0'; }
+
+        unsigned int version = BINARYDIST_VERSION;
+        unsigned int bits = precision;
+        unsigned long long numSeqs = names.size();
+        unsigned long long numDists = rowStarts[rowStarts.size()-1];
+
+        out.write(BINARYDIST_MAGIC, 8);
+        out.write((char*)&version, sizeof(unsigned int));
+        out.write((char*)&bits, sizeof(unsigned int));
+        out.write((char*)&numSeqs, sizeof(unsigned long long));
+        out.write((char*)&numDists, sizeof(unsigned long long));
+        out.write((char*)&nameBytes, sizeof(unsigned long long));
+        out.write(nameTable.c_str(), nameTable.length());
+        out.write((char*)&rowStarts[0], rowStarts.size() * sizeof(unsigned long long));
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "writeHeader");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//sorts the pending distances by row and column and writes them to the next run file
+void BinaryDistFile::spillRun() {
+    try {
+        if (pending.size() == 0) { return; }
+
+        stable_sort(pending.begin(), pending.end(), [](const BinaryDistCell& a, const BinaryDistCell& b) { return (a.row < b.row) || ((a.row == b.row) && (a.col < b.col)); });
+
+        string runName = runFile + toString(runs.size()) + ".temp";
+        ofstream out;
+        if (!util.openOutputFileBinary(runName, out)) { m->setControl_pressed(true); return; }
+        runs.push_back(runName);
+
+        out.write((char*)&pending[0], pending.size() * sizeof(BinaryDistCell));
+        if (!out.good()) { m->mothurOut("[ERROR]: unable to write " + runName + ", quitting.\n"); m->setControl_pressed(true); }
+        out.close();
+
+        pending.clear();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "spillRun");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+struct BinaryDistRun {
+    ifstream in;
+    vector<BinaryDistCell> buffer;
+    unsigned long long pos;
+
+    BinaryDistRun() : pos(0) {}
+
+    bool next(BinaryDistCell& cell) {
+        if (pos == buffer.size()) {
+            buffer.resize(8192); pos = 0;
+            in.read((char*)&buffer[0], buffer.size() * sizeof(BinaryDistCell));
+            buffer.resize(in.gcount() / sizeof(BinaryDistCell));
+            if (buffer.size() == 0) { return false; }
+        }
+        cell = buffer[pos]; pos++;
+        return true;
+    }
+};
+/**************************************************************************************************/
+//merges the sorted runs in row order, dropping repeated pairs like finalize. With no outputs, counts the distances in
+//each row into rowStarts[row+1], otherwise writes the columns to colOut and the distances to distOut.
+bool BinaryDistFile::mergeRuns(ofstream* colOut, ofstream* distOut, int precision) {
+    try {
+        unsigned long long numSeqs = names.size();
+
+        vector<BinaryDistRun*> readers(runs.size(), NULL);
+        vector<BinaryDistCell> heads(runs.size());
+        priority_queue<pair<unsigned long long, int>, vector<pair<unsigned long long, int> >, greater<pair<unsigned long long, int> > > heap;
+
+        for (int i = 0; i < runs.size(); i++) {
+            readers[i] = new BinaryDistRun();
+            readers[i]->in.open(util.getFullPathName(runs[i]).c_str(), ios::binary);
+            if (!readers[i]->in) { m->mothurOut("[ERROR]: Could not open " + runs[i] + "\n"); m->setControl_pressed(true); }
+            else if (readers[i]->next(heads[i])) { heap.push(pair<unsigned long long, int>((((unsigned long long)heads[i].row) << 32) | heads[i].col, i)); }
+        }
+
+        bool good = !m->getControl_pressed();
+        bool first = true; unsigned long long lastKey = 0;
+        while (good && !heap.empty()) {
+            unsigned long long key = heap.top().first;
+            int run = heap.top().second;
+            heap.pop();
+
+            BinaryDistCell cell = heads[run];
+            if (readers[run]->next(heads[run])) { heap.push(pair<unsigned long long, int>((((unsigned long long)heads[run].row) << 32) | heads[run].col, run)); }
+
+            if (!first && (key == lastKey)) { continue; } //square column files have every pair twice
+            first = false; lastKey = key;
+
+            if (cell.row >= numSeqs) { m->mothurOut("[ERROR]: distance for sequence " + toString(cell.row) + ", but there are only " + toString(numSeqs) + " names, quitting.\n"); m->setControl_pressed(true); good = false; break; }
+
+            if (colOut == NULL) { rowStarts[cell.row+1]++; }
+            else {
+                colOut->write((char*)&cell.col, sizeof(unsigned int));
+                if (precision == 32) { distOut->write((char*)&cell.dist, sizeof(float)); }
+                else { unsigned short half = floatToHalf(cell.dist); distOut->write((char*)&half, sizeof(unsigned short)); }
+            }
+
+            if (m->getControl_pressed()) { good = false; }
+        }
+
+        for (int i = 0; i < readers.size(); i++) { readers[i]->in.close(); delete readers[i]; }
+
+        return good;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "mergeRuns");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//counts the rows with a first merge, then writes the columns to the file and the distances to a temp file that is
+//appended to it, so only the row starts are held in memory
+bool BinaryDistFile::writeRuns(string filename, int precision) {
+    try {
+        if (runFile == "") { runFile = filename + ".run"; }
+        spillRun();
+
+        long long numSeqs = names.size();
+        rowStarts.assign(numSeqs+1, 0);
+        bool good = mergeRuns(NULL, NULL, precision);
+
+        if (good) {
+            for (long long i = 0; i < numSeqs; i++) { rowStarts[i+1] += rowStarts[i]; }
+            unsigned long long numDists = rowStarts[numSeqs];
+
+            ofstream out, distOut;
+            string distFile = filename + ".dists.temp";
+            good = util.openOutputFileBinary(filename, out) && util.openOutputFileBinary(distFile, distOut);
+
+            if (good) {
+                writeHeader(out, precision);
+                good = mergeRuns(&out, &distOut, precision);
+
+                //pad to 8 bytes
+                unsigned long long used = (numDists * sizeof(unsigned int)) + (numDists * (precision / 8));
+                while ((used % 8) != 0) { distOut.put('\0'); used++; }
+
+                good = good && out.good() && distOut.good();
+            }
+            out.close(); distOut.close();
+
+            if (good) { good = util.appendBinaryFiles(distFile, filename); }
+            util.mothurRemove(distFile);
+
+            if (!good) { m->mothurOut("[ERROR]: unable to write " + filename + ".\n"); }
+        }
+
+        for (int i = 0; i < runs.size(); i++) { util.mothurRemove(runs[i]); }
+        runs.clear();
+        rowStarts.assign(1, 0); finalized = true;
+
+        return good;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "writeRuns");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool BinaryDistFile::read(string filename) {
+    try {
+        names.clear(); pending.clear(); cols.clear(); dists.clear();
+        rowStarts.assign(1, 0); finalized = true; nextRow = 0; nextDist = 0;
+
+        ifstream in(util.getFullPathName(filename).c_str(), ios::binary);
+        if (!in) { m->mothurOut("[ERROR]: Could not open " + filename + "\n"); return false; }
+
+        char magic[8];
+        unsigned int version, bits;
+        unsigned long long numSeqs, numDists, nameBytes;
+
+        in.read(magic, 8);
+        in.read((char*)&version, sizeof(unsigned int));
+        in.read((char*)&bits, sizeof(unsigned int));
+        in.read((char*)&numSeqs, sizeof(unsigned long long));
+        in.read((char*)&numDists, sizeof(unsigned long long));
+        in.read((char*)&nameBytes, sizeof(unsigned long long));
+
+        if (!in || (strncmp(magic, BINARYDIST_MAGIC, 8) != 0)) { m->mothurOut("[ERROR]: " + filename + " is not a binary distance file.\n"); return false; }
+        if (version != BINARYDIST_VERSION) { m->mothurOut("[ERROR]: " + filename + " was written by a newer version of mothur, version " + toString(version) + ".\n"); return false; }
+        if ((bits != 32) && (bits != 16)) { m->mothurOut("[ERROR]: " + filename + " has an unknown precision of " + toString(bits) + " bits.\n"); return false; }
+
+        unsigned long long paddedBytes = nameBytes;
+        while ((paddedBytes % 8) != 0) { paddedBytes++; }
+
+        string nameTable(paddedBytes, '\0');
+        if (paddedBytes != 0) { in.read(&nameTable[0], paddedBytes); }
+
+        string name = "";
+        for (unsigned long long i = 0; i < nameBytes; i++) {
+            if (nameTable[i] == '\n') { names.push_back(name); name = ""; }
+            else { name += nameTable[i]; }
+        }
+        if (names.size() != numSeqs) { m->mothurOut("[ERROR]: " + filename + " is damaged, expected " + toString(numSeqs) + " names and found " + toString(names.size()) + ".\n"); names.clear(); return false; }
+
+        rowStarts.resize(numSeqs+1);
+        in.read((char*)&rowStarts[0], rowStarts.size() * sizeof(unsigned long long));
+
+        cols.resize(numDists); dists.resize(numDists);
+        if (numDists != 0) { in.read((char*)&cols[0], numDists * sizeof(unsigned int)); }
+
+        if (bits == 32) {
+            if (numDists != 0) { in.read((char*)&dists[0], numDists * sizeof(float)); }
+        }else {
+            vector<unsigned short> halfs(numDists);
+            if (numDists != 0) { in.read((char*)&halfs[0], numDists * sizeof(unsigned short)); }
+            for (unsigned long long k = 0; k < numDists; k++) { dists[k] = halfToFloat(halfs[k]); }
+        }
+
+        if (!in || (rowStarts[numSeqs] != numDists)) {
+            m->mothurOut("[ERROR]: " + filename + " is damaged or incomplete.\n");
+            names.clear(); rowStarts.assign(1, 0); cols.clear(); dists.clear();
+            return false;
+        }
+        in.close();
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "read");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool BinaryDistFile::readColumn(string filename, float cutoff) {
+    try {
+        names.clear(); pending.clear(); cols.clear(); dists.clear();
+        rowStarts.assign(1, 0); finalized = false;
+
+        ifstream in;
+        if (!util.openInputFile(filename, in)) { return false; }
+
+        map<string, unsigned int> nameIndex;
+        map<string, unsigned int>::iterator itA, itB;
+
+        while (in) {
+            if (m->getControl_pressed()) { break; }
+
+            string nameA, nameB; float dist = 0;
+            in >> nameA; util.gobble(in);
+            if (nameA == "") { break; } //end of file
+
+            in >> nameB;
+            if (!(in >> dist)) { m->mothurOut("[ERROR]: " + filename + " ends in the middle of the distance for " + nameA + ", quitting.\n"); in.close(); return false; }
+            util.gobble(in);
+
+            if (dist > cutoff) { continue; }
+
+            itA = nameIndex.find(nameA);
+            if (itA == nameIndex.end()) { itA = nameIndex.insert(pair<string, unsigned int>(nameA, names.size())).first; names.push_back(nameA); }
+            itB = nameIndex.find(nameB);
+            if (itB == nameIndex.end()) { itB = nameIndex.insert(pair<string, unsigned int>(nameB, names.size())).first; names.push_back(nameB); }
+
+            add(itA->second, itB->second, dist);
+        }
+        in.close();
+
+        finalize();
+
+        return !m->getControl_pressed();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "readColumn");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool BinaryDistFile::readPhylip(string filename, float cutoff) {
+    try {
+        names.clear(); pending.clear(); cols.clear(); dists.clear();
+        rowStarts.assign(1, 0); finalized = false;
+
+        ifstream in;
+        if (!util.openInputFile(filename, in)) { return false; }
+
+        string numTest, name;
+        long long nseqs;
+        in >> numTest >> name;
+
+        if (!util.isContainingOnlyDigits(numTest)) { m->mothurOut("[ERROR]: expected a number and got " + numTest + ", quitting.\n"); return false; }
+        else { convert(numTest, nseqs); }
+
+        names.push_back(name);
+
+        //square test
+        bool square = false;
+        char d;
+        while((d=in.get()) != EOF){
+            if(isalnum(d)){ square = true; in.putback(d); break; }
+            if(d == '\n'){ square = false; break; }
+        }
+
+        float dist;
+        if (square) { for (long long j = 0; j < nseqs; j++) { in >> dist; } }
+
+        for (long long i = 1; i < nseqs; i++) {
+            if (m->getControl_pressed()) { break; }
+
+            in >> name; util.gobble(in);
+            names.push_back(name);
+
+            long long numCols = i;
+            if (square) { numCols = nseqs; }
+
+            for (long long j = 0; j < numCols; j++) {
+                in >> dist; util.gobble(in);
+                if ((j < i) && (dist <= cutoff)) { add(i, j, dist); }
+            }
+        }
+        in.close();
+
+        finalize();
+
+        return !m->getControl_pressed();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "readPhylip");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void BinaryDistFile::writeColumn(string filename) {
+    try {
+        finalize();
+
+        ofstream out;
+        util.openOutputFile(filename, out);
+
+        for (long long i = 0; i < names.size(); i++) {
+            if (m->getControl_pressed()) { break; }
+
+            string buffer = "";
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) {
+                buffer += names[i] + " " + names[cols[k]] + " " + toString(dists[k]) + "\n";
+            }
+            out << buffer;
+        }
+        out.close();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "writeColumn");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void BinaryDistFile::writePhylip(string filename) {
+    try {
+        finalize();
+
+        ofstream out;
+        util.openOutputFile(filename, out);
+        out.setf(ios::fixed, ios::showpoint);
+        out << setprecision(4);
+
+        long long numSeqs = names.size();
+        out << numSeqs << endl;
+
+        vector<float> row(numSeqs, 1.0);
+        for (long long i = 0; i < numSeqs; i++) {
+            if (m->getControl_pressed()) { break; }
+
+            string name = names[i];
+            if (name.length() < 10) {  while (name.length() < 10) {  name += " ";  } }
+            out << name;
+
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) { row[cols[k]] = dists[k]; }
+            for (long long j = 0; j < i; j++) { out << '\t' << row[j]; }
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) { row[cols[k]] = 1.0; }
+
+            out << endl;
+        }
+        out.close();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "writePhylip");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//IEEE 754 half precision, rounded to nearest. Distances are between 0 and 1, so this keeps about 3 significant digits.
+unsigned short BinaryDistFile::floatToHalf(float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(float));
+
+    unsigned int sign = (bits >> 16) & 0x8000;
+    int exponent = ((bits >> 23) & 0xff) - 127 + 15;
+    unsigned int mantissa = bits & 0x7fffff;
+
+    if (((bits >> 23) & 0xff) == 0xff) { return sign | 0x7c00 | (mantissa ? 0x200 : 0); } //inf or nan
+    if (exponent >= 31) { return sign | 0x7c00; } //too big
+    if (exponent <= 0) { //subnormal or zero
+        if (exponent < -10) { return sign; }
+        mantissa |= 0x800000;
+        unsigned int shift = 14 - exponent;
+        unsigned int half = mantissa >> shift;
+        if ((mantissa >> (shift-1)) & 1) { half++; }
+        return sign | half;
+    }
+
+    unsigned int half = sign | (exponent << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) { half++; } //round, a carry into the exponent is still correct
+    return half;
+}
+/**************************************************************************************************/
+float BinaryDistFile::halfToFloat(unsigned short half) {
+    unsigned int sign = (half & 0x8000) << 16;
+    unsigned int exponent = (half >> 10) & 0x1f;
+    unsigned int mantissa = half & 0x3ff;
+
+    unsigned int bits;
+    if (exponent == 0) {
+        if (mantissa == 0) { bits = sign; }
+        else { //subnormal
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) { mantissa <<= 1; exponent--; }
+            mantissa &= 0x3ff;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    }else if (exponent == 31) { bits = sign | 0x7f800000 | (mantissa << 13); }
+    else { bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13); }
+
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+/**************************************************************************************************/
@@ -0,0 +1,113 @@
+//
+//  binarydistfile.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef binarydistfile_hpp
+#define binarydistfile_hpp
+
+#include "mothurout.h"
+#include "utils.hpp"
+#include <queue>
+
+#define BINARYDIST_MAGIC "MOTHURBD"
+#define BINARYDIST_VERSION 1
+#define BINARYDIST_RUN_SIZE 4194304 //distances add holds before spilling a sorted run, about 48MB
+
+/* This class reads and writes sparse distance matrices in mothur's binary distance format (.bdist), so the distances
+ dist.seqs finds don't have to be written out and parsed again as "nameA nameB dist" text.
+
+ The file holds the lower triangle of the matrix in rows, like a compressed sparse row matrix:
+    header      - "MOTHURBD", version, precision (32 or 16 bit distances), numSeqs, numDists, size of the name table
+    names       - the sequence names separated by '\n', padded to 8 bytes
+    rowStarts   - numSeqs+1 unsigned long longs. The distances for row i are [rowStarts[i], rowStarts[i+1])
+    cols        - numDists unsigned ints, the column of each distance. Columns are less than the row and sorted
+    dists       - numDists floats or half floats, padded to 8 bytes
+
+ Numbers are stored in the byte order of the machine that wrote the file. Pairs not in the file are above the cutoff
+ used to create it.
+
+ With a run file set, add sorts and spills the distances to a temp file every BINARYDIST_RUN_SIZE distances, and write
+ merges the runs into the file, so a matrix bigger than memory can be written. Only write can be used after a spill. */
+
+/**************************************************************************************************/
+
+struct BinaryDistCell {
+    unsigned int row, col;
+    float dist;
+
+    BinaryDistCell() : row(0), col(0), dist(0) {}
+    BinaryDistCell(unsigned int r, unsigned int c, float d) : row(r), col(c), dist(d) {}
+};
+
+/**************************************************************************************************/
+
+class BinaryDistFile {
+
+public:
+
+    BinaryDistFile();
+    ~BinaryDistFile();
+
+    static bool isBinary(string); //true if the file starts with the binary distance file header
+
+    //adding distances, call finalize or write when done
+    void setNames(vector<string> n)                 { names = n; finalized = false;                     }
+    void add(unsigned int, unsigned int, float);    //row, col, dist - stored in the lower triangle, order doesn't matter
+    void append(BinaryDistFile&);                   //moves the other file's unfinalized distances and runs into this one
+    void setRunFile(string r, long long size=BINARYDIST_RUN_SIZE) { runFile = r; runSize = size;      } //runs are named r + run number + ".temp"
+    void finalize();                                //sorts the distances into rows and removes duplicate pairs
+
+    bool read(string);                              //returns false if the file is not a binary distance file
+    bool write(string, int precision=32);           //precision is 32 or 16 bits
+
+    bool readColumn(string, float);                 //column file, cutoff
+    bool readPhylip(string, float);                 //lt or square phylip file, cutoff
+    void writeColumn(string);
+    void writePhylip(string);                       //lt, pairs not in the file are written as 1.0
+
+    long long getNumSeqs()                          { return names.size();          }
+    long long getNumDists()                         { return cols.size();           }
+    string getName(long long i)                     { return names[i];              }
+    vector<string> getNames()                       { return names;                 }
+
+    //the distances of row i are [getRowStart(i), getRowStart(i+1))
+    unsigned long long getRowStart(long long i)     { return rowStarts[i];          }
+    unsigned int getCol(unsigned long long k)       { return cols[k];               }
+    float getDist(unsigned long long k)             { return dists[k];              }
+
+    //steps through the distances in row order, returns false after the last one
+    bool getNext(string&, string&, float&);
+
+    static float halfToFloat(unsigned short);      //for readers of 16 bit files that don't use this class
+
+private:
+
+    MothurOut* m;
+    Utils util;
+    vector<string> names;
+    vector<BinaryDistCell> pending;
+    string runFile;
+    long long runSize;
+    vector<string> runs;
+    vector<unsigned long long> rowStarts;
+    vector<unsigned int> cols;
+    vector<float> dists;
+    bool finalized;
+    long long nextRow;
+    unsigned long long nextDist;
+
+    static unsigned short floatToHalf(float);
+    void writeHeader(ofstream&, int);
+    void spillRun();
+    bool mergeRuns(ofstream*, ofstream*, int);
+    bool writeRuns(string, int);
+
+};
+
+/**************************************************************************************************/
+
+#endif /* binarydistfile_hpp */
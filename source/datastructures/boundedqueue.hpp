@@ -0,0 +1,71 @@
+//
+//  boundedqueue.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef boundedqueue_hpp
+#define boundedqueue_hpp
+
+#include "mothur.h"
+#include <deque>
+#include <condition_variable>
+
+/* A first in first out queue for handing work from one thread to others. It holds at most capacity items, so a
+ producer that gets ahead of the workers waits instead of filling memory. */
+
+/**************************************************************************************************/
+
+template <class T>
+class BoundedQueue {
+
+public:
+
+    BoundedQueue(int c) : capacity(c), closed(false) { if (capacity < 1) { capacity = 1; } }
+    ~BoundedQueue() {}
+
+    //waits while the queue is full, returns false if the queue was closed
+    bool push(T item) {
+        unique_lock<mutex> lock(queueMutex);
+        notFull.wait(lock, [this] { return (closed || (items.size() < (size_t)capacity)); });
+        if (closed) { return false; }
+
+        items.push_back(item);
+        notEmpty.notify_one();
+
+        return true;
+    }
+
+    //waits while the queue is empty, returns false once the queue is closed and empty
+    bool pop(T& item) {
+        unique_lock<mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this] { return (closed || (items.size() != 0)); });
+        if (items.size() == 0) { return false; }
+
+        item = items.front(); items.pop_front();
+        notFull.notify_one();
+
+        return true;
+    }
+
+    //no more items will be pushed, the items already in the queue can still be popped
+    void close() {
+        lock_guard<mutex> lock(queueMutex);
+        closed = true;
+        notEmpty.notify_all(); notFull.notify_all();
+    }
+
+private:
+
+    int capacity;
+    bool closed;
+    deque<T> items;
+    mutex queueMutex;
+    condition_variable notFull, notEmpty;
+};
+
+/**************************************************************************************************/
+
+#endif /* boundedqueue_hpp */
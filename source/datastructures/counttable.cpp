@@ -7,28 +7,49 @@
 //
 
 #include "counttable.h"
+#include "dereplicator.hpp"
 
+#if defined NON_WINDOWS
+    #include <sys/mman.h>
+    #include <fcntl.h>
+#endif
+
+/************************************************************/
+//reads the next int of a count table line, returns false if there isn't one
+static inline bool readCountTableInt(const char*& p, const char* end, int& value) {
+    while ((p < end) && ((*p == ' ') || (*p == '\t'))) { p++; }
+
+    bool negative = false;
+    if ((p < end) && (*p == '-')) { negative = true; p++; }
+
+    const char* start = p;
+    long long num = 0;
+    while ((p < end) && (*p >= '0') && (*p <= '9')) { num = num * 10 + (*p - '0'); p++; }
+
+    value = (int)(negative ? -num : num);
+
+    return (p != start);
+}
+/************************************************************/
+static inline unsigned long long padTo8(unsigned long long bytes) { return ((bytes + 7) / 8) * 8; }
+/************************************************************/
+static inline void writePadding(ofstream& out, unsigned long long bytes) {
+    char zeros[8] = { 0 };
+    out.write(zeros, padTo8(bytes) - bytes);
+}
 /************************************************************/
 //used by tree commands
 int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>& gs) {
     try {
-        hasGroups = false;
-        int numGroups = 0;
-        groups.clear();
-        totalGroups.clear();
-        indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearTable();
         for (set<string>::iterator it = gs.begin(); it != gs.end(); it++) { groups.push_back(*it);  hasGroups = true; }
-        numGroups = groups.size();
+        int numGroups = groups.size();
         totalGroups.resize(numGroups, 0);
 
 		//sort groups to keep consistent with how we store the groups in groupmap
         sort(groups.begin(), groups.end());
         for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
 
-        uniques = 0;
-        total = 0;
         bool error = false;
         //n contains treenames
         for (set<string>::iterator it = n.begin(); it != n.end(); it++) {
@@ -41,8 +62,11 @@ int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>&
             map<string, string>::iterator itGroup = g.find(seqName);
 
             if (itGroup != g.end()) {
-                groupCounts.push_back(countTableItem(1, indexGroupMap[itGroup->second]));
-                totalGroups[indexGroupMap[itGroup->second]]++;
+                map<string, int>::iterator itIndex = indexGroupMap.find(itGroup->second);
+                if (itIndex != indexGroupMap.end()) {
+                    groupCounts.push_back(countTableItem(1, itIndex->second));
+                    totalGroups[itIndex->second]++;
+                }
             }else {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
@@ -51,11 +75,8 @@ int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>&
                 m->mothurOut("[ERROR]: Your group file does not contain " + seqName + ". Please correct.\n");
             }
 
-            map<string, int>::iterator it2 = indexNameMap.find(seqName);
-            if (it2 == indexNameMap.end()) {
-                if (hasGroups) { counts.push_back(groupCounts); }
-                indexNameMap[seqName] = uniques;
-                totals.push_back(1);
+            if (findName(seqName) == -1) {
+                addRow(seqName, 1, groupCounts);
                 total++;
                 uniques++;
             }else {
@@ -99,15 +120,15 @@ bool CountTable::testGroups(string file, vector<string>& groups) {
         util.openInputFile(file, in);
 
         string headers = util.getline(in); util.gobble(in);
-        
+
         if (headers[0] == '#') { //is this a count file in compressed form
             isCompressed = true;
-            
+
             //read headers
             headers = util.getline(in); util.gobble(in); //gets compressed group name map line
             headers = util.getline(in); util.gobble(in);
         }
-        
+
         vector<string> columnHeaders = util.splitWhiteSpace(headers);
 
         if (columnHeaders.size() > 2) {
@@ -157,21 +178,14 @@ bool CountTable::setNamesOfGroups(vector<string> mygroups) {
 
 int CountTable::createTable(string namefile, string groupfile, vector<string> selectedGroups, bool createGroup) {
     try {
-        
+
         GroupMap* groupMap;
         int numGroups = 0;
-        groups.clear();
-        totalGroups.clear();
-        indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
-        map<int, string> originalGroupIndexes;
-        uniques = 0;
-        total = 0;
+        clearTable();
         bool error = false;
         bool pickedGroups = false;
         if (selectedGroups.size() != 0) { pickedGroups = true; }
-        
+
         if (groupfile != "") {
             hasGroups = true;
             groupMap = new GroupMap(groupfile); groupMap->readMap(selectedGroups);
@@ -190,98 +204,91 @@ int CountTable::createTable(string namefile, string groupfile, vector<string> se
         for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
 
         if ((namefile == "") && (groupfile == "")) { m->mothurOut("[ERROR]: No name or group file given. You must provide a name or group file to create a count file, please correct.\n");  m->setControl_pressed(true); return 0; }
-        
+
         else if (namefile != "") {
-        
+
             ifstream in; util.openInputFile(namefile, in);
-            
+
             while (!in.eof()) {
                 if (m->getControl_pressed()) { break; }
-                
+
                 string firstCol, secondCol;
                 in >> firstCol; util.gobble(in); in >> secondCol; util.gobble(in);
-                
+
                 util.checkName(firstCol);
                 util.checkName(secondCol);
-                
+
                 vector<string> names;
                 util.splitAtChar(secondCol, names, ',');
-                
-                map<string, int> groupCounts;
-                for (int i = 0; i < groups.size(); i++) { groupCounts[groups[i]] = 0;  } //initialize groupCounts
-                
+
+                vector<int> groupCounts(groups.size(), 0); //indexed like groups
+
                 int thisTotal = 0;
                 if (groupfile != "") {
-                    
+
                     //get counts for each of the users groups
                     for (int i = 0; i < names.size(); i++) {
                         string group = groupMap->getGroup(names[i]);
-                        
+
                         if (group == "not found") {
                             if (!pickedGroups) { m->mothurOut("[ERROR]: " + names[i] + " is not in your groupfile, please correct.\n");  error=true; }
                             //else - ignore because we assume this read is from a group we are not interested in
                         }else { //this is a read from a group we want to save
-                            map<string, int>::iterator it = groupCounts.find(group);
-                            
+                            map<string, int>::iterator it = indexGroupMap.find(group);
+
                             //if not found, then this sequence is not from a group we care about
-                            if (it != groupCounts.end()) { it->second++; }
+                            if (it != indexGroupMap.end()) { groupCounts[it->second]++; }
                             thisTotal++;
                         }
                     }
                 }else if (createGroup) {
                     thisTotal = names.size();
-                    groupCounts["Group1"] = thisTotal;
+                    groupCounts[0] = thisTotal;
                 }else { thisTotal = names.size();  }
-                
+
                 //if group info, then read it
                 vector<countTableItem> thisGroupsCount;
-                for (map<string, int>::iterator it = groupCounts.begin(); it != groupCounts.end(); it++) {
-                    int groupIndex = indexGroupMap[it->first];
-                    int abund = it->second;
+                for (int groupIndex = 0; groupIndex < groupCounts.size(); groupIndex++) {
+                    int abund = groupCounts[groupIndex];
                     if (abund != 0) {
-                        countTableItem thisAbund(it->second, groupIndex);
+                        countTableItem thisAbund(abund, groupIndex);
                         thisGroupsCount.push_back(thisAbund);
                         totalGroups[groupIndex] += abund;
                     }
-                    
+
                 }
-                
-                map<string, int>::iterator it = indexNameMap.find(firstCol);
-                if (it == indexNameMap.end()) {
-                    
-                    if (hasGroups) {  counts.push_back(thisGroupsCount);  }
-                    indexNameMap[firstCol] = uniques;
-                    totals.push_back(thisTotal);
+
+                if (findName(firstCol) == -1) {
+
+                    addRow(firstCol, thisTotal, thisGroupsCount);
                     total += thisTotal;
                     uniques++;
-                    
+
                 }else { error = true; m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + firstCol + ", sequence names must be unique. Please correct.\n"); }
             }
             in.close();
 
         }else if ((namefile == "") && (groupfile != "")) { //create count file from group only
-            
+
             vector<string> names = groupMap->getNamesSeqs(); //only contains names from selectedGroups or all groups if selectedGroups is empty
-            
+
             for (int i = 0; i < names.size(); i++) {
                if (m->getControl_pressed()) { break; }
-                
+
                 vector<countTableItem> abunds;
                 string group = groupMap->getGroup(names[i]);
-                int groupIndex = indexGroupMap[group];
-                totalGroups[groupIndex]++;
-                countTableItem thisAbund(1, groupIndex);
-                abunds.push_back(thisAbund);
-                
-                map<string, int>::iterator it = indexNameMap.find(names[i]);
-                if (it == indexNameMap.end()) {
-                    
-                    counts.push_back(abunds);
-                    indexNameMap[names[i]] = uniques;
-                    totals.push_back(1);
+                map<string, int>::iterator it = indexGroupMap.find(group);
+                if (it != indexGroupMap.end()) {
+                    totalGroups[it->second]++;
+                    abunds.push_back(countTableItem(1, it->second));
+                }
+
+                if (findName(names[i]) == -1) {
+
+                    addRow(names[i], 1, abunds);
                     total++;
                     uniques++;
-                    
+
                 }else { error = true; m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + names[i] + ", sequence names must be unique. Please correct.\n"); }
             }
         }
@@ -311,15 +318,8 @@ int CountTable::readTable(string file, string format) {
             ifstream in;
             util.openInputFile(filename, in);
 
-            hasGroups = false;
-            groups.clear();
-            totalGroups.clear();
-            indexGroupMap.clear();
-            indexNameMap.clear();
-            counts.clear();
+            clearTable();
             bool error = false;
-            uniques = 0;
-            total = 0;
             while (!in.eof()) {
 
                 if (m->getControl_pressed()) { break; }
@@ -328,10 +328,8 @@ int CountTable::readTable(string file, string format) {
                 string name = seq.getName();
                 if (m->getDebug()) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(1) + "\n"); }
 
-                map<string, int>::iterator it = indexNameMap.find(name);
-                if (it == indexNameMap.end()) {
-                    indexNameMap[name] = uniques;
-                    totals.push_back(1);
+                if (findName(name) == -1) {
+                    addRow(name, 1, vector<countTableItem>());
                     total ++;
                     uniques++;
                 }else {
@@ -354,9 +352,9 @@ int CountTable::readTable(string file, string format) {
 /************************************************************/
 int CountTable::readTable(string file, bool readGroups, bool mothurRunning) {
     try {
-        
+
         readTable(file, readGroups, mothurRunning, nullVector);
-       
+
         return total;
     }
     catch(exception& e) {
@@ -378,23 +376,23 @@ int CountTable::readTable(ifstream& in, bool readGroups, bool mothurRunning) {
 /************************************************************/
 bool CountTable::isCountTable(string file) {
     try {
-        
+
         filename = file;
         ifstream in;
         util.openInputFile(filename, in);
-        
+
         string headers = util.getline(in); util.gobble(in);
-        
+
         if (headers[0] == '#') { //is this a count file in compressed form
             isCompressed = true;
-            
+
             //read headers
             headers = util.getline(in); util.gobble(in); //gets compressed group name map line
             headers = util.getline(in); util.gobble(in);
         }
         vector<string> columnHeaders = util.splitWhiteSpace(headers);
         in.close();
-        
+
         bool isCount = true;
         if (columnHeaders.size() >= 2) {
             vector<string> defaultHeaders = getHardCodedHeaders();
@@ -403,7 +401,7 @@ bool CountTable::isCountTable(string file) {
                 if (columnHeaders[1] != defaultHeaders[1]) { isCount = false; }
             }else { isCount = false; }
         }else { isCount = false; }
-        
+
         return isCount;
 
     }
@@ -418,11 +416,11 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, vect
         filename = file;
         ifstream in;
         util.openInputFile(filename, in);
-        
-        readTable(in, readGroups, mothurRunning, selectedGroups);
-        
+
+        readFile(filename, in, readGroups, mothurRunning, selectedGroups, NULL);
+
         in.close();
-        
+
         return 0;
     }
     catch(exception& e) {
@@ -432,186 +430,147 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, vect
 }
 /************************************************************/
 int CountTable::readTable(ifstream& in, bool readGroups, bool mothurRunning, vector<string> selectedGroups) {
+    try {
+        return readFile("", in, readGroups, mothurRunning, selectedGroups, NULL);
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "readTable");
+		exit(1);
+	}
+}
+/************************************************************/
+int CountTable::readTable(string file, bool readGroups, bool mothurRunning, set<string> selectedSeqs) {
+    try {
+        filename = file;
+        ifstream in;
+        util.openInputFile(filename, in);
+
+        readFile(filename, in, readGroups, mothurRunning, nullVector, &selectedSeqs);
+
+        in.close();
+
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "readTable");
+        exit(1);
+    }
+}
+/************************************************************/
+//reads the binary copy of the file if it is current, otherwise parses the text. filename is "" when reading from a filehandle
+int CountTable::readFile(string file, ifstream& in, bool readGroups, bool mothurRunning, vector<string> selectedGroups, set<string>* selectedSeqs) {
     try {
         if (!readGroups) { selectedGroups.clear(); }
 
-        string headers = util.getline(in); util.gobble(in);
-        
-        map<string, int> headerIndex2Group;
-        //#1,F003D000	2,F003D002	3,F003D004	4,F003D006	5,F003D008	6,F003D142	7,F003D144	8,F003D146	9,F003D148	10,F003D150
-        if (headers[0] == '#') { //is this a count file in compressed form
-            isCompressed = true;
-            
-            //read headers
-            headers = util.getline(in); util.gobble(in); //gets compressed group name map line
-            headers = headers.substr(1);
-            
-            vector<string> groupNameHeaders = util.splitWhiteSpace(headers);
-            
-            for (int i = 0; i < groupNameHeaders.size(); i++) {
-                string groupIndex = ""; string groupName = groupNameHeaders[i];
-                util.splitAtComma(groupIndex, groupName);
-                int a; util.mothurConvert(groupIndex, a);
-                headerIndex2Group[groupName] = a-1;
-            }
-            
-            headers = util.getline(in); util.gobble(in);
-        }
-        
-        vector<string> columnHeaders = util.splitWhiteSpace(headers);
-        
-        int numGroupsInFile = 0;
-        groups.clear();
-        totalGroups.clear();
-        indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
-        map<int, string> originalGroupIndexes;
-        if ((columnHeaders.size() > 2) && readGroups) { hasGroups = true; numGroupsInFile = columnHeaders.size() - 2;  }
-        
-        set<string> setOfSelectedGroups;
-        if (readGroups) {
-            for (int i = 2; i < columnHeaders.size(); i++) {
-                bool saveGroup = true;
-                if (selectedGroups.size() != 0) {
-                    if (!(util.inUsersGroups(columnHeaders[i], selectedGroups))) { saveGroup = false; }
-                } //is this group in selected groups
-                
-                if (saveGroup) {
-                    groups.push_back(columnHeaders[i]);
-                    if (isCompressed) {
-                        map<string, int>::iterator it = headerIndex2Group.find(columnHeaders[i]);
-                        if (it != headerIndex2Group.end()) {
-                            originalGroupIndexes[it->second] = columnHeaders[i];
-                        }
-                    }
-                    else {  originalGroupIndexes[i-2] = columnHeaders[i];  }
-                    totalGroups.push_back(0);
-                    setOfSelectedGroups.insert(columnHeaders[i]);
+        clearTable();
+
+        countTableFile thisFile;
+        thisFile.readGroups = readGroups; thisFile.mothurRunning = mothurRunning; thisFile.selectedSeqs = selectedSeqs;
+        thisFile.pickedGroups = false; thisFile.hasGroupColumns = false; thisFile.error = false;
+
+        if ((file == "") || !readBinaryFile(file, thisFile, selectedGroups)) {
+
+            string headers = util.getline(in); util.gobble(in);
+
+            bool compressedFile = false;
+            map<string, int> headerIndex2Group;
+            //#1,F003D000	2,F003D002	3,F003D004	4,F003D006	5,F003D008	6,F003D142	7,F003D144	8,F003D146	9,F003D148	10,F003D150
+            if (headers[0] == '#') { //is this a count file in compressed form
+                isCompressed = true; compressedFile = true;
+
+                //read headers
+                headers = util.getline(in); util.gobble(in); //gets compressed group name map line
+                headers = headers.substr(1);
+
+                vector<string> groupNameHeaders = util.splitWhiteSpace(headers);
+
+                for (int i = 0; i < groupNameHeaders.size(); i++) {
+                    string groupIndex = ""; string groupName = groupNameHeaders[i];
+                    util.splitAtComma(groupIndex, groupName);
+                    int a; util.mothurConvert(groupIndex, a);
+                    headerIndex2Group[groupName] = a-1;
                 }
-            }
-        }
-        
-        //sort groups to keep consistent with how we store the groups in groupmap
-        sort(groups.begin(), groups.end());
-        for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
-        int numGroupsSelected = groups.size();
 
-        bool error = false;
-        string name;
-        int thisTotal = 0;
-        uniques = 0;
-        total = 0;
-        while (!in.eof()) {
+                headers = util.getline(in); util.gobble(in);
+            }
 
-            if (m->getControl_pressed()) { break; }
+            vector<string> columnHeaders = util.splitWhiteSpace(headers);
+            vector<string> columnGroups;
+            for (int i = 2; i < columnHeaders.size(); i++) { columnGroups.push_back(columnHeaders[i]); }
 
-            in >> name; util.gobble(in); in >> thisTotal; util.gobble(in);
-            if (m->getDebug()) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(thisTotal) + "\n"); }
+            setFileGroups(thisFile, columnGroups, selectedGroups);
 
-            if ((thisTotal == 0) && !mothurRunning) { error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + name + " with a total=0. Please correct.\n"); 
+            //the compressed rows give the number of the group in the # line, find its column
+            vector<int> numberToColumn;
+            for (int i = 0; i < columnGroups.size(); i++) {
+                map<string, int>::iterator it = headerIndex2Group.find(columnGroups[i]);
+                if ((it != headerIndex2Group.end()) && (it->second >= 0)) {
+                    if (it->second >= numberToColumn.size()) { numberToColumn.resize(it->second+1, -1); }
+                    numberToColumn[it->second] = i;
+                }
             }
 
-            //if group info, then read it
-            vector<int> groupCounts; groupCounts.resize(numGroupsSelected, 0);
-            if (columnHeaders.size() > 2) { //file contains groups
-                if (readGroups) { //user wants to save them
-                    if (selectedGroups.size() != 0) {
-                        //read this seqs groups abundances
-                        thisTotal = 0;
-                        if (isCompressed) {
-                            string groupInfo = util.getline(in); util.gobble(in);
-                            vector<string> groupNodes = util.splitWhiteSpace(groupInfo);
-                            
-                            vector<countTableItem> abunds;
-                            for (int i = 0; i < groupNodes.size(); i++) { //for each non zero group count
-                                string abund = groupNodes[i]; string thisgroup = "";
-                                util.splitAtComma(thisgroup, abund);
-                                int a; util.mothurConvert(abund, a);
-                                int g; util.mothurConvert(thisgroup, g); g--;
-                                string groupName = originalGroupIndexes[g]; //order of groups in file may not be sorted
-                                
-                                if (setOfSelectedGroups.count(groupName) != 0) { //we selected this group
-                                    int thisIndex = indexGroupMap[groupName];
-                                    countTableItem item(a, thisIndex);
-                                    abunds.push_back(item);
-                                    totalGroups[thisIndex] += a;
-                                    thisTotal += a;
+            bool readColumns = (thisFile.hasGroupColumns && readGroups);
+            int numColumns = columnGroups.size();
+            vector<countTableItem> columnItems;
+            string line;
+            while (getline(in, line)) {
+
+                if (m->getControl_pressed()) { break; }
+
+                //a line may hold more than one row if the file has \r line endings
+                size_t segmentStart = 0;
+                while (segmentStart < line.length()) {
+                    size_t segmentEnd = line.find('\r', segmentStart);
+                    if (segmentEnd == string::npos) { segmentEnd = line.length(); }
+
+                    const char* p = line.c_str() + segmentStart;
+                    const char* end = line.c_str() + segmentEnd;
+                    segmentStart = segmentEnd + 1;
+
+                    while ((p < end) && isspace(*p)) { p++; }
+                    if (p == end) { continue; }
+
+                    const char* nameStart = p;
+                    while ((p < end) && !isspace(*p)) { p++; }
+                    string name(nameStart, p - nameStart);
+
+                    int thisTotal = 0;
+                    readCountTableInt(p, end, thisTotal);
+
+                    columnItems.clear();
+                    if (readColumns) {
+                        if (compressedFile) {
+                            while (p < end) {
+                                int g = 0, a = 0;
+                                bool foundGroup = readCountTableInt(p, end, g);
+                                if ((p < end) && (*p == ',')) { p++; }
+                                bool foundAbund = readCountTableInt(p, end, a);
+
+                                if (!foundGroup && !foundAbund) { //not a group,abund pair, skip it
+                                    while ((p < end) && !isspace(*p)) { p++; }
+                                    while ((p < end) && isspace(*p)) { p++; }
+                                    continue;
                                 }
+
+                                g--;
+                                if ((g >= 0) && (g < numberToColumn.size()) && (numberToColumn[g] != -1) && (a != 0)) { columnItems.push_back(countTableItem(a, numberToColumn[g])); }
                             }
-                            
-                            groupCounts = expandAbunds(abunds);
                         }else {
-                            for (int i = 0; i < numGroupsInFile; i++) {
-                                int thisGroupAbund = 0;
-                                in >> thisGroupAbund; util.gobble(in);
-                                string groupName = originalGroupIndexes[i]; //order of groups in file may not be sorted
-                                
-                                if (setOfSelectedGroups.count(groupName) != 0) { //we selected this group
-                                    int thisIndex = indexGroupMap[groupName];
-                                    groupCounts[thisIndex] = thisGroupAbund;
-                                    totalGroups[thisIndex] += thisGroupAbund;
-                                    thisTotal += thisGroupAbund;
-                                }
+                            for (int i = 0; i < numColumns; i++) {
+                                int a = 0;
+                                readCountTableInt(p, end, a);
+                                if (a != 0) { columnItems.push_back(countTableItem(a, i)); }
                             }
                         }
-                    }else {
-                        
-                            if (isCompressed) {
-                                string groupInfo = util.getline(in); util.gobble(in);
-                                vector<string> groupNodes = util.splitWhiteSpace(groupInfo);
-                                
-                                vector<countTableItem> abunds;
-                                for (int i = 0; i < groupNodes.size(); i++) { //for each non zero group count
-                                    string abund = groupNodes[i]; string thisgroup = "";
-                                    util.splitAtComma(thisgroup, abund);
-                                    int a; util.mothurConvert(abund, a);
-                                    int g; util.mothurConvert(thisgroup, g); g--;
-                                    string groupName = originalGroupIndexes[g]; //order of groups in file may not be sorted
-                                    int thisIndex = indexGroupMap[groupName];
-                                    countTableItem item(a, thisIndex);
-                                   
-                                    abunds.push_back(item);
-                                    totalGroups[thisIndex] += a;
-                                }
-                                
-                                groupCounts = expandAbunds(abunds);
-                            }
-                            else {
-                                for (int i = 0; i < numGroupsInFile; i++) {
-                                    int thisIndex = indexGroupMap[originalGroupIndexes[i]];
-                                    in >> groupCounts[thisIndex]; util.gobble(in);
-                                    totalGroups[thisIndex] += groupCounts[thisIndex];
-                                }
-                            }
-                        
                     }
-                }else { //read and discard
-                    util.getline(in); util.gobble(in);
-                }
-            }
-            
-            map<string, int>::iterator it = indexNameMap.find(name);
-            if (it == indexNameMap.end()) {
-                bool saveSeq = true;
-                if (hasGroups && readGroups) {
-                    vector<countTableItem> thisGroupsCount = compressAbunds(groupCounts);
-                    if (thisGroupsCount.size() == 0) {  saveSeq = false; }
-                    else { counts.push_back(thisGroupsCount); }
-                }
-                if (saveSeq) {
-                    indexNameMap[name] = uniques;
-                    totals.push_back(thisTotal);
-                    total += thisTotal;
-                    uniques++;
+
+                    addFileRow(thisFile, name, thisTotal, columnItems);
                 }
-            }else {
-                error = true;
-                m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + name + ", sequence names must be unique. Please correct.\n");
             }
         }
 
-        if (error) { m->setControl_pressed(true); }
+        if (thisFile.error) { m->setControl_pressed(true); }
         else { //check for zero groups
             if (hasGroups && readGroups) {
                 for (int i = 0; i < totalGroups.size(); i++) {
@@ -622,161 +581,306 @@ int CountTable::readTable(ifstream& in, bool readGroups, bool mothurRunning, vec
                 }
             }
         }
-        
+
         //if the file has groups, but we didn't read them
         if (!readGroups) { hasGroups = false; }
 
         return 0;
     }
-	catch(exception& e) {
-		m->errorOut(e, "CountTable", "readTable");
-		exit(1);
-	}
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "readFile");
+        exit(1);
+    }
 }
 /************************************************************/
-int CountTable::readTable(string file, bool readGroups, bool mothurRunning, set<string> selectedSeqs) {
+//sets the groups read from the group columns of the file
+void CountTable::setFileGroups(countTableFile& thisFile, vector<string>& columnGroups, vector<string>& selectedGroups) {
     try {
-        filename = file;
-        ifstream in;
-        util.openInputFile(filename, in);
-        
-        string headers = util.getline(in); util.gobble(in);
-        
-        map<string, int> headerIndex2Group;
-        //#1,F003D000	2,F003D002	3,F003D004	4,F003D006	5,F003D008	6,F003D142	7,F003D144	8,F003D146	9,F003D148	10,F003D150
-        if (headers[0] == '#') { //is this a count file in compressed form
-            isCompressed = true;
-            
-            //read headers
-            headers = util.getline(in); util.gobble(in); //gets compressed group name map line
-            headers = headers.substr(1);
-            
-            vector<string> groupNameHeaders = util.splitWhiteSpace(headers);
-            
-            for (int i = 0; i < groupNameHeaders.size(); i++) {
-                string groupIndex = ""; string groupName = groupNameHeaders[i];
-                util.splitAtComma(groupIndex, groupName);
-                int a; util.mothurConvert(groupIndex, a);
-                headerIndex2Group[groupName] = a-1;
+        thisFile.hasGroupColumns = (columnGroups.size() != 0);
+        thisFile.pickedGroups = (selectedGroups.size() != 0);
+        thisFile.columnToGroup.assign(columnGroups.size(), -1);
+
+        if (thisFile.hasGroupColumns && thisFile.readGroups) { hasGroups = true; }
+
+        if (thisFile.readGroups) {
+            vector<bool> saveGroup(columnGroups.size(), true);
+            for (int i = 0; i < columnGroups.size(); i++) {
+                if (thisFile.pickedGroups) { saveGroup[i] = util.inUsersGroups(columnGroups[i], selectedGroups); } //is this group in selected groups
+                if (saveGroup[i]) { groups.push_back(columnGroups[i]); }
             }
-            
-            headers = util.getline(in); util.gobble(in);
-        }
-        
-        vector<string> columnHeaders = util.splitWhiteSpace(headers);
-        
-        int numGroupsInFile = 0;
-        groups.clear();
-        totalGroups.clear();
-        indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
-        map<int, string> originalGroupIndexes;
-        if ((columnHeaders.size() > 2) && readGroups) { hasGroups = true; numGroupsInFile = columnHeaders.size() - 2;  }
-        
-                
-        if (readGroups) {
-            for (int i = 2; i < columnHeaders.size(); i++) {
-                groups.push_back(columnHeaders[i]);
-                
-                if (isCompressed) {
-                    map<string, int>::iterator it = headerIndex2Group.find(columnHeaders[i]);
-                    if (it != headerIndex2Group.end()) {
-                        originalGroupIndexes[it->second] = columnHeaders[i];
-                    }
-                }else { originalGroupIndexes[i-2] = columnHeaders[i];  }
-                totalGroups.push_back(0);
+
+            //sort groups to keep consistent with how we store the groups in groupmap
+            sort(groups.begin(), groups.end());
+            for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
+            totalGroups.assign(groups.size(), 0);
+
+            for (int i = 0; i < columnGroups.size(); i++) {
+                if (saveGroup[i]) { thisFile.columnToGroup[i] = indexGroupMap[columnGroups[i]]; }
             }
         }
-        
-        //sort groups to keep consistent with how we store the groups in groupmap
-        sort(groups.begin(), groups.end());
-        for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
-        int numGroups = groups.size();
-        
-        bool error = false;
-        string name;
-        int thisTotal;
-        uniques = 0;
-        total = 0;
-        while (!in.eof()) {
-            
-            if (m->getControl_pressed()) { break; }
-            
-            in >> name; util.gobble(in); in >> thisTotal; util.gobble(in);
-            if (m->getDebug()) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(thisTotal) + "\n"); }
-            
-            if ((thisTotal == 0) && !mothurRunning) { error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + name + " with a total=0. Please correct.\n");
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "setFileGroups");
+        exit(1);
+    }
+}
+/************************************************************/
+//columnItems are the file's non zero abundances, by column
+void CountTable::addFileRow(countTableFile& thisFile, const string& name, int thisTotal, vector<countTableItem>& columnItems) {
+    try {
+        if (m->getDebug()) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(thisTotal) + "\n"); }
+
+        if ((thisTotal == 0) && !thisFile.mothurRunning) { thisFile.error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + name + " with a total=0. Please correct.\n");
+        }
+
+        thisFile.rowItems.clear();
+        if (thisFile.hasGroupColumns && thisFile.readGroups) { //user wants to save them
+            if (thisFile.pickedGroups) { thisTotal = 0; }
+
+            bool sorted = true;
+            for (int i = 0; i < columnItems.size(); i++) {
+                int columnIndex = columnItems[i].group;
+                if ((columnIndex < 0) || (columnIndex >= thisFile.columnToGroup.size())) { continue; }
+
+                int thisIndex = thisFile.columnToGroup[columnIndex];
+                if ((thisIndex == -1) || (columnItems[i].abund == 0)) { continue; } //we didn't select this group
+
+                if ((thisFile.rowItems.size() != 0) && (thisFile.rowItems.back().group > thisIndex)) { sorted = false; }
+                thisFile.rowItems.push_back(countTableItem(columnItems[i].abund, thisIndex));
+                totalGroups[thisIndex] += columnItems[i].abund;
+                if (thisFile.pickedGroups) { thisTotal += columnItems[i].abund; }
             }
-            
-            vector<int> groupCounts; groupCounts.resize(numGroups, 0);
-            if (columnHeaders.size() > 2) { //file contains groups
-                if (readGroups) { //user wants to save them
-                    if (isCompressed) {
-                        string groupInfo = util.getline(in); util.gobble(in);
-                        vector<string> groupNodes = util.splitWhiteSpace(groupInfo);
-                        
-                        vector<countTableItem> abunds;
-                        for (int i = 0; i < groupNodes.size(); i++) { //for each non zero group count
-                            string abund = groupNodes[i]; string thisgroup = "";
-                            util.splitAtComma(thisgroup, abund);
-                            int a; util.mothurConvert(abund, a);
-                            int g; util.mothurConvert(thisgroup, g); g--;
-                            string groupName = originalGroupIndexes[g]; //order of groups in file may not be sorted
-                            int thisIndex = indexGroupMap[groupName];
-                            countTableItem item(a, thisIndex);
-                            
-                            abunds.push_back(item);
-                            totalGroups[thisIndex] += a;
-                        }
-                        
-                        groupCounts = expandAbunds(abunds);
-                    }
-                    else {
-                        for (int i = 0; i < numGroupsInFile; i++) { int thisIndex = indexGroupMap[originalGroupIndexes[i]]; in >> groupCounts[thisIndex]; util.gobble(in); totalGroups[thisIndex] += groupCounts[thisIndex]; }
-                    }
-                }else { util.getline(in); util.gobble(in); }//read and discard
+
+            //order of groups in file may not be sorted
+            if (!sorted) { sort(thisFile.rowItems.begin(), thisFile.rowItems.end(), compareGroups); }
+        }
+
+        if (findName(name) == -1) {
+            bool saveSeq = true;
+            if (thisFile.selectedSeqs != NULL) { saveSeq = (thisFile.selectedSeqs->count(name) != 0); }
+            else if (hasGroups && thisFile.readGroups && (thisFile.rowItems.size() == 0)) { saveSeq = false; }
+
+            if (saveSeq) {
+                addRow(name, thisTotal, thisFile.rowItems);
+                total += thisTotal;
+                uniques++;
             }
-            
-            map<string, int>::iterator it = indexNameMap.find(name);
-            if (it == indexNameMap.end()) {
-                bool saveSeq = true;
-                if (selectedSeqs.count(name) == 0) { //don't save
-                    saveSeq = false;
-                }
-                if (saveSeq) {
-                    if (hasGroups && readGroups) {
-                        vector<countTableItem> thisGroupsCount = compressAbunds(groupCounts);
-                        counts.push_back(thisGroupsCount);
-                    }
-                    indexNameMap[name] = uniques;
-                    totals.push_back(thisTotal);
-                    total += thisTotal;
-                    uniques++;
-                }
-            }else {
-                error = true;
-                m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + name + ", sequence names must be unique. Please correct.\n");
+        }else {
+            thisFile.error = true;
+            m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + name + ", sequence names must be unique. Please correct.\n");
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "addFileRow");
+        exit(1);
+    }
+}
+/************************************************************/
+//the size, time and a hash of the first and last 64KB of the file, so a binary copy is only used for the text it was written with
+unsigned long long CountTable::getTextStamp(string file, unsigned long long& size, unsigned long long& time) {
+    try {
+        size = 0; time = 0;
+
+#if defined NON_WINDOWS
+        struct stat fileInfo;
+        if (stat(file.c_str(), &fileInfo) == -1) { return 0; }
+        size = fileInfo.st_size;
+    #if defined __APPLE__
+        time = (unsigned long long)fileInfo.st_mtimespec.tv_sec * 1000000000ULL + fileInfo.st_mtimespec.tv_nsec;
+    #else
+        time = (unsigned long long)fileInfo.st_mtim.tv_sec * 1000000000ULL + fileInfo.st_mtim.tv_nsec;
+    #endif
+#endif
+
+        ifstream in(file.c_str(), ios::binary);
+        if (!in) { return 0; }
+
+#if !defined NON_WINDOWS
+        in.seekg(0, ios::end);
+        size = (unsigned long long)in.tellg();
+        in.seekg(0, ios::beg);
+#endif
+
+        unsigned long long blockSize = 65536;
+        unsigned long long firstBytes = min(size, blockSize);
+        unsigned long long lastStart = max(firstBytes, (size > blockSize ? size - blockSize : 0));
+
+        string ends(firstBytes + (size - lastStart), '\0');
+        in.read(&ends[0], firstBytes);
+        in.seekg(lastStart);
+        in.read(&ends[firstBytes], size - lastStart);
+        in.close();
+
+        return Dereplicator::hashString(ends.data(), ends.length());
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "CountTable", "getTextStamp");
+        exit(1);
+    }
+}
+/************************************************************/
+//writes the rows printed to file, with the abundances by column of the printed file
+void CountTable::writeBinaryFile(string file, bool compressed, vector<string>& columnGroups, vector<int>& rows, vector<int>& rowTotals, vector<int>& groupToColumn) {
+    try {
+        file = util.getFullPathName(file);
+
+        unsigned long long textSize, textTime;
+        unsigned long long textHash = getTextStamp(file, textSize, textTime);
+
+        vector<unsigned long long> groupOffsets(1, 0), nameOffsets(1, 0), itemOffsets(1, 0);
+        string groupBytes, nameBytes;
+        for (int i = 0; i < columnGroups.size(); i++) { groupBytes += columnGroups[i]; groupOffsets.push_back(groupBytes.length()); }
+
+        vector<countTableItem> fileItems;
+        for (int i = 0; i < rows.size(); i++) {
+            int row = rows[i];
+            nameBytes.append(nameArena, nameStarts[row], nameLengths[row]);
+            nameOffsets.push_back(nameBytes.length());
+
+            for (long long j = rowStarts[row]; j < rowStarts[row]+rowLengths[row]; j++) {
+                int column = groupToColumn[items[j].group];
+                if ((column != -1) && (items[j].abund != 0)) { fileItems.push_back(countTableItem(items[j].abund, column)); }
             }
+            itemOffsets.push_back(fileItems.size());
         }
+
+        unsigned int fileVersion = COUNTTABLE_BINARY_VERSION;
+        unsigned int flags = 0;
+        if (compressed)                 { flags |= 1; }
+        if (columnGroups.size() != 0)   { flags |= 2; }
+        unsigned long long counts[5] = { columnGroups.size(), rows.size(), fileItems.size(), nameBytes.length(), groupBytes.length() };
+
+        ofstream out;
+        util.openOutputFileBinary(CountTableBinaryFile::getFileName(file), out);
+
+        out.write(COUNTTABLE_BINARY_MAGIC, 8);
+        out.write((char*)&fileVersion, sizeof(unsigned int));
+        out.write((char*)&flags, sizeof(unsigned int));
+        out.write((char*)&textSize, sizeof(unsigned long long));
+        out.write((char*)&textTime, sizeof(unsigned long long));
+        out.write((char*)&textHash, sizeof(unsigned long long));
+        out.write((char*)counts, sizeof(counts));
+
+        out.write((char*)groupOffsets.data(), groupOffsets.size()*sizeof(unsigned long long));
+        out.write(groupBytes.data(), groupBytes.length()); writePadding(out, groupBytes.length());
+
+        out.write((char*)nameOffsets.data(), nameOffsets.size()*sizeof(unsigned long long));
+        out.write(nameBytes.data(), nameBytes.length()); writePadding(out, nameBytes.length());
+
+        out.write((char*)rowTotals.data(), rowTotals.size()*sizeof(int)); writePadding(out, rowTotals.size()*sizeof(int));
+
+        out.write((char*)itemOffsets.data(), itemOffsets.size()*sizeof(unsigned long long));
+        out.write((char*)fileItems.data(), fileItems.size()*sizeof(countTableItem));
+        out.close();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "writeBinaryFile");
+        exit(1);
+    }
+}
+/************************************************************/
+//returns false without changing the table if there is no binary copy of file, or it was written for a different version of the text
+bool CountTable::readBinaryFile(string file, countTableFile& thisFile, vector<string>& selectedGroups) {
+    try {
+        file = util.getFullPathName(file);
+        string binaryFileName = CountTableBinaryFile::getFileName(file);
+
+        const char* data = NULL;
+        unsigned long long dataSize = 0;
+
+#if defined NON_WINDOWS
+        int fd = open(binaryFileName.c_str(), O_RDONLY);
+        if (fd == -1) { return false; }
+        struct stat fileInfo;
+        if ((fstat(fd, &fileInfo) == -1) || (fileInfo.st_size < 80)) { close(fd); return false; }
+
+        dataSize = fileInfo.st_size;
+        void* mapped = mmap(NULL, dataSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) { return false; }
+        data = (const char*)mapped;
+#else
+        ifstream in(binaryFileName.c_str(), ios::binary);
+        if (!in) { return false; }
+        in.seekg(0, ios::end);
+        dataSize = (unsigned long long)in.tellg();
+        in.seekg(0, ios::beg);
+        if (dataSize < 80) { in.close(); return false; }
+
+        vector<unsigned long long> buffer((dataSize + 7) / 8); //8 byte aligned
+        in.read((char*)buffer.data(), dataSize);
+        if (!in) { in.close(); return false; }
         in.close();
-        
-        if (error) { m->setControl_pressed(true); }
-        else { //check for zero groups
-            if (hasGroups && readGroups) {
-                for (int i = 0; i < totalGroups.size(); i++) {
-                    if (totalGroups[i] == 0) { m->mothurOut("\nRemoving group: " + groups[i] + " because all sequences have been removed.\n"); removeGroup(groups[i]); i--; }
-                }
+        data = (const char*)buffer.data();
+#endif
+
+        unsigned int fileVersion = 0, flags = 0;
+        unsigned long long fileTextSize = 0, fileTextTime = 0, fileTextHash = 0;
+        unsigned long long counts[5];
+        memcpy(&fileVersion, data + 8, sizeof(unsigned int));
+        memcpy(&flags, data + 12, sizeof(unsigned int));
+        memcpy(&fileTextSize, data + 16, sizeof(unsigned long long));
+        memcpy(&fileTextTime, data + 24, sizeof(unsigned long long));
+        memcpy(&fileTextHash, data + 32, sizeof(unsigned long long));
+        memcpy(counts, data + 40, sizeof(counts));
+        unsigned long long numColumns = counts[0], numRows = counts[1], numItems = counts[2], nameBytes = counts[3], groupBytes = counts[4];
+
+        unsigned long long textSize, textTime;
+        unsigned long long textHash = getTextStamp(file, textSize, textTime);
+
+        //find the sections, the file must be exactly the size they add up to
+        unsigned long long groupOffsetsStart = 80;
+        unsigned long long groupBytesStart = groupOffsetsStart + (numColumns+1)*sizeof(unsigned long long);
+        unsigned long long nameOffsetsStart = groupBytesStart + padTo8(groupBytes);
+        unsigned long long nameBytesStart = nameOffsetsStart + (numRows+1)*sizeof(unsigned long long);
+        unsigned long long totalsStart = nameBytesStart + padTo8(nameBytes);
+        unsigned long long itemOffsetsStart = totalsStart + padTo8(numRows*sizeof(int));
+        unsigned long long itemsStart = itemOffsetsStart + (numRows+1)*sizeof(unsigned long long);
+        unsigned long long expectedSize = itemsStart + numItems*sizeof(countTableItem);
+
+        bool good = ((strncmp(data, COUNTTABLE_BINARY_MAGIC, 8) == 0) && (fileVersion == COUNTTABLE_BINARY_VERSION));
+        good = good && (fileTextSize == textSize) && (fileTextTime == textTime) && (fileTextHash == textHash);
+        good = good && (numColumns < dataSize) && (numRows < dataSize) && (numItems < dataSize) && (nameBytes < dataSize) && (groupBytes < dataSize) && (expectedSize == dataSize);
+
+        const unsigned long long* groupOffsets = (const unsigned long long*)(data + groupOffsetsStart);
+        const unsigned long long* nameOffsets = (const unsigned long long*)(data + nameOffsetsStart);
+        const unsigned long long* itemOffsets = (const unsigned long long*)(data + itemOffsetsStart);
+        const int* fileTotals = (const int*)(data + totalsStart);
+        const countTableItem* fileItems = (const countTableItem*)(data + itemsStart);
+
+        if (good) { //offsets must stay inside their sections
+            for (unsigned long long i = 0; i < numColumns; i++) { if ((groupOffsets[i] > groupOffsets[i+1]) || (groupOffsets[i+1] > groupBytes)) { good = false; break; } }
+            for (unsigned long long i = 0; i < numRows; i++) {
+                if ((nameOffsets[i] > nameOffsets[i+1]) || (nameOffsets[i+1] > nameBytes) || (itemOffsets[i] > itemOffsets[i+1]) || (itemOffsets[i+1] > numItems)) { good = false; break; }
             }
         }
-        
-        //if the file has groups, but we didn't read them
-         if (!readGroups) { hasGroups = false; }
-        
-        return 0;
+
+        if (good) {
+            if ((flags & 1) != 0) { isCompressed = true; }
+
+            vector<string> columnGroups;
+            for (unsigned long long i = 0; i < numColumns; i++) { columnGroups.push_back(string(data + groupBytesStart + groupOffsets[i], groupOffsets[i+1] - groupOffsets[i])); }
+            setFileGroups(thisFile, columnGroups, selectedGroups);
+
+            vector<countTableItem> columnItems;
+            for (unsigned long long i = 0; i < numRows; i++) {
+                if (m->getControl_pressed()) { break; }
+
+                string name(data + nameBytesStart + nameOffsets[i], nameOffsets[i+1] - nameOffsets[i]);
+                columnItems.assign(fileItems + itemOffsets[i], fileItems + itemOffsets[i+1]);
+
+                addFileRow(thisFile, name, fileTotals[i], columnItems);
+            }
+        }
+
+#if defined NON_WINDOWS
+        munmap((void*)data, dataSize);
+#endif
+
+        return good;
     }
     catch(exception& e) {
-        m->errorOut(e, "CountTable", "readTable");
+        m->errorOut(e, "CountTable", "readBinaryFile");
         exit(1);
     }
 }
@@ -784,14 +888,13 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, set<
 
 int CountTable::zeroOutTable() {
   try {
-
-		for(int i=0;i<counts.size();i++){
-			for(int j=0;j<counts[0].size();j++){
-                counts[j].clear();
-			}
-		}
+        items.clear();
+        rowStarts.assign(totals.size(), 0);
+        rowLengths.assign(totals.size(), 0);
+        numUnusedItems = 0;
 
 		totals.assign(totals.size(), 0);
+        clearViews();
 
 		return 0;
 	}
@@ -808,62 +911,30 @@ int CountTable::clearTable() {
         total = 0;
         uniques = 0;
         groups.clear();
-        counts.clear();
         totals.clear();
         totalGroups.clear();
-        indexNameMap.clear();
         indexGroupMap.clear();
-        
-        return 0;
-    }
-    catch(exception& e) {
-        m->errorOut(e, "CountTable", "clearTable");
-        exit(1);
-    }
-}
-/************************************************************/
-//zeroed reads are not printed
-vector<string> CountTable::printTable(string file) {
-    try {
-        
-        //remove group if all reads are removed
-        for (int i = 0; i < totalGroups.size(); i++) {
-            if (totalGroups[i] == 0) { m->mothurOut("\nRemoving group: " + groups[i] + " because all sequences have been removed.\n"); removeGroup(groups[i]); i--; }
-        }
-        
-        if (isCompressed) { return printCompressedTable(file); }
-        
-        ofstream out;
-        util.openOutputFile(file, out);
-        
-        vector<string> namesInTable;
-        
-        if (total != 0) {
-            printHeaders(out);
-            
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            for (int i = 0; i < totals.size(); i++) {
-                if (totals[i] != 0) {
-
-                    map<int, string>::iterator itR = reverse.find(i);
-                
-                    if (itR != reverse.end()) {
-                        
-                        namesInTable.push_back(itR->second);
-                        
-                        out << itR->second << '\t' << totals[i];
-                        
-                        if (hasGroups) { printGroupAbunds(out, i); }
-                        
-                        out << endl;
-                    }
-                }
-            }
-        }
-        out.close();
-        return namesInTable;
+
+        nameArena.clear(); nameStarts.clear(); nameLengths.clear();
+        nameSlots.assign(1024, 0);
+        numNamed = 0; numNameSlotsUsed = 0;
+
+        items.clear(); rowStarts.clear(); rowLengths.clear();
+        numUnusedItems = 0;
+        clearViews();
+
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "clearTable");
+        exit(1);
+    }
+}
+/************************************************************/
+//zeroed reads are not printed
+vector<string> CountTable::printTable(string file) {
+    try {
+        return printTable(file, isCompressed);
     }
 	catch(exception& e) {
 		m->errorOut(e, "CountTable", "printTable");
@@ -874,34 +945,34 @@ vector<string> CountTable::printTable(string file) {
 //zeroed reads are not printed
 vector<string> CountTable::printNoGroupsTable(string file) {
     try {
-        
+
         ofstream out;
         util.openOutputFile(file, out);
-        
+
         vector<string> namesInTable;
-        
+        vector<int> rows, rowTotals;
+
         if (total != 0) {
             vector<string> headers = getHardCodedHeaders();
             out << headers[0] << '\t' << headers[1] << endl;
-            
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
+
             for (int i = 0; i < totals.size(); i++) {
-                if (totals[i] != 0) {
-
-                    map<int, string>::iterator itR = reverse.find(i);
-                
-                    if (itR != reverse.end()) {
-                        
-                        namesInTable.push_back(itR->second);
-                        
-                        out << itR->second << '\t' << totals[i] << endl;
-                    }
+                if ((totals[i] != 0) && isNamed(i)) {
+                    string name = getName(i);
+                    namesInTable.push_back(name);
+
+                    out << name << '\t' << totals[i] << '\n';
+                    rows.push_back(i); rowTotals.push_back(totals[i]);
                 }
             }
         }
         out.close();
+
+        vector<string> columnGroups;
+        vector<int> groupToColumn(groups.size(), -1);
+        if (total != 0) { writeBinaryFile(file, false, columnGroups, rows, rowTotals, groupToColumn); }
+        else { CountTableBinaryFile::remove(file); }
+
         return namesInTable;
     }
     catch(exception& e) {
@@ -913,44 +984,49 @@ vector<string> CountTable::printNoGroupsTable(string file) {
 //zeroed reads are not printed
 vector<string> CountTable::printTable(string file, bool compressedFormat) {
     try {
-        
+
         //remove group if all reads are removed
         for (int i = 0; i < totalGroups.size(); i++) {
             if (totalGroups[i] == 0) { m->mothurOut("\nRemoving group: " + groups[i] + " because all sequences have been removed.\n"); removeGroup(groups[i]); i--; }
         }
-        
+
         if (compressedFormat) { return printCompressedTable(file); }
-        
+
         ofstream out;
         util.openOutputFile(file, out);
-        
+
         vector<string> namesInTable;
-        
+        vector<int> rows, rowTotals;
+
         if (total != 0) {
             printHeaders(out);
-            
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
+
             for (int i = 0; i < totals.size(); i++) {
-                
-                if (totals[i] != 0) {
-                    
-                    map<int, string>::iterator itR = reverse.find(i);
-                    
-                    if (itR != reverse.end()) {
-                        namesInTable.push_back(itR->second);
-                        
-                        out << itR->second << '\t' << totals[i];
-                        
-                        if (hasGroups) { printGroupAbunds(out, i); }
-                        
-                        out << endl;
-                    }
+
+                if ((totals[i] != 0) && isNamed(i)) {
+                    string name = getName(i);
+                    namesInTable.push_back(name);
+
+                    out << name << '\t' << totals[i];
+
+                    if (hasGroups) { printGroupAbunds(out, i); }
+
+                    out << '\n';
+                    rows.push_back(i); rowTotals.push_back(totals[i]);
                 }
             }
         }
         out.close();
+
+        vector<string> columnGroups;
+        vector<int> groupToColumn(groups.size(), -1);
+        if (hasGroups) {
+            columnGroups = groups;
+            for (int i = 0; i < groups.size(); i++) { groupToColumn[i] = i; }
+        }
+        if (total != 0) { writeBinaryFile(file, false, columnGroups, rows, rowTotals, groupToColumn); }
+        else { CountTableBinaryFile::remove(file); }
+
         return namesInTable;
     }
     catch(exception& e) {
@@ -964,89 +1040,90 @@ vector<string> CountTable::printCompressedTable(string file, vector<string> grou
     try {
         ofstream out;
         util.openOutputFile(file, out);
-        
+
         vector<string> namesInTable;
-        
+        vector<int> rows, rowTotals;
+
         bool pickedGroups = false;
-        set<int> selectedGroupsIndicies;
         if (groupsToPrint.size() != 0) { if (hasGroups) { pickedGroups = true; } } //if no groups selected, print all groups
-        
+
         if (total != 0) {
-            if (hasGroups) {
-                
-                map<int, string> reverse;
-                for (map<string, int>::iterator it = indexGroupMap.begin(); it !=indexGroupMap.end(); it++) { reverse[it->second] = it->first; }
-                
-                map<int, string>::iterator it = reverse.begin();
-                string group1Name = it->second;
+            if (hasGroups && (groups.size() != 0)) {
+
+                string group1Name = groups[0];
                 if (pickedGroups) { //find selected groups indicies
-                    for (map<int, string>::iterator it = reverse.begin(); it != reverse.end(); it++) {
-                        if (util.inUsersGroups(it->second, groupsToPrint)) { group1Name = it->second; break; }
+                    for (int i = 0; i < groups.size(); i++) {
+                        if (util.inUsersGroups(groups[i], groupsToPrint)) { group1Name = groups[i]; break; }
                     }
                 }
-                
+
                 out << "#Compressed Format: groupIndex,abundance. For example 1,6 would mean the read has an abundance of 6 for group " + group1Name + "." << endl;
                 out << "#";
-                
-                for (map<int, string>::iterator it = reverse.begin(); it != reverse.end(); it++) {
+
+                for (int i = 0; i < groups.size(); i++) {
                     if (pickedGroups) { //find selected groups indicies
-                        if (util.inUsersGroups(it->second, groupsToPrint)) {
-                            selectedGroupsIndicies.insert(it->first);
-                            
-                            out << it->first+1 << "," << it->second << "\t";
-                        }
-                    }else { out << it->first+1 << "," << it->second << "\t"; }
+                        if (util.inUsersGroups(groups[i], groupsToPrint)) { out << i+1 << "," << groups[i] << "\t"; }
+                    }else { out << i+1 << "," << groups[i] << "\t"; }
                 }
                 out << endl;
             }
-            
+        }
+
+        //the columns printed, and where the group of an item is printed
+        vector<string> columnGroups;
+        vector<int> groupToColumn;
+
+        if (total != 0) {
             printHeaders(out, groupsToPrint);
-            
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
+
+            groupToColumn.assign(groups.size(), -1);
+            if (hasGroups) {
+                for (int i = 0; i < groups.size(); i++) {
+                    if (!pickedGroups || util.inUsersGroups(groups[i], groupsToPrint)) { groupToColumn[i] = columnGroups.size(); columnGroups.push_back(groups[i]); }
+                }
+            }
+
             for (int i = 0; i < totals.size(); i++) {
-                if (totals[i] != 0) {
+                if ((totals[i] != 0) && isNamed(i)) {
                     if (pickedGroups) {
                         string groupOutput = "";
                         long long thisTotal = 0;
-                        for (int j = 0; j < counts[i].size(); j++) {
-                            if (selectedGroupsIndicies.count(counts[i][j].group) != 0) { //this is a group we want
-                                groupOutput += '\t' + toString(counts[i][j].group+1) + ',' + toString(counts[i][j].abund);
-                                thisTotal += counts[i][j].abund;
+                        for (long long j = rowStarts[i]; j < rowStarts[i]+rowLengths[i]; j++) {
+                            if (groupToColumn[items[j].group] != -1) { //this is a group we want
+                                groupOutput += '\t' + toString(items[j].group+1) + ',' + toString(items[j].abund);
+                                thisTotal += items[j].abund;
                             }
                         }
-                        
+
                         if (thisTotal != 0) {
-                            map<int, string>::iterator itR = reverse.find(i);
-                            
-                            if (itR != reverse.end()) {
-                                namesInTable.push_back(itR->second);
-                                
-                                out << itR->second << '\t' << thisTotal << groupOutput << endl;
-                            }
+                            string name = getName(i);
+                            namesInTable.push_back(name);
+
+                            out << name << '\t' << thisTotal << groupOutput << '\n';
+                            rows.push_back(i); rowTotals.push_back((int)thisTotal);
                         }
                     }
                     else {
-                        map<int, string>::iterator itR = reverse.find(i);
-                        
-                        if (itR != reverse.end()) {
-                            namesInTable.push_back(itR->second);
-                            
-                            out << itR->second << '\t' << totals[i];
-                            if (hasGroups) {
-                                for (int j = 0; j < counts[i].size(); j++) {
-                                    out  << '\t' << counts[i][j].group+1 << ',' << counts[i][j].abund;
-                                }
+                        string name = getName(i);
+                        namesInTable.push_back(name);
+
+                        out << name << '\t' << totals[i];
+                        if (hasGroups) {
+                            for (long long j = rowStarts[i]; j < rowStarts[i]+rowLengths[i]; j++) {
+                                out  << '\t' << items[j].group+1 << ',' << items[j].abund;
                             }
-                            out << endl;
                         }
+                        out << '\n';
+                        rows.push_back(i); rowTotals.push_back(totals[i]);
                     }
                 }
             }
         }
         out.close();
-        
+
+        if (total != 0) { writeBinaryFile(file, (hasGroups && (groups.size() != 0)), columnGroups, rows, rowTotals, groupToColumn); }
+        else { CountTableBinaryFile::remove(file); }
+
         return namesInTable;
     }
     catch(exception& e) {
@@ -1058,18 +1135,19 @@ vector<string> CountTable::printCompressedTable(string file, vector<string> grou
 //returns index of countTableItem for group passed in. If group is not present in seq, returns index of next group or -1
 int CountTable::find(int seq, int group, bool returnNext) {
     try {
-        
+
         //if (!returnNext) { return find(seq, group); }
         int index = -1;
-        
-        for (int i = 0; i < counts[seq].size(); i++) {
-            if (counts[seq][i].group >= group) { //found it or done looking
-                
-                if (counts[seq][i].group == group) { index = i;  }
+
+        const countTableItem* row = items.data() + rowStarts[seq];
+        for (int i = 0; i < rowLengths[seq]; i++) {
+            if (row[i].group >= group) { //found it or done looking
+
+                if (row[i].group == group) { index = i;  }
                 break;
             }
         }
-        
+
         return index;
     }
     catch(exception& e) {
@@ -1081,11 +1159,11 @@ int CountTable::find(int seq, int group, bool returnNext) {
 int CountTable::getAbund(int seq, int group) {
     try {
         int index = find(seq, group, false);
-        
+
         if (index != -1) { //this seq has a non zero abundance for this group
-            return counts[seq][index].abund;
+            return items[rowStarts[seq]+index].abund;
         }
-        
+
         return 0;
     }
     catch(exception& e) {
@@ -1097,11 +1175,11 @@ int CountTable::getAbund(int seq, int group) {
 vector<int> CountTable::expandAbunds(vector<countTableItem>& items) {
     try {
         vector<int> abunds; abunds.resize(groups.size(), 0); //prefill with 0's
-        
+
         for (int i = 0; i < items.size(); i++) { //for each non zero entry
             abunds[items[i].group] = items[i].abund; //set abund for group
         }
-        
+
         return abunds;
     }
     catch(exception& e) {
@@ -1113,12 +1191,11 @@ vector<int> CountTable::expandAbunds(vector<countTableItem>& items) {
 vector<int> CountTable::expandAbunds(int index) {
     try {
         vector<int> abunds; abunds.resize(groups.size(), 0); //prefill with 0's
-        
-        
-        for (int i = 0; i < counts[index].size(); i++) { //for each non zero entry
-            abunds[counts[index][i].group] = counts[index][i].abund; //set abund for group
+
+        for (long long i = rowStarts[index]; i < rowStarts[index]+rowLengths[index]; i++) { //for each non zero entry
+            abunds[items[i].group] = items[i].abund; //set abund for group
         }
-        
+
         return abunds;
     }
     catch(exception& e) {
@@ -1131,14 +1208,14 @@ vector<int> CountTable::expandAbunds(int index) {
 vector<countTableItem> CountTable::compressAbunds(vector<int> abunds) {
     try {
         vector<countTableItem> row;
-        
+
         for (int i = 0; i < abunds.size(); i++) {
             if (abunds[i] != 0) {
                 countTableItem thisAbund(abunds[i], i);
                 row.push_back(thisAbund);
             }
         }
-        
+
         return row;
     }
     catch(exception& e) {
@@ -1149,9 +1226,9 @@ vector<countTableItem> CountTable::compressAbunds(vector<int> abunds) {
 /************************************************************/
 void CountTable::printGroupAbunds(ofstream& out, int index) {
     try {
-        
+
         vector<int> abunds = expandAbunds(index);
-        
+
         for (int i = 0; i < abunds.size(); i++) { out << '\t' << abunds[i]; }
     }
     catch(exception& e) {
@@ -1166,29 +1243,40 @@ vector<string> CountTable::printSortedTable(string file) {
         for (int i = 0; i < totalGroups.size(); i++) {
             if (totalGroups[i] == 0) { m->mothurOut("\nRemoving group: " + groups[i] + " because all sequences have been removed.\n"); removeGroup(groups[i]); i--; }
         }
-        
+
         ofstream out;
         util.openOutputFile(file, out);
         printHeaders(out);
-        
+
         vector<string> namesInTable;
-        
-        for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) {
-            string seqName = it->first;
-            int index = it->second;
-            
+        vector<int> rows, rowTotals;
+
+        vector<int>& sorted = getSortedRows();
+        for (int i = 0; i < sorted.size(); i++) {
+            int index = sorted[i];
+
             if (totals[index] != 0) {
+                string seqName = getName(index);
                 namesInTable.push_back(seqName);
-                
+
                 out << seqName << '\t' << totals[index];
                 if (hasGroups) {
                     printGroupAbunds(out, index);
                 }
-                out << endl;
+                out << '\n';
+                rows.push_back(index); rowTotals.push_back(totals[index]);
             }
         }
         out.close();
-        
+
+        vector<string> columnGroups;
+        vector<int> groupToColumn(groups.size(), -1);
+        if (hasGroups) {
+            columnGroups = groups;
+            for (int i = 0; i < groups.size(); i++) { groupToColumn[i] = i; }
+        }
+        writeBinaryFile(file, false, columnGroups, rows, rowTotals, groupToColumn);
+
         return namesInTable;
     }
     catch(exception& e) {
@@ -1215,10 +1303,10 @@ int CountTable::printHeaders(ofstream& out, vector<string> selectedGroups) {
         for (int i = 0; i < totalGroups.size(); i++) {
             if (totalGroups[i] == 0) { m->mothurOut("\nRemoving group: " + groups[i] + " because all sequences have been removed.\n"); removeGroup(groups[i]); i--; }
         }
-        
+
         bool pickedGroups = false;
         if (selectedGroups.size() != 0) { pickedGroups = true; }
-        
+
         out << "Representative_Sequence\ttotal";
         if (hasGroups) {
             for (int i = 0; i < groups.size(); i++) {
@@ -1239,15 +1327,15 @@ int CountTable::printHeaders(ofstream& out, vector<string> selectedGroups) {
 /************************************************************/
 int CountTable::printSeq(ofstream& out, string seqName) {
     try {
-		map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(seqName);
+        if (row == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            if (totals[it->second] != 0) {
-                out << it->first << '\t' << totals[it->second];
-                
-                if (hasGroups) { printGroupAbunds(out, it->second); }
-                
+            if (totals[row] != 0) {
+                out << seqName << '\t' << totals[row];
+
+                if (hasGroups) { printGroupAbunds(out, row); }
+
                 out << endl;
             }
         }
@@ -1261,10 +1349,10 @@ int CountTable::printSeq(ofstream& out, string seqName) {
 /************************************************************/
 SharedRAbundVectors* CountTable::getShared(vector<string> selected, map<string, string>& seqNameToOtuName) {
     try {
-        
+
         if (selected.size() == 0) {}
         else { setNamesOfGroups(selected); }
-        
+
         return getShared(seqNameToOtuName);
     }
     catch(exception& e) {
@@ -1276,29 +1364,34 @@ SharedRAbundVectors* CountTable::getShared(vector<string> selected, map<string,
 SharedRAbundVectors* CountTable::getShared(map<string, string>& seqNameToOtuName) {
     try {
         SharedRAbundVectors* lookup = new SharedRAbundVectors();
-        
+
         if (hasGroups) {
             for (int i = 0; i < groups.size(); i++) { //create blank rabunds for each group
                 SharedRAbundVector* thisGroupsRabund = new SharedRAbundVector();
                 thisGroupsRabund->setGroup(groups[i]);
                 lookup->push_back(thisGroupsRabund);
             }
-            
+
             //generate OTULabels
             vector<string> otuNames;
-            util.getOTUNames(otuNames, counts.size(), "Otu");
-            
-            //create name map for seq -> otuName for use by other commands with associated files
-            for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) { seqNameToOtuName[it->first] = otuNames[it->second]; }
-            
+            util.getOTUNames(otuNames, totals.size(), "Otu");
+
+            //create name map for seq -> otuName for use by other commands with associated files, the names are in order so each insert is at the end
+            bool emptyMap = (seqNameToOtuName.size() == 0);
+            vector<int>& sorted = getSortedRows();
+            for (int i = 0; i < sorted.size(); i++) {
+                if (emptyMap)   { seqNameToOtuName.emplace_hint(seqNameToOtuName.end(), getName(sorted[i]), otuNames[sorted[i]]); }
+                else            { seqNameToOtuName[getName(sorted[i])] = otuNames[sorted[i]]; }
+            }
+
             //add each "otu"
-            for (int i = 0; i < counts.size(); i++) {
+            for (int i = 0; i < totals.size(); i++) {
                 vector<int> abunds = expandAbunds(i);
                 lookup->push_back(abunds, otuNames[i]);
             }
-            
+
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
-        
+
 
         return lookup;
     }
@@ -1312,8 +1405,8 @@ SharedRAbundVectors* CountTable::getShared(map<string, string>& seqNameToOtuName
 vector<int> CountTable::getGroupCounts(string seqName) {
     try {
         vector<countTableItem> temp = getItems(seqName);
-        return (expandAbunds(temp)); 
-        
+        return (expandAbunds(temp));
+
     }
 	catch(exception& e) {
 		m->errorOut(e, "CountTable", "getGroupCounts");
@@ -1326,18 +1419,18 @@ vector<countTableItem> CountTable::getItems(string seqName) {
     try {
         vector<countTableItem> temp;
         if (hasGroups) {
-            map<string, int>::iterator it = indexNameMap.find(seqName);
-            if (it == indexNameMap.end()) {
+            int row = findName(seqName);
+            if (row == -1) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
-                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                 }
                 m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                temp = counts[it->second];
+                temp.assign(items.begin()+rowStarts[row], items.begin()+rowStarts[row]+rowLengths[row]);
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n"); m->setControl_pressed(true); }
-        
+
         return temp;
     }
     catch(exception& e) {
@@ -1374,15 +1467,15 @@ int CountTable::getGroupCount(string seqName, string groupName) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: group " + groupName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                map<string, int>::iterator it2 = indexNameMap.find(seqName);
-                if (it2 == indexNameMap.end()) {
+                int row = findName(seqName);
+                if (row == -1) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (util.inUsersGroups(seqName, groups)) {
-                        m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                        m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                     }
                     m->mothurOut("[ERROR]: seq " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
                 }else {
-                    return expandAbunds(it2->second)[it->second];
+                    return getAbund(row, it->second);
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
@@ -1403,29 +1496,31 @@ int CountTable::setAbund(string seqName, string groupName, int num) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + groupName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                map<string, int>::iterator it2 = indexNameMap.find(seqName);
-                if (it2 == indexNameMap.end()) {
+                int row = findName(seqName);
+                if (row == -1) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (util.inUsersGroups(seqName, groups)) {
-                        m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                        m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                     }
                     m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
                 }else {
-                    int indexOfGroup = find(it2->second, it->second, false);
+                    int indexOfGroup = find(row, it->second, false);
                     int oldCount = 0;
-                    
+
                     if (indexOfGroup == -1) { //create item for this group
-                        countTableItem newItem(num, it->second);
-                        counts[it2->second].push_back(newItem);
-                        sortRow(it2->second);
+                        vector<countTableItem> rowItems(items.begin()+rowStarts[row], items.begin()+rowStarts[row]+rowLengths[row]);
+                        rowItems.push_back(countTableItem(num, it->second));
+                        sort(rowItems.begin(), rowItems.end(), compareGroups);
+                        setRow(row, rowItems);
                     }else { //update total for group
-                        oldCount = counts[it2->second][indexOfGroup].abund;
-                        counts[it2->second][indexOfGroup].abund = num;
+                        oldCount = items[rowStarts[row]+indexOfGroup].abund;
+                        items[rowStarts[row]+indexOfGroup].abund = num;
+                        clearViews();
                     }
-                    
+
                     totalGroups[it->second] += (num - oldCount);
                     total += (num - oldCount);
-                    totals[it2->second] += (num - oldCount);
+                    totals[row] += (num - oldCount);
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
@@ -1445,8 +1540,7 @@ int CountTable::addGroup(string groupName) {
         if (sanity) { m->mothurOut("[ERROR]: " + groupName + " is already in the count table, cannot add again.\n"); m->setControl_pressed(true);  return 0; }
 
         groups.push_back(groupName);
-        if (!hasGroups) { counts.resize(uniques);  }
-        
+
         totalGroups.push_back(0);
         indexGroupMap[groupName] = groups.size()-1;
         map<string, int> originalGroupMap = indexGroupMap;
@@ -1456,14 +1550,20 @@ int CountTable::addGroup(string groupName) {
 
         //fix indexGroupMap && totalGroups
         vector<int> newTotals; newTotals.resize(groups.size(), 0);
+        vector<int> newIndexes(groups.size(), 0); //original index -> sorted index
         for (int i = 0; i < groups.size(); i++) {
             indexGroupMap[groups[i]] = i;
             //find original spot of group[i]
             int index = originalGroupMap[groups[i]];
             newTotals[i] = totalGroups[index];
+            newIndexes[index] = i;
         }
         totalGroups = newTotals;
 
+        //the items keep the groups sorted
+        for (int i = 0; i < items.size(); i++) { items[i].group = newIndexes[items[i].group]; }
+        clearViews();
+
         hasGroups = true;
 
         return 0;
@@ -1478,17 +1578,11 @@ int CountTable::addGroup(string groupName) {
 int CountTable::removeGroup(string groupName) {
     try {
         if (hasGroups) {
-            //save for later in case removing a group means we need to remove a seq.
-            map<int, string> reverse;
-            map<string, int>::iterator it;
-            for (it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            it = indexGroupMap.find(groupName);
+            map<string, int>::iterator it = indexGroupMap.find(groupName);
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + groupName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
                 int indexOfGroupToRemove = it->second;
-                map<string, int> currentGroupIndex = indexGroupMap;
                 vector<string> newGroups;
                 for (int i = 0; i < groups.size(); i++) {
                     if (groups[i] != groupName) {
@@ -1499,53 +1593,50 @@ int CountTable::removeGroup(string groupName) {
                 indexGroupMap.erase(groupName);
                 groups = newGroups;
                 totalGroups.erase(totalGroups.begin()+indexOfGroupToRemove);
-                
-                int thisIndex = 0;
-                map<string, int> newIndexNameMap;
-                for (int i = 0; i < counts.size(); i++) {
-                    
+
+                vector<bool> keep(totals.size(), true);
+                bool removedRows = false;
+                for (int i = 0; i < totals.size(); i++) {
+
                     if (m->getControl_pressed()) { break; }
-                    
+
+                    countTableItem* row = items.data() + rowStarts[i];
+                    int length = rowLengths[i];
+
                     int indexOfGroup = -1; bool found = false;
-                    for (int j = 0; j < counts[i].size(); j++) {
-                        if (counts[i][j].group >= indexOfGroupToRemove) { //found it or done looking
-                            
+                    for (int j = 0; j < length; j++) {
+                        if (row[j].group >= indexOfGroupToRemove) { //found it or done looking
+
                             indexOfGroup = j;
-                            if (counts[i][j].group == indexOfGroupToRemove) {   found = true; }
+                            if (row[j].group == indexOfGroupToRemove) {   found = true; }
                             break;
                         }
                     }
-                    
+                    if (indexOfGroup == -1) { continue; } //all this seqs groups are before the group removed
+
                     if (found) { //you have an abundance for this group
-                        int num = counts[i][indexOfGroup].abund;
-                        counts[i].erase(counts[i].begin()+indexOfGroup);
+                        int num = row[indexOfGroup].abund;
+                        for (int j = indexOfGroup; j < length-1; j++) { row[j] = row[j+1]; }
+                        rowLengths[i]--; length--; numUnusedItems++;
                         totals[i] -= num;
                         total -= num;
-                        
+
                         if (totals[i] == 0) { //your sequences are only from the group we want to remove, then remove you.
-                            counts.erase(counts.begin()+i);
-                            totals.erase(totals.begin()+i);
-                            uniques--;
-                            i--;
-                            if (i == -1) { i = 0; }
-                            indexOfGroup = counts[i].size(); //don't adjust the the group indexes because we removed the read
-                        }else { newIndexNameMap[reverse[thisIndex]] = i; }
-                    }else { //you don't have this group, nothing to remove
-                        
-                        if (indexOfGroup == -1) { indexOfGroup = counts[i].size(); }
-                        newIndexNameMap[reverse[thisIndex]] = i;
+                            keep[i] = false; removedRows = true;
+                            if (isNamed(i)) { uniques--; }
+                        }
                     }
-                    
-                    for (int j = indexOfGroup; j < counts[i].size(); j++) { counts[i][j].group -= 1; }
-                    
-                    thisIndex++;
+
+                    for (int j = indexOfGroup; j < length; j++) { row[j].group -= 1; }
                 }
-                indexNameMap = newIndexNameMap;
-                
+
+                if (removedRows) { keepRows(keep); }
+                clearViews();
+
                 if (groups.size() == 0) { hasGroups = false; }
             }
         }else { m->mothurOut("[ERROR]: your count table does not contain group information, can not remove group " + groupName + ".\n"); m->setControl_pressed(true); }
-        
+
         return 0;
     }
     catch(exception& e) {
@@ -1556,13 +1647,13 @@ int CountTable::removeGroup(string groupName) {
 /***********************************************************************/
 int CountTable::removeGroup(int minSize){
     try {
-        
+
         if (hasGroups) {
             for (int i = 0; i < totalGroups.size(); i++) {
                 if (totalGroups[i] < minSize) { removeGroup(groups[i]); }
             }
         }else { m->mothurOut("[ERROR]: your count table does not contain group information, can not remove groups.\n"); m->setControl_pressed(true); }
-        
+
         return groups.size();
     }
     catch(exception& e) {
@@ -1575,14 +1666,13 @@ int CountTable::removeGroup(int minSize){
 vector<string> CountTable::getGroups(string seqName) {
     try {
         vector<string> thisGroups;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(seqName);
+        if (row == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
             if (hasGroups) {
-                int index = it->second;
-                for (int i = 0; i < counts[index].size(); i++) {
-                    thisGroups.push_back(groups[counts[index][i].group]);
+                for (long long i = rowStarts[row]; i < rowStarts[row]+rowLengths[row]; i++) {
+                    thisGroups.push_back(groups[items[i].group]);
                 }
             }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
         }
@@ -1599,19 +1689,21 @@ vector<string> CountTable::getGroups(string seqName) {
 int CountTable::renameSeq(string oldSeqName, string newSeqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(oldSeqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(oldSeqName);
+        if (row == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(oldSeqName, groups)) {
-                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + oldSeqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + oldSeqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                 }
             }
             m->mothurOut("[ERROR]: " + oldSeqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            int index = it->second;
-            indexNameMap.erase(it);
-            indexNameMap[newSeqName] = index;
+            //the new name now belongs to this seq
+            int otherRow = findName(newSeqName);
+            if ((otherRow != -1) && (otherRow != row)) { nameLengths[otherRow] = -1; numNamed--; }
+
+            setName(row, newSeqName);
         }
 
         return 0;
@@ -1627,17 +1719,17 @@ int CountTable::renameSeq(string oldSeqName, string newSeqName) {
 int CountTable::getNumSeqs(string seqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(seqName);
+        if (row == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
-                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                 }
             }
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            return totals[it->second];
+            return totals[row];
         }
 
         return 0;
@@ -1652,12 +1744,12 @@ int CountTable::getNumSeqs(string seqName) {
 int CountTable::setNumSeqs(string seqName, int abund) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(seqName);
+        if (row == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true); return -1;
         }else {
-            int diff = totals[it->second] - abund;
-            totals[it->second] = abund;
+            int diff = totals[row] - abund;
+            totals[row] = abund;
             total-=diff;
         }
 
@@ -1672,20 +1764,19 @@ int CountTable::setNumSeqs(string seqName, int abund) {
 int CountTable::zeroOutSeq(string seqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(seqName);
+        if (row == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true); return -1;
         }else {
-            int abund = totals[it->second];
-            totals[it->second] = 0;
+            int abund = totals[row];
+            totals[row] = 0;
             total-=abund;
-            
+
             if (hasGroups) {
-                int seqIndexIntoCounts = it->second;
-                for (int i = 0; i < counts[seqIndexIntoCounts].size(); i++) {
-                    totalGroups[counts[seqIndexIntoCounts][i].group] -= counts[seqIndexIntoCounts][i].abund;
+                for (long long i = rowStarts[row]; i < rowStarts[row]+rowLengths[row]; i++) {
+                    totalGroups[items[i].group] -= items[i].abund;
                 }
-                counts[seqIndexIntoCounts].clear();
+                setRow(row, vector<countTableItem>());
             }
         }
 
@@ -1701,8 +1792,8 @@ int CountTable::zeroOutSeq(string seqName) {
 int CountTable::get(string seqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int row = findName(seqName);
+        if (row == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
@@ -1710,7 +1801,7 @@ int CountTable::get(string seqName) {
                 }
             }
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
-        }else { return it->second; }
+        }else { return row; }
 
         return -1;
     }
@@ -1723,11 +1814,9 @@ int CountTable::get(string seqName) {
 //add seqeunce without group info
 int CountTable::push_back(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findName(seqName) == -1) {
             if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + ".\n");  m->setControl_pressed(true);  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(1);
+            addRow(seqName, 1, vector<countTableItem>());
             total++;
             uniques++;
         }else {
@@ -1745,10 +1834,7 @@ int CountTable::push_back(string seqName) {
 //
 bool CountTable::inTable(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it != indexNameMap.end()) { return true; }
-        return false;
-        
+        return (findName(seqName) != -1);
     }
     catch(exception& e) {
         m->errorOut(e, "CountTable", "inTable");
@@ -1760,43 +1846,30 @@ bool CountTable::inTable(string seqName) {
 //remove sequence
 int CountTable::remove(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it != indexNameMap.end()) {
-            int seqIndexIntoCounts = it->second;
+        int row = findName(seqName);
+        if (row != -1) {
             uniques--;
             if (hasGroups){ //remove this sequences counts from group totals
-                for (int i = 0; i < counts[seqIndexIntoCounts].size(); i++) {
-                    totalGroups[counts[seqIndexIntoCounts][i].group] -= counts[seqIndexIntoCounts][i].abund;
+                for (long long i = rowStarts[row]; i < rowStarts[row]+rowLengths[row]; i++) {
+                    totalGroups[items[i].group] -= items[i].abund;
                 }
             }
-            
-            //save for later in case removing a group means we need to remove a seq.
-            map<int, string> reverse;
-            for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 !=indexNameMap.end(); it2++) { reverse[it2->second] = it2->first;  }
-            
-            int newIndex = 0;
-            map<string, int> newIndexNameMap;
-            for (int i = 0; i < counts.size(); i++) {
-                if (i == seqIndexIntoCounts) { }//you are the seq we are trying to remove
-                else {   newIndexNameMap[reverse[i]] = newIndex; newIndex++;  }
-            }
-            indexNameMap = newIndexNameMap;
 
-            counts.erase(counts.begin()+seqIndexIntoCounts);
-            int thisTotal = totals[seqIndexIntoCounts];
-            totals.erase(totals.begin()+seqIndexIntoCounts);
+            int thisTotal = totals[row];
+            vector<bool> keep(totals.size(), true); keep[row] = false;
+            keepRows(keep);
             total -= thisTotal;
-            
+
             //remove group if all reads are removed
             for (int i = 0; i < totalGroups.size(); i++) {
                 if (totalGroups[i] == 0) { m->mothurOut("\nRemoving group: " + groups[i] + " because all sequences have been removed.\n"); removeGroup(groups[i]); i--; }
             }
-            
+
         }else {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
-                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                 }
             }
             m->mothurOut("[ERROR]: Your count table contains does not include " + seqName + ", cannot remove.\n");  m->setControl_pressed(true);
@@ -1813,11 +1886,9 @@ int CountTable::remove(string seqName) {
 //add seqeunce without group info
 int CountTable::push_back(string seqName, int thisTotal) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findName(seqName) == -1) {
             if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + ".\n"); m->setControl_pressed(true);  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(thisTotal);
+            addRow(seqName, thisTotal, vector<countTableItem>());
             total+=thisTotal;
             uniques++;
         }else {
@@ -1836,22 +1907,21 @@ int CountTable::push_back(string seqName, int thisTotal) {
 int CountTable::push_back(string seqName, vector<int> groupCounts, bool ignoreDup=false) {
     try {
         int thisTotal = 0;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findName(seqName) == -1) {
             if ((hasGroups) && (groupCounts.size() != getNumGroups())) {  m->mothurOut("[ERROR]: Your count table has a " + toString(getNumGroups()) + " groups and " + seqName + " has " + toString(groupCounts.size()) + ", please correct.\n");  m->setControl_pressed(true);  }
-            
+
+            groupCounts.resize(getNumGroups(), 0);
             for (int i = 0; i < getNumGroups(); i++) {   totalGroups[i] += groupCounts[i];  thisTotal += groupCounts[i]; }
-            if (hasGroups) {  counts.push_back(compressAbunds(groupCounts));  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(thisTotal);
+            if (hasGroups)  { addRow(seqName, thisTotal, compressAbunds(groupCounts));    }
+            else            { addRow(seqName, thisTotal, vector<countTableItem>());       }
             total+= thisTotal;
             uniques++;
         }else {
             if (ignoreDup) {
-                m->mothurOut("[WARNING]: Your count table contains more than 1 sequence named " + seqName + ".  Mothur requires sequence names to be unique. I will only add it once.\n"); 
+                m->mothurOut("[WARNING]: Your count table contains more than 1 sequence named " + seqName + ".  Mothur requires sequence names to be unique. I will only add it once.\n");
             }else {  m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + seqName + ", sequence names must be unique. Please correct.\n");  m->setControl_pressed(true);  }
         }
-        
+
         return thisTotal;
     }
     catch(exception& e) {
@@ -1864,22 +1934,7 @@ int CountTable::push_back(string seqName, vector<int> groupCounts, bool ignoreDu
 //add sequence with group info
 int CountTable::push_back(string seqName, vector<int> groupCounts) {
     try {
-        int thisTotal = 0;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
-            if ((hasGroups) && (groupCounts.size() != getNumGroups())) {  m->mothurOut("[ERROR]: Your count table has a " + toString(getNumGroups()) + " groups and " + seqName + " has " + toString(groupCounts.size()) + ", please correct.\n");  m->setControl_pressed(true);  }
-
-            for (int i = 0; i < getNumGroups(); i++) {   totalGroups[i] += groupCounts[i];  thisTotal += groupCounts[i]; }
-            if (hasGroups) {  counts.push_back(compressAbunds(groupCounts));  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(thisTotal);
-            total+= thisTotal;
-            uniques++;
-        }else {
-            m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + seqName + ", sequence names must be unique. Please correct.\n");  m->setControl_pressed(true);
-        }
-
-        return thisTotal;
+        return push_back(seqName, groupCounts, false);
     }
 	catch(exception& e) {
 		m->errorOut(e, "CountTable", "push_back");
@@ -1891,14 +1946,14 @@ int CountTable::push_back(string seqName, vector<int> groupCounts) {
 int CountTable::getNumSeqsSmallestGroup() {
     try {
         int smallestGroupSize = MOTHURMAX;
-        
+
         if (hasGroups) {
             for (int i = 0; i < totalGroups.size(); i++) {
                 if (totalGroups[i] < smallestGroupSize) { smallestGroupSize = totalGroups[i]; }
             }
         }
         else { return total; }
-        
+
         return smallestGroupSize;
     }
     catch(exception& e) {
@@ -1911,10 +1966,17 @@ int CountTable::getNumSeqsSmallestGroup() {
 //create ListVector from uniques
 ListVector CountTable::getListVector() {
     try {
-        ListVector list(indexNameMap.size());
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
+        ListVector list(numNamed);
+
+        //bins are in the order the rows were added, skipping the rows merged into others
+        vector<int> rowToBin(totals.size(), -1);
+        int numBins = 0;
+        for (int i = 0; i < totals.size(); i++) { if (isNamed(i)) { rowToBin[i] = numBins++; } }
+
+        vector<int>& sorted = getSortedRows();
+        for (int i = 0; i < sorted.size(); i++) {
             if (m->getControl_pressed()) { break; }
-            list.set(it->second, it->first);
+            list.set(rowToBin[sorted[i]], getName(sorted[i]));
         }
         return list;
     }
@@ -1929,9 +1991,9 @@ ListVector CountTable::getListVector() {
 vector<string> CountTable::getNamesOfSeqs() {
     try {
         vector<string> names;
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
-            names.push_back(it->first);
-        }
+        vector<int>& sorted = getSortedRows();
+        names.reserve(sorted.size());
+        for (int i = 0; i < sorted.size(); i++) { names.push_back(getName(sorted[i])); }
 
         return names;
     }
@@ -1945,9 +2007,8 @@ vector<string> CountTable::getNamesOfSeqs() {
 map<string, int> CountTable::getNameMap() {
     try {
         map<string, int> names;
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
-            names[it->first] = totals[it->second];
-        }
+        vector<int>& sorted = getSortedRows();
+        for (int i = 0; i < sorted.size(); i++) { names.emplace_hint(names.end(), getName(sorted[i]), totals[sorted[i]]); }
 
         return names;
     }
@@ -1961,16 +2022,14 @@ map<string, int> CountTable::getNameMap() {
 map<string, int> CountTable::getNameMap(string group) {
     try {
         map<string, int> names;
-        
+
         if (hasGroups) {
             map<string, int>::iterator it = indexGroupMap.find(group);
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + group + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 != indexNameMap.end(); it2++) {
-                    int abund = getAbund(it2->second, it->second);
-                    if (abund != 0) {  names[it2->first] = abund; }
-                }
+                buildGroupRows();
+                for (long long i = groupStarts[it->second]; i < groupStarts[it->second+1]; i++) { names.emplace_hint(names.end(), getName(groupRows[i]), groupAbunds[i]); }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
 
@@ -1991,9 +2050,8 @@ vector<string> CountTable::getNamesOfSeqs(string group) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + group + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 != indexNameMap.end(); it2++) {
-                    if (getAbund(it2->second, it->second) != 0) {  names.push_back(it2->first); }
-                }
+                buildGroupRows();
+                for (long long i = groupStarts[it->second]; i < groupStarts[it->second+1]; i++) { names.push_back(getName(groupRows[i])); }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
 
@@ -2010,17 +2068,23 @@ vector<string> CountTable::getNamesOfSeqs(vector<string> chosenGroups) {
     try {
         vector<string> names;
         if (hasGroups) {
-            set<string> uniqueNames;
+            //only adds names once. seqs are likely present in more than one group, but we only want to enter them once
+            vector<bool> inChosenGroups(totals.size(), false);
             for (int i = 0; i < chosenGroups.size(); i++) {
-                vector<string> namesFromThisGroup = getNamesOfSeqs(chosenGroups[i]);
-                for (int j = 0; j < namesFromThisGroup.size(); j++) { uniqueNames.insert(namesFromThisGroup[j]);  }
+                map<string, int>::iterator it = indexGroupMap.find(chosenGroups[i]);
+                if (it == indexGroupMap.end()) {
+                    m->mothurOut("[ERROR]: " + chosenGroups[i] + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
+                }else {
+                    buildGroupRows();
+                    for (long long j = groupStarts[it->second]; j < groupStarts[it->second+1]; j++) { inChosenGroups[groupRows[j]] = true; }
+                }
             }
-            
-            //only adds names once. seqs are likely present in more than one group, but we only want to enter them once
-            for (set<string>::iterator it = uniqueNames.begin(); it != uniqueNames.end(); it++) { names.push_back(*it); }
-            
+
+            vector<int>& sorted = getSortedRows();
+            for (int i = 0; i < sorted.size(); i++) { if (inChosenGroups[sorted[i]]) { names.push_back(getName(sorted[i])); } }
+
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
-        
+
         return names;
     }
     catch(exception& e) {
@@ -2033,38 +2097,41 @@ vector<string> CountTable::getNamesOfSeqs(vector<string> chosenGroups) {
 //merges counts of seq1 and seq2, saving in seq1
 int CountTable::mergeCounts(string seq1, string seq2) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seq1);
-        if (it == indexNameMap.end()) {
+        int row1 = findName(seq1);
+        if (row1 == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seq1, groups)) {
-                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seq1 + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                    m->mothurOut("[WARNING]: Your group or design file contains a group named " + seq1 + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                 }
             }
             m->mothurOut("[ERROR]: " + seq1 + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            map<string, int>::iterator it2 = indexNameMap.find(seq2);
-            if (it2 == indexNameMap.end()) {
+            int row2 = findName(seq2);
+            if (row2 == -1) {
                 if (hasGroupInfo()) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (util.inUsersGroups(seq2, groups)) {
-                        m->mothurOut("[WARNING]: Your group or design file contains a group named " + seq2 + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
+                        m->mothurOut("[WARNING]: Your group or design file contains a group named " + seq2 + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n");
                     }
                 }
                 m->mothurOut("[ERROR]: " + seq2 + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
                 if (hasGroupInfo()) { //if no group data then counts are empty
                     //merge data
-                    vector<int> countsSeq1 = expandAbunds(it->second);
-                    vector<int> countsSeq2 = expandAbunds(it2->second);
-                
+                    vector<int> countsSeq1 = expandAbunds(row1);
+                    vector<int> countsSeq2 = expandAbunds(row2);
+
                     for (int i = 0; i < groups.size(); i++) { countsSeq1[i] += countsSeq2[i]; }
-                
-                    counts[it->second] = compressAbunds(countsSeq1);
+
+                    setRow(row1, compressAbunds(countsSeq1));
                 }
-                totals[it->second] += totals[it2->second];
+                totals[row1] += totals[row2];
                 uniques--;
-                indexNameMap.erase(it2);
+
+                //seq2's row stays so the other rows keep their indexes, but it no longer has a name
+                nameLengths[row2] = -1; numNamed--;
+                clearViews();
             }
         }
         return 0;
@@ -2085,7 +2152,7 @@ int CountTable::copy(CountTable* ct) {
             vector<int> thisCounts = ct->getGroupCounts(names[i]);
             push_back(names[i], thisCounts, false);
         }
-        
+
         isCompressed = ct->isTableCompressed();
 
         return 0;
@@ -2099,11 +2166,11 @@ int CountTable::copy(CountTable* ct) {
 
 int CountTable::sortCountTable(){
     try {
-        
+
         //sorts each rows abunds by group
-        //counts[i] = (1,4),(1,2),(3,7) -> (1,2),(1,4),(3,7)
-        for (int i = 0; i < counts.size(); i++) {  sort(counts[i].begin(), counts[i].end(), compareGroups); }
-        
+        //row i = (1,4),(1,2),(3,7) -> (1,2),(1,4),(3,7)
+        for (int i = 0; i < totals.size(); i++) {  sortRow(i); }
+
         return 0;
     }
     catch(exception& e) {
@@ -2115,10 +2182,10 @@ int CountTable::sortCountTable(){
 
 int CountTable::sortRow(int index){
     try {
-        
+
         //saves time in getSmallestCell, by making it so you dont search the repeats
-        sort(counts[index].begin(), counts[index].end(), compareGroups);
-        
+        sort(items.begin()+rowStarts[index], items.begin()+rowStarts[index]+rowLengths[index], compareGroups);
+
         return 0;
     }
     catch(exception& e) {
@@ -2126,5 +2193,217 @@ int CountTable::sortRow(int index){
         exit(1);
     }
 }
+/***********************************************************************/
+//returns row, -1 if not found
+int CountTable::findName(const string& name) {
+    try {
+        size_t mask = nameSlots.size() - 1;
+        size_t slot = Dereplicator::hashString(name.data(), name.length()) & mask;
+
+        while (nameSlots[slot] != 0) {
+            int row = nameSlots[slot] - 1;
+            if ((nameLengths[row] == (int)name.length()) && (memcmp(nameArena.data() + nameStarts[row], name.data(), name.length()) == 0)) { return row; }
+            slot = (slot + 1) & mask;
+        }
+
+        return -1;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "findName");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//the row's old name, if it had one, is left in the arena and its slot no longer matches it
+void CountTable::setName(int row, const string& name) {
+    try {
+        if (row == nameStarts.size()) { nameStarts.push_back(0); nameLengths.push_back(-1); }
+        if (!isNamed(row)) { numNamed++; }
+
+        nameStarts[row] = nameArena.length();
+        nameLengths[row] = (int)name.length();
+        nameArena += name;
+
+        indexName(row);
+        clearViews();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "setName");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void CountTable::indexName(int row) {
+    try {
+        size_t mask = nameSlots.size() - 1;
+        size_t slot = Dereplicator::hashString(nameArena.data() + nameStarts[row], nameLengths[row]) & mask;
+
+        while (nameSlots[slot] != 0) { slot = (slot + 1) & mask; }
+        nameSlots[slot] = row + 1;
+        numNameSlotsUsed++;
+
+        if ((numNameSlotsUsed * 2) > nameSlots.size()) { rebuildNameIndex(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "indexName");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//sized for 4 slots per name, so the index is rebuilt after the table doubles or many names are renamed or merged
+void CountTable::rebuildNameIndex() {
+    try {
+        size_t numSlots = 1024;
+        while (numSlots < ((size_t)numNamed * 4)) { numSlots *= 2; }
+
+        nameSlots.assign(numSlots, 0);
+        numNameSlotsUsed = 0;
+
+        for (int i = 0; i < nameLengths.size(); i++) {
+            if (isNamed(i)) { indexName(i); }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "rebuildNameIndex");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//name, total, items sorted by group. returns row
+int CountTable::addRow(const string& name, int thisTotal, const vector<countTableItem>& rowItems) {
+    try {
+        int row = totals.size();
+
+        totals.push_back(thisTotal);
+        rowStarts.push_back(items.size());
+        rowLengths.push_back((int)rowItems.size());
+        items.insert(items.end(), rowItems.begin(), rowItems.end());
+
+        setName(row, name);
+
+        return row;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "addRow");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//replaces the row's items, rewriting them in place if they fit
+void CountTable::setRow(int row, const vector<countTableItem>& rowItems) {
+    try {
+        if (rowItems.size() <= rowLengths[row]) {
+            std::copy(rowItems.begin(), rowItems.end(), items.begin()+rowStarts[row]);
+            numUnusedItems += rowLengths[row] - rowItems.size();
+        }else {
+            numUnusedItems += rowLengths[row];
+            rowStarts[row] = items.size();
+            items.insert(items.end(), rowItems.begin(), rowItems.end());
+        }
+        rowLengths[row] = (int)rowItems.size();
+        clearViews();
+
+        //compact items once most of them are left behind
+        if ((numUnusedItems > 65536) && ((numUnusedItems * 2) > items.size())) { keepRows(vector<bool>(totals.size(), true)); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "setRow");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//rebuilds the names, items and totals from the rows kept, in the same order
+void CountTable::keepRows(const vector<bool>& keep) {
+    try {
+        string newArena;
+        vector<unsigned long long> newStarts;
+        vector<int> newLengths, newTotals, newRowLengths;
+        vector<countTableItem> newItems;
+        vector<long long> newRowStarts;
+
+        numNamed = 0;
+        for (int i = 0; i < totals.size(); i++) {
+            if (!keep[i]) { continue; }
+
+            newStarts.push_back(newArena.length());
+            newLengths.push_back(nameLengths[i]);
+            if (isNamed(i)) { newArena.append(nameArena, nameStarts[i], nameLengths[i]); numNamed++; }
+
+            newTotals.push_back(totals[i]);
+            newRowStarts.push_back(newItems.size());
+            newRowLengths.push_back(rowLengths[i]);
+            newItems.insert(newItems.end(), items.begin()+rowStarts[i], items.begin()+rowStarts[i]+rowLengths[i]);
+        }
+
+        nameArena.swap(newArena); nameStarts.swap(newStarts); nameLengths.swap(newLengths);
+        totals.swap(newTotals); rowStarts.swap(newRowStarts); rowLengths.swap(newRowLengths); items.swap(newItems);
+        numUnusedItems = 0;
+
+        rebuildNameIndex();
+        clearViews();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "keepRows");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//named rows in the order of a map of the names
+vector<int>& CountTable::getSortedRows() {
+    try {
+        if (sortedRows.size() != numNamed) {
+            sortedRows.clear();
+            for (int i = 0; i < nameLengths.size(); i++) { if (isNamed(i)) { sortedRows.push_back(i); } }
+
+            const char* arena = nameArena.data();
+            const vector<unsigned long long>& starts = nameStarts;
+            const vector<int>& lengths = nameLengths;
+            sort(sortedRows.begin(), sortedRows.end(), [arena, &starts, &lengths](int a, int b) {
+                int compare = memcmp(arena + starts[a], arena + starts[b], min(lengths[a], lengths[b]));
+                if (compare != 0) { return (compare < 0); }
+                return (lengths[a] < lengths[b]);
+            });
+        }
+
+        return sortedRows;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "getSortedRows");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//the named rows with a non zero abundance in each group, in name order. groupStarts are the prefix sums of the group sizes
+void CountTable::buildGroupRows() {
+    try {
+        if (groupStarts.size() == (groups.size() + 1)) { return; }
+
+        vector<int>& sorted = getSortedRows();
 
+        groupStarts.assign(groups.size() + 1, 0);
+        for (int i = 0; i < sorted.size(); i++) {
+            int row = sorted[i];
+            for (long long j = rowStarts[row]; j < rowStarts[row]+rowLengths[row]; j++) {
+                if (items[j].abund != 0) { groupStarts[items[j].group+1]++; }
+            }
+        }
+        for (int i = 0; i < groups.size(); i++) { groupStarts[i+1] += groupStarts[i]; }
+
+        groupRows.resize(groupStarts[groups.size()]); groupAbunds.resize(groupStarts[groups.size()]);
+        vector<long long> next(groupStarts.begin(), groupStarts.end()-1);
+        for (int i = 0; i < sorted.size(); i++) {
+            int row = sorted[i];
+            for (long long j = rowStarts[row]; j < rowStarts[row]+rowLengths[row]; j++) {
+                if (items[j].abund != 0) {
+                    long long index = next[items[j].group]++;
+                    groupRows[index] = row; groupAbunds[index] = items[j].abund;
+                }
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "buildGroupRows");
+        exit(1);
+    }
+}
 /************************************************************/
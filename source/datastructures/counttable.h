@@ -49,6 +49,28 @@
  GQY1XT001CNUHI	19	1,17	2,1	7,1
  ...
 
+ 
+ In memory the table is kept by row, a row for each sequence line, in the order the rows were added:
+    names   - one string holding every row's name, found by a hashed index of the rows. mergeCounts takes the second
+              sequence's name off its row, but the row stays so the other rows keep their indexes.
+    items   - the non zero abundances of each row sorted by group, rows are contiguous (compressed sparse rows). A row is
+              rewritten in place, or moved to the end of items if it grows.
+    totals  - per row, and totalGroups per group.
+ The rows in name order and the rows of each group (offsets into one array are the prefix sums of the group sizes) are
+ built when first asked for and dropped when the table changes.
+
+ When a table is printed to file, a binary copy of what was printed is written to [file].bin:
+    header  - "MOTHURCT", version, flags (1 compressed, 2 group columns), the size, time and a hash of the ends of the
+              text file, then the number of groups, rows, items, name bytes and group name bytes
+    groups  - numGroups+1 offsets, group names as in the column headers
+    names   - numRows+1 offsets, names
+    totals  - numRows ints
+    rows    - numRows+1 offsets, then numItems (abund, column) pairs
+ Each section is padded to 8 bytes. readTable maps the binary file in place of parsing the text when it was written for
+ the text file as it is now, and gives the same table the text would.
+ There is no section for the rows of each group. The file is copied into the table and unmapped, so the group totals
+ and abundances are looked up in memory, and the prefix sums of the group sizes are built from the rows when first
+ asked for, as they are for a table read from text.
  */
 
 
@@ -57,12 +79,13 @@
 #include "groupmap.h"
 #include "sequence.hpp"
 #include "sharedrabundvectors.hpp"
+#include "counttablebinaryfile.hpp"
 
 class CountTable {
 
     public:
 
-        CountTable() { m = MothurOut::getInstance(); hasGroups = false; total = 0; uniques = 0; isCompressed = false; }
+        CountTable() { m = MothurOut::getInstance(); hasGroups = false; total = 0; uniques = 0; isCompressed = false; numNamed = 0; numNameSlotsUsed = 0; numUnusedItems = 0; nameSlots.assign(1024, 0); }
         ~CountTable() {}
 
         //reads and creates smart enough to eliminate groups with zero counts
@@ -111,7 +134,7 @@ class CountTable {
         int push_back(string, vector<int>, bool); //add a sequence with group info, no error - ignore dups
         int remove(string); //remove seq
         int get(string); //returns unique sequence index for reading distance matrices like NameAssignment
-        int size() { return (int)indexNameMap.size(); }
+        int size() { return numNamed; }
 
         vector<string> getGroups(string); //returns vector of groups represented by this sequence
         vector<int> getGroupCounts(string);  //returns group counts for a seq passed in, if no group info is in file vector is blank. Order is the same as the groups returned by getGroups function.
@@ -133,6 +156,11 @@ class CountTable {
         SharedRAbundVectors* getShared(vector<string>, map<string, string>&); //set of groups selected
         map<string, int> getNameMap();  //sequenceName -> total number of sequences it represents
         map<string, int> getNameMap(string);  //sequenceName -> total number of sequences it represents in that group
+
+        //the named seqs in name order, what getNameMap holds without building the map. Good until the table changes
+        int getNumSortedSeqs() { return (int)getSortedRows().size(); }
+        string getSortedName(int i) { return getName(getSortedRows()[i]); }
+        int getSortedNumSeqs(int i) { return totals[getSortedRows()[i]]; }
     
 
     private:
@@ -142,12 +170,52 @@ class CountTable {
         bool hasGroups, isCompressed;
         int total, uniques;
         vector<string> groups;
-        vector< vector<countTableItem> > counts; //countTableItem ((int)abund, (int)group). each line in counts represents a sequence line from the count table file(sparse). The vector<ountTableItem> are sorted by group, so that you can stop search early if group is not found. For example:  seq1 10 5 0 0 1 0 0 0 3 0 0 1 0 0 - 13 groups, but seq1 is only present in 4 samples. Let's save space by not storing 0 abunds. seq1's vector<ountTableItem> (5,0),(1,3),(3,7),(1,10). Group0 = 5, Group3 = 1, Group7 = 3, Group10 = 1.  
         vector<int> totals;
         vector<int> totalGroups;
-        map<string, int> indexNameMap; //maps seqName -> vector index in counts. seq1 -> 1 would mean seq1's counts are stored in counts[1].
         map<string, int> indexGroupMap;
     
+        string nameArena;
+        vector<unsigned long long> nameStarts; //per row
+        vector<int> nameLengths; //per row, -1 if the row's name was merged into another row
+        vector<int> nameSlots; //row + 1, 0 if empty. Renamed and merged rows leave slots that match nothing
+        int numNamed, numNameSlotsUsed;
+    
+        vector<countTableItem> items; //countTableItem ((int)abund, (int)group). For example: seq1 10 5 0 0 1 0 0 0 3 0 0 1 0 0 - 13 groups, but seq1 is only present in 4 samples. seq1's items (5,0),(1,3),(3,7),(1,10). Group0 = 5, Group3 = 1, Group7 = 3, Group10 = 1.
+        vector<long long> rowStarts; //per row, index of the row's first item
+        vector<int> rowLengths; //per row
+        long long numUnusedItems; //left behind by rows that moved or shrank
+    
+        vector<int> sortedRows; //named rows in name order, empty until needed
+        vector<long long> groupStarts; //numGroups+1 prefix sums of the number of rows in each group, empty until needed
+        vector<int> groupRows, groupAbunds; //rows of each group in name order
+    
+        struct countTableFile { //what the readers need to add the rows of a count table file
+            bool readGroups, mothurRunning, pickedGroups, hasGroupColumns, error;
+            set<string>* selectedSeqs; //NULL unless reading selected seqs
+            vector<int> columnToGroup; //index in groups of each group column, -1 if the group is not read
+            vector<countTableItem> rowItems;
+        };
+    
+        int readFile(string, ifstream&, bool, bool, vector<string>, set<string>*); //filename, filehandle, readGroups, mothurRunning, selectedGroups, selectedSeqs
+        void setFileGroups(countTableFile&, vector<string>&, vector<string>&); //file, column groups, selectedGroups
+        void addFileRow(countTableFile&, const string&, int, vector<countTableItem>&); //file, name, total, abundances by column
+        bool readBinaryFile(string, countTableFile&, vector<string>&); //filename, file, selectedGroups
+        void writeBinaryFile(string, bool, vector<string>&, vector<int>&, vector<int>&, vector<int>&); //filename, compressed, column groups, rows, row totals, group to column
+        static unsigned long long getTextStamp(string, unsigned long long&, unsigned long long&); //filename, size, time. returns hash of the ends of the file
+    
+        int findName(const string&); //returns row, -1 if not found
+        string getName(int row) { return nameArena.substr(nameStarts[row], nameLengths[row]); }
+        bool isNamed(int row) { return (nameLengths[row] != -1); }
+        void setName(int, const string&); //row, name. adds the name to the index
+        void indexName(int);
+        void rebuildNameIndex();
+        int addRow(const string&, int, const vector<countTableItem>&); //name, total, items. returns row
+        void setRow(int, const vector<countTableItem>&);
+        void keepRows(const vector<bool>&); //rebuilds the table from the rows kept
+        void clearViews() { sortedRows.clear(); groupStarts.clear(); groupRows.clear(); groupAbunds.clear(); }
+        vector<int>& getSortedRows();
+        void buildGroupRows();
+    
         int find(int seq, int group, bool returnNext); //returns index of countTableItem for group passed in. If group is not present in seq, returns -1
         int getAbund(int seq, int group); //returns abundance of countTableItem for seq and group passed in. If group is not present in seq, returns 0
         vector<countTableItem> getItems(string); //returns group counts for a seq passed in, if no group info is in file vector is blank. sorted by group
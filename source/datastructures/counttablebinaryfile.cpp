@@ -0,0 +1,52 @@
+//
+//  counttablebinaryfile.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "counttablebinaryfile.hpp"
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//only files written by CountTable start with the magic, other files named [file].bin are left alone
+bool CountTableBinaryFile::isBinaryFile(string binaryFileName) {
+    try {
+        ifstream in(binaryFileName.c_str(), ios::binary);
+        if (!in) { return false; }
+        char magic[8] = { 0 };
+        in.read(magic, 8);
+        in.close();
+
+        return (strncmp(magic, COUNTTABLE_BINARY_MAGIC, 8) == 0);
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "CountTableBinaryFile", "isBinaryFile");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void CountTableBinaryFile::remove(string file) {
+    try {
+        string binaryFileName = getFileName(file);
+        if (isBinaryFile(binaryFileName)) { ::remove(binaryFileName.c_str()); }
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "CountTableBinaryFile", "remove");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//renaming keeps the size and time of the text, so the binary copy is still current
+void CountTableBinaryFile::rename(string oldFile, string newFile) {
+    try {
+        string oldBinaryFileName = getFileName(oldFile);
+        if (isBinaryFile(oldBinaryFileName)) { ::rename(oldBinaryFileName.c_str(), getFileName(newFile).c_str()); }
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "CountTableBinaryFile", "rename");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
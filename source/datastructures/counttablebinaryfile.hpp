@@ -0,0 +1,33 @@
+//
+//  counttablebinaryfile.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef counttablebinaryfile_hpp
+#define counttablebinaryfile_hpp
+
+#include "mothur.h"
+
+#define COUNTTABLE_BINARY_MAGIC "MOTHURCT"
+#define COUNTTABLE_BINARY_VERSION 1
+
+/* The binary copy CountTable writes next to a printed count table, [file].bin. The layout is described in counttable.h.
+ Every command that prints a count table writes one. It is not one of the command's output files, later commands read it
+ in place of the text while the table is unchanged and parse the text again if it was deleted.
+ Utils renames and removes the copy with its count table through this class, so it doesn't need CountTable. */
+
+class CountTableBinaryFile {
+
+public:
+
+    static string getFileName(string file) { return file + ".bin"; } //count table filename
+    static bool isBinaryFile(string); //binary copy filename, true if CountTable wrote it
+    static void remove(string); //count table filename, removes the binary copy if there is one
+    static void rename(string, string); //old count table filename, new count table filename
+
+};
+
+#endif /* counttablebinaryfile_hpp */
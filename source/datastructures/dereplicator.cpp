@@ -0,0 +1,234 @@
+//
+//  dereplicator.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "dereplicator.hpp"
+
+/**************************************************************************************************/
+Dereplicator::Dereplicator(int p) {
+    try {
+        m = MothurOut::getInstance();
+        processors = p;
+        if (processors < 1) { processors = 1; }
+        shards.resize(processors);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "Dereplicator");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//multiplies in the string 8 bytes at a time and mixes the result with the murmur3 finalizer
+unsigned long long Dereplicator::hashString(const char* s, size_t length) {
+    const unsigned long long prime = 0x9E3779B97F4A7C15ULL;
+    unsigned long long h = length * prime;
+    unsigned long long word;
+
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        memcpy(&word, s + i, 8);
+        h = (h ^ word) * prime;
+        h ^= h >> 29;
+    }
+    word = 0;
+    memcpy(&word, s + i, length - i);
+    h = (h ^ word) * prime;
+
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+/**************************************************************************************************/
+int Dereplicator::Shard::find(unsigned long long h, const string& s) {
+    size_t mask = slots.size() - 1;
+    size_t slot = h & mask;
+
+    while (slots[slot] != 0) {
+        int entry = slots[slot] - 1;
+        if ((hashes[entry] == h) && (lengths[entry] == s.length()) && (memcmp(arena.data() + starts[entry], s.data(), s.length()) == 0)) { return entry; }
+        slot = (slot + 1) & mask;
+    }
+
+    int entry = (int)hashes.size();
+    hashes.push_back(h); starts.push_back(arena.length()); lengths.push_back((int)s.length()); uniqueIndexes.push_back(-1);
+    arena += s;
+    slots[slot] = entry + 1;
+
+    if ((hashes.size() * 2) > slots.size()) { grow(); }
+
+    return entry;
+}
+/**************************************************************************************************/
+void Dereplicator::Shard::grow() {
+    slots.assign(slots.size() * 2, 0);
+    size_t mask = slots.size() - 1;
+
+    for (int i = 0; i < hashes.size(); i++) {
+        size_t slot = hashes[i] & mask;
+        while (slots[slot] != 0) { slot = (slot + 1) & mask; }
+        slots[slot] = i + 1;
+    }
+}
+/**************************************************************************************************/
+int Dereplicator::number(int shard, int entry, bool& isNew) {
+    try {
+        int& index = shards[shard].uniqueIndexes[entry];
+        isNew = (index == -1);
+
+        if (isNew) {
+            index = (int)uniqueShards.size();
+            uniqueShards.push_back(shard); uniqueEntries.push_back(entry);
+        }
+
+        return index;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "number");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int Dereplicator::add(const string& s, bool& isNew) {
+    try {
+        unsigned long long h = hashString(s.data(), s.length());
+        int shard = getShard(h);
+
+        return number(shard, shards[shard].find(h, s), isNew);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "add");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void Dereplicator::hashStrings(const vector<string>* strings, int start, int end) {
+    try {
+        for (int i = start; i < end; i++) { batchHashes[i] = hashString((*strings)[i].data(), (*strings)[i].length()); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "hashStrings");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//only this thread touches the shard, so the strings of a shard are added in the order they appear in the batch
+void Dereplicator::findStrings(const vector<string>* strings, int shard) {
+    try {
+        for (int i = 0; i < strings->size(); i++) {
+            if (getShard(batchHashes[i]) == shard) { batchEntries[i] = shards[shard].find(batchHashes[i], (*strings)[i]); }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "findStrings");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int Dereplicator::add(const vector<string>& strings, vector<int>& uniqueIndexes, vector<bool>& isNew) {
+    try {
+        int numStrings = (int)strings.size();
+        batchHashes.resize(numStrings); batchEntries.resize(numStrings);
+        uniqueIndexes.resize(numStrings); isNew.resize(numStrings);
+
+        if (processors == 1) {
+            hashStrings(&strings, 0, numStrings);
+            findStrings(&strings, 0);
+        }else {
+            vector<std::thread*> workerThreads;
+            for (int i = 1; i < processors; i++) {
+                workerThreads.push_back(new std::thread(&Dereplicator::hashStrings, this, &strings, (int)((long long)numStrings * i / processors), (int)((long long)numStrings * (i+1) / processors)));
+            }
+            hashStrings(&strings, 0, numStrings / processors);
+            for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+            workerThreads.clear();
+
+            for (int i = 1; i < processors; i++) { workerThreads.push_back(new std::thread(&Dereplicator::findStrings, this, &strings, i)); }
+            findStrings(&strings, 0);
+            for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+        }
+
+        //numbered in the order of the batch, not the order the shards finished
+        int numNew = 0;
+        for (int i = 0; i < numStrings; i++) {
+            bool thisNew;
+            uniqueIndexes[i] = number(getShard(batchHashes[i]), batchEntries[i], thisNew);
+            isNew[i] = thisNew;
+            if (thisNew) { numNew++; }
+        }
+
+        return numNew;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "add");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+string Dereplicator::getUnique(int i) {
+    try {
+        Shard& shard = shards[uniqueShards[i]];
+        int entry = uniqueEntries[i];
+
+        return shard.arena.substr(shard.starts[entry], shard.lengths[entry]);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "getUnique");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void Dereplicator::addMember(int i, const string& name) {
+    try {
+        int member = (int)memberStarts.size();
+        memberStarts.push_back(memberArena.length()); memberLengths.push_back((int)name.length()); nextMembers.push_back(-1);
+        memberArena += name;
+
+        if (i >= firstMembers.size()) { firstMembers.resize(uniqueShards.size(), -1); lastMembers.resize(uniqueShards.size(), -1); }
+        if (firstMembers[i] == -1)  { firstMembers[i] = member;               }
+        else                        { nextMembers[lastMembers[i]] = member;   }
+        lastMembers[i] = member;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "addMember");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+string Dereplicator::getFirstMember(int i) {
+    try {
+        if (!hasMembers(i)) { return ""; }
+
+        int member = firstMembers[i];
+
+        return memberArena.substr(memberStarts[member], memberLengths[member]);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "getFirstMember");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+string Dereplicator::getMembers(int i) {
+    try {
+        string members = "";
+        if (!hasMembers(i)) { return members; }
+
+        for (int member = firstMembers[i]; member != -1; member = nextMembers[member]) {
+            if (member != firstMembers[i]) { members += ','; }
+            members.append(memberArena, memberStarts[member], memberLengths[member]);
+        }
+
+        return members;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Dereplicator", "getMembers");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
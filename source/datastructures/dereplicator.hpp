@@ -0,0 +1,85 @@
+//
+//  dereplicator.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef dereplicator_hpp
+#define dereplicator_hpp
+
+#include "mothurout.h"
+
+/* Finds the unique strings in a stream of strings, used by unique.seqs to find the unique sequences and the duplicate names.
+
+ Each string is found by a 64 bit hash in an open addressing table, and the strings with the same hash are compared in full,
+ so a collision can't merge 2 sequences. The unique strings are copied into one arena, and the members of a unique (names
+ or namefile lists) are kept in a second arena as a linked list with an abundance, so a unique costs a few ints instead of a
+ map node and a string that grows with each duplicate.
+
+ The table is split into one shard per processor by the hash. A batch of strings is hashed by all the processors, then each
+ processor adds the strings of its shard in the order they appear. The uniques are numbered in the order they first appear
+ in the batch, so the results don't depend on the number of processors. */
+
+/**************************************************************************************************/
+
+class Dereplicator {
+
+public:
+
+    Dereplicator(int p = 1);
+    ~Dereplicator() {}
+
+    //sets the unique index of each string, adding the strings not seen before. Returns the number of new uniques
+    int add(const vector<string>&, vector<int>&, vector<bool>&); //strings, uniqueIndexes, isNew
+    int add(const string&, bool&); //string, isNew. returns the unique index
+
+    int getNumUniques() { return (int)uniqueShards.size(); }
+    string getUnique(int);
+
+    void addMember(int, const string&); //unique index, name or list of names
+    string getMembers(int); //comma separated, in the order they were added
+    string getFirstMember(int); //"" if the unique has no members
+    bool hasMembers(int i) { return ((i < firstMembers.size()) && (firstMembers[i] != -1)); }
+
+    void addAbundance(int i, int num) { if (i >= abundances.size()) { abundances.resize(uniqueShards.size(), 0); } abundances[i] += num; }
+    int getAbundance(int i) { return (i < abundances.size() ? abundances[i] : 0); }
+
+    static unsigned long long hashString(const char*, size_t);
+
+private:
+
+    struct Shard {
+        string arena;
+        vector<unsigned long long> hashes, starts;
+        vector<int> lengths, uniqueIndexes; //per entry, uniqueIndexes is -1 until the entry is numbered
+        vector<int> slots; //entry + 1, 0 if empty
+
+        Shard() : slots(1024, 0) {}
+        int find(unsigned long long, const string&); //hash, string. returns the entry, adding it if not found
+        void grow();
+    };
+
+    MothurOut* m;
+    int processors;
+    vector<Shard> shards;
+
+    vector<int> uniqueShards, uniqueEntries; //per unique
+    vector<int> abundances, firstMembers, lastMembers; //per unique, grown when first used so a table of names doesn't pay for them
+    string memberArena;
+    vector<unsigned long long> memberStarts; //per member
+    vector<int> memberLengths, nextMembers;
+
+    vector<unsigned long long> batchHashes;
+    vector<int> batchEntries;
+
+    int getShard(unsigned long long h) { return (int)((h >> 32) % shards.size()); }
+    int number(int, int, bool&); //shard, entry, isNew. returns the unique index
+    void hashStrings(const vector<string>*, int, int); //strings, start, end
+    void findStrings(const vector<string>*, int); //strings, shard
+};
+
+/**************************************************************************************************/
+
+#endif /* dereplicator_hpp */
@@ -126,9 +126,11 @@ FastqRead::FastqRead(ifstream& in, bool& ignore, string f) {
         ignore = false;
         format = f;
         //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
+        if (format == "solexa") {
+            for (int i = -64; i < 65; i++) {
+                char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
+                convertTable.push_back(temp);
+            }
         }
         
         //read sequence name
@@ -184,9 +186,11 @@ FastqRead::FastqRead(boost::iostreams::filtering_istream& in, bool& ignore, stri
         if (in.eof()) { ignore = true; }
         else {
             //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-            for (int i = -64; i < 65; i++) {
-                char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-                convertTable.push_back(temp);
+            if (format == "solexa") {
+                for (int i = -64; i < 65; i++) {
+                    char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
+                    convertTable.push_back(temp);
+                }
             }
             
             //read sequence name
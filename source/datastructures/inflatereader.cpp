@@ -0,0 +1,101 @@
+//
+//  inflatereader.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "inflatereader.hpp"
+
+#ifdef USE_BOOST
+
+static const int numBlocks = 8;
+static const int blockSize = 1048576;
+
+/**************************************************************************************************/
+InflateReader::InflateReader(string filename) {
+    try {
+        m = MothurOut::getInstance();
+        current = NULL; currentPos = 0; inflater = NULL;
+
+        inflated = new BoundedQueue<string*>(numBlocks);
+        freeBlocks = new BoundedQueue<string*>(numBlocks);
+        for (int i = 0; i < numBlocks; i++) { blocks.push_back(new string()); freeBlocks->push(blocks[i]); }
+
+        open = util.openInputFileBinary(filename, file, gzIn);
+
+        if (open)   { inflater = new std::thread(&InflateReader::inflate, this);  }
+        else        { inflated->close();                                            } //reads as an empty file
+
+        in.push(BlockSource(this));
+    }
+    catch(exception& e) {
+        m->errorOut(e, "InflateReader", "InflateReader");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+InflateReader::~InflateReader() {
+    try {
+        //stops the inflate thread if the parser quit before the end of the file
+        inflated->close(); freeBlocks->close();
+        if (inflater != NULL) { inflater->join(); delete inflater; }
+
+        in.reset();
+        if (open) { gzIn.pop(); file.close(); }
+
+        for (int i = 0; i < blocks.size(); i++) { delete blocks[i]; }
+        delete inflated; delete freeBlocks;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "InflateReader", "~InflateReader");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//fills the free blocks with inflated text until the end of the file, then closes the queue so the parser sees the end
+void InflateReader::inflate() {
+    try {
+        string* block;
+        while (freeBlocks->pop(block)) {
+            block->resize(blockSize);
+            gzIn.read(&(*block)[0], blockSize);
+            block->resize(gzIn.gcount());
+
+            if (block->size() == 0)         { break; }
+            if (!inflated->push(block))     { break; }
+            if (!gzIn)                      { break; }
+        }
+        inflated->close();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "InflateReader", "inflate");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//copies up to n characters from the current block, returns -1 at the end of the file
+streamsize InflateReader::readBlocks(char* s, streamsize n) {
+    try {
+        if ((current != NULL) && (currentPos == current->size())) { freeBlocks->push(current); current = NULL; }
+
+        if (current == NULL) {
+            if (!inflated->pop(current)) { current = NULL; return -1; }
+            currentPos = 0;
+        }
+
+        streamsize length = min(n, (streamsize)(current->size() - currentPos));
+        memcpy(s, current->data() + currentPos, length);
+        currentPos += length;
+
+        return length;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "InflateReader", "readBlocks");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+
+#endif
@@ -0,0 +1,71 @@
+//
+//  inflatereader.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef inflatereader_hpp
+#define inflatereader_hpp
+
+#include "mothurout.h"
+#include "utils.hpp"
+#include "boundedqueue.hpp"
+
+/* Decompresses a .gz file on a thread of its own, ahead of whoever parses it. A gz file can't be divided by byte offset,
+ so without this the reader inflates and parses on the same stream. The inflated text is passed in blocks through
+ bounded queues, so at most numBlocks blocks are held however far the inflate thread gets ahead, and getStream() reads
+ the blocks back as a filtering_istream the fastq, fasta and qual readers already take. */
+
+/**************************************************************************************************/
+
+#ifdef USE_BOOST
+
+class InflateReader {
+
+public:
+
+    InflateReader(string); //gz file name, starts the inflate thread
+    ~InflateReader();
+
+    bool isOpen()                                       { return open;  }
+    boost::iostreams::filtering_istream& getStream()    { return in;    }
+
+private:
+
+    //boost copies the devices pushed on a stream, so the source only points back at the reader
+    struct BlockSource {
+        typedef char char_type;
+        typedef boost::iostreams::source_tag category;
+
+        InflateReader* reader;
+
+        BlockSource(InflateReader* r) : reader(r) {}
+        streamsize read(char* s, streamsize n) { return reader->readBlocks(s, n); }
+    };
+
+    MothurOut* m;
+    Utils util;
+    bool open;
+
+    ifstream file;
+    boost::iostreams::filtering_istream gzIn; //read by the inflate thread
+    boost::iostreams::filtering_istream in;   //read by the parser
+
+    vector<string*> blocks;
+    BoundedQueue<string*>* inflated;
+    BoundedQueue<string*>* freeBlocks;
+    string* current;
+    size_t currentPos;
+    std::thread* inflater;
+
+    void inflate();
+    streamsize readBlocks(char*, streamsize);
+};
+
+#endif
+
+/**************************************************************************************************/
+
+#endif /* inflatereader_hpp */
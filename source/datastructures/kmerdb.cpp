@@ -27,6 +27,11 @@
 #include "database.hpp"
 #include "kmerdb.hpp"
 
+#if defined NON_WINDOWS
+    #include <sys/mman.h>
+    #include <fcntl.h>
+#endif
+
 /**************************************************************************************************/
 
 KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
@@ -40,6 +45,8 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
 		maxKmer = power4s[kmerSize];
 		kmerLocations.resize(maxKmer+1);
         
+        compacted = false; postingStarts = NULL; postingCounts = NULL; postings = NULL; mapped = NULL; mappedSize = 0;
+        
         CurrentFile* current; current = CurrentFile::getInstance();
         version = current->getVersion();
 		
@@ -54,10 +61,11 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
 KmerDB::KmerDB() : Database() {
     CurrentFile* current; current = CurrentFile::getInstance();
     version = current->getVersion();
+    compacted = false; postingStarts = NULL; postingCounts = NULL; postings = NULL; mapped = NULL; mappedSize = 0;
 }
 /**************************************************************************************************/
 
-KmerDB::~KmerDB(){}
+KmerDB::~KmerDB(){ releaseIndex(); }
 
 /**************************************************************************************************/
 
@@ -65,42 +73,100 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 	try {
 		if (num > numSeqs) { m->mothurOut("[WARNING]: you requested " + toString(num) + " closest sequences, but the template only contains " + toString(numSeqs) + ", adjusting.\n");  num = numSeqs; }
 		
-		vector<int> topMatches;
-		Kmer kmer(kmerSize);
-		float searchScore = 0;
-		Scores.clear();
+		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;
 		
-		vector<int> matches(numSeqs, 0);						//	a record of the sequences with shared kmers
-		vector<bool> timesKmerFound(kmerLocations.size()+1, false);	//	a record of the kmers that we have already found
+		//a sequence can't share more kmers than the query has, so short queries count in 16 bits and touch half the memory
+		if (numKmers < 65536) {
+			vector<unsigned short> matches(numSeqs, 0);
+			countMatches(candidateSeq, matches);
+			return getTopMatches(matches, num, numKmers, Scores);
+		}
 		
+		vector<int> matches(numSeqs, 0);
+		countMatches(candidateSeq, matches);
+		return getTopMatches(matches, num, numKmers, Scores);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "findClosestSequences");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//matches[i] is the number of the query's different kmers that sequence i also has
+template <class T>
+void KmerDB::countMatches(Sequence* candidateSeq, vector<T>& matches) const{
+	try {
+		Kmer kmer(kmerSize);
+		vector<bool> timesKmerFound(maxKmer+2, false);	//	a record of the kmers that we have already found
+		
+		string unaligned = candidateSeq->getUnaligned();
 		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;	
 	
 		for(int i=0;i<numKmers;i++){
-			int kmerNumber = kmer.getKmerNumber(candidateSeq->getUnaligned(), i);		//	go through the query sequence and get a kmer number
+			int kmerNumber = kmer.getKmerNumber(unaligned, i);		//	go through the query sequence and get a kmer number
 			if(!timesKmerFound[kmerNumber]){				//	if we haven't seen it before...
-				for(int j=0;j<kmerLocations[kmerNumber].size();j++){//increase the count for each sequence that also has
-					matches[kmerLocations[kmerNumber][j]]++;	//	that kmer
+				if (compacted) {
+					const unsigned char* posting = postings + postingStarts[kmerNumber];
+					int seq = 0;
+					for(unsigned int j=0;j<postingCounts[kmerNumber];j++){ //decode the differences between the sequence indices
+						unsigned int diff = 0; int shift = 0;
+						while (*posting & 128) { diff |= (unsigned int)(*posting & 127) << shift; shift += 7; posting++; }
+						diff |= (unsigned int)(*posting) << shift; posting++;
+						seq += diff;
+						matches[seq]++;
+					}
+				}else {
+					for(int j=0;j<kmerLocations[kmerNumber].size();j++){//increase the count for each sequence that also has
+						matches[kmerLocations[kmerNumber][j]]++;	//	that kmer
+					}
 				}
 			}
 			timesKmerFound[kmerNumber] = true;						//	ok, we've seen the kmer now
 		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "countMatches");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//more shared kmers first, ties go to the sequence added to the database first
+inline bool isBetterMatch(const seqMatch& left, const seqMatch& right){
+	if (left.match != right.match) { return (left.match > right.match); }
+	return (left.seq < right.seq);
+}
+/**************************************************************************************************/
+//Scores holds the best score followed by the score of each match returned
+template <class T>
+vector<int> KmerDB::getTopMatches(vector<T>& matches, int num, int numKmers, vector<float>& Scores) const{
+	try {
+		vector<int> topMatches;
+		Scores.clear();
 		
 		if (num != 1) {
-			vector<seqMatch> seqMatches; seqMatches.resize(numSeqs);
-			for(int i=0;i<numSeqs;i++){		
-				seqMatches[i].seq = i;
-				seqMatches[i].match = matches[i];
+			//keep the best num sequences in a heap with the worst of them on top, a sequence that doesn't beat the
+			//worst can't be in the top num and is skipped with one comparison
+			vector<seqMatch> seqMatches; seqMatches.reserve(num);
+			for(int i=0;i<numSeqs;i++){
+				if (seqMatches.size() < num) {
+					seqMatches.push_back(seqMatch(i, matches[i]));
+					push_heap(seqMatches.begin(), seqMatches.end(), isBetterMatch);
+				}else if (matches[i] > seqMatches.front().match) {
+					pop_heap(seqMatches.begin(), seqMatches.end(), isBetterMatch);
+					seqMatches.back() = seqMatch(i, matches[i]);
+					push_heap(seqMatches.begin(), seqMatches.end(), isBetterMatch);
+				}
 			}
 			
 			//sorts putting largest matches first
-			sort(seqMatches.begin(), seqMatches.end(), compareSeqMatches);
+			sort_heap(seqMatches.begin(), seqMatches.end(), isBetterMatch);
 			
-			searchScore = seqMatches[0].match;
-			searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
+			float searchScore = 0;
+			if (seqMatches.size() != 0) { searchScore = 100 * seqMatches[0].match / (float) numKmers; }
             Scores.push_back(searchScore);
             
 			//save top matches
-			for (int i = 0; i < num; i++) {
+			for (int i = 0; i < seqMatches.size(); i++) {
 				topMatches.push_back(seqMatches[i].seq);
 				float thisScore = 100 * seqMatches[i].match / (float) numKmers;
 				Scores.push_back(thisScore);
@@ -111,13 +177,13 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
             
 			for(int i=0;i<numSeqs;i++){	
 				
-				if (matches[i] > bestMatch) {
+				if ((int)matches[i] > bestMatch) {
 					bestIndex = i;
 					bestMatch = matches[i];
 				}
 			}
             
-			searchScore = bestMatch;
+			float searchScore = bestMatch;
 			searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
 			topMatches.push_back(bestIndex);
 			Scores.push_back(searchScore);
@@ -125,31 +191,58 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 		return topMatches;		
 	}
 	catch(exception& e) {
-		m->errorOut(e, "KmerDB", "findClosestSequences");
+		m->errorOut(e, "KmerDB", "getTopMatches");
 		exit(1);
 	}	
 }
 
 /**************************************************************************************************/
-//print shortcut file
+//print shortcut file - the version line, padded to 8 bytes, followed by the compact index. It is written to a temp file
+//and renamed over the old one, a process that has the old file mapped keeps reading the old contents instead of faulting
 void KmerDB::generateDB(){
 	try {
 		
+		compact();
+		
+		string tempName = kmerDBName + ".temp";
+#if defined NON_WINDOWS
+		tempName = kmerDBName + "." + toString(getpid()) + ".temp";
+#endif
+		
 		ofstream kmerFile;										//	once we have the kmerLocations folder print it out
-		util.openOutputFile(kmerDBName, kmerFile);					//	to a file
+		if (!util.openOutputFileBinary(tempName, kmerFile)) { return; }	//	to a file
 		
 		//output version
-		kmerFile << "#" << version << endl;
+		string versionLine = "#" + version + "\n";
+		while ((versionLine.length() % 8) != 0) { versionLine += '\0'; }
+		kmerFile.write(versionLine.c_str(), versionLine.length());
 		
-		for(int i=0;i<maxKmer;i++){								//	step through all of the possible kmer numbers
-			kmerFile << i << ' ' << kmerLocations[i].size();	//	print the kmer number and the number of sequences with
-			for(int j=0;j<kmerLocations[i].size();j++){			//	that kmer.  then print out the indices of the sequences
-				kmerFile << ' ' << kmerLocations[i][j];			//	with that kmer.
-			}
-			kmerFile << endl;
-		}
+		//header - magic, file version, kmer size, number of seqs, number of kmers, size of postings
+		kmerFile.write(KMERDB_MAGIC, 8);
+		unsigned int fileVersion = KMERDB_VERSION; unsigned int k = kmerSize;
+		kmerFile.write((char*)&fileVersion, sizeof(unsigned int));
+		kmerFile.write((char*)&k, sizeof(unsigned int));
+		unsigned long long numSeqsInDB = count; unsigned long long numKmers = maxKmer+1; unsigned long long numBytes = postingStarts[maxKmer+1];
+		kmerFile.write((char*)&numSeqsInDB, sizeof(unsigned long long));
+		kmerFile.write((char*)&numKmers, sizeof(unsigned long long));
+		kmerFile.write((char*)&numBytes, sizeof(unsigned long long));
+		
+		kmerFile.write((char*)postingStarts, (numKmers+1)*sizeof(unsigned long long));
+		kmerFile.write((char*)postingCounts, numKmers*sizeof(unsigned int));
+		if ((numKmers % 2) != 0) { unsigned int pad = 0; kmerFile.write((char*)&pad, sizeof(unsigned int)); }
+		if (numBytes != 0) { kmerFile.write((char*)postings, numBytes); }
+		bool good = kmerFile.good();
 		kmerFile.close();
 		
+		if (!good) { m->mothurOut("[WARNING]: unable to write " + kmerDBName + ".\n"); util.mothurRemove(tempName); return; }
+		
+#if !defined NON_WINDOWS
+		util.mothurRemove(kmerDBName); //windows won't rename over an existing file
+#endif
+		if (rename(util.getFullPathName(tempName).c_str(), util.getFullPathName(kmerDBName).c_str()) != 0) {
+			m->mothurOut("[WARNING]: unable to rename " + tempName + " to " + kmerDBName + ".\n"); util.mothurRemove(tempName);
+		}
+		
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "generateDB");
@@ -160,6 +253,8 @@ void KmerDB::generateDB(){
 /**************************************************************************************************/
 void KmerDB::addSequence(Sequence seq) {
 	try {
+		if (compacted) { expand(); }
+		
 		Kmer kmer(kmerSize);
 		
 		string unaligned = seq.getUnaligned();	//	...take the unaligned sequence...
@@ -188,6 +283,35 @@ void KmerDB::readDB(ifstream& kmerDBFile){
 					
 		kmerDBFile.seekg(0);									//	start at the beginning of the file
 		
+		//read version
+		string line = util.getline(kmerDBFile);
+		
+		//binary files start the index at the next multiple of 8 bytes
+		unsigned long long indexStart = ((line.length() + 1 + 7) / 8) * 8;
+		char magic[8] = { 0 };
+		kmerDBFile.seekg(indexStart);
+		kmerDBFile.read(magic, 8);
+		
+		if (kmerDBFile && (strncmp(magic, KMERDB_MAGIC, 8) == 0)) {
+			kmerDBFile.close();
+			if (!readBinary(indexStart)) { m->mothurOut("[ERROR]: " + kmerDBName + " is not a valid kmer database file, please remove it and rerun.\n"); m->setControl_pressed(true); }
+		}else {
+			kmerDBFile.clear();
+			kmerDBFile.seekg(0);
+			readText(kmerDBFile);
+		}
+		
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "readDB");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//database files written by older versions of mothur
+void KmerDB::readText(ifstream& kmerDBFile){
+	try {
+		
 		//read version
 		string line = util.getline(kmerDBFile); util.gobble(kmerDBFile);
 		
@@ -201,22 +325,153 @@ void KmerDB::readDB(ifstream& kmerDBFile){
 			for(int j=0;j<numValues;j++){						//	for each kmer number get the...
 				kmerDBFile >> seqNumber;						//		1. number of sequences with the kmer number
 				kmerLocations[i].push_back(seqNumber);			//		2. sequence indices
+				if (seqNumber >= count) { count = seqNumber+1; }
 			}
 		}
 		kmerDBFile.close();
 		
+		compact();
 	}
 	catch(exception& e) {
-		m->errorOut(e, "KmerDB", "readDB");
+		m->errorOut(e, "KmerDB", "readText");
 		exit(1);
 	}	
 }
+/**************************************************************************************************/
+//maps the index into memory, or reads it in one block if mmap isn't available
+bool KmerDB::readBinary(unsigned long long indexStart){
+	try {
+		releaseIndex();
+		
+		string filename = util.getFullPathName(kmerDBName);
+		const char* contents = NULL;
+		unsigned long long size = 0;
+		
+#if defined NON_WINDOWS
+		int fd = open(filename.c_str(), O_RDONLY);
+		if (fd == -1) { return false; }
+		
+		struct stat fileInfo;
+		if ((fstat(fd, &fileInfo) == -1) || (fileInfo.st_size == 0)) { close(fd); return false; }
+		size = fileInfo.st_size;
+		
+		mapped = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (mapped == MAP_FAILED) { mapped = NULL; return false; }
+		mappedSize = size;
+		contents = (const char*)mapped;
+#else
+		ifstream in(filename.c_str(), ios::binary | ios::ate);
+		if (!in) { return false; }
+		
+		size = in.tellg();
+		ownedBuffer.resize((size + 7) / 8); //8 byte aligned like a mapped file
+		in.seekg(0, ios::beg);
+		if (size != 0) { in.read((char*)&ownedBuffer[0], size); }
+		in.close();
+		contents = (const char*)&ownedBuffer[0];
+#endif
+		
+		unsigned long long headerSize = 8 + 2*sizeof(unsigned int) + 3*sizeof(unsigned long long);
+		if (size < (indexStart + headerSize)) { releaseIndex(); return false; }
+		
+		const char* header = contents + indexStart + 8;
+		unsigned int fileVersion = *(const unsigned int*)header;
+		unsigned int k = *(const unsigned int*)(header + sizeof(unsigned int));
+		const unsigned long long* sizes = (const unsigned long long*)(header + 2*sizeof(unsigned int));
+		unsigned long long numSeqsInDB = sizes[0]; unsigned long long numKmers = sizes[1]; unsigned long long numBytes = sizes[2];
+		
+		unsigned long long startsOffset = indexStart + headerSize;
+		unsigned long long countsOffset = startsOffset + (numKmers+1)*sizeof(unsigned long long);
+		unsigned long long postingsOffset = countsOffset + ((numKmers + 1) / 2) * 2 * sizeof(unsigned int);
+		
+		if ((fileVersion != KMERDB_VERSION) || (k != kmerSize) || (numKmers != (maxKmer+1)) || (size < (postingsOffset + numBytes))) { releaseIndex(); return false; }
+		
+		postingStarts = (const unsigned long long*)(contents + startsOffset);
+		postingCounts = (const unsigned int*)(contents + countsOffset);
+		postings = (const unsigned char*)(contents + postingsOffset);
+		count = numSeqsInDB;
+		
+		vector<vector<int> > empty; kmerLocations.swap(empty);
+		compacted = true;
+		
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "readBinary");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//packs the lists into the compact index, the sequence indices in each list are increasing
+void KmerDB::compact(){
+	try {
+		if (compacted) { return; }
+		
+		ownedStarts.assign(maxKmer+2, 0);
+		ownedCounts.assign(maxKmer+1, 0);
+		ownedPostings.clear();
+		
+		for(int i=0;i<=maxKmer;i++){
+			ownedStarts[i] = ownedPostings.size();
+			ownedCounts[i] = kmerLocations[i].size();
+			
+			int last = 0;
+			for(int j=0;j<kmerLocations[i].size();j++){
+				unsigned int diff = kmerLocations[i][j] - last; last = kmerLocations[i][j];
+				while (diff >= 128) { ownedPostings.push_back((diff & 127) | 128); diff >>= 7; }
+				ownedPostings.push_back(diff);
+			}
+			vector<int> empty; kmerLocations[i].swap(empty);
+		}
+		ownedStarts[maxKmer+1] = ownedPostings.size();
+		
+		postingStarts = &ownedStarts[0];
+		postingCounts = &ownedCounts[0];
+		postings = ownedPostings.data();
+		compacted = true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "compact");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//unpacks the compact index so more sequences can be added
+void KmerDB::expand(){
+	try {
+		if (!compacted) { return; }
+		
+		kmerLocations.clear(); kmerLocations.resize(maxKmer+1);
+		for(int i=0;i<=maxKmer;i++){ kmerLocations[i] = getSequencesWithKmer(i); }
+		
+		releaseIndex();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "expand");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+void KmerDB::releaseIndex(){
+#if defined NON_WINDOWS
+	if (mapped != NULL) { munmap(mapped, mappedSize); }
+#endif
+	mapped = NULL; mappedSize = 0;
+	vector<unsigned long long> emptyStarts; ownedStarts.swap(emptyStarts);
+	vector<unsigned long long> emptyBuffer; ownedBuffer.swap(emptyBuffer);
+	vector<unsigned int> emptyCounts; ownedCounts.swap(emptyCounts);
+	vector<unsigned char> emptyPostings; ownedPostings.swap(emptyPostings);
+	postingStarts = NULL; postingCounts = NULL; postings = NULL;
+	compacted = false;
+}
 
 /**************************************************************************************************/
 int KmerDB::getCount(int kmer) {
 	try {
 		if (kmer < 0) { return 0; }  //if user gives negative number
 		else if (kmer > maxKmer) {	return 0;	}  //or a kmer that is bigger than maxkmer
+		else if (compacted) { return postingCounts[kmer]; }
 		else {	return kmerLocations[kmer].size();	}  // kmer is in vector range
 	}
 	catch(exception& e) {
@@ -246,6 +501,17 @@ vector<int> KmerDB::getSequencesWithKmer(int kmer) {
 	
 		if (kmer < 0) { }  //if user gives negative number
 		else if (kmer > maxKmer) {	}  //or a kmer that is bigger than maxkmer
+		else if (compacted) {
+			const unsigned char* posting = postings + postingStarts[kmer];
+			int seq = 0;
+			for(unsigned int j=0;j<postingCounts[kmer];j++){
+				unsigned int diff = 0; int shift = 0;
+				while (*posting & 128) { diff |= (unsigned int)(*posting & 127) << shift; shift += 7; posting++; }
+				diff |= (unsigned int)(*posting) << shift; posting++;
+				seq += diff;
+				seqs.push_back(seq);
+			}
+		}
 		else {	seqs = kmerLocations[kmer];	}
 		
 		return seqs;
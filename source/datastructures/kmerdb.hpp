@@ -16,12 +16,24 @@
  *	Construction of an object of this type will first look for an appropriately named database file and if it is found
  *	then will read in the database file (readKmerDB), otherwise it will generate one and store the data in memory
  *	(generateKmerDB)
+ *
+ *	Once the database is written or read, the lists are packed into one compact index: the sequence indices of each
+ *	kmer are stored as varint encoded differences in one byte array, with an array of where each kmer's list starts.
+ *	The database file is that index written out in binary after the version line, so reading it is mapping the file
+ *	into memory. The mapping is read only and the operating system shares it between processes using the same
+ *	reference. Text database files from older versions are still read.
+ *
+ *	Searches count the shared kmers in 16 bit counters when the query is short enough and keep only the best n
+ *	sequences in a heap while scanning the counts, instead of sorting every sequence in the database.
 
  */
 
 #include "mothur.h"
 #include "database.hpp"
 
+#define KMERDB_MAGIC "MOTHURKM"
+#define KMERDB_VERSION 1
+
 class KmerDB : public Database {
 	
 public:
@@ -44,7 +56,27 @@ private:
 	int kmerSize;
 	int maxKmer, count;
 	string kmerDBName;
-	vector<vector<int> > kmerLocations;
+	vector<vector<int> > kmerLocations; //used while adding sequences
+    
+    //compact index - the list of kmer i is postingCounts[i] varints starting at postings[postingStarts[i]]
+    bool compacted;
+    const unsigned long long* postingStarts;
+    const unsigned int* postingCounts;
+    const unsigned char* postings;
+    vector<unsigned long long> ownedStarts, ownedBuffer; //hold the index when it isn't mapped from the file
+    vector<unsigned int> ownedCounts;
+    vector<unsigned char> ownedPostings;
+    void* mapped;
+    unsigned long long mappedSize;
+    
+    void compact();
+    void expand();
+    void releaseIndex();
+    bool readBinary(unsigned long long); //offset of the binary index in the database file
+    void readText(ifstream&);
+    
+    template <class T> void countMatches(Sequence*, vector<T>&) const; //counts the query's kmers shared with each sequence
+    template <class T> vector<int> getTopMatches(vector<T>&, int, int, vector<float>&) const; //matches, num, numKmers, Scores
 };
 
 #endif
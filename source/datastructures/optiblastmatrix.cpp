@@ -41,8 +41,7 @@ int OptiBlastMatrix::readBlast(){
         if (namefile != "") { util.readNames(namefile, nameAssignment); }
         else if (countfile != "") {
             CountTable ct; ct.readTable(countfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) { nameAssignment.emplace_hint(nameAssignment.end(), ct.getSortedName(i), ct.getSortedNumSeqs(i)); }
         }
         else { readBlastNames(nameAssignment);  }
         int count = 0;
@@ -0,0 +1,402 @@
+//
+//  opticsrmatrix.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "opticsrmatrix.hpp"
+#include "counttable.h"
+#include "binarydistfile.hpp"
+
+#if defined NON_WINDOWS
+    #include <sys/mman.h>
+    #include <fcntl.h>
+#endif
+
+/***********************************************************************/
+OptiCSRMatrix::OptiCSRMatrix(string d, string nc, string f, double c, bool s) : distFile(d), format(f), sim(s), OptiData(c) {
+    try {
+        if (format == "name") { namefile = nc; countfile = ""; }
+        else if (format == "count") { countfile = nc; namefile = ""; }
+        else { countfile = ""; namefile = ""; }
+
+        //same numbering as OptiMatrix - alphabetical, then singletons removed
+        map<string, long long> nameAssignment;
+        if (namefile != "") { util.readNames(namefile, nameAssignment); }
+        else  {
+            CountTable ct; ct.readTable(countfile, false, true);
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) { nameAssignment.emplace_hint(nameAssignment.end(), ct.getSortedName(i), ct.getSortedNumSeqs(i)); }
+        }
+        long long count = 0;
+        for (map<string, long long>::iterator it = nameAssignment.begin(); it!= nameAssignment.end(); it++) {
+            it->second = count; count++;
+            nameMap.push_back(it->first);
+        }
+
+        if (BinaryDistFile::isBinary(distFile)) { readBinary(nameAssignment); }
+        else { readColumn(nameAssignment); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "OptiCSRMatrix");
+        exit(1);
+    }
+}
+/***********************************************************************/
+long long OptiCSRMatrix::print(ostream& out) {
+    try {
+        long long count = 0;
+        for (long long i = 0; i < getNumSeqs(); i++) {
+            out << i << '\t' << getName(i) << '\t';
+            for (unsigned long long k = offsets[i]; k < offsets[i+1]; k++) {
+                out << neighbors[k] << '\t';
+                count++;
+            }
+            out << endl;
+        }
+        out << endl;
+        return count;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "print");
+        exit(1);
+    }
+}
+/***********************************************************************/
+long long OptiCSRMatrix::getNumClose(long long index) {
+    try {
+        if (index < 0) { return 0; }
+        else if (index >= getNumSeqs()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return 0; }
+
+        return (offsets[index+1] - offsets[index]);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "getNumClose");
+        exit(1);
+    }
+}
+/***********************************************************************/
+bool OptiCSRMatrix::isClose(long long i, long long toFind){
+    try {
+        if ((i < 0) || (toFind < 0)) { return false; }
+        else if (i >= getNumSeqs()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return false; }
+
+        return binary_search(neighbors.begin()+offsets[i], neighbors.begin()+offsets[i+1], (unsigned int)toFind);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "isClose");
+        exit(1);
+    }
+}
+/***********************************************************************/
+set<long long> OptiCSRMatrix::getCloseSeqs(long long i){
+    try {
+        set<long long> closeSeqs;
+
+        if (i < 0) { return closeSeqs; }
+        else if (i >= getNumSeqs()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return closeSeqs; }
+
+        //neighbors are sorted, so each insert goes at the end
+        for (unsigned long long k = offsets[i]; k < offsets[i+1]; k++) { closeSeqs.insert(closeSeqs.end(), neighbors[k]); }
+
+        return closeSeqs;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "getCloseSeqs");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void OptiCSRMatrix::getCloseSeqs(long long i, vector<long long>& closeSeqs){
+    try {
+        closeSeqs.clear();
+
+        if (i < 0) { return; }
+        else if (i >= getNumSeqs()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return; }
+
+        closeSeqs.assign(neighbors.begin()+offsets[i], neighbors.begin()+offsets[i+1]);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "getCloseSeqs");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//numClose is the number of distances under the cutoff for each seq in nameMap order. Fills indexSwap with each
+//seq's new index, -1 for singletons, sets up the offsets and renames nameMap and singletons like OptiMatrix does.
+void OptiCSRMatrix::setSingletons(vector<unsigned long long>& numClose, vector<long long>& indexSwap) {
+    try {
+        map<string, string> names;
+        if (namefile != "") { util.readNames(namefile, names); }
+
+        indexSwap.assign(numClose.size(), -1);
+        offsets.assign(1, 0);
+
+        vector<string> closeNames;
+        for (long long i = 0; i < numClose.size(); i++) {
+            string name = nameMap[i];
+            if (namefile != "") { name = names[name]; } //redundant names
+
+            if (numClose[i] == 0) { singletons.push_back(name); }
+            else {
+                indexSwap[i] = closeNames.size();
+                closeNames.push_back(name);
+                offsets.push_back(offsets.back() + numClose[i]);
+            }
+        }
+        nameMap = closeNames;
+
+        if (nameMap.size() > 4294967295LL) { m->mothurOut("[ERROR]: too many sequences with distances below the cutoff, quitting.\n"); m->setControl_pressed(true); offsets.assign(1, 0); return; }
+
+        neighbors.resize(offsets.back());
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "setSingletons");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//sorts each seq's neighbors and removes pairs given twice, for example in both directions in a column file
+void OptiCSRMatrix::removeDuplicates() {
+    try {
+        unsigned long long next = 0;
+        for (long long i = 0; i < getNumSeqs(); i++) {
+            vector<unsigned int>::iterator start = neighbors.begin()+offsets[i];
+            vector<unsigned int>::iterator end = neighbors.begin()+offsets[i+1];
+            sort(start, end);
+            end = unique(start, end);
+
+            offsets[i] = next;
+            for (vector<unsigned int>::iterator it = start; it != end; it++) { neighbors[next] = *it; next++; }
+        }
+
+        if (next != neighbors.size()) { neighbors.resize(next); neighbors.shrink_to_fit(); }
+        offsets[getNumSeqs()] = next;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "removeDuplicates");
+        exit(1);
+    }
+}
+/***********************************************************************/
+int OptiCSRMatrix::readColumn(map<string, long long>& nameAssignment){
+    try {
+        string firstName, secondName;
+        float distance;
+
+        //first pass counts the distances below the cutoff for each seq
+        vector<unsigned long long> numClose(nameAssignment.size(), 0);
+        ifstream fileHandle;
+        util.openInputFile(distFile, fileHandle);
+
+        while(fileHandle){  //let's assume it's a triangular matrix...
+
+            fileHandle >> firstName; util.gobble(fileHandle);
+            fileHandle >> secondName; util.gobble(fileHandle);
+            fileHandle >> distance;	util.gobble(fileHandle); // get the row and column names and distance
+
+            if (m->getControl_pressed()) {  fileHandle.close();   return 0; }
+
+            if (util.isEqual(distance,-1)) { distance = 1000000; }
+            else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+
+            if(distance <= cutoff){
+                map<string,long long>::iterator itA = nameAssignment.find(firstName);
+                map<string,long long>::iterator itB = nameAssignment.find(secondName);
+
+                if(itA == nameAssignment.end()){  m->mothurOut("AAError: Sequence '" + firstName + "' was not found in the name or count file, please correct\n"); exit(1);  }
+                if(itB == nameAssignment.end()){  m->mothurOut("ABError: Sequence '" + secondName + "' was not found in the name or count file, please correct\n"); exit(1);  }
+
+                numClose[itA->second]++;
+                numClose[itB->second]++;
+            }
+        }
+        fileHandle.close();
+
+        vector<long long> indexSwap;
+        setSingletons(numClose, indexSwap);
+        numClose.clear();
+
+        if (m->getControl_pressed()) { return 0; }
+
+        //second pass fills in the neighbors
+        vector<unsigned long long> nextNeighbor(offsets.begin(), offsets.end()-1);
+        ifstream in;
+        util.openInputFile(distFile, in);
+
+        while(in){
+
+            in >> firstName; util.gobble(in);
+            in >> secondName; util.gobble(in);
+            in >> distance;	util.gobble(in);
+
+            if (m->getControl_pressed()) {  in.close();   return 0; }
+
+            if (util.isEqual(distance,-1)) { distance = 1000000; }
+            else if (sim) { distance = 1.0 - distance;  }
+
+            if(distance <= cutoff){
+                long long newA = indexSwap[nameAssignment[firstName]];
+                long long newB = indexSwap[nameAssignment[secondName]];
+
+                neighbors[nextNeighbor[newA]] = newB; nextNeighbor[newA]++;
+                neighbors[nextNeighbor[newB]] = newA; nextNeighbor[newB]++;
+            }
+        }
+        in.close();
+
+        removeDuplicates();
+
+        return 1;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "readColumn");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//maps the binary distance file into memory, or reads it in one block if mmap isn't available
+int OptiCSRMatrix::readBinary(map<string, long long>& nameAssignment){
+    try {
+        string filename = util.getFullPathName(distFile);
+        int result = 0;
+
+#if defined NON_WINDOWS
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) { m->mothurOut("[ERROR]: Could not open " + distFile + "\n"); m->setControl_pressed(true); return 0; }
+
+        struct stat fileInfo;
+        if ((fstat(fd, &fileInfo) == -1) || (fileInfo.st_size == 0)) { close(fd); m->mothurOut("[ERROR]: " + distFile + " is not a binary distance file.\n"); m->setControl_pressed(true); return 0; }
+        unsigned long long size = fileInfo.st_size;
+
+        void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) { m->mothurOut("[ERROR]: Could not map " + distFile + " into memory.\n"); m->setControl_pressed(true); return 0; }
+
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        result = readMapped((const char*)mapped, size, nameAssignment);
+        munmap(mapped, size);
+#else
+        ifstream in(filename.c_str(), ios::binary | ios::ate);
+        if (!in) { m->mothurOut("[ERROR]: Could not open " + distFile + "\n"); m->setControl_pressed(true); return 0; }
+
+        unsigned long long size = in.tellg();
+        vector<unsigned long long> buffer((size + 7) / 8); //8 byte aligned like a mapped file
+        in.seekg(0, ios::beg);
+        if (size != 0) { in.read((char*)&buffer[0], size); }
+        in.close();
+
+        result = readMapped((const char*)&buffer[0], size, nameAssignment);
+#endif
+
+        return result;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "readBinary");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//the layout is described in binarydistfile.hpp. data must be 8 byte aligned.
+int OptiCSRMatrix::readMapped(const char* data, unsigned long long size, map<string, long long>& nameAssignment){
+    try {
+        unsigned int version, bits;
+        unsigned long long numSeqs, numDists, nameBytes;
+
+        if ((size < 40) || (strncmp(data, BINARYDIST_MAGIC, 8) != 0)) { m->mothurOut("[ERROR]: " + distFile + " is not a binary distance file.\n"); m->setControl_pressed(true); return 0; }
+        memcpy(&version, data+8, sizeof(unsigned int));
+        memcpy(&bits, data+12, sizeof(unsigned int));
+        memcpy(&numSeqs, data+16, sizeof(unsigned long long));
+        memcpy(&numDists, data+24, sizeof(unsigned long long));
+        memcpy(&nameBytes, data+32, sizeof(unsigned long long));
+
+        if (version != BINARYDIST_VERSION) { m->mothurOut("[ERROR]: " + distFile + " was written by a newer version of mothur, version " + toString(version) + ".\n"); m->setControl_pressed(true); return 0; }
+        if ((bits != 32) && (bits != 16)) { m->mothurOut("[ERROR]: " + distFile + " has an unknown precision of " + toString(bits) + " bits.\n"); m->setControl_pressed(true); return 0; }
+
+        unsigned long long paddedBytes = nameBytes;
+        while ((paddedBytes % 8) != 0) { paddedBytes++; }
+
+        unsigned long long rowPos = 40 + paddedBytes;
+        unsigned long long colPos = rowPos + ((numSeqs+1) * sizeof(unsigned long long));
+        unsigned long long distPos = colPos + (numDists * sizeof(unsigned int));
+        if ((distPos + (numDists * (bits / 8))) > size) { m->mothurOut("[ERROR]: " + distFile + " is damaged or incomplete.\n"); m->setControl_pressed(true); return 0; }
+
+        const unsigned long long* rowStarts = (const unsigned long long*)(data + rowPos);
+        const unsigned int* cols = (const unsigned int*)(data + colPos);
+        const float* dists = (const float*)(data + distPos);
+        const unsigned short* halfDists = (const unsigned short*)(data + distPos);
+
+        //index of each binary file sequence in the nameMap
+        vector<long long> indexes; indexes.reserve(numSeqs);
+        const char* nameStart = data + 40;
+        for (unsigned long long i = 0; i < nameBytes; i++) {
+            if (data[40+i] != '\n') { continue; }
+
+            string name(nameStart, (data + 40 + i) - nameStart);
+            nameStart = data + 40 + i + 1;
+
+            map<string,long long>::iterator it = nameAssignment.find(name);
+            if(it == nameAssignment.end()){  m->mothurOut("AAError: Sequence '" + name + "' was not found in the name or count file, please correct\n"); exit(1);  }
+            indexes.push_back(it->second);
+        }
+        if ((indexes.size() != numSeqs) || (rowStarts[numSeqs] != numDists)) { m->mothurOut("[ERROR]: " + distFile + " is damaged or incomplete.\n"); m->setControl_pressed(true); return 0; }
+
+        //first pass counts the distances below the cutoff for each seq
+        vector<unsigned long long> numClose(nameAssignment.size(), 0);
+        for (unsigned long long i = 0; i < numSeqs; i++) {
+            if (m->getControl_pressed()) { return 0; }
+
+            if ((rowStarts[i] > rowStarts[i+1]) || (rowStarts[i+1] > numDists)) { m->mothurOut("[ERROR]: " + distFile + " is damaged or incomplete.\n"); m->setControl_pressed(true); return 0; }
+
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) {
+                float distance = (bits == 32) ? dists[k] : BinaryDistFile::halfToFloat(halfDists[k]);
+
+                if (util.isEqual(distance,-1)) { distance = 1000000; }
+                else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+
+                if(distance <= cutoff){
+                    if (cols[k] >= numSeqs) { m->mothurOut("[ERROR]: " + distFile + " is damaged or incomplete.\n"); m->setControl_pressed(true); return 0; }
+                    numClose[indexes[i]]++;
+                    numClose[indexes[cols[k]]]++;
+                }
+            }
+        }
+
+        vector<long long> indexSwap;
+        setSingletons(numClose, indexSwap);
+        numClose.clear();
+
+        if (m->getControl_pressed()) { return 0; }
+
+        //second pass fills in the neighbors
+        vector<unsigned long long> nextNeighbor(offsets.begin(), offsets.end()-1);
+        for (unsigned long long i = 0; i < numSeqs; i++) {
+            if (m->getControl_pressed()) { return 0; }
+
+            for (unsigned long long k = rowStarts[i]; k < rowStarts[i+1]; k++) {
+                float distance = (bits == 32) ? dists[k] : BinaryDistFile::halfToFloat(halfDists[k]);
+
+                if (util.isEqual(distance,-1)) { distance = 1000000; }
+                else if (sim) { distance = 1.0 - distance;  }
+
+                if(distance <= cutoff){
+                    long long newA = indexSwap[indexes[i]];
+                    long long newB = indexSwap[indexes[cols[k]]];
+
+                    neighbors[nextNeighbor[newA]] = newB; nextNeighbor[newA]++;
+                    neighbors[nextNeighbor[newB]] = newA; nextNeighbor[newB]++;
+                }
+            }
+        }
+
+        removeDuplicates();
+
+        return 1;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCSRMatrix", "readMapped");
+        exit(1);
+    }
+}
+/***********************************************************************/
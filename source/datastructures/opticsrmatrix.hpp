@@ -0,0 +1,58 @@
+//
+//  opticsrmatrix.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef opticsrmatrix_hpp
+#define opticsrmatrix_hpp
+
+#include "optidata.hpp"
+
+/* This class holds the same closeness information as OptiMatrix, but instead of a set per sequence it stores the
+ neighbors of all the sequences in one sorted array, with an offset array giving where each sequence's neighbors start
+ (compressed sparse row). That is 4 bytes per neighbor instead of a tree node, so about 8 bytes per distance under
+ the cutoff instead of about 48.
+
+ Column files are read twice, once to count each sequence's neighbors and once to fill the array, so the distances are
+ never held in memory twice. Binary distance files (.bdist) are memory mapped and the neighbors are counted and filled
+ from the mapped rows without parsing. Sequences are numbered the same way OptiMatrix numbers them, so clustering gives
+ the same results with either class. */
+
+/**************************************************************************************************/
+
+class OptiCSRMatrix : public OptiData {
+
+public:
+
+    OptiCSRMatrix(string, string, string, double, bool); //distfile, dupsFile, dupsFormat, cutoff, sim - column or binary distfile
+    ~OptiCSRMatrix(){}
+
+    set<long long> getCloseSeqs(long long);
+    void getCloseSeqs(long long, vector<long long>&);
+    bool isClose(long long, long long);
+    long long getNumClose(long long);
+    long long getNumSeqs() { if (offsets.size() == 0) { return 0; } return offsets.size()-1; }
+    long long getNumDists() { return neighbors.size(); }
+    long long print(ostream&);
+
+protected:
+
+    string distFile, namefile, countfile, format;
+    bool sim;
+
+    vector<unsigned long long> offsets;  //neighbors of seq i are [offsets[i], offsets[i+1])
+    vector<unsigned int> neighbors;      //sorted within each seq
+
+    int readColumn(map<string, long long>&);
+    int readBinary(map<string, long long>&);
+    int readMapped(const char*, unsigned long long, map<string, long long>&); //file contents, size
+    void setSingletons(vector<unsigned long long>&, vector<long long>&);
+    void removeDuplicates();
+};
+
+/**************************************************************************************************/
+
+#endif /* opticsrmatrix_hpp */
@@ -69,6 +69,21 @@ set<long long> OptiData::getCloseSeqs(long long i){
     }
 }
 /***********************************************************************/
+void OptiData::getCloseSeqs(long long i, vector<long long>& closeSeqs){
+    try {
+        closeSeqs.clear();
+        
+        if (i < 0) { return; }
+        else if (i >= closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return; }
+        
+        closeSeqs.assign(closeness[i].begin(), closeness[i].end());
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiData", "getCloseSeqs");
+        exit(1);
+    }
+}
+/***********************************************************************/
 //maps unique name to index in distance matrix
 //used by sensspec to get translate the list file name to the index name for closeness shirt
 map<string, long long> OptiData::getNameIndexMap() {
@@ -76,7 +91,7 @@ map<string, long long> OptiData::getNameIndexMap() {
         map<string, long long> nameIndexes;
         for (int i = 0; i < nameMap.size(); i++) {
             vector<string> thisBinsSeqs; util.splitAtComma(nameMap[i], thisBinsSeqs);
-            if (i < closeness.size()) { nameIndexes[thisBinsSeqs[0]] = i;  }
+            if (i < getNumSeqs()) { nameIndexes[thisBinsSeqs[0]] = i;  }
         }
         return nameIndexes;
     }
@@ -89,7 +104,7 @@ map<string, long long> OptiData::getNameIndexMap() {
 string OptiData::getName(long long index) {
     try {
         if (index < 0) { return ""; }
-        else if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return ""; }
+        else if (index > getNumSeqs()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return ""; }
         
         return nameMap[index];
     }
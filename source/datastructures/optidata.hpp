@@ -26,13 +26,14 @@ public:
     OptiData(double c)  { m = MothurOut::getInstance(); cutoff = c; }
     virtual ~OptiData(){}
     
-    set<long long> getCloseSeqs(long long i);// { return closeness[i]; }
-    bool isClose(long long, long long);
-    long long getNumClose(long long);
+    virtual set<long long> getCloseSeqs(long long i);// { return closeness[i]; }
+    virtual void getCloseSeqs(long long, vector<long long>&); //fills the vector with the seqs close to seq i, sorted
+    virtual bool isClose(long long, long long);
+    virtual long long getNumClose(long long);
     map<string, long long> getNameIndexMap();
     string getName(long long); //name from nameMap index
     
-    long long getNumSeqs() { return closeness.size(); }
+    virtual long long getNumSeqs() { return closeness.size(); }
     long long getNumSingletons() { return singletons.size(); }
     virtual long long getNumDists(); //number of distances under cutoff
     ListVector* getListSingle();
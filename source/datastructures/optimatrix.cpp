@@ -8,6 +8,7 @@
 
 #include "optimatrix.h"
 #include "counttable.h"
+#include "binarydistfile.hpp"
 
 /***********************************************************************/
 OptiMatrix::OptiMatrix(vector< set<long long> > close, vector<string> name, vector<string> single, double c) : OptiData(c) {
@@ -202,8 +203,7 @@ int OptiMatrix::readColumn(){
         if (namefile != "") { util.readNames(namefile, nameAssignment); }
         else  {
             CountTable ct; ct.readTable(countfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) { nameAssignment.emplace_hint(nameAssignment.end(), ct.getSortedName(i), ct.getSortedNumSeqs(i)); }
         }
         long long count = 0;
         for (map<string, long long>::iterator it = nameAssignment.begin(); it!= nameAssignment.end(); it++) {
@@ -211,6 +211,8 @@ int OptiMatrix::readColumn(){
             nameMap.push_back(it->first);
         }
         
+        if (BinaryDistFile::isBinary(distFile)) { return readBinary(nameAssignment); }
+        
         string firstName, secondName;
         float distance;
         
@@ -322,5 +324,96 @@ int OptiMatrix::readColumn(){
 }
 
 /***********************************************************************/
-
+//same as readColumn, but the distances come from a binary distance file
+int OptiMatrix::readBinary(map<string, long long>& nameAssignment){
+    try {
+        Utils util;
+        BinaryDistFile binDist;
+        if (!binDist.read(distFile)) { m->setControl_pressed(true); return 0; }
+        
+        //index of each binary file sequence in the nameMap
+        vector<long long> indexes;
+        for (long long i = 0; i < binDist.getNumSeqs(); i++) {
+            map<string,long long>::iterator it = nameAssignment.find(binDist.getName(i));
+            if(it == nameAssignment.end()){  m->mothurOut("AAError: Sequence '" + binDist.getName(i) + "' was not found in the name or count file, please correct\n"); exit(1);  }
+            indexes.push_back(it->second);
+        }
+        
+        ///////////////////// Read to eliminate singletons ///////////////////////
+        vector<bool> singleton; singleton.resize(nameAssignment.size(), true);
+        for (long long i = 0; i < binDist.getNumSeqs(); i++) {
+            if (m->getControl_pressed()) { return 0; }
+            
+            for (unsigned long long k = binDist.getRowStart(i); k < binDist.getRowStart(i+1); k++) {
+                float distance = binDist.getDist(k);
+                
+                if (util.isEqual(distance,-1)) { distance = 1000000; }
+                else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+                
+                if(distance <= cutoff){
+                    singleton[indexes[i]] = false;
+                    singleton[indexes[binDist.getCol(k)]] = false;
+                }
+            }
+        }
+        //////////////////////////////////////////////////////////////////////////
+        
+        vector<long long> singletonIndexSwap(singleton.size(), 0);
+        long long nonSingletonCount = 0;
+        for (long long i = 0; i < singleton.size(); i++) {
+            if (!singleton[i]) { //if you are a singleton
+                singletonIndexSwap[i] = nonSingletonCount;
+                nonSingletonCount++;
+            }else { singletons.push_back(nameMap[i]); }
+        }
+        singleton.clear();
+        
+        closeness.resize(nonSingletonCount);
+        
+        map<string, string> names;
+        if (namefile != "") {
+            util.readNames(namefile, names);
+            for (long long i = 0; i < singletons.size(); i++) {
+                singletons[i] = names[singletons[i]];
+            }
+        }
+        
+        for (long long i = 0; i < binDist.getNumSeqs(); i++) {
+            if (m->getControl_pressed()) { return 0; }
+            
+            for (unsigned long long k = binDist.getRowStart(i); k < binDist.getRowStart(i+1); k++) {
+                float distance = binDist.getDist(k);
+                
+                if (util.isEqual(distance,-1)) { distance = 1000000; }
+                else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+                
+                if(distance <= cutoff){
+                    string firstName = binDist.getName(i);
+                    string secondName = binDist.getName(binDist.getCol(k));
+                    
+                    long long newA = singletonIndexSwap[indexes[i]];
+                    long long newB = singletonIndexSwap[indexes[binDist.getCol(k)]];
+                    closeness[newA].insert(newB);
+                    closeness[newB].insert(newA);
+                    
+                    if (namefile != "") {
+                        firstName = names[firstName];  //redundant names
+                        secondName = names[secondName]; //redundant names
+                    }
+                    
+                    nameMap[newA] = firstName;
+                    nameMap[newB] = secondName;
+                }
+            }
+        }
+        nameAssignment.clear();
+        
+        return 1;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "readBinary");
+        exit(1);
+    }
+}
+/***********************************************************************/
 
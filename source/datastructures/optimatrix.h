@@ -32,6 +32,7 @@ protected:
 
     int readPhylip();
     int readColumn();
+    int readBinary(map<string, long long>&);
 };
 
 
@@ -516,8 +516,7 @@ int OptiRefMatrix::readFiles(string distFile, string distFormat, string dupsFile
         if (namefile != "") { util.readNames(namefile, nameAssignment); }
         else  {
             CountTable ct; ct.readTable(countfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) { nameAssignment.emplace_hint(nameAssignment.end(), ct.getSortedName(i), ct.getSortedNumSeqs(i)); }
         }
         
         //select sequences to be reference
@@ -618,8 +617,7 @@ int OptiRefMatrix::readFiles(string refdistfile, string refnamefile, string refc
         if (refnamefile != "") { util.readNames(refnamefile, nameAssignment); }
         else  {
             CountTable ct; ct.readTable(refcountfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) { nameAssignment.emplace_hint(nameAssignment.end(), ct.getSortedName(i), ct.getSortedNumSeqs(i)); }
         }
         
         long long count = 0;
@@ -641,8 +639,7 @@ int OptiRefMatrix::readFiles(string refdistfile, string refnamefile, string refc
         if (fitnamefile != "") { util.readNames(fitnamefile, fitnameAssignment); }
         else  {
             CountTable ct; ct.readTable(fitcountfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  fitnameAssignment[it->first] = it->second; }
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) { fitnameAssignment.emplace_hint(fitnameAssignment.end(), ct.getSortedName(i), ct.getSortedNumSeqs(i)); }
         }
         
         for (map<string, long long>::iterator it = fitnameAssignment.begin(); it!= fitnameAssignment.end(); it++) {
@@ -0,0 +1,153 @@
+//
+//  packedseqdb.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "packedseqdb.hpp"
+
+/**************************************************************************************************/
+PackedSeqDB::PackedSeqDB() {
+    m = MothurOut::getInstance();
+    numWords = 0; numPlanes = 0; recordSize = 0; alignLength = 0; packed = false;
+}
+/**************************************************************************************************/
+bool PackedSeqDB::pack(SequenceDB& db) {
+    try {
+        vector<SequenceDB*> dbs; dbs.push_back(&db);
+        return pack(dbs);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSeqDB", "pack");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool PackedSeqDB::pack(SequenceDB& db, SequenceDB& db2) {
+    try {
+        vector<SequenceDB*> dbs; dbs.push_back(&db); dbs.push_back(&db2);
+        return pack(dbs);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSeqDB", "pack");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool PackedSeqDB::pack(vector<SequenceDB*>& dbs) {
+    try {
+        packed = false; names.clear(); bits.clear(); summaries.clear();
+
+        //find the alignment length and the residue alphabet
+        vector<bool> seen(256, false);
+        long long total = 0; alignLength = -1;
+        for (int k = 0; k < dbs.size(); k++) {
+            for (int i = 0; i < dbs[k]->getNumSeqs(); i++) {
+                if (m->getControl_pressed()) { return false; }
+
+                string aligned = dbs[k]->get(i).getAligned();
+
+                if (alignLength == -1) { alignLength = aligned.length(); }
+                else if (alignLength != aligned.length()) { return false; }
+
+                for (int j = 0; j < aligned.length(); j++) { seen[(unsigned char)aligned[j]] = true; }
+                total++;
+            }
+        }
+
+        if (total == 0) { return false; }
+
+        vector<unsigned char> codes(256, 0);
+        int numResidues = 0;
+        for (int c = 0; c < 256; c++) {
+            if (!seen[c] || (c == '-') || (c == '.')) { continue; }
+            codes[c] = numResidues; numResidues++;
+        }
+
+        if (numResidues <= 4)        { numPlanes = 2; }
+        else if (numResidues <= 16)  { numPlanes = 4; }
+        else { return false; }
+
+        recordSize = 2 + numPlanes;
+        numWords = (alignLength + 63) / 64;
+        if (numWords == 0) { numWords = 1; }
+
+        bits.resize(total * numWords * recordSize, 0);
+        summaries.resize(total);
+        names.reserve(total);
+
+        long long index = 0;
+        for (int k = 0; k < dbs.size(); k++) {
+            for (int i = 0; i < dbs[k]->getNumSeqs(); i++) {
+                if (m->getControl_pressed()) { return false; }
+
+                Sequence seq = dbs[k]->get(i);
+                string aligned = seq.getAligned();
+                names.push_back(seq.getName());
+                encode(aligned, codes, index);
+                index++;
+            }
+        }
+
+        packed = true;
+
+        return packed;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSeqDB", "pack");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void PackedSeqDB::encode(string& aligned, vector<unsigned char>& codes, long long index) {
+    try {
+        unsigned long long* seq = &(bits[index * numWords * recordSize]);
+        PackedSeqSummary& summary = summaries[index];
+        
+        for (int col = 0; col < alignLength; col++) {
+            if (aligned[col] == '.') { continue; }
+            if (summary.start == -1) { summary.start = col; }
+            summary.end = col;
+            if (aligned[col] != '-') {
+                summary.numBases++;
+                
+                switch (toupper(aligned[col])) {
+                    case 'A': summary.baseCounts[0]++; break;
+                    case 'C': summary.baseCounts[1]++; break;
+                    case 'G': summary.baseCounts[2]++; break;
+                    case 'T': summary.baseCounts[3]++; break;
+                    default: summary.baseCounts[4]++; break;
+                }
+            }
+        }
+        for (int col = summary.start+1; col < summary.end; col++) {
+            if (aligned[col] == '.') { summary.terminalDotsOnly = false; break; }
+        }
+
+        for (int w = 0; w < numWords; w++) {
+            unsigned long long* record = seq + (w * recordSize);
+
+            for (int b = 0; b < 64; b++) {
+                int col = (w * 64) + b;
+                unsigned long long bit = 1ULL << b;
+
+                if (col >= alignLength)         { record[1] |= bit; } //pad with terminal gaps
+                else if (aligned[col] == '-')   { record[0] |= bit; }
+                else if (aligned[col] == '.')   { record[1] |= bit; }
+                else {
+                    unsigned char code = codes[(unsigned char)aligned[col]];
+                    for (int p = 0; p < numPlanes; p++) {
+                        if ((code >> p) & 1) { record[2+p] |= bit; }
+                    }
+                }
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSeqDB", "encode");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
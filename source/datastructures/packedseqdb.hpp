@@ -0,0 +1,78 @@
+//
+//  packedseqdb.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef packedseqdb_hpp
+#define packedseqdb_hpp
+
+#include "mothurout.h"
+#include "sequencedb.h"
+
+/* This class stores aligned sequences bit-sliced 64 columns to a word, so the distance calculators can compare
+ 64 columns per operation instead of walking the aligned strings a character at a time.
+
+ Each word of a sequence is stored as a record of 2 + numPlanes unsigned long longs:
+    record[0] - bit set where the column is a '-' (gap)
+    record[1] - bit set where the column is a '.' (terminal gap)
+    record[2...] - bit planes of the column's residue code. Gap columns have code 0.
+
+ Residue codes are assigned from the alphabet of all the sequences packed together, so any two packed sequences
+ have the same characters at a column if and only if their gap, terminal gap and code bits match. When the alphabet
+ has 4 or fewer residues 2 planes are used, 16 or fewer uses 4 planes, otherwise the sequences can't be packed and
+ the caller should fall back to the string based calculators. Columns past the alignment length are stored as '.'. */
+
+/**************************************************************************************************/
+
+struct PackedSeqSummary {
+    int start, end;             //first and last column that is not a '.', -1 if the seq is all '.'s
+    int numBases;               //columns that are not a '-' or '.'
+    bool terminalDotsOnly;      //no '.'s between start and end
+    int baseCounts[5];          //A, C, G, T and any other base, ignoring case
+    
+    PackedSeqSummary() : start(-1), end(-1), numBases(0), terminalDotsOnly(true) { for (int i = 0; i < 5; i++) { baseCounts[i] = 0; } }
+};
+
+/**************************************************************************************************/
+
+class PackedSeqDB {
+
+public:
+
+    PackedSeqDB();
+    ~PackedSeqDB() {}
+
+    bool pack(SequenceDB&);                 //returns false if the sequences can't be packed
+    bool pack(SequenceDB&, SequenceDB&);    //sequences from the second db are appended after the first
+
+    bool isPacked()                 { return packed;            }
+    long long getNumSeqs()          { return names.size();      }
+    int getNumWords()               { return numWords;          }
+    int getNumPlanes()              { return numPlanes;         }
+    int getRecordSize()             { return recordSize;        }
+    int getAlignLength()            { return alignLength;       }
+    string getName(long long i)     { return names[i];          }
+
+    const unsigned long long* getSeq(long long i) const { return &(bits[i * numWords * recordSize]); }
+    const PackedSeqSummary& getSummary(long long i) const { return summaries[i]; }
+
+private:
+
+    MothurOut* m;
+    vector<string> names;
+    vector<unsigned long long> bits;
+    vector<PackedSeqSummary> summaries;
+    int numWords, numPlanes, recordSize, alignLength;
+    bool packed;
+
+    bool pack(vector<SequenceDB*>&);
+    void encode(string&, vector<unsigned char>&, long long);
+
+};
+
+/**************************************************************************************************/
+
+#endif /* packedseqdb_hpp */
@@ -0,0 +1,296 @@
+//
+//  stripedalignment.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "stripedalignment.hpp"
+
+#if defined(__GNUC__)
+    #define STRIPED_VECTORS
+    #define STRIPED_INLINE inline __attribute__((always_inline))
+    #if defined(__x86_64__) || defined(__i386__)
+        #define STRIPED_DISPATCH
+    #endif
+#endif
+
+#define STRIPED_NOT_FILLED -16384 //low enough that no real score is below it, high enough that adding a gap doesn't wrap
+#define STRIPED_MAX_SCORE 12000
+
+#ifdef STRIPED_VECTORS
+
+#if !defined(__clang__)
+    #pragma GCC diagnostic ignored "-Wpsabi" //the helpers are always inlined, so no AVX vector crosses a call
+#endif
+
+typedef short v8s __attribute__((vector_size(16)));
+typedef short v16s __attribute__((vector_size(32)));
+
+/**************************************************************************************************/
+template<class V>
+STRIPED_INLINE V stripedSplat(short value) {
+    V v; short* lanes = (short*)&v;
+    for (int l = 0; l < (int)(sizeof(V)/sizeof(short)); l++) { lanes[l] = value; }
+    return v;
+}
+/**************************************************************************************************/
+template<class V>
+STRIPED_INLINE V stripedMax(V a, V b) { V greater = a > b; return (a & greater) | (b & ~greater); }
+/**************************************************************************************************/
+template<class V>
+STRIPED_INLINE V stripedSelect(V mask, V a, V b) { return (a & mask) | (b & ~mask); }
+/**************************************************************************************************/
+//lane l gets lane l-1, lane 0 gets value
+template<class V>
+STRIPED_INLINE V stripedShift(V v, short value) {
+    const int lanes = sizeof(V)/sizeof(short);
+    short buffer[lanes+1];
+    memcpy(buffer+1, &v, sizeof(V));
+    buffer[0] = value;
+    V shifted; memcpy(&shifted, buffer, sizeof(V));
+    return shifted;
+}
+/**************************************************************************************************/
+template<class V>
+STRIPED_INLINE bool stripedAny(V mask) {
+    unsigned long long words[sizeof(V)/8]; memcpy(words, &mask, sizeof(V));
+    unsigned long long any = 0;
+    for (int w = 0; w < (int)(sizeof(V)/8); w++) { any |= words[w]; }
+    return (any != 0);
+}
+/**************************************************************************************************/
+template<class V>
+STRIPED_INLINE short stripedLane(V v, int lane) { short lanes[sizeof(V)/sizeof(short)]; memcpy(lanes, &v, sizeof(V)); return lanes[lane]; }
+/**************************************************************************************************/
+template<class V>
+STRIPED_INLINE void stripedStoreDirections(V directions, unsigned char* out) {
+    const int lanes = sizeof(V)/sizeof(short);
+    short buffer[lanes]; memcpy(buffer, &directions, sizeof(V));
+    for (int l = 0; l < lanes; l++) { out[l] = (unsigned char)buffer[l]; }
+}
+/**************************************************************************************************/
+//bottom row scores in column order, column 0 is 0
+template<class V>
+STRIPED_INLINE void stripedLastRow(V* H, float* lastRow, int lA, int numSegments) {
+    const int lanes = sizeof(V)/sizeof(short);
+    short buffer[lanes];
+    for (int k = 0; k < numSegments; k++) {
+        memcpy(buffer, &H[k], sizeof(V));
+        for (int l = 0; l < lanes; l++) {
+            int column = l * numSegments + k + 1;
+            if (column < lA) { lastRow[column] = buffer[l]; }
+        }
+    }
+}
+/**************************************************************************************************/
+//NeedlemanOverlap::align - a cell is the best of diagonal, up and left, ties go to diagonal then up
+template<class V>
+STRIPED_INLINE void stripedNeedlemanKernel(void* work, const string& seqB, const short* stripedA, const short* scores, unsigned char* directions, float* lastColumn, float* lastRow, int lA, int lB, int numSegments) {
+    const int lanes = sizeof(V)/sizeof(short);
+    V* previousH = (V*)work; V* H = previousH + numSegments; V* T = H + numSegments; V* diagonalBest = T + numSegments;
+
+    const V vMatch = stripedSplat<V>(scores[0]), vMismatch = stripedSplat<V>(scores[1]), vGap = stripedSplat<V>(scores[2]);
+    const V vD = stripedSplat<V>('d'), vU = stripedSplat<V>('u'), vL = stripedSplat<V>('l');
+    const V* vA = (const V*)stripedA;
+
+    for (int k = 0; k < numSegments; k++) { previousH[k] = stripedSplat<V>(0); } //the first row
+
+    int lastSegment = (lA-2) % numSegments; int lastLane = (lA-2) / numSegments;
+
+    for (int i = 1; i < lB; i++) {
+        const V vB = stripedSplat<V>((short)(unsigned char)seqB[i]);
+
+        //best of diagonal and up, and the first guess at the row with only the left gaps inside each lane
+        V diagonalH = stripedShift(previousH[numSegments-1], 0); //column 0 is 0
+        V vF = stripedShift(stripedSplat<V>(STRIPED_NOT_FILLED), (short)(0 + scores[2])); //column 1 from column 0
+        for (int k = 0; k < numSegments; k++) {
+            V same = (vA[k] == vB);
+            V diagonal = diagonalH + stripedSelect(same, vMatch, vMismatch);
+            V up = previousH[k] + vGap;
+            V useDiagonal = (diagonal >= up);
+            T[k] = stripedSelect(useDiagonal, diagonal, up); diagonalBest[k] = useDiagonal;
+            H[k] = stripedMax(T[k], vF);
+            vF = H[k] + vGap;
+            diagonalH = previousH[k];
+        }
+
+        //carry the left gaps from the end of each lane into the next one until nothing changes
+        vF = stripedShift(vF, STRIPED_NOT_FILLED);
+        int k = 0;
+        while (stripedAny(vF > H[k])) {
+            H[k] = stripedMax(H[k], vF);
+            vF = H[k] + vGap;
+            k++;
+            if (k == numSegments) { k = 0; vF = stripedShift(vF, STRIPED_NOT_FILLED); }
+        }
+
+        //pointers from the final scores
+        unsigned char* rowDirections = directions + (long long)i * numSegments * lanes;
+        V leftH = stripedShift(H[numSegments-1], 0);
+        for (int k = 0; k < numSegments; k++) {
+            V left = leftH + vGap;
+            V useBest = (T[k] >= left);
+            V best = stripedSelect(diagonalBest[k], vD, vU);
+            stripedStoreDirections(stripedSelect(useBest, best, vL), rowDirections + k * lanes);
+            leftH = H[k];
+        }
+
+        lastColumn[i] = stripedLane(H[lastSegment], lastLane);
+        if (i == (lB-1)) { stripedLastRow(H, lastRow, lA, numSegments); }
+
+        V* temp = previousH; previousH = H; H = temp;
+    }
+}
+/**************************************************************************************************/
+//GotohOverlap::align - I is a gap in seqB along the row, D a gap in seqA down the column. A cell is I if I > D and
+//I > diagonal, D if D >= I and D > diagonal, otherwise diagonal
+template<class V>
+STRIPED_INLINE void stripedGotohKernel(void* work, const string& seqB, const short* stripedA, const short* scores, unsigned char* directions, float* lastColumn, float* lastRow, int lA, int lB, int numSegments) {
+    const int lanes = sizeof(V)/sizeof(short);
+    V* previousC = (V*)work; V* C = previousC + numSegments; V* previousD = C + numSegments; V* D = previousD + numSegments;
+    V* I = D + numSegments; V* diagonals = I + numSegments;
+
+    const V vMatch = stripedSplat<V>(scores[0]), vMismatch = stripedSplat<V>(scores[1]);
+    const V vGapOpen = stripedSplat<V>(scores[2]), vGapExtend = stripedSplat<V>(scores[3]);
+    const V vD = stripedSplat<V>('d'), vU = stripedSplat<V>('u'), vL = stripedSplat<V>('l');
+    const V* vA = (const V*)stripedA;
+
+    for (int k = 0; k < numSegments; k++) { previousC[k] = stripedSplat<V>(0); previousD[k] = stripedSplat<V>(0); } //the first row
+
+    short firstI = max(0, (int)scores[2]) + scores[3]; //column 1 from column 0, where I and C are 0
+    int lastSegment = (lA-2) % numSegments; int lastLane = (lA-2) / numSegments;
+
+    for (int i = 1; i < lB; i++) {
+        const V vB = stripedSplat<V>((short)(unsigned char)seqB[i]);
+
+        V diagonalC = stripedShift(previousC[numSegments-1], 0);
+        V vF = stripedShift(stripedSplat<V>(STRIPED_NOT_FILLED), firstI);
+        for (int k = 0; k < numSegments; k++) {
+            V same = (vA[k] == vB);
+            diagonals[k] = diagonalC + stripedSelect(same, vMatch, vMismatch);
+            D[k] = stripedMax(previousD[k], previousC[k] + vGapOpen) + vGapExtend;
+            I[k] = vF;
+            C[k] = stripedMax(stripedMax(D[k], diagonals[k]), vF);
+            vF = stripedMax(vF, C[k] + vGapOpen) + vGapExtend;
+            diagonalC = previousC[k];
+        }
+
+        vF = stripedShift(vF, STRIPED_NOT_FILLED);
+        int k = 0;
+        while (stripedAny(vF > I[k])) {
+            I[k] = stripedMax(I[k], vF);
+            C[k] = stripedMax(C[k], I[k]);
+            vF = stripedMax(I[k], C[k] + vGapOpen) + vGapExtend;
+            k++;
+            if (k == numSegments) { k = 0; vF = stripedShift(vF, STRIPED_NOT_FILLED); }
+        }
+
+        unsigned char* rowDirections = directions + (long long)i * numSegments * lanes;
+        for (int k = 0; k < numSegments; k++) {
+            V useI = (I[k] > D[k]);
+            V fromI = stripedSelect((V)(I[k] > diagonals[k]), vL, vD);
+            V fromD = stripedSelect((V)(D[k] > diagonals[k]), vU, vD);
+            stripedStoreDirections(stripedSelect(useI, fromI, fromD), rowDirections + k * lanes);
+        }
+
+        lastColumn[i] = stripedLane(C[lastSegment], lastLane);
+        if (i == (lB-1)) { stripedLastRow(C, lastRow, lA, numSegments); }
+
+        V* temp = previousC; previousC = C; C = temp;
+        temp = previousD; previousD = D; D = temp;
+    }
+}
+/**************************************************************************************************/
+template<bool AFFINE, class V>
+void stripedBaseline(void* work, const string& seqB, const short* stripedA, const short* scores, unsigned char* directions, float* lastColumn, float* lastRow, int lA, int lB, int numSegments) {
+    if (AFFINE) { stripedGotohKernel<V>(work, seqB, stripedA, scores, directions, lastColumn, lastRow, lA, lB, numSegments); }
+    else        { stripedNeedlemanKernel<V>(work, seqB, stripedA, scores, directions, lastColumn, lastRow, lA, lB, numSegments); }
+}
+#ifdef STRIPED_DISPATCH
+template<bool AFFINE, class V> __attribute__((target("avx2")))
+void stripedAVX2(void* work, const string& seqB, const short* stripedA, const short* scores, unsigned char* directions, float* lastColumn, float* lastRow, int lA, int lB, int numSegments) {
+    if (AFFINE) { stripedGotohKernel<V>(work, seqB, stripedA, scores, directions, lastColumn, lastRow, lA, lB, numSegments); }
+    else        { stripedNeedlemanKernel<V>(work, seqB, stripedA, scores, directions, lastColumn, lastRow, lA, lB, numSegments); }
+}
+#endif
+
+#endif
+/**************************************************************************************************/
+StripedAlignment::StripedAlignment(bool aff, float gapOpen, float gapExtend, float match, float mismatch) : affine(aff) {
+    try {
+        m = MothurOut::getInstance();
+        kernel = NULL; kernelName = "scalar"; numLanes = 0; numSegments = 0;
+
+        if (!affine) { gapExtend = 0; }
+        float params[4] = { match, mismatch, gapOpen, gapExtend };
+
+        //the 16 bit lanes hold the same scores exactly if the parameters are small whole numbers, and gaps only lower scores
+        usable = ((gapOpen <= 0) && (gapExtend <= 0));
+        for (int i = 0; i < 4; i++) {
+            if ((abs(params[i]) > 1000) || (params[i] != (float)(int)params[i])) { usable = false; }
+            else { scores[i] = (short)params[i]; }
+        }
+
+#ifdef STRIPED_VECTORS
+        if (usable) {
+#ifdef STRIPED_DISPATCH
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                kernelName = "avx2"; numLanes = 16;
+                if (affine) { kernel = stripedAVX2<true, v16s>; } else { kernel = stripedAVX2<false, v16s>; }
+            }
+#endif
+            if (kernel == NULL) {
+                kernelName = "baseline"; numLanes = 8;
+                if (affine) { kernel = stripedBaseline<true, v8s>; } else { kernel = stripedBaseline<false, v8s>; }
+            }
+        }
+#endif
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedAlignment", "StripedAlignment");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool StripedAlignment::fill(const string& seqA, const string& seqB, vector<unsigned char>& directions, vector<float>& lastColumn, vector<float>& lastRow) {
+    try {
+        int lA = seqA.length(); int lB = seqB.length();
+        if ((kernel == NULL) || (lA < 2) || (lB < 2)) { return false; }
+
+        numSegments = (lA - 1 + numLanes - 1) / numLanes;
+
+        //every score is within the number of diagonal steps times the largest score plus a gap, including the padding
+        int largest = max(abs((int)scores[0]), abs((int)scores[1]));
+        long long maxScore = (long long)(min(lA, lB) + numSegments + 1) * largest + abs((int)scores[2]) + abs((int)scores[3]);
+        if (maxScore > STRIPED_MAX_SCORE) { return false; }
+
+        //seqA in striped order followed by the kernel's score vectors, aligned for the vector loads
+        long long vectorSize = numLanes * sizeof(short);
+        long long workSize = 7 * numSegments * vectorSize + 32;
+        if (workspace.size() < workSize) { workspace.resize(workSize); }
+        short* stripedA = (short*)(((unsigned long long)workspace.data() + 31) & ~31ULL);
+        void* work = (void*)(stripedA + numSegments * numLanes);
+        
+        //the padding at the end of the last lane never matches
+        for (int p = 0; p < numSegments * numLanes; p++) { stripedA[p] = -1; }
+        for (int j = 1; j < lA; j++) {
+            int t = j - 1;
+            stripedA[(t % numSegments) * numLanes + (t / numSegments)] = (short)(unsigned char)seqA[j];
+        }
+
+        long long numCells = (long long)lB * numSegments * numLanes;
+        if (directions.size() < numCells) { directions.resize(numCells); }
+
+        kernel(work, seqB, stripedA, scores, directions.data(), lastColumn.data(), lastRow.data(), lA, lB, numSegments);
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedAlignment", "fill");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,59 @@
+//
+//  stripedalignment.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef stripedalignment_hpp
+#define stripedalignment_hpp
+
+#include "mothurout.h"
+
+/* This class fills the dynamic programming matrix of the NeedlemanOverlap and GotohOverlap alignments several cells at
+ a time, using 16 bit vector lanes laid out the way Farrar's striped Smith-Waterman does. Lane l of vector k holds
+ column l * numSegments + k + 1 of seqA, so the cells a vector depends on from the row above are the same lanes of the
+ vectors before it, and the gaps along the row are fixed up afterwards by the lazy F loop.
+
+ The scores are the same integers the scalar loops add up in floats, and the traceback gets the same pointer for every
+ cell, with the same tie breaking, so the alignments are identical. The traceback is written one byte per cell in
+ striped order, see Alignment::getDirection. If the scores aren't whole numbers or could overflow 16 bits fill returns
+ false and the scalar loop is used.
+
+ With gcc or clang the kernel is compiled for AVX2 (16 lanes) and the baseline vector unit (8 lanes, SSE2 on x86), and
+ the fastest one the cpu supports is picked at runtime. Other builds always use the scalar loop. */
+
+typedef void (*StripedKernel)(void*, const string&, const short*, const short*, unsigned char*, float*, float*, int, int, int); //workspace, seqB, striped seqA, scores, directions, lastColumn, lastRow, lA, lB, numSegments
+
+/**************************************************************************************************/
+
+class StripedAlignment {
+
+public:
+
+    StripedAlignment(bool, float, float, float, float); //affine gaps, gapOpen, gapExtend, match, mismatch - gapExtend is ignored for linear gaps
+    ~StripedAlignment() {}
+
+    //fills directions with the traceback of seqA and seqB (both with the leading dummy space), lastColumn with the
+    //scores of the right column and lastRow with the scores of the bottom row. Returns false if it can't.
+    bool fill(const string&, const string&, vector<unsigned char>&, vector<float>&, vector<float>&);
+
+    int getNumSegments()    { return numSegments;   }
+    int getNumLanes()       { return numLanes;      }
+    string getKernelName()  { return kernelName;    }
+
+private:
+
+    MothurOut* m;
+    StripedKernel kernel;
+    string kernelName;
+    bool affine, usable;
+    short scores[4]; //match, mismatch, gapOpen, gapExtend
+    int numLanes, numSegments;
+    vector<char> workspace; //seqA in striped order and the score vectors, aligned by fill
+};
+
+/**************************************************************************************************/
+
+#endif /* stripedalignment_hpp */
@@ -0,0 +1,63 @@
+//
+//  templateprofile.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "templateprofile.hpp"
+
+/**************************************************************************************************/
+TemplateProfile::TemplateProfile(int i, Sequence& temp) : index(i), seq(temp.getName(), temp.getAligned()) {
+    string aligned = seq.getAligned();
+    for (int j = 0; j < aligned.length(); j++) {
+        if (isalpha(aligned[j])) { baseColumns.push_back(j); }
+    }
+}
+/**************************************************************************************************/
+TemplateProfileCache::TemplateProfileCache(AlignmentDB* db, int c) : templateDB(db), capacity(c) {
+    try {
+        m = MothurOut::getInstance();
+        numHits = 0; numMisses = 0;
+        if (capacity < 1) { capacity = 1; }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TemplateProfileCache", "TemplateProfileCache");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+TemplateProfileCache::~TemplateProfileCache() {
+    for (list<TemplateProfile*>::iterator it = profiles.begin(); it != profiles.end(); it++) { delete *it; }
+}
+/**************************************************************************************************/
+TemplateProfile* TemplateProfileCache::get(int index) {
+    try {
+        map<int, list<TemplateProfile*>::iterator>::iterator it = lookup.find(index);
+        
+        if (it != lookup.end()) { //move it to the front
+            numHits++;
+            profiles.splice(profiles.begin(), profiles, it->second);
+            return profiles.front();
+        }
+        
+        numMisses++;
+        if (profiles.size() >= capacity) { //drop the least recently used
+            lookup.erase(profiles.back()->index);
+            delete profiles.back();
+            profiles.pop_back();
+        }
+        
+        Sequence temp = templateDB->getTemplate(index);
+        profiles.push_front(new TemplateProfile(index, temp));
+        lookup[index] = profiles.begin();
+        
+        return profiles.front();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TemplateProfileCache", "get");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,60 @@
+//
+//  templateprofile.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef templateprofile_hpp
+#define templateprofile_hpp
+
+#include "mothur.h"
+#include "sequence.hpp"
+#include "alignmentdb.h"
+
+/* The template side of a NAST alignment, worked out once per template: the template Sequence with its unaligned bases,
+ and the alignment column of each base so Nast can step over the gap columns between two bases in one go. */
+
+/**************************************************************************************************/
+
+struct TemplateProfile {
+    int index; //in the AlignmentDB, -1 for no match
+    Sequence seq;
+    vector<int> baseColumns;
+    
+    TemplateProfile(int, Sequence&);
+};
+
+/**************************************************************************************************/
+
+/* A least recently used cache of template profiles keyed by the template's index in the AlignmentDB. Amplicon reads hit
+ the same few templates over and over, so most reads find their template already built. Each thread keeps its own cache
+ because Nast writes the pairwise alignment into the template Sequence. */
+
+class TemplateProfileCache {
+    
+public:
+    
+    TemplateProfileCache(AlignmentDB*, int); //templates, number of profiles to keep
+    ~TemplateProfileCache();
+    
+    TemplateProfile* get(int); //template index from AlignmentDB::findClosestSequenceIndex, builds the profile if needed
+    
+    long long getNumHits()      { return numHits;       }
+    long long getNumMisses()    { return numMisses;     }
+    
+private:
+    
+    MothurOut* m;
+    AlignmentDB* templateDB;
+    int capacity;
+    long long numHits, numMisses;
+    
+    list<TemplateProfile*> profiles; //most recently used first
+    map<int, list<TemplateProfile*>::iterator> lookup;
+};
+
+/**************************************************************************************************/
+
+#endif /* templateprofile_hpp */
@@ -70,9 +70,11 @@ bool BatchEngine::getInput(){
                 m->resetCommandErrors();
                 m->setChangedSeqNames(true);
                             
+                profiler->startCommand(commandName);
                 Command* command = cFactory->getCommand(commandName, options);
                 quitCommandCalled = command->execute();
                 delete command;
+                profiler->endCommand();
                             
                 //if we aborted command
                 if (quitCommandCalled == 2) {  m->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
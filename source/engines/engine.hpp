@@ -14,6 +14,7 @@
 #include "command.hpp"
 #include "commandfactory.hpp"
 #include "mothurout.h"
+#include "profiler.hpp"
 
 class Engine {
 public:
@@ -22,6 +23,7 @@ public:
             cFactory = CommandFactory::getInstance();
             m = MothurOut::getInstance();
             current = CurrentFile::getInstance();
+            profiler = Profiler::getInstance();
             
             m->resetCommandErrors();
             
@@ -138,6 +140,7 @@ protected:
 	CommandFactory* cFactory;
 	MothurOut* m;
     CurrentFile* current;
+    Profiler* profiler;
     Utils util;
     time_t start;
     int numCommandsRun;
@@ -61,9 +61,11 @@ bool InteractEngine::getInput(){
                 //executes valid command
                 m->setChangedSeqNames(true);
                 
+                profiler->startCommand(commandName);
                 Command* command = cFactory->getCommand(commandName, options);
                 quitCommandCalled = command->execute();
                 delete command;
+                profiler->endCommand();
                 
                 //if we aborted command
                 if (quitCommandCalled == 2) {  m->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
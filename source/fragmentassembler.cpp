@@ -0,0 +1,355 @@
+//
+//  fragmentassembler.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "fragmentassembler.hpp"
+
+static const int maxShift = 8;          //gaps longer than this are ruled out by the number of mismatches
+static const int minOverlap = 4*maxShift;
+static const int maxErrorScore = 128;   //larger scores are converted as they come
+
+/**************************************************************************************************/
+FragmentAssembler::FragmentAssembler(Alignment* a, string method, float ma, float mm, float gO, float gE, int ins, int dq, bool trim) {
+    try {
+        m = MothurOut::getInstance();
+        alignment = a;
+        insert = ins; deltaq = dq; trimOverlap = trim;
+        numUngapped = 0; numGapped = 0;
+
+        //needleman charges the gap open penalty for every gapped position, gotoh charges it once plus the extend penalty per position
+        float open = 0; float column = -gO;
+        if (method == "gotoh") { open = -gO; column = -gE; }
+
+        //the band is scored in whole numbers, the kmer aligner doesn't look for gaps so its overlaps are left to it
+        tracedBack = (method == "needleman") || (method == "gotoh");
+        ungapped = tracedBack && (ma == round(ma)) && (mm == round(mm)) && (open == round(open)) && (column == round(column));
+        match = round(ma); misMatch = round(mm); gapOpen = round(open); gapColumn = round(column);
+        if ((match <= misMatch) || (gapOpen < 0) || (gapColumn <= 0)) { ungapped = false; }
+
+        loadQmatchValues();
+
+        errorProbs.resize(maxErrorScore);
+        for (int i = 0; i < errorProbs.size(); i++) { errorProbs[i] = convertQToProb(i); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FragmentAssembler", "FragmentAssembler");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+/**
+ * Convert the probability to a quality score.
+ */
+double FragmentAssembler::convertProbToQ(double prob){
+    return round(-10*log10(prob));
+}
+/**************************************************************************************************/
+/**
+ * Convert the quality score to a probability.
+ */
+double FragmentAssembler::convertQToProb(double Q){
+    return pow(10,(-Q/10));
+}
+/**************************************************************************************************/
+void FragmentAssembler::loadQmatchValues(){
+    try {
+        int size = PHREDMAX+1;
+        vector<double> probs(size);
+        for(int i=0;i<probs.size();i++){ probs[i] = convertQToProb(i); }
+
+        qualMatch.assign(size*size, 0);
+        qualMismatch.assign(size*size, 0);
+
+        //qualMatch - naturally symmetric
+        //qualMismatch - force symmetry
+        for(int i=0;i<size; i++){
+            for(int j=0;j<=i;j++){
+                qualMatch[i*size+j] = convertProbToQ((probs[i]*probs[j]/3)/(1-probs[i]-probs[j]+4*probs[i]*probs[j]/3));
+                qualMismatch[i*size+j] = convertProbToQ(probs[i]*(1-probs[j]/3)/(probs[i]+probs[j]-4*probs[i]*probs[j]/3));
+
+                qualMatch[j*size+i] = qualMatch[i*size+j];
+                qualMismatch[j*size+i] = qualMismatch[i*size+j];
+            }
+            qualMismatch[i*size+i] = 2;
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FragmentAssembler", "loadQmatchValues");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+double FragmentAssembler::getExpectedErrors(const vector<int>& scores){
+    try {
+        double expected_errors = 0;
+        for(int i=0;i<scores.size();i++){
+            int score = scores[i];
+            if ((score >= 0) && (score < maxErrorScore))    { expected_errors += errorProbs[score];        }
+            else                                            { expected_errors += convertQToProb(score);   }
+        }
+        return expected_errors;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FragmentAssembler", "getExpectedErrors");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//the overlap alignment is free to start and end anywhere. Fills the cells within maxShift of the offset the way the
+//gapped aligners do, except that of two paths with the same score the one with fewer pairs on the offset wins: a cell
+//holds score * scale - pairs, with scale larger than any number of pairs. Any path other than the ungapped one pairs
+//fewer bases on the offset, so the ungapped one only comes out on top if nothing in the band scores as well.
+bool FragmentAssembler::isBestAlignment(const string& A, const string& B, int offset, int score){
+    try {
+        int lA = A.length(); int lB = B.length();
+        int width = 2*maxShift+1;
+        const long long outside = -(1LL << 60);
+        long long scale = max(lA, lB) + 1;
+        long long matchScore = match * scale; long long misMatchScore = misMatch * scale;
+        long long openPenalty = gapOpen * scale; long long columnPenalty = gapColumn * scale;
+
+        //cell i,j is at t = j - i - offset + maxShift in its row, the cell above it is at t+1 and the one to the left at t-1
+        previousCells.assign(width+1, outside); currentCells.assign(width+1, outside); //the extra cell stays outside the band
+        previousUp.assign(width+1, outside); currentUp.assign(width+1, outside);
+        long long best = outside;
+
+        for (int i = 0; i <= lB; i++) {
+            long long left = outside; long long leftCell = outside;
+            for (int t = 0; t < width; t++) {
+                int j = i + offset - maxShift + t;
+                if ((j < 0) || (j > lA)) { currentCells[t] = outside; currentUp[t] = outside; leftCell = outside; continue; }
+
+                long long cell = 0;
+                if ((i == 0) || (j == 0)) { currentUp[t] = outside; left = outside; }
+                else {
+                    cell = previousCells[t] + ((A[j-1] == B[i-1]) ? matchScore : misMatchScore);
+                    if (t == maxShift) { cell--; }
+
+                    long long up = max(previousUp[t+1], previousCells[t+1] - openPenalty) - columnPenalty;   //gap in A
+                    left = max(left, leftCell - openPenalty) - columnPenalty;                               //gap in B
+                    cell = max(cell, max(up, left));
+                    currentUp[t] = up;
+                }
+                currentCells[t] = cell; leftCell = cell;
+
+                if (((i == lB) || (j == lA)) && (cell > best)) { best = cell; }
+            }
+            previousCells.swap(currentCells); previousUp.swap(currentUp);
+        }
+
+        int overlap = min(lA, offset + lB) - max(0, offset);
+        return (best == (score * scale - overlap));
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FragmentAssembler", "isBestAlignment");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool FragmentAssembler::findUngappedOverlap(const string& A, const string& B, string& seqAaln, string& seqBaln){
+    try {
+        int lA = A.length(); int lB = B.length();
+        if ((lA == 0) || (lB == 0)) { return false; }
+
+        //B starts at A[offset], offsets run from -(lB-1) to lA-1
+        int numOffsets = lA + lB - 1;
+        matches.resize(numOffsets);
+        const char* a = A.data(); const char* b = B.data();
+
+        for (int k = 0; k < numOffsets; k++) {
+            int offset = k - (lB-1);
+            int start = max(0, offset); int end = min(lA, offset + lB);
+            const char* x = a + start; const char* y = b + start - offset;
+            int n = end - start; int count = 0;
+            for (int i = 0; i < n; i++) { count += (x[i] == y[i]); }
+            matches[k] = count;
+        }
+
+        int best = -1; int bestScore = 0; int secondScore = 0;
+        for (int k = 0; k < numOffsets; k++) {
+            int offset = k - (lB-1);
+            int n = min(lA, offset + lB) - max(0, offset);
+            int score = matches[k] * match + (n - matches[k]) * misMatch;
+            if ((best == -1) || (score > bestScore)) { secondScore = bestScore; bestScore = score; best = k; }
+            else if (score > secondScore) { secondScore = score; }
+        }
+
+        int offset = best - (lB-1);
+        int overlap = min(lA, offset + lB) - max(0, offset);
+
+        //a short or mostly mismatched overlap is as likely to have gaps, a tie between offsets is up to the traceback
+        if (overlap < minOverlap)                           { return false; }
+        if ((matches[best] * 4) < (overlap * 3))            { return false; }
+        if (bestScore <= secondScore)                       { return false; }
+
+        //the band only sees gaps of up to maxShift, if turning every mismatch into a match could pay for a longer one
+        //the traceback has to look
+        if (((overlap - matches[best]) * (match - misMatch)) >= (gapOpen + (maxShift+1) * gapColumn)) { return false; }
+        if (!isBestAlignment(A, B, offset, bestScore))      { return false; }
+
+        //the traceback writes the unpaired bases at the start and end as bases against gaps
+        int length = max(lA, offset + lB) - min(0, offset);
+        if (offset >= 0) {
+            seqAaln = A + string(length - lA, '-');
+            seqBaln = string(offset, '-') + B + string(length - offset - lB, '-');
+        }else {
+            seqAaln = string(-offset, '-') + A + string(length + offset - lA, '-');
+            seqBaln = B + string(length - lB, '-');
+        }
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FragmentAssembler", "findUngappedOverlap");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//the index of the base in each column of the aligned sequence
+void FragmentAssembler::fillBaseMap(const string& aligned, vector<int>& baseMap){
+    int count = 0;
+    for (int i = 0; i < aligned.length(); i++) {
+        if ((aligned[i] != '-') && (aligned[i] != '.')) { baseMap[i] = count; count++; }
+    }
+}
+/**************************************************************************************************/
+vector<int> FragmentAssembler::assemble(Sequence& fSeq, Sequence& rSeq, const vector<int>& scores1, const vector<int>& scores2, bool hasQuality, string& contig, string& trashCode, int& oend, int& oStart, int& numMismatches) {
+    try {
+        vector<int> contigScores;
+
+        //flip the reverse reads
+        rSeq.reverseComplement();
+
+        //pairwise align, without gaps if that's the best alignment
+        string fUnaligned = fSeq.getUnaligned(); string rUnaligned = rSeq.getUnaligned();
+        string fAligned, rAligned;
+        if (ungapped && findUngappedOverlap(fUnaligned, rUnaligned, fAligned, rAligned)) { numUngapped++; }
+        else {
+            alignment->align(fUnaligned, rUnaligned, !tracedBack);
+            fAligned = alignment->getSeqAAln(); rAligned = alignment->getSeqBAln();
+            numGapped++;
+        }
+        fSeq.setAligned(fAligned);
+        rSeq.setAligned(rAligned);
+        int length = fSeq.getAligned().length();
+
+        //traverse alignments merging into one contiguous seq
+        string seq1 = fSeq.getAligned();
+        string seq2 = rSeq.getAligned();
+
+        vector<int> ABaseMap(max(seq1.length(), seq2.length()), 0);
+        vector<int> BBaseMap(ABaseMap.size(), 0);
+        if (tracedBack) { fillBaseMap(seq1, ABaseMap); fillBaseMap(seq2, BBaseMap); }
+        else { //the kmer aligner's maps
+            map<int, int> AMap = alignment->getSeqAAlnBaseMap(); map<int, int> BMap = alignment->getSeqBAlnBaseMap();
+            for (map<int, int>::iterator it = AMap.begin(); it != AMap.end(); it++) { if (it->first < ABaseMap.size()) { ABaseMap[it->first] = it->second; } }
+            for (map<int, int>::iterator it = BMap.begin(); it != BMap.end(); it++) { if (it->first < BBaseMap.size()) { BBaseMap[it->first] = it->second; } }
+        }
+
+        int overlapStart = fSeq.getStartPos()-1;
+        int seq2Start = rSeq.getStartPos()-1;
+
+        //bigger of the 2 starting positions is the location of the overlapping start
+        if (overlapStart < seq2Start) { //seq2 starts later so take from 0 to seq2Start from seq1
+            overlapStart = seq2Start;
+            for (int i = 0; i < overlapStart; i++) { contig += seq1[i];  if (hasQuality) { if (((seq1[i] != '-') && (seq1[i] != '.'))) { contigScores.push_back(scores1[ABaseMap[i]]); } } }
+        }else { //seq1 starts later so take from 0 to overlapStart from seq2
+            for (int i = 0; i < overlapStart; i++) {  contig += seq2[i]; if (hasQuality) { if (((seq2[i] != '-') && (seq2[i] != '.'))) {  contigScores.push_back(scores2[BBaseMap[i]]); }  } }
+        }
+
+        int seq1End = fSeq.getEndPos();
+        int seq2End = rSeq.getEndPos();
+        int overlapEnd = seq1End;
+        if (seq2End < overlapEnd) { overlapEnd = seq2End; }  //smallest end position is where overlapping ends
+
+        oStart = contig.length();
+
+        int firstForward = 0; int seq2FirstForward = 0; int lastReverse = seq1.length(); int seq2lastReverse = seq2.length(); bool firstChooseSeq1 = false; bool lastChooseSeq1 = false;
+        if (hasQuality) {
+            for (int i = 0; i < seq1.length(); i++) { if ((seq1[i] != '.') && (seq1[i] != '-')) { if (scores1[ABaseMap[i]] == 2) { firstForward++; }else { break; } } }
+            for (int i = 0; i < seq2.length(); i++) { if ((seq2[i] != '.') && (seq2[i] != '-')) { if (scores2[BBaseMap[i]] == 2) { seq2FirstForward++; }else { break; } } }
+            if (seq2FirstForward > firstForward) { firstForward = seq2FirstForward; firstChooseSeq1 = true; }
+            for (int i = seq1.length()-1; i >= 0; i--) { if ((seq1[i] != '.') && (seq1[i] != '-')) { if (scores1[ABaseMap[i]] == 2) { lastReverse--; }else { break; } } }
+            for (int i = seq2.length()-1; i >= 0; i--) { if ((seq2[i] != '.') && (seq2[i] != '-')) { if (scores2[BBaseMap[i]] == 2) { seq2lastReverse--; }else { break; } } }
+            if (lastReverse > seq2lastReverse) { lastReverse = seq2lastReverse; lastChooseSeq1 = true; }
+        }
+
+        const int size = PHREDMAX+1;
+        for (int i = overlapStart; i < overlapEnd; i++) {
+            if (seq1[i] == seq2[i]) {
+                contig += seq1[i];
+                if (hasQuality) {
+                    contigScores.push_back(qualMatch[PHREDCLAMP(scores1[ABaseMap[i]])*size + PHREDCLAMP(scores2[BBaseMap[i]])]);
+                }
+            }else if (((seq1[i] == '.') || (seq1[i] == '-')) && ((seq2[i] != '-') && (seq2[i] != '.'))) { //seq1 is a gap and seq2 is a base, choose seq2, unless quality score for base is below insert. In that case eliminate base
+                if (hasQuality) {
+                    if (scores2[BBaseMap[i]] <= insert) { } //
+                    else {
+                        contig += seq2[i];
+                        contigScores.push_back(scores2[BBaseMap[i]]);
+                    }
+                } else {  contig += seq2[i]; } //with no quality info, then we keep it?
+            }else if (((seq2[i] == '.') || (seq2[i] == '-')) && ((seq1[i] != '-') && (seq1[i] != '.'))) { //seq2 is a gap and seq1 is a base, choose seq1, unless quality score for base is below insert. In that case eliminate base
+                if (hasQuality) {
+                    if (scores1[ABaseMap[i]] <= insert) { } //eliminate base
+                    else {
+                        contig += seq1[i];
+                        contigScores.push_back(scores1[ABaseMap[i]]);
+                    }
+                }else { contig += seq1[i]; } //with no quality info, then we keep it?
+            }else if (((seq1[i] != '-') && (seq1[i] != '.')) && ((seq2[i] != '-') && (seq2[i] != '.'))) { //both bases choose one with better quality
+                if (hasQuality) {
+                    if (abs(scores1[ABaseMap[i]] - scores2[BBaseMap[i]]) >= deltaq) { //is the difference in qual scores >= deltaq, if yes choose base with higher score
+                        char c = seq1[i];
+                        if (scores1[ABaseMap[i]] < scores2[BBaseMap[i]]) { c = seq2[i]; }
+                        contig += c;
+                        if ((i >= firstForward) && (i <= lastReverse)) { //in unmasked section
+                            contigScores.push_back(qualMismatch[PHREDCLAMP(scores1[ABaseMap[i]])*size + PHREDCLAMP(scores2[BBaseMap[i]])]);
+                        }else if (i < firstForward) {
+                            if (firstChooseSeq1) { contigScores.push_back(scores1[ABaseMap[i]]); }
+                            else { contigScores.push_back(scores2[BBaseMap[i]]); }
+                        }else if ((i > lastReverse)) {
+                            if (lastChooseSeq1) { contigScores.push_back(scores1[ABaseMap[i]]);   }
+                            else { contigScores.push_back(scores2[BBaseMap[i]]); }
+                        }else { contigScores.push_back(2); } //N
+                    }else { //if no, base becomes n
+                        contig += 'N'; contigScores.push_back(2);
+                    }
+                    numMismatches++;
+                }else { numMismatches++; } //cant decide, so eliminate and mark as mismatch
+            }else { //should never get here
+                m->mothurOut("[ERROR]: case I didn't think of seq1 = " + toString(seq1[i]) + " and seq2 = " + toString(seq2[i]) + "\n");
+            }
+        }
+        oend = contig.length();
+        if (seq1End < seq2End) { //seq1 ends before seq2 so take from overlap to length from seq2
+            for (int i = overlapEnd; i < length; i++) { contig += seq2[i];  if (hasQuality) { if (((seq2[i] != '-') && (seq2[i] != '.'))) {  contigScores.push_back(scores2[BBaseMap[i]]); } }
+            }
+        }else { //seq2 ends before seq1 so take from overlap to length from seq1
+            for (int i = overlapEnd; i < length; i++) {  contig += seq1[i];  if (hasQuality) { if (((seq1[i] != '-') && (seq1[i] != '.'))) { contigScores.push_back(scores1[ABaseMap[i]]); } }
+            }
+        }
+
+        if (trimOverlap) {
+            contig = contig.substr(overlapStart, oend-oStart);
+            if (hasQuality) {
+                vector<int> newContigScores;
+                for (int i = overlapStart; i < oend; i++)  { newContigScores.push_back(contigScores[i]);  }
+                contigScores = newContigScores;
+            }
+        }
+
+        if (contig == "") { trashCode += "l"; contig = "NNNN"; contigScores.push_back(2); contigScores.push_back(2); contigScores.push_back(2); contigScores.push_back(2); }
+
+        return contigScores;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FragmentAssembler", "assemble");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,77 @@
+//
+//  fragmentassembler.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef fragmentassembler_hpp
+#define fragmentassembler_hpp
+
+#include "mothurout.h"
+#include "sequence.hpp"
+#include "alignment.hpp"
+
+#        define PHREDMAX 46
+#        define PHREDCLAMP(x) ((x) > PHREDMAX ? PHREDMAX : ((x) < 0 ? 0 : (x)))
+
+/* Merges a forward read and a reverse read into a contig for make.contigs.
+
+ Most pairs overlap without an indel, so the overlap is first found by scoring every offset of the reads without gaps,
+ which the compiler vectorizes. The best offset is kept if it beats every other offset and nothing in a band of maxShift
+ cells around it in the gapped aligner's matrix scores as well, which takes a fraction of the cells of the whole matrix.
+ Otherwise the reads are aligned with the gapped aligner make.contigs was given, as before. The ungapped result is
+ written the way the needleman and gotoh tracebacks write it, so the contig doesn't depend on which one ran.
+
+ The posterior quality tables of Edgar & Flyvbjerg (2015) are built once as flat arrays indexed by the clamped scores,
+ and the expected errors are summed from a table of the error probabilities of the scores. */
+
+/**************************************************************************************************/
+
+class FragmentAssembler {
+
+public:
+
+    //gapped aligner (not owned), align method, match, mismatch, gap open, gap extend, insert, deltaq, trimOverlap
+    FragmentAssembler(Alignment*, string, float, float, float, float, int, int, bool);
+    ~FragmentAssembler() {}
+
+    //reverse complements the reverse read, aligns the pair and merges it, returns the contig's scores if hasQuality
+    vector<int> assemble(Sequence&, Sequence&, const vector<int>&, const vector<int>&, bool, string&, string&, int&, int&, int&); //fSeq, rSeq, scores1, scores2, hasQuality, contig, trashCode, oend, oStart, numMismatches
+
+    //fills the aligned forward and reverse reads if the best ungapped overlap is also the best alignment
+    bool findUngappedOverlap(const string&, const string&, string&, string&);
+
+    double getExpectedErrors(const vector<int>&);
+
+    long long getNumUngapped()  { return numUngapped;   }
+    long long getNumGapped()    { return numGapped;     }
+
+    static double convertProbToQ(double);
+    static double convertQToProb(double);
+
+private:
+
+    MothurOut* m;
+    Alignment* alignment;
+    bool ungapped, tracedBack;
+    int match, misMatch, gapOpen, gapColumn; //gapOpen and gapColumn are the penalties, a gap of n columns costs gapOpen + n*gapColumn
+    int insert, deltaq;
+    bool trimOverlap;
+    long long numUngapped, numGapped;
+
+    vector<int> qualMatch, qualMismatch; //(PHREDMAX+1) x (PHREDMAX+1)
+    vector<double> errorProbs;           //indexed by quality score
+
+    vector<int> matches; //per offset
+    vector<long long> previousCells, currentCells, previousUp, currentUp;
+
+    void loadQmatchValues();
+    bool isBestAlignment(const string&, const string&, int, int); //A, B, offset, ungapped score
+    void fillBaseMap(const string&, vector<int>&);
+};
+
+/**************************************************************************************************/
+
+#endif /* fragmentassembler_hpp */
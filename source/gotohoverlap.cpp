@@ -29,18 +29,8 @@ GotohOverlap::GotohOverlap(float gO, float gE, float f, float mm, int r) :
 	gapOpen(gO), gapExtend(gE), match(f), mismatch(mm), Alignment(r) {
 	
 	try {
-		for(int i=1;i<nCols;i++){				//	we initialize the dynamic programming matrix by setting the pointers in
-			alignment[0][i].prevCell = 'l';		//	the first row to the left
-			alignment[0][i].cValue = 0;
-			alignment[0][i].dValue = 0;
-		}
-		
-		for(int i=1;i<nRows;i++){				//	we initialize the dynamic programming matrix by setting the pointers in
-			alignment[i][0].prevCell = 'u';		//	the first column upward
-			alignment[i][0].cValue = 0;
-			alignment[i][0].iValue = 0;
-		}
-		
+		//	the first row points left and the first column points up with scores of zero, see Alignment::getDirection
+		striped = new StripedAlignment(true, gapOpen, gapExtend, match, mismatch);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "GotohOverlap", "GotohOverlap");
@@ -55,41 +45,63 @@ void GotohOverlap::align(string A, string B, bool createBaseMap){
 		seqA = ' ' + A;	lA = seqA.length();		//	the algorithm requires that the first character be a dummy value
 		seqB = ' ' + B;	lB = seqB.length();		//	the algorithm requires that the first character be a dummy value
 		
-		for(int i=1;i<lB;i++){					//	the recursion here is shown in Webb and Miller, Fig. 1A.  Note that 
-			for(int j=1;j<lA;j++){				//	if we need to conserve on space we should see Fig. 1B, which is linear
-				//	in space, which I think is unnecessary
-				float diagonal;
-				if(seqB[i] == seqA[j])	{	diagonal = alignment[i-1][j-1].cValue + match;		}
-				else					{	diagonal = alignment[i-1][j-1].cValue + mismatch;	}
+		setBand();								//	band around the diagonal sharing the most kmers, if bandWidth is set
+		
+		if (!fillStriped()) {						//	several cells at a time if the scores fit, see StripedAlignment
+			previousD.assign(lA, 0);
+			if (currentD.size() < lA) { currentD.resize(lA); }
+		
+			for(int i=1;i<lB;i++){					//	the recursion here is shown in Webb and Miller, Fig. 1A.  Note that 
+				int first, last; getRowRange(i, first, last);
+				long long rowStart = getRowStart(i);
+				currentRow[0] = 0;
+				float iValue = 0;					//	the gap in seqB score of the cell to the left
+			
+				for(int j=first;j<=last;j++){		//	if we need to conserve on space we should see Fig. 1B, which is linear
+					//	in space, which I think is unnecessary
+					float diagonal;
+					if(seqB[i] == seqA[j])	{	diagonal = previousRow[j-1] + match;		}
+					else					{	diagonal = previousRow[j-1] + mismatch;	}
 				
-				alignment[i][j].iValue = max(alignment[i][j-1].iValue, alignment[i][j-1].cValue + gapOpen) + gapExtend;
-				alignment[i][j].dValue = max(alignment[i-1][j].dValue, alignment[i-1][j].cValue + gapOpen) + gapExtend;
+					if (banded && (j > 1) && (j == (i + bandDiagonal - bandWidth)))	{	iValue = OUTSIDE_BAND;	}	//	the cell to the left wasn't filled
+					else															{	iValue = max(iValue, currentRow[j-1] + gapOpen) + gapExtend;	}
 				
-				if(alignment[i][j].iValue > alignment[i][j].dValue){
-					if(alignment[i][j].iValue > diagonal){
-						alignment[i][j].cValue = alignment[i][j].iValue;
-						alignment[i][j].prevCell = 'l';
-					}
-					else{
-						alignment[i][j].cValue = diagonal;
-						alignment[i][j].prevCell = 'd';
-					}
-				}
-				else{
-					if(alignment[i][j].dValue > diagonal){
-						alignment[i][j].cValue = alignment[i][j].dValue;
-						alignment[i][j].prevCell = 'u';
+					float dValue;
+					if (banded && (i > 1) && (j == (i + bandDiagonal + bandWidth)))	{	dValue = OUTSIDE_BAND;	}	//	the cell above wasn't filled
+					else															{	dValue = max(previousD[j], previousRow[j] + gapOpen) + gapExtend;	}
+					currentD[j] = dValue;
+				
+					if(iValue > dValue){
+						if(iValue > diagonal){
+							currentRow[j] = iValue;
+							directions[rowStart+j] = 'l';
+						}
+						else{
+							currentRow[j] = diagonal;
+							directions[rowStart+j] = 'd';
+						}
 					}
 					else{
-						alignment[i][j].cValue = diagonal;
-						alignment[i][j].prevCell = 'd';
+						if(dValue > diagonal){
+							currentRow[j] = dValue;
+							directions[rowStart+j] = 'u';
+						}
+						else{
+							currentRow[j] = diagonal;
+							directions[rowStart+j] = 'd';
+						}
 					}
-				}
 				
+				}
+			
+				if (last == (lA-1)) { lastColumn[i] = currentRow[lA-1]; }
+				if (i == (lB-1))	{ for(int j=first;j<=last;j++){ lastRow[j] = currentRow[j]; } }
+				previousRow.swap(currentRow);
+				previousD.swap(currentD);
 			}
 		}
 		Overlap over;
-		over.setOverlap(alignment, lA, lB, 0);	//	Fix the gaps at the ends of the sequences
+		over.setOverlap(lastColumn, lastRow, lA, lB, endRow, endColumn);	//	Fix the gaps at the ends of the sequences
 		traceBack(createBaseMap);							//	Construct the alignment and set seqAaln and seqBaln
 		
 	}
@@ -38,6 +38,7 @@ private:
 	float gapExtend;
 	float match;
 	float mismatch;
+	vector<float> previousD, currentD; //scores ending in a gap in seqA, the scores ending in a gap in seqB are kept for the cell to the left
 };
 
 /**************************************************************************************************/
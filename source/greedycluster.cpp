@@ -0,0 +1,145 @@
+//
+//  greedycluster.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "greedycluster.hpp"
+#include "kmer.hpp"
+
+/***********************************************************************/
+GreedyCluster::GreedyCluster(string meth, double c) : method(meth), cutoff(c) {
+    try {
+        m = MothurOut::getInstance();
+
+        //vsearch settings mothur used
+        kmerSize = 8; maxAccepts = 16; maxRejects = 64; minWordMatches = 12;
+
+        centroidDB = new KmerDB("", kmerSize);
+        alignment = new NeedlemanOverlap(-2.0, 1.0, -1.0, 500); //pairwise.seqs defaults - gapopen, match, mismatch
+        distCalc = new eachGapIgnoreTermGapDist(cutoff);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "GreedyCluster", "GreedyCluster");
+        exit(1);
+    }
+}
+/***********************************************************************/
+GreedyCluster::~GreedyCluster() { delete centroidDB; delete alignment; delete distCalc; }
+/***********************************************************************/
+int GreedyCluster::cluster(vector<seqPriorityNode>& seqs, vector<int>& bins) {
+    try {
+        bins.assign(seqs.size(), -1);
+
+        for (int i = 0; i < seqs.size(); i++) {
+
+            if (m->getControl_pressed()) { break; }
+
+            int bin = findBin(seqs[i].seq);
+
+            if (bin == -1) { //new centroid
+                bin = centroids.size();
+                centroids.push_back(seqs[i].seq);
+                centroidAbundance.push_back(seqs[i].numIdentical);
+
+                centroidDB->addSequence(Sequence(seqs[i].name, seqs[i].seq));
+                centroidDB->setNumSeqs(centroids.size());
+            }
+
+            bins[i] = bin;
+        }
+
+        return centroids.size();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "GreedyCluster", "cluster");
+        exit(1);
+    }
+}
+/***********************************************************************/
+int GreedyCluster::findBin(string seq) {
+    try {
+        Sequence query("query", seq);
+
+        int numKmers = query.getNumBases() - kmerSize + 1;
+        if ((centroids.size() == 0) || (numKmers < 1)) { return -1; }
+
+        //the number of different kmers in the query
+        Kmer kmer(kmerSize);
+        vector<bool> seen(centroidDB->getMaxKmer()+1, false);
+        int numUnique = 0;
+        for (int i = 0; i < numKmers; i++) {
+            int kmerNumber = kmer.getKmerNumber(query.getUnaligned(), i);
+            if (!seen[kmerNumber]) { seen[kmerNumber] = true; numUnique++; }
+        }
+
+        int minShared = minWordMatches;
+        if (numUnique < minShared) { minShared = numUnique; }
+
+        int numCandidates = maxAccepts + maxRejects;
+        if (numCandidates > centroids.size()) { numCandidates = centroids.size(); }
+
+        for (int strand = 0; strand < 2; strand++) { //only look at the reverse strand if nothing on the forward strand is close
+
+            if (strand == 1) { query.reverseComplement(); }
+            string unaligned = query.getUnaligned();
+
+            vector<float> scores;
+            vector<int> candidates = centroidDB->findClosestSequences(&query, numCandidates, scores);
+
+            int bestBin = -1; double bestDist = 1.0;
+            int numAccepted = 0; int numRejected = 0;
+
+            for (int i = 0; i < candidates.size(); i++) {
+
+                if (m->getControl_pressed()) { return -1; }
+
+                //candidates are sorted by shared kmers, the rest share too few to be worth aligning
+                float score = scores[0];
+                if (candidates.size() != 1) { score = scores[i+1]; }
+                int shared = (int)(score * numKmers / 100.0 + 0.5);
+                if (shared < minShared) { break; }
+
+                //terminal gaps are ignored, so a short overlap can be within the cutoff whatever the number of shared
+                //kmers. Every candidate sharing at least minShared kmers is aligned
+                int c = candidates[i];
+
+                int longest = max(unaligned.length(), centroids[c].length());
+                if (longest >= alignment->getnRows()) { alignment->resize(longest+1); }
+
+                alignment->align(unaligned, centroids[c]);
+                Sequence seqA("query", alignment->getSeqAAln());
+                Sequence seqB("centroid", alignment->getSeqBAln());
+                double dist = distCalc->calcDist(seqA, seqB);
+
+                if (dist <= cutoff) {
+                    bool better = false;
+                    if (bestBin == -1) { better = true; }
+                    else if (method == "agc") { //most abundant centroid, then closest
+                        if (centroidAbundance[c] > centroidAbundance[bestBin]) { better = true; }
+                        else if ((centroidAbundance[c] == centroidAbundance[bestBin]) && (dist < bestDist)) { better = true; }
+                    }else if (dist < bestDist) { better = true; }
+
+                    if (better) { bestBin = c; bestDist = dist; }
+
+                    numAccepted++;
+                    if (numAccepted >= maxAccepts) { break; }
+                }else {
+                    numRejected++;
+                    if (numRejected >= maxRejects) { break; }
+                }
+            }
+
+            if (bestBin != -1) { return bestBin; }
+        }
+
+        return -1;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "GreedyCluster", "findBin");
+        exit(1);
+    }
+}
+/***********************************************************************/
@@ -0,0 +1,59 @@
+//
+//  greedycluster.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef greedycluster_hpp
+#define greedycluster_hpp
+
+#include "mothur.h"
+#include "kmerdb.hpp"
+#include "needlemanoverlap.hpp"
+#include "eachgapignore.h"
+
+/* This class does abundance based (agc) and distance based (dgc) greedy clustering the way vsearch's cluster_smallmem
+ does with the options mothur used to run it with (--usersort --maxaccepts 16 --maxrejects 64 --wordlength 8
+ --strand both, --sizeorder for agc), without writing the sequences out and starting vsearch.
+
+ The sequences are processed most abundant first. The centroids found so far are kept in a kmer database and each
+ sequence is aligned to the centroids it shares the most kmers with, stopping after 16 centroids within the cutoff or
+ 64 that are not. Distances are found with the needleman overlap alignment and the eachgap distance ignoring terminal
+ gaps, the same distance vsearch's default identity uses. agc puts the sequence in the most abundant centroid within
+ the cutoff and dgc in the closest. If no centroid is within the cutoff on either strand the sequence becomes a new
+ centroid. */
+
+/**************************************************************************************************/
+
+class GreedyCluster {
+
+public:
+
+    GreedyCluster(string, double); //method - agc or dgc, cutoff
+    ~GreedyCluster();
+
+    //seqs must be unaligned and sorted most abundant first. Fills bins with the bin of each seq, numbered in the order
+    //the centroids were found. Returns the number of bins.
+    int cluster(vector<seqPriorityNode>&, vector<int>&);
+
+private:
+
+    MothurOut* m;
+    string method;
+    double cutoff;
+    int kmerSize, maxAccepts, maxRejects, minWordMatches;
+
+    KmerDB* centroidDB;
+    NeedlemanOverlap* alignment;
+    eachGapIgnoreTermGapDist* distCalc;
+    vector<string> centroids;       //unaligned centroid seqs, in bin order
+    vector<int> centroidAbundance;
+
+    int findBin(string); //returns the bin the seq belongs in, or -1 if it should be a new centroid
+};
+
+/**************************************************************************************************/
+
+#endif /* greedycluster_hpp */
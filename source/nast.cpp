@@ -21,10 +21,11 @@
 
 /**************************************************************************************************/
 
-Nast::Nast(Alignment* method, Sequence* cand, Sequence* temp) : alignment(method), candidateSeq(cand), templateSeq(temp) {
+Nast::Nast(Alignment* method, Sequence* cand, Sequence* temp, const vector<int>* columns) : alignment(method), candidateSeq(cand), templateSeq(temp), baseColumns(columns) {
 	try {
 		m = MothurOut::getInstance();
 		maxInsertLength = 0;
+		nextBase = 0;
 	
 		pairwiseAlignSeqs();	//	This is part A in Fig. 2 of DeSantis et al.
 		regapSequences();		//	This is parts B-F in Fig. 2 of DeSantis et al.
@@ -213,6 +214,17 @@ void Nast::removeExtraGaps(string& candAln, string tempAln, string newTemplateAl
 	}	
 }
 
+/**************************************************************************************************/
+//	the column after a run of template alignment gaps starting at column, that is the column of the template's next base
+int Nast::getGapRunEnd(int column){
+	
+	int numBases = baseColumns->size();
+	while(nextBase < numBases && (*baseColumns)[nextBase] < column)	{	nextBase++;	}	//	columns only move right
+	
+	if(nextBase < numBases)	{	return (*baseColumns)[nextBase];	}
+	return column + 1;
+}
+
 /**************************************************************************************************/
 
 void Nast::regapSequences(){	//This is essentially part B in Fig 2. of DeSantis et al.
@@ -232,10 +244,16 @@ void Nast::regapSequences(){	//This is essentially part B in Fig 2. of DeSantis
 			return;
 		}
 	
+		if(baseColumns == NULL){
+			for(int i=0;i<fullAlignLength;i++)	{	if(isalpha(tempAln[i])) {	templateColumns.push_back(i);	}	}
+			baseColumns = &templateColumns;
+		}
+		candAln.reserve(fullAlignLength);
+	
 		int fullAlignIndex = 0;
 		int pairwiseAlignIndex = 0;
 		string newTemplateAlign = "";					//	this is going to be messy so we want a temporary template
-		//	alignment string
+		newTemplateAlign.reserve(fullAlignLength);		//	alignment string
 		while(tempAln[fullAlignIndex] == '.' || tempAln[fullAlignIndex]  == '-'){
 			candAln += '.';								//	add the initial '-' and '.' to the candidate and template
 			newTemplateAlign += tempAln[fullAlignIndex];//	pairwise sequences
@@ -259,11 +277,12 @@ void Nast::regapSequences(){	//This is essentially part B in Fig 2. of DeSantis
 			else if(isalpha(tempPair[pairwiseAlignIndex]) && !isalpha(tempAln[fullAlignIndex])
 					&& isalpha(candPair[pairwiseAlignIndex])){
 				//	the template pairwise and candidate pairwise are characters and the template aligned is a gap
-				//	need to insert gaps into the candidateSeq.aligned sequence
+				//	need to insert gaps into the candidateSeq.aligned sequence, up to the template's next base
 				
-				candAln += '-';
-				newTemplateAlign += '-';//
-				fullAlignIndex++;
+				int runEnd = getGapRunEnd(fullAlignIndex);
+				candAln.append(runEnd-fullAlignIndex, '-');
+				newTemplateAlign.append(runEnd-fullAlignIndex, '-');//
+				fullAlignIndex = runEnd;
 			}
 			else if(!isalpha(tempPair[pairwiseAlignIndex]) && isalpha(tempAln[fullAlignIndex])
 					&& isalpha(candPair[pairwiseAlignIndex])){
@@ -300,9 +319,9 @@ void Nast::regapSequences(){	//This is essentially part B in Fig 2. of DeSantis
 				//	template pairwise has a character, but its full aligned sequence and candidate sequence have gaps
 				//	this would happen like we need to add a gap.  basically the opposite of the alpha situation
 				
-				newTemplateAlign += tempAln[fullAlignIndex];//
-				candAln += "-";
-				fullAlignIndex++;			
+				int runEnd = getGapRunEnd(fullAlignIndex);
+				candAln.append(runEnd-fullAlignIndex, '-');
+				for(;fullAlignIndex<runEnd;fullAlignIndex++)	{	newTemplateAlign += tempAln[fullAlignIndex];	}//			
 			}
 			else if(!isalpha(tempPair[pairwiseAlignIndex]) && isalpha(tempAln[fullAlignIndex])
 					&& !isalpha(candPair[pairwiseAlignIndex])){
@@ -14,7 +14,8 @@
  *		sequence alignment server for comparative analysis of 16S rRNA genes.  Nucleic Acids Research.  34:W394-9.
  *
  *	To construct an object one needs to provide a method of getting a pairwise alignment (alignment) and the template
- *	and candidate sequence that are to be aligned to each other.
+ *	and candidate sequence that are to be aligned to each other. The alignment columns of the template's bases can be
+ *	passed in when they are already known, see TemplateProfile.
  *
  */
 
@@ -29,7 +30,7 @@ class Sequence;
 class Nast {
 	
 public:
-	Nast(Alignment*, Sequence*, Sequence*);
+	Nast(Alignment*, Sequence*, Sequence*, const vector<int>* columns=NULL); //method, candidate, template, template base columns
 	~Nast(){};
 	float getSimilarityScore();
 	int getMaxInsertLength();
@@ -38,10 +39,14 @@ private:
 	void pairwiseAlignSeqs();
 	void regapSequences();
 	void removeExtraGaps(string&, string, string);
+	int getGapRunEnd(int);
 	
 	Alignment* alignment;
 	Sequence* candidateSeq;
 	Sequence* templateSeq;
+	const vector<int>* baseColumns;	//	the template alignment column of each template base
+	vector<int> templateColumns;	//	filled by regapSequences if they weren't passed in
+	int nextBase;
 	
 	int maxInsertLength;
 	MothurOut* m;
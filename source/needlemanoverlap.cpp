@@ -27,16 +27,8 @@
 NeedlemanOverlap::NeedlemanOverlap(float gO, float f, float mm, int r) ://	note that we don't have a gap extend
 gap(gO), match(f), mismatch(mm), Alignment(r) {							//	the gap openning penalty is assessed for
 	try {																	//	every gapped position
-		for(int i=1;i<nCols;i++){
-			alignment[0][i].prevCell = 'l';					//	initialize first row by pointing all poiters to the left
-			alignment[0][i].cValue = 0;						//	and the score to zero
-		}
-		
-		for(int i=1;i<nRows;i++){
-			alignment[i][0].prevCell = 'u';					//	initialize first column by pointing all poiters upwards
-			alignment[i][0].cValue = 0;						//	and the score to zero
-		}
-	
+		//	the first row points left and the first column points up with scores of zero, see Alignment::getDirection
+		striped = new StripedAlignment(false, gap, 0, match, mismatch);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "NeedlemanOverlap", "NeedlemanOverlap");
@@ -57,43 +49,59 @@ void NeedlemanOverlap::align(string A, string B, bool createBaseMap){
 
 		if (lA > nRows) { m->mothurOut("One of your candidate sequences is longer than you longest template sequence. Your longest template sequence is " + toString(nRows) + ". Your candidate is " + toString(lA) + ".\n");   }
 		
-		for(int i=1;i<lB;i++){					//	This code was largely translated from Perl code provided in Ex 3.1 
+		setBand();								//	band around the diagonal sharing the most kmers, if bandWidth is set
+		
+		if (!fillStriped()) {						//	several cells at a time if the scores fit, see StripedAlignment
+			for(int i=1;i<lB;i++){					//	This code was largely translated from Perl code provided in Ex 3.1 
 		
-			for(int j=1;j<lA;j++){				//	of the O'Reilly BLAST book.  I found that the example output had a
+				int first, last; getRowRange(i, first, last);
+				long long rowStart = getRowStart(i);
+				currentRow[0] = 0;
+			
+				for(int j=first;j<=last;j++){		//	of the O'Reilly BLAST book.  I found that the example output had a
 	
-				//	number of errors
-				float diagonal;
-				if(seqB[i] == seqA[j])	{	diagonal = alignment[i-1][j-1].cValue + match;		}
-				else					{	diagonal = alignment[i-1][j-1].cValue + mismatch;	}
+					//	number of errors
+					float diagonal;
+					if(seqB[i] == seqA[j])	{	diagonal = previousRow[j-1] + match;		}
+					else					{	diagonal = previousRow[j-1] + mismatch;	}
 			
-				float up	= alignment[i-1][j].cValue + gap;
-				float left	= alignment[i][j-1].cValue + gap;
-				
-				if(diagonal >= up){
-					if(diagonal >= left){
-						alignment[i][j].cValue = diagonal;
-						alignment[i][j].prevCell = 'd';
+					float up	= previousRow[j] + gap;
+					float left	= currentRow[j-1] + gap;
+					if (banded) {						//	the cells above the band's right edge and left of its left edge
+						if ((i > 1) && (j == (i + bandDiagonal + bandWidth)))	{	up = OUTSIDE_BAND;		}	//	weren't filled
+						if ((j > 1) && (j == (i + bandDiagonal - bandWidth)))	{	left = OUTSIDE_BAND;	}
 					}
-					else{
-						alignment[i][j].cValue = left;
-						alignment[i][j].prevCell = 'l';
-					}
-				}
-				else{
-					if(up >= left){
-						alignment[i][j].cValue = up;
-						alignment[i][j].prevCell = 'u';
+				
+					if(diagonal >= up){
+						if(diagonal >= left){
+							currentRow[j] = diagonal;
+							directions[rowStart+j] = 'd';
+						}
+						else{
+							currentRow[j] = left;
+							directions[rowStart+j] = 'l';
+						}
 					}
 					else{
-						alignment[i][j].cValue = left;
-						alignment[i][j].prevCell = 'l';
+						if(up >= left){
+							currentRow[j] = up;
+							directions[rowStart+j] = 'u';
+						}
+						else{
+							currentRow[j] = left;
+							directions[rowStart+j] = 'l';
+						}
 					}
 				}
+			
+				if (last == (lA-1)) { lastColumn[i] = currentRow[lA-1]; }
+				if (i == (lB-1))	{ for(int j=first;j<=last;j++){ lastRow[j] = currentRow[j]; } }
+				previousRow.swap(currentRow);
 			}
 		}
-
+		
 		Overlap over;						
-		over.setOverlap(alignment, lA, lB, 0);		//	Fix gaps at the beginning and end of the sequences
+		over.setOverlap(lastColumn, lastRow, lA, lB, endRow, endColumn);		//	Fix gaps at the beginning and end of the sequences
 		traceBack(createBaseMap);								//	Traceback the alignment to populate seqAaln and seqBaln
 	
 	}
@@ -113,43 +121,57 @@ void NeedlemanOverlap::alignPrimer(string A, string B){
         
 		if (lA > nRows) { m->mothurOut("One of your candidate sequences is longer than you longest template sequence. Your longest template sequence is " + toString(nRows) + ". Your candidate is " + toString(lA) + ".\n");   }
 		
-		for(int i=1;i<lB;i++){					//	This code was largely translated from Perl code provided in Ex 3.1
-            
-			for(int j=1;j<lA;j++){				//	of the O'Reilly BLAST book.  I found that the example output had a
-                
+		int width = bandWidth; bandWidth = 0; setBand(); bandWidth = width; //	primers are short, fill the whole matrix
+		
+		for(int i=1;i<lB;i++){					//	This code was largely translated from Perl code provided in Ex 3.1 
+		
+			int first, last; getRowRange(i, first, last);
+			long long rowStart = getRowStart(i);
+			currentRow[0] = 0;
+			
+			for(int j=first;j<=last;j++){		//	of the O'Reilly BLAST book.  I found that the example output had a
+	
 				//	number of errors
 				float diagonal;
-				if(isEquivalent(seqB[i],seqA[j]))	{	diagonal = alignment[i-1][j-1].cValue + match;		}
-				else                                {	diagonal = alignment[i-1][j-1].cValue + mismatch;	}
-                
-				float up	= alignment[i-1][j].cValue + gap;
-				float left	= alignment[i][j-1].cValue + gap;
+				if(isEquivalent(seqB[i],seqA[j]))	{	diagonal = previousRow[j-1] + match;		}
+				else					{	diagonal = previousRow[j-1] + mismatch;	}
+			
+				float up	= previousRow[j] + gap;
+				float left	= currentRow[j-1] + gap;
+				if (banded) {						//	the cells above the band's right edge and left of its left edge
+					if ((i > 1) && (j == (i + bandDiagonal + bandWidth)))	{	up = OUTSIDE_BAND;		}	//	weren't filled
+					if ((j > 1) && (j == (i + bandDiagonal - bandWidth)))	{	left = OUTSIDE_BAND;	}
+				}
 				
 				if(diagonal >= up){
 					if(diagonal >= left){
-						alignment[i][j].cValue = diagonal;
-						alignment[i][j].prevCell = 'd';
+						currentRow[j] = diagonal;
+						directions[rowStart+j] = 'd';
 					}
 					else{
-						alignment[i][j].cValue = left;
-						alignment[i][j].prevCell = 'l';
+						currentRow[j] = left;
+						directions[rowStart+j] = 'l';
 					}
 				}
 				else{
 					if(up >= left){
-						alignment[i][j].cValue = up;
-						alignment[i][j].prevCell = 'u';
+						currentRow[j] = up;
+						directions[rowStart+j] = 'u';
 					}
 					else{
-						alignment[i][j].cValue = left;
-						alignment[i][j].prevCell = 'l';
+						currentRow[j] = left;
+						directions[rowStart+j] = 'l';
 					}
 				}
 			}
+			
+			if (last == (lA-1)) { lastColumn[i] = currentRow[lA-1]; }
+			if (i == (lB-1))	{ for(int j=first;j<=last;j++){ lastRow[j] = currentRow[j]; } }
+			previousRow.swap(currentRow);
 		}
-        
-		Overlap over;
-		over.setOverlap(alignment, lA, lB, 0);		//	Fix gaps at the beginning and end of the sequences
+
+		Overlap over;						
+		over.setOverlap(lastColumn, lastRow, lA, lB, endRow, endColumn);		//	Fix gaps at the beginning and end of the sequences
 		traceBack(false);								//	Traceback the alignment to populate seqAaln and seqBaln
         
 	}
@@ -0,0 +1,225 @@
+//
+//  oligoindex.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "oligoindex.hpp"
+#include "needlemanoverlap.hpp"
+
+/**************************************************************************************************/
+OligoIndex::OligoIndex(vector<string> o, int d) {
+    try {
+        m = MothurOut::getInstance();
+        oligos = o; diffs = d; maxLength = 0; stamp = 0;
+        stamps.resize(oligos.size(), 0);
+
+        map<int, int> binIndexes; //length -> bin
+        for (int i = 0; i < oligos.size(); i++) {
+            int length = oligos[i].length();
+            if (length > maxLength) { maxLength = length; }
+            if (oligoIndexes.count(oligos[i]) == 0) { oligoIndexes[oligos[i]] = i; }
+
+            map<int, int>::iterator it = binIndexes.find(length);
+            if (it == binIndexes.end()) {
+                LengthBin bin; bin.length = length;
+                bins.push_back(bin);
+                it = binIndexes.insert(make_pair(length, (int)bins.size()-1)).first;
+            }
+            bins[it->second].all.push_back(i);
+
+            expand(i);
+        }
+
+        alignment = NULL;
+        maxCachedAlignments = 1;
+        if (oligos.size() != 0) {
+            alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxLength+diffs+1));
+            maxCachedAlignments = max(1, (int)(250000 / oligos.size())); //about 3Mb of results
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OligoIndex", "OligoIndex");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+OligoIndex::~OligoIndex() { if (alignment != NULL) { delete alignment; } }
+/**************************************************************************************************/
+//adds every A, C, G, T and N string that matches the oligo to its length's bin
+void OligoIndex::expand(int index) {
+    try {
+        const string bases = "ACGTN";
+        const long long maxVariants = 4096;
+
+        string oligo = oligos[index];
+        LengthBin* bin = NULL;
+        for (int i = 0; i < bins.size(); i++) { if (bins[i].length == oligo.length()) { bin = &bins[i]; break; } }
+
+        //bit j of masks[i] is set when the oligo's base i matches bases[j]
+        vector<int> masks(oligo.length(), 0);
+        long long numVariants = 1;
+        for (int i = 0; i < oligo.length(); i++) {
+            int numBases = 0;
+            for (int j = 0; j < bases.length(); j++) {
+                if (isMatchingBase(oligo[i], bases[j])) { masks[i] |= (1 << j); numBases++; }
+            }
+            numVariants *= numBases;
+            if (numVariants > maxVariants) { bin->unexpanded.push_back(index); return; }
+        }
+
+        vector<string> variants(1, "");
+        for (int i = 0; i < oligo.length(); i++) {
+            vector<string> longer;
+            for (int k = 0; k < variants.size(); k++) {
+                for (int j = 0; j < bases.length(); j++) {
+                    if ((masks[i] & (1 << j)) != 0) { longer.push_back(variants[k] + bases[j]); }
+                }
+            }
+            variants = longer;
+        }
+
+        for (int k = 0; k < variants.size(); k++) { bin->variants[variants[k]].push_back(index); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OligoIndex", "expand");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void OligoIndex::mark(int index) {
+    if (stamps[index] != stamp) { stamps[index] = stamp; matches.push_back(index); }
+}
+/**************************************************************************************************/
+int OligoIndex::findMatches(const string& seq, bool fromEnd) {
+    try {
+        stamp++;
+        if (stamp == 0) { fill(stamps.begin(), stamps.end(), 0); stamp = 1; }
+        matches.clear();
+
+        for (int i = 0; i < bins.size(); i++) {
+            int length = bins[i].length;
+            if (seq.length() < length) { continue; }
+
+            string chunk = seq.substr((fromEnd ? seq.length()-length : 0), length);
+
+            bool expanded = true;
+            for (int j = 0; j < chunk.length(); j++) {
+                char base = chunk[j];
+                if ((base != 'A') && (base != 'C') && (base != 'G') && (base != 'T') && (base != 'N')) { expanded = false; break; }
+            }
+
+            if (expanded) {
+                unordered_map<string, vector<int> >::iterator it = bins[i].variants.find(chunk);
+                if (it != bins[i].variants.end()) { for (int j = 0; j < it->second.size(); j++) { mark(it->second[j]); } }
+
+                for (int j = 0; j < bins[i].unexpanded.size(); j++) {
+                    if (compareDNASeq(oligos[bins[i].unexpanded[j]], chunk)) { mark(bins[i].unexpanded[j]); }
+                }
+            }else { //ambiguous bases in the sequence
+                for (int j = 0; j < bins[i].all.size(); j++) {
+                    if (compareDNASeq(oligos[bins[i].all[j]], chunk)) { mark(bins[i].all[j]); }
+                }
+            }
+        }
+
+        if (matches.size() == 0) { return -1; }
+
+        sort(matches.begin(), matches.end());
+        return matches[0];
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OligoIndex", "findMatches");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool OligoIndex::isMatch(const string& oligo) {
+    map<string, int>::iterator it = oligoIndexes.find(oligo);
+    if (it == oligoIndexes.end()) { return false; }
+    return isMatch(it->second);
+}
+/**************************************************************************************************/
+vector<OligoAlignment> OligoIndex::align(const string& seq, string name) {
+    try {
+        //the alignments only look at the first maxLength+diffs bases
+        string fragment = seq.substr(0, maxLength+diffs);
+        bool debug = m->getDebug();
+
+        if (!debug) {
+            unordered_map<string, vector<OligoAlignment> >::iterator it = alignments.find(fragment);
+            if (it != alignments.end()) { return it->second; }
+        }
+
+        vector<OligoAlignment> results(oligos.size());
+        for (int i = 0; i < oligos.size(); i++) {
+            if (oligos[i] == "NONE") { continue; }
+
+            //use needleman to align first oligo.length()+numdiffs of sequence to each oligo
+            alignment->alignPrimer(oligos[i], fragment.substr(0, oligos[i].length()+diffs));
+            string oligo = alignment->getSeqAAln();
+            string temp = alignment->getSeqBAln();
+
+            int alnLength = oligo.length();
+            for (int j = oligo.length()-1; j >= 0; j--) { if (oligo[j] != '-') { alnLength = j+1; break; } }
+            oligo = oligo.substr(0, alnLength);
+            temp = temp.substr(0, alnLength);
+
+            results[i].numDiffs = countDiffs(oligo, temp);
+            results[i].alnLength = alnLength;
+            for (int j = 0; j < alnLength; j++) { if (temp[j] != '-') { results[i].pos++; } }
+
+            if (debug) { m->mothurOut("[DEBUG]: " + name + " aligned fragment=" + temp + ", oligo=" + oligo + ", numDiffs=" + toString(results[i].numDiffs) + ".\n"); }
+        }
+
+        if (!debug) {
+            if (alignments.size() >= maxCachedAlignments) { alignments.clear(); }
+            alignments[fragment] = results;
+        }
+
+        return results;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OligoIndex", "align");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+bool OligoIndex::isMatchingBase(char oligo, char seq) {
+    if (oligo == seq) { return true; }
+
+    if (oligo == 'A' || oligo == 'T' || oligo == 'G' || oligo == 'C')   {	return false;	}
+    else if ((oligo == 'N' || oligo == 'I') && (seq == 'N'))            {	return false;	}
+    else if (oligo == 'R' && (seq != 'A' && seq != 'G'))                {	return false;	}
+    else if (oligo == 'Y' && (seq != 'C' && seq != 'T'))                {	return false;	}
+    else if (oligo == 'M' && (seq != 'C' && seq != 'A'))                {	return false;	}
+    else if (oligo == 'K' && (seq != 'T' && seq != 'G'))                {	return false;	}
+    else if (oligo == 'W' && (seq != 'T' && seq != 'A'))                {	return false;	}
+    else if (oligo == 'S' && (seq != 'C' && seq != 'G'))                {	return false;	}
+    else if (oligo == 'B' && (seq != 'C' && seq != 'T' && seq != 'G'))  {	return false;	}
+    else if (oligo == 'D' && (seq != 'A' && seq != 'T' && seq != 'G'))  {	return false;	}
+    else if (oligo == 'H' && (seq != 'A' && seq != 'T' && seq != 'C'))  {	return false;	}
+    else if (oligo == 'V' && (seq != 'A' && seq != 'C' && seq != 'G'))  {	return false;	}
+
+    return true; //anything else matches
+}
+/**************************************************************************************************/
+bool OligoIndex::compareDNASeq(const string& oligo, const string& seq) {
+    for (int i = 0; i < oligo.length(); i++) {
+        if (!isMatchingBase(oligo[i], seq[i])) { return false; }
+    }
+    return true;
+}
+/**************************************************************************************************/
+//like compareDNASeq, but gaps in the oligo count as differences
+int OligoIndex::countDiffs(const string& oligo, const string& seq) {
+    int numDiffs = 0;
+    for (int i = 0; i < oligo.length(); i++) {
+        if (oligo[i] == seq[i]) { continue; }
+        if ((oligo[i] == '-') || (oligo[i] == '.') || !isMatchingBase(oligo[i], seq[i])) { numDiffs++; }
+    }
+    return numDiffs;
+}
+/**************************************************************************************************/
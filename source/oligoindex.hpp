@@ -0,0 +1,93 @@
+//
+//  oligoindex.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef oligoindex_hpp
+#define oligoindex_hpp
+
+#include <unordered_map>
+#include "mothurout.h"
+#include "alignment.hpp"
+
+/* Finds the barcodes or primers at the start (or end) of a read without comparing the read to every oligo.
+
+ Each oligo is expanded into every A, C, G, T and N string compareDNASeq would accept for it, using a bitmask of the
+ bases each IUPAC code matches, and the strings are hashed by length. A read is looked up once per oligo length. Oligos
+ with too many ambiguous bases to expand, and reads with bases other than A, C, G, T and N, are compared base by base
+ like before.
+
+ The oligos keep the order the strip functions search them in, so the first match is the oligo the old loops stopped at.
+
+ align() aligns the start of a read to every oligo with one NeedlemanOverlap, the way the strip functions do when diffs
+ are allowed, and caches the results by the part of the read the alignments look at. */
+
+/**************************************************************************************************/
+
+struct OligoAlignment {
+    int numDiffs;   //countDiffs of the trimmed alignment
+    int alnLength;  //length of the alignment without the oligo's trailing gaps
+    int pos;        //bases of the read in the alignment, where the read starts after the oligo
+
+    OligoAlignment() : numDiffs(0), alnLength(0), pos(0) {}
+};
+
+/**************************************************************************************************/
+
+class OligoIndex {
+
+public:
+
+    OligoIndex(vector<string>, int); //oligos in search order, diffs allowed when aligning
+    ~OligoIndex();
+
+    //marks the oligos that match the start of the sequence, or the end if fromEnd is true. Returns the first one or -1.
+    int findMatches(const string&, bool fromEnd=false);
+    bool isMatch(int i)                     { return (stamps[i] == stamp);     }
+    bool isMatch(const string&);            //the oligo matched in the last findMatches
+    const vector<int>& getMatches()         { return matches;                  } //ascending
+
+    //aligns the first length+diffs bases of the sequence to each oligo, "NONE" is skipped. Returns one result per oligo.
+    vector<OligoAlignment> align(const string&, string); //sequence, name for the debug output
+
+    int getNumOligos()          { return oligos.size();     }
+    string getOligo(int i)      { return oligos[i];         }
+    int getMaxLength()          { return maxLength;         }
+
+    static bool isMatchingBase(char, char);         //oligo base, sequence base, by compareDNASeq's rules
+    static bool compareDNASeq(const string&, const string&);
+    static int countDiffs(const string&, const string&);
+
+private:
+
+    MothurOut* m;
+    vector<string> oligos;
+    map<string, int> oligoIndexes;
+    int diffs, maxLength;
+
+    struct LengthBin {
+        int length;
+        unordered_map<string, vector<int> > variants; //expanded oligo -> oligos, ascending
+        vector<int> unexpanded;                          //too ambiguous to expand
+        vector<int> all;
+    };
+    vector<LengthBin> bins;
+
+    vector<unsigned int> stamps;
+    unsigned int stamp;
+    vector<int> matches;
+
+    Alignment* alignment;
+    unordered_map<string, vector<OligoAlignment> > alignments;
+    int maxCachedAlignments;
+
+    void expand(int);
+    void mark(int);
+};
+
+/**************************************************************************************************/
+
+#endif /* oligoindex_hpp */
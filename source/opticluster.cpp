@@ -18,34 +18,29 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
         falseNegatives = 0;
         trueNegatives = 0;
         
-        bins.resize(numSeqs); //place seqs in own bin
-        
-        vector<long long> temp;
-        bins.push_back(temp);
-        seqBin[numSeqs] = -1;
+        //one bin per seq plus an empty one to insert into
+        seqBin.assign(numSeqs, -1);
+        binSize.assign(numSeqs+1, 0);
+        binFirst.assign(numSeqs+1, -1); binLast.assign(numSeqs+1, -1);
+        nextInBin.assign(numSeqs, -1); prevInBin.assign(numSeqs, -1);
+        emptyBins.clear();
         insertLocation = numSeqs;
         Utils util;
         
         if (initialize == "singleton") {
             
             //put everyone in own bin
-            for (int i = 0; i < numSeqs; i++) { bins[i].push_back(i); }
-            
-            //maps randomized sequences to bins
             for (int i = 0; i < numSeqs; i++) {
-                seqBin[i] = bins[i][0];
+                addToBin(i, i);
                 randomizeSeqs.push_back(i);
             }
             
             if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
             
             //for each sequence (singletons removed on read)
-            for (map<long long, long long>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
-                else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
-                    falseNegatives += numCloseSeqs;
-                }
+            for (long long i = 0; i < numSeqs; i++) {
+                long long numCloseSeqs = (matrix->getNumClose(i)); //does not include self
+                falseNegatives += numCloseSeqs;
             }
             falseNegatives /= 2; //square matrix
             trueNegatives = numSeqs * (numSeqs-1)/2 - (falsePositives + falseNegatives + truePositives); //since everyone is a singleton no one clusters together. True negative = num far apart
@@ -53,20 +48,17 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
             
             //put everyone in first bin
             for (int i = 0; i < numSeqs; i++) {
-                bins[0].push_back(i);
-                seqBin[i] = 0;
+                addToBin(i, 0);
                 randomizeSeqs.push_back(i);
             }
+            for (long long i = 1; i < numSeqs; i++) { emptyBins.push_back(i); } //sorted, so already a heap
             
             if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
             
             //for each sequence (singletons removed on read)
-            for (map<long long, long long>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
-                else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
-                    truePositives += numCloseSeqs;
-                }
+            for (long long i = 0; i < numSeqs; i++) {
+                long long numCloseSeqs = (matrix->getNumClose(i)); //does not include self
+                truePositives += numCloseSeqs;
             }
             truePositives /= 2; //square matrix
             falsePositives = numSeqs * (numSeqs-1)/2 - (trueNegatives + falseNegatives + truePositives);
@@ -88,85 +80,253 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
 bool OptiCluster::update(double& listMetric) {
     try {
         
-        //for each sequence (singletons removed on read)
-        for (int i = 0; i < randomizeSeqs.size(); i++) {
+        if (processors > 1) { updateBatches(); }
+        else {
+            //for each sequence (singletons removed on read)
+            for (int i = 0; i < randomizeSeqs.size(); i++) {
+                
+                if (m->getControl_pressed()) { break; }
+                
+                optiMove move = evaluateMove(randomizeSeqs[i], truePositives, trueNegatives, falsePositives, falseNegatives);
+                
+                if (move.fromBin == -1) { }
+                else { commitMove(move); }
+            }
+        }
+        
+        listMetric = metric->getValue(truePositives, trueNegatives, falsePositives, falseNegatives);
+        
+        if (m->getDebug()) { ListVector* list = getList(); list->print(cout); delete list; }
+        
+        return 0;
+        
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "update");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//finds the best bin for seq given the current bins and tp, tn, fp, fn. Does not change the cluster.
+//If previous is given and none of the bins it looked at have changed since, its close / far counts are reused.
+optiMove OptiCluster::evaluateMove(long long seqNumber, double truePos, double trueNeg, double falsePos, double falseNeg, optiMove* previous, vector<bool>* changed) {
+    try {
+        optiMove move;
+        move.seq = seqNumber;
+        
+        if ((seqNumber < 0) || (seqNumber >= seqBin.size())) { return move; }
+        
+        long long binNumber = seqBin[seqNumber];
+        move.fromBin = binNumber; move.toBin = binNumber;
+        
+        if (binNumber == -1) { return move; }
+        
+        bool useCounts = ((previous != NULL) && (previous->fromBin == binNumber) && (!(*changed)[binNumber]));
+        if (useCounts) {
+            for (int i = 0; i < previous->binsTried.size(); i++) { if ((*changed)[previous->binsTried[i]]) { useCounts = false; break; } }
+        }
+        
+        if (useCounts) {
+            move.fromClose = previous->fromClose; move.fromFar = previous->fromFar;
+            move.binsTried = previous->binsTried; move.closeTried = previous->closeTried; move.farTried = previous->farTried;
+        }else {
+            //tally the close seqs in each bin, so the work is proportional to the number of close seqs not the size of the bins
+            vector<long long> closeSeqs;
+            matrix->getCloseSeqs(seqNumber, closeSeqs);
+            
+            vector<long long> closeBins; closeBins.reserve(closeSeqs.size());
+            for (int i = 0; i < closeSeqs.size(); i++) { if (closeSeqs[i] != seqNumber) { closeBins.push_back(seqBin[closeSeqs[i]]); } } //ignore self
+            sort(closeBins.begin(), closeBins.end());
+            
+            for (int i = 0; i < closeBins.size(); i++) {
+                if ((i == 0) || (closeBins[i] != closeBins[i-1])) { move.binsTried.push_back(closeBins[i]); move.closeTried.push_back(0); }
+                move.closeTried.back()++;
+            }
+            
+            for (int i = 0; i < move.binsTried.size(); i++) {
+                long long bin = move.binsTried[i];
+                double others = binSize[bin]; if (bin == binNumber) { others--; }
+                move.farTried.push_back(others - move.closeTried[i]);
+                if (bin == binNumber) { move.fromClose = move.closeTried[i]; move.fromFar = move.farTried[i]; }
+            }
+            
+            if (binSize[binNumber] == 1) { move.fromClose = 0; move.fromFar = 0; }
+            else if (!binary_search(move.binsTried.begin(), move.binsTried.end(), binNumber)) { move.fromClose = 0; move.fromFar = binSize[binNumber] - 1; }
+        }
+        
+        double tn, tp, fp, fn;
+        double bestMetric = -1;
+        tn = trueNeg; tp = truePos; fp = falsePos; fn = falseNeg;
+        
+        //close / far count in current bin
+        double cCount = move.fromClose;  double fCount = move.fromFar;
+        
+        //metric in current bin
+        bestMetric = metric->getValue(tp, tn, fp, fn);
+        
+        //if not already singleton, then calc value if singleton was created
+        if (!(binSize[binNumber] == 1)) {
+            //make a singleton
+            //move out of old bin
+            fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount;
+            double singleMetric = metric->getValue(tp, tn, fp, fn);
+            if (singleMetric > bestMetric) { move.toBin = -1; bestMetric = singleMetric; }
+        }
+        
+        //merge into each "close" otu
+        for (int i = 0; i < move.binsTried.size(); i++) {
+            tn = trueNeg; tp = truePos; fp = falsePos; fn = falseNeg;
+            fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount; //move out of old bin
+            fn-=move.closeTried[i]; tn-=move.farTried[i];  tp+=move.closeTried[i]; fp+=move.farTried[i]; //move into new bin
+            double newMetric = metric->getValue(tp, tn, fp, fn); //score when sequence is moved
+            //new best
+            if (newMetric > bestMetric) { bestMetric = newMetric; move.toBin = move.binsTried[i]; move.toClose = move.closeTried[i]; move.toFar = move.farTried[i]; }
+        }
+        
+        if (move.toBin == -1) { move.toClose = 0; move.toFar = 0; }
+        
+        return move;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "evaluateMove");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//moves the sequence to the bin found by evaluateMove and updates tp, tn, fp, fn. Returns the sequence's new bin.
+long long OptiCluster::commitMove(optiMove& move) {
+    try {
+        long long bestBin = move.toBin;
+        
+        bool usedInsert = false;
+        if (bestBin == -1) {  bestBin = insertLocation;  usedInsert = true;  }
+        
+        if (bestBin != move.fromBin) {
+            //move out of old bin
+            falseNegatives += move.fromClose; trueNegatives += move.fromFar; falsePositives -= move.fromFar; truePositives -= move.fromClose;
+            //move into new bin
+            falseNegatives -= move.toClose; trueNegatives -= move.toFar; truePositives += move.toClose; falsePositives += move.toFar;
+            
+            //move seq from i to j
+            removeFromBin(move.seq, move.fromBin); //remove from old bin i
+            addToBin(move.seq, bestBin); //add seq to bestbin
+            if (binSize[move.fromBin] == 0) { emptyBins.push_back(move.fromBin); push_heap(emptyBins.begin(), emptyBins.end(), greater<long long>()); }
+        }
+        
+        if (usedInsert) { insertLocation = findInsert(); }
+        
+        return bestBin;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "commitMove");
+        exit(1);
+    }
+}
+/***********************************************************************/
+struct optiMoveData {
+    OptiCluster* cluster;
+    vector<int>* seqs;
+    vector<optiMove>* moves;
+    long long start, end, batchStart;
+    double tp, tn, fp, fn;
+    MothurOut* m;
+    
+    optiMoveData(){}
+    optiMoveData(OptiCluster* c, vector<int>* s, vector<optiMove>* mv, long long st, long long en, long long bst, double truePos, double trueNeg, double falsePos, double falseNeg) {
+        m = MothurOut::getInstance();
+        cluster = c; seqs = s; moves = mv;
+        start = st; end = en; batchStart = bst;
+        tp = truePos; tn = trueNeg; fp = falsePos; fn = falseNeg;
+    }
+};
+/***********************************************************************/
+void driverOptiMoves(optiMoveData* params) {
+    try {
+        for (long long i = params->start; i < params->end; i++) {
+            if (params->m->getControl_pressed()) { break; }
+            
+            (*params->moves)[i - params->batchStart] = params->cluster->evaluateMove((*params->seqs)[i], params->tp, params->tn, params->fp, params->fn);
+        }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "OptiCluster", "driverOptiMoves");
+        exit(1);
+    }
+}
+/***********************************************************************/
+/* The sequences are processed in batches. The close / far counts for every sequence in a batch are found in parallel
+ * from the bins at the start of the batch, then the moves are chosen and made in order, counting again only the bins
+ * changed by earlier moves in the batch. The OTUs are the same as the serial update, for any number of processors. */
+void OptiCluster::updateBatches() {
+    try {
+        //bigger batches launch fewer threads, but more of their counts have to be found again. Size them from the average
+        //number of close sequences so a batch changes a small part of the bins.
+        double averageClose = 0;
+        if (numSeqs != 0) { averageClose = matrix->getNumDists() / (double) numSeqs; }
+        long long batchSize = numSeqs / (averageClose + 1);
+        if (batchSize < 64) { batchSize = 64; }
+        else if (batchSize > 4096) { batchSize = 4096; }
+        
+        vector<bool> touched(binSize.size(), false);
+        
+        for (long long batchStart = 0; batchStart < randomizeSeqs.size(); batchStart += batchSize) {
             
             if (m->getControl_pressed()) { break; }
             
-            map<long long, long long>::iterator it = seqBin.find(randomizeSeqs[i]);
+            long long batchEnd = batchStart + batchSize;
+            if (batchEnd > randomizeSeqs.size()) { batchEnd = randomizeSeqs.size(); }
             
-            long long seqNumber = it->first;
-            long long binNumber = it->second;
+            vector<optiMove> moves(batchEnd - batchStart);
             
-            if (binNumber == -1) { }
-            else {
-                
-                double tn, tp, fp, fn;
-                double bestMetric = -1;
-                double bestBin, bestTp, bestTn, bestFn, bestFp;
-                tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
-                
-                //close / far count in current bin
-                vector<double> results = getCloseFarCounts(seqNumber, binNumber);
-                double cCount = results[0];  double fCount = results[1];
+            //find the best moves from the current bins
+            long long numPerThread = (batchEnd - batchStart) / processors;
+            vector<std::thread*> workerThreads;
+            vector<optiMoveData*> data;
+            
+            for (int i = 1; i < processors; i++) {
+                long long start = batchStart + (i * numPerThread);
+                long long end = start + numPerThread;
+                if (i == (processors-1)) { end = batchEnd; }
                 
-                //metric in current bin
-                bestMetric = metric->getValue(tp, tn, fp, fn); bestBin = binNumber; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
+                optiMoveData* dataBundle = new optiMoveData(this, &randomizeSeqs, &moves, start, end, batchStart, truePositives, trueNegatives, falsePositives, falseNegatives);
+                data.push_back(dataBundle);
+                workerThreads.push_back(new std::thread(driverOptiMoves, dataBundle));
+            }
+            
+            optiMoveData* dataBundle = new optiMoveData(this, &randomizeSeqs, &moves, batchStart, batchStart + numPerThread, batchStart, truePositives, trueNegatives, falsePositives, falseNegatives);
+            driverOptiMoves(dataBundle);
+            delete dataBundle;
+            
+            for (int i = 0; i < workerThreads.size(); i++) {
+                workerThreads[i]->join();
+                delete data[i];
+                delete workerThreads[i];
+            }
+            
+            //make the moves in order
+            vector<long long> touchedBins;
+            for (long long i = 0; i < moves.size(); i++) {
                 
-                //if not already singleton, then calc value if singleton was created
-                if (!((bins[binNumber].size()) == 1)) {
-                    //make a singleton
-                    //move out of old bin
-                    fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount;
-                    double singleMetric = metric->getValue(tp, tn, fp, fn);
-                    if (singleMetric > bestMetric) {
-                        bestBin = -1; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
-                        bestMetric = singleMetric;
-                    }
-                }
+                if (m->getControl_pressed()) { break; }
                 
-                set<long long> binsToTry;
-                set<long long> closeSeqs = matrix->getCloseSeqs(seqNumber);
-                for (set<long long>::iterator itClose = closeSeqs.begin(); itClose != closeSeqs.end(); itClose++) {  binsToTry.insert(seqBin[*itClose]); }
+                if (moves[i].fromBin == -1) { continue; }
                 
-                //merge into each "close" otu
-                for (set<long long>::iterator it = binsToTry.begin(); it != binsToTry.end(); it++) {
-                    tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
-                    fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount; //move out of old bin
-                    results = getCloseFarCounts(seqNumber, *it);
-                    fn-=results[0]; tn-=results[1];  tp+=results[0]; fp+=results[1]; //move into new bin
-                    double newMetric = metric->getValue(tp, tn, fp, fn); //score when sequence is moved
-                    //new best
-                    if (newMetric > bestMetric) { bestMetric = newMetric; bestBin = (*it); bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn; }
-                }
+                optiMove move = evaluateMove(moves[i].seq, truePositives, trueNegatives, falsePositives, falseNegatives, &moves[i], &touched);
                 
-                bool usedInsert = false;
-                if (bestBin == -1) {  bestBin = insertLocation;  usedInsert = true;  }
+                long long fromBin = move.fromBin;
+                long long toBin = commitMove(move);
                 
-                if (bestBin != binNumber) {
-                    truePositives = bestTp; trueNegatives = bestTn; falsePositives = bestFp; falseNegatives = bestFn;
-                    
-                    //move seq from i to j
-                    bins[bestBin].push_back(seqNumber); //add seq to bestbin
-                    bins[binNumber].erase(remove(bins[binNumber].begin(), bins[binNumber].end(), seqNumber), bins[binNumber].end()); //remove from old bin i
+                if (toBin != fromBin) {
+                    if (!touched[fromBin])  { touched[fromBin] = true; touchedBins.push_back(fromBin); }
+                    if (!touched[toBin])    { touched[toBin] = true; touchedBins.push_back(toBin);     }
                 }
-                
-                if (usedInsert) { insertLocation = findInsert(); }
-                
-                //update seqBins
-                seqBin[seqNumber] = bestBin; //set new OTU location
             }
+            
+            for (int i = 0; i < touchedBins.size(); i++) { touched[touchedBins[i]] = false; }
         }
-        
-        listMetric = metric->getValue(truePositives, trueNegatives, falsePositives, falseNegatives);
-        
-        if (m->getDebug()) { ListVector* list = getList(); list->print(cout); delete list; }
-        
-        return 0;
-        
     }
     catch(exception& e) {
-        m->errorOut(e, "OptiCluster", "update");
+        m->errorOut(e, "OptiCluster", "updateBatches");
         exit(1);
     }
 }
@@ -177,11 +337,17 @@ vector<double> OptiCluster::getCloseFarCounts(long long seq, long long newBin) {
         
         if (newBin == -1) { }  //making a singleton bin. Close but we are forcing apart.
         else { //merging a bin
-            for (int i = 0; i < bins[newBin].size(); i++) {
-                if (seq == bins[newBin][i]) {} //ignore self
-                else if (!matrix->isClose(seq, bins[newBin][i])) { results[1]++; }  //this sequence is "far away" from sequence i - above the cutoff
-                else { results[0]++;  }  //this sequence is "close" to sequence i - distance between them is less than cutoff
+            vector<long long> closeSeqs;
+            matrix->getCloseSeqs(seq, closeSeqs);
+            
+            for (int i = 0; i < closeSeqs.size(); i++) {
+                if (seq == closeSeqs[i]) {} //ignore self
+                else if (seqBin[closeSeqs[i]] == newBin) { results[0]++; } //this sequence is "close" to sequence i - distance between them is less than cutoff
             }
+            
+            //everyone else in the bin is "far away" - above the cutoff
+            results[1] = binSize[newBin] - results[0];
+            if (seqBin[seq] == newBin) { results[1]--; }
         }
         
         return results;
@@ -236,12 +402,12 @@ ListVector* OptiCluster::getList() {
             delete singleton;
         }
         
-        for (int i = 0; i < bins.size(); i++) {
-            if (bins[i].size() != 0) {
-                string otu = matrix->getName(bins[i][0]);
+        for (long long i = 0; i < binSize.size(); i++) {
+            if (binSize[i] != 0) {
+                string otu = matrix->getName(binFirst[i]);
                 
-                for (int j = 1; j < bins[i].size(); j++) {
-                    otu += "," + matrix->getName(bins[i][j]);
+                for (long long seq = nextInBin[binFirst[i]]; seq != -1; seq = nextInBin[seq]) {
+                    otu += "," + matrix->getName(seq);
                 }
                 list->push_back(otu);
             }
@@ -259,8 +425,8 @@ long long OptiCluster::getNumBins() {
     try {
         long long singletn = matrix->getNumSingletons();
         
-        for (int i = 0; i < bins.size(); i++) {
-            if (bins[i].size() != 0) {
+        for (long long i = 0; i < binSize.size(); i++) {
+            if (binSize[i] != 0) {
                 singletn++;
             }
         }
@@ -276,21 +442,54 @@ long long OptiCluster::getNumBins() {
 /***********************************************************************/
 long long OptiCluster::findInsert() {
     try {
+        //lowest numbered empty bin
+        if (emptyBins.size() == 0) { return -1; }
         
-        //initially there are bins for each sequence (excluding singletons removed on read)
-        for (long long i = 0; i < bins.size(); i++) {
-            
-            if (m->getControl_pressed()) { break; }
-            
-            if (bins[i].size() == 0) { return i;  } //this bin is empty
-        }
+        pop_heap(emptyBins.begin(), emptyBins.end(), greater<long long>());
+        long long bin = emptyBins.back();
+        emptyBins.pop_back();
         
-        return -1;
+        return bin;
     }
     catch(exception& e) {
         m->errorOut(e, "OptiCluster", "findInsert");
         exit(1);
     }
 }
-
+/***********************************************************************/
+//adds seq to the end of bin
+void OptiCluster::addToBin(long long seq, long long bin) {
+    try {
+        prevInBin[seq] = binLast[bin];
+        nextInBin[seq] = -1;
+        
+        if (binLast[bin] == -1) { binFirst[bin] = seq; }
+        else { nextInBin[binLast[bin]] = seq; }
+        
+        binLast[bin] = seq;
+        binSize[bin]++;
+        seqBin[seq] = bin;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "addToBin");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//removes seq from bin, keeping the order of the other seqs. Doesn't change seqBin.
+void OptiCluster::removeFromBin(long long seq, long long bin) {
+    try {
+        if (prevInBin[seq] == -1) { binFirst[bin] = nextInBin[seq]; }
+        else { nextInBin[prevInBin[seq]] = nextInBin[seq]; }
+        
+        if (nextInBin[seq] == -1) { binLast[bin] = prevInBin[seq]; }
+        else { prevInBin[nextInBin[seq]] = prevInBin[seq]; }
+        
+        binSize[bin]--;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "removeFromBin");
+        exit(1);
+    }
+}
 /***********************************************************************/
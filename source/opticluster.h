@@ -27,6 +27,16 @@
 #include "fn.hpp"
 #include "accuracy.hpp"
 
+/***********************************************************************/
+//the best place found for a sequence and the close / far counts needed to move it there
+struct optiMove {
+    long long seq, fromBin, toBin;              //toBin is -1 when the sequence should become its own OTU
+    double fromClose, fromFar, toClose, toFar;  //close / far counts in the current bin and in toBin
+    vector<long long> binsTried;                //bins the sequence had a close sequence in, sorted
+    vector<double> closeTried, farTried;        //close / far counts in each of binsTried
+    
+    optiMove() : seq(-1), fromBin(-1), toBin(-1), fromClose(0), fromFar(0), toClose(0), toFar(0) {}
+};
 /***********************************************************************/
 
 class OptiCluster : public Cluster {
@@ -35,12 +45,12 @@ public:
     
 #ifdef UNIT_TEST
     friend class TestOptiCluster;
-    OptiCluster() : Cluster() { m = MothurOut::getInstance(); truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0;  } //for testing class
+    OptiCluster() : Cluster() { m = MothurOut::getInstance(); truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; processors = 1; } //for testing class
     void setVariables(OptiData* mt, ClusterMetric* met) { matrix = mt; metric = met; }
 #endif
     
-    OptiCluster(OptiData* mt, ClusterMetric* met, long long ns) : Cluster() {
-        m = MothurOut::getInstance(); matrix = mt; metric = met; truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = ns;
+    OptiCluster(OptiData* mt, ClusterMetric* met, long long ns, int p=1) : Cluster() {
+        m = MothurOut::getInstance(); matrix = mt; metric = met; truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = ns; processors = p;
     }
     ~OptiCluster() {}
     bool updateDistance(PDistCell& colCell, PDistCell& rowCell) { return false; } //inheritance compliant
@@ -52,20 +62,30 @@ public:
     vector<double> getStats( double&,  double&,  double&,  double&);
     ListVector* getList();
     
+    //seq, tp, tn, fp, fn, counts found earlier, bins changed since - read only, called by the update threads
+    optiMove evaluateMove(long long, double, double, double, double, optiMove* previous=NULL, vector<bool>* changed=NULL);
+    
 protected:
     MothurOut* m;
     Utils util;
-    map<long long, long long> seqBin; //sequence# -> bin#
+    vector<long long> seqBin; //sequence# -> bin#
     OptiData* matrix;
     vector<int> randomizeSeqs;
-    vector< vector<long long> > bins; //bin[0] -> seqs in bin[0]
+    vector<long long> binSize; //number of seqs in each bin
+    vector<long long> binFirst, binLast, nextInBin, prevInBin; //seqs in each bin, in the order they were added. -1 ends the list
+    vector<long long> emptyBins; //min heap of the empty bins, not including insertLocation
     map<long long, string> binLabels; //for fitting - maps binNumber to existing reference label
     
     ClusterMetric* metric;
     long long numSeqs, insertLocation, numSingletons;
+    int processors;
     double truePositives, trueNegatives, falsePositives, falseNegatives;
     
     long long findInsert();
+    void addToBin(long long seq, long long bin);
+    void removeFromBin(long long seq, long long bin);
+    long long commitMove(optiMove&);
+    void updateBatches();
     vector<double> getCloseFarCounts(long long seq, long long newBin);
     vector<double> getFitStats( long long&,  long long&,  long long&,  long long&);
     
@@ -19,16 +19,16 @@
 
 /**************************************************************************************************/
 
-int Overlap::maxRow(vector<vector<AlignmentCell> >& alignment, const int band){
+int Overlap::maxRow(vector<float>& lastColumn){
 	
 	float max = -100;
 	int end = lA - 1;
 	int index = end;
 	
-	for(int i=band;i<lB;i++){					//	find the row where the right most column has the highest alignment
-		if(alignment[i][end].cValue >= max){	//	score.
+	for(int i=0;i<lB;i++){						//	find the row where the right most column has the highest alignment
+		if(lastColumn[i] >= max){				//	score.
 			index = i;
-			max = alignment[i][end].cValue;
+			max = lastColumn[i];
 		}
 	}
 	return index;
@@ -36,16 +36,16 @@ int Overlap::maxRow(vector<vector<AlignmentCell> >& alignment, const int band){
 
 /**************************************************************************************************/
 
-int Overlap::maxColumn(vector<vector<AlignmentCell> >& alignment, const int band){
+int Overlap::maxColumn(vector<float>& lastRow){
 	
 	float max = -100;
 	int end = lB - 1;
 	int index = end;
 	
-	for(int i=band;i<lA;i++){					//	find the column where the bottom most column has the highest
-		if(alignment[end][i].cValue >= max){	//	alignment score.
+	for(int i=0;i<lA;i++){						//	find the column where the bottom most column has the highest
+		if(lastRow[i] >= max){					//	alignment score.
 			index = i;
-			max = alignment[end][i].cValue;
+			max = lastRow[i];
 		}
 	}
 	return index;
@@ -53,30 +53,27 @@ int Overlap::maxColumn(vector<vector<AlignmentCell> >& alignment, const int band
 
 /**************************************************************************************************/
 
-void Overlap::setOverlap(vector<vector<AlignmentCell> >& alignment, const int nA, const int nB, const int band=0){
+void Overlap::setOverlap(vector<float>& lastColumn, vector<float>& lastRow, const int nA, const int nB, int& endRow, int& endColumn){
 	
 	lA = nA;
 	lB = nB;	
 	
-	int rowIndex = maxRow(alignment, band);		//	get the index for the row with the highest right hand side score
-	int colIndex = maxColumn(alignment, band);	//	get the index for the column with the highest bottom row score
+	int rowIndex = maxRow(lastColumn);		//	get the index for the row with the highest right hand side score
+	int colIndex = maxColumn(lastRow);		//	get the index for the column with the highest bottom row score
 		
 	int row = lB-1;
 	int column = lA-1;
+	endRow = row;
+	endColumn = column;
 	
 	if(colIndex == column && rowIndex == row){}	//	if the max values are the lower right corner, then we're good
-	else if(alignment[row][colIndex].cValue < alignment[rowIndex][column].cValue){
-		for(int i=rowIndex+1;i<lB;i++){			//	decide whether sequence A or B needs the gaps at the end either set 
-			alignment[i][column].prevCell = 'u';//	the pointer upwards or...
-		}
-		
+	else if(lastRow[colIndex] < lastColumn[rowIndex]){
+		endRow = rowIndex;						//	decide whether sequence A or B needs the gaps at the end either
+												//	go up the right column to rowIndex or...
 	}
 	else {
-		for(int i=colIndex+1;i<lA;i++){
-			alignment[row][i].prevCell = 'l';	//	...to the left
-		}
+		endColumn = colIndex;					//	...left along the bottom row to colIndex
 	}
 }												//	the traceback should take care of the gaps at the 5' end
 
 /**************************************************************************************************/
-
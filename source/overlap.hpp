@@ -14,6 +14,8 @@
  *	in the last column and row to determine whether there should be exta gaps in sequence A or sequence B.  The gap
  *	issues at the 5' end of the alignment seem to take care of themselves in the traceback.
  *
+ *	The traceback leaves the right column at endRow or the bottom row at endColumn, the cells after that are gaps.
+ *
  */
 
 #include "mothur.h"
@@ -25,10 +27,10 @@ class Overlap {
 public:
 	Overlap(){};
 	~Overlap(){};
-	void setOverlap(vector<vector<AlignmentCell> >&, const int, const int, const int);
+	void setOverlap(vector<float>&, vector<float>&, const int, const int, int&, int&); //right column scores, bottom row scores, lA, lB, endRow, endColumn
 private:
-	int maxRow(vector<vector<AlignmentCell> >&, const int);
-	int maxColumn(vector<vector<AlignmentCell> >&, const int);
+	int maxRow(vector<float>&);
+	int maxColumn(vector<float>&);
 	int lA, lB;
 };
 
@@ -0,0 +1,183 @@
+//
+//  profiler.cpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "profiler.hpp"
+
+Profiler* Profiler::instance = NULL;
+/**************************************************************************************************/
+Profiler* Profiler::getInstance() {
+    if (instance == NULL) { instance = new Profiler(); }
+    return instance;
+}
+/**************************************************************************************************/
+Profiler::Profiler() {
+    m = MothurOut::getInstance();
+    enabled = false; generation = 0; commandStarted = false;
+    profileFileName = ""; format = "tsv"; commandName = "";
+}
+/**************************************************************************************************/
+void Profiler::setProfile(string fileName, string f) {
+    try {
+        profileFileName = fileName; format = f;
+        commandStarted = false;
+
+        if (profileFileName == "") { enabled = false; return; }
+
+        ofstream out; util.openOutputFile(profileFileName, out);
+        if (format == "tsv") { out << "command\tstage\tthreads\tcalls\tseconds\tmaxThreadSeconds\titems\tbytesRead\tbytesWritten\tpeakRAM\n"; }
+        out.close();
+
+        enabled = true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Profiler", "setProfile");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void Profiler::startCommand(string name) {
+    try {
+        commandStarted = isEnabled();
+        if (!commandStarted) { return; }
+
+        commandName = name;
+        clearThreadStages();
+        commandStart = std::chrono::steady_clock::now();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Profiler", "startCommand");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//appends the command's stages to the profile file, one row per stage for tsv and one line per command for json
+void Profiler::endCommand() {
+    try {
+        if (!commandStarted || !isEnabled()) { commandStarted = false; return; }
+        commandStarted = false;
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - commandStart;
+        double peakRAM = util.getRAMUsed();
+        map<string, ProfileStage> stages = getStages();
+
+        ofstream out; util.openOutputFileAppend(profileFileName, out);
+        out.setf(ios::fixed, ios::floatfield); out << setprecision(6);
+
+        if (format == "json") {
+            out << "{\"command\": \"" << commandName << "\", \"seconds\": " << elapsed.count() << ", \"peakRAM\": " << (long long)peakRAM << ", \"stages\": {";
+            for (map<string, ProfileStage>::iterator it = stages.begin(); it != stages.end(); it++) {
+                if (it != stages.begin()) { out << ", "; }
+                ProfileStage& s = it->second;
+                out << "\"" << it->first << "\": {\"threads\": " << s.threads << ", \"calls\": " << s.calls << ", \"seconds\": " << s.seconds << ", \"maxThreadSeconds\": " << s.maxThreadSeconds << ", \"items\": " << s.items << ", \"bytesRead\": " << s.bytesRead << ", \"bytesWritten\": " << s.bytesWritten << ", \"peakRAM\": " << (long long)s.peakRAM << "}";
+            }
+            out << "}}\n";
+        }else {
+            for (map<string, ProfileStage>::iterator it = stages.begin(); it != stages.end(); it++) {
+                ProfileStage& s = it->second;
+                out << commandName << '\t' << it->first << '\t' << s.threads << '\t' << s.calls << '\t' << s.seconds << '\t' << s.maxThreadSeconds << '\t' << s.items << '\t' << s.bytesRead << '\t' << s.bytesWritten << '\t' << (long long)s.peakRAM << '\n';
+            }
+            out << commandName << "\ttotal\t1\t1\t" << elapsed.count() << '\t' << elapsed.count() << "\t0\t0\t0\t" << (long long)peakRAM << '\n';
+        }
+        out.close();
+
+        clearThreadStages();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Profiler", "endCommand");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void Profiler::addTime(const char* stage, double seconds) {
+    ProfileStage& s = getThreadStages()[stage];
+    s.calls++; s.seconds += seconds;
+
+    double ram = util.getRAMUsed();
+    if (ram > s.peakRAM) { s.peakRAM = ram; }
+}
+/**************************************************************************************************/
+void Profiler::addItems(const char* stage, long long num) {
+    if (isEnabled()) { getThreadStages()[stage].items += num; }
+}
+/**************************************************************************************************/
+void Profiler::addBytesRead(const char* stage, long long num) {
+    if (isEnabled()) { getThreadStages()[stage].bytesRead += num; }
+}
+/**************************************************************************************************/
+void Profiler::addBytesWritten(const char* stage, long long num) {
+    if (isEnabled()) { getThreadStages()[stage].bytesWritten += num; }
+}
+/**************************************************************************************************/
+void Profiler::addFileRead(const char* stage, string fileName) {
+    if (isEnabled()) { getThreadStages()[stage].bytesRead += getFileSize(fileName); }
+}
+/**************************************************************************************************/
+void Profiler::addFileWritten(const char* stage, string fileName) {
+    if (isEnabled()) { getThreadStages()[stage].bytesWritten += getFileSize(fileName); }
+}
+/**************************************************************************************************/
+map<string, ProfileStage> Profiler::getStages() {
+    try {
+        map<string, ProfileStage> stages;
+
+        lock_guard<mutex> guard(threadMutex);
+        for (int i = 0; i < threadStages.size(); i++) {
+            for (map<string, ProfileStage>::iterator it = threadStages[i]->begin(); it != threadStages[i]->end(); it++) {
+                ProfileStage& total = stages[it->first];
+                ProfileStage& thread = it->second;
+
+                total.threads++;
+                total.calls += thread.calls; total.items += thread.items;
+                total.bytesRead += thread.bytesRead; total.bytesWritten += thread.bytesWritten;
+                total.seconds += thread.seconds;
+                if (thread.seconds > total.maxThreadSeconds) { total.maxThreadSeconds = thread.seconds; }
+                if (thread.peakRAM > total.peakRAM) { total.peakRAM = thread.peakRAM; }
+            }
+        }
+
+        return stages;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Profiler", "getStages");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//the threads keep a pointer to their counters, the profiler owns them so they outlive the threads. A thread whose
+//counters are from an earlier command gets new ones.
+map<string, ProfileStage>& Profiler::getThreadStages() {
+    static thread_local map<string, ProfileStage>* stages = NULL;
+    static thread_local int stagesGeneration = -1;
+
+    int currentGeneration = generation.load();
+    if ((stages == NULL) || (stagesGeneration != currentGeneration)) {
+        lock_guard<mutex> guard(threadMutex);
+        stages = new map<string, ProfileStage>();
+        threadStages.push_back(stages);
+        stagesGeneration = currentGeneration;
+    }
+
+    return *stages;
+}
+/**************************************************************************************************/
+void Profiler::clearThreadStages() {
+    lock_guard<mutex> guard(threadMutex);
+    for (int i = 0; i < threadStages.size(); i++) { delete threadStages[i]; }
+    threadStages.clear();
+    generation++;
+}
+/**************************************************************************************************/
+long long Profiler::getFileSize(string fileName) {
+    ifstream in(fileName.c_str(), ios::binary | ios::ate);
+    if (!in) { return 0; }
+
+    long long size = in.tellg();
+    if (size < 0) { size = 0; }
+    return size;
+}
+/**************************************************************************************************/
@@ -0,0 +1,106 @@
+//
+//  profiler.hpp
+//  Mothur
+//
+//  Created by Schloss Lab on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef profiler_hpp
+#define profiler_hpp
+
+#include "utils.hpp"
+#include <atomic>
+
+/* The profiler breaks the time a command takes down by stage - reading, searching, aligning, writing and so on. The
+ drivers mark a stage with a ProfileTimer for the scope of the work and add the number of items processed and bytes
+ read or written. Each thread adds to its own counters, so the timers don't share a lock, and the threads' counters are
+ summed when the command finishes.
+
+ Profiling is off until set.profile turns it on. When it is off a timer only checks a flag, so the timers can stay in
+ the drivers' loops. When it is on, the engines write a row per stage to the profile file after each command. */
+
+//**********************************************************************************************************************
+struct ProfileStage {
+    long long calls, items, bytesRead, bytesWritten;
+    double seconds, maxThreadSeconds, peakRAM;
+    int threads;
+
+    ProfileStage() : calls(0), items(0), bytesRead(0), bytesWritten(0), seconds(0), maxThreadSeconds(0), peakRAM(0), threads(0) {}
+};
+//**********************************************************************************************************************
+class Profiler {
+
+public:
+    static Profiler* getInstance();
+
+    bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    //format is tsv or json, starts a new profile file. Pass "" to turn profiling off.
+    void setProfile(string, string);
+    string getProfileFile() { return profileFileName; }
+
+    //called by the engines around each command
+    void startCommand(string);
+    void endCommand();
+
+    void addTime(const char*, double); //seconds
+    void addItems(const char*, long long);
+    void addBytesRead(const char*, long long);
+    void addBytesWritten(const char*, long long);
+    void addFileRead(const char*, string);      //adds the size of the file
+    void addFileWritten(const char*, string);
+
+    map<string, ProfileStage> getStages(); //the stages of the command so far, summed over the threads
+
+private:
+
+    static Profiler* instance;
+    Profiler();
+    ~Profiler() {}
+
+    MothurOut* m;
+    Utils util;
+    std::atomic<bool> enabled;
+    std::atomic<int> generation; //changes each command, so a thread starts new counters
+    bool commandStarted;
+    string profileFileName, format, commandName;
+    std::chrono::steady_clock::time_point commandStart;
+
+    mutex threadMutex;
+    vector< map<string, ProfileStage>* > threadStages;
+
+    map<string, ProfileStage>& getThreadStages();
+    void clearThreadStages();
+    long long getFileSize(string);
+};
+//**********************************************************************************************************************
+//times its scope as part of a stage
+class ProfileTimer {
+
+public:
+    ProfileTimer(const char* s) : stage(s) {
+        profiler = Profiler::getInstance();
+        running = profiler->isEnabled();
+        if (running) { start = std::chrono::steady_clock::now(); }
+    }
+    ~ProfileTimer() { stop(); }
+
+    //ends the timing before the end of the scope
+    void stop() {
+        if (running) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            profiler->addTime(stage, elapsed.count());
+            running = false;
+        }
+    }
+
+private:
+    Profiler* profiler;
+    const char* stage;
+    bool running;
+    std::chrono::steady_clock::time_point start;
+};
+//**********************************************************************************************************************
+
+#endif /* profiler_hpp */
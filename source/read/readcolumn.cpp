@@ -36,6 +36,22 @@ int ReadColumnMatrix::read(NameAssignment* nameMap){
 		int nseqs = nameMap->size();
         DMatrix->resize(nseqs);
 		list = new ListVector(nameMap->getListVector());
+        
+        if (BinaryDistFile::isBinary(distFile)) {
+            fileHandle.close();
+            
+            BinaryDistFile binDist;
+            if (!binDist.read(distFile)) { m->setControl_pressed(true); return 0; }
+            
+            vector<long long> indexes;
+            for (long long i = 0; i < binDist.getNumSeqs(); i++) {
+                map<string,int>::iterator it = nameMap->find(binDist.getName(i));
+                if(it == nameMap->end()){  m->mothurOut("AAError: Sequence '" + binDist.getName(i) + "' was not found in the names file, please correct\n"); exit(1);  }
+                indexes.push_back(it->second);
+            }
+            
+            return readBinary(binDist, indexes);
+        }
 	
         int lt = 1;
 		int refRow = 0;	//we'll keep track of one cell - Cell(refRow,refCol) - and see if it's transpose
@@ -158,6 +174,21 @@ int ReadColumnMatrix::read(CountTable* countTable){
         DMatrix->resize(nseqs);
 		list = new ListVector(countTable->getListVector());
         
+        if (BinaryDistFile::isBinary(distFile)) {
+            fileHandle.close();
+            
+            BinaryDistFile binDist;
+            if (!binDist.read(distFile)) { m->setControl_pressed(true); return 0; }
+            
+            vector<long long> indexes;
+            for (long long i = 0; i < binDist.getNumSeqs(); i++) {
+                indexes.push_back(countTable->get(binDist.getName(i)));
+                if (m->getControl_pressed()) { exit(1); }
+            }
+            
+            return readBinary(binDist, indexes);
+        }
+        
 		int lt = 1;
 		int refRow = 0;	//we'll keep track of one cell - Cell(refRow,refCol) - and see if it's transpose
 		int refCol = 0; //shows up later - Cell(refCol,refRow).  If it does, then its a square matrix
@@ -265,6 +296,38 @@ int ReadColumnMatrix::read(CountTable* countTable){
 	}
 }
 
+/***********************************************************************/
+//binary files only have the lower triangle, so there is no need to check for a square matrix
+int ReadColumnMatrix::readBinary(BinaryDistFile& binDist, vector<long long>& indexes){
+	try {
+        for (long long i = 0; i < binDist.getNumSeqs(); i++) {
+            
+            if (m->getControl_pressed()) {  return 0; }
+            
+            for (unsigned long long k = binDist.getRowStart(i); k < binDist.getRowStart(i+1); k++) {
+                long long itA = indexes[i];
+                long long itB = indexes[binDist.getCol(k)];
+                float distance = binDist.getDist(k);
+                
+                if (util.isEqual(distance, -1)) { distance = 1000000; }
+                else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+                
+                if(distance <= cutoff && itA != itB){
+                    if (itA > itB) { PDistCell value(itA, distance); DMatrix->addCell(itB, value); }
+                    else { PDistCell value(itB, distance); DMatrix->addCell(itA, value); }
+                }
+            }
+        }
+        
+		list->setLabel("0");
+		
+		return 1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadColumnMatrix", "readBinary");
+		exit(1);
+	}
+}
 /***********************************************************************/
 ReadColumnMatrix::~ReadColumnMatrix(){}
 /***********************************************************************/
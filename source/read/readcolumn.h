@@ -10,6 +10,7 @@
  */
 
 #include "readmatrix.hpp"
+#include "binarydistfile.hpp"
 
 /******************************************************/
 
@@ -24,6 +25,8 @@ public:
 private:
 	ifstream fileHandle;
 	string distFile;
+    
+    int readBinary(BinaryDistFile&, vector<long long>&); //index of each binary file sequence in the matrix
 	
 };
 
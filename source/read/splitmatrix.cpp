@@ -24,6 +24,8 @@ SplitMatrix::SplitMatrix(string distfile, string name, string count, string tax,
     countfile = count;
 	large = l;
     outputType = "distance";
+    binDist = NULL;
+    stream = false; memory = 0; memoryUsed = 0; streamCutoff = c; numSingleton = 0;
 }
 /***********************************************************************/
 
@@ -40,6 +42,8 @@ SplitMatrix::SplitMatrix(string ffile, string name, string count, string tax, fl
     classic = cl;
 	outputDir = output;
     outputType = ot;
+    binDist = NULL;
+    stream = false; memory = 0; memoryUsed = 0; streamCutoff = cu; numSingleton = 0;
 }
 
 /***********************************************************************/
@@ -67,11 +71,54 @@ int SplitMatrix::split(){
 	}
 }
 /***********************************************************************/
+//distFile can be a column file or a binary distance file
+bool SplitMatrix::openDistFile(ifstream& in){
+	try {
+        if (BinaryDistFile::isBinary(distFile)) {
+            binDist = new BinaryDistFile();
+            if (!binDist->read(distFile)) { m->setControl_pressed(true); return false; }
+            return true;
+        }
+        return util.openInputFile(distFile, in);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "openDistFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool SplitMatrix::getNextDist(ifstream& in, string& seqA, string& seqB, float& dist){
+	try {
+        if (binDist != NULL) { return binDist->getNext(seqA, seqB, dist); }
+        
+        if (!in) { return false; }
+        in >> seqA >> seqB >> dist; util.gobble(in);
+        
+        return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "getNextDist");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SplitMatrix::closeDistFile(ifstream& in){
+	try {
+        if (binDist != NULL) { delete binDist; binDist = NULL; }
+        else { in.close(); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "closeDistFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
 int SplitMatrix::splitDistance(){
 	try {
         
-		if (large)	{ splitDistanceLarge(); }
-		else		{ splitDistanceRAM();	}
+		if (stream)         { streamDistance();     }
+		else if (large)     { splitDistanceLarge(); }
+		else                { splitDistanceRAM();	}
 		
 		return 0;
 			
@@ -127,7 +174,9 @@ int SplitMatrix::splitClassify(){
 	
 		delete phylo;
 		
-		if (method == "classify") {
+		if ((method == "classify") && stream) {
+			streamDistanceByTax(seqGroup, numGroups);
+		}else if (method == "classify") {
 			splitDistanceFileByTax(seqGroup, numGroups);
 		}else {
 			createDistanceFilesFromTax(seqGroup, numGroups);
@@ -241,7 +290,7 @@ int SplitMatrix::splitDistanceFileByTax(map<string, int>& seqGroup, int numGroup
 		
         ofstream outFile;
 		ifstream dFile;
-		util.openInputFile(distFile, dFile);
+		openDistFile(dFile);
 		
 		
 		for (int i = 0; i < numGroups; i++) { //remove old temp files, just in case
@@ -258,13 +307,12 @@ int SplitMatrix::splitDistanceFileByTax(map<string, int>& seqGroup, int numGroup
 		vector<bool> validDistances;   validDistances.resize(numGroups, false); 
 		
 		//for each distance
-		while(dFile){
-			string seqA, seqB;
-			float dist;
+		string seqA, seqB;
+		float dist;
+		while(getNextDist(dFile, seqA, seqB, dist)){
 			
-			if (m->getControl_pressed()) { dFile.close(); for (int i = 0; i < numGroups; i++) { util.mothurRemove((distFile + "." + toString(i) + ".temp"));	} }
+			if (m->getControl_pressed()) { closeDistFile(dFile); for (int i = 0; i < numGroups; i++) { util.mothurRemove((distFile + "." + toString(i) + ".temp"));	} }
 			
-			dFile >> seqA >> seqB >> dist;  util.gobble(dFile);
 			
 			//if both sequences are in the same group then they are within the cutoff
 			it = seqGroup.find(seqA);
@@ -286,7 +334,7 @@ int SplitMatrix::splitDistanceFileByTax(map<string, int>& seqGroup, int numGroup
 				}
 			}
 		}
-		dFile.close();
+		closeDistFile(dFile);
         
         string inputFile = namefile;
         if (countfile != "") { inputFile = countfile; }
@@ -340,15 +388,13 @@ int SplitMatrix::splitDistanceLarge(){
 
 		//ofstream outFile;
 		ifstream dFile;
-		util.openInputFile(distFile, dFile);
+		openDistFile(dFile);
 	
-		while(dFile){
-			string seqA, seqB;
-			float dist;
-
-			dFile >> seqA >> seqB >> dist;
+		string seqA, seqB;
+		float dist;
+		while(getNextDist(dFile, seqA, seqB, dist)){
 			
-			if (m->getControl_pressed()) {   dFile.close();  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  util.mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
+			if (m->getControl_pressed()) {   closeDistFile(dFile);  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  util.mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
 					
 			if(dist <= cutoff){
 				
@@ -490,9 +536,8 @@ int SplitMatrix::splitDistanceLarge(){
 					}
 				}
 			}
-			util.gobble(dFile);
 		}
-		dFile.close();
+		closeDistFile(dFile);
         
 		vector<string> tempDistFiles;
 		for (int i = 0; i < numGroups; i++) {
@@ -545,13 +590,12 @@ int SplitMatrix::splitNames(map<string, int>& seqGroup, int numGroups, vector<st
         //grab header line
         string defaultCountTableHeaders = "";
         if (countfile != "") {
-            map<string, int> ctMap;
-            CountTable ct; ct.readTable(countfile, false, true); ctMap = ct.getNameMap();
+            CountTable ct; ct.readTable(countfile, false, true);
             vector<string> headers = ct.getHardCodedHeaders();
             defaultCountTableHeaders = util.getStringFromVector(headers, "\t");
-            for (map<string, int>::iterator itCtMap = ctMap.begin(); itCtMap != ctMap.end(); itCtMap++) {
-                string name = itCtMap->first;
-                int abundance = itCtMap->second;
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) {
+                string name = ct.getSortedName(i);
+                int abundance = ct.getSortedNumSeqs(i);
                 
                 //did this sequence get assigned a group
                 it = seqGroup.find(name);
@@ -689,15 +733,15 @@ int SplitMatrix::splitNamesVsearch(map<string, int>& seqGroup, int numGroups, ve
         numSingleton = 0;
         string headers = ""; bool hasGroups = false;
         if (countfile != "") {
-            errorMessage = "count"; map<string, int> ctMap;
-            CountTable ct; ct.readTable(countfile, true, true); ctMap = ct.getNameMap();
+            errorMessage = "count";
+            CountTable ct; ct.readTable(countfile, true, true);
             hasGroups = ct.hasGroupInfo();
             vector<string> headers = ct.getHardCodedHeaders();
             defaultCountTableHeaders = util.getStringFromVector(headers, "\t");
             
-            for (map<string, int>::iterator itCtMap = ctMap.begin(); itCtMap != ctMap.end(); itCtMap++) {
-                string name = itCtMap->first;
-                int abundance = itCtMap->second;
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) {
+                string name = ct.getSortedName(i);
+                int abundance = ct.getSortedNumSeqs(i);
                 
                 //did this sequence get assigned a group
                 it = seqGroup.find(name);
@@ -813,15 +857,13 @@ int SplitMatrix::splitDistanceRAM(){
 		int numGroups = 0;
 
 		ifstream dFile;
-		util.openInputFile(distFile, dFile);
+		openDistFile(dFile);
 
-		while(dFile){
-			string seqA, seqB;
-			float dist;
-
-			dFile >> seqA >> seqB >> dist;
+		string seqA, seqB;
+		float dist;
+		while(getNextDist(dFile, seqA, seqB, dist)){
 			
-			if (m->getControl_pressed()) {   dFile.close();  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  util.mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
+			if (m->getControl_pressed()) {   closeDistFile(dFile);  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  util.mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
 					
 			if(dist <= cutoff){
 				
@@ -889,9 +931,8 @@ int SplitMatrix::splitDistanceRAM(){
 					}
 				}
 			}
-			util.gobble(dFile);
 		}
-		dFile.close();
+		closeDistFile(dFile);
 		
         vector<string> tempDistFiles;
 		for (int i = 0; i < numGroups; i++) {
@@ -923,6 +964,365 @@ int SplitMatrix::splitDistanceRAM(){
 	}
 }
 //********************************************************************************************************************
+//reads the name or count file so the streamed distances can be stored by index
+int SplitMatrix::readStreamNames(){
+	try {
+        seqNames.clear(); seqLists.clear(); seqIndex.clear();
+        
+        if (countfile != "") {
+            CountTable ct; ct.readTable(countfile, false, true);
+            vector<string> headers = ct.getHardCodedHeaders();
+            defaultCountTableHeaders = util.getStringFromVector(headers, "\t");
+            
+            for (int i = 0; i < ct.getNumSortedSeqs(); i++) {
+                seqIndex[ct.getSortedName(i)] = seqNames.size();
+                seqNames.push_back(ct.getSortedName(i)); seqLists.push_back(toString(ct.getSortedNumSeqs(i)));
+            }
+        }else if (namefile != "") {
+            ifstream in;
+            util.openInputFile(namefile, in);
+            
+            string name, nameList;
+            while(!in.eof()){
+                if (m->getControl_pressed()) { break; }
+                
+                in >> name; util.gobble(in); in >> nameList; util.gobble(in);
+                
+                seqIndex[name] = seqNames.size();
+                seqNames.push_back(name); seqLists.push_back(nameList);
+            }
+            in.close();
+        }else { m->mothurOut("[ERROR]: You must provide a name or count file to split the distances in memory.\n"); m->setControl_pressed(true); }
+        
+        seqLocal.assign(seqNames.size(), -1);
+        
+        return seqNames.size();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "readStreamNames");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+//same groups as splitDistanceRAM, but the distances are kept in memory by group instead of written to a file for each group
+int SplitMatrix::streamDistance(){
+	try {
+        readStreamNames();
+        if (m->getControl_pressed()) { return 0; }
+        
+        vector<int> seqGroup(seqNames.size(), -1);
+		int numGroups = 0;
+        
+		ifstream dFile;
+		openDistFile(dFile);
+        
+		string seqA, seqB;
+		float dist;
+		while(getNextDist(dFile, seqA, seqB, dist)){
+			
+			if (m->getControl_pressed()) { break; }
+            
+			if(dist <= cutoff){
+                map<string, unsigned int>::iterator itA = seqIndex.find(seqA);
+                map<string, unsigned int>::iterator itB = seqIndex.find(seqB);
+                
+                if (itA == seqIndex.end()) { m->mothurOut("[ERROR]: " + seqA + " is in your distance file and not in your name or count file, please correct.\n"); m->setControl_pressed(true); break; }
+                if (itB == seqIndex.end()) { m->mothurOut("[ERROR]: " + seqB + " is in your distance file and not in your name or count file, please correct.\n"); m->setControl_pressed(true); break; }
+                
+                unsigned int a = itA->second; unsigned int b = itB->second;
+                int groupIDA = -1; if (seqGroup[a] != -1) { groupIDA = findGroup(seqGroup[a]); }
+                int groupIDB = -1; if (seqGroup[b] != -1) { groupIDB = findGroup(seqGroup[b]); }
+                
+                int groupID = groupIDA;
+                if ((groupIDA == -1) && (groupIDB == -1)) { //we need a new group
+                    groupID = numGroups; numGroups++;
+                    groupParent.push_back(groupID); groupBytes.push_back(0);
+                    groupDists.resize(numGroups); groupSpills.resize(numGroups);
+                }else if (groupIDA == -1) { groupID = groupIDB; }
+                else if ((groupIDB != -1) && (groupIDA != groupIDB)) { //merge the two groups into the lower one
+                    groupID = min(groupIDA, groupIDB);
+                    int merged = max(groupIDA, groupIDB);
+                    groupParent[merged] = groupID;
+                    
+                    if (groupDists[merged].size() > groupDists[groupID].size()) { groupDists[merged].swap(groupDists[groupID]); } //order doesn't matter, copy the smaller one
+                    groupDists[groupID].insert(groupDists[groupID].end(), groupDists[merged].begin(), groupDists[merged].end());
+                    vector<SplitDist>().swap(groupDists[merged]);
+                    
+                    groupSpills[groupID].insert(groupSpills[groupID].end(), groupSpills[merged].begin(), groupSpills[merged].end());
+                    groupSpills[merged].clear();
+                    
+                    groupBytes[groupID] += groupBytes[merged]; groupBytes[merged] = 0;
+                }
+                
+                seqGroup[a] = groupID; seqGroup[b] = groupID;
+                addStreamDist(groupID, SplitDist(a, b, dist), seqA, seqB);
+			}
+		}
+		closeDistFile(dFile);
+        
+        if (m->getControl_pressed()) { return 0; }
+        
+        for (int i = 0; i < seqGroup.size(); i++) { if (seqGroup[i] != -1) { seqGroup[i] = findGroup(seqGroup[i]); } }
+        
+        finishStream(seqGroup, numGroups);
+        
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "streamDistance");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+//same groups as splitDistanceFileByTax, but the distances are kept in memory by group
+int SplitMatrix::streamDistanceByTax(map<string, int>& seqGroup, int numGroups){
+	try {
+        readStreamNames();
+        if (m->getControl_pressed()) { return 0; }
+        
+        vector<int> groups(seqNames.size(), -1);
+        for (int i = 0; i < seqNames.size(); i++) {
+            map<string, int>::iterator it = seqGroup.find(seqNames[i]);
+            if (it != seqGroup.end()) { groups[i] = it->second; }
+        }
+        
+        for (int i = 0; i < numGroups; i++) { groupParent.push_back(i); }
+        groupBytes.assign(numGroups, 0); groupDists.resize(numGroups); groupSpills.resize(numGroups);
+        
+		ifstream dFile;
+		openDistFile(dFile);
+        
+		string seqA, seqB;
+		float dist;
+		while(getNextDist(dFile, seqA, seqB, dist)){
+			
+			if (m->getControl_pressed()) { break; }
+            
+			//if both sequences are in the same group then they are within the cutoff
+			map<string, int>::iterator it = seqGroup.find(seqA);
+			map<string, int>::iterator it2 = seqGroup.find(seqB);
+			
+			if ((it != seqGroup.end()) && (it2 != seqGroup.end())) { //they are both not singletons
+				if (it->second == it2->second) { //they are from the same group so add the distance
+                    map<string, unsigned int>::iterator itA = seqIndex.find(seqA);
+                    map<string, unsigned int>::iterator itB = seqIndex.find(seqB);
+                    
+                    unsigned int a = 0; unsigned int b = 0;
+                    if (itA != seqIndex.end()) { a = itA->second; }
+                    if (itB != seqIndex.end()) { b = itB->second; }
+                    
+                    if (!util.isEqual(dist, -1) && (dist <= streamCutoff)) { //the clustering will use this distance
+                        if (itA == seqIndex.end()) { m->mothurOut("[ERROR]: " + seqA + " is in your distance file and not in your name or count file, please correct.\n"); m->setControl_pressed(true); break; }
+                        if (itB == seqIndex.end()) { m->mothurOut("[ERROR]: " + seqB + " is in your distance file and not in your name or count file, please correct.\n"); m->setControl_pressed(true); break; }
+                    }
+                    
+                    addStreamDist(it->second, SplitDist(a, b, dist), seqA, seqB);
+				}
+			}
+		}
+		closeDistFile(dFile);
+        
+        if (m->getControl_pressed()) { return 0; }
+        
+        finishStream(groups, numGroups);
+        
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "streamDistanceByTax");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+void SplitMatrix::addStreamDist(int group, SplitDist dist, string& seqA, string& seqB){
+	try {
+        //size of the line in the group's distance file, so the groups are clustered in the same order as the files
+        map<float, int>::iterator it = distLengths.find(dist.dist);
+        if (it == distLengths.end()) { distLengths[dist.dist] = toString(dist.dist).length(); it = distLengths.find(dist.dist); }
+        groupBytes[group] += seqA.length() + seqB.length() + it->second + 3;
+        
+        //only the distances the clustering will use are kept
+        if (util.isEqual(dist.dist, -1) || (dist.dist > streamCutoff)) { return; }
+        
+        groupDists[group].push_back(dist);
+        memoryUsed += sizeof(SplitDist);
+        
+        if (memoryUsed > memory) { spillGroups(); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "addStreamDist");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+//writes the biggest groups to their temp files until half the memory is free
+void SplitMatrix::spillGroups(){
+	try {
+        while (memoryUsed > (memory / 2)) {
+            int biggest = -1;
+            for (int i = 0; i < groupDists.size(); i++) {
+                if ((biggest == -1) || (groupDists[i].size() > groupDists[biggest].size())) { biggest = i; }
+            }
+            if ((biggest == -1) || (groupDists[biggest].size() == 0)) { break; }
+            
+            string spillFile = distFile + "." + toString(biggest) + ".stream.temp";
+            if (find(groupSpills[biggest].begin(), groupSpills[biggest].end(), spillFile) == groupSpills[biggest].end()) {
+                util.mothurRemove(spillFile); //remove old temp file, just in case
+                groupSpills[biggest].push_back(spillFile);
+            }
+            
+            ofstream out;
+            util.openOutputFileBinaryAppend(spillFile, out);
+            out.write((char*)&(groupDists[biggest][0]), groupDists[biggest].size() * sizeof(SplitDist));
+            out.close();
+            
+            memoryUsed -= groupDists[biggest].size() * sizeof(SplitDist);
+            vector<SplitDist>().swap(groupDists[biggest]);
+        }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "spillGroups");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+//reads the group's temp files back into memory and removes them
+void SplitMatrix::readSpills(int group){
+	try {
+        for (int i = 0; i < groupSpills[group].size(); i++) {
+            ifstream in;
+            util.openInputFileBinary(groupSpills[group][i], in);
+            
+            in.seekg(0, ios::end);
+            unsigned long long numDists = in.tellg() / sizeof(SplitDist);
+            in.seekg(0, ios::beg);
+            
+            unsigned long long start = groupDists[group].size();
+            groupDists[group].resize(start + numDists);
+            if (numDists != 0) { in.read((char*)&(groupDists[group][start]), numDists * sizeof(SplitDist)); }
+            in.close();
+            
+            memoryUsed += numDists * sizeof(SplitDist);
+            util.mothurRemove(groupSpills[group][i]);
+        }
+        groupSpills[group].clear();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "readSpills");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+int SplitMatrix::findGroup(int group){
+	try {
+        while (groupParent[group] != group) {
+            groupParent[group] = groupParent[groupParent[group]];
+            group = groupParent[group];
+        }
+        return group;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "findGroup");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+//orders the groups like getDistanceFiles and writes the singleton file the same way splitNames does
+int SplitMatrix::finishStream(vector<int>& seqGroup, int numGroups){
+	try {
+        groupMembers.assign(numGroups, vector<unsigned int>());
+        for (int i = 0; i < seqGroup.size(); i++) { if (seqGroup[i] != -1) { groupMembers[seqGroup[i]].push_back(i); } }
+        
+        groupOrder.clear();
+        for (int i = 0; i < numGroups; i++) { if (groupBytes[i] != 0) { groupOrder.push_back(i); } }
+        sort(groupOrder.begin(), groupOrder.end(), [this](int left, int right) { return groupBytes[left] > groupBytes[right]; }); //biggest to smallest
+        
+        string inputFile = namefile;
+        if (countfile != "") { inputFile = countfile; }
+        
+        singleton = inputFile + ".extra.temp";
+        ofstream remainingNames;
+        util.openOutputFile(singleton, remainingNames);
+        if (countfile != "") { remainingNames << defaultCountTableHeaders << endl; }
+        
+        //seqs that are not in a group, then the seqs in groups without distances
+        numSingleton = 0;
+        for (int i = 0; i < seqGroup.size(); i++) {
+            if (seqGroup[i] == -1) { remainingNames << seqNames[i] << '\t' << seqLists[i] << endl; numSingleton++; }
+        }
+        for (int i = 0; i < numGroups; i++) {
+            if (groupBytes[i] != 0) { continue; }
+            for (int j = 0; j < groupMembers[i].size(); j++) {
+                remainingNames << seqNames[groupMembers[i][j]] << '\t' << seqLists[groupMembers[i][j]] << endl; numSingleton++;
+            }
+            vector<unsigned int>().swap(groupMembers[i]);
+        }
+        remainingNames.close();
+        
+        if (numSingleton == 0) { util.mothurRemove(singleton); singleton = "none"; }
+        
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "finishStream");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+OptiMatrix* SplitMatrix::getGroupMatrix(int i){
+	try {
+        int group = groupOrder[i];
+        
+        readSpills(group);
+        vector<SplitDist> dists; dists.swap(groupDists[group]);
+        memoryUsed -= dists.size() * sizeof(SplitDist);
+        
+        //number the seqs the way OptiMatrix::readColumn does, sorted by name with the singletons at the end
+        map<string, unsigned int> nameAssignment;
+        for (int j = 0; j < groupMembers[group].size(); j++) { nameAssignment[seqNames[groupMembers[group][j]]] = groupMembers[group][j]; }
+        vector<unsigned int>().swap(groupMembers[group]);
+        
+        vector<string> nameMap; vector<unsigned int> sorted;
+        for (map<string, unsigned int>::iterator it = nameAssignment.begin(); it != nameAssignment.end(); it++) {
+            seqLocal[it->second] = sorted.size();
+            sorted.push_back(it->second); nameMap.push_back(it->first);
+        }
+        nameAssignment.clear();
+        
+        vector<bool> singleton(sorted.size(), true);
+        for (long long j = 0; j < dists.size(); j++) { singleton[seqLocal[dists[j].seqA]] = false; singleton[seqLocal[dists[j].seqB]] = false; }
+        
+        vector<string> singletons;
+        vector<long long> singletonIndexSwap(sorted.size(), -1);
+        long long nonSingletonCount = 0;
+        for (long long j = 0; j < sorted.size(); j++) {
+            if (!singleton[j]) { singletonIndexSwap[j] = nonSingletonCount; nonSingletonCount++; }
+            else if (countfile == "") { singletons.push_back(seqLists[sorted[j]]); } //redundant names
+            else { singletons.push_back(seqNames[sorted[j]]); }
+        }
+        
+        vector< set<long long> > closeness(nonSingletonCount);
+        for (long long j = 0; j < dists.size(); j++) {
+            long long newA = singletonIndexSwap[seqLocal[dists[j].seqA]];
+            long long newB = singletonIndexSwap[seqLocal[dists[j].seqB]];
+            closeness[newA].insert(newB);
+            closeness[newB].insert(newA);
+            
+            if (countfile == "") { nameMap[newA] = seqLists[dists[j].seqA]; nameMap[newB] = seqLists[dists[j].seqB]; }
+            else { nameMap[newA] = seqNames[dists[j].seqA]; nameMap[newB] = seqNames[dists[j].seqB]; }
+        }
+        dists.clear();
+        
+        for (long long j = 0; j < sorted.size(); j++) { seqLocal[sorted[j]] = -1; }
+        
+        return new OptiMatrix(closeness, nameMap, singletons, streamCutoff);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "getGroupMatrix");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
 //sorts biggest to smallest
 inline bool compareFileSizes(map<string, string> left, map<string, string> right){
 	
@@ -971,6 +1371,8 @@ vector< map< string, string> > SplitMatrix::getDistanceFiles(){
 	}
 }
 /***********************************************************************/
-SplitMatrix::~SplitMatrix(){}
+SplitMatrix::~SplitMatrix(){
+    for (int i = 0; i < groupSpills.size(); i++) { for (int j = 0; j < groupSpills[i].size(); j++) { util.mothurRemove(groupSpills[i][j]); } }
+}
 /***********************************************************************/
 
@@ -14,6 +14,19 @@
 #include "mothurout.h"
 #include "utils.hpp"
 #include "counttable.h"
+#include "binarydistfile.hpp"
+#include "optimatrix.h"
+
+/******************************************************/
+
+//a distance kept by the streaming split, the seqs are indexes into the name or count file
+struct SplitDist {
+    unsigned int seqA, seqB;
+    float dist;
+    
+    SplitDist() : seqA(0), seqB(0), dist(0) {}
+    SplitDist(unsigned int a, unsigned int b, float d) : seqA(a), seqB(b), dist(d) {}
+};
 
 /******************************************************/
 
@@ -29,6 +42,13 @@ class SplitMatrix  {
 		vector< map<string, string> > getDistanceFiles();  //returns map of distance files -> namefile sorted by distance file size
 		string getSingletonNames() { return singleton; } //returns namesfile containing singletons
         long long getNumSingleton() { return numSingleton; } //returns namesfile containing singletons
+    
+        //stream mode splits the distances into memory in one pass instead of writing a distance and name file for each group.
+        //groups are written to temp files only while more than memory bytes of distances are held.
+        void setStream(unsigned long long mem, double dc) { stream = true; memory = mem; streamCutoff = dc; } //memory, cutoff for the clustering
+        int getNumGroups() { return groupOrder.size(); } //groups with distances, largest first like getDistanceFiles
+        string getGroupFile(int i) { return distFile + "." + toString(groupOrder[i]) + ".temp"; } //the distance file the group would have been written to
+        OptiMatrix* getGroupMatrix(int); //group - numbered the way OptiMatrix reads the group's files, frees the group's distances
 	
 	private:
 		MothurOut* m;
@@ -40,7 +60,26 @@ class SplitMatrix  {
 		bool large, classic;
         int processors;
         long long numSingleton;
+        BinaryDistFile* binDist; //NULL unless distFile is a binary distance file
+    
+        bool stream;
+        double streamCutoff; //the clustering cutoff, distances above it are counted but not kept
+        unsigned long long memory, memoryUsed;
+        string defaultCountTableHeaders;
+        vector<string> seqNames, seqLists; //in name or count file order, seqLists holds the namelist or abundance
+        map<string, unsigned int> seqIndex;
+        vector< vector<SplitDist> > groupDists;
+        vector< vector<string> > groupSpills; //temp files holding the group's distances past the memory limit
+        vector<long long> groupBytes; //size of the group's distance file
+        vector<int> groupParent; //distance split merges groups, groupParent[i] == i if i has not been merged
+        vector<int> groupOrder;
+        vector< vector<unsigned int> > groupMembers;
+        vector<long long> seqLocal; //scratch for getGroupMatrix, -1 unless the seq is in the group being built
+        map<float, int> distLengths;
 				
+		bool openDistFile(ifstream&);
+		bool getNextDist(ifstream&, string&, string&, float&);
+		void closeDistFile(ifstream&);
 		int splitDistance();
 		int splitClassify();
 		int splitDistanceLarge();
@@ -49,6 +88,14 @@ class SplitMatrix  {
         int splitNamesVsearch(map<string, int>& groups, int, vector<string>&);
 		int splitDistanceFileByTax(map<string, int>&, int);
 		int createDistanceFilesFromTax(map<string, int>&, int);
+        int readStreamNames();
+        int streamDistance();
+        int streamDistanceByTax(map<string, int>&, int);
+        void addStreamDist(int, SplitDist, string&, string&); //group, dist, seqA, seqB
+        void spillGroups();
+        void readSpills(int);
+        int findGroup(int);
+        int finishStream(vector<int>&, int); //group of each seq, numGroups
 };
 
 /******************************************************/
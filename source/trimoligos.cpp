@@ -91,6 +91,14 @@ int TrimOligos::preProcess(int p, int b, int l, int s, int rd, map<string, int>
             }
         }
         
+        vector<string> barcodeOligos, primerOligos;
+        for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){ barcodeOligos.push_back(it->first); }
+        for(it=primers.begin();it!=primers.end();it++){ primerOligos.push_back(it->first); }
+        
+        fBarcodeIndex = new OligoIndex(barcodeOligos, bdiffs);
+        fPrimerIndex = new OligoIndex(primerOligos, pdiffs);
+        rBarcodeIndex = NULL; rPrimerIndex = NULL; rcBarcodeIndex = NULL; rcPrimerIndex = NULL;
+        
         return 0;
     }
     catch(exception& e) {
@@ -164,6 +172,27 @@ int TrimOligos::preProcess(int p, int b, int l, int s, map<int, oligosPair> pr,
         
         ipbarcodes = br;
         ipprimers = pr;
+        
+        vector<string> fBarcodes, rBarcodes, fPrimers, rPrimers, rcBarcodes, rcPrimers;
+        for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){ fBarcodes.push_back(it->first); }
+        for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){ fPrimers.push_back(it->first); }
+        for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+            rBarcodes.push_back(it->first);
+            if (it->first != "NONE") { rcBarcodes.push_back(reverseOligo(it->first)); }
+            else { rcBarcodes.push_back(it->first); }
+        }
+        for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+            rPrimers.push_back(it->first);
+            if (it->first != "NONE") { rcPrimers.push_back(reverseOligo(it->first)); }
+            else { rcPrimers.push_back(it->first); }
+        }
+        
+        fBarcodeIndex = new OligoIndex(fBarcodes, bdiffs);
+        rBarcodeIndex = new OligoIndex(rBarcodes, bdiffs);
+        fPrimerIndex = new OligoIndex(fPrimers, pdiffs);
+        rPrimerIndex = new OligoIndex(rPrimers, pdiffs);
+        rcBarcodeIndex = new OligoIndex(rcBarcodes, bdiffs);
+        rcPrimerIndex = new OligoIndex(rcPrimers, pdiffs);
 
         return 0;
     }
@@ -172,6 +201,56 @@ int TrimOligos::preProcess(int p, int b, int l, int s, map<int, oligosPair> pr,
         exit(1);
     }
 }
+/********************************************************************/
+TrimOligos::~TrimOligos(){
+    if (fBarcodeIndex != NULL) { delete fBarcodeIndex; }
+    if (rBarcodeIndex != NULL) { delete rBarcodeIndex; }
+    if (fPrimerIndex != NULL) { delete fPrimerIndex; }
+    if (rPrimerIndex != NULL) { delete rPrimerIndex; }
+    if (rcBarcodeIndex != NULL) { delete rcBarcodeIndex; }
+    if (rcPrimerIndex != NULL) { delete rcPrimerIndex; }
+}
+//********************************************************************/
+//the first oligo in the map that matches the start of the sequence, or the end of the map
+map<string, int>::iterator TrimOligos::findFirst(map<string, int>& oligos, OligoIndex* index, const string& seq){
+    try {
+        int first = index->findMatches(seq);
+        if (first == -1) { return oligos.end(); }
+        return oligos.find(index->getOligo(first));
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "findFirst");
+        exit(1);
+    }
+}
+//********************************************************************/
+//the first pair in the map whose forward and reverse oligos both match, or the end of the map. "NONE" matches anything.
+map<int, oligosPair>::iterator TrimOligos::findFirstPair(map<int, oligosPair>& pairs, map<string, vector<int> >& forwards, OligoIndex* forwardIndex, OligoIndex* reverseIndex, const string& forwardSeq, const string& reverseSeq, bool reverseAtEnd){
+    try {
+        map<int, oligosPair>::iterator first = pairs.end();
+        
+        if (forwardIndex->findMatches(forwardSeq) == -1) { return first; }
+        if (reverseIndex->findMatches(reverseSeq, reverseAtEnd) == -1) { return first; }
+        
+        const vector<int>& matches = forwardIndex->getMatches();
+        for (int i = 0; i < matches.size(); i++) {
+            vector<int>& groups = forwards[forwardIndex->getOligo(matches[i])];
+            
+            for (int j = 0; j < groups.size(); j++) {
+                if ((first != pairs.end()) && (groups[j] >= first->first)) { continue; }
+                
+                map<int, oligosPair>::iterator it = pairs.find(groups[j]);
+                if (reverseIndex->isMatch(it->second.reverse)) { first = it; }
+            }
+        }
+        
+        return first;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "findFirstPair");
+        exit(1);
+    }
+}
 //********************************************************************/
 vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primerEnd){
     try {
@@ -410,8 +489,11 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
         success.push_back(bdiffs + 1000);	//guilty until proven innocent
         success.push_back(MOTHURMAX); //no matches found
         
-        //can you find the barcode
-        for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+        //can you find the barcode, the index skips to the first barcode that matches when the sequence is long enough for all of them
+        map<string,int>::iterator itStart = barcodes.begin();
+        if (rawSequence.length() >= maxFBarcodeLength) { itStart = findFirst(barcodes, fBarcodeIndex, rawSequence); }
+        
+        for(map<string,int>::iterator it=itStart;it!=barcodes.end();it++){
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the barcodes are the same length
                 success[0] = rawSequence.length();
@@ -437,17 +519,18 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (barcodes.size() > 0) {alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> alignments;
+            if (rawSequence.length() >= maxFBarcodeLength) { alignments = fBarcodeIndex->align(rawSequence, seq.getName()); }
+            
+            int index = 0;
+            for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++, index++){
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -457,32 +540,13 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+bdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
-                
-                int alnLength = oligo.length();
-                
-                for(int i=oligo.length()-1;i>=0;i--){
-                    if(oligo[i] != '-'){	alnLength = i+1;	break;	}
-                }
-                oligo = oligo.substr(0,alnLength);
-                temp = temp.substr(0,alnLength);
-                int numDiff = countDiffs(oligo, temp);
-                
-                if (m->getDebug()) { m->mothurOut("[DEBUG]: " + seq.getName() + " aligned fragment =" + temp + ", barcode =" + oligo + ", numDiffs = " + toString(numDiff) + "\n"); }
+                int numDiff = alignments[index].numDiffs;
                 
                 if(numDiff < minDiff){
                     minDiff = numDiff;
                     minCount = 1;
                     minGroup = it->second;
-                    minPos = 0;
-                    for(int i=0;i<alnLength;i++){
-                        if(temp[i] != '-'){
-                            minPos++;
-                        }
-                    }
+                    minPos = alignments[index].pos;
                 }
                 else if(numDiff == minDiff){
                     minCount++;
@@ -502,7 +566,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -526,8 +589,11 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         success.push_back(bdiffs + 1000);
         success.push_back(MOTHURMAX);
         
-        //can you find the forward barcode
-        for(map<int,oligosPair>::iterator it=ipbarcodes.begin();it!=ipbarcodes.end();it++){
+        //can you find the forward barcode, the index skips to the first pair that matches when the sequences are long enough for all the barcodes
+        map<int,oligosPair>::iterator itStart = ipbarcodes.begin();
+        if ((rawFSequence.length() >= maxFBarcodeLength) && (rawRSequence.length() >= maxRBarcodeLength)) { itStart = findFirstPair(ipbarcodes, ifbarcodes, fBarcodeIndex, rBarcodeIndex, rawFSequence, rawRSequence, false); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipbarcodes.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -568,10 +634,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         //if you found the barcode or if you don't want to allow for diffs
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -592,7 +654,12 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawFSequence.length() >= maxFBarcodeLength) { fAlignments = fBarcodeIndex->align(rawFSequence, "forward " + forwardSeq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++, fIndex++){
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -603,19 +670,8 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 
                 if (oligo != "NONE") {
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
-                    
-                    if (m->getDebug()) { m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + ", barcode=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = bdiffs + 1000; }
                     
@@ -625,22 +681,12 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -656,18 +702,18 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff;
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRBarcodeLength) { rAlignments = rBarcodeIndex->align(rawRSequence, "reverse " + forwardSeq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++, rIndex++){
                     string oligo = it->first;
                     
                     if(rawRSequence.length() < maxRBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -677,18 +723,8 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
-                        
-                        if (m->getDebug()) { m->mothurOut("[DEBUG]: reverse " + forwardSeq.getName() + " aligned fragment=" + temp + ", barcode=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         
                         if (alnLength == 0) { numDiff = bdiffs + 1000; }
                         
@@ -698,21 +734,11 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -754,7 +780,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -778,8 +803,11 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
         success.push_back(bdiffs + 1000);
         success.push_back(MOTHURMAX);
         //cout << "SEQUENCE " << endl << forwardSeq.getName() << '\n' << rawFSequence << endl << rawRSequence << endl;
-        //can you find the forward barcode
-        for(map<int,oligosPair>::iterator it=ipbarcodes.begin();it!=ipbarcodes.end();it++){
+        //can you find the forward barcode, the index skips to the first pair that matches when the sequences are long enough for all the barcodes
+        map<int,oligosPair>::iterator itStart = ipbarcodes.begin();
+        if ((rawFSequence.length() >= maxFBarcodeLength) && (rawRSequence.length() >= maxRBarcodeLength)) { itStart = findFirstPair(ipbarcodes, ifbarcodes, fBarcodeIndex, rBarcodeIndex, rawFSequence, rawRSequence, false); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipbarcodes.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -819,10 +847,6 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
         //if you found the barcode or if you don't want to allow for diffs
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -842,7 +866,12 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
              reverse = Westcott, Schloss, Brown, Moore
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawFSequence.length() >= maxFBarcodeLength) { fAlignments = fBarcodeIndex->align(rawFSequence, "forward " + forwardSeq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++, fIndex++){
                 string oligo = it->first;
                 //cout << "trying forward oligos " << oligo << endl;
                 if (oligo != "NONE") {
@@ -853,48 +882,23 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                         break;
                     }
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){    alnLength = i+1;    break;    } }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = bdiffs + 1000; }
                     //if (m->getDebug()) { m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + ", barcode=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
                     
-                    if (m->getDebug()) {
-                        if (numDiff < minDiff) {
-                            m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + "\nbarcode=" + oligo + "\nnumDiffs=" + toString(numDiff) + ".\n");
-                        }
-                    }
-                    
                     if(numDiff < minDiff){
                         minDiff = numDiff;
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -910,18 +914,18 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRBarcodeLength) { rAlignments = rBarcodeIndex->align(rawRSequence, "reverse " + reverseSeq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++, rIndex++){
                     string oligo = it->first;
                     //cout << "trying reverse oligos " << oligo << endl;
                     if (oligo != "NONE") {
@@ -932,45 +936,20 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                             break;
                         }
                         
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        //cout << oligo <<endl;
-                        //cout << temp << endl;
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){    alnLength = i+1;    break;    } }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         if (alnLength == 0) { numDiff = bdiffs + 1000; }
                         
-                        if (m->getDebug()) {
-                            if (numDiff < minDiff) {
-                                m->mothurOut("[DEBUG]: reverse " + reverseSeq.getName() + " aligned fragment=" + temp + "\nbarcode=" + oligo + "\nnumDiffs=" + toString(numDiff) + ".\n");
-                            }
-                        }
-                        
                         if(numDiff < minDiff){
                             minDiff = numDiff;
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -1010,7 +989,6 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         //exit(1);
         return success;
@@ -1034,8 +1012,11 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         success.push_back(bdiffs + 1000);
         success.push_back(MOTHURMAX);
         //cout << "SEQUENCE " << endl << forwardSeq.getName() << '\n' << rawFSequence << endl << rawRSequence << endl;
-        //can you find the forward barcode
-        for(map<int,oligosPair>::iterator it=ipbarcodes.begin();it!=ipbarcodes.end();it++){
+        //can you find the forward barcode, the index skips to the first pair that matches when the sequences are long enough for all the barcodes
+        map<int,oligosPair>::iterator itStart = ipbarcodes.begin();
+        if ((rawFSequence.length() >= maxFBarcodeLength) && (rawRSequence.length() >= maxRBarcodeLength)) { itStart = findFirstPair(ipbarcodes, ifbarcodes, fBarcodeIndex, rBarcodeIndex, rawFSequence, rawRSequence, false); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipbarcodes.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -1089,10 +1070,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         //if you found the barcode or if you don't want to allow for diffs
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -1112,7 +1089,12 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
              reverse = Westcott, Schloss, Brown, Moore
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawFSequence.length() >= maxFBarcodeLength) { fAlignments = fBarcodeIndex->align(rawFSequence, "forward " + forwardSeq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++, fIndex++){
                 string oligo = it->first;
                 
                 if (oligo != "NONE") {
@@ -1123,48 +1105,23 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                         break;
                     }
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = bdiffs + 1000; }
                     //if (m->getDebug()) { m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + ", barcode=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
                     
-                    if (m->getDebug()) {
-                        if (numDiff < minDiff) {
-                            m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + "\nbarcode=" + oligo + "\nnumDiffs=" + toString(numDiff) + ".\n");
-                        }
-                    }
-                    
                     if(numDiff < minDiff){
                         minDiff = numDiff;
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -1180,18 +1137,18 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRBarcodeLength) { rAlignments = rBarcodeIndex->align(rawRSequence, "reverse " + reverseSeq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++, rIndex++){
                     string oligo = it->first;
                     
                     if (oligo != "NONE") {
@@ -1202,45 +1159,20 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                             break;
                         }
                         
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        //cout << oligo <<endl;
-                        //cout << temp << endl;
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         if (alnLength == 0) { numDiff = bdiffs + 1000; }
-                    
-                        if (m->getDebug()) {
-                            if (numDiff < minDiff) {
-                                m->mothurOut("[DEBUG]: reverse " + reverseSeq.getName() + " aligned fragment=" + temp + "\nbarcode=" + oligo + "\nnumDiffs=" + toString(numDiff) + ".\n");
-                            }
-                        }
                         
                         if(numDiff < minDiff){
                             minDiff = numDiff;
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -1286,7 +1218,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         //exit(1);
         return success;
@@ -1313,8 +1244,11 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
         success.push_back(MOTHURMAX);
         
         
-        //can you find the forward barcode
-        for(map<int,oligosPair>::iterator it=ipbarcodes.begin();it!=ipbarcodes.end();it++){
+        //can you find the forward barcode, the index skips to the first pair that matches when the sequences are long enough for all the barcodes
+        map<int,oligosPair>::iterator itStart = ipbarcodes.begin();
+        if (rawSeq.length() >= (maxFBarcodeLength + maxRBarcodeLength)) { itStart = findFirstPair(ipbarcodes, ifbarcodes, fBarcodeIndex, rBarcodeIndex, rawSeq, rawSeq, true); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipbarcodes.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -1369,10 +1303,6 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
         //if you found the barcode or if you don't want to allow for diffs
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -1393,7 +1323,12 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawSeq.length() >= maxFBarcodeLength) { fAlignments = fBarcodeIndex->align(rawSeq, "forward " + seq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++, fIndex++){
                 string oligo = it->first;
 
                 if (oligo != "NONE") {
@@ -1403,17 +1338,8 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                         break;
                     }
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawSeq.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = bdiffs + 1000; }
                     
@@ -1423,22 +1349,12 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -1456,11 +1372,6 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
@@ -1469,7 +1380,12 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 
                 string rawRSequence = reverseOligo(seq.getUnaligned());
                 
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRBarcodeLength) { rAlignments = rcBarcodeIndex->align(rawRSequence, "reverse " + seq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++, rIndex++){
                     string oligo = it->first;
                     if (oligo != "NONE") { oligo = reverseOligo(oligo); }
                     
@@ -1481,16 +1397,8 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                             break;
                         }
                         
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         if (alnLength == 0) { numDiff = bdiffs + 1000; }
                         
                         
@@ -1499,21 +1407,11 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -1561,7 +1459,6 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
             }
             rMinDiff = minDiff;
 
-            if (alignment != NULL) { delete alignment; }
         }
 
         return success;
@@ -1588,8 +1485,11 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
         success.push_back(MOTHURMAX);
         
         
-        //can you find the forward
-        for(map<int,oligosPair>::iterator it=ipprimers.begin();it!=ipprimers.end();it++){
+        //can you find the forward, the index skips to the first pair that matches when the sequences are long enough for all the primers
+        map<int,oligosPair>::iterator itStart = ipprimers.begin();
+        if (rawSeq.length() >= (maxFPrimerLength + maxRPrimerLength)) { itStart = findFirstPair(ipprimers, ifprimers, fPrimerIndex, rPrimerIndex, rawSeq, rawSeq, true); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipprimers.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -1650,10 +1550,6 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
         //if you found the barcode or if you don't want to allow for diffs
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -1674,7 +1570,12 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
-            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawSeq.length() >= maxFPrimerLength) { fAlignments = fPrimerIndex->align(rawSeq, "forward " + seq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++, fIndex++){
                 string oligo = it->first;
                 
                 if(rawSeq.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1684,17 +1585,8 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 }
                 
                 if (oligo != "NONE") {
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawSeq.substr(0,oligo.length()+pdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = pdiffs + 1000; }
                     
@@ -1704,22 +1596,12 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -1738,11 +1620,6 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
@@ -1751,7 +1628,12 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 
                 string rawRSequence = reverseOligo(seq.getUnaligned());
                 
-                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRPrimerLength) { rAlignments = rcPrimerIndex->align(rawRSequence, "reverse " + seq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++, rIndex++){
                     string oligo = it->first;
                     if (oligo != "NONE") { oligo = reverseOligo(oligo); }
                     
@@ -1762,16 +1644,8 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         if (alnLength == 0) { numDiff = pdiffs + 1000; }
                         
                         
@@ -1780,21 +1654,11 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -1845,7 +1709,6 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
 
             rMinDiff = minDiff;
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -1870,8 +1733,11 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         success.push_back(pdiffs + 1000);
         success.push_back(MOTHURMAX);
         
-        //can you find the forward barcode
-        for(map<int,oligosPair>::iterator it=ipprimers.begin();it!=ipprimers.end();it++){
+        //can you find the forward barcode, the index skips to the first pair that matches when the sequences are long enough for all the primers
+        map<int,oligosPair>::iterator itStart = ipprimers.begin();
+        if ((rawFSequence.length() >= maxFPrimerLength) && (rawRSequence.length() >= maxRPrimerLength)) { itStart = findFirstPair(ipprimers, ifprimers, fPrimerIndex, rPrimerIndex, rawFSequence, rawRSequence, false); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipprimers.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -1916,10 +1782,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         //if you found the barcode or if you don't want to allow for diffs
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -1940,7 +1802,12 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
-            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawFSequence.length() >= maxFPrimerLength) { fAlignments = fPrimerIndex->align(rawFSequence, "forward " + forwardSeq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++, fIndex++){
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1950,44 +1817,23 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
                 
                 if (oligo != "NONE") {
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+pdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = pdiffs + 1000; }
                     
                     
-                    if (m->getDebug()) { m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + ", primer=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
-                    
                     if(numDiff < minDiff){
                         minDiff = numDiff;
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -2003,18 +1849,18 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRPrimerLength) { rAlignments = rPrimerIndex->align(rawRSequence, "reverse " + reverseSeq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++, rIndex++){
                     string oligo = it->first;
                     
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -2024,40 +1870,20 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         if (alnLength == 0) { numDiff = pdiffs + 1000; }
                         
-                        if (m->getDebug()) { m->mothurOut("[DEBUG]: reverse " + forwardSeq.getName() + " aligned fragment=" + temp + ", primer=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
-                        
                         if(numDiff < minDiff){
                             minDiff = numDiff;
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -2101,7 +1927,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -2126,8 +1951,11 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         success.push_back(pdiffs + 1000);
         success.push_back(MOTHURMAX);
         
-        //can you find the forward barcode
-        for(map<int,oligosPair>::iterator it=ipprimers.begin();it!=ipprimers.end();it++){
+        //can you find the forward barcode, the index skips to the first pair that matches when the sequences are long enough for all the primers
+        map<int,oligosPair>::iterator itStart = ipprimers.begin();
+        if ((rawFSequence.length() >= maxFPrimerLength) && (rawRSequence.length() >= maxRPrimerLength)) { itStart = findFirstPair(ipprimers, ifprimers, fPrimerIndex, rPrimerIndex, rawFSequence, rawRSequence, false); }
+        
+        for(map<int,oligosPair>::iterator it=itStart;it!=ipprimers.end();it++){
             string foligo = it->second.forward;
             string roligo = it->second.reverse;
             
@@ -2168,10 +1996,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         //if you found the barcode or if you don't want to allow for diffs
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
@@ -2192,7 +2016,12 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
-            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> fAlignments;
+            if (rawFSequence.length() >= maxFPrimerLength) { fAlignments = fPrimerIndex->align(rawFSequence, "forward " + forwardSeq.getName()); }
+            
+            int fIndex = 0;
+            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++, fIndex++){
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -2202,19 +2031,8 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
                 
                 if (oligo != "NONE") {
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+pdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
-                    
-                    int alnLength = oligo.length();
-                    
-                    for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                    oligo = oligo.substr(0,alnLength);
-                    temp = temp.substr(0,alnLength);
-                    int numDiff = countDiffs(oligo, temp);
-                    
-                    if (m->getDebug()) { m->mothurOut("[DEBUG]: forward " + forwardSeq.getName() + " aligned fragment=" + temp + ", primer=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
+                    int alnLength = fAlignments[fIndex].alnLength;
+                    int numDiff = fAlignments[fIndex].numDiffs;
                     
                     if (alnLength == 0) { numDiff = pdiffs + 1000; }
                     
@@ -2224,22 +2042,12 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                         minCount = 1;
                         minFGroup.clear();
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.clear();
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
                         minFPos.push_back(tempminFPos);
                     }else if(numDiff == minDiff){
                         minFGroup.push_back(it->second);
-                        int tempminFPos = 0;
-                        for(int i=0;i<alnLength;i++){
-                            if(temp[i] != '-'){
-                                tempminFPos++;
-                            }
-                        }
+                        int tempminFPos = fAlignments[fIndex].pos;
                         minFPos.push_back(tempminFPos);
                     }
                 }else { //is a match
@@ -2255,18 +2063,18 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
-                
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
-                else{ alignment = NULL; }
-                
                 //can you find the barcode
                 minDiff = MOTHURMAX;
                 minCount = 1;
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+                vector<OligoAlignment> rAlignments;
+                if (rawRSequence.length() >= maxRPrimerLength) { rAlignments = rPrimerIndex->align(rawRSequence, "reverse " + reverseSeq.getName()); }
+                
+                int rIndex = 0;
+                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++, rIndex++){
                     string oligo = it->first;
                     
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -2276,18 +2084,8 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
-                        
-                        int alnLength = oligo.length();
-                        for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
-                        oligo = oligo.substr(0,alnLength);
-                        temp = temp.substr(0,alnLength);
-                        int numDiff = countDiffs(oligo, temp);
-                        
-                        if (m->getDebug()) { m->mothurOut("[DEBUG]: reverse " + forwardSeq.getName() + " aligned fragment=" + temp + ", primer=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
+                        int alnLength = rAlignments[rIndex].alnLength;
+                        int numDiff = rAlignments[rIndex].numDiffs;
                         
                         if (alnLength == 0) { numDiff = pdiffs + 1000; }
                         
@@ -2297,21 +2095,11 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                             minCount = 1;
                             minRGroup.clear();
                             minRGroup.push_back(it->second);
-                            int tempminRPos = 0;
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.clear();
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
                             minRPos.push_back(tempminRPos);
                         }else if(numDiff == minDiff){
-                            int tempminRPos = 0;
-                            for(int i=0;i<alnLength;i++){
-                                if(temp[i] != '-'){
-                                    tempminRPos++;
-                                }
-                            }
+                            int tempminRPos = rAlignments[rIndex].pos;
                             minRPos.push_back(tempminRPos);
                             minRGroup.push_back(it->second);
                         }
@@ -2353,7 +2141,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -2375,8 +2162,11 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
         success.push_back(bdiffs + 1000);	//guilty until proven innocent
         success.push_back(MOTHURMAX);
         
-        //can you find the barcode
-        for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+        //can you find the barcode, the index skips to the first barcode that matches when the sequence is long enough for all of them
+        map<string,int>::iterator itStart = barcodes.begin();
+        if (rawSequence.length() >= maxFBarcodeLength) { itStart = findFirst(barcodes, fBarcodeIndex, rawSequence); }
+        
+        for(map<string,int>::iterator it=itStart;it!=barcodes.end();it++){
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the barcodes are the same length
                 success[0] = rawSequence.length();
@@ -2396,17 +2186,18 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (barcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> alignments;
+            if (rawSequence.length() >= maxFBarcodeLength) { alignments = fBarcodeIndex->align(rawSequence, seq.getName()); }
+            
+            int index = 0;
+            for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++, index++){
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2416,33 +2207,13 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+bdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
-                
-                int alnLength = oligo.length();
-                
-                for(int i=oligo.length()-1;i>=0;i--){
-                    if(oligo[i] != '-'){	alnLength = i+1;	break;	}
-                }
-                oligo = oligo.substr(0,alnLength);
-                temp = temp.substr(0,alnLength);
-                
-                int numDiff = countDiffs(oligo, temp);
-                
-                if (m->getDebug()) { m->mothurOut("[DEBUG]: " + seq.getName() + " aligned fragment =" + temp + ", barcode =" + oligo + ", numDiffs = " + toString(numDiff) + "\n"); }
+                int numDiff = alignments[index].numDiffs;
                 
                 if(numDiff < minDiff){
                     minDiff = numDiff;
                     minCount = 1;
                     minGroup = it->second;
-                    minPos = 0;
-                    for(int i=0;i<alnLength;i++){
-                        if(temp[i] != '-'){
-                            minPos++;
-                        }
-                    }
+                    minPos = alignments[index].pos;
                 }
                 else if(numDiff == minDiff){
                     minCount++;
@@ -2458,7 +2229,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2480,8 +2250,11 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
         success.push_back(pdiffs + 1000);	//guilty until proven innocent
         success.push_back(MOTHURMAX);
         
-        //can you find the primer
-        for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+        //can you find the primer, the index skips to the first primer that matches when the sequence is long enough for all of them
+        map<string,int>::iterator itStart = primers.begin();
+        if (rawSequence.length() >= maxFPrimerLength) { itStart = findFirst(primers, fPrimerIndex, rawSequence); }
+        
+        for(map<string,int>::iterator it=itStart;it!=primers.end();it++){
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the primers are the same length
                 success[0] = rawSequence.length();
@@ -2501,17 +2274,18 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
         if ((pdiffs == 0) || (success[0] == 0)) {	return success; }
         
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> alignments;
+            if (rawSequence.length() >= maxFPrimerLength) { alignments = fPrimerIndex->align(rawSequence, seq.getName()); }
+            
+            int index = 0;
+            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++, index++){
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2521,33 +2295,13 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+pdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
-                
-                int alnLength = oligo.length();
-                
-                for(int i=oligo.length()-1;i>=0;i--){
-                    if(oligo[i] != '-'){	alnLength = i+1;	break;	}
-                }
-                oligo = oligo.substr(0,alnLength);
-                temp = temp.substr(0,alnLength);
-                
-                int numDiff = countDiffs(oligo, temp);
-                
-                if (m->getDebug()) { m->mothurOut("[DEBUG]: " + seq.getName() + " aligned fragment=" + temp + ", primer=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
+                int numDiff = alignments[index].numDiffs;
                 
                 if(numDiff < minDiff){
                     minDiff = numDiff;
                     minCount = 1;
                     minGroup = it->second;
-                    minPos = 0;
-                    for(int i=0;i<alnLength;i++){
-                        if(temp[i] != '-'){
-                            minPos++;
-                        }
-                    }
+                    minPos = alignments[index].pos;
                 }
                 else if(numDiff == minDiff){
                     minCount++;
@@ -2563,7 +2317,6 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2588,8 +2341,11 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
         
         string rawSequence = seq.getUnaligned();
         
-        //can you find the primer
-        for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+        //can you find the primer, the index skips to the first primer that matches when the sequence is long enough for all of them
+        map<string,int>::iterator itStart = primers.begin();
+        if (rawSequence.length() >= maxFPrimerLength) { itStart = findFirst(primers, fPrimerIndex, rawSequence); }
+        
+        for(map<string,int>::iterator it=itStart;it!=primers.end();it++){
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the primers are the same length
                 success[0] = rawSequence.length();
@@ -2612,17 +2368,18 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         
         else { //try aligning and see if you can find it
-            Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
-            else{ alignment = NULL; }
-            
             //can you find the barcode
             int minDiff = MOTHURMAX;
             int minCount = 1;
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+            //the alignments of the start of the sequence to each oligo, see OligoIndex::align
+            vector<OligoAlignment> alignments;
+            if (rawSequence.length() >= maxFPrimerLength) { alignments = fPrimerIndex->align(rawSequence, seq.getName()); }
+            
+            int index = 0;
+            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++, index++){
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2632,33 +2389,13 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+pdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
-                
-                int alnLength = oligo.length();
-                
-                for(int i=oligo.length()-1;i>=0;i--){
-                    if(oligo[i] != '-'){	alnLength = i+1;	break;	}
-                }
-                oligo = oligo.substr(0,alnLength);
-                temp = temp.substr(0,alnLength);
-                
-                int numDiff = countDiffs(oligo, temp);
-                
-                if (m->getDebug()) { m->mothurOut("[DEBUG]: " + seq.getName() + " aligned fragment=" + temp + ", primer=" + oligo + ", numDiffs=" + toString(numDiff) + ".\n");  }
+                int numDiff = alignments[index].numDiffs;
                 
                 if(numDiff < minDiff){
                     minDiff = numDiff;
                     minCount = 1;
                     minGroup = it->second;
-                    minPos = 0;
-                    for(int i=0;i<alnLength;i++){
-                        if(temp[i] != '-'){
-                            minPos++;
-                        }
-                    }
+                    minPos = alignments[index].pos;
                 }
                 else if(numDiff == minDiff){
                     minCount++;
@@ -2677,7 +2414,6 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -3286,31 +3022,7 @@ int TrimOligos::stripSpacer(Sequence& seq){
 //******************************************************************/
 bool TrimOligos::compareDNASeq(string oligo, string seq){
     try {
-        bool success = true;
-        int length = oligo.length();
-        
-        for(int i=0;i<length;i++){
-            
-            if(oligo[i] != seq[i]){
-                if(oligo[i] == 'A' || oligo[i] == 'T' || oligo[i] == 'G' || oligo[i] == 'C')	{	success = false; }
-                else if((oligo[i] == 'N' || oligo[i] == 'I') && (seq[i] == 'N'))	{	success = false;	}
-                else if(oligo[i] == 'R' && (seq[i] != 'A' && seq[i] != 'G'))	{	success = false;	}
-                else if(oligo[i] == 'Y' && (seq[i] != 'C' && seq[i] != 'T'))	{	success = false;	}
-                else if(oligo[i] == 'M' && (seq[i] != 'C' && seq[i] != 'A'))	{	success = false;	}
-                else if(oligo[i] == 'K' && (seq[i] != 'T' && seq[i] != 'G'))	{	success = false;	}
-                else if(oligo[i] == 'W' && (seq[i] != 'T' && seq[i] != 'A'))	{	success = false;	}
-                else if(oligo[i] == 'S' && (seq[i] != 'C' && seq[i] != 'G'))	{	success = false;	}
-                else if(oligo[i] == 'B' && (seq[i] != 'C' && seq[i] != 'T' && seq[i] != 'G'))	{	success = false;	}
-                else if(oligo[i] == 'D' && (seq[i] != 'A' && seq[i] != 'T' && seq[i] != 'G'))	{	success = false;	}
-                else if(oligo[i] == 'H' && (seq[i] != 'A' && seq[i] != 'T' && seq[i] != 'C'))	{	success = false;	}
-                else if(oligo[i] == 'V' && (seq[i] != 'A' && seq[i] != 'C' && seq[i] != 'G'))	{	success = false;	}
-                
-                if(success == false)	{	break;	}
-            }
-            else{ success = true; }
-        }
-        
-        return success;
+        return OligoIndex::compareDNASeq(oligo, seq);
     }
     catch(exception& e) {
         m->errorOut(e, "TrimOligos", "compareDNASeq");
@@ -3321,30 +3033,7 @@ bool TrimOligos::compareDNASeq(string oligo, string seq){
 //********************************************************************/
 int TrimOligos::countDiffs(string oligo, string seq){
     try {
-        
-        int length = oligo.length();
-        int countDiffs = 0;
-        
-        for(int i=0;i<length;i++){
-            
-            if(oligo[i] != seq[i]){
-                if(oligo[i] == 'A' || oligo[i] == 'T' || oligo[i] == 'G' || oligo[i] == 'C' || oligo[i] == '-' || oligo[i] == '.')	{	countDiffs++; }
-                else if((oligo[i] == 'N' || oligo[i] == 'I') && (seq[i] == 'N'))	{	countDiffs++;	}
-                else if(oligo[i] == 'R' && (seq[i] != 'A' && seq[i] != 'G'))	{	countDiffs++;	}
-                else if(oligo[i] == 'Y' && (seq[i] != 'C' && seq[i] != 'T'))	{	countDiffs++;	}
-                else if(oligo[i] == 'M' && (seq[i] != 'C' && seq[i] != 'A'))	{	countDiffs++;	}
-                else if(oligo[i] == 'K' && (seq[i] != 'T' && seq[i] != 'G'))	{	countDiffs++;	}
-                else if(oligo[i] == 'W' && (seq[i] != 'T' && seq[i] != 'A'))	{	countDiffs++;	}
-                else if(oligo[i] == 'S' && (seq[i] != 'C' && seq[i] != 'G'))	{	countDiffs++;	}
-                else if(oligo[i] == 'B' && (seq[i] != 'C' && seq[i] != 'T' && seq[i] != 'G'))	{	countDiffs++;	}
-                else if(oligo[i] == 'D' && (seq[i] != 'A' && seq[i] != 'T' && seq[i] != 'G'))	{	countDiffs++;	}
-                else if(oligo[i] == 'H' && (seq[i] != 'A' && seq[i] != 'T' && seq[i] != 'C'))	{	countDiffs++;	}
-                else if(oligo[i] == 'V' && (seq[i] != 'A' && seq[i] != 'C' && seq[i] != 'G'))	{	countDiffs++;	}	
-            }
-            
-        }
-        
-        return countDiffs;
+        return OligoIndex::countDiffs(oligo, seq);
     }
     catch(exception& e) {
         m->errorOut(e, "TrimOligos", "countDiffs");
@@ -13,20 +13,21 @@
 #include "mothurout.h"
 #include "sequence.hpp"
 #include "qualityscores.h"
+#include "oligoindex.hpp"
 
 
 class TrimOligos {
     
 #ifdef UNIT_TEST
     friend class TestTrimOligos;
-    TrimOligos() { m = MothurOut::getInstance(); }
+    TrimOligos() { m = MothurOut::getInstance(); fBarcodeIndex = NULL; rBarcodeIndex = NULL; fPrimerIndex = NULL; rPrimerIndex = NULL; rcBarcodeIndex = NULL; rcPrimerIndex = NULL; }
 #endif
 	
 	public:
         TrimOligos(int,int,int, map<string, int>, map<string, int>, vector<string>); //pdiffs, rpdiffs, bdiffs, primers, barcodes, revPrimers
         TrimOligos(int,int, int, int, map<string, int>, map<string, int>, vector<string>, vector<string>, vector<string>); //pdiffs, bdiffs, ldiffs, sdiffs, primers, barcodes, revPrimers, linker, spacer
         TrimOligos(int,int, int, int, map<int, oligosPair>, map<int, oligosPair>, bool); //pdiffs, bdiffs, ldiffs, sdiffs, primers, barcodes, hasIndex
-    ~TrimOligos(){}
+    ~TrimOligos();
 	
     
         //codes : 10 means sequence shorter than barcode, 100 means multiple matches, MOTHURMAX no matches, 0 found match.
@@ -77,11 +78,25 @@ class TrimOligos {
         map<int, oligosPair> ipprimers;
     
         int maxFBarcodeLength, maxRBarcodeLength, maxFPrimerLength, maxRPrimerLength, maxLinkerLength, maxSpacerLength;
+    
+        //indexes of the barcodes and primers in the order the strip functions search them. The forward indexes hold the
+        //single barcodes and primers when the oligos are not paired. The rc indexes hold the reverse oligos reverse
+        //complemented, the way stripPairedBarcode and stripPairedPrimers align them.
+        OligoIndex* fBarcodeIndex;
+        OligoIndex* rBarcodeIndex;
+        OligoIndex* fPrimerIndex;
+        OligoIndex* rPrimerIndex;
+        OligoIndex* rcBarcodeIndex;
+        OligoIndex* rcPrimerIndex;
 	
 		MothurOut* m;
 	
 		bool compareDNASeq(string, string);				
 		int countDiffs(string, string);
+    
+        //where the exact search loops can start, only valid when the sequences are at least as long as the longest oligos
+        map<string, int>::iterator findFirst(map<string, int>&, OligoIndex*, const string&);
+        map<int, oligosPair>::iterator findFirstPair(map<int, oligosPair>&, map<string, vector<int> >&, OligoIndex*, OligoIndex*, const string&, const string&, bool); //pairs, forward oligos, forward index, reverse index, forward seq, reverse seq, reverse oligo at the end of the reverse seq
         
         vector<int> stripPairedBarcode(Sequence& seq, QualityScores& qual, int& group);
         vector<int> stripPairedPrimers(Sequence& seq, QualityScores& qual, int& group, bool);
@@ -14,6 +14,7 @@
 #include "inputdata.h"
 #include "sharedclrvectors.hpp"
 #include "sharedrabundfloatvectors.hpp"
+#include "counttablebinaryfile.hpp"
 
 /***********************************************************************/
 string getLabelTag(string label){
@@ -1051,6 +1052,8 @@ int Utils::renameFile(string oldName, string newName){
         
         if(m->getDebug()) { m->mothurOut("[DEBUG]: rename " + oldName + " " + newName + " returned " + toString(renameOk) + "\n"); }
 #endif
+        CountTableBinaryFile::rename(oldName, newName); //a count table's binary copy goes with it
+        
         return 0;
 
     }
@@ -3938,6 +3941,7 @@ bool Utils::mothurRemove(string filename){
     try {
         filename = getFullPathName(filename);
         int error = remove(filename.c_str());
+        CountTableBinaryFile::remove(filename);
         return error;
     }
     catch(exception& e) {
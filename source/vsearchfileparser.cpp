@@ -59,14 +59,7 @@ VsearchFileParser::VsearchFileParser(string f, string nameOrCount, string forma)
 /***********************************************************************/
 string VsearchFileParser::getVsearchFile() {
     try {
-        Utils util;
-        if (fastafile == "") { m->mothurOut("[ERROR]: no fasta file given, cannot continue.\n"); m->setControl_pressed(true);  }
-        
-        //Run unique.seqs on the data if a name or count file is not given
-        if ((namefile == "") && (countfile == ""))  {  getNamesFile(fastafile);                  }
-        else if (namefile != "")                    {  counts = util.readNames(namefile);        }
-        
-        if (countfile != "") { CountTable countTable; countTable.readTable(countfile, false, false);  counts = countTable.getNameMap(); }
+        readCounts();
         
         if (m->getControl_pressed()) {  return 0; }
         
@@ -83,6 +76,43 @@ string VsearchFileParser::getVsearchFile() {
         exit(1);
     }
 }
+/***********************************************************************/
+vector<seqPriorityNode> VsearchFileParser::getSortedSeqs() {
+    try {
+        vector<seqPriorityNode> seqs;
+        
+        readCounts();
+        
+        if (m->getControl_pressed()) {  return seqs; }
+        
+        readSeqs(fastafile, seqs);
+        
+        sort(seqs.begin(), seqs.end(), compareSeqPriorityNodes);
+        
+        return seqs;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "VsearchFileParser", "getSortedSeqs");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void VsearchFileParser::readCounts() {
+    try {
+        Utils util;
+        if (fastafile == "") { m->mothurOut("[ERROR]: no fasta file given, cannot continue.\n"); m->setControl_pressed(true);  }
+        
+        //Run unique.seqs on the data if a name or count file is not given
+        if ((namefile == "") && (countfile == ""))  {  getNamesFile(fastafile);                  }
+        else if (namefile != "")                    {  counts = util.readNames(namefile);        }
+        
+        if (countfile != "") { CountTable countTable; countTable.readTable(countfile, false, false);  counts = countTable.getNameMap(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "VsearchFileParser", "readCounts");
+        exit(1);
+    }
+}
 /**********************************************************************/
 
 string VsearchFileParser::createVsearchFasta(string inputFile){
@@ -91,6 +121,24 @@ string VsearchFileParser::createVsearchFasta(string inputFile){
         string vsearchFasta = util.getSimpleName(fastafile) + ".sorted.fasta.temp";
         
         vector<seqPriorityNode> seqs;
+        readSeqs(inputFile, seqs);
+        
+        if (m->getControl_pressed()) { return vsearchFasta; }
+        
+        util.printVsearchFile(seqs, vsearchFasta, ";size=", ";");
+        
+        return vsearchFasta;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "VsearchFileParser", "createVsearchFasta");
+        exit(1);
+    }
+}
+/**********************************************************************/
+
+void VsearchFileParser::readSeqs(string inputFile, vector<seqPriorityNode>& seqs){
+    try {
+        Utils util;
         map<string, int>::iterator it;
         
         ifstream in;
@@ -98,7 +146,7 @@ string VsearchFileParser::createVsearchFasta(string inputFile){
         
         while (!in.eof()) {
             
-            if (m->getControl_pressed()) { in.close(); return vsearchFasta; }
+            if (m->getControl_pressed()) { break; }
             
             Sequence seq(in); util.gobble(in);
             
@@ -112,13 +160,9 @@ string VsearchFileParser::createVsearchFasta(string inputFile){
             
         }
         in.close();
-        
-        util.printVsearchFile(seqs, vsearchFasta, ";size=", ";");
-        
-        return vsearchFasta;
     }
     catch(exception& e) {
-        m->errorOut(e, "VsearchFileParser", "createVsearchFasta");
+        m->errorOut(e, "VsearchFileParser", "readSeqs");
         exit(1);
     }
 }
@@ -202,6 +246,41 @@ ListVector VsearchFileParser::createListFile(string inputFile, int numBins, stri
     }
 }
 /*************************************************************************/
+//bins[i] is the bin of seqs[i], seqs are in the order they were clustered
+ListVector VsearchFileParser::createListFile(vector<seqPriorityNode>& seqs, vector<int>& bins, int numBins, string label, map<string, int>& ct){
+    try {
+        Utils util;
+        map<string, string>::iterator itName;
+        if (format == "name") { counts.clear(); util.readNames(namefile, nameMap); }
+        
+        ListVector list(numBins); list.setLabel(label);
+        
+        for (int i = 0; i < seqs.size(); i++) {
+            if (m->getControl_pressed()) { break; }
+            
+            string seqName = seqs[i].name;
+            
+            if (format == "name") {
+                itName = nameMap.find(seqName);
+                if (itName == nameMap.end()) {  m->mothurOut("[ERROR]: " + seqName + " is not in your name file. Parsing error???\n"); m->setControl_pressed(true); }
+                else{  seqName = itName->second;  }
+            }
+            
+            string bin = list.get(bins[i]);
+            if (bin == "")  {   bin = seqName;          }
+            else            {   bin += ',' + seqName;   }
+            list.set(bins[i], bin);
+        }
+        ct = counts;
+        
+        return list;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "VsearchFileParser", "createListFile");
+        exit(1);
+    }
+}
+/*************************************************************************/
 //GQY1XT001C44N8/ab=3677/	*
 string VsearchFileParser::removeAbundances(string seqName){
     try {
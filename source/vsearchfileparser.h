@@ -30,8 +30,10 @@ class VsearchFileParser {
         ~VsearchFileParser(){}
     
         string getVsearchFile(); //creates vsearch formatted file. degapped, abundance appended, and sorted.
+        vector<seqPriorityNode> getSortedSeqs(); //degapped seqs with their abundances, sorted the same way as the vsearch file
         string getCountFile(); //returns count filename. If no names or count file is given, then a count file is generated. 
         ListVector createListFile(string uc, int numbins, string label, map<string, int>& counts); //takes vsearch output and creates listvector
+        ListVector createListFile(vector<seqPriorityNode>& seqs, vector<int>& bins, int numbins, string label, map<string, int>& counts); //takes greedy cluster bins and creates listvector
         int getNumBins(string logfile);
         void setFastaFile(string f) { fastafile = f; }
     
@@ -42,6 +44,8 @@ class VsearchFileParser {
         string fastafile, namefile, countfile, format;
         string getNamesFile(string& inputFile);
         string createVsearchFasta(string);
+        void readCounts();
+        void readSeqs(string, vector<seqPriorityNode>&);
         string removeAbundances(string seqName);
     
     